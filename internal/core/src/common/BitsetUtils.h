@@ -0,0 +1,370 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <boost_ext/dynamic_bitset_ext.hpp>
+
+#include "common/SimdDispatch.h"
+#include "common/Span.h"
+#include "common/Types.h"
+#include "exceptions/EasyAssert.h"
+
+namespace milvus {
+
+// Word-parallel kernels over BitsetType's raw block storage. The filtering
+// path builds and stitches millions of bits per query; going through
+// dynamic_bitset's per-bit proxy costs a read-modify-write per bit, while
+// these kernels touch each 64-bit block once and leave the inner predicate
+// loop in a shape compilers vectorize (AVX2 compare + movemask).
+constexpr int64_t kBitsetBlockBits = 64;
+
+inline uint64_t*
+BitsetBlocks(BitsetType& bitset) {
+    return reinterpret_cast<uint64_t*>(boost_ext::get_data(bitset));
+}
+
+inline const uint64_t*
+BitsetBlocks(const BitsetType& bitset) {
+    return reinterpret_cast<const uint64_t*>(boost_ext::get_data(bitset));
+}
+
+// Packs 64 bool bytes into one result block (SWAR movemask, 8 bytes a step).
+inline uint64_t
+PackBoolBytes(const uint8_t* flags) {
+    uint64_t block = 0;
+    for (int64_t k = 0; k < 8; ++k) {
+        uint64_t bytes;
+        std::memcpy(&bytes, flags + 8 * k, 8);
+        block |= ((bytes * 0x0102040810204080ULL) >> 56) << (8 * k);
+    }
+    return block;
+}
+
+namespace detail {
+
+// Predicate loop in compare-to-byte + pack shape: the flags loop is what the
+// vectorizer turns into SIMD compare + mask extraction. Kept as a standalone
+// body so an AVX2-targeted clone below can share the exact same code shape.
+#define MILVUS_EVAL_BLOCKS_BODY                                                               \
+    alignas(64) uint8_t flags[kBitsetBlockBits];                                              \
+    int64_t i = 0;                                                                            \
+    for (; i + kBitsetBlockBits <= size; i += kBitsetBlockBits) {                             \
+        for (int64_t bit = 0; bit < kBitsetBlockBits; ++bit) {                                \
+            /* out-of-line payload prefetch (string rows); no-op for scalars */               \
+            PrefetchSpanRow(data, i + bit, size);                                             \
+            flags[bit] = func(data[i + bit]) ? 1 : 0;                                         \
+        }                                                                                     \
+        blocks[i >> 6] = PackBoolBytes(flags);                                                \
+    }                                                                                         \
+    if (i < size) {                                                                           \
+        uint64_t block = 0;                                                                   \
+        for (int64_t bit = 0; i + bit < size; ++bit) {                                        \
+            block |= static_cast<uint64_t>(static_cast<bool>(func(data[i + bit]))) << bit;    \
+        }                                                                                     \
+        blocks[i >> 6] = block;                                                               \
+    }
+
+template <typename T, typename Func>
+void
+EvalBlocks(const T* data, int64_t size, uint64_t* blocks, Func func) {
+    MILVUS_EVAL_BLOCKS_BODY
+}
+
+#if defined(__x86_64__)
+// same body compiled for AVX2; segcore itself is built for baseline x86-64,
+// so the wide compares only exist in this clone and are gated at runtime
+template <typename T, typename Func>
+__attribute__((target("avx2"))) void
+EvalBlocksAvx2(const T* data, int64_t size, uint64_t* blocks, Func func) {
+    MILVUS_EVAL_BLOCKS_BODY
+}
+#endif
+
+#undef MILVUS_EVAL_BLOCKS_BODY
+
+// two-column variant used by fused compare kernels
+#define MILVUS_EVAL_BLOCKS2_BODY                                                                           \
+    alignas(64) uint8_t flags[kBitsetBlockBits];                                                           \
+    int64_t i = 0;                                                                                         \
+    for (; i + kBitsetBlockBits <= size; i += kBitsetBlockBits) {                                          \
+        for (int64_t bit = 0; bit < kBitsetBlockBits; ++bit) {                                             \
+            PrefetchSpanRow(left, i + bit, size);                                                          \
+            PrefetchSpanRow(right, i + bit, size);                                                         \
+            flags[bit] = func(left[i + bit], right[i + bit]) ? 1 : 0;                                      \
+        }                                                                                                  \
+        blocks[i >> 6] = PackBoolBytes(flags);                                                             \
+    }                                                                                                      \
+    if (i < size) {                                                                                        \
+        uint64_t block = 0;                                                                                \
+        for (int64_t bit = 0; i + bit < size; ++bit) {                                                     \
+            block |= static_cast<uint64_t>(static_cast<bool>(func(left[i + bit], right[i + bit]))) << bit; \
+        }                                                                                                  \
+        blocks[i >> 6] = block;                                                                            \
+    }
+
+template <typename TL, typename TR, typename Func>
+void
+EvalBlocks2(const TL* left, const TR* right, int64_t size, uint64_t* blocks, Func func) {
+    MILVUS_EVAL_BLOCKS2_BODY
+}
+
+#if defined(__x86_64__)
+template <typename TL, typename TR, typename Func>
+__attribute__((target("avx2"))) void
+EvalBlocks2Avx2(const TL* left, const TR* right, int64_t size, uint64_t* blocks, Func func) {
+    MILVUS_EVAL_BLOCKS2_BODY
+}
+#endif
+
+#undef MILVUS_EVAL_BLOCKS2_BODY
+
+// three-column variant used by the generated (compare ∧ range) kernels
+#define MILVUS_EVAL_BLOCKS3_BODY                                                      \
+    alignas(64) uint8_t flags[kBitsetBlockBits];                                      \
+    int64_t i = 0;                                                                    \
+    for (; i + kBitsetBlockBits <= size; i += kBitsetBlockBits) {                     \
+        for (int64_t bit = 0; bit < kBitsetBlockBits; ++bit) {                        \
+            flags[bit] = func(a[i + bit], b[i + bit], c[i + bit]) ? 1 : 0;            \
+        }                                                                             \
+        blocks[i >> 6] = PackBoolBytes(flags);                                        \
+    }                                                                                 \
+    if (i < size) {                                                                   \
+        uint64_t block = 0;                                                           \
+        for (int64_t bit = 0; i + bit < size; ++bit) {                                \
+            block |= static_cast<uint64_t>(                                           \
+                         static_cast<bool>(func(a[i + bit], b[i + bit], c[i + bit]))) \
+                     << bit;                                                          \
+        }                                                                             \
+        blocks[i >> 6] = block;                                                       \
+    }
+
+template <typename TA, typename TB, typename TC, typename Func>
+void
+EvalBlocks3(const TA* a, const TB* b, const TC* c, int64_t size, uint64_t* blocks, Func func) {
+    MILVUS_EVAL_BLOCKS3_BODY
+}
+
+#if defined(__x86_64__)
+template <typename TA, typename TB, typename TC, typename Func>
+__attribute__((target("avx2"))) void
+EvalBlocks3Avx2(const TA* a, const TB* b, const TC* c, int64_t size, uint64_t* blocks, Func func) {
+    MILVUS_EVAL_BLOCKS3_BODY
+}
+#endif
+
+#undef MILVUS_EVAL_BLOCKS3_BODY
+
+}  // namespace detail
+
+// Evaluates func over data[0, size) into the suffix of result starting at
+// the block-aligned bit_offset, whole blocks at a time; unused bits of the
+// last block stay zero, preserving dynamic_bitset's invariant. Arithmetic
+// element types take the AVX2 clone when the CPU has it.
+template <typename T, typename Func>
+void
+EvalElementwiseAt(const T* data, int64_t size, BitsetType& result, int64_t bit_offset, Func func) {
+    Assert(bit_offset % kBitsetBlockBits == 0);
+    Assert(bit_offset + size == static_cast<int64_t>(result.size()));
+    if (size == 0) {
+        return;
+    }
+    auto blocks = BitsetBlocks(result) + bit_offset / kBitsetBlockBits;
+#if defined(__x86_64__)
+    if constexpr (std::is_arithmetic_v<T>) {
+        if (UseSimdAvx2()) {
+            detail::EvalBlocksAvx2(data, size, blocks, func);
+            return;
+        }
+    }
+#endif
+    detail::EvalBlocks(data, size, blocks, func);
+}
+
+// Evaluates func over data[0, size) into result, which must already be
+// sized to `size`.
+template <typename T, typename Func>
+void
+EvalElementwise(const T* data, int64_t size, BitsetType& result, Func func) {
+    Assert(static_cast<int64_t>(result.size()) == size);
+    EvalElementwiseAt(data, size, result, 0, func);
+}
+
+// Two-column counterpart of EvalElementwise for fused compare kernels.
+template <typename TL, typename TR, typename Func>
+void
+EvalBinaryElementwise(const TL* left, const TR* right, int64_t size, BitsetType& result, Func func) {
+    Assert(static_cast<int64_t>(result.size()) == size);
+    if (size == 0) {
+        return;
+    }
+    auto blocks = BitsetBlocks(result);
+#if defined(__x86_64__)
+    if constexpr (std::is_arithmetic_v<TL> && std::is_arithmetic_v<TR>) {
+        if (UseSimdAvx2()) {
+            detail::EvalBlocks2Avx2(left, right, size, blocks, func);
+            return;
+        }
+    }
+#endif
+    detail::EvalBlocks2(left, right, size, blocks, func);
+}
+
+// Three-column counterpart for fused (compare ∧ range) kernels.
+template <typename TA, typename TB, typename TC, typename Func>
+void
+EvalTernaryElementwise(const TA* a, const TB* b, const TC* c, int64_t size, BitsetType& result, Func func) {
+    Assert(static_cast<int64_t>(result.size()) == size);
+    if (size == 0) {
+        return;
+    }
+    auto blocks = BitsetBlocks(result);
+#if defined(__x86_64__)
+    if constexpr (std::is_arithmetic_v<TA> && std::is_arithmetic_v<TB> && std::is_arithmetic_v<TC>) {
+        if (UseSimdAvx2()) {
+            detail::EvalBlocks3Avx2(a, b, c, size, blocks, func);
+            return;
+        }
+    }
+#endif
+    detail::EvalBlocks3(a, b, c, size, blocks, func);
+}
+
+// Bitset whose complement is deferred: flip() only toggles a flag, and a
+// pending complement on either operand is folded into the word pass of the
+// next binary operation (or applied by a single boost flip when the bits are
+// finally taken). NOT(NOT(x)) costs nothing and NOT(a) AND b costs the same
+// one pass as a AND b.
+class LazyBitset {
+ public:
+    LazyBitset() = default;
+    explicit LazyBitset(BitsetType bits) : bits_(std::move(bits)) {
+    }
+
+    size_t
+    size() const {
+        return bits_.size();
+    }
+
+    void
+    flip() {
+        negated_ = !negated_;
+    }
+
+    bool
+    none() const {
+        return negated_ ? bits_.all() : bits_.none();
+    }
+
+    bool
+    all() const {
+        return negated_ ? bits_.none() : bits_.all();
+    }
+
+    void
+    logical_and(LazyBitset&& other) {
+        Assert(bits_.size() == other.bits_.size());
+        if (!negated_ && !other.negated_) {
+            bits_ &= other.bits_;
+            return;
+        }
+        combine(other, [](uint64_t a, uint64_t b) { return a & b; });
+    }
+
+    void
+    logical_or(LazyBitset&& other) {
+        Assert(bits_.size() == other.bits_.size());
+        if (!negated_ && !other.negated_) {
+            bits_ |= other.bits_;
+            return;
+        }
+        combine(other, [](uint64_t a, uint64_t b) { return a | b; });
+    }
+
+    void
+    logical_xor(LazyBitset&& other) {
+        Assert(bits_.size() == other.bits_.size());
+        // complements cancel through xor, so they stay deferred
+        bits_ ^= other.bits_;
+        negated_ = negated_ != other.negated_;
+    }
+
+    void
+    logical_minus(LazyBitset&& other) {
+        // a - b == a AND NOT b
+        other.flip();
+        logical_and(std::move(other));
+    }
+
+    // applies the pending complement, if any, and yields the bits
+    BitsetType
+    take() && {
+        if (negated_) {
+            bits_.flip();
+            negated_ = false;
+        }
+        return std::move(bits_);
+    }
+
+ private:
+    template <typename Op>
+    void
+    combine(const LazyBitset& other, Op op) {
+        auto size = static_cast<int64_t>(bits_.size());
+        auto num_blocks = (size + kBitsetBlockBits - 1) / kBitsetBlockBits;
+        auto dst = BitsetBlocks(bits_);
+        auto src = BitsetBlocks(other.bits_);
+        uint64_t dst_mask = negated_ ? ~uint64_t(0) : 0;
+        uint64_t src_mask = other.negated_ ? ~uint64_t(0) : 0;
+        for (int64_t i = 0; i < num_blocks; ++i) {
+            dst[i] = op(dst[i] ^ dst_mask, src[i] ^ src_mask);
+        }
+        // complementing can raise bits past size; restore dynamic_bitset's
+        // unused-tail-zero invariant
+        if (auto rem = size & (kBitsetBlockBits - 1); rem != 0) {
+            dst[num_blocks - 1] &= (uint64_t(1) << rem) - 1;
+        }
+        negated_ = false;
+    }
+
+    BitsetType bits_;
+    bool negated_ = false;
+};
+
+// ORs src into dst starting at bit `offset`, 64 bits per step: stitches
+// disjoint chunk results in the expression visitors' Assemble pattern and
+// merges whole masks (delete bitmaps) into a query bitset.
+inline void
+AppendBitset(BitsetType& dst, int64_t offset, const BitsetType& src) {
+    auto size = static_cast<int64_t>(src.size());
+    Assert(offset + size <= static_cast<int64_t>(dst.size()));
+    if (size == 0) {
+        return;
+    }
+    auto dst_blocks = BitsetBlocks(dst);
+    auto src_blocks = BitsetBlocks(src);
+    auto num_blocks = (size + kBitsetBlockBits - 1) / kBitsetBlockBits;
+    auto base = offset >> 6;
+    auto shift = offset & 63;
+    for (int64_t i = 0; i < num_blocks; ++i) {
+        auto block = src_blocks[i];
+        dst_blocks[base + i] |= block << shift;
+        if (shift != 0 && (block >> (kBitsetBlockBits - shift)) != 0) {
+            dst_blocks[base + i + 1] |= block >> (kBitsetBlockBits - shift);
+        }
+    }
+}
+
+}  // namespace milvus
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <cstring>
 #include <deque>
+#include <vector>
 #include <boost_ext/dynamic_bitset_ext.hpp>
 #include "exceptions/EasyAssert.h"
 #include "common/Types.h"
@@ -45,16 +47,78 @@ class BitsetView : public faiss::BitsetView {
         }
     }
 
+    // first view bit within *data(); non-zero only for subviews that start
+    // mid-byte (chunk sizes that are not a multiple of 8)
+    int
+    bit_offset() const {
+        return bit_offset_;
+    }
+
+    bool
+    byte_aligned() const {
+        return bit_offset_ == 0;
+    }
+
+    // offset-aware probe; shadows the base class so the repo's own scan
+    // kernels read unaligned views in place
+    bool
+    test(int64_t index) const {
+        auto bit = bit_offset_ + index;
+        return (data()[bit >> 3] >> (bit & 0x7)) & 0x1;
+    }
+
+    // Bit-granular and zero-copy: the view keeps the containing byte's
+    // pointer plus the bit remainder, so any chunk size works without
+    // re-packing the bitmap. Offsets are relative to this view's bits.
     BitsetView
     subview(size_t offset, size_t size) const {
         if (empty()) {
             return BitsetView();
         }
-
-        AssertInfo((offset & 0x7) == 0, "offset is not divisible by 8");
         AssertInfo((offset + size) <= this->size(), "offset + size cross the border.");
-        return BitsetView(data() + (offset >> 3), size);
+        auto bit_begin = bit_offset_ + offset;
+        BitsetView view(data() + (bit_begin >> 3), size);
+        view.bit_offset_ = static_cast<int>(bit_begin & 0x7);
+        return view;
     }
+
+    // Adapter for knowhere, whose bitset ABI is a raw byte array addressed
+    // from bit 0: an unaligned view is re-based by shifting whole words down
+    // into a thread-local staging buffer (one 64-bit load per 8 bytes, not a
+    // per-bit copy); aligned views — every multiple-of-8 chunk size — pass
+    // through untouched. The returned view stays valid until this thread's
+    // next unaligned call, which outlives the knowhere query it feeds.
+    BitsetView
+    as_byte_aligned() const {
+        if (bit_offset_ == 0) {
+            return *this;
+        }
+        const auto num_bits = size();
+        const int64_t dst_bytes = (num_bits + 7) >> 3;
+        const int64_t src_bytes = (bit_offset_ + num_bits + 7) >> 3;
+        thread_local std::vector<uint8_t> staging;
+        staging.resize(dst_bytes);
+        const uint8_t* src = data();
+        const int shift = bit_offset_;
+        int64_t i = 0;
+        for (; i + 8 <= dst_bytes; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, src + i, sizeof(word));
+            // only the byte after the word can spill into it for shift < 8
+            uint64_t next = (i + 8 < src_bytes) ? src[i + 8] : 0;
+            word = (word >> shift) | (next << (64 - shift));
+            std::memcpy(staging.data() + i, &word, sizeof(word));
+        }
+        for (; i < dst_bytes; ++i) {
+            uint32_t lo = static_cast<uint32_t>(src[i]) >> shift;
+            uint32_t hi = (i + 1 < src_bytes) ? static_cast<uint32_t>(src[i + 1]) << (8 - shift) : 0u;
+            staging[i] = static_cast<uint8_t>(lo | hi);
+        }
+        return BitsetView(staging.data(), num_bits);
+    }
+
+ private:
+    int bit_offset_ = 0;
 };
 
 }  // namespace milvus
@@ -0,0 +1,71 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+namespace milvus {
+
+// Thrown from a cancellation checkpoint once the query's token fires; it
+// unwinds the execution stack like any other failure and the C boundary
+// maps it onto an error status.
+class CancelledException : public std::runtime_error {
+ public:
+    CancelledException() : std::runtime_error("query cancelled") {
+    }
+};
+
+// Shared cancellation flag for one query execution. A default-constructed
+// token is inert and never reports cancelled, so checkpoints can poll
+// unconditionally; Make() creates a live token whose Cancel() is visible to
+// every copy. Copies share the flag — the token rides in TaskOptions, so
+// the thread-local options mechanism carries it through every pool fan-out
+// a query performs.
+class CancellationToken {
+ public:
+    CancellationToken() = default;
+
+    static CancellationToken
+    Make() {
+        CancellationToken token;
+        token.flag_ = std::make_shared<std::atomic<bool>>(false);
+        return token;
+    }
+
+    void
+    Cancel() const {
+        if (flag_) {
+            flag_->store(true, std::memory_order_relaxed);
+        }
+    }
+
+    bool
+    IsCancelled() const {
+        return flag_ && flag_->load(std::memory_order_relaxed);
+    }
+
+    // the checkpoint itself: cheap enough for chunk boundaries, a relaxed
+    // load on an inert or unfired token
+    void
+    ThrowIfCancelled() const {
+        if (IsCancelled()) {
+            throw CancelledException();
+        }
+    }
+
+ private:
+    std::shared_ptr<std::atomic<bool>> flag_;
+};
+
+}  // namespace milvus
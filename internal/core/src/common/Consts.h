@@ -29,6 +29,7 @@ const char MAX_LENGTH[] = "max_length";
 // fill followed extra info to binlog file
 const char ORIGIN_SIZE_KEY[] = "original_size";
 const char INDEX_BUILD_ID_KEY[] = "indexBuildID";
+const char PAYLOAD_CRC32C_KEY[] = "payload_crc32c";
 
 const char INDEX_ROOT_PATH[] = "index_files";
 const char RAWDATA_ROOT_PATH[] = "raw_datas";
@@ -0,0 +1,41 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "common/Float16.h"
+#include "common/kernels/Kernels.h"
+
+namespace milvus {
+
+void
+Float32ToFloat16Batch(const float* src, uint16_t* dst, size_t n) {
+    if (auto* fn = kernels::float32_to_float16_batch.Get()) {
+        fn(src, dst, n);
+        return;
+    }
+    // only reachable before the kernel objects have run their static
+    // initializers
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = Float32ToFloat16(src[i]);
+    }
+}
+
+void
+Float16ToFloat32Batch(const uint16_t* src, float* dst, size_t n) {
+    if (auto* fn = kernels::float16_to_float32_batch.Get()) {
+        fn(src, dst, n);
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = Float16ToFloat32(src[i]);
+    }
+}
+
+}  // namespace milvus
@@ -0,0 +1,105 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace milvus {
+
+// IEEE 754 binary16 <-> binary32 conversions. The scalar forms match the
+// hardware F16C instructions bit for bit (round to nearest even, overflow
+// to infinity, NaNs kept quiet), so data written on any machine reads back
+// identically on every other.
+
+inline uint16_t
+Float32ToFloat16(float value) {
+    uint32_t f;
+    std::memcpy(&f, &value, sizeof(f));
+    uint32_t sign = (f >> 16) & 0x8000u;
+    f &= 0x7fffffffu;
+
+    if (f >= 0x7f800000u) {
+        // infinity stays infinity; NaNs are quieted and keep their top
+        // payload bits, matching the hardware converter
+        if (f > 0x7f800000u) {
+            return sign | 0x7e00u | static_cast<uint16_t>((f & 0x7fffffu) >> 13);
+        }
+        return sign | 0x7c00u;
+    }
+    if (f >= 0x47800000u) {
+        // magnitude >= 2^16 overflows the half range
+        return sign | 0x7c00u;
+    }
+    if (f >= 0x38800000u) {
+        // normal half; rounding may carry into the exponent, which is
+        // exactly the right behavior (1.999.. * 2^e rounds to 2^(e+1))
+        uint32_t mant = f & 0x7fffffu;
+        auto h = static_cast<uint16_t>((((f >> 23) - 112u) << 10) | (mant >> 13));
+        uint32_t rest = mant & 0x1fffu;
+        if (rest > 0x1000u || (rest == 0x1000u && (h & 1u))) {
+            ++h;
+        }
+        return sign | h;
+    }
+    if (f >= 0x33000000u) {
+        // subnormal half: align the mantissa with the 2^-24 ulp grid
+        uint32_t shift = 126u - (f >> 23);
+        uint32_t mant = (f & 0x7fffffu) | 0x800000u;
+        auto h = static_cast<uint16_t>(mant >> shift);
+        uint32_t rest = mant & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1u);
+        if (rest > halfway || (rest == halfway && (h & 1u))) {
+            ++h;
+        }
+        return sign | h;
+    }
+    // below 2^-25 everything rounds to signed zero
+    return sign;
+}
+
+inline float
+Float16ToFloat32(uint16_t value) {
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    uint32_t exp = (value >> 10) & 0x1fu;
+    uint32_t mant = value & 0x3ffu;
+    uint32_t f;
+    if (exp == 0x1fu) {
+        // like the hardware converter, signaling NaNs come out quiet
+        f = sign | 0x7f800000u | (mant != 0 ? 0x400000u : 0u) | (mant << 13);
+    } else if (exp != 0) {
+        f = sign | ((exp + 112u) << 23) | (mant << 13);
+    } else if (mant != 0) {
+        // subnormal half is a normal float; shift the leading bit into place
+        uint32_t shift = 0;
+        while ((mant & 0x400u) == 0) {
+            mant <<= 1;
+            ++shift;
+        }
+        f = sign | ((113u - shift) << 23) | ((mant & 0x3ffu) << 13);
+    } else {
+        f = sign;
+    }
+    float out;
+    std::memcpy(&out, &f, sizeof(out));
+    return out;
+}
+
+// bulk forms, hardware-converted (F16C) where the CPU allows
+void
+Float32ToFloat16Batch(const float* src, uint16_t* dst, size_t n);
+
+void
+Float16ToFloat32Batch(const uint16_t* src, float* dst, size_t n);
+
+}  // namespace milvus
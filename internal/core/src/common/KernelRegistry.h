@@ -0,0 +1,68 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+#include "common/SimdDispatch.h"
+
+namespace milvus {
+
+inline constexpr int kNumSimdLevels = 3;
+
+// One dispatch slot per multi-versioned kernel. The same kernel TU is
+// compiled once per instruction-set level (see the milvus_kernels_* object
+// libraries); each build registers its function here from a static
+// initializer, after checking the CPU actually supports its level's full
+// flag set. Slots are constant-initialized, so registration works in any
+// translation-unit order, and callers resolving before all ISA objects have
+// registered simply see fewer candidates.
+//
+// Resolution walks from the process simd level cap downwards and returns
+// the best registered build, re-reading the cap on every call like
+// UseSimdAvx2 does, so lowering the cap at runtime takes effect
+// immediately. Hot call sites amortize the walk by fetching the function
+// pointer once per batch, never per element.
+template <typename Fn>
+class KernelSlot {
+ public:
+    constexpr KernelSlot() = default;
+
+    void
+    Register(SimdLevel level, Fn* fn) {
+        impls_[static_cast<int>(level)].store(fn, std::memory_order_release);
+    }
+
+    // best registered build not above the cap, or nullptr when nothing is
+    // registered yet; callers keep their scalar loop as the fallback
+    Fn*
+    Get() const {
+        auto level = std::min(static_cast<int>(GetSimdLevelCap()), kNumSimdLevels - 1);
+        for (; level >= 0; --level) {
+            if (auto* fn = impls_[level].load(std::memory_order_acquire)) {
+                return fn;
+            }
+        }
+        return nullptr;
+    }
+
+ private:
+    std::atomic<Fn*> impls_[kNumSimdLevels] = {};
+};
+
+}  // namespace milvus
@@ -17,17 +17,27 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <string>
 #include "Types.h"
 
 #include "common/CDataType.h"
 #include "knowhere/index/Index.h"
 
+namespace milvus::segcore {
+class ChunkArena;
+}  // namespace milvus::segcore
+
 struct LoadIndexInfo {
     int64_t field_id;
     CDataType field_type;
     std::map<std::string, std::string> index_params;
     knowhere::IndexPtr index;
+    // when set, AppendIndexSlices stages the deserialized binary buffers in
+    // a 2 MiB hugepage arena instead of the heap; buffers the index retains
+    // keep the arena (and its page backing) alive through their deleters
+    bool enable_hugepages = false;
+    std::shared_ptr<milvus::segcore::ChunkArena> index_arena;
 };
 
 // NOTE: field_id can be system field
@@ -38,6 +48,9 @@ struct LoadFieldDataInfo {
     //    const void* blob = nullptr;
     const milvus::DataArray* field_data;
     int64_t row_count = -1;
+    // when set, the segment may keep the payload alive and defer
+    // materialization of the column until its first use
+    std::shared_ptr<const milvus::DataArray> owned_data = nullptr;
 };
 
 struct LoadDeletedRecordInfo {
@@ -0,0 +1,87 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <algorithm>
+#include <mutex>
+
+#include "common/Metrics.h"
+#include "utils/Json.h"
+
+namespace milvus {
+
+MetricsRegistry&
+MetricsRegistry::GetInstance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricCounter&
+MetricsRegistry::GetCounter(const std::string& name) {
+    {
+        std::shared_lock lock(mutex_);
+        auto it = counters_.find(name);
+        if (it != counters_.end()) {
+            return *it->second;
+        }
+    }
+    std::unique_lock lock(mutex_);
+    auto& counter = counters_[name];
+    if (counter == nullptr) {
+        counter = std::make_unique<MetricCounter>();
+    }
+    return *counter;
+}
+
+MetricHistogram&
+MetricsRegistry::GetHistogram(const std::string& name) {
+    {
+        std::shared_lock lock(mutex_);
+        auto it = histograms_.find(name);
+        if (it != histograms_.end()) {
+            return *it->second;
+        }
+    }
+    std::unique_lock lock(mutex_);
+    auto& histogram = histograms_[name];
+    if (histogram == nullptr) {
+        histogram = std::make_unique<MetricHistogram>();
+    }
+    return *histogram;
+}
+
+std::string
+MetricsRegistry::Snapshot() const {
+    json counters = json::object();
+    json histograms = json::object();
+    {
+        std::shared_lock lock(mutex_);
+        for (auto& [name, counter] : counters_) {
+            counters[name] = counter->Value();
+        }
+        for (auto& [name, histogram] : histograms_) {
+            json buckets = json::object();
+            for (int i = 0; i < MetricHistogram::kNumBuckets; ++i) {
+                auto count = histogram->BucketCount(i);
+                if (count == 0) {
+                    continue;
+                }
+                // bucket i holds values below 2^i; render the upper bound
+                auto upper_bound = i == 0 ? int64_t(0) : int64_t(1) << std::min(i, 62);
+                buckets[std::to_string(upper_bound)] = count;
+            }
+            histograms[name] = json{{"count", histogram->Count()}, {"sum", histogram->Sum()}, {"buckets", buckets}};
+        }
+    }
+    json snapshot{{"counters", counters}, {"histograms", histograms}};
+    return snapshot.dump();
+}
+
+}  // namespace milvus
@@ -0,0 +1,117 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+
+namespace milvus {
+
+// always-on counter for hot paths: one relaxed fetch_add per increment,
+// padded onto its own cache line so unrelated counters never false-share
+class MetricCounter {
+ public:
+    void
+    Increment(int64_t n = 1) {
+        value_.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    int64_t
+    Value() const {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+ private:
+    alignas(64) std::atomic<int64_t> value_{0};
+};
+
+// lock-free histogram with power-of-two buckets: bucket i counts values in
+// [2^(i-1), 2^i), bucket 0 takes zero and negative values, the last bucket
+// is open-ended; one relaxed fetch_add per observation
+class MetricHistogram {
+ public:
+    static constexpr int kNumBuckets = 33;
+
+    void
+    Observe(int64_t value) {
+        buckets_[BucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    int64_t
+    BucketCount(int bucket) const {
+        return buckets_[bucket].load(std::memory_order_relaxed);
+    }
+
+    int64_t
+    Count() const {
+        int64_t total = 0;
+        for (auto& bucket : buckets_) {
+            total += bucket.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    int64_t
+    Sum() const {
+        return sum_.load(std::memory_order_relaxed);
+    }
+
+    static int
+    BucketOf(int64_t value) {
+        if (value <= 0) {
+            return 0;
+        }
+        int bucket = 64 - __builtin_clzll(static_cast<uint64_t>(value));
+        return bucket < kNumBuckets ? bucket : kNumBuckets - 1;
+    }
+
+ private:
+    alignas(64) std::array<std::atomic<int64_t>, kNumBuckets> buckets_{};
+    std::atomic<int64_t> sum_{0};
+};
+
+// process-wide registry of named counters and histograms. Lookups take a
+// shared lock, so hot paths cache the returned reference in a function-local
+// static and pay only the atomic increment afterwards; instruments are never
+// removed, so references stay valid for the process lifetime
+class MetricsRegistry {
+ public:
+    static MetricsRegistry&
+    GetInstance();
+
+    MetricCounter&
+    GetCounter(const std::string& name);
+
+    MetricHistogram&
+    GetHistogram(const std::string& name);
+
+    // json rendering of every instrument for the Go metrics scraper:
+    // {"counters": {name: value}, "histograms": {name: {count, sum,
+    // buckets: {upper_bound: count}}}}; empty buckets are omitted
+    std::string
+    Snapshot() const;
+
+ private:
+    MetricsRegistry() = default;
+
+    mutable std::shared_mutex mutex_;
+    std::map<std::string, std::unique_ptr<MetricCounter>> counters_;
+    std::map<std::string, std::unique_ptr<MetricHistogram>> histograms_;
+};
+
+}  // namespace milvus
@@ -0,0 +1,134 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#if defined(__linux__)
+#include <fstream>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace milvus::numa {
+
+// Best-effort NUMA placement helpers. Everything degrades to a no-op when
+// the kernel interfaces are unavailable (non-linux, single-node machines,
+// restricted containers), so callers never need to branch on support.
+
+#if defined(__linux__) && defined(SYS_mbind)
+
+// linux/mempolicy.h values; spelled out to avoid a libnuma dependency
+constexpr int kMpolPreferred = 1;
+
+// asks the kernel to place the pages of [addr, addr + len) on `node`;
+// already-touched pages stay where they are, which is fine for fresh slabs
+inline bool
+BindMemoryToNode(void* addr, size_t len, int64_t node) {
+    if (node < 0) {
+        return false;
+    }
+    unsigned long nodemask = 1ul << node;
+    return syscall(SYS_mbind, addr, len, kMpolPreferred, &nodemask, sizeof(nodemask) * 8, 0) == 0;
+}
+
+inline const cpu_set_t*
+CpusOfNode(int64_t node) {
+    static std::mutex mutex;
+    static std::map<int64_t, cpu_set_t> cache;
+    std::lock_guard lck(mutex);
+    auto iter = cache.find(node);
+    if (iter != cache.end()) {
+        return &iter->second;
+    }
+    std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (!in.good()) {
+        return nullptr;
+    }
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    std::string list;
+    std::getline(in, list);
+    // cpulist looks like "0-15,32-47"
+    size_t pos = 0;
+    while (pos < list.size()) {
+        auto end = list.find(',', pos);
+        auto range = list.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        auto dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu) {
+            CPU_SET(cpu, &cpus);
+        }
+        if (end == std::string::npos) {
+            break;
+        }
+        pos = end + 1;
+    }
+    return &cache.emplace(node, cpus).first->second;
+}
+
+// pins the calling thread onto the node's cpus for the lifetime of the
+// guard, restoring the previous mask afterwards; used by search workers so
+// a query runs next to the segment's memory
+class ScopedThreadNodeBind {
+ public:
+    explicit ScopedThreadNodeBind(int64_t node) {
+        if (node < 0) {
+            return;
+        }
+        auto cpus = CpusOfNode(node);
+        if (cpus == nullptr) {
+            return;
+        }
+        if (sched_getaffinity(0, sizeof(previous_), &previous_) != 0) {
+            return;
+        }
+        bound_ = sched_setaffinity(0, sizeof(*cpus), cpus) == 0;
+    }
+
+    ~ScopedThreadNodeBind() {
+        if (bound_) {
+            sched_setaffinity(0, sizeof(previous_), &previous_);
+        }
+    }
+
+    ScopedThreadNodeBind(const ScopedThreadNodeBind&) = delete;
+    ScopedThreadNodeBind&
+    operator=(const ScopedThreadNodeBind&) = delete;
+
+ private:
+    cpu_set_t previous_;
+    bool bound_ = false;
+};
+
+#else
+
+inline bool
+BindMemoryToNode(void* addr, size_t len, int64_t node) {
+    return false;
+}
+
+class ScopedThreadNodeBind {
+ public:
+    explicit ScopedThreadNodeBind(int64_t node) {
+    }
+};
+
+#endif
+
+}  // namespace milvus::numa
@@ -0,0 +1,36 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/QueryProfile.h"
+
+#include "utils/Json.h"
+
+namespace milvus {
+
+std::string
+QueryProfile::ToJson() const {
+    json profile{
+        {"predicate_ns", predicate_ns_},
+        {"vector_search_ns", vector_search_ns_},
+        {"rows_scanned", rows_scanned_},
+        {"rows_filtered", rows_filtered_},
+        {"chunks_on_index", chunks_on_index_},
+        {"chunks_brute_forced", chunks_brute_forced_},
+    };
+    return profile.dump();
+}
+
+}  // namespace milvus
@@ -0,0 +1,61 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace milvus {
+
+// Per-query execution profile collected while a plan runs inside segcore.
+// The counters are cheap enough to fill unconditionally; rendering to json
+// only happens when the caller asks for it through the C API.
+struct QueryProfile {
+    // wall time spent evaluating the predicate and building the masking bitset
+    int64_t predicate_ns_ = 0;
+    // wall time spent in vector search (index and brute-force combined)
+    int64_t vector_search_ns_ = 0;
+    // rows visible to the query, i.e. the segment's active count
+    int64_t rows_scanned_ = 0;
+    // rows masked out by predicate, timestamp and delete filtering
+    int64_t rows_filtered_ = 0;
+    // chunks answered by a built index vs. scanned brute-force
+    int64_t chunks_on_index_ = 0;
+    int64_t chunks_brute_forced_ = 0;
+
+    std::string
+    ToJson() const;
+};
+
+// writes the elapsed wall time into the bound counter on scope exit
+class ProfileTimer {
+ public:
+    explicit ProfileTimer(int64_t& sink) : sink_(sink), start_(std::chrono::steady_clock::now()) {
+    }
+
+    ~ProfileTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        sink_ += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
+ private:
+    int64_t& sink_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace milvus
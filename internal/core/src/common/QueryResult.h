@@ -27,6 +27,7 @@
 #include <NamedType/named_type.hpp>
 
 #include "common/FieldMeta.h"
+#include "common/QueryProfile.h"
 #include "pb/schema.pb.h"
 
 namespace milvus {
@@ -65,6 +66,9 @@ struct SearchResult {
 
     // used for reduce, filter invalid pk, get real topks count
     std::vector<size_t> topk_per_nq_prefix_sum_;
+
+    // filled while the plan executes; rendered on demand via GetSearchProfile
+    QueryProfile profile_;
 };
 
 using SearchResultPtr = std::shared_ptr<SearchResult>;
@@ -102,6 +102,13 @@ class Schema {
     const FieldMeta&
     operator[](FieldId field_id) const {
         Assert(field_id.get() >= 0);
+        // hot path: user field ids are dense from START_USER_FIELDID, so
+        // this resolves with one array read instead of a hash probe
+        auto offset = field_id.get() - START_USER_FIELDID;
+        if (offset >= 0 && offset < static_cast<int64_t>(metas_by_offset_.size()) &&
+            metas_by_offset_[offset].has_value()) {
+            return metas_by_offset_[offset].value();
+        }
         AssertInfo(fields_.find(field_id) != fields_.end(),
                    "Cannot find field with field_id: " + std::to_string(field_id.get()));
         return fields_.at(field_id);
@@ -156,6 +163,14 @@ class Schema {
         fields_.emplace(field_id, field_meta);
         field_ids_.emplace_back(field_id);
 
+        auto dense_offset = field_id.get() - START_USER_FIELDID;
+        if (dense_offset >= 0) {
+            if (dense_offset >= static_cast<int64_t>(metas_by_offset_.size())) {
+                metas_by_offset_.resize(dense_offset + 1);
+            }
+            metas_by_offset_[dense_offset] = field_meta;
+        }
+
         auto field_sizeof = field_meta.get_sizeof();
         total_sizeof_ += field_sizeof;
     }
@@ -167,6 +182,10 @@ class Schema {
     // this is where data holds
     std::unordered_map<FieldId, FieldMeta> fields_;
 
+    // field_id - START_USER_FIELDID -> FieldMeta, the hot operator[] path;
+    // sparse ids (none in practice) fall back to the map above
+    std::vector<std::optional<FieldMeta>> metas_by_offset_;
+
     // a mapping for random access
     std::unordered_map<FieldName, FieldId> name_ids_;  // field_name -> field_id
     std::unordered_map<FieldId, FieldName> id_names_;  // field_id -> field_name
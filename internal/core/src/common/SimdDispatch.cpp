@@ -0,0 +1,76 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/SimdDispatch.h"
+
+namespace milvus {
+
+namespace detail {
+std::atomic<int> simd_level_cap{static_cast<int>(SimdLevel::AVX2)};
+}  // namespace detail
+
+void
+SetSimdLevelCap(SimdLevel cap) {
+    detail::simd_level_cap.store(static_cast<int>(cap), std::memory_order_relaxed);
+}
+
+SimdLevel
+GetSimdLevelCap() {
+    return static_cast<SimdLevel>(detail::simd_level_cap.load(std::memory_order_relaxed));
+}
+
+SimdLevel
+GetEffectiveSimdLevel() {
+    if (UseSimdAvx2()) {
+        return SimdLevel::AVX2;
+    }
+    if (UseSimdSse42()) {
+        return SimdLevel::SSE42;
+    }
+    return SimdLevel::Scalar;
+}
+
+bool
+SimdLevelSupported(SimdLevel level) {
+#if defined(__x86_64__)
+    switch (level) {
+        case SimdLevel::AVX2:
+            // the avx2 kernel objects are compiled with -mavx2 -mfma -mf16c,
+            // so all three must be present before any of their code may run
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+        case SimdLevel::SSE42:
+            return __builtin_cpu_supports("sse4.2");
+        default:
+            return true;
+    }
+#else
+    return level == SimdLevel::Scalar;
+#endif
+}
+
+const char*
+SimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX2:
+            return "avx2";
+        case SimdLevel::SSE42:
+            return "sse4_2";
+        default:
+            return "scalar";
+    }
+}
+
+}  // namespace milvus
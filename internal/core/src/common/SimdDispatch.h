@@ -0,0 +1,82 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+
+namespace milvus {
+
+// Instruction-set levels segcore's multi-versioned kernels (bitset
+// expression evaluation, gather, distance rounding, crc) can select.
+// knowhere picks its own kernels, but both are driven from the same
+// simd_type config so one knob governs every vectorized path.
+enum class SimdLevel : int {
+    Scalar = 0,
+    SSE42 = 1,
+    AVX2 = 2,
+};
+
+namespace detail {
+// highest level the process may use; the effective choice is the minimum
+// of this cap and what the CPU supports
+extern std::atomic<int> simd_level_cap;
+}  // namespace detail
+
+// caps kernel dispatch for the whole process; meant to be set once at init
+// (e.g. to dodge frequency throttling on affected SKUs), but safe to lower
+// at runtime since every dispatch re-reads the cap
+void
+SetSimdLevelCap(SimdLevel cap);
+
+SimdLevel
+GetSimdLevelCap();
+
+// effective level actually selected: cap clamped to CPU support
+SimdLevel
+GetEffectiveSimdLevel();
+
+// "avx2" / "sse4_2" / "scalar"
+const char*
+SimdLevelName(SimdLevel level);
+
+// whether this CPU can run code compiled at `level`'s full flag set (the
+// flags the milvus_kernels_* object libraries are built with, not just the
+// level's namesake extension)
+bool
+SimdLevelSupported(SimdLevel level);
+
+inline bool
+UseSimdAvx2() {
+#if defined(__x86_64__)
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2 && detail::simd_level_cap.load(std::memory_order_relaxed) >= static_cast<int>(SimdLevel::AVX2);
+#else
+    return false;
+#endif
+}
+
+inline bool
+UseSimdSse42() {
+#if defined(__x86_64__)
+    static const bool has_sse42 = __builtin_cpu_supports("sse4.2");
+    return has_sse42 && detail::simd_level_cap.load(std::memory_order_relaxed) >= static_cast<int>(SimdLevel::SSE42);
+#else
+    return false;
+#endif
+}
+
+}  // namespace milvus
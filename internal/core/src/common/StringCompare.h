@@ -0,0 +1,205 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "common/SimdDispatch.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace milvus {
+
+// Comparison kernels for VarChar predicate scans. std::string_view::compare
+// walks both strings a byte at a time with a branch per character; the
+// filtering path runs that per row over every chunk. The kernels here find
+// the first differing byte with wide compares (64-bit XOR, or SSE4.2/AVX2
+// cmpeq + movemask for longer strings) and decide the ordering from that
+// single byte, so the per-row cost is a handful of word operations for
+// typical short strings and ~1 instruction per 32 bytes for long ones.
+
+namespace detail {
+
+// index of the first byte where a and b differ within [0, n), or n if the
+// ranges are equal
+inline size_t
+FirstMismatchScalar(const char* a, const char* b, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint64_t wa;
+        uint64_t wb;
+        memcpy(&wa, a + i, 8);
+        memcpy(&wb, b + i, 8);
+        if (auto diff = wa ^ wb; diff != 0) {
+            // little-endian: the lowest set bit marks the first differing byte
+            return i + (__builtin_ctzll(diff) >> 3);
+        }
+    }
+    for (; i < n; ++i) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+    return n;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) inline size_t
+FirstMismatchSse42(const char* a, const char* b, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        auto neq = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb))) ^ 0xFFFFu;
+        if (neq != 0) {
+            return i + __builtin_ctz(neq);
+        }
+    }
+    return i + FirstMismatchScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline size_t
+FirstMismatchAvx2(const char* a, const char* b, size_t n) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        auto va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        auto vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        auto neq = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+        if (neq != 0) {
+            return i + __builtin_ctz(neq);
+        }
+    }
+    return i + FirstMismatchScalar(a + i, b + i, n - i);
+}
+#endif
+
+}  // namespace detail
+
+// length-aware dispatch: short inputs go straight to the word loop (the
+// vector setup would cost more than it saves), long ones to the widest unit
+// the CPU supports
+inline size_t
+FirstMismatch(const char* a, const char* b, size_t n) {
+#if defined(__x86_64__)
+    if (n >= 32 && UseSimdAvx2()) {
+        return detail::FirstMismatchAvx2(a, b, n);
+    }
+    if (n >= 16 && UseSimdSse42()) {
+        return detail::FirstMismatchSse42(a, b, n);
+    }
+#endif
+    return detail::FirstMismatchScalar(a, b, n);
+}
+
+// three-way lexicographic compare (unsigned byte order, same ordering as
+// std::string_view::compare): <0, 0, >0
+inline int
+CompareStringViews(std::string_view a, std::string_view b) {
+    auto n = std::min(a.size(), b.size());
+    auto pos = FirstMismatch(a.data(), b.data(), n);
+    if (pos < n) {
+        return static_cast<uint8_t>(a[pos]) < static_cast<uint8_t>(b[pos]) ? -1 : 1;
+    }
+    if (a.size() == b.size()) {
+        return 0;
+    }
+    return a.size() < b.size() ? -1 : 1;
+}
+
+// first min(len, 8) bytes packed big-endian into a uint64_t, zero-padded.
+// Big-endian packing makes integer order match lexicographic byte order, and
+// zero padding is exact for the shorter-is-smaller rule: a shorter string's
+// padded prefix can never exceed a longer one that shares its bytes.
+inline uint64_t
+BigEndianPrefix(const char* data, size_t len) {
+    uint64_t word = 0;
+    if (len >= 8) {
+        memcpy(&word, data, 8);
+    } else if (len > 0) {
+        memcpy(&word, data, len);
+    }
+    return __builtin_bswap64(word);
+}
+
+// fixed comparison operand for a predicate scan: owns the value and
+// precomputes its prefix word once, so each row starts with a single integer
+// compare and only rows sharing the first 8 bytes touch the tail
+class StringOperand {
+ public:
+    explicit StringOperand(std::string value)
+        : value_(std::move(value)), prefix_(BigEndianPrefix(value_.data(), value_.size())) {
+    }
+
+    const std::string&
+    value() const {
+        return value_;
+    }
+
+    uint64_t
+    prefix() const {
+        return prefix_;
+    }
+
+ private:
+    std::string value_;
+    uint64_t prefix_;
+};
+
+// three-way compare of a row against the operand with the prefix early exit
+inline int
+PrefixedCompare(std::string_view x, const StringOperand& val) {
+    auto xp = BigEndianPrefix(x.data(), x.size());
+    if (xp != val.prefix()) {
+        return xp < val.prefix() ? -1 : 1;
+    }
+    if (x.size() <= 8 || val.value().size() <= 8) {
+        // equal prefixes and one side fits in the word: the shorter string is
+        // a proper prefix of the longer, so length decides
+        if (x.size() == val.value().size()) {
+            return 0;
+        }
+        return x.size() < val.value().size() ? -1 : 1;
+    }
+    return CompareStringViews(x.substr(8), std::string_view(val.value()).substr(8));
+}
+
+inline bool
+PrefixedEquals(std::string_view x, const StringOperand& val) {
+    if (x.size() != val.value().size()) {
+        return false;
+    }
+    if (BigEndianPrefix(x.data(), x.size()) != val.prefix()) {
+        return false;
+    }
+    if (x.size() <= 8) {
+        return true;
+    }
+    return FirstMismatch(x.data() + 8, val.value().data() + 8, x.size() - 8) == x.size() - 8;
+}
+
+// does x start with the operand (OpType::PrefixMatch)
+inline bool
+PrefixedStartsWith(std::string_view x, const StringOperand& val) {
+    auto n = val.value().size();
+    if (x.size() < n) {
+        return false;
+    }
+    return FirstMismatch(x.data(), val.value().data(), n) == n;
+}
+
+}  // namespace milvus
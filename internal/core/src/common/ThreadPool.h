@@ -0,0 +1,280 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "common/Cancellation.h"
+
+namespace milvus {
+
+// Each role owns its own fixed pool so a QueryNode can partition cores:
+// search keeps its reserved threads for p99 latency while index builds and
+// segment loads queue behind their own workers.
+enum class ThreadPoolRole { Search = 0, Build = 1, Load = 2 };
+
+// Dispatch class within a pool. Workers pick by weighted round-robin
+// (interactive 8 : normal 3 : batch 1), so a burst of analytics scans can
+// no longer starve p99-sensitive lookups while batch still keeps a
+// guaranteed share of dispatches.
+enum class TaskPriority { Interactive = 0, Normal = 1, Batch = 2 };
+inline constexpr int kNumTaskPriorities = 3;
+
+struct TaskOptions {
+    TaskPriority priority = TaskPriority::Normal;
+    // zero (the default) means no hint; a task whose deadline falls within
+    // the dispatch slack skips the weighted queues entirely
+    std::chrono::steady_clock::time_point deadline{};
+    // inert by default; an abandoned query's checkpoints poll this, and it
+    // inherits across nested submits like the rest of the options
+    CancellationToken cancellation;
+};
+
+// a deadline this close counts as nearly expired at dispatch time
+inline constexpr std::chrono::microseconds kDeadlineSlack{10000};
+
+// The options Submit calls on this thread inherit when none are given
+// explicitly. The C API entry points install the caller's class here, and
+// the pool re-installs a task's options around its execution, so a search
+// fanning out per-chunk work keeps its class across nested submits.
+class ScopedTaskOptions {
+ public:
+    explicit ScopedTaskOptions(TaskOptions options) : saved_(current_) {
+        current_ = options;
+    }
+    ScopedTaskOptions(const ScopedTaskOptions&) = delete;
+    ScopedTaskOptions&
+    operator=(const ScopedTaskOptions&) = delete;
+    ~ScopedTaskOptions() {
+        current_ = saved_;
+    }
+
+    static TaskOptions
+    Current() {
+        return current_;
+    }
+
+ private:
+    TaskOptions saved_;
+    inline static thread_local TaskOptions current_{};
+};
+
+// Fixed-size worker pool shared by segcore background work (chunk index
+// builds, parallel loads). Keep tasks coarse: the queue is a single mutex,
+// which is fine for chunk-granularity jobs but not for per-row ones.
+class ThreadPool {
+ public:
+    explicit ThreadPool(int num_threads) {
+        for (int i = 0; i < num_threads; ++i) {
+            workers_.emplace_back([this] { Worker(); });
+        }
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool&
+    operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lck(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    template <typename Fn>
+    auto
+    Submit(Fn fn) -> std::future<decltype(fn())> {
+        return Submit(ScopedTaskOptions::Current(), std::move(fn));
+    }
+
+    template <typename Fn>
+    auto
+    Submit(TaskOptions options, Fn fn) -> std::future<decltype(fn())> {
+        auto task = std::make_shared<std::packaged_task<decltype(fn())()>>(std::move(fn));
+        auto future = task->get_future();
+        {
+            std::lock_guard lck(mutex_);
+            Entry entry{[task] { (*task)(); }, options};
+            if (options.deadline != std::chrono::steady_clock::time_point{}) {
+                // deadline tasks live in their own min-heap so the nearest
+                // one can skip ahead once it is about to expire
+                deadline_tasks_.push_back(std::move(entry));
+                std::push_heap(deadline_tasks_.begin(), deadline_tasks_.end(), DeadlineLater);
+            } else {
+                class_queues_[static_cast<int>(options.priority)].push_back(std::move(entry));
+            }
+        }
+        cv_.notify_one();
+        return future;
+    }
+
+    int
+    num_threads() const {
+        return workers_.size();
+    }
+
+    // tasks waiting for a worker; together with active_count this is the
+    // backlog the Go side watches to spot an overloaded role
+    int64_t
+    queue_depth() const {
+        std::lock_guard lck(mutex_);
+        int64_t depth = deadline_tasks_.size();
+        for (auto& queue : class_queues_) {
+            depth += queue.size();
+        }
+        return depth;
+    }
+
+    int64_t
+    active_count() const {
+        return active_.load();
+    }
+
+    // must be called before the role's pool is first used; later calls have
+    // no effect since the workers are already running
+    static void
+    SetNumThreads(ThreadPoolRole role, int num_threads) {
+        configured_sizes_[static_cast<int>(role)] = num_threads;
+    }
+
+    // per-role pool, created with the configured size on first use
+    static ThreadPool&
+    GetInstance(ThreadPoolRole role) {
+        switch (role) {
+            case ThreadPoolRole::Search: {
+                static ThreadPool pool(EffectiveNumThreads(ThreadPoolRole::Search));
+                return pool;
+            }
+            case ThreadPoolRole::Build: {
+                static ThreadPool pool(EffectiveNumThreads(ThreadPoolRole::Build));
+                return pool;
+            }
+            default: {
+                static ThreadPool pool(EffectiveNumThreads(ThreadPoolRole::Load));
+                return pool;
+            }
+        }
+    }
+
+ private:
+    static int
+    EffectiveNumThreads(ThreadPoolRole role) {
+        auto configured = configured_sizes_[static_cast<int>(role)].load();
+        if (configured > 0) {
+            return configured;
+        }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    struct Entry {
+        std::function<void()> fn;
+        TaskOptions options;
+    };
+
+    static bool
+    DeadlineLater(const Entry& lhs, const Entry& rhs) {
+        return lhs.options.deadline > rhs.options.deadline;
+    }
+
+    bool
+    Empty() const {
+        if (!deadline_tasks_.empty()) {
+            return false;
+        }
+        return std::all_of(std::begin(class_queues_), std::end(class_queues_),
+                           [](const std::deque<Entry>& queue) { return queue.empty(); });
+    }
+
+    // callers hold mutex_ and guarantee at least one task is queued
+    Entry
+    PopNext() {
+        auto class_queues_empty = std::all_of(std::begin(class_queues_), std::end(class_queues_),
+                                              [](const std::deque<Entry>& queue) { return queue.empty(); });
+        // a nearly-expired deadline task skips the weighted queues; an
+        // otherwise idle dispatch also drains the deadline heap early
+        if (!deadline_tasks_.empty() &&
+            (class_queues_empty ||
+             deadline_tasks_.front().options.deadline <= std::chrono::steady_clock::now() + kDeadlineSlack)) {
+            std::pop_heap(deadline_tasks_.begin(), deadline_tasks_.end(), DeadlineLater);
+            auto entry = std::move(deadline_tasks_.back());
+            deadline_tasks_.pop_back();
+            return entry;
+        }
+        // weighted round-robin over the classes: interactive dominates the
+        // cycle but batch always keeps its share, so it cannot be starved
+        for (;;) {
+            for (int cls = 0; cls < kNumTaskPriorities; ++cls) {
+                if (credits_[cls] > 0 && !class_queues_[cls].empty()) {
+                    --credits_[cls];
+                    auto entry = std::move(class_queues_[cls].front());
+                    class_queues_[cls].pop_front();
+                    return entry;
+                }
+            }
+            // every non-empty class is out of credit: start a new cycle
+            credits_[0] = 8;
+            credits_[1] = 3;
+            credits_[2] = 1;
+        }
+    }
+
+    void
+    Worker() {
+        for (;;) {
+            Entry entry;
+            {
+                std::unique_lock lck(mutex_);
+                cv_.wait(lck, [this] { return stop_ || !Empty(); });
+                if (stop_ && Empty()) {
+                    return;
+                }
+                entry = PopNext();
+            }
+            active_.fetch_add(1);
+            {
+                // nested submits from this task inherit its class/deadline
+                ScopedTaskOptions scope(entry.options);
+                entry.fn();
+            }
+            active_.fetch_sub(1);
+        }
+    }
+
+    inline static std::atomic<int> configured_sizes_[3] = {};
+
+    std::vector<std::thread> workers_;
+    std::deque<Entry> class_queues_[kNumTaskPriorities];
+    // min-heap on deadline via DeadlineLater
+    std::vector<Entry> deadline_tasks_;
+    int credits_[kNumTaskPriorities] = {8, 3, 1};
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::atomic<int64_t> active_{0};
+    bool stop_ = false;
+};
+
+}  // namespace milvus
@@ -12,39 +12,29 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include "exceptions/EasyAssert.h"
 
 namespace milvus {
+// string_view parameters so both std::string values and the views handed out
+// by string columns match without a copy
 inline bool
-PrefixMatch(const std::string& str, const std::string& prefix) {
-    auto ret = strncmp(str.c_str(), prefix.c_str(), prefix.length());
-    if (ret != 0) {
+PrefixMatch(std::string_view str, std::string_view prefix) {
+    if (prefix.length() > str.length()) {
         return false;
     }
 
-    return true;
+    return str.compare(0, prefix.length(), prefix) == 0;
 }
 
 inline bool
-PostfixMatch(const std::string& str, const std::string& postfix) {
+PostfixMatch(std::string_view str, std::string_view postfix) {
     if (postfix.length() > str.length()) {
         return false;
     }
 
-    int offset = str.length() - postfix.length();
-    auto ret = strncmp(str.c_str() + offset, postfix.c_str(), postfix.length());
-    if (ret != 0) {
-        return false;
-    }
-    //
-    //    int i = postfix.length() - 1;
-    //    int j = str.length() - 1;
-    //    for (; i >= 0; i--, j--) {
-    //        if (postfix[i] != str[j]) {
-    //            return false;
-    //        }
-    //    }
-    return true;
+    auto offset = str.length() - postfix.length();
+    return str.compare(offset, postfix.length(), postfix) == 0;
 }
 
 inline int64_t
@@ -34,6 +34,15 @@ class BinaryVector : public VectorTrait {
     static constexpr auto metric_type = DataType::VECTOR_BINARY;
 };
 
+// storage trait, not a schema type: a VECTOR_FLOAT column whose rows are
+// kept as IEEE half-precision bits (see SegcoreConfig's fp16 storage mode);
+// data converts to float32 at the query and output boundaries
+class Float16Vector : public VectorTrait {
+ public:
+    using embedded_type = uint16_t;
+    static constexpr auto metric_type = DataType::VECTOR_FLOAT;
+};
+
 template <typename VectorType>
 inline constexpr int64_t
 element_sizeof(int64_t dim) {
@@ -61,7 +70,9 @@ struct EmbeddedTypeImpl<T, std::enable_if_t<IsScalar<T>>> {
 
 template <typename T>
 struct EmbeddedTypeImpl<T, std::enable_if_t<IsVector<T>>> {
-    using type = std::conditional_t<std::is_same_v<T, FloatVector>, float, uint8_t>;
+    using type = std::conditional_t<std::is_same_v<T, FloatVector>,
+                                    float,
+                                    std::conditional_t<std::is_same_v<T, Float16Vector>, uint16_t, uint8_t>>;
 };
 
 template <typename T>
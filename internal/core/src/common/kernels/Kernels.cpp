@@ -0,0 +1,91 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// This translation unit is compiled once per instruction-set level, with
+// MILVUS_KERNEL_LEVEL and the matching -m flags set by the milvus_kernels_*
+// object libraries in src/CMakeLists.txt. Every kernel here has internal
+// linkage, so the per-level builds coexist in one binary; each build
+// registers its functions into the shared dispatch slots at static-init
+// time, after checking the CPU supports its level's full flag set. Write
+// kernels as plain loops in the shape the vectorizer handles - the per-level
+// clones come from the build flags; intrinsics are for the few spots where
+// auto-vectorization cannot reach (guarded on the level's predefines).
+
+#include "common/kernels/Kernels.h"
+
+#include "common/Float16.h"
+#include "common/SimdDispatch.h"
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+#ifndef MILVUS_KERNEL_LEVEL
+#error "Kernels.cpp must be built through a milvus_kernels_* object library"
+#endif
+
+namespace milvus::kernels {
+
+#if MILVUS_KERNEL_LEVEL == 0
+// slot definitions live in the scalar build, which exists on every platform
+KernelSlot<Float32ToFloat16Fn> float32_to_float16_batch;
+KernelSlot<Float16ToFloat32Fn> float16_to_float32_batch;
+#endif
+
+namespace {
+
+void
+Float32ToFloat16BatchImpl(const float* src, uint16_t* dst, size_t n) {
+    size_t i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= n; i += 8) {
+        auto f = _mm256_loadu_ps(src + i);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = Float32ToFloat16(src[i]);
+    }
+}
+
+void
+Float16ToFloat32BatchImpl(const uint16_t* src, float* dst, size_t n) {
+    size_t i = 0;
+#if defined(__F16C__)
+    for (; i + 8 <= n; i += 8) {
+        auto h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = Float16ToFloat32(src[i]);
+    }
+}
+
+constexpr auto kLevel = static_cast<SimdLevel>(MILVUS_KERNEL_LEVEL);
+
+const bool registered = [] {
+    if (!SimdLevelSupported(kLevel)) {
+        return false;
+    }
+    float32_to_float16_batch.Register(kLevel, &Float32ToFloat16BatchImpl);
+    float16_to_float32_batch.Register(kLevel, &Float16ToFloat32BatchImpl);
+    return true;
+}();
+
+}  // namespace
+
+}  // namespace milvus::kernels
@@ -0,0 +1,39 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/KernelRegistry.h"
+
+namespace milvus::kernels {
+
+// Dispatch slots for the multi-versioned leaf kernels. Kernels.cpp is
+// compiled once per instruction-set level (the milvus_kernels_* object
+// libraries in src/CMakeLists.txt); each build registers its functions
+// here. New kernels go into Kernels.cpp with a slot added below - the
+// per-level clones then come from the build, not from hand-written
+// target-attribute copies.
+
+using Float32ToFloat16Fn = void(const float* src, uint16_t* dst, size_t n);
+using Float16ToFloat32Fn = void(const uint16_t* src, float* dst, size_t n);
+
+extern KernelSlot<Float32ToFloat16Fn> float32_to_float16_batch;
+extern KernelSlot<Float16ToFloat32Fn> float16_to_float32_batch;
+
+}  // namespace milvus::kernels
@@ -22,7 +22,9 @@ std::string MINIO_ADDRESS = "localhost:9000";   // NOLINT
 std::string MINIO_ACCESS_KEY = "minioadmin";    // NOLINT
 std::string MINIO_ACCESS_VALUE = "minioadmin";  // NOLINT
 std::string MINIO_BUCKET_NAME = "a-bucket";     // NOLINT
-std::string LOCAL_BUCKET_NAME = "/tmp/milvus";  // NOLINT
+std::string LOCAL_BUCKET_NAME = "/tmp/milvus";        // NOLINT
+std::string CACHE_PATH_PREFIX = "/tmp/milvus/cache";  // NOLINT
+uint64_t CACHE_CAPACITY_BYTES = 32ULL << 30;
 bool MINIO_USE_SSL = false;
 
 void
@@ -85,4 +87,24 @@ GetLocalBucketName() {
     return LOCAL_BUCKET_NAME;
 }
 
+void
+SetCachePathPrefix(const std::string& path_prefix) {
+    CACHE_PATH_PREFIX = path_prefix.c_str();
+}
+
+std::string
+GetCachePathPrefix() {
+    return CACHE_PATH_PREFIX;
+}
+
+void
+SetCacheCapacity(uint64_t capacity_bytes) {
+    CACHE_CAPACITY_BYTES = capacity_bytes;
+}
+
+uint64_t
+GetCacheCapacity() {
+    return CACHE_CAPACITY_BYTES;
+}
+
 }  // namespace milvus::ChunkMangerConfig
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace milvus::ChunkMangerConfig {
@@ -56,4 +57,16 @@ SetLocalBucketName(const std::string& path_prefix);
 std::string
 GetLocalBucketName();
 
+void
+SetCachePathPrefix(const std::string& path_prefix);
+
+std::string
+GetCachePathPrefix();
+
+void
+SetCacheCapacity(uint64_t capacity_bytes);
+
+uint64_t
+GetCacheCapacity();
+
 }  // namespace milvus::ChunkMangerConfig
@@ -17,6 +17,7 @@
 #include <mutex>
 
 #include "ConfigKnowhere.h"
+#include "common/SimdDispatch.h"
 #include "exceptions/EasyAssert.h"
 #include "easyloggingpp/easylogging++.h"
 #include "log/Log.h"
@@ -54,19 +55,28 @@ KnowhereInitImpl(const char* conf_file) {
 std::string
 KnowhereSetSimdType(const char* value) {
     knowhere::KnowhereConfig::SimdType simd_type;
+    // the same knob caps segcore's own multi-versioned kernels, so one
+    // config setting governs every vectorized path in the process
+    milvus::SimdLevel segcore_cap;
     if (strcmp(value, "auto") == 0) {
         simd_type = knowhere::KnowhereConfig::SimdType::AUTO;
+        segcore_cap = milvus::SimdLevel::AVX2;
     } else if (strcmp(value, "avx512") == 0) {
         simd_type = knowhere::KnowhereConfig::SimdType::AVX512;
+        segcore_cap = milvus::SimdLevel::AVX2;
     } else if (strcmp(value, "avx2") == 0) {
         simd_type = knowhere::KnowhereConfig::SimdType::AVX2;
+        segcore_cap = milvus::SimdLevel::AVX2;
     } else if (strcmp(value, "avx") == 0 || strcmp(value, "sse4_2") == 0) {
         simd_type = knowhere::KnowhereConfig::SimdType::SSE4_2;
+        segcore_cap = milvus::SimdLevel::SSE42;
     } else {
         PanicInfo("invalid SIMD type: " + std::string(value));
     }
     try {
-        return knowhere::KnowhereConfig::SetSimdType(simd_type);
+        auto real_type = knowhere::KnowhereConfig::SetSimdType(simd_type);
+        milvus::SetSimdLevelCap(segcore_cap);
+        return real_type;
     } catch (std::exception& e) {
         LOG_SERVER_ERROR_ << e.what();
         PanicInfo(e.what());
@@ -27,7 +27,8 @@
 namespace milvus {
 using ErrorCodeEnum = proto::common::ErrorCode;
 namespace impl {
-void
+// cold: only reached on assertion failure, keep it out of hot code layout
+__attribute__((cold)) void
 EasyAssertInfo(bool value,
                std::string_view expr_str,
                std::string_view filename,
@@ -54,11 +55,14 @@ class SegcoreError : public std::runtime_error {
 
 }  // namespace milvus
 
+/* the `info` expression is captured by the macro and only evaluated inside
+ * the failure branch, so message formatting (to_string, concatenation) costs
+ * nothing on the hot path; the branch is marked unlikely to keep the
+ * formatting code off the fall-through path */
 #define AssertInfo(expr, info)                                                          \
     do {                                                                                \
         auto _expr_res = bool(expr);                                                    \
-        /* call func only when needed */                                                \
-        if (!_expr_res) {                                                               \
+        if (__builtin_expect(!_expr_res, false)) {                                      \
             milvus::impl::EasyAssertInfo(_expr_res, #expr, __FILE__, __LINE__, (info)); \
         }                                                                               \
     } while (0)
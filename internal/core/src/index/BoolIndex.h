@@ -11,15 +11,87 @@
 
 #pragma once
 
-#include <vector>
+#include <cstring>
 #include <memory>
-#include "index/ScalarIndexSort.h"
+#include <stdexcept>
+#include <vector>
+
+#include "index/Meta.h"
+#include "index/ScalarIndex.h"
 
 namespace milvus::scalar {
 
-// TODO: optimize here.
-class BoolIndex : public ScalarIndexSort<bool> {
+// a boolean column only ever partitions rows into a true-set and its
+// complement, so the index is just the packed true bitmap; every query
+// reduces to copy/flip/set/reset over whole words instead of the
+// sort-and-binary-search machinery of ScalarIndexSort<bool>
+class BoolIndex : public ScalarIndex<bool> {
  public:
+    BoolIndex() = default;
+
+    int64_t
+    Size() override {
+        return trues_.num_blocks() * sizeof(TargetBitmap::block_type);
+    }
+
+    BinarySet
+    Serialize(const Config& config) override {
+        AssertInfo(is_built_, "index has not been built");
+
+        std::shared_ptr<uint8_t[]> meta(new uint8_t[sizeof(uint64_t)]);
+        uint64_t count = count_;
+        memcpy(meta.get(), &count, sizeof(count));
+
+        std::vector<TargetBitmap::block_type> blocks(trues_.num_blocks());
+        boost::to_block_range(trues_, blocks.begin());
+        auto bitmap_len = blocks.size() * sizeof(TargetBitmap::block_type);
+        std::shared_ptr<uint8_t[]> bitmap(new uint8_t[bitmap_len]);
+        memcpy(bitmap.get(), blocks.data(), bitmap_len);
+
+        BinarySet res_set;
+        res_set.Append(BOOL_INDEX_META, meta, sizeof(uint64_t));
+        res_set.Append(BOOL_INDEX_BITMAP, bitmap, bitmap_len);
+        return res_set;
+    }
+
+    void
+    Load(const BinarySet& set) override {
+        auto meta = set.GetByName(BOOL_INDEX_META);
+        uint64_t count;
+        memcpy(&count, meta->data.get(), sizeof(count));
+        count_ = count;
+
+        auto bitmap = set.GetByName(BOOL_INDEX_BITMAP);
+        std::vector<TargetBitmap::block_type> blocks(bitmap->size / sizeof(TargetBitmap::block_type));
+        memcpy(blocks.data(), bitmap->data.get(), bitmap->size);
+        trues_.resize(count_);
+        boost::from_block_range(blocks.begin(), blocks.end(), trues_);
+        is_built_ = true;
+    }
+
+    size_t
+    Count() override {
+        return count_;
+    }
+
+    void
+    Build(size_t n, const bool* values) override {
+        if (is_built_) {
+            return;
+        }
+        if (n == 0) {
+            throw std::invalid_argument("BoolIndex cannot build null values!");
+        }
+        count_ = n;
+        trues_.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            if (values[i]) {
+                trues_.set(i);
+            }
+        }
+        is_built_ = true;
+    }
+
     void
     BuildWithDataset(const DatasetPtr& dataset) override {
         auto size = knowhere::GetDatasetRows(dataset);
@@ -28,6 +100,91 @@ class BoolIndex : public ScalarIndexSort<bool> {
         arr.ParseFromArray(data, size);
         Build(arr.data().size(), arr.data().data());
     }
+
+    const TargetBitmapPtr
+    In(size_t n, const bool* values) override {
+        AssertInfo(is_built_, "index has not been built");
+        bool want_true = false;
+        bool want_false = false;
+        for (size_t i = 0; i < n; ++i) {
+            (values[i] ? want_true : want_false) = true;
+        }
+        return compose(want_true, want_false);
+    }
+
+    const TargetBitmapPtr
+    NotIn(size_t n, const bool* values) override {
+        AssertInfo(is_built_, "index has not been built");
+        bool want_true = false;
+        bool want_false = false;
+        for (size_t i = 0; i < n; ++i) {
+            (values[i] ? want_true : want_false) = true;
+        }
+        return compose(!want_true, !want_false);
+    }
+
+    const TargetBitmapPtr
+    Range(bool value, OpType op) override {
+        AssertInfo(is_built_, "index has not been built");
+        auto satisfies = [&](bool candidate) {
+            switch (op) {
+                case OpType::LessThan:
+                    return candidate < value;
+                case OpType::LessEqual:
+                    return candidate <= value;
+                case OpType::GreaterThan:
+                    return candidate > value;
+                case OpType::GreaterEqual:
+                    return candidate >= value;
+                default:
+                    throw std::invalid_argument(std::string("Invalid OperatorType: ") + std::to_string((int)op) +
+                                                "!");
+            }
+        };
+        return compose(satisfies(true), satisfies(false));
+    }
+
+    const TargetBitmapPtr
+    Range(bool lower_bound_value, bool lb_inclusive, bool upper_bound_value, bool ub_inclusive) override {
+        AssertInfo(is_built_, "index has not been built");
+        if (lower_bound_value > upper_bound_value ||
+            (lower_bound_value == upper_bound_value && !(lb_inclusive && ub_inclusive))) {
+            return std::make_unique<TargetBitmap>(count_);
+        }
+        auto within = [&](bool candidate) {
+            return (candidate > lower_bound_value || (candidate == lower_bound_value && lb_inclusive)) &&
+                   (candidate < upper_bound_value || (candidate == upper_bound_value && ub_inclusive));
+        };
+        return compose(within(true), within(false));
+    }
+
+    bool
+    Reverse_Lookup(size_t offset) const override {
+        AssertInfo(offset < count_, "out of range of total count");
+        AssertInfo(is_built_, "index has not been built");
+        return trues_.test(offset);
+    }
+
+ private:
+    // one word-level pass builds any answer from the true bitmap and the
+    // two "which values match" flags
+    TargetBitmapPtr
+    compose(bool want_true, bool want_false) const {
+        auto bitset = std::make_unique<TargetBitmap>(trues_);
+        if (want_true && want_false) {
+            bitset->set();
+        } else if (want_false) {
+            bitset->flip();
+        } else if (!want_true) {
+            bitset->reset();
+        }
+        return bitset;
+    }
+
+ private:
+    TargetBitmap trues_;
+    size_t count_ = 0;
+    bool is_built_ = false;
 };
 using BoolIndexPtr = std::unique_ptr<BoolIndex>;
 
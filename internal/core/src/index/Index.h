@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <knowhere/index/Index.h>
 #include <knowhere/common/Dataset.h>
@@ -35,6 +36,16 @@ class IndexBase : public Index {
 
     virtual size_t
     Count() = 0;
+
+    // build-time parallelism from the index build params:
+    // 0 lets the index decide by size, 1 forces the serial path
+    void
+    SetBuildParallelism(int64_t parallelism) {
+        build_parallelism_ = parallelism;
+    }
+
+ protected:
+    int64_t build_parallelism_ = 0;
 };
 using IndexBasePtr = std::unique_ptr<IndexBase>;
 
@@ -10,7 +10,9 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <string>
+#include "index/ScalarIndexBitmap.h"
 #include "index/ScalarIndexSort.h"
+#include "index/StringIndexHash.h"
 #include "index/StringIndexMarisa.h"
 #include "index/IndexType.h"
 #include "index/BoolIndex.h"
@@ -20,12 +22,16 @@ namespace milvus::scalar {
 template <typename T>
 inline ScalarIndexPtr<T>
 IndexFactory::CreateIndex(const std::string& index_type) {
+    if (index_type == INDEX_TYPE_BITMAP) {
+        return CreateScalarIndexBitmap<T>();
+    }
     return CreateScalarIndexSort<T>();
 }
 
 template <>
 inline ScalarIndexPtr<bool>
 IndexFactory::CreateIndex(const std::string& index_type) {
+    // booleans are already a two-bitmap index regardless of requested type
     return CreateBoolIndex();
 }
 
@@ -33,6 +39,12 @@ template <>
 inline ScalarIndexPtr<std::string>
 IndexFactory::CreateIndex(const std::string& index_type) {
 #if defined(__linux__) || defined(__APPLE__)
+    if (index_type == INDEX_TYPE_BITMAP) {
+        return CreateScalarIndexBitmap<std::string>();
+    }
+    if (index_type == INDEX_TYPE_HASH) {
+        return CreateStringIndexHash();
+    }
     return CreateStringIndexMarisa();
 #else
     throw std::runtime_error("unsupported platform");
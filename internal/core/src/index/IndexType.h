@@ -13,4 +13,9 @@
 
 namespace milvus::scalar {
 constexpr const char* INDEX_TYPE_MARISA = "marisa";
-}
+constexpr const char* INDEX_TYPE_SORT = "sort";
+// posting bitmap per distinct value, for low-cardinality columns
+constexpr const char* INDEX_TYPE_BITMAP = "bitmap";
+// equality-only hash table, for high-cardinality string columns
+constexpr const char* INDEX_TYPE_HASH = "hash";
+}  // namespace milvus::scalar
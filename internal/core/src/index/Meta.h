@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 namespace milvus::scalar {
 constexpr const char* OPERATOR_TYPE = "operator_type";
 constexpr const char* RANGE_VALUE = "range_value";
@@ -20,8 +22,19 @@ constexpr const char* UPPER_BOUND_VALUE = "upper_bound_value";
 constexpr const char* UPPER_BOUND_INCLUSIVE = "upper_bound_inclusive";
 constexpr const char* PREFIX_VALUE = "prefix_value";
 constexpr const char* MARISA_TRIE = "marisa_trie";
+constexpr const char* BUILD_PARALLELISM = "build_parallelism";
+// below this row count an unconfigured build stays serial
+constexpr size_t PARALLEL_BUILD_ROW_THRESHOLD = 1 << 20;
 // below configurations will be persistent, do not edit them.
 constexpr const char* MARISA_TRIE_INDEX = "marisa_trie_index";
 constexpr const char* MARISA_STR_IDS = "marisa_trie_str_ids";
+constexpr const char* MARISA_STR_IDS_TO_OFFSETS = "marisa_trie_str_ids_to_offsets";
 constexpr const char* FLAT_STR_INDEX = "flat_str_index";
+constexpr const char* STRING_SORT_META = "string_sort_meta";
+constexpr const char* STRING_SORT_ARENA = "string_sort_arena";
+constexpr const char* BOOL_INDEX_META = "bool_index_meta";
+constexpr const char* BOOL_INDEX_BITMAP = "bool_index_bitmap";
+constexpr const char* BITMAP_INDEX_DATA = "bitmap_index_data";
+constexpr const char* STRING_HASH_META = "string_hash_meta";
+constexpr const char* STRING_HASH_ARENA = "string_hash_arena";
 }  // namespace milvus::scalar
@@ -16,6 +16,7 @@
 #include <string>
 #include <boost/dynamic_bitset.hpp>
 #include "index/Index.h"
+#include "index/TargetRanges.h"
 #include "common/Types.h"
 
 namespace milvus::scalar {
@@ -41,6 +42,24 @@ class ScalarIndex : public IndexBase {
     virtual T
     Reverse_Lookup(size_t offset) const = 0;
 
+    // compressed hit-set variants: the defaults expand the bitmap form,
+    // sorted indexes override them to enumerate hits directly in O(hits)
+    virtual TargetRangesPtr
+    InAsRanges(size_t n, const T* values) {
+        return std::make_unique<TargetRanges>(TargetRanges::FromBitmap(*In(n, values)));
+    }
+
+    virtual TargetRangesPtr
+    RangeAsRanges(T value, OpType op) {
+        return std::make_unique<TargetRanges>(TargetRanges::FromBitmap(*Range(value, op)));
+    }
+
+    virtual TargetRangesPtr
+    RangeAsRanges(T lower_bound_value, bool lb_inclusive, T upper_bound_value, bool ub_inclusive) {
+        return std::make_unique<TargetRanges>(
+            TargetRanges::FromBitmap(*Range(lower_bound_value, lb_inclusive, upper_bound_value, ub_inclusive)));
+    }
+
     const TargetBitmapPtr
     Query(const DatasetPtr& dataset) override;
 };
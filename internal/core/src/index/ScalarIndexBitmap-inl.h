@@ -0,0 +1,236 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <pb/schema.pb.h>
+
+#include "index/Meta.h"
+#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
+
+namespace milvus::scalar {
+
+template <typename T>
+inline void
+ScalarIndexBitmap<T>::Build(size_t n, const T* values) {
+    if (is_built_) {
+        return;
+    }
+    if (n == 0) {
+        throw std::invalid_argument("ScalarIndexBitmap cannot build null values!");
+    }
+    count_ = n;
+    for (size_t i = 0; i < n; ++i) {
+        postings_.try_emplace(values[i], count_).first->second.set(i);
+    }
+    is_built_ = true;
+}
+
+template <typename T>
+inline void
+ScalarIndexBitmap<T>::BuildWithDataset(const DatasetPtr& dataset) {
+    auto size = knowhere::GetDatasetRows(dataset);
+    auto data = knowhere::GetDatasetTensor(dataset);
+    if constexpr (std::is_same_v<T, std::string>) {
+        // string datasets carry a serialized StringArray, not a flat tensor
+        proto::schema::StringArray arr;
+        arr.ParseFromArray(data, size);
+        std::vector<std::string> vecs{arr.data().begin(), arr.data().end()};
+        Build(vecs.size(), vecs.data());
+    } else {
+        Build(size, reinterpret_cast<const T*>(data));
+    }
+}
+
+template <typename T>
+inline TargetBitmapPtr
+ScalarIndexBitmap<T>::merge(typename std::map<T, TargetBitmap>::const_iterator first,
+                            typename std::map<T, TargetBitmap>::const_iterator last) const {
+    auto bitset = std::make_unique<TargetBitmap>(count_);
+    for (; first != last; ++first) {
+        *bitset |= first->second;
+    }
+    return bitset;
+}
+
+template <typename T>
+inline const TargetBitmapPtr
+ScalarIndexBitmap<T>::In(size_t n, const T* values) {
+    AssertInfo(is_built_, "index has not been built");
+    auto bitset = std::make_unique<TargetBitmap>(count_);
+    for (size_t i = 0; i < n; ++i) {
+        auto it = postings_.find(values[i]);
+        if (it != postings_.end()) {
+            *bitset |= it->second;
+        }
+    }
+    return bitset;
+}
+
+template <typename T>
+inline const TargetBitmapPtr
+ScalarIndexBitmap<T>::NotIn(size_t n, const T* values) {
+    auto bitset = In(n, values);
+    bitset->flip();
+    return bitset;
+}
+
+template <typename T>
+inline const TargetBitmapPtr
+ScalarIndexBitmap<T>::Range(T value, OpType op) {
+    AssertInfo(is_built_, "index has not been built");
+    switch (op) {
+        case OpType::LessThan:
+            return merge(postings_.begin(), postings_.lower_bound(value));
+        case OpType::LessEqual:
+            return merge(postings_.begin(), postings_.upper_bound(value));
+        case OpType::GreaterThan:
+            return merge(postings_.upper_bound(value), postings_.end());
+        case OpType::GreaterEqual:
+            return merge(postings_.lower_bound(value), postings_.end());
+        default:
+            throw std::invalid_argument(std::string("Invalid OperatorType: ") + std::to_string((int)op) + "!");
+    }
+}
+
+template <typename T>
+inline const TargetBitmapPtr
+ScalarIndexBitmap<T>::Range(T lower_bound_value, bool lb_inclusive, T upper_bound_value, bool ub_inclusive) {
+    AssertInfo(is_built_, "index has not been built");
+    if (lower_bound_value > upper_bound_value ||
+        (lower_bound_value == upper_bound_value && !(lb_inclusive && ub_inclusive))) {
+        return std::make_unique<TargetBitmap>(count_);
+    }
+    auto first = lb_inclusive ? postings_.lower_bound(lower_bound_value) : postings_.upper_bound(lower_bound_value);
+    auto last = ub_inclusive ? postings_.upper_bound(upper_bound_value) : postings_.lower_bound(upper_bound_value);
+    return merge(first, last);
+}
+
+template <typename T>
+inline T
+ScalarIndexBitmap<T>::Reverse_Lookup(size_t offset) const {
+    AssertInfo(offset < count_, "out of range of total count");
+    AssertInfo(is_built_, "index has not been built");
+    for (const auto& [value, posting] : postings_) {
+        if (posting.test(offset)) {
+            return value;
+        }
+    }
+    throw std::runtime_error("bitmap index corrupted: row missing from postings");
+}
+
+template <typename T>
+inline int64_t
+ScalarIndexBitmap<T>::Size() {
+    int64_t total = 0;
+    for (const auto& [value, posting] : postings_) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            total += value.size();
+        } else {
+            total += sizeof(T);
+        }
+        total += posting.num_blocks() * sizeof(typename TargetBitmap::block_type);
+    }
+    return total;
+}
+
+template <typename T>
+inline BinarySet
+ScalarIndexBitmap<T>::Serialize(const Config& config) {
+    AssertInfo(is_built_, "index has not been built");
+
+    // one blob: uint64 count, uint64 cardinality, then per distinct value
+    // in ascending order the value (raw for arithmetic types, uint32
+    // length + bytes for strings) followed by its posting blocks
+    auto num_blocks = TargetBitmap(count_).num_blocks();
+    auto blocks_len = num_blocks * sizeof(typename TargetBitmap::block_type);
+    size_t total_len = 2 * sizeof(uint64_t);
+    for (const auto& [value, posting] : postings_) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            total_len += sizeof(uint32_t) + value.size();
+        } else {
+            total_len += sizeof(T);
+        }
+        total_len += blocks_len;
+    }
+
+    std::shared_ptr<uint8_t[]> blob(new uint8_t[total_len]);
+    auto* p = blob.get();
+    uint64_t count = count_;
+    uint64_t cardinality = postings_.size();
+    memcpy(p, &count, sizeof(count));
+    p += sizeof(count);
+    memcpy(p, &cardinality, sizeof(cardinality));
+    p += sizeof(cardinality);
+
+    std::vector<typename TargetBitmap::block_type> blocks(num_blocks);
+    for (const auto& [value, posting] : postings_) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            uint32_t len = value.size();
+            memcpy(p, &len, sizeof(len));
+            p += sizeof(len);
+            memcpy(p, value.data(), len);
+            p += len;
+        } else {
+            memcpy(p, &value, sizeof(T));
+            p += sizeof(T);
+        }
+        boost::to_block_range(posting, blocks.begin());
+        memcpy(p, blocks.data(), blocks_len);
+        p += blocks_len;
+    }
+
+    BinarySet res_set;
+    res_set.Append(BITMAP_INDEX_DATA, blob, total_len);
+    return res_set;
+}
+
+template <typename T>
+inline void
+ScalarIndexBitmap<T>::Load(const BinarySet& index_binary) {
+    auto blob = index_binary.GetByName(BITMAP_INDEX_DATA);
+    const auto* p = blob->data.get();
+
+    uint64_t count;
+    uint64_t cardinality;
+    memcpy(&count, p, sizeof(count));
+    p += sizeof(count);
+    memcpy(&cardinality, p, sizeof(cardinality));
+    p += sizeof(cardinality);
+    count_ = count;
+
+    auto num_blocks = TargetBitmap(count_).num_blocks();
+    std::vector<typename TargetBitmap::block_type> blocks(num_blocks);
+    auto blocks_len = num_blocks * sizeof(typename TargetBitmap::block_type);
+
+    postings_.clear();
+    for (uint64_t i = 0; i < cardinality; ++i) {
+        T value;
+        if constexpr (std::is_same_v<T, std::string>) {
+            uint32_t len;
+            memcpy(&len, p, sizeof(len));
+            p += sizeof(len);
+            value.assign(reinterpret_cast<const char*>(p), len);
+            p += len;
+        } else {
+            memcpy(&value, p, sizeof(T));
+            p += sizeof(T);
+        }
+        memcpy(blocks.data(), p, blocks_len);
+        p += blocks_len;
+        auto& posting = postings_.try_emplace(std::move(value), count_).first->second;
+        boost::from_block_range(blocks.begin(), blocks.end(), posting);
+    }
+    is_built_ = true;
+}
+
+}  // namespace milvus::scalar
@@ -0,0 +1,109 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "index/ScalarIndex.h"
+
+namespace milvus::scalar {
+
+// posting-bitmap index for low-cardinality columns (status/region style:
+// a handful of distinct values over millions of rows). Every distinct value
+// maps to a packed bitmap of the rows holding it, so equality and IN
+// predicates are a map lookup plus word-level ORs, and range predicates OR
+// the postings of the ordered value range. Memory and serialized size scale
+// with cardinality * rows/8, so the sort index remains the better fit for
+// high-cardinality columns.
+template <typename T>
+class ScalarIndexBitmap : public ScalarIndex<T> {
+    static_assert(std::is_arithmetic_v<T> || std::is_same_v<T, std::string>,
+                  "ScalarIndexBitmap supports arithmetic and string types only");
+
+ public:
+    ScalarIndexBitmap() = default;
+
+    BinarySet
+    Serialize(const Config& config) override;
+
+    void
+    Load(const BinarySet& index_binary) override;
+
+    void
+    BuildWithDataset(const DatasetPtr& dataset) override;
+
+    size_t
+    Count() override {
+        return count_;
+    }
+
+    void
+    Build(size_t n, const T* values) override;
+
+    const TargetBitmapPtr
+    In(size_t n, const T* values) override;
+
+    const TargetBitmapPtr
+    NotIn(size_t n, const T* values) override;
+
+    const TargetBitmapPtr
+    Range(T value, OpType op) override;
+
+    const TargetBitmapPtr
+    Range(T lower_bound_value, bool lb_inclusive, T upper_bound_value, bool ub_inclusive) override;
+
+    T
+    Reverse_Lookup(size_t offset) const override;
+
+    int64_t
+    Size() override;
+
+    size_t
+    Cardinality() const {
+        return postings_.size();
+    }
+
+    bool
+    IsBuilt() const {
+        return is_built_;
+    }
+
+ private:
+    // OR the postings of [first, last) into one result bitmap
+    TargetBitmapPtr
+    merge(typename std::map<T, TargetBitmap>::const_iterator first,
+          typename std::map<T, TargetBitmap>::const_iterator last) const;
+
+ private:
+    // ordered so range predicates can walk the value range directly
+    std::map<T, TargetBitmap> postings_;
+    size_t count_ = 0;
+    bool is_built_ = false;
+};
+
+template <typename T>
+using ScalarIndexBitmapPtr = std::unique_ptr<ScalarIndexBitmap<T>>;
+
+}  // namespace milvus::scalar
+
+#include "index/ScalarIndexBitmap-inl.h"
+
+namespace milvus::scalar {
+template <typename T>
+inline ScalarIndexBitmapPtr<T>
+CreateScalarIndexBitmap() {
+    return std::make_unique<ScalarIndexBitmap<T>>();
+}
+}  // namespace milvus::scalar
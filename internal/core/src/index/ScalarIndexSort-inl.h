@@ -11,8 +11,13 @@
 
 #include <algorithm>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <pb/schema.pb.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/task_arena.h>
 #include <vector>
 #include <string>
 #include "knowhere/common/Log.h"
@@ -59,10 +64,31 @@ ScalarIndexSort<T>::build() {
         // todo: throw an exception
         throw std::invalid_argument("ScalarIndexSort cannot build null values!");
     }
-    std::sort(data_.begin(), data_.end());
-    for (size_t i = 0; i < data_.size(); ++i) {
-        idx_to_offsets_[data_[i].idx_] = i;
+    auto parallelism = build_parallelism_;
+    if (parallelism <= 0) {
+        parallelism = data_.size() >= PARALLEL_BUILD_ROW_THRESHOLD ? std::thread::hardware_concurrency() : 1;
     }
+    if (parallelism > 1) {
+        tbb::task_arena arena(parallelism);
+        arena.execute([&] {
+            tbb::parallel_sort(data_.begin(), data_.end());
+            // every element scatters to a distinct slot, safe to fill in parallel
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, data_.size()),
+                              [&](const tbb::blocked_range<size_t>& range) {
+                                  for (auto i = range.begin(); i != range.end(); ++i) {
+                                      idx_to_offsets_[data_[i].idx_] = i;
+                                  }
+                              });
+        });
+    } else {
+        std::sort(data_.begin(), data_.end());
+        for (size_t i = 0; i < data_.size(); ++i) {
+            idx_to_offsets_[data_[i].idx_] = i;
+        }
+    }
+    data_view_ = data_.data();
+    idx_to_offsets_view_ = idx_to_offsets_.data();
+    count_ = data_.size();
     is_built_ = true;
 }
 
@@ -71,23 +97,61 @@ inline BinarySet
 ScalarIndexSort<T>::Serialize(const Config& config) {
     AssertInfo(is_built_, "index has not been built");
 
-    auto index_data_size = data_.size() * sizeof(IndexStructure<T>);
-    std::shared_ptr<uint8_t[]> index_data(new uint8_t[index_data_size]);
-    memcpy(index_data.get(), data_.data(), index_data_size);
+    if constexpr (std::is_trivially_copyable_v<T>) {
+        // flat format: the loader can search the buffer in place instead
+        // of copying it back into vectors and rebuilding the offsets
+        auto data_offset = FlatIndexAlign(sizeof(FlatIndexHeader));
+        auto offsets_offset = FlatIndexAlign(data_offset + count_ * sizeof(IndexStructure<T>));
+        auto total_size = offsets_offset + count_ * sizeof(size_t);
+        std::shared_ptr<uint8_t[]> flat(new uint8_t[total_size]);
+        memset(flat.get(), 0, data_offset);
+        FlatIndexHeader header{SCALAR_INDEX_FLAT_MAGIC, SCALAR_INDEX_FLAT_VERSION, count_};
+        memcpy(flat.get(), &header, sizeof(header));
+        memcpy(flat.get() + data_offset, data_view_, count_ * sizeof(IndexStructure<T>));
+        memset(flat.get() + data_offset + count_ * sizeof(IndexStructure<T>), 0,
+               offsets_offset - data_offset - count_ * sizeof(IndexStructure<T>));
+        memcpy(flat.get() + offsets_offset, idx_to_offsets_view_, count_ * sizeof(size_t));
+
+        BinarySet res_set;
+        res_set.Append("index_flat", flat, total_size);
+        return res_set;
+    } else {
+        auto index_data_size = data_.size() * sizeof(IndexStructure<T>);
+        std::shared_ptr<uint8_t[]> index_data(new uint8_t[index_data_size]);
+        memcpy(index_data.get(), data_.data(), index_data_size);
 
-    std::shared_ptr<uint8_t[]> index_length(new uint8_t[sizeof(size_t)]);
-    auto index_size = data_.size();
-    memcpy(index_length.get(), &index_size, sizeof(size_t));
+        std::shared_ptr<uint8_t[]> index_length(new uint8_t[sizeof(size_t)]);
+        auto index_size = data_.size();
+        memcpy(index_length.get(), &index_size, sizeof(size_t));
 
-    BinarySet res_set;
-    res_set.Append("index_data", index_data, index_data_size);
-    res_set.Append("index_length", index_length, sizeof(size_t));
-    return res_set;
+        BinarySet res_set;
+        res_set.Append("index_data", index_data, index_data_size);
+        res_set.Append("index_length", index_length, sizeof(size_t));
+        return res_set;
+    }
 }
 
 template <typename T>
 inline void
 ScalarIndexSort<T>::Load(const BinarySet& index_binary) {
+    if (index_binary.Contains("index_flat")) {
+        auto flat = index_binary.GetByName("index_flat");
+        FlatIndexHeader header;
+        memcpy(&header, flat->data.get(), sizeof(header));
+        AssertInfo(header.magic == SCALAR_INDEX_FLAT_MAGIC, "invalid flat scalar index magic");
+        AssertInfo(header.version == SCALAR_INDEX_FLAT_VERSION, "unsupported flat scalar index version");
+
+        // keep the serialized buffer and search it in place
+        load_buf_ = flat->data;
+        count_ = header.count;
+        auto data_offset = FlatIndexAlign(sizeof(FlatIndexHeader));
+        auto offsets_offset = FlatIndexAlign(data_offset + count_ * sizeof(IndexStructure<T>));
+        data_view_ = reinterpret_cast<const IndexStructure<T>*>(load_buf_.get() + data_offset);
+        idx_to_offsets_view_ = reinterpret_cast<const size_t*>(load_buf_.get() + offsets_offset);
+        is_built_ = true;
+        return;
+    }
+
     size_t index_size;
     auto index_length = index_binary.GetByName("index_length");
     memcpy(&index_size, index_length->data.get(), (size_t)index_length->size);
@@ -99,6 +163,9 @@ ScalarIndexSort<T>::Load(const BinarySet& index_binary) {
     for (size_t i = 0; i < data_.size(); ++i) {
         idx_to_offsets_[data_[i].idx_] = i;
     }
+    data_view_ = data_.data();
+    idx_to_offsets_view_ = idx_to_offsets_.data();
+    count_ = data_.size();
     is_built_ = true;
 }
 
@@ -106,10 +173,10 @@ template <typename T>
 inline const TargetBitmapPtr
 ScalarIndexSort<T>::In(const size_t n, const T* values) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(data_.size());
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
     for (size_t i = 0; i < n; ++i) {
-        auto lb = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        auto ub = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
+        auto lb = std::lower_bound(data_view_, data_view_ + count_, IndexStructure<T>(*(values + i)));
+        auto ub = std::upper_bound(data_view_, data_view_ + count_, IndexStructure<T>(*(values + i)));
         for (; lb < ub; ++lb) {
             if (lb->a_ != *(values + i)) {
                 std::cout << "error happens in ScalarIndexSort<T>::In, experted value is: " << *(values + i)
@@ -125,11 +192,11 @@ template <typename T>
 inline const TargetBitmapPtr
 ScalarIndexSort<T>::NotIn(const size_t n, const T* values) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(data_.size());
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
     bitset->set();
     for (size_t i = 0; i < n; ++i) {
-        auto lb = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
-        auto ub = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
+        auto lb = std::lower_bound(data_view_, data_view_ + count_, IndexStructure<T>(*(values + i)));
+        auto ub = std::upper_bound(data_view_, data_view_ + count_, IndexStructure<T>(*(values + i)));
         for (; lb < ub; ++lb) {
             if (lb->a_ != *(values + i)) {
                 std::cout << "error happens in ScalarIndexSort<T>::NotIn, experted value is: " << *(values + i)
@@ -145,21 +212,21 @@ template <typename T>
 inline const TargetBitmapPtr
 ScalarIndexSort<T>::Range(const T value, const OpType op) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(data_.size());
-    auto lb = data_.begin();
-    auto ub = data_.end();
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
+    auto lb = data_view_;
+    auto ub = data_view_ + count_;
     switch (op) {
         case OpType::LessThan:
-            ub = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(value));
+            ub = std::lower_bound(data_view_, data_view_ + count_, IndexStructure<T>(value));
             break;
         case OpType::LessEqual:
-            ub = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(value));
+            ub = std::upper_bound(data_view_, data_view_ + count_, IndexStructure<T>(value));
             break;
         case OpType::GreaterThan:
-            lb = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(value));
+            lb = std::upper_bound(data_view_, data_view_ + count_, IndexStructure<T>(value));
             break;
         case OpType::GreaterEqual:
-            lb = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(value));
+            lb = std::lower_bound(data_view_, data_view_ + count_, IndexStructure<T>(value));
             break;
         default:
             throw std::invalid_argument(std::string("Invalid OperatorType: ") + std::to_string((int)op) + "!");
@@ -174,22 +241,22 @@ template <typename T>
 inline const TargetBitmapPtr
 ScalarIndexSort<T>::Range(T lower_bound_value, bool lb_inclusive, T upper_bound_value, bool ub_inclusive) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(data_.size());
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
     if (lower_bound_value > upper_bound_value ||
         (lower_bound_value == upper_bound_value && !(lb_inclusive && ub_inclusive))) {
         return bitset;
     }
-    auto lb = data_.begin();
-    auto ub = data_.end();
+    auto lb = data_view_;
+    auto ub = data_view_ + count_;
     if (lb_inclusive) {
-        lb = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(lower_bound_value));
+        lb = std::lower_bound(data_view_, data_view_ + count_, IndexStructure<T>(lower_bound_value));
     } else {
-        lb = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(lower_bound_value));
+        lb = std::upper_bound(data_view_, data_view_ + count_, IndexStructure<T>(lower_bound_value));
     }
     if (ub_inclusive) {
-        ub = std::upper_bound(data_.begin(), data_.end(), IndexStructure<T>(upper_bound_value));
+        ub = std::upper_bound(data_view_, data_view_ + count_, IndexStructure<T>(upper_bound_value));
     } else {
-        ub = std::lower_bound(data_.begin(), data_.end(), IndexStructure<T>(upper_bound_value));
+        ub = std::lower_bound(data_view_, data_view_ + count_, IndexStructure<T>(upper_bound_value));
     }
     for (; lb < ub; ++lb) {
         bitset->set(lb->idx_);
@@ -197,14 +264,87 @@ ScalarIndexSort<T>::Range(T lower_bound_value, bool lb_inclusive, T upper_bound_
     return bitset;
 }
 
+template <typename T>
+inline TargetRangesPtr
+ScalarIndexSort<T>::InAsRanges(const size_t n, const T* values) {
+    AssertInfo(is_built_, "index has not been built");
+    std::vector<size_t> hits;
+    for (size_t i = 0; i < n; ++i) {
+        auto lb = std::lower_bound(data_view_, data_view_ + count_, IndexStructure<T>(*(values + i)));
+        auto ub = std::upper_bound(data_view_, data_view_ + count_, IndexStructure<T>(*(values + i)));
+        for (; lb < ub; ++lb) {
+            hits.push_back(lb->idx_);
+        }
+    }
+    return std::make_unique<TargetRanges>(TargetRanges::FromOffsets(count_, std::move(hits)));
+}
+
+template <typename T>
+inline TargetRangesPtr
+ScalarIndexSort<T>::RangeAsRanges(const T value, const OpType op) {
+    AssertInfo(is_built_, "index has not been built");
+    auto lb = data_view_;
+    auto ub = data_view_ + count_;
+    switch (op) {
+        case OpType::LessThan:
+            ub = std::lower_bound(data_view_, data_view_ + count_, IndexStructure<T>(value));
+            break;
+        case OpType::LessEqual:
+            ub = std::upper_bound(data_view_, data_view_ + count_, IndexStructure<T>(value));
+            break;
+        case OpType::GreaterThan:
+            lb = std::upper_bound(data_view_, data_view_ + count_, IndexStructure<T>(value));
+            break;
+        case OpType::GreaterEqual:
+            lb = std::lower_bound(data_view_, data_view_ + count_, IndexStructure<T>(value));
+            break;
+        default:
+            throw std::invalid_argument(std::string("Invalid OperatorType: ") + std::to_string((int)op) + "!");
+    }
+    std::vector<size_t> hits;
+    hits.reserve(ub - lb);
+    for (; lb < ub; ++lb) {
+        hits.push_back(lb->idx_);
+    }
+    return std::make_unique<TargetRanges>(TargetRanges::FromOffsets(count_, std::move(hits)));
+}
+
+template <typename T>
+inline TargetRangesPtr
+ScalarIndexSort<T>::RangeAsRanges(T lower_bound_value, bool lb_inclusive, T upper_bound_value, bool ub_inclusive) {
+    AssertInfo(is_built_, "index has not been built");
+    if (lower_bound_value > upper_bound_value ||
+        (lower_bound_value == upper_bound_value && !(lb_inclusive && ub_inclusive))) {
+        return std::make_unique<TargetRanges>(count_);
+    }
+    auto lb = data_view_;
+    auto ub = data_view_ + count_;
+    if (lb_inclusive) {
+        lb = std::lower_bound(data_view_, data_view_ + count_, IndexStructure<T>(lower_bound_value));
+    } else {
+        lb = std::upper_bound(data_view_, data_view_ + count_, IndexStructure<T>(lower_bound_value));
+    }
+    if (ub_inclusive) {
+        ub = std::upper_bound(data_view_, data_view_ + count_, IndexStructure<T>(upper_bound_value));
+    } else {
+        ub = std::lower_bound(data_view_, data_view_ + count_, IndexStructure<T>(upper_bound_value));
+    }
+    std::vector<size_t> hits;
+    hits.reserve(ub - lb);
+    for (; lb < ub; ++lb) {
+        hits.push_back(lb->idx_);
+    }
+    return std::make_unique<TargetRanges>(TargetRanges::FromOffsets(count_, std::move(hits)));
+}
+
 template <typename T>
 inline T
 ScalarIndexSort<T>::Reverse_Lookup(size_t idx) const {
-    AssertInfo(idx < idx_to_offsets_.size(), "out of range of total count");
+    AssertInfo(idx < count_, "out of range of total count");
     AssertInfo(is_built_, "index has not been built");
 
-    auto offset = idx_to_offsets_[idx];
-    return data_[offset].a_;
+    auto offset = idx_to_offsets_view_[idx];
+    return data_view_[offset].a_;
 }
 
 }  // namespace milvus::scalar
@@ -12,7 +12,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <string>
@@ -22,6 +24,23 @@
 
 namespace milvus::scalar {
 
+// versioned flat serialized form: one 64-byte header, then the sorted
+// IndexStructure array and the idx->offset array, each section starting at
+// a 64-byte boundary so a loaded buffer can be binary-searched in place
+struct FlatIndexHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t count;
+};
+constexpr uint32_t SCALAR_INDEX_FLAT_MAGIC = 0x53495331;  // "SIS1"
+constexpr uint32_t SCALAR_INDEX_FLAT_VERSION = 1;
+constexpr size_t SCALAR_INDEX_FLAT_ALIGN = 64;
+
+constexpr size_t
+FlatIndexAlign(size_t offset) {
+    return (offset + SCALAR_INDEX_FLAT_ALIGN - 1) & ~(SCALAR_INDEX_FLAT_ALIGN - 1);
+}
+
 template <typename T>
 class ScalarIndexSort : public ScalarIndex<T> {
  public:
@@ -39,7 +58,7 @@ class ScalarIndexSort : public ScalarIndex<T> {
 
     size_t
     Count() override {
-        return data_.size();
+        return count_;
     }
 
     void
@@ -60,6 +79,15 @@ class ScalarIndexSort : public ScalarIndex<T> {
     const TargetBitmapPtr
     Range(T lower_bound_value, bool lb_inclusive, T upper_bound_value, bool ub_inclusive) override;
 
+    TargetRangesPtr
+    InAsRanges(size_t n, const T* values) override;
+
+    TargetRangesPtr
+    RangeAsRanges(T value, OpType op) override;
+
+    TargetRangesPtr
+    RangeAsRanges(T lower_bound_value, bool lb_inclusive, T upper_bound_value, bool ub_inclusive) override;
+
     T
     Reverse_Lookup(size_t offset) const override;
 
@@ -71,7 +99,7 @@ class ScalarIndexSort : public ScalarIndex<T> {
 
     int64_t
     Size() override {
-        return (int64_t)data_.size();
+        return (int64_t)count_;
     }
 
     bool
@@ -83,6 +111,12 @@ class ScalarIndexSort : public ScalarIndex<T> {
     bool is_built_;
     std::vector<size_t> idx_to_offsets_;  // used to retrieve.
     std::vector<IndexStructure<T>> data_;
+    // queries run on these views: Build and the legacy Load point them at
+    // the vectors above, a flat-format Load points them into load_buf_
+    const IndexStructure<T>* data_view_ = nullptr;
+    const size_t* idx_to_offsets_view_ = nullptr;
+    size_t count_ = 0;
+    std::shared_ptr<uint8_t[]> load_buf_;
 };
 
 template <typename T>
@@ -0,0 +1,183 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "index/StringIndexHash.h"
+#include "index/Meta.h"
+
+namespace milvus::scalar {
+
+size_t
+StringIndexHash::find_slot(std::string_view value) const {
+    auto idx = std::hash<std::string_view>{}(value) & slot_mask_;
+    while (slots_[idx] >= 0) {
+        if (row_value(slots_[idx]) == value) {
+            break;
+        }
+        idx = (idx + 1) & slot_mask_;
+    }
+    return idx;
+}
+
+void
+StringIndexHash::build_table() {
+    // 2x rows keeps the load factor under 0.5 even with all-distinct values
+    size_t num_slots = 2;
+    while (num_slots < count_ * 2) {
+        num_slots <<= 1;
+    }
+    slot_mask_ = num_slots - 1;
+    slots_.assign(num_slots, -1);
+    next_.assign(count_, -1);
+    for (size_t row = 0; row < count_; ++row) {
+        auto idx = find_slot(row_value(row));
+        if (slots_[idx] >= 0) {
+            // chain order does not matter, prepend is O(1)
+            next_[row] = slots_[idx];
+        }
+        slots_[idx] = row;
+    }
+}
+
+void
+StringIndexHash::Build(size_t n, const std::string* values) {
+    if (is_built_) {
+        return;
+    }
+    if (n == 0) {
+        throw std::invalid_argument("StringIndexHash cannot build null values!");
+    }
+    AssertInfo(n < std::numeric_limits<int32_t>::max(), "row count exceeds string hash index capacity");
+
+    count_ = n;
+    offsets_.resize(n + 1);
+    uint64_t total = 0;
+    for (size_t i = 0; i < n; ++i) {
+        offsets_[i] = total;
+        total += values[i].size();
+    }
+    offsets_[n] = total;
+    arena_.resize(total);
+    for (size_t i = 0; i < n; ++i) {
+        memcpy(arena_.data() + offsets_[i], values[i].data(), values[i].size());
+    }
+    arena_view_ = arena_.data();
+    offsets_view_ = offsets_.data();
+
+    build_table();
+    is_built_ = true;
+}
+
+int64_t
+StringIndexHash::Size() {
+    if (!is_built_) {
+        return 0;
+    }
+    return static_cast<int64_t>(offsets_view_[count_] + (count_ + 1) * sizeof(uint64_t) +
+                                (slots_.size() + next_.size()) * sizeof(int32_t));
+}
+
+const TargetBitmapPtr
+StringIndexHash::In(size_t n, const std::string* values) {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
+    for (size_t i = 0; i < n; ++i) {
+        auto idx = find_slot(values[i]);
+        for (auto row = slots_[idx]; row >= 0; row = next_[row]) {
+            bitset->set(row);
+        }
+    }
+    return bitset;
+}
+
+const TargetBitmapPtr
+StringIndexHash::NotIn(size_t n, const std::string* values) {
+    auto bitset = In(n, values);
+    bitset->flip();
+    return bitset;
+}
+
+const TargetBitmapPtr
+StringIndexHash::Range(std::string value, OpType op) {
+    throw std::invalid_argument("StringIndexHash does not support range queries");
+}
+
+const TargetBitmapPtr
+StringIndexHash::Range(std::string lower_bound_value,
+                       bool lb_inclusive,
+                       std::string upper_bound_value,
+                       bool ub_inclusive) {
+    throw std::invalid_argument("StringIndexHash does not support range queries");
+}
+
+const TargetBitmapPtr
+StringIndexHash::PrefixMatch(std::string prefix) {
+    throw std::invalid_argument("StringIndexHash does not support prefix queries");
+}
+
+std::string
+StringIndexHash::Reverse_Lookup(size_t offset) const {
+    AssertInfo(offset < count_, "out of range of total count");
+    AssertInfo(is_built_, "index has not been built");
+    auto value = row_value(offset);
+    return std::string(value.data(), value.size());
+}
+
+BinarySet
+StringIndexHash::Serialize(const Config& config) {
+    AssertInfo(is_built_, "index has not been built");
+
+    // only the row-order values are persisted; the probe table is cheaper
+    // to rebuild on load than to ship
+    auto arena_len = static_cast<size_t>(offsets_view_[count_]);
+    auto meta_len = sizeof(uint64_t) * (count_ + 2);
+    std::shared_ptr<uint8_t[]> meta(new uint8_t[meta_len]);
+    uint64_t count = count_;
+    memcpy(meta.get(), &count, sizeof(count));
+    memcpy(meta.get() + sizeof(count), offsets_view_, (count_ + 1) * sizeof(uint64_t));
+
+    std::shared_ptr<uint8_t[]> arena_data(new uint8_t[arena_len]);
+    memcpy(arena_data.get(), arena_view_, arena_len);
+
+    BinarySet res_set;
+    res_set.Append(STRING_HASH_META, meta, meta_len);
+    res_set.Append(STRING_HASH_ARENA, arena_data, arena_len);
+    return res_set;
+}
+
+void
+StringIndexHash::Load(const BinarySet& set) {
+    auto meta = set.GetByName(STRING_HASH_META);
+    auto arena_data = set.GetByName(STRING_HASH_ARENA);
+
+    meta_buf_ = meta->data;
+    arena_buf_ = arena_data->data;
+
+    uint64_t count;
+    memcpy(&count, meta_buf_.get(), sizeof(count));
+    count_ = count;
+    AssertInfo(static_cast<size_t>(meta->size) == sizeof(uint64_t) * (count_ + 2),
+               "string hash index meta size mismatch");
+
+    offsets_view_ = reinterpret_cast<const uint64_t*>(meta_buf_.get() + sizeof(uint64_t));
+    arena_view_ = reinterpret_cast<const char*>(arena_buf_.get());
+    AssertInfo(static_cast<uint64_t>(arena_data->size) == offsets_view_[count_],
+               "string hash index arena size mismatch");
+
+    build_table();
+    is_built_ = true;
+}
+
+}  // namespace milvus::scalar
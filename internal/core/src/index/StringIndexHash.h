@@ -0,0 +1,107 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "index/StringIndex.h"
+
+namespace milvus::scalar {
+
+// equality-only index for high-cardinality string columns (device ids,
+// URLs): the values stay in row order in one byte arena and an
+// open-addressing table maps value hash -> chain of rows holding the value,
+// so In/NotIn are O(1) probes per term. Range and prefix predicates are not
+// supported — columns needing them should use the marisa or sort index.
+class StringIndexHash : public StringIndex {
+ public:
+    StringIndexHash() = default;
+
+    int64_t
+    Size() override;
+
+    BinarySet
+    Serialize(const Config& config) override;
+
+    void
+    Load(const BinarySet& set) override;
+
+    size_t
+    Count() override {
+        return count_;
+    }
+
+    void
+    Build(size_t n, const std::string* values) override;
+
+    const TargetBitmapPtr
+    In(size_t n, const std::string* values) override;
+
+    const TargetBitmapPtr
+    NotIn(size_t n, const std::string* values) override;
+
+    const TargetBitmapPtr
+    Range(std::string value, OpType op) override;
+
+    const TargetBitmapPtr
+    Range(std::string lower_bound_value, bool lb_inclusive, std::string upper_bound_value, bool ub_inclusive) override;
+
+    const TargetBitmapPtr
+    PrefixMatch(std::string prefix) override;
+
+    std::string
+    Reverse_Lookup(size_t offset) const override;
+
+ private:
+    // value of the row at offset, viewed straight from the arena
+    std::string_view
+    row_value(size_t offset) const {
+        auto beg = offsets_view_[offset];
+        return std::string_view(arena_view_ + beg, offsets_view_[offset + 1] - beg);
+    }
+
+    // slot holding the chain head for value, or the empty slot where it
+    // would be inserted
+    size_t
+    find_slot(std::string_view value) const;
+
+    void
+    build_table();
+
+ private:
+    // values in row order: arena plus offsets, like a var-length column
+    std::vector<char> arena_;
+    std::vector<uint64_t> offsets_;  // count_ + 1 entries
+    const char* arena_view_ = nullptr;
+    const uint64_t* offsets_view_ = nullptr;
+    std::shared_ptr<uint8_t[]> meta_buf_;
+    std::shared_ptr<uint8_t[]> arena_buf_;
+
+    // open addressing with linear probing; slots_ holds the first row of
+    // each value chain, next_ links further rows with the same value
+    std::vector<int32_t> slots_;
+    std::vector<int32_t> next_;
+    size_t slot_mask_ = 0;
+
+    size_t count_ = 0;
+    bool is_built_ = false;
+};
+using StringIndexHashPtr = std::unique_ptr<StringIndexHash>;
+
+inline StringIndexHashPtr
+CreateStringIndexHash() {
+    return std::make_unique<StringIndexHash>();
+}
+}  // namespace milvus::scalar
@@ -9,14 +9,19 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/uuid/uuid_generators.hpp>
+#include <future>
 #include <stdlib.h>
 #include <stdio.h>
 #include <fcntl.h>
+#include <thread>
 #include <knowhere/index/VecIndex.h>
 
+#include "common/ThreadPool.h"
+
 #include "index/StringIndexMarisa.h"
 #include "index/Utils.h"
 #include "index/Index.h"
@@ -76,9 +81,24 @@ StringIndexMarisa::Serialize(const Config& config) {
     std::shared_ptr<uint8_t[]> str_ids(new uint8_t[str_ids_len]);
     memcpy(str_ids.get(), str_ids_.data(), str_ids_len);
 
+    // persist the CSR offsets mapping so Load does not rebuild it by
+    // iterating every key
+    auto offsets_index_len = offsets_index_.size() * sizeof(size_t);
+    auto offsets_len = offsets_by_str_id_.size() * sizeof(size_t);
+    auto mapping_len = sizeof(size_t) + offsets_index_len + offsets_len;
+    std::shared_ptr<uint8_t[]> mapping(new uint8_t[mapping_len]);
+    auto cursor = mapping.get();
+    size_t index_entries = offsets_index_.size();
+    memcpy(cursor, &index_entries, sizeof(size_t));
+    cursor += sizeof(size_t);
+    memcpy(cursor, offsets_index_.data(), offsets_index_len);
+    cursor += offsets_index_len;
+    memcpy(cursor, offsets_by_str_id_.data(), offsets_len);
+
     BinarySet res_set;
     res_set.Append(MARISA_TRIE_INDEX, index_data, size);
     res_set.Append(MARISA_STR_IDS, str_ids, str_ids_len);
+    res_set.Append(MARISA_STR_IDS_TO_OFFSETS, mapping, mapping_len);
 
     knowhere::Disassemble(res_set, config);
 
@@ -89,30 +109,34 @@ void
 StringIndexMarisa::Load(const BinarySet& set) {
     knowhere::Assemble(const_cast<BinarySet&>(set));
 
-    auto uuid = boost::uuids::random_generator()();
-    auto uuid_string = boost::uuids::to_string(uuid);
-    auto file = std::string("/tmp/") + uuid_string;
-
     auto index = set.GetByName(MARISA_TRIE_INDEX);
     auto len = index->size;
 
-    auto fd = open(file.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR | S_IXUSR);
-    lseek(fd, 0, SEEK_SET);
-    while (write(fd, index->data.get(), len) != len) {
-        lseek(fd, 0, SEEK_SET);
-    }
-
-    lseek(fd, 0, SEEK_SET);
-    trie_.read(fd);
-    close(fd);
-    remove(file.c_str());
+    // map the trie straight from the serialized bytes instead of taking a
+    // temp file round trip; trie_buf_ keeps the mapped region alive
+    trie_buf_ = index->data;
+    trie_.map(trie_buf_.get(), len);
 
     auto str_ids = set.GetByName(MARISA_STR_IDS);
     auto str_ids_len = str_ids->size;
     str_ids_.resize(str_ids_len / sizeof(size_t));
     memcpy(str_ids_.data(), str_ids->data.get(), str_ids_len);
 
-    fill_offsets();
+    if (set.Contains(MARISA_STR_IDS_TO_OFFSETS)) {
+        auto mapping = set.GetByName(MARISA_STR_IDS_TO_OFFSETS);
+        auto cursor = mapping->data.get();
+        size_t index_entries;
+        memcpy(&index_entries, cursor, sizeof(size_t));
+        cursor += sizeof(size_t);
+        offsets_index_.resize(index_entries);
+        memcpy(offsets_index_.data(), cursor, index_entries * sizeof(size_t));
+        cursor += index_entries * sizeof(size_t);
+        offsets_by_str_id_.resize(str_ids_.size());
+        memcpy(offsets_by_str_id_.data(), cursor, str_ids_.size() * sizeof(size_t));
+    } else {
+        // index was serialized before the offsets mapping was persisted
+        fill_offsets();
+    }
 }
 
 bool
@@ -127,9 +151,8 @@ StringIndexMarisa::In(size_t n, const std::string* values) {
         auto str = values[i];
         auto str_id = lookup(str);
         if (valid_str_id(str_id)) {
-            auto offsets = str_ids_to_offsets_[str_id];
-            for (auto offset : offsets) {
-                bitset->set(offset);
+            for (auto i = offsets_index_[str_id]; i < offsets_index_[str_id + 1]; i++) {
+                bitset->set(offsets_by_str_id_[i]);
             }
         }
     }
@@ -144,9 +167,8 @@ StringIndexMarisa::NotIn(size_t n, const std::string* values) {
         auto str = values[i];
         auto str_id = lookup(str);
         if (valid_str_id(str_id)) {
-            auto offsets = str_ids_to_offsets_[str_id];
-            for (auto offset : offsets) {
-                bitset->reset(offset);
+            for (auto i = offsets_index_[str_id]; i < offsets_index_[str_id + 1]; i++) {
+                bitset->reset(offsets_by_str_id_[i]);
             }
         }
     }
@@ -223,11 +245,14 @@ StringIndexMarisa::Range(std::string lower_bound_value,
 const TargetBitmapPtr
 StringIndexMarisa::PrefixMatch(std::string prefix) {
     TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(str_ids_.size());
-    auto matched = prefix_match(prefix);
-    for (const auto str_id : matched) {
-        auto offsets = str_ids_to_offsets_[str_id];
-        for (auto offset : offsets) {
-            bitset->set(offset);
+    // walk the trie's predictive search and emit row offsets straight from
+    // the CSR mapping, no intermediate key list
+    marisa::Agent agent;
+    agent.set_query(prefix.c_str(), prefix.length());
+    while (trie_.predictive_search(agent)) {
+        auto str_id = agent.key().id();
+        for (auto i = offsets_index_[str_id]; i < offsets_index_[str_id + 1]; i++) {
+            bitset->set(offsets_by_str_id_[i]);
         }
     }
     return bitset;
@@ -236,22 +261,59 @@ StringIndexMarisa::PrefixMatch(std::string prefix) {
 void
 StringIndexMarisa::fill_str_ids(size_t n, const std::string* values) {
     str_ids_.resize(n);
-    for (size_t i = 0; i < n; i++) {
-        auto str = values[i];
-        auto str_id = lookup(str);
-        assert(valid_str_id(str_id));
-        str_ids_[i] = str_id;
+    auto parallelism = build_parallelism_;
+    if (parallelism <= 0) {
+        parallelism = n >= PARALLEL_BUILD_ROW_THRESHOLD ? std::thread::hardware_concurrency() : 1;
+    }
+    if (parallelism <= 1) {
+        for (size_t i = 0; i < n; i++) {
+            auto str = values[i];
+            auto str_id = lookup(str);
+            assert(valid_str_id(str_id));
+            str_ids_[i] = str_id;
+        }
+        return;
+    }
+
+    // trie lookups are read-only and every slot is distinct, so this
+    // post-build pass shards cleanly across the pool
+    auto num_shards = std::min<size_t>(parallelism, ThreadPool::GetInstance(ThreadPoolRole::Build).num_threads());
+    auto shard_rows = (n + num_shards - 1) / num_shards;
+    std::vector<std::future<void>> futures;
+    for (size_t begin = 0; begin < n; begin += shard_rows) {
+        auto end = std::min(n, begin + shard_rows);
+        futures.emplace_back(ThreadPool::GetInstance(ThreadPoolRole::Build).Submit([this, values, begin, end] {
+            for (size_t i = begin; i < end; i++) {
+                auto str_id = lookup(values[i]);
+                assert(valid_str_id(str_id));
+                str_ids_[i] = str_id;
+            }
+        }));
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+    for (auto& future : futures) {
+        future.get();
     }
 }
 
 void
 StringIndexMarisa::fill_offsets() {
+    // counting sort into the CSR arrays: bucket sizes, prefix sums, then a
+    // stable scatter of every offset into its str_id bucket
+    auto num_keys = trie_.num_keys();
+    offsets_index_.assign(num_keys + 1, 0);
+    for (auto str_id : str_ids_) {
+        offsets_index_[str_id + 1]++;
+    }
+    for (size_t str_id = 0; str_id < num_keys; str_id++) {
+        offsets_index_[str_id + 1] += offsets_index_[str_id];
+    }
+    offsets_by_str_id_.resize(str_ids_.size());
+    auto cursors = offsets_index_;
     for (size_t offset = 0; offset < str_ids_.size(); offset++) {
-        auto str_id = str_ids_[offset];
-        if (str_ids_to_offsets_.find(str_id) == str_ids_to_offsets_.end()) {
-            str_ids_to_offsets_[str_id] = std::vector<size_t>{};
-        }
-        str_ids_to_offsets_[str_id].push_back(offset);
+        offsets_by_str_id_[cursors[str_ids_[offset]]++] = offset;
     }
 }
 
@@ -267,17 +329,6 @@ StringIndexMarisa::lookup(const std::string& str) {
     return MARISA_INVALID_KEY_ID;
 }
 
-std::vector<size_t>
-StringIndexMarisa::prefix_match(const std::string& prefix) {
-    std::vector<size_t> ret;
-    marisa::Agent agent;
-    agent.set_query(prefix.c_str());
-    while (trie_.predictive_search(agent)) {
-        ret.push_back(agent.key().id());
-    }
-    return ret;
-}
-
 std::string
 StringIndexMarisa::Reverse_Lookup(size_t offset) const {
     AssertInfo(offset < str_ids_.size(), "out of range of total count");
@@ -17,7 +17,6 @@
 #include "index/StringIndex.h"
 #include <string>
 #include <vector>
-#include <map>
 #include <memory>
 
 namespace milvus::scalar {
@@ -72,13 +71,15 @@ class StringIndexMarisa : public StringIndex {
     size_t
     lookup(const std::string& str);
 
-    std::vector<size_t>
-    prefix_match(const std::string& prefix);
-
  private:
     marisa::Trie trie_;
     std::vector<size_t> str_ids_;  // used to retrieve.
-    std::map<size_t, std::vector<size_t>> str_ids_to_offsets_;
+    // id->offsets mapping in CSR form: the offsets for str_id live in
+    // offsets_by_str_id_[offsets_index_[str_id], offsets_index_[str_id + 1])
+    std::vector<size_t> offsets_index_;
+    std::vector<size_t> offsets_by_str_id_;
+    // keeps the serialized trie bytes alive while trie_ maps them
+    std::shared_ptr<uint8_t[]> trie_buf_;
     bool built_ = false;
 };
 
@@ -0,0 +1,406 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <tbb/parallel_sort.h>
+#include <tbb/task_arena.h>
+#include <knowhere/index/VecIndex.h>
+
+#include "index/StringIndexSort.h"
+#include "common/Utils.h"
+
+namespace milvus::scalar {
+
+void
+StringIndexSort::set_views() {
+    arena_view_ = arena_.data();
+    stored_offsets_view_ = stored_offsets_.data();
+    prefix_lens_view_ = prefix_lens_.data();
+    row_ids_view_ = row_ids_.data();
+}
+
+void
+StringIndexSort::Cursor::seek(size_t target) {
+    pos = target - target % kBlockStrings;
+    auto head = index->stored_bytes(pos);
+    value.assign(head.data(), head.size());
+    while (pos < target) {
+        next();
+    }
+}
+
+void
+StringIndexSort::Cursor::next() {
+    if (++pos >= index->count_) {
+        return;
+    }
+    // block heads carry prefix length 0, so this re-assigns them whole
+    auto suffix = index->stored_bytes(pos);
+    value.resize(index->prefix_lens_view_[pos]);
+    value.append(suffix.data(), suffix.size());
+}
+
+void
+StringIndexSort::Build(size_t n, const std::string* values) {
+    if (is_built_) {
+        return;
+    }
+    if (n == 0) {
+        throw std::invalid_argument("StringIndexSort cannot build null values!");
+    }
+    AssertInfo(n < std::numeric_limits<uint32_t>::max(), "row count exceeds string sort index capacity");
+
+    row_ids_.resize(n);
+    std::iota(row_ids_.begin(), row_ids_.end(), 0);
+    auto cmp = [values](uint32_t lhs, uint32_t rhs) { return values[lhs] < values[rhs]; };
+    auto parallelism = build_parallelism_;
+    if (parallelism <= 0) {
+        parallelism = n >= PARALLEL_BUILD_ROW_THRESHOLD ? std::thread::hardware_concurrency() : 1;
+    }
+    if (parallelism > 1) {
+        tbb::task_arena arena(parallelism);
+        arena.execute([&] { tbb::parallel_sort(row_ids_.begin(), row_ids_.end(), cmp); });
+    } else {
+        std::sort(row_ids_.begin(), row_ids_.end(), cmp);
+    }
+
+    count_ = n;
+    row_to_pos_.resize(n);
+    for (size_t pos = 0; pos < n; ++pos) {
+        row_to_pos_[row_ids_[pos]] = pos;
+    }
+
+    // first pass sizes the arena, second pass fills it
+    prefix_lens_.resize(n);
+    stored_offsets_.resize(n + 1);
+    uint64_t total = 0;
+    for (size_t pos = 0; pos < n; ++pos) {
+        const auto& cur = values[row_ids_[pos]];
+        uint32_t prefix_len = 0;
+        if (pos % kBlockStrings != 0) {
+            const auto& prev = values[row_ids_[pos - 1]];
+            auto limit = std::min(cur.size(), prev.size());
+            while (prefix_len < limit && cur[prefix_len] == prev[prefix_len]) {
+                ++prefix_len;
+            }
+        }
+        prefix_lens_[pos] = prefix_len;
+        stored_offsets_[pos] = total;
+        total += cur.size() - prefix_len;
+    }
+    stored_offsets_[n] = total;
+
+    arena_.resize(total);
+    for (size_t pos = 0; pos < n; ++pos) {
+        const auto& cur = values[row_ids_[pos]];
+        memcpy(arena_.data() + stored_offsets_[pos], cur.data() + prefix_lens_[pos], cur.size() - prefix_lens_[pos]);
+    }
+
+    set_views();
+    is_built_ = true;
+}
+
+size_t
+StringIndexSort::bound(const std::string& value, bool upper) const {
+    auto pred = [&](std::string_view stored) { return upper ? stored > value : stored >= value; };
+    // binary search over the fully stored block heads, then walk the one
+    // block that can contain the boundary
+    auto num_blocks = (count_ + kBlockStrings - 1) / kBlockStrings;
+    size_t lo = 0;
+    size_t hi = num_blocks;
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        if (pred(stored_bytes(mid * kBlockStrings))) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    if (lo == 0) {
+        return 0;
+    }
+    auto start = (lo - 1) * kBlockStrings;
+    auto limit = std::min(lo * kBlockStrings, count_);
+    Cursor cursor{this};
+    cursor.seek(start);
+    while (cursor.pos < limit) {
+        if (pred(cursor.value)) {
+            return cursor.pos;
+        }
+        cursor.next();
+    }
+    return limit;
+}
+
+int64_t
+StringIndexSort::Size() {
+    if (!is_built_) {
+        return 0;
+    }
+    return static_cast<int64_t>(stored_offsets_view_[count_] + (count_ + 1) * sizeof(uint64_t) +
+                                count_ * 2 * sizeof(uint32_t));
+}
+
+const TargetBitmapPtr
+StringIndexSort::In(size_t n, const std::string* values) {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
+    Cursor cursor{this};
+    for (size_t i = 0; i < n; ++i) {
+        auto lb = lower_bound(values[i]);
+        if (lb == count_) {
+            continue;
+        }
+        cursor.seek(lb);
+        while (cursor.pos < count_ && cursor.value == values[i]) {
+            bitset->set(row_ids_view_[cursor.pos]);
+            cursor.next();
+        }
+    }
+    return bitset;
+}
+
+const TargetBitmapPtr
+StringIndexSort::NotIn(size_t n, const std::string* values) {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
+    bitset->set();
+    Cursor cursor{this};
+    for (size_t i = 0; i < n; ++i) {
+        auto lb = lower_bound(values[i]);
+        if (lb == count_) {
+            continue;
+        }
+        cursor.seek(lb);
+        while (cursor.pos < count_ && cursor.value == values[i]) {
+            bitset->reset(row_ids_view_[cursor.pos]);
+            cursor.next();
+        }
+    }
+    return bitset;
+}
+
+const TargetBitmapPtr
+StringIndexSort::Range(std::string value, OpType op) {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
+    size_t lb = 0;
+    size_t ub = count_;
+    switch (op) {
+        case OpType::LessThan:
+            ub = lower_bound(value);
+            break;
+        case OpType::LessEqual:
+            ub = upper_bound(value);
+            break;
+        case OpType::GreaterThan:
+            lb = upper_bound(value);
+            break;
+        case OpType::GreaterEqual:
+            lb = lower_bound(value);
+            break;
+        default:
+            throw std::invalid_argument(std::string("Invalid OperatorType: ") + std::to_string((int)op) + "!");
+    }
+    for (auto pos = lb; pos < ub; ++pos) {
+        bitset->set(row_ids_view_[pos]);
+    }
+    return bitset;
+}
+
+const TargetBitmapPtr
+StringIndexSort::Range(std::string lower_bound_value,
+                       bool lb_inclusive,
+                       std::string upper_bound_value,
+                       bool ub_inclusive) {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
+    if (lower_bound_value > upper_bound_value ||
+        (lower_bound_value == upper_bound_value && !(lb_inclusive && ub_inclusive))) {
+        return bitset;
+    }
+    auto lb = lb_inclusive ? lower_bound(lower_bound_value) : upper_bound(lower_bound_value);
+    auto ub = ub_inclusive ? upper_bound(upper_bound_value) : lower_bound(upper_bound_value);
+    for (auto pos = lb; pos < ub; ++pos) {
+        bitset->set(row_ids_view_[pos]);
+    }
+    return bitset;
+}
+
+const TargetBitmapPtr
+StringIndexSort::PrefixMatch(std::string prefix) {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(count_);
+    // entries sharing the prefix form one contiguous run starting at the
+    // first entry >= prefix
+    auto lb = lower_bound(prefix);
+    if (lb == count_) {
+        return bitset;
+    }
+    Cursor cursor{this};
+    cursor.seek(lb);
+    while (cursor.pos < count_ && milvus::PrefixMatch(cursor.value, prefix)) {
+        bitset->set(row_ids_view_[cursor.pos]);
+        cursor.next();
+    }
+    return bitset;
+}
+
+std::string
+StringIndexSort::Reverse_Lookup(size_t offset) const {
+    AssertInfo(offset < count_, "out of range of total count");
+    AssertInfo(is_built_, "index has not been built");
+    Cursor cursor{this};
+    cursor.seek(row_to_pos_[offset]);
+    return cursor.value;
+}
+
+TargetRangesPtr
+StringIndexSort::InAsRanges(size_t n, const std::string* values) {
+    AssertInfo(is_built_, "index has not been built");
+    std::vector<size_t> hits;
+    Cursor cursor{this};
+    for (size_t i = 0; i < n; ++i) {
+        auto lb = lower_bound(values[i]);
+        if (lb == count_) {
+            continue;
+        }
+        cursor.seek(lb);
+        while (cursor.pos < count_ && cursor.value == values[i]) {
+            hits.push_back(row_ids_view_[cursor.pos]);
+            cursor.next();
+        }
+    }
+    return std::make_unique<TargetRanges>(TargetRanges::FromOffsets(count_, std::move(hits)));
+}
+
+TargetRangesPtr
+StringIndexSort::RangeAsRanges(std::string value, OpType op) {
+    AssertInfo(is_built_, "index has not been built");
+    size_t lb = 0;
+    size_t ub = count_;
+    switch (op) {
+        case OpType::LessThan:
+            ub = lower_bound(value);
+            break;
+        case OpType::LessEqual:
+            ub = upper_bound(value);
+            break;
+        case OpType::GreaterThan:
+            lb = upper_bound(value);
+            break;
+        case OpType::GreaterEqual:
+            lb = lower_bound(value);
+            break;
+        default:
+            throw std::invalid_argument(std::string("Invalid OperatorType: ") + std::to_string((int)op) + "!");
+    }
+    std::vector<size_t> hits;
+    hits.reserve(ub - lb);
+    for (auto pos = lb; pos < ub; ++pos) {
+        hits.push_back(row_ids_view_[pos]);
+    }
+    return std::make_unique<TargetRanges>(TargetRanges::FromOffsets(count_, std::move(hits)));
+}
+
+TargetRangesPtr
+StringIndexSort::RangeAsRanges(std::string lower_bound_value,
+                               bool lb_inclusive,
+                               std::string upper_bound_value,
+                               bool ub_inclusive) {
+    AssertInfo(is_built_, "index has not been built");
+    if (lower_bound_value > upper_bound_value ||
+        (lower_bound_value == upper_bound_value && !(lb_inclusive && ub_inclusive))) {
+        return std::make_unique<TargetRanges>(count_);
+    }
+    auto lb = lb_inclusive ? lower_bound(lower_bound_value) : upper_bound(lower_bound_value);
+    auto ub = ub_inclusive ? upper_bound(upper_bound_value) : lower_bound(upper_bound_value);
+    std::vector<size_t> hits;
+    hits.reserve(ub - lb);
+    for (auto pos = lb; pos < ub; ++pos) {
+        hits.push_back(row_ids_view_[pos]);
+    }
+    return std::make_unique<TargetRanges>(TargetRanges::FromOffsets(count_, std::move(hits)));
+}
+
+BinarySet
+StringIndexSort::Serialize(const Config& config) {
+    AssertInfo(is_built_, "index has not been built");
+
+    // meta layout: uint64 count, uint64 stored_offsets[count + 1],
+    // uint32 row_ids[count], uint32 prefix_lens[count]; row_to_pos_ is
+    // rebuilt on load
+    auto arena_len = static_cast<size_t>(stored_offsets_view_[count_]);
+    auto meta_len = sizeof(uint64_t) * (count_ + 2) + sizeof(uint32_t) * 2 * count_;
+    std::shared_ptr<uint8_t[]> meta(new uint8_t[meta_len]);
+    auto* p = meta.get();
+    uint64_t count = count_;
+    memcpy(p, &count, sizeof(count));
+    p += sizeof(count);
+    memcpy(p, stored_offsets_view_, (count_ + 1) * sizeof(uint64_t));
+    p += (count_ + 1) * sizeof(uint64_t);
+    memcpy(p, row_ids_view_, count_ * sizeof(uint32_t));
+    p += count_ * sizeof(uint32_t);
+    memcpy(p, prefix_lens_view_, count_ * sizeof(uint32_t));
+
+    std::shared_ptr<uint8_t[]> arena_data(new uint8_t[arena_len]);
+    memcpy(arena_data.get(), arena_view_, arena_len);
+
+    BinarySet res_set;
+    res_set.Append(STRING_SORT_META, meta, meta_len);
+    res_set.Append(STRING_SORT_ARENA, arena_data, arena_len);
+
+    knowhere::Disassemble(res_set, config);
+
+    return res_set;
+}
+
+void
+StringIndexSort::Load(const BinarySet& set) {
+    knowhere::Assemble(const_cast<BinarySet&>(set));
+
+    auto meta = set.GetByName(STRING_SORT_META);
+    auto arena_data = set.GetByName(STRING_SORT_ARENA);
+
+    // the serialized buffers already hold the arrays in their in-memory
+    // layout; keep them alive and point the views straight at them
+    meta_buf_ = meta->data;
+    arena_buf_ = arena_data->data;
+
+    uint64_t count;
+    memcpy(&count, meta_buf_.get(), sizeof(count));
+    count_ = count;
+    AssertInfo(static_cast<size_t>(meta->size) == sizeof(uint64_t) * (count_ + 2) + sizeof(uint32_t) * 2 * count_,
+               "string sort index meta size mismatch");
+
+    auto* p = meta_buf_.get() + sizeof(uint64_t);
+    stored_offsets_view_ = reinterpret_cast<const uint64_t*>(p);
+    p += (count_ + 1) * sizeof(uint64_t);
+    row_ids_view_ = reinterpret_cast<const uint32_t*>(p);
+    p += count_ * sizeof(uint32_t);
+    prefix_lens_view_ = reinterpret_cast<const uint32_t*>(p);
+    arena_view_ = reinterpret_cast<const char*>(arena_buf_.get());
+    AssertInfo(static_cast<uint64_t>(arena_data->size) == stored_offsets_view_[count_],
+               "string sort index arena size mismatch");
+
+    row_to_pos_.resize(count_);
+    for (size_t pos = 0; pos < count_; ++pos) {
+        row_to_pos_[row_ids_view_[pos]] = pos;
+    }
+    is_built_ = true;
+}
+
+}  // namespace milvus::scalar
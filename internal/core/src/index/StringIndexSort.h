@@ -9,60 +9,137 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#pragma once
+
 #include <memory>
-#include <vector>
 #include <string>
+#include <string_view>
+#include <vector>
 
-#include "common/Utils.h"
-#include "index/ScalarIndexSort.h"
 #include "index/StringIndex.h"
-#include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 
 namespace milvus::scalar {
-// TODO: should inherit from StringIndex?
-class StringIndexSort : public ScalarIndexSort<std::string> {
+
+// Sorted string index over a front-coded byte arena. The sorted run lives in
+// one contiguous buffer: every kBlockStrings-th entry (a block head) is
+// stored whole, the entries in between keep only the suffix past the prefix
+// they share with their predecessor. Lookups binary-search the block heads
+// and decode at most one block sequentially, so the index holds each string
+// once (minus shared prefixes) with no per-row std::string objects.
+class StringIndexSort : public StringIndex {
  public:
+    StringIndexSort() = default;
+
+    int64_t
+    Size() override;
+
+    BinarySet
+    Serialize(const Config& config) override;
+
     void
-    BuildWithDataset(const DatasetPtr& dataset) override {
-        auto size = knowhere::GetDatasetRows(dataset);
-        auto data = knowhere::GetDatasetTensor(dataset);
-        proto::schema::StringArray arr;
-        arr.ParseFromArray(data, size);
-
-        {
-            // TODO: optimize here. avoid memory copy.
-            std::vector<std::string> vecs{arr.data().begin(), arr.data().end()};
-            Build(arr.data().size(), vecs.data());
-        }
-
-        {
-            // TODO: test this way.
-            // auto strs = (const std::string*)arr.data().data();
-            // Build(arr.data().size(), strs);
-        }
+    Load(const BinarySet& set) override;
+
+    size_t
+    Count() override {
+        return count_;
     }
 
+    void
+    Build(size_t n, const std::string* values) override;
+
     const TargetBitmapPtr
-    Query(const DatasetPtr& dataset) override {
-        auto op = dataset->Get<OpType>(OPERATOR_TYPE);
-        if (op == OpType::PrefixMatch) {
-            auto prefix = dataset->Get<std::string>(PREFIX_VALUE);
-            return PrefixMatch(prefix);
-        }
-        return ScalarIndex<std::string>::Query(dataset);
-    }
+    In(size_t n, const std::string* values) override;
 
     const TargetBitmapPtr
-    PrefixMatch(std::string prefix) {
-        auto data = GetData();
-        TargetBitmapPtr bitset = std::make_unique<TargetBitmap>(data.size());
-        for (size_t i = 0; i < data.size(); i++) {
-            if (milvus::PrefixMatch(data[i].a_, prefix)) {
-                bitset->set(data[i].idx_);
-            }
-        }
-        return bitset;
+    NotIn(size_t n, const std::string* values) override;
+
+    const TargetBitmapPtr
+    Range(std::string value, OpType op) override;
+
+    const TargetBitmapPtr
+    Range(std::string lower_bound_value, bool lb_inclusive, std::string upper_bound_value, bool ub_inclusive) override;
+
+    const TargetBitmapPtr
+    PrefixMatch(std::string prefix) override;
+
+    std::string
+    Reverse_Lookup(size_t offset) const override;
+
+    TargetRangesPtr
+    InAsRanges(size_t n, const std::string* values) override;
+
+    TargetRangesPtr
+    RangeAsRanges(std::string value, OpType op) override;
+
+    TargetRangesPtr
+    RangeAsRanges(std::string lower_bound_value,
+                  bool lb_inclusive,
+                  std::string upper_bound_value,
+                  bool ub_inclusive) override;
+
+ private:
+    // strings per front-coding block; block heads are stored whole and serve
+    // as the binary-search keys
+    static constexpr size_t kBlockStrings = 16;
+
+    // sequential decoder over the front-coded run: holds the fully decoded
+    // string at pos and extends it suffix by suffix
+    struct Cursor {
+        const StringIndexSort* index;
+        size_t pos = 0;
+        std::string value;
+
+        void
+        seek(size_t target);
+
+        void
+        next();
+    };
+
+    // raw bytes stored for the entry at a sorted position (the whole string
+    // for block heads, the unshared suffix otherwise)
+    std::string_view
+    stored_bytes(size_t pos) const {
+        auto beg = stored_offsets_view_[pos];
+        return std::string_view(arena_view_ + beg, stored_offsets_view_[pos + 1] - beg);
+    }
+
+    // first sorted position whose string compares >= value, or > value when
+    // upper is set
+    size_t
+    bound(const std::string& value, bool upper) const;
+
+    size_t
+    lower_bound(const std::string& value) const {
+        return bound(value, false);
     }
+
+    size_t
+    upper_bound(const std::string& value) const {
+        return bound(value, true);
+    }
+
+    void
+    set_views();
+
+ private:
+    // a built index owns its arrays; a loaded one points the views straight
+    // into the serialized buffers and only materializes row_to_pos_
+    std::vector<char> arena_;
+    std::vector<uint64_t> stored_offsets_;  // count_ + 1 entries into arena_
+    std::vector<uint32_t> prefix_lens_;
+    std::vector<uint32_t> row_ids_;     // sorted position -> row offset
+    std::vector<uint32_t> row_to_pos_;  // row offset -> sorted position
+
+    const char* arena_view_ = nullptr;
+    const uint64_t* stored_offsets_view_ = nullptr;
+    const uint32_t* prefix_lens_view_ = nullptr;
+    const uint32_t* row_ids_view_ = nullptr;
+    std::shared_ptr<uint8_t[]> meta_buf_;
+    std::shared_ptr<uint8_t[]> arena_buf_;
+
+    size_t count_ = 0;
+    bool is_built_ = false;
 };
 using StringIndexSortPtr = std::unique_ptr<StringIndexSort>;
 
@@ -0,0 +1,94 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <algorithm>
+
+#include "exceptions/EasyAssert.h"
+#include "index/TargetRanges.h"
+
+namespace milvus::scalar {
+
+TargetRanges
+TargetRanges::FromOffsets(size_t row_count, std::vector<size_t> offsets) {
+    std::sort(offsets.begin(), offsets.end());
+    TargetRanges ranges(row_count);
+    for (size_t i = 0; i < offsets.size();) {
+        auto start = offsets[i];
+        auto end = start + 1;
+        for (++i; i < offsets.size() && offsets[i] == end; ++i) {
+            ++end;
+        }
+        ranges.AddRange(start, end);
+    }
+    return ranges;
+}
+
+TargetRanges
+TargetRanges::FromBitmap(const TargetBitmap& bitmap) {
+    TargetRanges ranges(bitmap.size());
+    auto start = bitmap.find_first();
+    while (start != TargetBitmap::npos) {
+        auto end = start + 1;
+        while (end < bitmap.size() && bitmap.test(end)) {
+            ++end;
+        }
+        ranges.AddRange(start, end);
+        start = end < bitmap.size() ? bitmap.find_next(end) : TargetBitmap::npos;
+    }
+    return ranges;
+}
+
+void
+TargetRanges::AddRange(size_t start, size_t end) {
+    AssertInfo(start < end && end <= row_count_, "invalid hit range");
+    if (!ranges_.empty()) {
+        AssertInfo(start >= ranges_.back().second, "hit ranges must be added in order");
+        if (start == ranges_.back().second) {
+            ranges_.back().second = end;
+            cardinality_ += end - start;
+            return;
+        }
+    }
+    ranges_.emplace_back(start, end);
+    cardinality_ += end - start;
+}
+
+TargetBitmapPtr
+TargetRanges::ToBitmap() const {
+    auto bitmap = std::make_unique<TargetBitmap>(row_count_);
+    OrInto(*bitmap);
+    return bitmap;
+}
+
+void
+TargetRanges::OrInto(TargetBitmap& bitmap) const {
+    AssertInfo(bitmap.size() == row_count_, "bitmap size mismatch");
+    for (auto& range : ranges_) {
+        // block-wise range set from boost, not per-bit
+        bitmap.set(range.first, range.second - range.first, true);
+    }
+}
+
+TargetBitmapPtr
+TargetRanges::AndWith(const TargetBitmap& bitmap) const {
+    AssertInfo(bitmap.size() == row_count_, "bitmap size mismatch");
+    auto result = std::make_unique<TargetBitmap>(row_count_);
+    for (auto& range : ranges_) {
+        for (auto offset = range.first; offset < range.second; ++offset) {
+            if (bitmap.test(offset)) {
+                result->set(offset);
+            }
+        }
+    }
+    return result;
+}
+
+}  // namespace milvus::scalar
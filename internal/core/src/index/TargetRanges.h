@@ -0,0 +1,81 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "index/Index.h"
+
+namespace milvus::scalar {
+
+// Run-length compressed hit set from a scalar index query: sorted,
+// disjoint [start, end) intervals over row offsets. A highly selective
+// predicate carries O(hits) state this way instead of one bit per row,
+// and combines with full bitmaps in O(hits) as well.
+class TargetRanges {
+ public:
+    explicit TargetRanges(size_t row_count) : row_count_(row_count) {
+    }
+
+    // offsets need not be sorted or distinct-run aware; adjacent hits are
+    // coalesced into runs
+    static TargetRanges
+    FromOffsets(size_t row_count, std::vector<size_t> offsets);
+
+    // expand a full bitmap, used by indexes without a native range path
+    static TargetRanges
+    FromBitmap(const TargetBitmap& bitmap);
+
+    // [start, end) must begin at or after the end of the last run
+    void
+    AddRange(size_t start, size_t end);
+
+    size_t
+    size() const {
+        return row_count_;
+    }
+
+    // number of hits across all runs
+    size_t
+    cardinality() const {
+        return cardinality_;
+    }
+
+    const std::vector<std::pair<size_t, size_t>>&
+    ranges() const {
+        return ranges_;
+    }
+
+    // expand to the engine's one-bit-per-row form
+    TargetBitmapPtr
+    ToBitmap() const;
+
+    // bitmap |= this, touching only the covered rows
+    void
+    OrInto(TargetBitmap& bitmap) const;
+
+    // this & bitmap, touching only the covered rows
+    TargetBitmapPtr
+    AndWith(const TargetBitmap& bitmap) const;
+
+ private:
+    size_t row_count_;
+    size_t cardinality_ = 0;
+    std::vector<std::pair<size_t, size_t>> ranges_;
+};
+
+using TargetRangesPtr = std::unique_ptr<TargetRanges>;
+
+}  // namespace milvus::scalar
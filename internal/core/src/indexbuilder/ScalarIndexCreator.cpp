@@ -12,6 +12,7 @@
 #include "indexbuilder/helper.h"
 #include "indexbuilder/ScalarIndexCreator.h"
 #include "index/IndexFactory.h"
+#include "index/Meta.h"
 
 #include <string>
 
@@ -24,6 +25,11 @@ ScalarIndexCreator::ScalarIndexCreator(CDataType dtype, const char* type_params,
     Helper::ParseFromString(index_params_, std::string(index_params));
     // TODO: create index according to the params.
     index_ = scalar::IndexFactory::GetInstance().CreateIndex(dtype_, index_type());
+    for (const auto& param : index_params_.params()) {
+        if (param.key() == scalar::BUILD_PARALLELISM) {
+            index_->SetBuildParallelism(std::stoll(param.value()));
+        }
+    }
 }
 
 void
@@ -43,8 +49,12 @@ ScalarIndexCreator::Load(const knowhere::BinarySet& binary_set) {
 
 std::string
 ScalarIndexCreator::index_type() {
-    // TODO
-    return "sort";
+    for (const auto& param : index_params_.params()) {
+        if (param.key() == "index_type") {
+            return param.value();
+        }
+    }
+    return scalar::INDEX_TYPE_SORT;
 }
 
 }  // namespace milvus::indexbuilder
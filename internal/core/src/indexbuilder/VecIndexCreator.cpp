@@ -63,6 +63,7 @@ VecIndexCreator::parse_impl(const std::string& serialized_params_str, knowhere::
 
     /***************************** meta *******************************/
     check_parameter<int>(conf, knowhere::meta::SLICE_SIZE, stoi_closure, std::optional{4});
+    check_parameter<int>(conf, BUILD_MEM_BUDGET_MB, stoi_closure, std::nullopt);
     check_parameter<int>(conf, knowhere::meta::DIM, stoi_closure, std::nullopt);
     check_parameter<int>(conf, knowhere::meta::TOPK, stoi_closure, std::nullopt);
 
@@ -184,6 +185,80 @@ VecIndexCreator::BuildWithIds(const knowhere::DatasetPtr& dataset) {
     }
 }
 
+int64_t
+VecIndexCreator::row_bytes() {
+    auto d = dim();
+    return is_in_bin_list(get_index_type()) ? d / 8 : d * sizeof(float);
+}
+
+int64_t
+VecIndexCreator::max_build_block_rows() {
+    auto budget_mb = get_config_by_name<int>(BUILD_MEM_BUDGET_MB);
+    if (!budget_mb.has_value() || budget_mb.value() <= 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(budget_mb.value()) * 1024 * 1024 / row_bytes();
+}
+
+void
+VecIndexCreator::BuildStreamingBegin(const knowhere::DatasetPtr& train_sample, int64_t total_rows) {
+    AssertInfo(streaming_rows_expected_ == 0, "streaming build has already been started");
+    AssertInfo(total_rows > 0, "streaming build needs a positive total row count");
+    auto index_type = get_index_type();
+    auto index_mode = get_index_mode();
+    knowhere::SetMetaRows(config_, total_rows);
+    if (index_type == knowhere::IndexEnum::INDEX_FAISS_IVFPQ) {
+        if (!config_.contains(knowhere::indexparam::NBITS)) {
+            knowhere::SetIndexParamNbits(config_, 8);
+        }
+    }
+    auto conf_adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(index_type);
+    AssertInfo(conf_adapter->CheckTrain(config_, index_mode), "something wrong in index parameters!");
+    if (is_in_need_id_list(index_type)) {
+        PanicInfo(std::string(index_type) + " doesn't support build without ids yet!");
+    }
+    if (is_in_nm_list(index_type)) {
+        // raw vectors must still be kept for non-maintained indexes, but
+        // only once, not next to a second full input copy
+        raw_data_.clear();
+        raw_data_.reserve(total_rows * row_bytes());
+    }
+    index_->Train(train_sample, config_);
+    streaming_rows_expected_ = total_rows;
+    streaming_rows_added_ = 0;
+}
+
+void
+VecIndexCreator::BuildStreamingAdd(const knowhere::DatasetPtr& dataset) {
+    AssertInfo(streaming_rows_expected_ > 0, "streaming build has not been started");
+    auto rows = knowhere::GetDatasetRows(dataset);
+    auto budget_rows = max_build_block_rows();
+    AssertInfo(budget_rows == 0 || rows <= budget_rows,
+               "build block of " + std::to_string(rows) + " rows exceeds the configured memory budget of " +
+                   std::to_string(budget_rows) + " rows");
+    AssertInfo(streaming_rows_added_ + rows <= streaming_rows_expected_,
+               "streaming build received more rows than announced");
+    index_->AddWithoutIds(dataset, config_);
+    if (is_in_nm_list(get_index_type())) {
+        auto tensor = knowhere::GetDatasetTensor(dataset);
+        auto block_bytes = rows * row_bytes();
+        auto old_size = raw_data_.size();
+        raw_data_.resize(old_size + block_bytes);
+        memcpy(raw_data_.data() + old_size, tensor, block_bytes);
+    }
+    streaming_rows_added_ += rows;
+}
+
+void
+VecIndexCreator::BuildStreamingEnd() {
+    AssertInfo(streaming_rows_expected_ > 0, "streaming build has not been started");
+    AssertInfo(streaming_rows_added_ == streaming_rows_expected_,
+               "streaming build ended after " + std::to_string(streaming_rows_added_) + " of " +
+                   std::to_string(streaming_rows_expected_) + " announced rows");
+    streaming_rows_expected_ = 0;
+    streaming_rows_added_ = 0;
+}
+
 void
 VecIndexCreator::StoreRawData(const knowhere::DatasetPtr& dataset) {
     auto index_type = get_index_type();
@@ -218,6 +293,29 @@ VecIndexCreator::Serialize() {
     return ret;
 }
 
+void
+VecIndexCreator::SerializeToSink(const SliceSink& sink) {
+    auto binary_set = index_->Serialize(config_);
+    auto index_type = get_index_type();
+
+    if (is_in_nm_list(index_type)) {
+        // hand Disassemble a view of raw_data_ instead of a copy; the no-op
+        // deleter keeps ownership here, the same trick LoadRawData uses
+        auto bptr = std::make_shared<knowhere::Binary>();
+        bptr->data = std::shared_ptr<uint8_t[]>(raw_data_.data(), [](uint8_t*) {});
+        bptr->size = raw_data_.size();
+        binary_set.Append(RAW_DATA, bptr);
+        knowhere::Disassemble(binary_set, config_);
+    }
+
+    for (auto& [key, binary] : binary_set.binary_map_) {
+        sink(key, binary->data.get(), binary->size);
+        // drop each slice as soon as the sink has consumed it
+        binary->data.reset();
+        binary->size = 0;
+    }
+}
+
 void
 VecIndexCreator::Load(const knowhere::BinarySet& binary_set) {
     auto& map_ = binary_set.binary_map_;
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -32,9 +33,44 @@ class VecIndexCreator : public IndexCreatorBase {
         BuildWithoutIds(dataset);
     }
 
+    // index params key holding the streaming build memory budget in MB;
+    // absent or 0 means unbounded blocks
+    static constexpr const char* BUILD_MEM_BUDGET_MB = "build_mem_budget_mb";
+
+    // Streaming build: train once on a sample, then feed the dataset in
+    // blocks so the whole raw input never has to sit next to the index
+    // being built. Blocks may be released by the caller as soon as the
+    // add call returns.
+    void
+    BuildStreamingBegin(const knowhere::DatasetPtr& train_sample, int64_t total_rows);
+
+    void
+    BuildStreamingAdd(const knowhere::DatasetPtr& dataset);
+
+    void
+    BuildStreamingEnd();
+
+    // largest block row count the configured memory budget allows,
+    // 0 when no budget is set
+    int64_t
+    max_build_block_rows();
+
     knowhere::BinarySet
     Serialize() override;
 
+    // receives one serialized slice at a time; the data pointer is only
+    // valid for the duration of the call
+    using SliceSink = std::function<void(const std::string& key, const uint8_t* data, int64_t size)>;
+
+    // streaming alternative to Serialize(): every binary is handed to the
+    // sink in key order and released as soon as the sink returns, so the
+    // serialized copy of the index drains while it is consumed instead of
+    // staying whole until the caller has copied every key. The raw vectors
+    // of non-maintained indexes are sliced from raw_data_ in place rather
+    // than duplicated first.
+    void
+    SerializeToSink(const SliceSink& sink);
+
     void
     Load(const knowhere::BinarySet& binary_set) override;
 
@@ -79,6 +115,10 @@ class VecIndexCreator : public IndexCreatorBase {
     void
     StoreRawData(const knowhere::DatasetPtr& dataset);
 
+    // bytes one row occupies in the raw input
+    int64_t
+    row_bytes();
+
     void
     LoadRawData();
 
@@ -112,6 +152,8 @@ class VecIndexCreator : public IndexCreatorBase {
     knowhere::Config config_;
     std::vector<uint8_t> raw_data_;
     std::once_flag raw_data_loaded_;
+    int64_t streaming_rows_expected_ = 0;
+    int64_t streaming_rows_added_ = 0;
 };
 
 }  // namespace milvus::indexbuilder
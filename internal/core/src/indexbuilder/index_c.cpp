@@ -99,6 +99,110 @@ BuildBinaryVecIndex(CIndex index, int64_t data_size, const uint8_t* vectors) {
     return status;
 }
 
+CStatus
+BuildFloatVecIndexBegin(CIndex index, int64_t total_row_num, int64_t float_value_num, const float* train_vectors) {
+    auto status = CStatus();
+    try {
+        AssertInfo(index, "failed to begin streaming build, passed index was null");
+        auto real_index = reinterpret_cast<milvus::indexbuilder::IndexCreatorBase*>(index);
+        auto cIndex = dynamic_cast<milvus::indexbuilder::VecIndexCreator*>(real_index);
+        auto dim = cIndex->dim();
+        auto row_nums = float_value_num / dim;
+        auto ds = knowhere::GenDataset(row_nums, dim, train_vectors);
+        cIndex->BuildStreamingBegin(ds, total_row_num);
+        status.error_code = Success;
+        status.error_msg = "";
+    } catch (std::exception& e) {
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+    }
+    return status;
+}
+
+CStatus
+BuildFloatVecIndexBlock(CIndex index, int64_t float_value_num, const float* vectors) {
+    auto status = CStatus();
+    try {
+        AssertInfo(index, "failed to add streaming build block, passed index was null");
+        auto real_index = reinterpret_cast<milvus::indexbuilder::IndexCreatorBase*>(index);
+        auto cIndex = dynamic_cast<milvus::indexbuilder::VecIndexCreator*>(real_index);
+        auto dim = cIndex->dim();
+        auto row_nums = float_value_num / dim;
+        auto ds = knowhere::GenDataset(row_nums, dim, vectors);
+        cIndex->BuildStreamingAdd(ds);
+        status.error_code = Success;
+        status.error_msg = "";
+    } catch (std::exception& e) {
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+    }
+    return status;
+}
+
+CStatus
+BuildBinaryVecIndexBegin(CIndex index, int64_t total_row_num, int64_t data_size, const uint8_t* train_vectors) {
+    auto status = CStatus();
+    try {
+        AssertInfo(index, "failed to begin streaming build, passed index was null");
+        auto real_index = reinterpret_cast<milvus::indexbuilder::IndexCreatorBase*>(index);
+        auto cIndex = dynamic_cast<milvus::indexbuilder::VecIndexCreator*>(real_index);
+        auto dim = cIndex->dim();
+        auto row_nums = (data_size * 8) / dim;
+        auto ds = knowhere::GenDataset(row_nums, dim, train_vectors);
+        cIndex->BuildStreamingBegin(ds, total_row_num);
+        status.error_code = Success;
+        status.error_msg = "";
+    } catch (std::exception& e) {
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+    }
+    return status;
+}
+
+CStatus
+BuildBinaryVecIndexBlock(CIndex index, int64_t data_size, const uint8_t* vectors) {
+    auto status = CStatus();
+    try {
+        AssertInfo(index, "failed to add streaming build block, passed index was null");
+        auto real_index = reinterpret_cast<milvus::indexbuilder::IndexCreatorBase*>(index);
+        auto cIndex = dynamic_cast<milvus::indexbuilder::VecIndexCreator*>(real_index);
+        auto dim = cIndex->dim();
+        auto row_nums = (data_size * 8) / dim;
+        auto ds = knowhere::GenDataset(row_nums, dim, vectors);
+        cIndex->BuildStreamingAdd(ds);
+        status.error_code = Success;
+        status.error_msg = "";
+    } catch (std::exception& e) {
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+    }
+    return status;
+}
+
+CStatus
+BuildVecIndexEnd(CIndex index) {
+    auto status = CStatus();
+    try {
+        AssertInfo(index, "failed to end streaming build, passed index was null");
+        auto real_index = reinterpret_cast<milvus::indexbuilder::IndexCreatorBase*>(index);
+        auto cIndex = dynamic_cast<milvus::indexbuilder::VecIndexCreator*>(real_index);
+        cIndex->BuildStreamingEnd();
+        status.error_code = Success;
+        status.error_msg = "";
+    } catch (std::exception& e) {
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+    }
+    return status;
+}
+
+int64_t
+GetBuildBlockRows(CIndex index) {
+    auto real_index = reinterpret_cast<milvus::indexbuilder::IndexCreatorBase*>(index);
+    auto cIndex = dynamic_cast<milvus::indexbuilder::VecIndexCreator*>(real_index);
+    return cIndex->max_build_block_rows();
+}
+
 // field_data:
 //  1, serialized proto::schema::BoolArray, if type is bool;
 //  2, serialized proto::schema::StringArray, if type is string;
@@ -141,6 +245,38 @@ SerializeIndexToBinarySet(CIndex index, CBinarySet* c_binary_set) {
     return status;
 }
 
+CStatus
+SerializeIndexToSink(CIndex index, CIndexSliceSink sink, void* context) {
+    auto status = CStatus();
+    try {
+        AssertInfo(index, "failed to serialize index to sink, passed index was null");
+        AssertInfo(sink, "failed to serialize index to sink, passed sink was null");
+        auto real_index = reinterpret_cast<milvus::indexbuilder::IndexCreatorBase*>(index);
+        auto consume = [&](const std::string& key, const uint8_t* data, int64_t size) {
+            auto ret = sink(context, key.c_str(), data, size);
+            AssertInfo(ret == 0, "index slice sink failed on key " + key);
+        };
+        if (auto vec_index = dynamic_cast<milvus::indexbuilder::VecIndexCreator*>(real_index)) {
+            vec_index->SerializeToSink(consume);
+        } else {
+            // scalar indexes are small; stream the set with the same
+            // release-as-consumed contract for a uniform caller
+            auto binary_set = real_index->Serialize();
+            for (auto& [key, binary] : binary_set.binary_map_) {
+                consume(key, binary->data.get(), binary->size);
+                binary->data.reset();
+                binary->size = 0;
+            }
+        }
+        status.error_code = Success;
+        status.error_msg = "";
+    } catch (std::exception& e) {
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+    }
+    return status;
+}
+
 CStatus
 LoadIndexFromBinarySet(CIndex index, CBinarySet c_binary_set) {
     auto status = CStatus();
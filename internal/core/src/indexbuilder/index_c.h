@@ -35,6 +35,29 @@ BuildFloatVecIndex(CIndex index, int64_t float_value_num, const float* vectors);
 CStatus
 BuildBinaryVecIndex(CIndex index, int64_t data_size, const uint8_t* vectors);
 
+// Streaming build: train on a sample, then feed the dataset in blocks the
+// caller can free right after each call, instead of keeping the whole raw
+// input resident next to the index being built. total_row_num announces the
+// final size; the index params key "build_mem_budget_mb" caps block sizes.
+CStatus
+BuildFloatVecIndexBegin(CIndex index, int64_t total_row_num, int64_t float_value_num, const float* train_vectors);
+
+CStatus
+BuildFloatVecIndexBlock(CIndex index, int64_t float_value_num, const float* vectors);
+
+CStatus
+BuildBinaryVecIndexBegin(CIndex index, int64_t total_row_num, int64_t data_size, const uint8_t* train_vectors);
+
+CStatus
+BuildBinaryVecIndexBlock(CIndex index, int64_t data_size, const uint8_t* vectors);
+
+CStatus
+BuildVecIndexEnd(CIndex index);
+
+// largest block row count the configured budget allows, 0 when unbounded
+int64_t
+GetBuildBlockRows(CIndex index);
+
 // field_data:
 //  1, serialized proto::schema::BoolArray, if type is bool;
 //  2, serialized proto::schema::StringArray, if type is string;
@@ -46,6 +69,17 @@ BuildScalarIndex(CIndex c_index, int64_t size, const void* field_data);
 CStatus
 SerializeIndexToBinarySet(CIndex index, CBinarySet* c_binary_set);
 
+// receives one serialized slice; slice_data is only valid during the call.
+// Return 0 to continue, anything else aborts the serialization with an error.
+typedef int (*CIndexSliceSink)(void* context, const char* key, const uint8_t* slice_data, int64_t slice_size);
+
+// streaming alternative to SerializeIndexToBinarySet: slices are pushed to
+// the sink one at a time and freed as soon as it returns, so the caller can
+// write them straight to storage without holding a second full copy of the
+// index in memory
+CStatus
+SerializeIndexToSink(CIndex index, CIndexSliceSink sink, void* context);
+
 CStatus
 LoadIndexFromBinarySet(CIndex index, CBinarySet c_binary_set);
 
@@ -0,0 +1,213 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "log/AsyncLogSink.h"
+
+namespace milvus {
+
+namespace {
+
+// a dispatch captured on the logging thread; el::LogMessage copies the
+// streamed text and metadata by value, so the entry stays valid after the
+// caller's Writer frame unwinds. The Logger pointer inside stays valid for
+// the process lifetime (loggers are registered once and never destroyed).
+struct PendingLog {
+    el::LogMessage message;
+    el::base::DispatchAction action;
+};
+
+class AsyncLogWriter {
+ public:
+    static AsyncLogWriter&
+    Instance() {
+        static AsyncLogWriter writer;
+        return writer;
+    }
+
+    void
+    Start(int64_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = capacity;
+        if (!running_) {
+            running_ = true;
+            worker_ = std::thread([this] { Run(); });
+        }
+    }
+
+    void
+    Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) {
+                return;
+            }
+            running_ = false;
+            not_empty_.notify_all();
+        }
+        worker_.join();
+        // the writer loop drains the queue before exiting, nothing left here
+    }
+
+    void
+    Push(const el::LogDispatchData* data) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        if (static_cast<int64_t>(queue_.size()) >= capacity_) {
+            ++dropped_;
+            return;
+        }
+        queue_.push_back(PendingLog{*data->logMessage(), data->dispatchAction()});
+        not_empty_.notify_one();
+    }
+
+    void
+    Flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        drained_.wait(lock, [this] { return (queue_.empty() && !writing_) || !running_; });
+    }
+
+    int64_t
+    dropped() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dropped_;
+    }
+
+    // synchronous write used for Fatal and for the writer thread itself;
+    // mirrors DefaultLogDispatchCallback::dispatch through the public
+    // Logger/TypedConfigurations interface
+    static void
+    Write(PendingLog& entry) {
+        if (entry.action != el::base::DispatchAction::NormalLog) {
+            return;
+        }
+        auto* logger = entry.message.logger();
+        auto log_line = logger->logBuilder()->build(&entry.message, true);
+        auto* conf = logger->typedConfigurations();
+        auto level = entry.message.level();
+        if (conf->toFile(level)) {
+            auto* fs = conf->fileStream(level);
+            if (fs != nullptr) {
+                fs->write(log_line.c_str(), log_line.size());
+                if (!fs->fail() &&
+                    (ELPP->hasFlag(el::LoggingFlag::ImmediateFlush) || logger->isFlushNeeded(level))) {
+                    logger->flush(level, fs);
+                }
+            }
+        }
+        if (conf->toStandardOutput(level)) {
+            if (ELPP->hasFlag(el::LoggingFlag::ColoredTerminalOutput)) {
+                logger->logBuilder()->convertToColoredOutput(&log_line, level);
+            }
+            ELPP_COUT << ELPP_COUT_LINE(log_line);
+        }
+    }
+
+ private:
+    void
+    Run() {
+        std::vector<PendingLog> batch;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_ || !queue_.empty()) {
+            not_empty_.wait(lock, [this] { return !queue_.empty() || !running_; });
+            if (queue_.empty()) {
+                continue;
+            }
+            batch.swap(queue_);
+            writing_ = true;
+            lock.unlock();
+            for (auto& entry : batch) {
+                Write(entry);
+            }
+            batch.clear();
+            lock.lock();
+            writing_ = false;
+            if (queue_.empty()) {
+                drained_.notify_all();
+            }
+        }
+        drained_.notify_all();
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable drained_;
+    std::vector<PendingLog> queue_;
+    int64_t capacity_ = AsyncLogSink::kDefaultQueueCapacity;
+    int64_t dropped_ = 0;
+    bool running_ = false;
+    bool writing_ = false;
+    std::thread worker_;
+};
+
+const char kAsyncSinkId[] = "AsyncLogSink";
+const char kDefaultSinkId[] = "DefaultLogDispatchCallback";
+
+void
+SetDefaultDispatchEnabled(bool enabled) {
+    auto* cb = el::Helpers::logDispatchCallback<el::base::DefaultLogDispatchCallback>(kDefaultSinkId);
+    if (cb != nullptr) {
+        cb->setEnabled(enabled);
+    }
+}
+
+}  // namespace
+
+void
+AsyncLogSink::Enable(int64_t queue_capacity) {
+    AsyncLogWriter::Instance().Start(queue_capacity);
+    el::Helpers::installLogDispatchCallback<AsyncLogSink>(kAsyncSinkId);
+    SetDefaultDispatchEnabled(false);
+}
+
+void
+AsyncLogSink::Disable() {
+    SetDefaultDispatchEnabled(true);
+    el::Helpers::uninstallLogDispatchCallback<AsyncLogSink>(kAsyncSinkId);
+    AsyncLogWriter::Instance().Stop();
+}
+
+void
+AsyncLogSink::Flush() {
+    AsyncLogWriter::Instance().Flush();
+}
+
+int64_t
+AsyncLogSink::DroppedCount() {
+    return AsyncLogWriter::Instance().dropped();
+}
+
+void
+AsyncLogSink::handle(const el::LogDispatchData* data) {
+    if (data->logMessage()->level() == el::Level::Fatal) {
+        // the process aborts right after a fatal log; drain what is already
+        // queued so the log ends in order, then write the fatal line here
+        AsyncLogWriter::Instance().Flush();
+        PendingLog entry{*data->logMessage(), data->dispatchAction()};
+        AsyncLogWriter::Write(entry);
+        return;
+    }
+    AsyncLogWriter::Instance().Push(data);
+}
+
+}  // namespace milvus
@@ -0,0 +1,65 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include "easyloggingpp/easylogging++.h"
+
+namespace milvus {
+
+// Asynchronous backend for the easylogging dispatch path. The stock
+// DefaultLogDispatchCallback formats the log line and writes it to the file
+// and console streams on the calling thread, so a LOG_SEGCORE_INFO_ inside a
+// search or load path pays for timestamp formatting and a (possibly blocking)
+// file write. When this sink is enabled it replaces the default dispatch: the
+// caller only copies the already-streamed message plus its metadata into a
+// bounded queue, and a single background writer thread does the line
+// formatting and the actual writes. The LOG_SEGCORE_* / MLOG macros are
+// untouched; only where the write happens changes.
+//
+// The queue is bounded so a stalled disk cannot grow memory without limit;
+// when it is full new entries are counted and dropped rather than blocking
+// the logging thread. Fatal messages bypass the queue and are written
+// synchronously, since the process is about to abort and the queue would
+// never be drained.
+class AsyncLogSink : public el::LogDispatchCallback {
+ public:
+    // install the sink and mute the default synchronous dispatch; idempotent
+    static void
+    Enable(int64_t queue_capacity = kDefaultQueueCapacity);
+
+    // drain the queue, stop the writer and restore synchronous dispatch
+    static void
+    Disable();
+
+    // block until every entry queued so far has been written
+    static void
+    Flush();
+
+    // entries discarded because the queue was full since Enable()
+    static int64_t
+    DroppedCount();
+
+    static constexpr int64_t kDefaultQueueCapacity = 8192;
+
+ protected:
+    void
+    handle(const el::LogDispatchData* data) override;
+};
+
+}  // namespace milvus
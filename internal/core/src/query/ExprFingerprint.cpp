@@ -0,0 +1,177 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "query/ExprFingerprint.h"
+
+#include <type_traits>
+
+#include "query/ExprImpl.h"
+
+namespace milvus::query {
+
+namespace {
+
+void
+AppendBytes(std::string& out, const void* data, size_t size) {
+    out.append(static_cast<const char*>(data), size);
+}
+
+template <typename T>
+void
+AppendValue(std::string& out, const T& value) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        auto size = value.size();
+        AppendBytes(out, &size, sizeof(size));
+        out.append(value);
+    } else {
+        AppendBytes(out, &value, sizeof(value));
+    }
+}
+
+void
+AppendEnum(std::string& out, int32_t value) {
+    AppendBytes(out, &value, sizeof(value));
+}
+
+// runs func with a value of the C++ type carrying data_type's constants in
+// the expression impls; false for types no expression is built with
+template <typename Func>
+bool
+DispatchDataType(DataType data_type, Func func) {
+    switch (data_type) {
+        case DataType::BOOL:
+            return func(bool{});
+        case DataType::INT8:
+            return func(int8_t{});
+        case DataType::INT16:
+            return func(int16_t{});
+        case DataType::INT32:
+            return func(int32_t{});
+        case DataType::INT64:
+            return func(int64_t{});
+        case DataType::FLOAT:
+            return func(float{});
+        case DataType::DOUBLE:
+            return func(double{});
+        case DataType::VARCHAR:
+            return func(std::string{});
+        default:
+            return false;
+    }
+}
+
+bool
+AppendExpr(std::string& out, const Expr& expr, const std::optional<FieldId>& pk_field_id) {
+    if (auto node = dynamic_cast<const LogicalUnaryExpr*>(&expr)) {
+        out.push_back('n');
+        AppendEnum(out, static_cast<int32_t>(node->op_type_));
+        return AppendExpr(out, *node->child_, pk_field_id);
+    }
+    if (auto node = dynamic_cast<const LogicalBinaryExpr*>(&expr)) {
+        out.push_back('l');
+        AppendEnum(out, static_cast<int32_t>(node->op_type_));
+        return AppendExpr(out, *node->left_, pk_field_id) && AppendExpr(out, *node->right_, pk_field_id);
+    }
+    if (auto node = dynamic_cast<const TermExpr*>(&expr)) {
+        if (pk_field_id.has_value() && pk_field_id.value() == node->field_id_) {
+            // pk IN lists run through search_ids, whose result depends on
+            // the query timestamp
+            return false;
+        }
+        out.push_back('t');
+        AppendValue(out, node->field_id_.get());
+        AppendEnum(out, static_cast<int32_t>(node->data_type_));
+        return DispatchDataType(node->data_type_, [&](auto zero) {
+            using T = decltype(zero);
+            auto typed = dynamic_cast<const TermExprImpl<T>*>(node);
+            if (typed == nullptr) {
+                return false;
+            }
+            AppendValue(out, typed->terms_.size());
+            for (const T& term : typed->terms_) {
+                AppendValue(out, term);
+            }
+            return true;
+        });
+    }
+    if (auto node = dynamic_cast<const UnaryRangeExpr*>(&expr)) {
+        out.push_back('u');
+        AppendValue(out, node->field_id_.get());
+        AppendEnum(out, static_cast<int32_t>(node->data_type_));
+        AppendEnum(out, static_cast<int32_t>(node->op_type_));
+        return DispatchDataType(node->data_type_, [&](auto zero) {
+            using T = decltype(zero);
+            auto typed = dynamic_cast<const UnaryRangeExprImpl<T>*>(node);
+            if (typed == nullptr) {
+                return false;
+            }
+            AppendValue(out, typed->value_);
+            return true;
+        });
+    }
+    if (auto node = dynamic_cast<const BinaryRangeExpr*>(&expr)) {
+        out.push_back('b');
+        AppendValue(out, node->field_id_.get());
+        AppendEnum(out, static_cast<int32_t>(node->data_type_));
+        AppendValue(out, node->lower_inclusive_);
+        AppendValue(out, node->upper_inclusive_);
+        return DispatchDataType(node->data_type_, [&](auto zero) {
+            using T = decltype(zero);
+            auto typed = dynamic_cast<const BinaryRangeExprImpl<T>*>(node);
+            if (typed == nullptr) {
+                return false;
+            }
+            AppendValue(out, typed->lower_value_);
+            AppendValue(out, typed->upper_value_);
+            return true;
+        });
+    }
+    if (auto node = dynamic_cast<const BinaryArithOpEvalRangeExpr*>(&expr)) {
+        out.push_back('a');
+        AppendValue(out, node->field_id_.get());
+        AppendEnum(out, static_cast<int32_t>(node->data_type_));
+        AppendEnum(out, static_cast<int32_t>(node->op_type_));
+        AppendEnum(out, static_cast<int32_t>(node->arith_op_));
+        return DispatchDataType(node->data_type_, [&](auto zero) {
+            using T = decltype(zero);
+            auto typed = dynamic_cast<const BinaryArithOpEvalRangeExprImpl<T>*>(node);
+            if (typed == nullptr) {
+                return false;
+            }
+            AppendValue(out, typed->right_operand_);
+            AppendValue(out, typed->value_);
+            return true;
+        });
+    }
+    if (auto node = dynamic_cast<const CompareExpr*>(&expr)) {
+        out.push_back('c');
+        AppendValue(out, node->left_field_id_.get());
+        AppendValue(out, node->right_field_id_.get());
+        AppendEnum(out, static_cast<int32_t>(node->left_data_type_));
+        AppendEnum(out, static_cast<int32_t>(node->right_data_type_));
+        AppendEnum(out, static_cast<int32_t>(node->op_type_));
+        return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+std::optional<std::string>
+FingerprintExpr(const Expr& expr, const Schema& schema) {
+    std::string out;
+    if (!AppendExpr(out, expr, schema.get_primary_field_id())) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+}  // namespace milvus::query
@@ -0,0 +1,30 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "common/Schema.h"
+#include "query/Expr.h"
+
+namespace milvus::query {
+
+// Serializes an expression tree — structure plus constants — into a byte
+// string usable as a cache key: equal fingerprints evaluate identically
+// over the same column data. Returns nullopt for trees that must not be
+// cached, i.e. unknown node kinds or pk IN lists, whose result depends on
+// the query timestamp.
+std::optional<std::string>
+FingerprintExpr(const Expr& expr, const Schema& schema);
+
+}  // namespace milvus::query
@@ -0,0 +1,379 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <algorithm>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include "LoweredExpr.h"
+#include "ExprImpl.h"
+#include "common/BitsetUtils.h"
+#include "common/Utils.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus::query {
+
+namespace {
+
+// mirrors the visitor's threshold for fanning chunk evaluation out to tbb
+constexpr int64_t kParallelEvalRowThreshold = 256 * 1024;
+
+template <typename T>
+bool
+IsFoldable(T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        // a NaN bound cannot be folded into an interval: every comparison
+        // against it is false, which interval arithmetic would lose
+        return value == value;
+    }
+    return true;
+}
+
+template <typename T>
+void
+TightenLower(LoweredInterval<T>& term, T value, bool inclusive) {
+    if (!term.has_lower_ || value > term.lower_ || (value == term.lower_ && !inclusive)) {
+        term.has_lower_ = true;
+        term.lower_ = value;
+        term.lower_inclusive_ = inclusive;
+    }
+}
+
+template <typename T>
+void
+TightenUpper(LoweredInterval<T>& term, T value, bool inclusive) {
+    if (!term.has_upper_ || value < term.upper_ || (value == term.upper_ && !inclusive)) {
+        term.has_upper_ = true;
+        term.upper_ = value;
+        term.upper_inclusive_ = inclusive;
+    }
+}
+
+template <typename T>
+bool
+FoldLeaf(LoweredInterval<T>& term, const UnaryRangeExprImpl<T>& expr) {
+    auto val = expr.value_;
+    if (!IsFoldable(val)) {
+        return false;
+    }
+    switch (expr.op_type_) {
+        case OpType::Equal: {
+            TightenLower(term, val, true);
+            TightenUpper(term, val, true);
+            return true;
+        }
+        case OpType::NotEqual: {
+            term.excluded_.push_back(val);
+            return true;
+        }
+        case OpType::GreaterEqual: {
+            TightenLower(term, val, true);
+            return true;
+        }
+        case OpType::GreaterThan: {
+            TightenLower(term, val, false);
+            return true;
+        }
+        case OpType::LessEqual: {
+            TightenUpper(term, val, true);
+            return true;
+        }
+        case OpType::LessThan: {
+            TightenUpper(term, val, false);
+            return true;
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+template <typename T>
+bool
+FoldLeaf(LoweredInterval<T>& term, const BinaryRangeExprImpl<T>& expr) {
+    if (!IsFoldable(expr.lower_value_) || !IsFoldable(expr.upper_value_)) {
+        return false;
+    }
+    TightenLower(term, expr.lower_value_, expr.lower_inclusive_);
+    TightenUpper(term, expr.upper_value_, expr.upper_inclusive_);
+    return true;
+}
+
+template <typename T, typename ExprImplType>
+bool
+FoldInto(LoweredExpr& out, const ExprImplType& expr) {
+    for (auto& candidate : out.terms_) {
+        bool matched = false;
+        bool folded = true;
+        std::visit(
+            [&](auto& term) {
+                if (term.field_id_ != expr.field_id_) {
+                    return;
+                }
+                matched = true;
+                if constexpr (std::is_same_v<std::decay_t<decltype(term)>, LoweredInterval<T>>) {
+                    folded = FoldLeaf(term, expr);
+                } else {
+                    folded = false;
+                }
+            },
+            candidate);
+        if (matched) {
+            return folded;
+        }
+    }
+    LoweredInterval<T> term;
+    term.field_id_ = expr.field_id_;
+    if (!FoldLeaf(term, expr)) {
+        return false;
+    }
+    out.terms_.emplace_back(std::move(term));
+    return true;
+}
+
+template <template <typename> class ExprImplType, typename ExprBaseType>
+bool
+FoldDispatch(LoweredExpr& out, const ExprBaseType& expr_raw) {
+    switch (expr_raw.data_type_) {
+        case DataType::BOOL:
+            return FoldInto<bool>(out, static_cast<const ExprImplType<bool>&>(expr_raw));
+        case DataType::INT8:
+            return FoldInto<int8_t>(out, static_cast<const ExprImplType<int8_t>&>(expr_raw));
+        case DataType::INT16:
+            return FoldInto<int16_t>(out, static_cast<const ExprImplType<int16_t>&>(expr_raw));
+        case DataType::INT32:
+            return FoldInto<int32_t>(out, static_cast<const ExprImplType<int32_t>&>(expr_raw));
+        case DataType::INT64:
+            return FoldInto<int64_t>(out, static_cast<const ExprImplType<int64_t>&>(expr_raw));
+        case DataType::FLOAT:
+            return FoldInto<float>(out, static_cast<const ExprImplType<float>&>(expr_raw));
+        case DataType::DOUBLE:
+            return FoldInto<double>(out, static_cast<const ExprImplType<double>&>(expr_raw));
+        default:
+            return false;
+    }
+}
+
+bool
+FlattenConjunction(LoweredExpr& out, const Expr& expr) {
+    if (auto node = dynamic_cast<const LogicalBinaryExpr*>(&expr)) {
+        if (node->op_type_ != LogicalBinaryExpr::OpType::LogicalAnd) {
+            return false;
+        }
+        return FlattenConjunction(out, *node->left_) && FlattenConjunction(out, *node->right_);
+    }
+    if (auto node = dynamic_cast<const UnaryRangeExpr*>(&expr)) {
+        return FoldDispatch<UnaryRangeExprImpl>(out, *node);
+    }
+    if (auto node = dynamic_cast<const BinaryRangeExpr*>(&expr)) {
+        return FoldDispatch<BinaryRangeExprImpl>(out, *node);
+    }
+    return false;
+}
+
+template <typename T>
+void
+PruneExcluded(LoweredInterval<T>& term) {
+    auto outside = [&](T e) {
+        if (term.has_lower_ && (e < term.lower_ || (e == term.lower_ && !term.lower_inclusive_))) {
+            return true;
+        }
+        if (term.has_upper_ && (e > term.upper_ || (e == term.upper_ && !term.upper_inclusive_))) {
+            return true;
+        }
+        return false;
+    };
+    term.excluded_.erase(std::remove_if(term.excluded_.begin(), term.excluded_.end(), outside), term.excluded_.end());
+}
+
+template <typename T>
+bool
+IntervalEmpty(const LoweredInterval<T>& term) {
+    if (!term.has_lower_ || !term.has_upper_) {
+        return false;
+    }
+    if (term.lower_ > term.upper_) {
+        return true;
+    }
+    if (term.lower_ == term.upper_) {
+        if (!(term.lower_inclusive_ && term.upper_inclusive_)) {
+            return true;
+        }
+        // single admissible point: a NotEqual on it empties the interval
+        return std::find(term.excluded_.begin(), term.excluded_.end(), term.lower_) != term.excluded_.end();
+    }
+    return false;
+}
+
+// what a chunk's zone map decides about one term before its rows are read
+enum class TermVerdict { Scan, AllFalse, AllTrue };
+
+template <typename T>
+TermVerdict
+ZoneMapVerdict(const LoweredInterval<T>& term, T chunk_min, T chunk_max) {
+    if (term.has_lower_ && (chunk_max < term.lower_ || (chunk_max == term.lower_ && !term.lower_inclusive_))) {
+        return TermVerdict::AllFalse;
+    }
+    if (term.has_upper_ && (chunk_min > term.upper_ || (chunk_min == term.upper_ && !term.upper_inclusive_))) {
+        return TermVerdict::AllFalse;
+    }
+    bool lower_covered =
+        !term.has_lower_ || (term.lower_inclusive_ ? term.lower_ <= chunk_min : term.lower_ < chunk_min);
+    bool upper_covered =
+        !term.has_upper_ || (term.upper_inclusive_ ? term.upper_ >= chunk_max : term.upper_ > chunk_max);
+    if (lower_covered && upper_covered) {
+        for (auto e : term.excluded_) {
+            if (chunk_min <= e && e <= chunk_max) {
+                return TermVerdict::Scan;
+            }
+        }
+        return TermVerdict::AllTrue;
+    }
+    return TermVerdict::Scan;
+}
+
+BitsetType
+ExecLowered(const segcore::SegmentInternalInterface& segment, int64_t row_count, const LoweredExpr& lowered) {
+    auto size_per_chunk = segment.size_per_chunk();
+    auto num_chunk = upper_div(row_count, size_per_chunk);
+    std::vector<BitsetType> results(num_chunk);
+    auto eval_chunk = [&](int64_t chunk_id) {
+        auto this_size = chunk_id == num_chunk - 1 ? row_count - chunk_id * size_per_chunk : size_per_chunk;
+        BitsetType result(this_size);
+        BitsetType scratch;
+        bool first = true;
+        for (auto& candidate : lowered.terms_) {
+            bool dead = false;
+            std::visit(
+                [&](const auto& term) {
+                    using T = typename std::decay_t<decltype(term)>::value_type;
+                    T chunk_min{};
+                    T chunk_max{};
+                    auto verdict = TermVerdict::Scan;
+                    if (segment.chunk_min_max(term.field_id_, chunk_id, chunk_min, chunk_max)) {
+                        verdict = ZoneMapVerdict(term, chunk_min, chunk_max);
+                    }
+                    if (verdict == TermVerdict::AllFalse) {
+                        dead = true;
+                        return;
+                    }
+                    if (verdict == TermVerdict::AllTrue) {
+                        if (first) {
+                            result.set();
+                            first = false;
+                        }
+                        return;
+                    }
+                    auto chunk = segment.chunk_data<T>(term.field_id_, chunk_id);
+                    const T* data = chunk.data();
+                    // the whole per-field constraint in one pass: both
+                    // bounds plus the NotEqual holes
+                    auto elem_func = [&term](const T& x) {
+                        if (term.has_lower_ && !(term.lower_inclusive_ ? term.lower_ <= x : term.lower_ < x)) {
+                            return false;
+                        }
+                        if (term.has_upper_ && !(term.upper_inclusive_ ? x <= term.upper_ : x < term.upper_)) {
+                            return false;
+                        }
+                        for (auto e : term.excluded_) {
+                            if (x == e) {
+                                return false;
+                            }
+                        }
+                        return true;
+                    };
+                    if (first) {
+                        EvalElementwise(data, this_size, result, elem_func);
+                        first = false;
+                    } else {
+                        scratch.clear();
+                        scratch.resize(this_size);
+                        EvalElementwise(data, this_size, scratch, elem_func);
+                        result &= scratch;
+                    }
+                },
+                candidate);
+            if (dead) {
+                result.reset();
+                first = false;
+                break;
+            }
+            if (!first && result.none()) {
+                break;
+            }
+        }
+        if (first) {
+            // every term was decided AllTrue by zone maps alone
+            result.set();
+        }
+        results[chunk_id] = std::move(result);
+    };
+    if (num_chunk > 1 && row_count >= kParallelEvalRowThreshold) {
+        tbb::parallel_for(tbb::blocked_range<int64_t>(0, num_chunk), [&](const tbb::blocked_range<int64_t>& range) {
+            for (auto chunk_id = range.begin(); chunk_id != range.end(); ++chunk_id) {
+                eval_chunk(chunk_id);
+            }
+        });
+    } else {
+        for (auto chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
+            eval_chunk(chunk_id);
+        }
+    }
+
+    BitsetType final_result(row_count);
+    int64_t counter = 0;
+    for (auto& chunk : results) {
+        AppendBitset(final_result, counter, chunk);
+        counter += chunk.size();
+    }
+    return final_result;
+}
+
+}  // namespace
+
+std::optional<LoweredExpr>
+LowerExpr(const Expr& expr) {
+    LoweredExpr out;
+    if (!FlattenConjunction(out, expr)) {
+        return std::nullopt;
+    }
+    for (auto& candidate : out.terms_) {
+        std::visit(
+            [&](auto& term) {
+                PruneExcluded(term);
+                if (IntervalEmpty(term)) {
+                    out.always_false_ = true;
+                }
+            },
+            candidate);
+    }
+    return out;
+}
+
+std::optional<BitsetType>
+TryExecLoweredExpr(const segcore::SegmentInternalInterface& segment, int64_t row_count, const Expr& expr) {
+    auto lowered = LowerExpr(expr);
+    if (!lowered.has_value()) {
+        return std::nullopt;
+    }
+    if (lowered->always_false_) {
+        return BitsetType(row_count);
+    }
+    for (auto& candidate : lowered->terms_) {
+        auto field_id = std::visit([](const auto& term) { return term.field_id_; }, candidate);
+        if (segment.num_chunk_index(field_id) > 0) {
+            return std::nullopt;
+        }
+    }
+    return ExecLowered(segment, row_count, *lowered);
+}
+
+}  // namespace milvus::query
@@ -0,0 +1,74 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <optional>
+#include <variant>
+#include <vector>
+
+#include "Expr.h"
+
+namespace milvus::segcore {
+class SegmentInternalInterface;
+}
+
+namespace milvus::query {
+
+// One field's share of a lowered conjunction: every range leaf on the field
+// is folded into a single [lower, upper] interval plus the NotEqual holes,
+// so the field contributes exactly one fused scan regardless of how many
+// leaves the plan spelled it with.
+template <typename T>
+struct LoweredInterval {
+    using value_type = T;
+
+    FieldId field_id_;
+    bool has_lower_ = false;
+    bool has_upper_ = false;
+    bool lower_inclusive_ = false;
+    bool upper_inclusive_ = false;
+    T lower_{};
+    T upper_{};
+    // NotEqual values; pruned to those inside the interval
+    std::vector<T> excluded_;
+};
+
+using LoweredTerm = std::variant<LoweredInterval<bool>,
+                                 LoweredInterval<int8_t>,
+                                 LoweredInterval<int16_t>,
+                                 LoweredInterval<int32_t>,
+                                 LoweredInterval<int64_t>,
+                                 LoweredInterval<float>,
+                                 LoweredInterval<double>>;
+
+// Devirtualized form of a filter, dispatched with std::visit instead of
+// Expr::accept. The virtual visitor tree stays authoritative for tooling
+// (ShowExprVisitor et al.) and for anything this form cannot express.
+struct LoweredExpr {
+    std::vector<LoweredTerm> terms_;
+    // interval intersection proved the conjunction unsatisfiable
+    bool always_false_ = false;
+};
+
+// Lowers AND-trees of arithmetic UnaryRange/BinaryRange leaves; nullopt for
+// anything else (strings, OR/NOT, term lists, cross-field compares), which
+// then runs through ExecExprVisitor unchanged.
+std::optional<LoweredExpr>
+LowerExpr(const Expr& expr);
+
+// Lowers and evaluates `expr` on `segment`, returning the match bitset, or
+// nullopt when the expression does not lower or an involved field carries a
+// scalar index (whose Range lookup beats any fused scan).
+std::optional<BitsetType>
+TryExecLoweredExpr(const segcore::SegmentInternalInterface& segment, int64_t row_count, const Expr& expr);
+
+}  // namespace milvus::query
@@ -14,6 +14,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <google/protobuf/arena.h>
+
 #include "Parser.h"
 #include "Plan.h"
 #include "PlanProto.h"
@@ -32,10 +34,15 @@ std::unique_ptr<PlaceholderGroup>
 ParsePlaceholderGroup(const Plan* plan, const uint8_t* blob, const int64_t blob_len) {
     namespace ser = milvus::proto::common;
     auto result = std::make_unique<PlaceholderGroup>();
-    ser::PlaceholderGroup ph_group;
-    auto ok = ph_group.ParseFromArray(blob, blob_len);
+    // parse onto an arena: the decoded group is dozens of small messages
+    // and value strings, released together by one arena teardown instead
+    // of individual frees
+    auto arena = std::make_shared<google::protobuf::Arena>();
+    auto* ph_group = google::protobuf::Arena::CreateMessage<ser::PlaceholderGroup>(arena.get());
+    auto ok = ph_group->ParseFromArray(blob, blob_len);
     Assert(ok);
-    for (auto& info : ph_group.placeholders()) {
+    bool wrapped = false;
+    for (auto& info : ph_group->placeholders()) {
         Placeholder element;
         element.tag_ = info.tag();
         Assert(plan->tag2field_.count(element.tag_));
@@ -46,14 +53,34 @@ ParsePlaceholderGroup(const Plan* plan, const uint8_t* blob, const int64_t blob_
         Assert(element.num_of_queries_ > 0);
         element.line_sizeof_ = info.values().Get(0).size();
         AssertInfo(field_meta.get_sizeof() == element.line_sizeof_, "vector dimension mismatch");
-        auto& target = element.blob_;
-        target.reserve(element.line_sizeof_ * element.num_of_queries_);
         for (auto& line : info.values()) {
             Assert(element.line_sizeof_ == line.size());
-            target.insert(target.end(), line.begin(), line.end());
+        }
+        // zero-copy mode: the decoded values frequently sit back to back in
+        // the proto's storage; when they do and the start is element
+        // aligned, point the placeholder at them instead of staging a copy
+        const char* first = info.values().Get(0).data();
+        bool wrappable = reinterpret_cast<uintptr_t>(first) % alignof(float) == 0;
+        for (int i = 1; wrappable && i < info.values_size(); ++i) {
+            wrappable = info.values().Get(i).data() == first + i * element.line_sizeof_;
+        }
+        if (wrappable) {
+            element.data_view_ = first;
+            wrapped = true;
+        } else {
+            auto& target = element.blob_;
+            target = ScratchBuffers::Local().TakeBlob();
+            target.reserve(element.line_sizeof_ * element.num_of_queries_);
+            for (auto& line : info.values()) {
+                target.insert(target.end(), line.begin(), line.end());
+            }
         }
         result->emplace_back(std::move(element));
     }
+    if (wrapped) {
+        // the arena owns the proto and thus the wrapped value bytes
+        result->blob_owner_ = std::move(arena);
+    }
     return result;
 }
 
@@ -68,16 +95,21 @@ CreatePlan(const Schema& schema, const std::string& dsl_str) {
 std::unique_ptr<Plan>
 CreateSearchPlanByExpr(const Schema& schema, const void* serialized_expr_plan, const int64_t size) {
     // Note: serialized_expr_plan is of binary format
-    proto::plan::PlanNode plan_node;
-    plan_node.ParseFromArray(serialized_expr_plan, size);
-    return ProtoParser(schema).CreatePlan(plan_node);
+    // ProtoParser copies everything it keeps into its own plan nodes, so
+    // the arena only has to outlive the parse; one reset replaces the
+    // per-submessage frees of a heap-parsed plan
+    google::protobuf::Arena arena;
+    auto* plan_node = google::protobuf::Arena::CreateMessage<proto::plan::PlanNode>(&arena);
+    plan_node->ParseFromArray(serialized_expr_plan, size);
+    return ProtoParser(schema).CreatePlan(*plan_node);
 }
 
 std::unique_ptr<RetrievePlan>
 CreateRetrievePlanByExpr(const Schema& schema, const void* serialized_expr_plan, const int64_t size) {
-    proto::plan::PlanNode plan_node;
-    plan_node.ParseFromArray(serialized_expr_plan, size);
-    return ProtoParser(schema).CreateRetrievePlan(plan_node);
+    google::protobuf::Arena arena;
+    auto* plan_node = google::protobuf::Arena::CreateMessage<proto::plan::PlanNode>(&arena);
+    plan_node->ParseFromArray(serialized_expr_plan, size);
+    return ProtoParser(schema).CreateRetrievePlan(*plan_node);
 }
 
 int64_t
@@ -19,6 +19,7 @@
 
 #include "Plan.h"
 #include "PlanNode.h"
+#include "ScratchBuffers.h"
 #include "exceptions/EasyAssert.h"
 #include "utils/Json.h"
 #include "common/Consts.h"
@@ -65,18 +66,15 @@ struct Placeholder {
     std::string tag_;
     int64_t num_of_queries_;
     int64_t line_sizeof_;
+    // zero-copy mode: points into proto storage kept alive by the owning
+    // PlaceholderGroup; null when the queries were staged into blob_
+    const char* data_view_ = nullptr;
     aligned_vector<char> blob_;
 
     template <typename T>
     const T*
     get_blob() const {
-        return reinterpret_cast<const T*>(blob_.data());
-    }
-
-    template <typename T>
-    T*
-    get_blob() {
-        return reinterpret_cast<T*>(blob_.data());
+        return reinterpret_cast<const T*>(data_view_ != nullptr ? data_view_ : blob_.data());
     }
 };
 
@@ -95,6 +93,16 @@ using PlanPtr = std::unique_ptr<Plan>;
 
 struct PlaceholderGroup : std::vector<Placeholder> {
     using std::vector<Placeholder>::vector;
+
+    ~PlaceholderGroup() {
+        for (auto& element : *this) {
+            ScratchBuffers::Local().Recycle(std::move(element.blob_));
+        }
+    }
+
+    // keeps the decoded proto alive (via its parse arena) while
+    // placeholders wrap its storage
+    std::shared_ptr<const void> blob_owner_;
 };
 
 }  // namespace milvus::query
@@ -19,6 +19,7 @@
 
 #include "Expr.h"
 #include "knowhere/common/Config.h"
+#include "query/SearchConfigCache.h"
 
 namespace milvus::query {
 
@@ -38,8 +39,14 @@ struct SearchInfo {
     int64_t topk_;
     int64_t round_decimal_;
     FieldId field_id_;
+    // resolved once at plan parse; hot search paths read it instead of
+    // looking the field up in the schema per query
+    const FieldMeta* field_meta_ = nullptr;
     knowhere::MetricType metric_type_;
     knowhere::Config search_params_;
+    // per-plan cache of validated search configs; plans are shared across
+    // queries, so each index type pays for CheckSearch only once
+    std::shared_ptr<SearchConfigCache> config_cache_ = std::make_shared<SearchConfigCache>();
 };
 
 struct VectorPlanNode : PlanNode {
@@ -66,6 +73,9 @@ struct RetrievePlanNode : PlanNode {
     accept(PlanNodeVisitor&) override;
 
     ExprPtr predicate_;
+    // cap on collected rows; -1 keeps every match. The offset scan stops
+    // at the cap, so limit-style retrieves never walk the whole segment.
+    int64_t limit_ = -1;
 };
 
 }  // namespace milvus::query
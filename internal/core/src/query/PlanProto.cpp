@@ -144,6 +144,7 @@ ProtoParser::PlanNodeFromProto(const planpb::PlanNode& plan_node_proto) {
     SearchInfo search_info;
     auto field_id = FieldId(anns_proto.field_id());
     search_info.field_id_ = field_id;
+    search_info.field_meta_ = &schema[field_id];
 
     search_info.metric_type_ = query_info_proto.metric_type();
     search_info.topk_ = query_info_proto.topk();
@@ -13,6 +13,8 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "index/ScalarIndexSort.h"
 #include "index/StringIndexSort.h"
 
@@ -29,11 +31,13 @@ generate_scalar_index(Span<T> data) {
     return indexing;
 }
 
-template <>
+// string columns span as views; the sort index wants owning strings, so
+// stage a copy for the build only
 inline scalar::ScalarIndexPtr<std::string>
-generate_scalar_index(Span<std::string> data) {
+generate_scalar_index(Span<std::string_view> data) {
+    std::vector<std::string> rows(data.data(), data.data() + data.row_count());
     auto indexing = scalar::CreateStringIndexSort();
-    indexing->Build(data.row_count(), data.data());
+    indexing->Build(data.row_count(), rows.data());
     return indexing;
 }
 
@@ -56,7 +60,7 @@ generate_scalar_index(SpanBase data, DataType data_type) {
         case DataType::DOUBLE:
             return generate_scalar_index(Span<double>(data));
         case DataType::VARCHAR:
-            return generate_scalar_index(Span<std::string>(data));
+            return generate_scalar_index(Span<std::string_view>(data));
         default:
             PanicInfo("unsupported type");
     }
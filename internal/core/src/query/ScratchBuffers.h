@@ -0,0 +1,124 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "common/Types.h"
+
+namespace milvus::query {
+
+// Thread-local recycling pool for query-lifetime scratch: the nq*topk
+// id/distance staging vectors that search results are built from, and the
+// per-query masking bitsets. Every chunk of every query stages its topk
+// through a pair of these, so at high QPS the short-lived allocations
+// dominate allocator traffic; recycling keeps the same warm buffers cycling
+// on each thread. Returned buffers are cleared but keep their capacity.
+class ScratchBuffers {
+ public:
+    static ScratchBuffers&
+    Local() {
+        thread_local ScratchBuffers scratch;
+        return scratch;
+    }
+
+    std::vector<int64_t>
+    TakeIds() {
+        return Take(ids_);
+    }
+
+    std::vector<float>
+    TakeDistances() {
+        return Take(distances_);
+    }
+
+    void
+    Recycle(std::vector<int64_t>&& ids, std::vector<float>&& distances) {
+        Keep(ids_, std::move(ids));
+        Keep(distances_, std::move(distances));
+    }
+
+    // one masking bitset is live per query on a thread; it is sized to the
+    // segment's active count, so reusing it saves the largest single
+    // allocation on the search path
+    BitsetType
+    TakeBitset() {
+        if (bitsets_.empty()) {
+            return {};
+        }
+        auto bitset = std::move(bitsets_.back());
+        bitsets_.pop_back();
+        bitset.clear();
+        return bitset;
+    }
+
+    void
+    Recycle(BitsetType&& bitset) {
+        if (bitset.capacity() > 0 && bitsets_.size() < kMaxPooled) {
+            bitsets_.emplace_back(std::move(bitset));
+        }
+    }
+
+    // query-vector staging for placeholder groups whose proto storage
+    // cannot be wrapped in place
+    aligned_vector<char>
+    TakeBlob() {
+        if (blobs_.empty()) {
+            return {};
+        }
+        auto blob = std::move(blobs_.back());
+        blobs_.pop_back();
+        blob.clear();
+        return blob;
+    }
+
+    void
+    Recycle(aligned_vector<char>&& blob) {
+        if (blob.capacity() > 0 && blobs_.size() < kMaxPooled) {
+            blobs_.emplace_back(std::move(blob));
+        }
+    }
+
+ private:
+    // enough for the chunk fan-out of one in-flight query per thread
+    static constexpr size_t kMaxPooled = 16;
+
+    template <typename T>
+    static std::vector<T>
+    Take(std::vector<std::vector<T>>& pool) {
+        if (pool.empty()) {
+            return {};
+        }
+        auto buf = std::move(pool.back());
+        pool.pop_back();
+        buf.clear();
+        return buf;
+    }
+
+    template <typename T>
+    static void
+    Keep(std::vector<std::vector<T>>& pool, std::vector<T>&& buf) {
+        if (buf.capacity() > 0 && pool.size() < kMaxPooled) {
+            pool.emplace_back(std::move(buf));
+        }
+    }
+
+    std::vector<std::vector<int64_t>> ids_;
+    std::vector<std::vector<float>> distances_;
+    std::vector<BitsetType> bitsets_;
+    std::vector<aligned_vector<char>> blobs_;
+};
+
+}  // namespace milvus::query
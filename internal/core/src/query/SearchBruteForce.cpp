@@ -9,9 +9,19 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+#include <cstring>
 #include <string>
+#include <utility>
 #include <vector>
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "ScratchBuffers.h"
+#include "common/Float16.h"
+#include "common/SimdDispatch.h"
 #include "SearchBruteForce.h"
 #include "SubSearchResult.h"
 #include "knowhere/archive/BruteForce.h"
@@ -19,35 +29,549 @@
 
 namespace milvus::query {
 
+namespace {
+
+// Hamming needs no staging through the knowhere archive: the metric is one
+// XOR + popcount per code word, so scan the chunk in place. The body is
+// shared between the baseline and an AVX2 clone, picked once per chunk the
+// same way the bitset kernels are.
+#define MILVUS_HAMMING_QUERY_BODY                                                            \
+    /* (distance, offset) max-heap on distance, keeps the best topk */                       \
+    std::vector<std::pair<int32_t, int64_t>> heap;                                           \
+    heap.reserve(topk);                                                                      \
+    for (int64_t row = 0; row < chunk_rows; ++row) {                                         \
+        if (!bitset.empty() && bitset.test(row)) {                                           \
+            continue;                                                                        \
+        }                                                                                    \
+        const uint8_t* code = codes + row * code_size;                                       \
+        int32_t dist = 0;                                                                    \
+        int64_t byte_id = 0;                                                                 \
+        for (; byte_id + 8 <= code_size; byte_id += 8) {                                     \
+            uint64_t x;                                                                      \
+            uint64_t y;                                                                      \
+            std::memcpy(&x, code + byte_id, sizeof(x));                                      \
+            std::memcpy(&y, query + byte_id, sizeof(y));                                     \
+            dist += __builtin_popcountll(x ^ y);                                             \
+        }                                                                                    \
+        for (; byte_id < code_size; ++byte_id) {                                             \
+            dist += __builtin_popcount(static_cast<uint32_t>(code[byte_id] ^ query[byte_id])); \
+        }                                                                                    \
+        if (static_cast<int64_t>(heap.size()) < topk) {                                      \
+            heap.emplace_back(dist, row);                                                    \
+            std::push_heap(heap.begin(), heap.end());                                        \
+        } else if (dist < heap.front().first) {                                              \
+            std::pop_heap(heap.begin(), heap.end());                                         \
+            heap.back() = std::make_pair(dist, row);                                         \
+            std::push_heap(heap.begin(), heap.end());                                        \
+        }                                                                                    \
+    }                                                                                        \
+    std::sort_heap(heap.begin(), heap.end());                                                \
+    for (int64_t i = 0; i < topk; ++i) {                                                     \
+        if (i < static_cast<int64_t>(heap.size())) {                                         \
+            out_ids[i] = heap[i].second;                                                     \
+            out_dists[i] = static_cast<float>(heap[i].first);                                \
+        } else {                                                                             \
+            out_ids[i] = -1;                                                                 \
+            out_dists[i] = std::numeric_limits<float>::max();                                \
+        }                                                                                    \
+    }
+
+void
+HammingSearchQuery(const uint8_t* codes,
+                   int64_t chunk_rows,
+                   int64_t code_size,
+                   const uint8_t* query,
+                   int64_t topk,
+                   const BitsetView& bitset,
+                   int64_t* out_ids,
+                   float* out_dists) {
+    MILVUS_HAMMING_QUERY_BODY
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2,popcnt"))) void
+HammingSearchQueryAvx2(const uint8_t* codes,
+                       int64_t chunk_rows,
+                       int64_t code_size,
+                       const uint8_t* query,
+                       int64_t topk,
+                       const BitsetView& bitset,
+                       int64_t* out_ids,
+                       float* out_dists) {
+    MILVUS_HAMMING_QUERY_BODY
+}
+#endif
+
+#undef MILVUS_HAMMING_QUERY_BODY
+
+SubSearchResult
+HammingBruteForceSearch(const dataset::SearchDataset& dataset,
+                        const void* chunk_data_raw,
+                        int64_t chunk_rows,
+                        const BitsetView& bitset) {
+    auto nq = dataset.num_queries;
+    auto topk = dataset.topk;
+    auto code_size = dataset.dim / 8;
+    auto codes = static_cast<const uint8_t*>(chunk_data_raw);
+    auto queries = static_cast<const uint8_t*>(dataset.query_data);
+
+    auto& scratch = ScratchBuffers::Local();
+    auto seg_offsets = scratch.TakeIds();
+    auto distances = scratch.TakeDistances();
+    seg_offsets.resize(nq * topk);
+    distances.resize(nq * topk);
+
+#if defined(__x86_64__)
+    const bool has_avx2 = UseSimdAvx2();
+#endif
+    for (int64_t q = 0; q < nq; ++q) {
+        auto out_ids = seg_offsets.data() + q * topk;
+        auto out_dists = distances.data() + q * topk;
+#if defined(__x86_64__)
+        if (has_avx2) {
+            HammingSearchQueryAvx2(codes, chunk_rows, code_size, queries + q * code_size, topk, bitset, out_ids,
+                                   out_dists);
+            continue;
+        }
+#endif
+        HammingSearchQuery(codes, chunk_rows, code_size, queries + q * code_size, topk, bitset, out_ids, out_dists);
+    }
+
+    SubSearchResult sub_result(nq, topk, dataset.metric_type, dataset.round_decimal, std::move(seg_offsets),
+                               std::move(distances));
+    return sub_result;
+}
+
+// below this alive fraction (1/20 of the chunk) a query gathers the
+// surviving vectors into a dense block and scans that, instead of
+// streaming the whole chunk through the bitset-rejecting kernel
+constexpr int64_t kGatherSelectivityDenominator = 20;
+
+// rows the filter rejects in [0, chunk_rows); the subview's edge bytes can
+// be shared with the neighbouring chunks' rows, so the bits before the
+// view's bit offset and after its last row are masked out
+int64_t
+CountFilteredRows(const BitsetView& bitset, int64_t chunk_rows) {
+    const uint8_t* data = bitset.data();
+    const int shift = bitset.bit_offset();
+    const int64_t total_bits = shift + chunk_rows;
+    const int64_t total_bytes = (total_bits + 7) / 8;
+    int64_t filtered = 0;
+    for (int64_t i = 0; i < total_bytes; ++i) {
+        uint32_t byte = data[i];
+        if (i == 0) {
+            byte &= 0xFFu << shift;
+        }
+        auto rest = total_bits - i * 8;
+        if (rest < 8) {
+            byte &= (1u << rest) - 1u;
+        }
+        filtered += __builtin_popcount(byte);
+    }
+    return filtered;
+}
+
+// compacts the rows the filter keeps and runs the dense scan on them; the
+// returned offsets are mapped back to chunk rows
+StatusOr<SubSearchResult>
+GatherBruteForceSearch(const dataset::SearchDataset& dataset,
+                       const float* chunk_data,
+                       int64_t chunk_rows,
+                       int64_t alive,
+                       const BitsetView& bitset) {
+    auto nq = dataset.num_queries;
+    auto dim = dataset.dim;
+    auto topk = dataset.topk;
+
+    auto& scratch = ScratchBuffers::Local();
+    auto blob = scratch.TakeBlob();
+    blob.resize(alive * dim * sizeof(float));
+    auto compact = reinterpret_cast<float*>(blob.data());
+    std::vector<int64_t> alive_rows(alive);
+    int64_t cursor = 0;
+    for (int64_t row = 0; row < chunk_rows; ++row) {
+        if (bitset.test(row)) {
+            continue;
+        }
+        std::memcpy(compact + cursor * dim, chunk_data + row * dim, dim * sizeof(float));
+        alive_rows[cursor++] = row;
+    }
+
+    auto base_dataset = knowhere::GenDataset(alive, dim, compact);
+    auto query_dataset = knowhere::GenDataset(nq, dim, dataset.query_data);
+    auto config = knowhere::Config{
+        {knowhere::meta::METRIC_TYPE, dataset.metric_type},
+        {knowhere::meta::DIM, dim},
+        {knowhere::meta::TOPK, topk},
+    };
+    knowhere::DatasetPtr result;
+    try {
+        result = knowhere::BruteForce::Search(base_dataset, query_dataset, config, BitsetView(nullptr));
+    } catch (std::exception& e) {
+        return Status(KNOWHERE_ERROR, e.what());
+    }
+
+    auto seg_offsets = scratch.TakeIds();
+    auto distances = scratch.TakeDistances();
+    seg_offsets.resize(nq * topk);
+    distances.resize(nq * topk);
+    auto result_ids = knowhere::GetDatasetIDs(result);
+    for (int64_t i = 0; i < nq * topk; ++i) {
+        seg_offsets[i] = result_ids[i] >= 0 ? alive_rows[result_ids[i]] : -1;
+    }
+    std::copy_n(knowhere::GetDatasetDistance(result), nq * topk, distances.data());
+    scratch.Recycle(std::move(blob));
+
+    return SubSearchResult(nq, topk, dataset.metric_type, dataset.round_decimal, std::move(seg_offsets),
+                           std::move(distances));
+}
+
+// Interactive queries arrive with tiny nq, where the knowhere staging
+// (dataset wrappers, json config, full nq x chunk result matrix) costs more
+// than the distance work itself. Up to this many queries the chunk is
+// scanned natively: one pass over the rows, each loaded row amortized
+// across all queries.
+constexpr int64_t kMaxSmallNq = 4;
+
+// distances from one row to up to kMaxSmallNq queries; the row element is
+// loaded once and feeds one accumulator per query. kStaticDim > 0 fixes the
+// trip count at compile time for the common dims, 0 falls back to the
+// runtime dim.
+template <bool is_ip, int kStaticDim>
+void
+SmallNqRowDistances(const float* row, const float* queries, int64_t nq, int64_t runtime_dim, float* out) {
+    const int64_t dim = kStaticDim > 0 ? kStaticDim : runtime_dim;
+    float acc[kMaxSmallNq] = {};
+    for (int64_t d = 0; d < dim; ++d) {
+        const float x = row[d];
+        for (int64_t q = 0; q < nq; ++q) {
+            if (is_ip) {
+                acc[q] += x * queries[q * dim + d];
+            } else {
+                const float diff = x - queries[q * dim + d];
+                acc[q] += diff * diff;
+            }
+        }
+    }
+    for (int64_t q = 0; q < nq; ++q) {
+        out[q] = acc[q];
+    }
+}
+
+template <bool is_ip>
+using SmallNqRowDistancesFn = void (*)(const float*, const float*, int64_t, int64_t, float*);
+
+template <bool is_ip>
+SmallNqRowDistancesFn<is_ip>
+SelectSmallNqRowDistances(int64_t dim) {
+    switch (dim) {
+        case 128:
+            return SmallNqRowDistances<is_ip, 128>;
+        case 256:
+            return SmallNqRowDistances<is_ip, 256>;
+        case 768:
+            return SmallNqRowDistances<is_ip, 768>;
+        case 1536:
+            return SmallNqRowDistances<is_ip, 1536>;
+        default:
+            return SmallNqRowDistances<is_ip, 0>;
+    }
+}
+
+template <bool is_ip>
+void
+SmallNqSearchChunk(const float* chunk,
+                   int64_t chunk_rows,
+                   int64_t dim,
+                   const float* queries,
+                   int64_t nq,
+                   int64_t topk,
+                   const BitsetView& bitset,
+                   int64_t* out_ids,
+                   float* out_dists) {
+    auto row_distances = SelectSmallNqRowDistances<is_ip>(dim);
+    // per query a (key, offset) max-heap keeping the best topk; IP negates
+    // so the same heap keeps the largest products
+    std::vector<std::pair<float, int64_t>> heaps[kMaxSmallNq];
+    for (int64_t q = 0; q < nq; ++q) {
+        heaps[q].reserve(topk);
+    }
+    float dists[kMaxSmallNq];
+    for (int64_t row = 0; row < chunk_rows; ++row) {
+        if (!bitset.empty() && bitset.test(row)) {
+            continue;
+        }
+        row_distances(chunk + row * dim, queries, nq, dim, dists);
+        for (int64_t q = 0; q < nq; ++q) {
+            auto& heap = heaps[q];
+            const float key = is_ip ? -dists[q] : dists[q];
+            if (static_cast<int64_t>(heap.size()) < topk) {
+                heap.emplace_back(key, row);
+                std::push_heap(heap.begin(), heap.end());
+            } else if (key < heap.front().first) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = std::make_pair(key, row);
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+    }
+    for (int64_t q = 0; q < nq; ++q) {
+        auto& heap = heaps[q];
+        std::sort_heap(heap.begin(), heap.end());
+        for (int64_t i = 0; i < topk; ++i) {
+            if (i < static_cast<int64_t>(heap.size())) {
+                out_ids[q * topk + i] = heap[i].second;
+                out_dists[q * topk + i] = is_ip ? -heap[i].first : heap[i].first;
+            } else {
+                out_ids[q * topk + i] = -1;
+                out_dists[q * topk + i] =
+                    is_ip ? -std::numeric_limits<float>::max() : std::numeric_limits<float>::max();
+            }
+        }
+    }
+}
+
 SubSearchResult
+SmallNqBruteForceSearch(const dataset::SearchDataset& dataset,
+                        const float* chunk_data,
+                        int64_t chunk_rows,
+                        const BitsetView& bitset) {
+    auto nq = dataset.num_queries;
+    auto topk = dataset.topk;
+    auto dim = dataset.dim;
+    auto queries = static_cast<const float*>(dataset.query_data);
+
+    auto& scratch = ScratchBuffers::Local();
+    auto seg_offsets = scratch.TakeIds();
+    auto distances = scratch.TakeDistances();
+    seg_offsets.resize(nq * topk);
+    distances.resize(nq * topk);
+
+    if (dataset.metric_type == knowhere::metric::IP) {
+        SmallNqSearchChunk<true>(chunk_data, chunk_rows, dim, queries, nq, topk, bitset, seg_offsets.data(),
+                                 distances.data());
+    } else {
+        SmallNqSearchChunk<false>(chunk_data, chunk_rows, dim, queries, nq, topk, bitset, seg_offsets.data(),
+                                  distances.data());
+    }
+
+    return SubSearchResult(nq, topk, dataset.metric_type, dataset.round_decimal, std::move(seg_offsets),
+                           std::move(distances));
+}
+
+// fp16-storage scans share one pass shape: per query, a (key, offset)
+// max-heap keeping the best topk. L2 keeps the smallest distances; IP
+// negates the product so the same heap keeps the largest.
+#define MILVUS_FP16_QUERY_BODY(DISTANCE_STMT)                                                          \
+    std::vector<std::pair<float, int64_t>> heap;                                                       \
+    heap.reserve(topk);                                                                                \
+    for (int64_t row = 0; row < chunk_rows; ++row) {                                                   \
+        if (!bitset.empty() && bitset.test(row)) {                                                     \
+            continue;                                                                                  \
+        }                                                                                              \
+        const uint16_t* vec = codes + row * dim;                                                       \
+        float dist = 0;                                                                                \
+        DISTANCE_STMT;                                                                                 \
+        float key = is_ip ? -dist : dist;                                                              \
+        if (static_cast<int64_t>(heap.size()) < topk) {                                                \
+            heap.emplace_back(key, row);                                                               \
+            std::push_heap(heap.begin(), heap.end());                                                  \
+        } else if (key < heap.front().first) {                                                         \
+            std::pop_heap(heap.begin(), heap.end());                                                   \
+            heap.back() = std::make_pair(key, row);                                                    \
+            std::push_heap(heap.begin(), heap.end());                                                  \
+        }                                                                                              \
+    }                                                                                                  \
+    std::sort_heap(heap.begin(), heap.end());                                                          \
+    for (int64_t i = 0; i < topk; ++i) {                                                               \
+        if (i < static_cast<int64_t>(heap.size())) {                                                   \
+            out_ids[i] = heap[i].second;                                                               \
+            out_dists[i] = is_ip ? -heap[i].first : heap[i].first;                                     \
+        } else {                                                                                       \
+            out_ids[i] = -1;                                                                           \
+            out_dists[i] =                                                                             \
+                is_ip ? -std::numeric_limits<float>::max() : std::numeric_limits<float>::max();        \
+        }                                                                                              \
+    }
+
+#define MILVUS_FP16_DIST_SCALAR                               \
+    if (is_ip) {                                              \
+        for (int64_t d = 0; d < dim; ++d) {                   \
+            dist += Float16ToFloat32(vec[d]) * query[d];      \
+        }                                                     \
+    } else {                                                  \
+        for (int64_t d = 0; d < dim; ++d) {                   \
+            float diff = Float16ToFloat32(vec[d]) - query[d]; \
+            dist += diff * diff;                              \
+        }                                                     \
+    }
+
+void
+Fp16SearchQuery(const uint16_t* codes,
+                int64_t chunk_rows,
+                int64_t dim,
+                const float* query,
+                int64_t topk,
+                bool is_ip,
+                const BitsetView& bitset,
+                int64_t* out_ids,
+                float* out_dists) {
+    MILVUS_FP16_QUERY_BODY(MILVUS_FP16_DIST_SCALAR)
+}
+
+#if defined(__x86_64__)
+
+// one row's distance with hardware half->float loads; rows convert in
+// registers, so the memory traffic is the half data alone
+__attribute__((target("avx2,f16c,fma"))) inline float
+Fp16RowDistanceAvx2(const uint16_t* vec, const float* query, int64_t dim, bool is_ip) {
+    auto acc = _mm256_setzero_ps();
+    int64_t d = 0;
+    if (is_ip) {
+        for (; d + 8 <= dim; d += 8) {
+            auto x = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(vec + d)));
+            acc = _mm256_fmadd_ps(x, _mm256_loadu_ps(query + d), acc);
+        }
+    } else {
+        for (; d + 8 <= dim; d += 8) {
+            auto x = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(vec + d)));
+            auto diff = _mm256_sub_ps(x, _mm256_loadu_ps(query + d));
+            acc = _mm256_fmadd_ps(diff, diff, acc);
+        }
+    }
+    auto lo = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    lo = _mm_hadd_ps(lo, lo);
+    lo = _mm_hadd_ps(lo, lo);
+    float dist = _mm_cvtss_f32(lo);
+    for (; d < dim; ++d) {
+        float x = Float16ToFloat32(vec[d]);
+        dist += is_ip ? x * query[d] : (x - query[d]) * (x - query[d]);
+    }
+    return dist;
+}
+
+__attribute__((target("avx2,f16c,fma"))) void
+Fp16SearchQueryAvx2(const uint16_t* codes,
+                    int64_t chunk_rows,
+                    int64_t dim,
+                    const float* query,
+                    int64_t topk,
+                    bool is_ip,
+                    const BitsetView& bitset,
+                    int64_t* out_ids,
+                    float* out_dists) {
+    MILVUS_FP16_QUERY_BODY(dist = Fp16RowDistanceAvx2(vec, query, dim, is_ip))
+}
+
+#endif
+
+#undef MILVUS_FP16_DIST_SCALAR
+#undef MILVUS_FP16_QUERY_BODY
+
+}  // namespace
+
+StatusOr<SubSearchResult>
 BruteForceSearch(const dataset::SearchDataset& dataset,
                  const void* chunk_data_raw,
                  int64_t chunk_rows,
                  const BitsetView& bitset) {
-    SubSearchResult sub_result(dataset.num_queries, dataset.topk, dataset.metric_type, dataset.round_decimal);
+    if (dataset.metric_type == knowhere::metric::HAMMING) {
+        return HammingBruteForceSearch(dataset, chunk_data_raw, chunk_rows, bitset);
+    }
+    auto nq = dataset.num_queries;
+    auto dim = dataset.dim;
+    auto topk = dataset.topk;
+
+    if (nq <= kMaxSmallNq &&
+        (dataset.metric_type == knowhere::metric::L2 || dataset.metric_type == knowhere::metric::IP)) {
+        return SmallNqBruteForceSearch(dataset, static_cast<const float*>(chunk_data_raw), chunk_rows, bitset);
+    }
+
+    if (!bitset.empty()) {
+        auto alive = chunk_rows - CountFilteredRows(bitset, chunk_rows);
+        if (alive == 0) {
+            // nothing to scan; the default-constructed result is all
+            // invalid slots, which merge_all treats as empty
+            return SubSearchResult(nq, topk, dataset.metric_type, dataset.round_decimal);
+        }
+        if (alive * kGatherSelectivityDenominator <= chunk_rows) {
+            return GatherBruteForceSearch(dataset, static_cast<const float*>(chunk_data_raw), chunk_rows, alive,
+                                          bitset);
+        }
+    }
+
+    auto base_dataset = knowhere::GenDataset(chunk_rows, dim, chunk_data_raw);
+    auto query_dataset = knowhere::GenDataset(nq, dim, dataset.query_data);
+    auto config = knowhere::Config{
+        {knowhere::meta::METRIC_TYPE, dataset.metric_type},
+        {knowhere::meta::DIM, dim},
+        {knowhere::meta::TOPK, topk},
+    };
+    // knowhere reports an unsupported metric or a bad config by throwing;
+    // fold that into the status channel here so nothing above this frame
+    // sees an exception on the scan path
+    knowhere::DatasetPtr result;
     try {
-        auto nq = dataset.num_queries;
-        auto dim = dataset.dim;
-        auto topk = dataset.topk;
-
-        auto base_dataset = knowhere::GenDataset(chunk_rows, dim, chunk_data_raw);
-        auto query_dataset = knowhere::GenDataset(nq, dim, dataset.query_data);
-        auto config = knowhere::Config{
-            {knowhere::meta::METRIC_TYPE, dataset.metric_type},
-            {knowhere::meta::DIM, dim},
-            {knowhere::meta::TOPK, topk},
-        };
-        auto result = knowhere::BruteForce::Search(base_dataset, query_dataset, config, bitset);
-
-        sub_result.mutable_seg_offsets().resize(nq * topk);
-        sub_result.mutable_distances().resize(nq * topk);
-
-        std::copy_n(knowhere::GetDatasetIDs(result), nq * topk, sub_result.get_seg_offsets());
-        std::copy_n(knowhere::GetDatasetDistance(result), nq * topk, sub_result.get_distances());
+        // knowhere addresses the bitmap from bit 0; bit-granular subviews
+        // re-base through the shifted-word staging, aligned ones pass as-is
+        result = knowhere::BruteForce::Search(base_dataset, query_dataset, config, bitset.as_byte_aligned());
     } catch (std::exception& e) {
-        PanicInfo(e.what());
+        return Status(KNOWHERE_ERROR, e.what());
     }
-    sub_result.round_values();
+
+    // stage through recycled buffers and hand them to the result by move
+    auto& scratch = ScratchBuffers::Local();
+    auto seg_offsets = scratch.TakeIds();
+    auto distances = scratch.TakeDistances();
+    seg_offsets.resize(nq * topk);
+    distances.resize(nq * topk);
+    std::copy_n(knowhere::GetDatasetIDs(result), nq * topk, seg_offsets.data());
+    std::copy_n(knowhere::GetDatasetDistance(result), nq * topk, distances.data());
+
+    SubSearchResult sub_result(nq, topk, dataset.metric_type, dataset.round_decimal, std::move(seg_offsets),
+                               std::move(distances));
+    return sub_result;
+}
+
+StatusOr<SubSearchResult>
+BruteForceSearchFp16(const dataset::SearchDataset& dataset,
+                     const void* chunk_data_raw,
+                     int64_t chunk_rows,
+                     const BitsetView& bitset) {
+    auto nq = dataset.num_queries;
+    auto topk = dataset.topk;
+    auto dim = dataset.dim;
+    bool is_ip = (dataset.metric_type == knowhere::metric::IP);
+    if (!is_ip && dataset.metric_type != knowhere::metric::L2) {
+        return Status(SERVER_INVALID_ARGUMENT, "fp16 storage scan supports only L2 and IP");
+    }
+    auto codes = static_cast<const uint16_t*>(chunk_data_raw);
+    auto queries = static_cast<const float*>(dataset.query_data);
+
+    auto& scratch = ScratchBuffers::Local();
+    auto seg_offsets = scratch.TakeIds();
+    auto distances = scratch.TakeDistances();
+    seg_offsets.resize(nq * topk);
+    distances.resize(nq * topk);
+
+#if defined(__x86_64__)
+    static const bool has_f16c_fma = __builtin_cpu_supports("f16c") && __builtin_cpu_supports("fma");
+    const bool use_avx2 = has_f16c_fma && UseSimdAvx2();
+#endif
+    for (int64_t q = 0; q < nq; ++q) {
+        auto out_ids = seg_offsets.data() + q * topk;
+        auto out_dists = distances.data() + q * topk;
+#if defined(__x86_64__)
+        if (use_avx2) {
+            Fp16SearchQueryAvx2(codes, chunk_rows, dim, queries + q * dim, topk, is_ip, bitset, out_ids, out_dists);
+            continue;
+        }
+#endif
+        Fp16SearchQuery(codes, chunk_rows, dim, queries + q * dim, topk, is_ip, bitset, out_ids, out_dists);
+    }
+
+    SubSearchResult sub_result(nq, topk, dataset.metric_type, dataset.round_decimal, std::move(seg_offsets),
+                               std::move(distances));
     return sub_result;
 }
 
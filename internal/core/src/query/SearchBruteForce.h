@@ -14,13 +14,25 @@
 #include "common/BitsetView.h"
 #include "query/SubSearchResult.h"
 #include "query/helper.h"
+#include "utils/Status.h"
 
 namespace milvus::query {
 
-SubSearchResult
+// Errors (an unsupported metric, a knowhere rejection) come back through
+// the status channel instead of unwinding: the chunk loops above run
+// exception-free and decide per chunk what a failure aborts.
+StatusOr<SubSearchResult>
 BruteForceSearch(const dataset::SearchDataset& dataset,
                  const void* chunk_data_raw,
                  int64_t chunk_rows,
                  const BitsetView& bitset);
 
+// scans a chunk stored as IEEE half bits (fp16 storage mode); the query
+// stays float32 and rows convert in registers. L2 and IP only.
+StatusOr<SubSearchResult>
+BruteForceSearchFp16(const dataset::SearchDataset& dataset,
+                     const void* chunk_data_raw,
+                     int64_t chunk_rows,
+                     const BitsetView& bitset);
+
 }  // namespace milvus::query
@@ -0,0 +1,48 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "query/SearchConfigCache.h"
+
+#include "exceptions/EasyAssert.h"
+#include "knowhere/index/vector_index/ConfAdapterMgr.h"
+#include "knowhere/index/vector_index/helpers/IndexParameter.h"
+
+namespace milvus::query {
+
+std::shared_ptr<const knowhere::Config>
+SearchConfigCache::Get(const knowhere::Config& search_params,
+                       int64_t topk,
+                       const knowhere::MetricType& metric_type,
+                       const knowhere::IndexType& index_type,
+                       knowhere::IndexMode index_mode) {
+    auto key = std::make_pair(index_type, static_cast<int>(index_mode));
+    std::lock_guard lck(mutex_);
+    auto iter = cache_.find(key);
+    if (iter != cache_.end()) {
+        return iter->second;
+    }
+
+    auto conf = std::make_shared<knowhere::Config>(search_params);
+    knowhere::SetMetaTopk(*conf, topk);
+    knowhere::SetMetaMetricType(*conf, metric_type);
+    auto adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(index_type);
+    try {
+        // CheckSearch also fills index-type defaults, so the cached config
+        // is the fully-resolved one that Query receives
+        adapter->CheckSearch(*conf, index_type, index_mode);
+    } catch (std::exception& e) {
+        AssertInfo(false, e.what());
+    }
+    cache_.emplace(key, conf);
+    return conf;
+}
+
+}  // namespace milvus::query
@@ -0,0 +1,44 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "knowhere/common/Config.h"
+#include "knowhere/index/VecIndex.h"
+
+namespace milvus::query {
+
+// Memoizes the validated knowhere search config per index type/mode. The
+// config only depends on the plan's search params and the index it runs
+// against, yet the json copy, adapter lookup and CheckSearch used to run on
+// every query; plans are cached and shared across queries, so validating
+// once per index type is enough.
+class SearchConfigCache {
+ public:
+    // returns the validated config for this index, building it on first use
+    std::shared_ptr<const knowhere::Config>
+    Get(const knowhere::Config& search_params,
+        int64_t topk,
+        const knowhere::MetricType& metric_type,
+        const knowhere::IndexType& index_type,
+        knowhere::IndexMode index_mode);
+
+ private:
+    std::mutex mutex_;
+    std::map<std::pair<knowhere::IndexType, int>, std::shared_ptr<const knowhere::Config>> cache_;
+};
+
+}  // namespace milvus::query
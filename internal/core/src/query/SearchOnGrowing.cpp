@@ -9,13 +9,101 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <future>
+#include <optional>
+#include <vector>
+
 #include "common/BitsetView.h"
+#include "common/Metrics.h"
+#include "common/ThreadPool.h"
 #include "SearchOnGrowing.h"
 #include "query/SearchBruteForce.h"
 #include "query/SearchOnIndex.h"
 
 namespace milvus::query {
 
+namespace {
+
+// number of leading whole chunks the small index can serve below the insert
+// barrier; reads the finished ack exactly once, so callers decide the
+// index/brute-force split up front and it stays fixed for the whole query
+int32_t
+indexed_chunk_count(const segcore::SegmentGrowingImpl& segment, FieldId vecfield_id, int64_t ins_barrier) {
+    auto& indexing_record = segment.get_indexing_record();
+    if (!indexing_record.is_in(vecfield_id)) {
+        return 0;
+    }
+    auto max_indexed_id = indexing_record.get_finished_ack();
+    auto size_per_chunk = indexing_record.get_vec_field_indexing(vecfield_id).get_size_per_chunk();
+    return static_cast<int32_t>(std::min(max_indexed_id, ins_barrier / size_per_chunk));
+}
+
+// searches the first num_chunks chunks against their per-chunk index
+void
+search_indexed_chunks(const segcore::SegmentGrowingImpl& segment,
+                      const query::SearchInfo& info,
+                      const dataset::SearchDataset& search_dataset,
+                      int32_t num_chunks,
+                      const BitsetView& bitset,
+                      SubSearchResult& results) {
+    auto vecfield_id = info.field_id_;
+    auto& field_indexing = segment.get_indexing_record().get_vec_field_indexing(vecfield_id);
+    auto search_conf = field_indexing.get_search_params(info.topk_);
+    auto vec_ptr = segment.get_insert_record().get_field_data_base(vecfield_id);
+    AssertInfo(vec_ptr->get_size_per_chunk() == field_indexing.get_size_per_chunk(),
+               "[VectorSearch]Chunk size of vector not equal to chunk size of field index");
+
+    auto size_per_chunk = field_indexing.get_size_per_chunk();
+    // works both inline and on a pool worker: the worker re-installs the
+    // submitting query's task options, token included
+    auto cancellation = ScopedTaskOptions::Current().cancellation;
+    // compacted runs fold several cold chunks into one index, so a run is
+    // one search and one merge instead of a fan-in of them
+    auto runs = field_indexing.get_compacted_runs();
+    size_t run_idx = 0;
+    int64_t chunk_id = 0;
+    while (chunk_id < num_chunks) {
+        cancellation.ThrowIfCancelled();
+        if (run_idx < runs.size() && runs[run_idx]->chunk_end <= chunk_id) {
+            ++run_idx;
+            continue;
+        }
+        if (run_idx < runs.size() && runs[run_idx]->chunk_beg == chunk_id && runs[run_idx]->chunk_end <= num_chunks) {
+            auto& run = runs[run_idx];
+            auto run_rows = (run->chunk_end - run->chunk_beg) * size_per_chunk;
+            auto sub_view = bitset.subview(chunk_id * size_per_chunk, run_rows);
+            auto sub_qr = SearchOnIndex(search_dataset, *run->index, search_conf, sub_view);
+
+            // convert run uid to segment uid
+            for (auto& x : sub_qr.mutable_seg_offsets()) {
+                if (x != -1) {
+                    x += chunk_id * size_per_chunk;
+                }
+            }
+
+            results.merge(sub_qr);
+            chunk_id = run->chunk_end;
+            ++run_idx;
+            continue;
+        }
+        auto indexing = field_indexing.get_chunk_indexing(chunk_id);
+        auto sub_view = bitset.subview(chunk_id * size_per_chunk, size_per_chunk);
+        auto sub_qr = SearchOnIndex(search_dataset, *indexing, search_conf, sub_view);
+
+        // convert chunk uid to segment uid
+        for (auto& x : sub_qr.mutable_seg_offsets()) {
+            if (x != -1) {
+                x += chunk_id * size_per_chunk;
+            }
+        }
+
+        results.merge(sub_qr);
+        ++chunk_id;
+    }
+}
+
+}  // namespace
+
 // TODO: small index is disabled, however 3 unittests still call this API, consider to remove this API
 //   - Query::ExecWithPredicateLoader
 //   - Query::ExecWithPredicate
@@ -29,50 +117,22 @@ FloatIndexSearch(const segcore::SegmentGrowingImpl& segment,
                  const BitsetView& bitset,
                  SubSearchResult& results) {
     auto& schema = segment.get_schema();
-    auto& indexing_record = segment.get_indexing_record();
-    auto& record = segment.get_insert_record();
-
     auto vecfield_id = info.field_id_;
-    auto& field = schema[vecfield_id];
+    auto& field = info.field_meta_ != nullptr ? *info.field_meta_ : schema[vecfield_id];
 
     AssertInfo(field.get_data_type() == DataType::VECTOR_FLOAT, "[FloatSearch]Field data type isn't VECTOR_FLOAT");
     dataset::SearchDataset search_dataset{info.metric_type_,   num_queries,     info.topk_,
                                           info.round_decimal_, field.get_dim(), query_data};
-    auto vec_ptr = record.get_field_data<FloatVector>(vecfield_id);
-
-    int current_chunk_id = 0;
-    if (indexing_record.is_in(vecfield_id)) {
-        auto max_indexed_id = indexing_record.get_finished_ack();
-        const auto& field_indexing = indexing_record.get_vec_field_indexing(vecfield_id);
-        auto search_conf = field_indexing.get_search_params(info.topk_);
-        AssertInfo(vec_ptr->get_size_per_chunk() == field_indexing.get_size_per_chunk(),
-                   "[FloatSearch]Chunk size of vector not equal to chunk size of field index");
-
-        auto size_per_chunk = field_indexing.get_size_per_chunk();
-        for (int chunk_id = current_chunk_id; chunk_id < max_indexed_id; ++chunk_id) {
-            if ((chunk_id + 1) * size_per_chunk > ins_barrier) {
-                break;
-            }
-
-            auto indexing = field_indexing.get_chunk_indexing(chunk_id);
-            auto sub_view = bitset.subview(chunk_id * size_per_chunk, size_per_chunk);
-            auto sub_qr = SearchOnIndex(search_dataset, *indexing, search_conf, sub_view);
 
-            // convert chunk uid to segment uid
-            for (auto& x : sub_qr.mutable_seg_offsets()) {
-                if (x != -1) {
-                    x += chunk_id * size_per_chunk;
-                }
-            }
-
-            results.merge(sub_qr);
-            current_chunk_id++;
-        }
+    auto num_chunks = indexed_chunk_count(segment, vecfield_id, ins_barrier);
+    if (num_chunks > 0) {
+        search_indexed_chunks(segment, info, search_dataset, num_chunks, bitset, results);
+        results.round_values();
     }
-    return current_chunk_id;
+    return num_chunks;
 }
 
-void
+Status
 SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
                 const query::SearchInfo& info,
                 const void* query_data,
@@ -88,7 +148,7 @@ SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
     // step 1.1: get meta
     // step 1.2: get which vector field to search
     auto vecfield_id = info.field_id_;
-    auto& field = schema[vecfield_id];
+    auto& field = info.field_meta_ != nullptr ? *info.field_meta_ : schema[vecfield_id];
     auto data_type = field.get_data_type();
     AssertInfo(datatype_is_vector(data_type), "[SearchOnGrowing]Data type isn't vector type");
 
@@ -97,42 +157,163 @@ SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
     auto metric_type = info.metric_type_;
     auto round_decimal = info.round_decimal_;
 
-    // step 2: small indexing search
     SubSearchResult final_qr(num_queries, topk, metric_type, round_decimal);
     dataset::SearchDataset search_dataset{metric_type, num_queries, topk, round_decimal, dim, query_data};
 
-    int32_t current_chunk_id = 0;
-    if (field.get_data_type() == DataType::VECTOR_FLOAT) {
-        current_chunk_id = FloatIndexSearch(segment, info, query_data, num_queries, active_count, bitset, final_qr);
-    }
-
-    // step 3: brute force search where small indexing is unavailable
+    // step 2: decide the index/brute-force split once, up front; float and
+    // binary fields both carry per-chunk small indexes when registered
+    int32_t indexed_chunks = indexed_chunk_count(segment, vecfield_id, active_count);
     auto vec_ptr = record.get_field_data_base(vecfield_id);
+    // the column may hold half-precision bits (fp16 storage mode); those
+    // chunks go through the fp16-aware scan kernel
+    const bool fp16_storage = dynamic_cast<const segcore::ConcurrentVector<Float16Vector>*>(vec_ptr) != nullptr;
     auto vec_size_per_chunk = vec_ptr->get_size_per_chunk();
     auto max_chunk = upper_div(active_count, vec_size_per_chunk);
+    auto num_tail_chunks = std::max<int64_t>(max_chunk - indexed_chunks, 0);
 
-    for (int chunk_id = current_chunk_id; chunk_id < max_chunk; ++chunk_id) {
-        auto chunk_data = vec_ptr->get_chunk_data(chunk_id);
+    // index hit ratio over time = indexed / (indexed + brute-forced)
+    static auto& indexed_count = MetricsRegistry::GetInstance().GetCounter("segcore.growing.chunks_indexed");
+    static auto& brute_count = MetricsRegistry::GetInstance().GetCounter("segcore.growing.chunks_brute_forced");
+    indexed_count.Increment(indexed_chunks);
+    brute_count.Increment(num_tail_chunks);
 
-        auto element_begin = chunk_id * vec_size_per_chunk;
-        auto element_end = std::min(active_count, (chunk_id + 1) * vec_size_per_chunk);
-        auto size_per_chunk = element_end - element_begin;
+    std::vector<SubSearchResult> chunk_results;
+    chunk_results.reserve(num_tail_chunks + 1);
 
-        auto sub_view = bitset.subview(element_begin, size_per_chunk);
-        auto sub_qr = BruteForceSearch(search_dataset, chunk_data, size_per_chunk, sub_view);
+    // step 3: index chunks. In the steady state the segment is fully
+    // indexed and this is the only search work; with a raw tail pending, the
+    // index portion overlaps with it on the search pool.
+    std::optional<std::future<SubSearchResult>> index_future;
+    if (indexed_chunks > 0) {
+        if (num_tail_chunks > 0) {
+            auto& pool = ThreadPool::GetInstance(ThreadPoolRole::Search);
+            index_future = pool.Submit([&] {
+                SubSearchResult index_qr(num_queries, topk, metric_type, round_decimal);
+                search_indexed_chunks(segment, info, search_dataset, indexed_chunks, bitset, index_qr);
+                return index_qr;
+            });
+        } else {
+            search_indexed_chunks(segment, info, search_dataset, indexed_chunks, bitset, final_qr);
+        }
+    }
 
-        // convert chunk uid to segment uid
-        for (auto& x : sub_qr.mutable_seg_offsets()) {
-            if (x != -1) {
-                x += chunk_id * vec_size_per_chunk;
+    // step 4: brute force the raw tail where no index exists yet
+    if (num_tail_chunks > 0) {
+        auto cancellation = ScopedTaskOptions::Current().cancellation;
+        auto search_chunk = [&](int chunk_id) -> StatusOr<SubSearchResult> {
+            cancellation.ThrowIfCancelled();
+            auto chunk_data = vec_ptr->get_chunk_data(chunk_id);
+
+            auto element_begin = chunk_id * vec_size_per_chunk;
+            auto element_end = std::min(active_count, (chunk_id + 1) * vec_size_per_chunk);
+            auto size_per_chunk = element_end - element_begin;
+
+            // a partially visible chunk is still being appended to; scan a
+            // stable copy so the brute-force kernel does not contend with
+            // the writers for the chunk's cache lines
+            std::shared_ptr<const segcore::SegmentGrowingImpl::TailChunkSnapshot> snapshot;
+            if (size_per_chunk < vec_size_per_chunk) {
+                snapshot = segment.get_tail_chunk_snapshot(vecfield_id, chunk_id, size_per_chunk);
+                chunk_data = snapshot->data.data();
+            }
+
+            auto sub_view = bitset.subview(element_begin, size_per_chunk);
+            auto sub_qr = fp16_storage ? BruteForceSearchFp16(search_dataset, chunk_data, size_per_chunk, sub_view)
+                                       : BruteForceSearch(search_dataset, chunk_data, size_per_chunk, sub_view);
+            if (!sub_qr.ok()) {
+                return sub_qr.status();
+            }
+
+            // convert chunk uid to segment uid
+            for (auto& x : sub_qr.value().mutable_seg_offsets()) {
+                if (x != -1) {
+                    x += chunk_id * vec_size_per_chunk;
+                }
+            }
+            return std::move(sub_qr.value());
+        };
+
+        // chunks are independent given the per-chunk bitset subviews, so fan
+        // the brute-force searches out over the shared pool, bounded by the
+        // segcore concurrency setting, and stitch everything with one k-way
+        // merge
+        auto concurrency = std::min(segment.get_segcore_config().get_search_concurrency(), num_tail_chunks);
+        // a fired token makes search_chunk throw, which may unwind this
+        // frame while the overlapped index task still references it; hold
+        // the unwind until that task has drained. Scan failures take the
+        // status channel instead and drain below the same way.
+        Status chunk_status = Status::OK();
+        try {
+            if (concurrency > 1) {
+                auto& pool = ThreadPool::GetInstance(ThreadPoolRole::Search);
+                std::vector<std::future<StatusOr<std::vector<SubSearchResult>>>> stripes;
+                stripes.reserve(concurrency);
+                for (int64_t stripe = 0; stripe < concurrency; ++stripe) {
+                    stripes.emplace_back(pool.Submit([&, stripe]() -> StatusOr<std::vector<SubSearchResult>> {
+                        std::vector<SubSearchResult> stripe_results;
+                        for (int chunk_id = indexed_chunks + stripe; chunk_id < max_chunk; chunk_id += concurrency) {
+                            auto sub_qr = search_chunk(chunk_id);
+                            if (!sub_qr.ok()) {
+                                return sub_qr.status();
+                            }
+                            stripe_results.emplace_back(std::move(sub_qr.value()));
+                        }
+                        return stripe_results;
+                    }));
+                }
+                // wait for every stripe before get() may rethrow, so no
+                // task outlives the captured state
+                for (auto& stripe : stripes) {
+                    stripe.wait();
+                }
+                for (auto& stripe : stripes) {
+                    auto stripe_qr = stripe.get();
+                    if (!stripe_qr.ok()) {
+                        if (chunk_status.ok()) {
+                            chunk_status = stripe_qr.status();
+                        }
+                        continue;
+                    }
+                    for (auto& sub_qr : stripe_qr.value()) {
+                        chunk_results.emplace_back(std::move(sub_qr));
+                    }
+                }
+            } else {
+                for (int chunk_id = indexed_chunks; chunk_id < max_chunk; ++chunk_id) {
+                    auto sub_qr = search_chunk(chunk_id);
+                    if (!sub_qr.ok()) {
+                        chunk_status = sub_qr.status();
+                        break;
+                    }
+                    chunk_results.emplace_back(std::move(sub_qr.value()));
+                }
             }
+        } catch (...) {
+            if (index_future.has_value()) {
+                index_future->wait();
+            }
+            throw;
+        }
+        if (!chunk_status.ok()) {
+            if (index_future.has_value()) {
+                index_future->wait();
+            }
+            return chunk_status;
         }
-        final_qr.merge(sub_qr);
     }
+    if (index_future.has_value()) {
+        chunk_results.emplace_back(index_future->get());
+    }
+    final_qr.merge_all(chunk_results);
+    // one rounding pass over the merged nq*topk result instead of one per chunk
+    final_qr.round_values();
+    results.profile_.chunks_on_index_ = indexed_chunks;
+    results.profile_.chunks_brute_forced_ = num_tail_chunks;
     results.distances_ = std::move(final_qr.mutable_distances());
     results.seg_offsets_ = std::move(final_qr.mutable_seg_offsets());
     results.unity_topK_ = topk;
     results.total_nq_ = num_queries;
+    return Status::OK();
 }
 
 }  // namespace milvus::query
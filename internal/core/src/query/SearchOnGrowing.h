@@ -13,10 +13,13 @@
 
 #include "common/BitsetView.h"
 #include "segcore/SegmentGrowingImpl.h"
+#include "utils/Status.h"
 
 namespace milvus::query {
 
-void
+// a failed chunk scan surfaces through the returned Status; exceptions on
+// this path are reserved for cancellation, which unwinds as before
+Status
 SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
                 const query::SearchInfo& info,
                 const void* query_data,
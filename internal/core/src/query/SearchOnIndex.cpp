@@ -13,6 +13,25 @@
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 
 namespace milvus::query {
+
+namespace {
+
+// a growing segment's chunk loop calls SearchOnIndex once per chunk with
+// the same queries, so building a fresh shared_ptr-wrapped dataset each
+// time is pure allocator churn; reuse one wrapper per thread and only
+// refresh its fields. Query() reads the dataset within the call, so
+// sequential reuse on the same thread is safe.
+knowhere::DatasetPtr
+ReusableQueryDataset(int64_t rows, int64_t dim, const void* tensor) {
+    thread_local knowhere::DatasetPtr dataset = std::make_shared<knowhere::Dataset>();
+    dataset->Set<int64_t>(knowhere::meta::ROWS, rows);
+    dataset->Set<int64_t>(knowhere::meta::DIM, dim);
+    dataset->Set<const void*>(knowhere::meta::TENSOR, tensor);
+    return dataset;
+}
+
+}  // namespace
+
 SubSearchResult
 SearchOnIndex(const dataset::SearchDataset& search_dataset,
               const knowhere::VecIndex& indexing,
@@ -23,12 +42,15 @@ SearchOnIndex(const dataset::SearchDataset& search_dataset,
     auto dim = search_dataset.dim;
     auto metric_type = search_dataset.metric_type;
     auto round_decimal = search_dataset.round_decimal;
-    auto dataset = knowhere::GenDataset(num_queries, dim, search_dataset.query_data);
+    auto dataset = ReusableQueryDataset(num_queries, dim, search_dataset.query_data);
 
     // NOTE: VecIndex Query API forget to add const qualifier
     // NOTE: use const_cast as a workaround
     auto& indexing_nonconst = const_cast<knowhere::VecIndex&>(indexing);
-    auto ans = indexing_nonconst.Query(dataset, search_conf, bitset);
+    // knowhere addresses the bitmap from bit 0; a bit-granular chunk
+    // subview re-bases through the shifted-word staging, aligned ones
+    // pass through untouched
+    auto ans = indexing_nonconst.Query(dataset, search_conf, bitset.as_byte_aligned());
 
     auto dis = knowhere::GetDatasetDistance(ans);
     auto uids = knowhere::GetDatasetIDs(ans);
@@ -36,7 +58,6 @@ SearchOnIndex(const dataset::SearchDataset& search_dataset,
     SubSearchResult sub_qr(num_queries, topK, metric_type, round_decimal);
     std::copy_n(dis, num_queries * topK, sub_qr.get_distances());
     std::copy_n(uids, num_queries * topK, sub_qr.get_seg_offsets());
-    sub_qr.round_values();
     return sub_qr;
 }
 
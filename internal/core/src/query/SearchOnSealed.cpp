@@ -22,7 +22,7 @@
 
 namespace milvus::query {
 
-void
+Status
 SearchOnSealedIndex(const Schema& schema,
                     const segcore::SealedIndexingRecord& record,
                     const SearchInfo& search_info,
@@ -34,51 +34,48 @@ SearchOnSealedIndex(const Schema& schema,
     auto round_decimal = search_info.round_decimal_;
 
     auto field_id = search_info.field_id_;
-    auto& field = schema[field_id];
+    auto& field = search_info.field_meta_ != nullptr ? *search_info.field_meta_ : schema[field_id];
     // Assert(field.get_data_type() == DataType::VECTOR_FLOAT);
     auto dim = field.get_dim();
 
-    AssertInfo(record.is_ready(field_id), "[SearchOnSealed]Record isn't ready");
+    // get_field_indexing asserts readiness itself; one array read resolves it
     auto field_indexing = record.get_field_indexing(field_id);
-    AssertInfo(field_indexing->metric_type_ == search_info.metric_type_,
-               "Metric type of field index isn't the same with search info");
+    if (field_indexing->metric_type_ != search_info.metric_type_) {
+        return Status(SERVER_INVALID_ARGUMENT, "Metric type of field index isn't the same with search info");
+    }
 
-    auto final = [&] {
+    // the loaded index rejects a bad search config by throwing; translate
+    // it here so the query layer above stays on the status channel
+    knowhere::DatasetPtr final;
+    try {
         auto ds = knowhere::GenDataset(num_queries, dim, query_data);
 
-        auto conf = search_info.search_params_;
-        knowhere::SetMetaTopk(conf, search_info.topk_);
-        knowhere::SetMetaMetricType(conf, field_indexing->metric_type_);
-        auto index_type = field_indexing->indexing_->index_type();
-        auto adapter = knowhere::AdapterMgr::GetInstance().GetAdapter(index_type);
-        try {
-            adapter->CheckSearch(conf, index_type, field_indexing->indexing_->index_mode());
-        } catch (std::exception& e) {
-            AssertInfo(false, e.what());
-        }
-        return field_indexing->indexing_->Query(ds, conf, bitset);
-    }();
+        auto conf = search_info.config_cache_->Get(search_info.search_params_, search_info.topk_,
+                                                   field_indexing->metric_type_,
+                                                   field_indexing->indexing_->index_type(),
+                                                   field_indexing->indexing_->index_mode());
+        final = field_indexing->indexing_->Query(ds, *conf, bitset);
+    } catch (std::exception& e) {
+        return Status(KNOWHERE_ERROR, e.what());
+    }
 
     auto ids = knowhere::GetDatasetIDs(final);
     float* distances = (float*)knowhere::GetDatasetDistance(final);
 
     auto total_num = num_queries * topk;
-    if (round_decimal != -1) {
-        const float multiplier = pow(10.0, round_decimal);
-        for (int i = 0; i < total_num; i++) {
-            distances[i] = round(distances[i] * multiplier) / multiplier;
-        }
-    }
+    RoundDistances(distances, total_num, round_decimal);
     result.seg_offsets_.resize(total_num);
     result.distances_.resize(total_num);
     result.total_nq_ = num_queries;
     result.unity_topK_ = topk;
+    result.profile_.chunks_on_index_ = 1;
 
     std::copy_n(ids, total_num, result.seg_offsets_.data());
     std::copy_n(distances, total_num, result.distances_.data());
+    return Status::OK();
 }
 
-void
+Status
 SearchOnSealed(const Schema& schema,
                const segcore::InsertRecord& record,
                const SearchInfo& search_info,
@@ -88,7 +85,7 @@ SearchOnSealed(const Schema& schema,
                const BitsetView& bitset,
                SearchResult& result) {
     auto field_id = search_info.field_id_;
-    auto& field = schema[field_id];
+    auto& field = search_info.field_meta_ != nullptr ? *search_info.field_meta_ : schema[field_id];
 
     query::dataset::SearchDataset dataset{search_info.metric_type_,   num_queries,     search_info.topk_,
                                           search_info.round_decimal_, field.get_dim(), query_data};
@@ -96,11 +93,19 @@ SearchOnSealed(const Schema& schema,
     AssertInfo(vec_data->num_chunk() == 1, "num chunk not equal to 1 for sealed segment");
     auto chunk_data = vec_data->get_chunk_data(0);
     auto sub_qr = query::BruteForceSearch(dataset, chunk_data, row_count, bitset);
+    if (!sub_qr.ok()) {
+        return sub_qr.status();
+    }
+    // BruteForceSearch leaves distances unrounded; a sealed segment is one
+    // chunk, so this is the final result
+    sub_qr.value().round_values();
 
-    result.distances_ = std::move(sub_qr.mutable_distances());
-    result.seg_offsets_ = std::move(sub_qr.mutable_seg_offsets());
+    result.distances_ = std::move(sub_qr.value().mutable_distances());
+    result.seg_offsets_ = std::move(sub_qr.value().mutable_seg_offsets());
     result.unity_topK_ = dataset.topk;
     result.total_nq_ = dataset.num_queries;
+    result.profile_.chunks_brute_forced_ = 1;
+    return Status::OK();
 }
 
 }  // namespace milvus::query
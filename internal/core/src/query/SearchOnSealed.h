@@ -15,10 +15,11 @@
 #include "query/PlanNode.h"
 #include "query/SearchOnGrowing.h"
 #include "segcore/SealedIndexingRecord.h"
+#include "utils/Status.h"
 
 namespace milvus::query {
 
-void
+Status
 SearchOnSealedIndex(const Schema& schema,
                     const segcore::SealedIndexingRecord& record,
                     const SearchInfo& search_info,
@@ -27,7 +28,7 @@ SearchOnSealedIndex(const Schema& schema,
                     const BitsetView& view,
                     SearchResult& result);
 
-void
+Status
 SearchOnSealed(const Schema& schema,
                const segcore::InsertRecord& record,
                const SearchInfo& search_info,
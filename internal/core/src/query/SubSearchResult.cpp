@@ -9,8 +9,10 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
 #include <cmath>
 
+#include "common/SimdDispatch.h"
 #include "exceptions/EasyAssert.h"
 #include "query/SubSearchResult.h"
 
@@ -58,6 +60,81 @@ SubSearchResult::merge_impl(const SubSearchResult& right) {
     }
 }
 
+template <bool is_desc>
+void
+SubSearchResult::merge_all_impl(const std::vector<SubSearchResult>& sub_results) {
+    // tournament heap over the heads of all candidate lists; each list is
+    // already sorted best-first, so popping the heap root topk times per
+    // query yields the merged topk in one pass over k lists
+    std::vector<const SubSearchResult*> lists;
+    lists.reserve(sub_results.size() + 1);
+    lists.push_back(this);
+    for (auto& sub_result : sub_results) {
+        AssertInfo(num_queries_ == sub_result.num_queries_, "[SubSearchResult]Nq check failed");
+        AssertInfo(topk_ == sub_result.topk_, "[SubSearchResult]Topk check failed");
+        AssertInfo(metric_type_ == sub_result.metric_type_, "[SubSearchResult]Metric type check failed");
+        lists.push_back(&sub_result);
+    }
+    auto num_lists = static_cast<int64_t>(lists.size());
+
+    struct Candidate {
+        float distance;
+        int64_t list;
+    };
+    // std heaps keep the *largest* element at the root, so "less" here must
+    // rank the better candidate higher
+    auto less = [](const Candidate& lhs, const Candidate& rhs) {
+        return is_desc ? (lhs.distance < rhs.distance) : (lhs.distance > rhs.distance);
+    };
+
+    auto& scratch = ScratchBuffers::Local();
+    auto merged_ids = scratch.TakeIds();
+    auto merged_distances = scratch.TakeDistances();
+    merged_ids.assign(num_queries_ * topk_, -1);
+    merged_distances.assign(num_queries_ * topk_, init_value(metric_type_));
+    std::vector<Candidate> heap;
+    heap.reserve(num_lists);
+    std::vector<int64_t> cursors(num_lists);
+
+    for (int64_t qn = 0; qn < num_queries_; ++qn) {
+        auto offset = qn * topk_;
+        heap.clear();
+        for (int64_t list = 0; list < num_lists; ++list) {
+            cursors[list] = 0;
+            heap.push_back(Candidate{lists[list]->get_distances()[offset], list});
+        }
+        std::make_heap(heap.begin(), heap.end(), less);
+
+        for (int64_t buf_iter = 0; buf_iter < topk_; ++buf_iter) {
+            std::pop_heap(heap.begin(), heap.end(), less);
+            auto candidate = heap.back();
+            heap.pop_back();
+            auto& cursor = cursors[candidate.list];
+            merged_distances[offset + buf_iter] = candidate.distance;
+            merged_ids[offset + buf_iter] = lists[candidate.list]->get_ids()[offset + cursor];
+            if (++cursor < topk_) {
+                heap.push_back(Candidate{lists[candidate.list]->get_distances()[offset + cursor], candidate.list});
+                std::push_heap(heap.begin(), heap.end(), less);
+            }
+        }
+    }
+    std::swap(distances_, merged_distances);
+    std::swap(seg_offsets_, merged_ids);
+    scratch.Recycle(std::move(merged_ids), std::move(merged_distances));
+}
+
+void
+SubSearchResult::merge_all(const std::vector<SubSearchResult>& sub_results) {
+    if (sub_results.empty()) {
+        return;
+    }
+    if (is_descending(metric_type_)) {
+        this->merge_all_impl<true>(sub_results);
+    } else {
+        this->merge_all_impl<false>(sub_results);
+    }
+}
+
 void
 SubSearchResult::merge(const SubSearchResult& sub_result) {
     AssertInfo(metric_type_ == sub_result.metric_type_, "[SubSearchResult]Metric type check failed when merge");
@@ -68,14 +145,52 @@ SubSearchResult::merge(const SubSearchResult& sub_result) {
     }
 }
 
+namespace {
+
+// round-half-away-from-zero spelled as copysign(0.5) + trunc so the scalar
+// body and the AVX2 clone compile from the same code shape and agree
+// bit-for-bit; the vectorizer lowers trunc/copysign to vroundps/vandps
+#define MILVUS_ROUND_DISTANCES_BODY                                                \
+    for (int64_t i = 0; i < count; ++i) {                                          \
+        float scaled = distances[i] * multiplier;                                  \
+        scaled = __builtin_truncf(scaled + __builtin_copysignf(0.5f, scaled));     \
+        distances[i] = scaled / multiplier;                                        \
+    }
+
 void
-SubSearchResult::round_values() {
-    if (round_decimal_ == -1)
+RoundDistancesImpl(float* distances, int64_t count, float multiplier) {
+    MILVUS_ROUND_DISTANCES_BODY
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) void
+RoundDistancesAvx2(float* distances, int64_t count, float multiplier) {
+    MILVUS_ROUND_DISTANCES_BODY
+}
+#endif
+
+#undef MILVUS_ROUND_DISTANCES_BODY
+
+}  // namespace
+
+void
+RoundDistances(float* distances, int64_t count, int64_t round_decimal) {
+    if (round_decimal == -1 || count == 0) {
+        return;
+    }
+    const float multiplier = pow(10.0, round_decimal);
+#if defined(__x86_64__)
+    if (UseSimdAvx2()) {
+        RoundDistancesAvx2(distances, count, multiplier);
         return;
-    const float multiplier = pow(10.0, round_decimal_);
-    for (auto it = this->distances_.begin(); it != this->distances_.end(); it++) {
-        *it = round(*it * multiplier) / multiplier;
     }
+#endif
+    RoundDistancesImpl(distances, count, multiplier);
+}
+
+void
+SubSearchResult::round_values() {
+    RoundDistances(distances_.data(), static_cast<int64_t>(distances_.size()), round_decimal_);
 }
 
 }  // namespace milvus::query
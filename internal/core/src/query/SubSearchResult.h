@@ -15,9 +15,15 @@
 #include <utility>
 #include <vector>
 #include "common/Types.h"
+#include "query/ScratchBuffers.h"
 
 namespace milvus::query {
 
+// vectorized round-half-away-from-zero over a distance buffer; no-op when
+// round_decimal is -1
+void
+RoundDistances(float* distances, int64_t count, int64_t round_decimal);
+
 class SubSearchResult {
  public:
     SubSearchResult(int64_t num_queries, int64_t topk, const knowhere::MetricType& metric_type, int64_t round_decimal)
@@ -25,8 +31,25 @@ class SubSearchResult {
           topk_(topk),
           round_decimal_(round_decimal),
           metric_type_(metric_type),
-          seg_offsets_(num_queries * topk, -1),
-          distances_(num_queries * topk, init_value(metric_type)) {
+          seg_offsets_(ScratchBuffers::Local().TakeIds()),
+          distances_(ScratchBuffers::Local().TakeDistances()) {
+        seg_offsets_.assign(num_queries * topk, -1);
+        distances_.assign(num_queries * topk, init_value(metric_type));
+    }
+
+    // adopts fully-populated staging buffers without the init fill
+    SubSearchResult(int64_t num_queries,
+                    int64_t topk,
+                    const knowhere::MetricType& metric_type,
+                    int64_t round_decimal,
+                    std::vector<int64_t>&& seg_offsets,
+                    std::vector<float>&& distances)
+        : num_queries_(num_queries),
+          topk_(topk),
+          round_decimal_(round_decimal),
+          metric_type_(metric_type),
+          seg_offsets_(std::move(seg_offsets)),
+          distances_(std::move(distances)) {
     }
 
     SubSearchResult(SubSearchResult&& other)
@@ -38,6 +61,10 @@ class SubSearchResult {
           distances_(std::move(other.distances_)) {
     }
 
+    ~SubSearchResult() {
+        ScratchBuffers::Local().Recycle(std::move(seg_offsets_), std::move(distances_));
+    }
+
  public:
     static float
     init_value(const knowhere::MetricType& metric_type) {
@@ -95,17 +122,28 @@ class SubSearchResult {
         return distances_;
     }
 
+    // rounds every distance to round_decimal places; called once on the
+    // final merged result rather than per chunk
     void
     round_values();
 
     void
     merge(const SubSearchResult& sub_result);
 
+    // merges all per-chunk results (plus this result's current contents) in a
+    // single k-way pass, instead of k pairwise merges
+    void
+    merge_all(const std::vector<SubSearchResult>& sub_results);
+
  private:
     template <bool is_desc>
     void
     merge_impl(const SubSearchResult& sub_result);
 
+    template <bool is_desc>
+    void
+    merge_all_impl(const std::vector<SubSearchResult>& sub_results);
+
  private:
     int64_t num_queries_;
     int64_t topk_;
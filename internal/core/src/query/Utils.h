@@ -12,6 +12,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include "query/Expr.h"
 #include "common/Utils.h"
 
@@ -35,4 +36,17 @@ Match<std::string>(const std::string& str, const std::string& val, OpType op) {
             PanicInfo("not supported");
     }
 }
+
+// string chunks hand out views instead of owning strings
+inline bool
+Match(std::string_view str, const std::string& val, OpType op) {
+    switch (op) {
+        case OpType::PrefixMatch:
+            return PrefixMatch(str, val);
+        case OpType::PostfixMatch:
+            return PostfixMatch(str, val);
+        default:
+            PanicInfo("not supported");
+    }
+}
 }  // namespace milvus::query
@@ -59,11 +59,20 @@ class ExecExprVisitor : public ExprVisitor {
         return std::move(res.value());
     }
 
+    int64_t
+    row_count() const {
+        return row_count_;
+    }
+
  public:
     template <typename T, typename IndexFunc, typename ElementFunc>
     auto
     ExecRangeVisitorImpl(FieldId field_id, IndexFunc func, ElementFunc element_func) -> BitsetType;
 
+    template <typename T, typename IndexFunc, typename ElementFunc, typename SkipFunc>
+    auto
+    ExecRangeVisitorImpl(FieldId field_id, IndexFunc func, ElementFunc element_func, SkipFunc skip_func) -> BitsetType;
+
     template <typename T, typename IndexFunc, typename ElementFunc>
     auto
     ExecDataRangeVisitorImpl(FieldId field_id, IndexFunc index_func, ElementFunc element_func) -> BitsetType;
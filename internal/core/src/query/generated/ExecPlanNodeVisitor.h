@@ -78,4 +78,9 @@ class ExecPlanNodeVisitor : public PlanNodeVisitor {
     SearchResultOpt search_result_opt_;
     RetrieveResultOpt retrieve_result_opt_;
 };
+
+// rows matching the retrieve plan's predicate and visible at `timestamp`,
+// counted word-wise on the filter bitset; no offsets or entries materialize
+int64_t
+ExecCount(const segcore::SegmentInternalInterface& segment, const RetrievePlanNode& node, Timestamp timestamp);
 }  // namespace milvus::query
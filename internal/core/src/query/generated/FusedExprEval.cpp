@@ -0,0 +1,2615 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+// Generated File
+// DO NOT EDIT
+#include <algorithm>
+#include <optional>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <vector>
+
+#include "query/generated/FusedExprEval.h"
+#include "common/BitsetUtils.h"
+#include "common/Utils.h"
+#include "query/ExprImpl.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus::query {
+
+namespace {
+
+// mirrors the expression visitors' threshold for fanning chunk evaluation
+// out to tbb
+constexpr int64_t kParallelEvalRowThreshold = 256 * 1024;
+
+// a field is fusable when every chunk scans raw data; a field with any
+// scalar index goes through the split per-leaf path instead
+bool
+FusableField(const segcore::SegmentInternalInterface& segment, FieldId field_id, int64_t num_chunk) {
+    return segment.num_chunk_index(field_id) == 0 && segment.num_chunk_data(field_id) >= num_chunk;
+}
+
+template <typename Eval>
+BitsetType
+EvalFusedChunks(const segcore::SegmentInternalInterface& segment, int64_t row_count, Eval eval) {
+    auto size_per_chunk = segment.size_per_chunk();
+    auto num_chunk = upper_div(row_count, size_per_chunk);
+    std::vector<BitsetType> results(num_chunk);
+    auto eval_chunk = [&](int64_t chunk_id) {
+        auto this_size = chunk_id == num_chunk - 1 ? row_count - chunk_id * size_per_chunk : size_per_chunk;
+        BitsetType result(this_size);
+        eval(chunk_id, this_size, result);
+        results[chunk_id] = std::move(result);
+    };
+    if (num_chunk > 1 && row_count >= kParallelEvalRowThreshold) {
+        tbb::parallel_for(tbb::blocked_range<int64_t>(0, num_chunk), [&](const tbb::blocked_range<int64_t>& range) {
+            for (auto chunk_id = range.begin(); chunk_id != range.end(); ++chunk_id) {
+                eval_chunk(chunk_id);
+            }
+        });
+    } else {
+        for (auto chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
+            eval_chunk(chunk_id);
+        }
+    }
+    BitsetType final_result(row_count);
+    int64_t counter = 0;
+    for (auto& chunk : results) {
+        AppendBitset(final_result, counter, chunk);
+        counter += chunk.size();
+    }
+    return final_result;
+}
+
+template <typename T, typename Func>
+BitsetType
+EvalFusedTwoColumn(const segcore::SegmentInternalInterface& segment,
+                   int64_t row_count,
+                   FieldId left_field,
+                   FieldId right_field,
+                   Func func) {
+    return EvalFusedChunks(segment, row_count, [&](int64_t chunk_id, int64_t size, BitsetType& result) {
+        auto left = segment.chunk_data<T>(left_field, chunk_id);
+        auto right = segment.chunk_data<T>(right_field, chunk_id);
+        EvalBinaryElementwise(left.data(), right.data(), size, result, func);
+    });
+}
+
+template <typename T, typename Func>
+BitsetType
+EvalFusedThreeColumn(const segcore::SegmentInternalInterface& segment,
+                     int64_t row_count,
+                     FieldId a_field,
+                     FieldId b_field,
+                     FieldId c_field,
+                     Func func) {
+    return EvalFusedChunks(segment, row_count, [&](int64_t chunk_id, int64_t size, BitsetType& result) {
+        auto a = segment.chunk_data<T>(a_field, chunk_id);
+        auto b = segment.chunk_data<T>(b_field, chunk_id);
+        auto c = segment.chunk_data<T>(c_field, chunk_id);
+        EvalTernaryElementwise(a.data(), b.data(), c.data(), size, result, func);
+    });
+}
+
+// sorted IN-list probe shared by the term kernels
+template <typename T>
+class SortedTerms {
+ public:
+    explicit SortedTerms(const std::vector<T>& terms) : values_(terms) {
+        std::sort(values_.begin(), values_.end());
+    }
+
+    bool
+    operator()(T value) const {
+        return std::binary_search(values_.begin(), values_.end(), value);
+    }
+
+ private:
+    std::vector<T> values_;
+};
+
+// ---- int8_t ----
+
+bool
+TryFusedTermRangeInt8(const segcore::SegmentInternalInterface& segment,
+                        int64_t row_count,
+                        const TermExprImpl<int8_t>& term,
+                        const Expr& range,
+                        BitsetType& out) {
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (auto unary = dynamic_cast<const UnaryRangeExprImpl<int8_t>*>(&range)) {
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, unary->field_id_, num_chunk)) {
+            return false;
+        }
+        SortedTerms<int8_t> probe(term.terms_);
+        auto val = unary->value_;
+        switch (unary->op_type_) {
+            case OpType::LessThan: {
+                out = EvalFusedTwoColumn<int8_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int8_t x, int8_t y) { return y < val && probe(x); });
+                return true;
+            }
+            case OpType::LessEqual: {
+                out = EvalFusedTwoColumn<int8_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int8_t x, int8_t y) { return y <= val && probe(x); });
+                return true;
+            }
+            case OpType::GreaterThan: {
+                out = EvalFusedTwoColumn<int8_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int8_t x, int8_t y) { return y > val && probe(x); });
+                return true;
+            }
+            case OpType::GreaterEqual: {
+                out = EvalFusedTwoColumn<int8_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int8_t x, int8_t y) { return y >= val && probe(x); });
+                return true;
+            }
+            case OpType::Equal: {
+                out = EvalFusedTwoColumn<int8_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int8_t x, int8_t y) { return y == val && probe(x); });
+                return true;
+            }
+            case OpType::NotEqual: {
+                out = EvalFusedTwoColumn<int8_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int8_t x, int8_t y) { return y != val && probe(x); });
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+    if (auto binary = dynamic_cast<const BinaryRangeExprImpl<int8_t>*>(&range)) {
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, binary->field_id_, num_chunk)) {
+            return false;
+        }
+        SortedTerms<int8_t> probe(term.terms_);
+        auto lower = binary->lower_value_;
+        auto upper = binary->upper_value_;
+        switch ((binary->lower_inclusive_ ? 2 : 0) | (binary->upper_inclusive_ ? 1 : 0)) {
+            case 0: {
+                out = EvalFusedTwoColumn<int8_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int8_t x, int8_t y) {
+                        return lower < y && y < upper && probe(x);
+                    });
+                return true;
+            }
+            case 1: {
+                out = EvalFusedTwoColumn<int8_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int8_t x, int8_t y) {
+                        return lower < y && y <= upper && probe(x);
+                    });
+                return true;
+            }
+            case 2: {
+                out = EvalFusedTwoColumn<int8_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int8_t x, int8_t y) {
+                        return lower <= y && y < upper && probe(x);
+                    });
+                return true;
+            }
+            case 3: {
+                out = EvalFusedTwoColumn<int8_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int8_t x, int8_t y) {
+                        return lower <= y && y <= upper && probe(x);
+                    });
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+bool
+TryFusedCompareRangeInt8(const segcore::SegmentInternalInterface& segment,
+                           int64_t row_count,
+                           const CompareExpr& compare,
+                           const UnaryRangeExprImpl<int8_t>& range,
+                           BitsetType& out) {
+    if (compare.left_data_type_ != DataType::INT8 || compare.right_data_type_ != DataType::INT8) {
+        return false;
+    }
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (!FusableField(segment, compare.left_field_id_, num_chunk) ||
+        !FusableField(segment, compare.right_field_id_, num_chunk) ||
+        !FusableField(segment, range.field_id_, num_chunk)) {
+        return false;
+    }
+    auto val = range.value_;
+    switch (compare.op_type_) {
+        case OpType::LessThan: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a < b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a < b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a < b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a < b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a < b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a < b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::LessEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a <= b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a <= b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a <= b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a <= b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a <= b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a <= b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::GreaterThan: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a > b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a > b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a > b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a > b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a > b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a > b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::GreaterEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a >= b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a >= b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a >= b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a >= b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a >= b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a >= b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::Equal: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a == b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a == b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a == b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a == b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a == b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a == b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::NotEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a != b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a != b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a != b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a != b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a != b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int8_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int8_t a, int8_t b, int8_t y) { return a != b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+bool
+TryFusedInt8(const segcore::SegmentInternalInterface& segment,
+               int64_t row_count,
+               const Expr& left,
+               const Expr& right,
+               BitsetType& out) {
+    if (auto term = dynamic_cast<const TermExprImpl<int8_t>*>(&left)) {
+        return TryFusedTermRangeInt8(segment, row_count, *term, right, out);
+    }
+    if (auto term = dynamic_cast<const TermExprImpl<int8_t>*>(&right)) {
+        return TryFusedTermRangeInt8(segment, row_count, *term, left, out);
+    }
+    if (auto compare = dynamic_cast<const CompareExpr*>(&left)) {
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<int8_t>*>(&right)) {
+            return TryFusedCompareRangeInt8(segment, row_count, *compare, *range, out);
+        }
+    }
+    if (auto compare = dynamic_cast<const CompareExpr*>(&right)) {
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<int8_t>*>(&left)) {
+            return TryFusedCompareRangeInt8(segment, row_count, *compare, *range, out);
+        }
+    }
+    return false;
+}
+
+// ---- int16_t ----
+
+bool
+TryFusedTermRangeInt16(const segcore::SegmentInternalInterface& segment,
+                        int64_t row_count,
+                        const TermExprImpl<int16_t>& term,
+                        const Expr& range,
+                        BitsetType& out) {
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (auto unary = dynamic_cast<const UnaryRangeExprImpl<int16_t>*>(&range)) {
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, unary->field_id_, num_chunk)) {
+            return false;
+        }
+        SortedTerms<int16_t> probe(term.terms_);
+        auto val = unary->value_;
+        switch (unary->op_type_) {
+            case OpType::LessThan: {
+                out = EvalFusedTwoColumn<int16_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int16_t x, int16_t y) { return y < val && probe(x); });
+                return true;
+            }
+            case OpType::LessEqual: {
+                out = EvalFusedTwoColumn<int16_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int16_t x, int16_t y) { return y <= val && probe(x); });
+                return true;
+            }
+            case OpType::GreaterThan: {
+                out = EvalFusedTwoColumn<int16_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int16_t x, int16_t y) { return y > val && probe(x); });
+                return true;
+            }
+            case OpType::GreaterEqual: {
+                out = EvalFusedTwoColumn<int16_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int16_t x, int16_t y) { return y >= val && probe(x); });
+                return true;
+            }
+            case OpType::Equal: {
+                out = EvalFusedTwoColumn<int16_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int16_t x, int16_t y) { return y == val && probe(x); });
+                return true;
+            }
+            case OpType::NotEqual: {
+                out = EvalFusedTwoColumn<int16_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int16_t x, int16_t y) { return y != val && probe(x); });
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+    if (auto binary = dynamic_cast<const BinaryRangeExprImpl<int16_t>*>(&range)) {
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, binary->field_id_, num_chunk)) {
+            return false;
+        }
+        SortedTerms<int16_t> probe(term.terms_);
+        auto lower = binary->lower_value_;
+        auto upper = binary->upper_value_;
+        switch ((binary->lower_inclusive_ ? 2 : 0) | (binary->upper_inclusive_ ? 1 : 0)) {
+            case 0: {
+                out = EvalFusedTwoColumn<int16_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int16_t x, int16_t y) {
+                        return lower < y && y < upper && probe(x);
+                    });
+                return true;
+            }
+            case 1: {
+                out = EvalFusedTwoColumn<int16_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int16_t x, int16_t y) {
+                        return lower < y && y <= upper && probe(x);
+                    });
+                return true;
+            }
+            case 2: {
+                out = EvalFusedTwoColumn<int16_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int16_t x, int16_t y) {
+                        return lower <= y && y < upper && probe(x);
+                    });
+                return true;
+            }
+            case 3: {
+                out = EvalFusedTwoColumn<int16_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int16_t x, int16_t y) {
+                        return lower <= y && y <= upper && probe(x);
+                    });
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+bool
+TryFusedCompareRangeInt16(const segcore::SegmentInternalInterface& segment,
+                           int64_t row_count,
+                           const CompareExpr& compare,
+                           const UnaryRangeExprImpl<int16_t>& range,
+                           BitsetType& out) {
+    if (compare.left_data_type_ != DataType::INT16 || compare.right_data_type_ != DataType::INT16) {
+        return false;
+    }
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (!FusableField(segment, compare.left_field_id_, num_chunk) ||
+        !FusableField(segment, compare.right_field_id_, num_chunk) ||
+        !FusableField(segment, range.field_id_, num_chunk)) {
+        return false;
+    }
+    auto val = range.value_;
+    switch (compare.op_type_) {
+        case OpType::LessThan: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a < b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a < b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a < b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a < b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a < b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a < b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::LessEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a <= b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a <= b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a <= b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a <= b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a <= b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a <= b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::GreaterThan: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a > b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a > b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a > b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a > b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a > b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a > b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::GreaterEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a >= b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a >= b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a >= b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a >= b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a >= b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a >= b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::Equal: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a == b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a == b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a == b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a == b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a == b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a == b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::NotEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a != b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a != b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a != b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a != b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a != b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int16_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int16_t a, int16_t b, int16_t y) { return a != b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+bool
+TryFusedInt16(const segcore::SegmentInternalInterface& segment,
+               int64_t row_count,
+               const Expr& left,
+               const Expr& right,
+               BitsetType& out) {
+    if (auto term = dynamic_cast<const TermExprImpl<int16_t>*>(&left)) {
+        return TryFusedTermRangeInt16(segment, row_count, *term, right, out);
+    }
+    if (auto term = dynamic_cast<const TermExprImpl<int16_t>*>(&right)) {
+        return TryFusedTermRangeInt16(segment, row_count, *term, left, out);
+    }
+    if (auto compare = dynamic_cast<const CompareExpr*>(&left)) {
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<int16_t>*>(&right)) {
+            return TryFusedCompareRangeInt16(segment, row_count, *compare, *range, out);
+        }
+    }
+    if (auto compare = dynamic_cast<const CompareExpr*>(&right)) {
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<int16_t>*>(&left)) {
+            return TryFusedCompareRangeInt16(segment, row_count, *compare, *range, out);
+        }
+    }
+    return false;
+}
+
+// ---- int32_t ----
+
+bool
+TryFusedTermRangeInt32(const segcore::SegmentInternalInterface& segment,
+                        int64_t row_count,
+                        const TermExprImpl<int32_t>& term,
+                        const Expr& range,
+                        BitsetType& out) {
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (auto unary = dynamic_cast<const UnaryRangeExprImpl<int32_t>*>(&range)) {
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, unary->field_id_, num_chunk)) {
+            return false;
+        }
+        SortedTerms<int32_t> probe(term.terms_);
+        auto val = unary->value_;
+        switch (unary->op_type_) {
+            case OpType::LessThan: {
+                out = EvalFusedTwoColumn<int32_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int32_t x, int32_t y) { return y < val && probe(x); });
+                return true;
+            }
+            case OpType::LessEqual: {
+                out = EvalFusedTwoColumn<int32_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int32_t x, int32_t y) { return y <= val && probe(x); });
+                return true;
+            }
+            case OpType::GreaterThan: {
+                out = EvalFusedTwoColumn<int32_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int32_t x, int32_t y) { return y > val && probe(x); });
+                return true;
+            }
+            case OpType::GreaterEqual: {
+                out = EvalFusedTwoColumn<int32_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int32_t x, int32_t y) { return y >= val && probe(x); });
+                return true;
+            }
+            case OpType::Equal: {
+                out = EvalFusedTwoColumn<int32_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int32_t x, int32_t y) { return y == val && probe(x); });
+                return true;
+            }
+            case OpType::NotEqual: {
+                out = EvalFusedTwoColumn<int32_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int32_t x, int32_t y) { return y != val && probe(x); });
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+    if (auto binary = dynamic_cast<const BinaryRangeExprImpl<int32_t>*>(&range)) {
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, binary->field_id_, num_chunk)) {
+            return false;
+        }
+        SortedTerms<int32_t> probe(term.terms_);
+        auto lower = binary->lower_value_;
+        auto upper = binary->upper_value_;
+        switch ((binary->lower_inclusive_ ? 2 : 0) | (binary->upper_inclusive_ ? 1 : 0)) {
+            case 0: {
+                out = EvalFusedTwoColumn<int32_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int32_t x, int32_t y) {
+                        return lower < y && y < upper && probe(x);
+                    });
+                return true;
+            }
+            case 1: {
+                out = EvalFusedTwoColumn<int32_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int32_t x, int32_t y) {
+                        return lower < y && y <= upper && probe(x);
+                    });
+                return true;
+            }
+            case 2: {
+                out = EvalFusedTwoColumn<int32_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int32_t x, int32_t y) {
+                        return lower <= y && y < upper && probe(x);
+                    });
+                return true;
+            }
+            case 3: {
+                out = EvalFusedTwoColumn<int32_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int32_t x, int32_t y) {
+                        return lower <= y && y <= upper && probe(x);
+                    });
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+bool
+TryFusedCompareRangeInt32(const segcore::SegmentInternalInterface& segment,
+                           int64_t row_count,
+                           const CompareExpr& compare,
+                           const UnaryRangeExprImpl<int32_t>& range,
+                           BitsetType& out) {
+    if (compare.left_data_type_ != DataType::INT32 || compare.right_data_type_ != DataType::INT32) {
+        return false;
+    }
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (!FusableField(segment, compare.left_field_id_, num_chunk) ||
+        !FusableField(segment, compare.right_field_id_, num_chunk) ||
+        !FusableField(segment, range.field_id_, num_chunk)) {
+        return false;
+    }
+    auto val = range.value_;
+    switch (compare.op_type_) {
+        case OpType::LessThan: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a < b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a < b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a < b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a < b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a < b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a < b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::LessEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a <= b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a <= b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a <= b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a <= b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a <= b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a <= b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::GreaterThan: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a > b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a > b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a > b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a > b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a > b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a > b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::GreaterEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a >= b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a >= b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a >= b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a >= b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a >= b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a >= b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::Equal: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a == b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a == b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a == b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a == b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a == b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a == b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::NotEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a != b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a != b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a != b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a != b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a != b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int32_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int32_t a, int32_t b, int32_t y) { return a != b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+bool
+TryFusedInt32(const segcore::SegmentInternalInterface& segment,
+               int64_t row_count,
+               const Expr& left,
+               const Expr& right,
+               BitsetType& out) {
+    if (auto term = dynamic_cast<const TermExprImpl<int32_t>*>(&left)) {
+        return TryFusedTermRangeInt32(segment, row_count, *term, right, out);
+    }
+    if (auto term = dynamic_cast<const TermExprImpl<int32_t>*>(&right)) {
+        return TryFusedTermRangeInt32(segment, row_count, *term, left, out);
+    }
+    if (auto compare = dynamic_cast<const CompareExpr*>(&left)) {
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<int32_t>*>(&right)) {
+            return TryFusedCompareRangeInt32(segment, row_count, *compare, *range, out);
+        }
+    }
+    if (auto compare = dynamic_cast<const CompareExpr*>(&right)) {
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<int32_t>*>(&left)) {
+            return TryFusedCompareRangeInt32(segment, row_count, *compare, *range, out);
+        }
+    }
+    return false;
+}
+
+// ---- int64_t ----
+
+bool
+TryFusedTermRangeInt64(const segcore::SegmentInternalInterface& segment,
+                        int64_t row_count,
+                        const TermExprImpl<int64_t>& term,
+                        const Expr& range,
+                        BitsetType& out) {
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (auto unary = dynamic_cast<const UnaryRangeExprImpl<int64_t>*>(&range)) {
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, unary->field_id_, num_chunk)) {
+            return false;
+        }
+        SortedTerms<int64_t> probe(term.terms_);
+        auto val = unary->value_;
+        switch (unary->op_type_) {
+            case OpType::LessThan: {
+                out = EvalFusedTwoColumn<int64_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int64_t x, int64_t y) { return y < val && probe(x); });
+                return true;
+            }
+            case OpType::LessEqual: {
+                out = EvalFusedTwoColumn<int64_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int64_t x, int64_t y) { return y <= val && probe(x); });
+                return true;
+            }
+            case OpType::GreaterThan: {
+                out = EvalFusedTwoColumn<int64_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int64_t x, int64_t y) { return y > val && probe(x); });
+                return true;
+            }
+            case OpType::GreaterEqual: {
+                out = EvalFusedTwoColumn<int64_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int64_t x, int64_t y) { return y >= val && probe(x); });
+                return true;
+            }
+            case OpType::Equal: {
+                out = EvalFusedTwoColumn<int64_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int64_t x, int64_t y) { return y == val && probe(x); });
+                return true;
+            }
+            case OpType::NotEqual: {
+                out = EvalFusedTwoColumn<int64_t>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](int64_t x, int64_t y) { return y != val && probe(x); });
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+    if (auto binary = dynamic_cast<const BinaryRangeExprImpl<int64_t>*>(&range)) {
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, binary->field_id_, num_chunk)) {
+            return false;
+        }
+        SortedTerms<int64_t> probe(term.terms_);
+        auto lower = binary->lower_value_;
+        auto upper = binary->upper_value_;
+        switch ((binary->lower_inclusive_ ? 2 : 0) | (binary->upper_inclusive_ ? 1 : 0)) {
+            case 0: {
+                out = EvalFusedTwoColumn<int64_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int64_t x, int64_t y) {
+                        return lower < y && y < upper && probe(x);
+                    });
+                return true;
+            }
+            case 1: {
+                out = EvalFusedTwoColumn<int64_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int64_t x, int64_t y) {
+                        return lower < y && y <= upper && probe(x);
+                    });
+                return true;
+            }
+            case 2: {
+                out = EvalFusedTwoColumn<int64_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int64_t x, int64_t y) {
+                        return lower <= y && y < upper && probe(x);
+                    });
+                return true;
+            }
+            case 3: {
+                out = EvalFusedTwoColumn<int64_t>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](int64_t x, int64_t y) {
+                        return lower <= y && y <= upper && probe(x);
+                    });
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+bool
+TryFusedCompareRangeInt64(const segcore::SegmentInternalInterface& segment,
+                           int64_t row_count,
+                           const CompareExpr& compare,
+                           const UnaryRangeExprImpl<int64_t>& range,
+                           BitsetType& out) {
+    if (compare.left_data_type_ != DataType::INT64 || compare.right_data_type_ != DataType::INT64) {
+        return false;
+    }
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (!FusableField(segment, compare.left_field_id_, num_chunk) ||
+        !FusableField(segment, compare.right_field_id_, num_chunk) ||
+        !FusableField(segment, range.field_id_, num_chunk)) {
+        return false;
+    }
+    auto val = range.value_;
+    switch (compare.op_type_) {
+        case OpType::LessThan: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a < b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a < b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a < b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a < b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a < b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a < b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::LessEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a <= b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a <= b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a <= b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a <= b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a <= b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a <= b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::GreaterThan: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a > b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a > b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a > b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a > b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a > b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a > b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::GreaterEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a >= b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a >= b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a >= b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a >= b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a >= b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a >= b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::Equal: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a == b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a == b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a == b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a == b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a == b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a == b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::NotEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a != b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a != b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a != b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a != b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a != b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<int64_t>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](int64_t a, int64_t b, int64_t y) { return a != b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+bool
+TryFusedInt64(const segcore::SegmentInternalInterface& segment,
+               int64_t row_count,
+               const Expr& left,
+               const Expr& right,
+               BitsetType& out) {
+    if (auto term = dynamic_cast<const TermExprImpl<int64_t>*>(&left)) {
+        return TryFusedTermRangeInt64(segment, row_count, *term, right, out);
+    }
+    if (auto term = dynamic_cast<const TermExprImpl<int64_t>*>(&right)) {
+        return TryFusedTermRangeInt64(segment, row_count, *term, left, out);
+    }
+    if (auto compare = dynamic_cast<const CompareExpr*>(&left)) {
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<int64_t>*>(&right)) {
+            return TryFusedCompareRangeInt64(segment, row_count, *compare, *range, out);
+        }
+    }
+    if (auto compare = dynamic_cast<const CompareExpr*>(&right)) {
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<int64_t>*>(&left)) {
+            return TryFusedCompareRangeInt64(segment, row_count, *compare, *range, out);
+        }
+    }
+    return false;
+}
+
+// ---- float ----
+
+bool
+TryFusedTermRangeFloat(const segcore::SegmentInternalInterface& segment,
+                        int64_t row_count,
+                        const TermExprImpl<float>& term,
+                        const Expr& range,
+                        BitsetType& out) {
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (auto unary = dynamic_cast<const UnaryRangeExprImpl<float>*>(&range)) {
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, unary->field_id_, num_chunk)) {
+            return false;
+        }
+        SortedTerms<float> probe(term.terms_);
+        auto val = unary->value_;
+        switch (unary->op_type_) {
+            case OpType::LessThan: {
+                out = EvalFusedTwoColumn<float>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](float x, float y) { return y < val && probe(x); });
+                return true;
+            }
+            case OpType::LessEqual: {
+                out = EvalFusedTwoColumn<float>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](float x, float y) { return y <= val && probe(x); });
+                return true;
+            }
+            case OpType::GreaterThan: {
+                out = EvalFusedTwoColumn<float>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](float x, float y) { return y > val && probe(x); });
+                return true;
+            }
+            case OpType::GreaterEqual: {
+                out = EvalFusedTwoColumn<float>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](float x, float y) { return y >= val && probe(x); });
+                return true;
+            }
+            case OpType::Equal: {
+                out = EvalFusedTwoColumn<float>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](float x, float y) { return y == val && probe(x); });
+                return true;
+            }
+            case OpType::NotEqual: {
+                out = EvalFusedTwoColumn<float>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](float x, float y) { return y != val && probe(x); });
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+    if (auto binary = dynamic_cast<const BinaryRangeExprImpl<float>*>(&range)) {
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, binary->field_id_, num_chunk)) {
+            return false;
+        }
+        SortedTerms<float> probe(term.terms_);
+        auto lower = binary->lower_value_;
+        auto upper = binary->upper_value_;
+        switch ((binary->lower_inclusive_ ? 2 : 0) | (binary->upper_inclusive_ ? 1 : 0)) {
+            case 0: {
+                out = EvalFusedTwoColumn<float>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](float x, float y) {
+                        return lower < y && y < upper && probe(x);
+                    });
+                return true;
+            }
+            case 1: {
+                out = EvalFusedTwoColumn<float>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](float x, float y) {
+                        return lower < y && y <= upper && probe(x);
+                    });
+                return true;
+            }
+            case 2: {
+                out = EvalFusedTwoColumn<float>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](float x, float y) {
+                        return lower <= y && y < upper && probe(x);
+                    });
+                return true;
+            }
+            case 3: {
+                out = EvalFusedTwoColumn<float>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](float x, float y) {
+                        return lower <= y && y <= upper && probe(x);
+                    });
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+bool
+TryFusedCompareRangeFloat(const segcore::SegmentInternalInterface& segment,
+                           int64_t row_count,
+                           const CompareExpr& compare,
+                           const UnaryRangeExprImpl<float>& range,
+                           BitsetType& out) {
+    if (compare.left_data_type_ != DataType::FLOAT || compare.right_data_type_ != DataType::FLOAT) {
+        return false;
+    }
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (!FusableField(segment, compare.left_field_id_, num_chunk) ||
+        !FusableField(segment, compare.right_field_id_, num_chunk) ||
+        !FusableField(segment, range.field_id_, num_chunk)) {
+        return false;
+    }
+    auto val = range.value_;
+    switch (compare.op_type_) {
+        case OpType::LessThan: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a < b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a < b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a < b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a < b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a < b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a < b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::LessEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a <= b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a <= b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a <= b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a <= b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a <= b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a <= b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::GreaterThan: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a > b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a > b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a > b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a > b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a > b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a > b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::GreaterEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a >= b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a >= b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a >= b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a >= b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a >= b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a >= b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::Equal: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a == b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a == b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a == b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a == b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a == b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a == b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::NotEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a != b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a != b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a != b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a != b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a != b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<float>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](float a, float b, float y) { return a != b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+bool
+TryFusedFloat(const segcore::SegmentInternalInterface& segment,
+               int64_t row_count,
+               const Expr& left,
+               const Expr& right,
+               BitsetType& out) {
+    if (auto term = dynamic_cast<const TermExprImpl<float>*>(&left)) {
+        return TryFusedTermRangeFloat(segment, row_count, *term, right, out);
+    }
+    if (auto term = dynamic_cast<const TermExprImpl<float>*>(&right)) {
+        return TryFusedTermRangeFloat(segment, row_count, *term, left, out);
+    }
+    if (auto compare = dynamic_cast<const CompareExpr*>(&left)) {
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<float>*>(&right)) {
+            return TryFusedCompareRangeFloat(segment, row_count, *compare, *range, out);
+        }
+    }
+    if (auto compare = dynamic_cast<const CompareExpr*>(&right)) {
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<float>*>(&left)) {
+            return TryFusedCompareRangeFloat(segment, row_count, *compare, *range, out);
+        }
+    }
+    return false;
+}
+
+// ---- double ----
+
+bool
+TryFusedTermRangeDouble(const segcore::SegmentInternalInterface& segment,
+                        int64_t row_count,
+                        const TermExprImpl<double>& term,
+                        const Expr& range,
+                        BitsetType& out) {
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (auto unary = dynamic_cast<const UnaryRangeExprImpl<double>*>(&range)) {
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, unary->field_id_, num_chunk)) {
+            return false;
+        }
+        SortedTerms<double> probe(term.terms_);
+        auto val = unary->value_;
+        switch (unary->op_type_) {
+            case OpType::LessThan: {
+                out = EvalFusedTwoColumn<double>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](double x, double y) { return y < val && probe(x); });
+                return true;
+            }
+            case OpType::LessEqual: {
+                out = EvalFusedTwoColumn<double>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](double x, double y) { return y <= val && probe(x); });
+                return true;
+            }
+            case OpType::GreaterThan: {
+                out = EvalFusedTwoColumn<double>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](double x, double y) { return y > val && probe(x); });
+                return true;
+            }
+            case OpType::GreaterEqual: {
+                out = EvalFusedTwoColumn<double>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](double x, double y) { return y >= val && probe(x); });
+                return true;
+            }
+            case OpType::Equal: {
+                out = EvalFusedTwoColumn<double>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](double x, double y) { return y == val && probe(x); });
+                return true;
+            }
+            case OpType::NotEqual: {
+                out = EvalFusedTwoColumn<double>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val](double x, double y) { return y != val && probe(x); });
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+    if (auto binary = dynamic_cast<const BinaryRangeExprImpl<double>*>(&range)) {
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, binary->field_id_, num_chunk)) {
+            return false;
+        }
+        SortedTerms<double> probe(term.terms_);
+        auto lower = binary->lower_value_;
+        auto upper = binary->upper_value_;
+        switch ((binary->lower_inclusive_ ? 2 : 0) | (binary->upper_inclusive_ ? 1 : 0)) {
+            case 0: {
+                out = EvalFusedTwoColumn<double>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](double x, double y) {
+                        return lower < y && y < upper && probe(x);
+                    });
+                return true;
+            }
+            case 1: {
+                out = EvalFusedTwoColumn<double>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](double x, double y) {
+                        return lower < y && y <= upper && probe(x);
+                    });
+                return true;
+            }
+            case 2: {
+                out = EvalFusedTwoColumn<double>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](double x, double y) {
+                        return lower <= y && y < upper && probe(x);
+                    });
+                return true;
+            }
+            case 3: {
+                out = EvalFusedTwoColumn<double>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper](double x, double y) {
+                        return lower <= y && y <= upper && probe(x);
+                    });
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+bool
+TryFusedCompareRangeDouble(const segcore::SegmentInternalInterface& segment,
+                           int64_t row_count,
+                           const CompareExpr& compare,
+                           const UnaryRangeExprImpl<double>& range,
+                           BitsetType& out) {
+    if (compare.left_data_type_ != DataType::DOUBLE || compare.right_data_type_ != DataType::DOUBLE) {
+        return false;
+    }
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (!FusableField(segment, compare.left_field_id_, num_chunk) ||
+        !FusableField(segment, compare.right_field_id_, num_chunk) ||
+        !FusableField(segment, range.field_id_, num_chunk)) {
+        return false;
+    }
+    auto val = range.value_;
+    switch (compare.op_type_) {
+        case OpType::LessThan: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a < b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a < b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a < b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a < b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a < b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a < b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::LessEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a <= b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a <= b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a <= b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a <= b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a <= b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a <= b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::GreaterThan: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a > b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a > b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a > b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a > b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a > b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a > b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::GreaterEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a >= b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a >= b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a >= b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a >= b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a >= b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a >= b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::Equal: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a == b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a == b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a == b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a == b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a == b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a == b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        case OpType::NotEqual: {
+            switch (range.op_type_) {
+                case OpType::LessThan: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a != b && y < val; });
+                    return true;
+                }
+                case OpType::LessEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a != b && y <= val; });
+                    return true;
+                }
+                case OpType::GreaterThan: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a != b && y > val; });
+                    return true;
+                }
+                case OpType::GreaterEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a != b && y >= val; });
+                    return true;
+                }
+                case OpType::Equal: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a != b && y == val; });
+                    return true;
+                }
+                case OpType::NotEqual: {
+                    out = EvalFusedThreeColumn<double>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val](double a, double b, double y) { return a != b && y != val; });
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+        default: {
+            return false;
+        }
+    }
+}
+
+bool
+TryFusedDouble(const segcore::SegmentInternalInterface& segment,
+               int64_t row_count,
+               const Expr& left,
+               const Expr& right,
+               BitsetType& out) {
+    if (auto term = dynamic_cast<const TermExprImpl<double>*>(&left)) {
+        return TryFusedTermRangeDouble(segment, row_count, *term, right, out);
+    }
+    if (auto term = dynamic_cast<const TermExprImpl<double>*>(&right)) {
+        return TryFusedTermRangeDouble(segment, row_count, *term, left, out);
+    }
+    if (auto compare = dynamic_cast<const CompareExpr*>(&left)) {
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<double>*>(&right)) {
+            return TryFusedCompareRangeDouble(segment, row_count, *compare, *range, out);
+        }
+    }
+    if (auto compare = dynamic_cast<const CompareExpr*>(&right)) {
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<double>*>(&left)) {
+            return TryFusedCompareRangeDouble(segment, row_count, *compare, *range, out);
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+std::optional<BitsetType>
+TryFusedConjunction(const segcore::SegmentInternalInterface& segment,
+                    int64_t row_count,
+                    const Expr& left,
+                    const Expr& right) {
+    BitsetType out;
+    if (TryFusedInt8(segment, row_count, left, right, out)) {
+        return out;
+    }
+    if (TryFusedInt16(segment, row_count, left, right, out)) {
+        return out;
+    }
+    if (TryFusedInt32(segment, row_count, left, right, out)) {
+        return out;
+    }
+    if (TryFusedInt64(segment, row_count, left, right, out)) {
+        return out;
+    }
+    if (TryFusedFloat(segment, row_count, left, right, out)) {
+        return out;
+    }
+    if (TryFusedDouble(segment, row_count, left, right, out)) {
+        return out;
+    }
+    return std::nullopt;
+}
+
+}  // namespace milvus::query
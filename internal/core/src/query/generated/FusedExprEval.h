@@ -0,0 +1,41 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+// Generated File
+// DO NOT EDIT
+#include <optional>
+
+#include "common/Types.h"
+#include "query/Expr.h"
+
+namespace milvus::segcore {
+class SegmentInternalInterface;
+}
+
+namespace milvus::query {
+
+// Shape-matched fused filter kernels for the hot leaf conjunctions
+// (term AND range) and (compare AND range), one specialization per scalar
+// type and comparison operator: the pair evaluates in a single pass over
+// the raw columns instead of two bitset-producing scans stitched with a
+// word AND. Returns nullopt when the pair does not match a generated
+// shape, mixes scalar types, or an involved field carries a scalar index
+// (whose lookup beats any scan); the caller then falls back to per-leaf
+// evaluation. Pure range pairs are not generated here: they take the
+// interval-folding path in LoweredExpr.
+std::optional<BitsetType>
+TryFusedConjunction(const segcore::SegmentInternalInterface& segment,
+                    int64_t row_count,
+                    const Expr& left,
+                    const Expr& right);
+
+}  // namespace milvus::query
@@ -11,12 +11,19 @@
 
 #include <deque>
 #include <optional>
-#include <unordered_set>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <string_view>
 #include <utility>
 #include <boost/variant.hpp>
 
+#include "common/BitsetUtils.h"
+#include "common/StringCompare.h"
+#include "common/ThreadPool.h"
 #include "query/ExprImpl.h"
+#include "query/LoweredExpr.h"
 #include "query/generated/ExecExprVisitor.h"
+#include "query/generated/FusedExprEval.h"
 #include "segcore/SegmentGrowingImpl.h"
 #include "query/Utils.h"
 #include "query/Relational.h"
@@ -41,11 +48,20 @@ class ExecExprVisitor : ExprVisitor {
         return std::move(res.value());
     }
 
+    int64_t
+    row_count() const {
+        return row_count_;
+    }
+
  public:
     template <typename T, typename IndexFunc, typename ElementFunc>
     auto
     ExecRangeVisitorImpl(FieldId field_id, IndexFunc func, ElementFunc element_func) -> BitsetType;
 
+    template <typename T, typename IndexFunc, typename ElementFunc, typename SkipFunc>
+    auto
+    ExecRangeVisitorImpl(FieldId field_id, IndexFunc func, ElementFunc element_func, SkipFunc skip_func) -> BitsetType;
+
     template <typename T>
     auto
     ExecUnaryRangeVisitorDispatcher(UnaryRangeExpr& expr_raw) -> BitsetType;
@@ -74,58 +90,190 @@ class ExecExprVisitor : ExprVisitor {
 };
 }  // namespace impl
 
+static LazyBitset
+ExecuteLazy(ExecExprVisitor& visitor, const segcore::SegmentInternalInterface& segment, Expr& expr);
+
 void
 ExecExprVisitor::visit(LogicalUnaryExpr& expr) {
-    using OpType = LogicalUnaryExpr::OpType;
-    auto child_res = call_child(*expr.child_);
-    BitsetType res = std::move(child_res);
-    switch (expr.op_type_) {
-        case OpType::LogicalNot: {
-            res.flip();
-            break;
-        }
-        default: {
-            PanicInfo("Invalid Unary Op");
-        }
-    }
+    auto res = ExecuteLazy(*this, segment_, expr).take();
     AssertInfo(res.size() == row_count_, "[ExecExprVisitor]Size of results not equal row count");
     bitset_opt_ = std::move(res);
 }
 
-void
-ExecExprVisitor::visit(LogicalBinaryExpr& expr) {
-    using OpType = LogicalBinaryExpr::OpType;
-    auto left = call_child(*expr.left_);
-    auto right = call_child(*expr.right_);
-    AssertInfo(left.size() == right.size(), "[ExecExprVisitor]Left size not equal to right size");
-    auto res = std::move(left);
-    switch (expr.op_type_) {
-        case OpType::LogicalAnd: {
-            res &= right;
-            break;
-        }
-        case OpType::LogicalOr: {
-            res |= right;
-            break;
+// Rough per-row cost of evaluating an expression, used only to order the
+// children of commutative boolean nodes: indexed leaves are nearly free,
+// numeric column scans cheap, string predicates and cross-field compares
+// expensive. The absolute scale is irrelevant.
+static int64_t
+EstimateExprCost(const Expr* expr, const segcore::SegmentInternalInterface& segment) {
+    auto field_cost = [&](FieldId field_id, DataType data_type) -> int64_t {
+        if (segment.HasIndex(field_id)) {
+            return 1;
+        }
+        return data_type == DataType::VARCHAR ? 8 : 2;
+    };
+    if (auto node = dynamic_cast<const TermExpr*>(expr)) {
+        return field_cost(node->field_id_, node->data_type_);
+    }
+    if (auto node = dynamic_cast<const UnaryRangeExpr*>(expr)) {
+        return field_cost(node->field_id_, node->data_type_);
+    }
+    if (auto node = dynamic_cast<const BinaryRangeExpr*>(expr)) {
+        return field_cost(node->field_id_, node->data_type_);
+    }
+    if (auto node = dynamic_cast<const BinaryArithOpEvalRangeExpr*>(expr)) {
+        return node->data_type_ == DataType::VARCHAR ? 8 : 3;
+    }
+    if (dynamic_cast<const CompareExpr*>(expr)) {
+        return 16;
+    }
+    if (auto node = dynamic_cast<const UnaryExprBase*>(expr)) {
+        return 1 + EstimateExprCost(node->child_.get(), segment);
+    }
+    if (auto node = dynamic_cast<const BinaryExprBase*>(expr)) {
+        return 1 + EstimateExprCost(node->left_.get(), segment) + EstimateExprCost(node->right_.get(), segment);
+    }
+    return 4;
+}
+
+// Evaluates the boolean spine of the tree onto LazyBitset: NOT only toggles
+// the deferred-complement flag and the binary connectives fold both
+// children's pending complements into their own word pass, so chained
+// boolean algebra costs one pass per connective instead of one per operator.
+// Anything that is not a logical node drops back to the regular dispatch,
+// and only the root of the spine materializes.
+static LazyBitset
+ExecuteLazy(ExecExprVisitor& visitor, const segcore::SegmentInternalInterface& segment, Expr& expr) {
+    if (auto unary = dynamic_cast<LogicalUnaryExpr*>(&expr)) {
+        AssertInfo(unary->op_type_ == LogicalUnaryExpr::OpType::LogicalNot, "Invalid Unary Op");
+        auto res = ExecuteLazy(visitor, segment, *unary->child_);
+        res.flip();
+        return res;
+    }
+    if (auto binary = dynamic_cast<LogicalBinaryExpr*>(&expr)) {
+        using OpType = LogicalBinaryExpr::OpType;
+        auto op = binary->op_type_;
+        auto first = binary->left_.get();
+        auto second = binary->right_.get();
+        // And/Or are commutative: run the cheaper (likelier more selective,
+        // index-backed) child first so the second one can be skipped entirely
+        // when the intermediate result already decides the conjunction
+        if (op == OpType::LogicalAnd || op == OpType::LogicalOr) {
+            if (EstimateExprCost(second, segment) < EstimateExprCost(first, segment)) {
+                std::swap(first, second);
+            }
         }
-        case OpType::LogicalXor: {
-            res ^= right;
-            break;
+        if (op == OpType::LogicalAnd) {
+            // pure range conjunctions fold to per-field intervals; the
+            // generated kernels then pick up the remaining hot leaf pairs
+            // (term ∧ range, compare ∧ range) as one fused pass instead of
+            // two scans. Either miss drops back to per-child evaluation.
+            if (auto lowered = TryExecLoweredExpr(segment, visitor.row_count(), expr)) {
+                return LazyBitset(std::move(lowered.value()));
+            }
+            if (auto fused = TryFusedConjunction(segment, visitor.row_count(), *first, *second)) {
+                return LazyBitset(std::move(fused.value()));
+            }
         }
-        case OpType::LogicalMinus: {
-            res -= right;
-            break;
+        auto first_res = ExecuteLazy(visitor, segment, *first);
+        if ((op == OpType::LogicalAnd && first_res.none()) || (op == OpType::LogicalOr && first_res.all())) {
+            return first_res;
         }
-        default: {
-            PanicInfo("Invalid Binary Op");
+        auto second_res = ExecuteLazy(visitor, segment, *second);
+        AssertInfo(first_res.size() == second_res.size(), "[ExecExprVisitor]Left size not equal to right size");
+        switch (op) {
+            case OpType::LogicalAnd: {
+                first_res.logical_and(std::move(second_res));
+                break;
+            }
+            case OpType::LogicalOr: {
+                first_res.logical_or(std::move(second_res));
+                break;
+            }
+            case OpType::LogicalXor: {
+                first_res.logical_xor(std::move(second_res));
+                break;
+            }
+            case OpType::LogicalMinus: {
+                first_res.logical_minus(std::move(second_res));
+                break;
+            }
+            default: {
+                PanicInfo("Invalid Binary Op");
+            }
         }
+        return first_res;
     }
+    return LazyBitset(visitor.call_child(expr));
+}
+
+void
+ExecExprVisitor::visit(LogicalBinaryExpr& expr) {
+    auto res = ExecuteLazy(*this, segment_, expr).take();
     AssertInfo(res.size() == row_count_, "[ExecExprVisitor]Size of results not equal row count");
     bitset_opt_ = std::move(res);
 }
 
+// evaluating a chunk is embarrassingly parallel; only fan out when there is
+// enough work to amortize the scheduling
+static constexpr int64_t kParallelEvalRowThreshold = 256 * 1024;
+
+// Probe structure for IN lists: small lists use a sorted array with binary
+// search; large arithmetic ones a flat power-of-2 open-addressing table,
+// whose single cache line per probe beats unordered_set's bucket chase on
+// the 5k-50k element lists seen in practice.
+template <typename T>
+class TermLookup {
+ public:
+    static constexpr size_t kHashThreshold = 64;
+
+    explicit TermLookup(const std::vector<T>& terms) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            if (terms.size() >= kHashThreshold) {
+                size_t capacity = 16;
+                while (capacity < terms.size() * 2) {
+                    capacity <<= 1;
+                }
+                mask_ = capacity - 1;
+                slots_.resize(capacity);
+                for (T term : terms) {
+                    auto pos = std::hash<T>{}(term) & mask_;
+                    while (slots_[pos].second && !(slots_[pos].first == term)) {
+                        pos = (pos + 1) & mask_;
+                    }
+                    slots_[pos] = {term, true};
+                }
+                return;
+            }
+        }
+        sorted_.assign(terms.begin(), terms.end());
+        std::sort(sorted_.begin(), sorted_.end());
+    }
+
+    bool
+    operator()(const T& value) const {
+        if (!slots_.empty()) {
+            auto pos = std::hash<T>{}(value) & mask_;
+            while (slots_[pos].second) {
+                if (slots_[pos].first == value) {
+                    return true;
+                }
+                pos = (pos + 1) & mask_;
+            }
+            return false;
+        }
+        return std::binary_search(sorted_.begin(), sorted_.end(), value);
+    }
+
+ private:
+    std::vector<T> sorted_;
+    std::vector<std::pair<T, bool>> slots_;
+    size_t mask_ = 0;
+};
+
+template <typename Container>
 static auto
-Assemble(const std::deque<BitsetType>& srcs) -> BitsetType {
+Assemble(const Container& srcs) -> BitsetType {
     BitsetType res;
 
     int64_t total_size = 0;
@@ -136,43 +284,104 @@ Assemble(const std::deque<BitsetType>& srcs) -> BitsetType {
 
     int64_t counter = 0;
     for (auto& chunk : srcs) {
-        for (int64_t i = 0; i < chunk.size(); ++i) {
-            res[counter + i] = chunk[i];
-        }
+        AppendBitset(res, counter, chunk);
         counter += chunk.size();
     }
     return res;
 }
 
+// what a chunk's zone map decides before any of its rows are read
+enum class ChunkVerdict { Scan, AllFalse, AllTrue };
+
+// for predicates whose truth cannot be derived from a min/max range
+static constexpr auto kNoChunkSkip = [](const auto& min, const auto& max) { return ChunkVerdict::Scan; };
+
 template <typename T, typename IndexFunc, typename ElementFunc>
 auto
 ExecExprVisitor::ExecRangeVisitorImpl(FieldId field_id, IndexFunc index_func, ElementFunc element_func) -> BitsetType {
+    return ExecRangeVisitorImpl<T>(field_id, index_func, element_func, kNoChunkSkip);
+}
+
+template <typename T, typename IndexFunc, typename ElementFunc, typename SkipFunc>
+auto
+ExecExprVisitor::ExecRangeVisitorImpl(FieldId field_id, IndexFunc index_func, ElementFunc element_func,
+                                      SkipFunc skip_func) -> BitsetType {
     auto& schema = segment_.get_schema();
     auto& field_meta = schema[field_id];
     auto indexing_barrier = segment_.num_chunk_index(field_id);
     auto size_per_chunk = segment_.size_per_chunk();
     auto num_chunk = upper_div(row_count_, size_per_chunk);
-    std::deque<BitsetType> results;
+    std::vector<BitsetType> results(num_chunk);
+
+    // read the query's token once up front: the tbb workers below do not
+    // carry this thread's task options, so the lambda captures it instead
+    auto cancellation = ScopedTaskOptions::Current().cancellation;
 
     using Index = scalar::ScalarIndex<T>;
     for (auto chunk_id = 0; chunk_id < indexing_barrier; ++chunk_id) {
+        cancellation.ThrowIfCancelled();
         const Index& indexing = segment_.chunk_scalar_index<T>(field_id, chunk_id);
         // NOTE: knowhere is not const-ready
         // This is a dirty workaround
         auto data = index_func(const_cast<Index*>(&indexing));
         AssertInfo(data->size() == size_per_chunk, "[ExecExprVisitor]Data size not equal to size_per_chunk");
-        results.emplace_back(std::move(*data));
+        results[chunk_id] = std::move(*data);
     }
-    for (auto chunk_id = indexing_barrier; chunk_id < num_chunk; ++chunk_id) {
+    // string chunks store rows as views into packed byte blocks, so scan
+    // them as string_view; the element funcs are generic over both
+    using ChunkDataType = std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+    auto eval_chunk = [&, element_func, skip_func](int64_t chunk_id) {
+        cancellation.ThrowIfCancelled();
         auto this_size = chunk_id == num_chunk - 1 ? row_count_ - chunk_id * size_per_chunk : size_per_chunk;
         BitsetType result(this_size);
-        auto chunk = segment_.chunk_data<T>(field_id, chunk_id);
-        const T* data = chunk.data();
-        for (int index = 0; index < this_size; ++index) {
-            result[index] = element_func(data[index]);
+        // consult the chunk's zone map first: a time-ordered or clustered
+        // column decides most chunks from min/max alone
+        ChunkDataType chunk_min{};
+        ChunkDataType chunk_max{};
+        auto verdict = ChunkVerdict::Scan;
+        if (segment_.chunk_min_max(field_id, chunk_id, chunk_min, chunk_max)) {
+            verdict = skip_func(chunk_min, chunk_max);
+        }
+        if (verdict == ChunkVerdict::AllTrue) {
+            result.set();
+        } else if (verdict == ChunkVerdict::Scan) {
+            bool scanned = false;
+            if constexpr (std::is_same_v<T, std::string>) {
+                // dictionary-encoded chunk: run the predicate once per
+                // distinct value, then stream the integer codes against the
+                // verdict table instead of touching any string bytes
+                if (auto dict = segment_.chunk_string_dict_view(field_id, chunk_id); dict.codes != nullptr) {
+                    auto num_codes = dict.chunk->dict_size();
+                    FixedVector<bool> verdicts(num_codes);
+                    for (int32_t code = 0; code < num_codes; ++code) {
+                        verdicts[code] = element_func(dict.chunk->dict_view(code));
+                    }
+                    EvalElementwise(dict.codes, this_size, result,
+                                    [&verdicts](int32_t code) { return verdicts[code]; });
+                    scanned = true;
+                }
+            }
+            if (!scanned) {
+                auto chunk = segment_.chunk_data<ChunkDataType>(field_id, chunk_id);
+                const ChunkDataType* data = chunk.data();
+                EvalElementwise(data, this_size, result, element_func);
+            }
         }
         AssertInfo(result.size() == this_size, "");
-        results.emplace_back(std::move(result));
+        results[chunk_id] = std::move(result);
+    };
+    auto scan_rows = (num_chunk - indexing_barrier) * size_per_chunk;
+    if (num_chunk - indexing_barrier > 1 && scan_rows >= kParallelEvalRowThreshold) {
+        tbb::parallel_for(tbb::blocked_range<int64_t>(indexing_barrier, num_chunk),
+                          [&](const tbb::blocked_range<int64_t>& range) {
+                              for (auto chunk_id = range.begin(); chunk_id != range.end(); ++chunk_id) {
+                                  eval_chunk(chunk_id);
+                              }
+                          });
+    } else {
+        for (auto chunk_id = indexing_barrier; chunk_id < num_chunk; ++chunk_id) {
+            eval_chunk(chunk_id);
+        }
     }
     auto final_result = Assemble(results);
     AssertInfo(final_result.size() == row_count_, "[ExecExprVisitor]Final result size not equal to row count");
@@ -191,35 +400,51 @@ ExecExprVisitor::ExecDataRangeVisitorImpl(FieldId field_id, IndexFunc index_func
     auto data_barrier = segment_.num_chunk_data(field_id);
     AssertInfo(std::max(data_barrier, indexing_barrier) == num_chunk,
                "max(data_barrier, index_barrier) not equal to num_chunk");
-    std::deque<BitsetType> results;
+    std::vector<BitsetType> results(std::max(data_barrier, indexing_barrier));
 
     // for growing segment, indexing_barrier will always less than data_barrier
     // so growing segment will always execute expr plan using raw data
     // if sealed segment has loaded raw data on this field, then index_barrier = 0 and data_barrier = 1
     // in this case, sealed segment execute expr plan using raw data
-    for (auto chunk_id = 0; chunk_id < data_barrier; ++chunk_id) {
+    using ChunkDataType = std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+    // captured, not re-read per chunk: the tbb workers below do not carry
+    // this thread's task options
+    auto cancellation = ScopedTaskOptions::Current().cancellation;
+    auto eval_chunk = [&, element_func](int64_t chunk_id) {
+        cancellation.ThrowIfCancelled();
         auto this_size = chunk_id == num_chunk - 1 ? row_count_ - chunk_id * size_per_chunk : size_per_chunk;
         BitsetType result(this_size);
-        auto chunk = segment_.chunk_data<T>(field_id, chunk_id);
-        const T* data = chunk.data();
-        for (int index = 0; index < this_size; ++index) {
-            result[index] = element_func(data[index]);
-        }
+        auto chunk = segment_.chunk_data<ChunkDataType>(field_id, chunk_id);
+        const ChunkDataType* data = chunk.data();
+        EvalElementwise(data, this_size, result, element_func);
         AssertInfo(result.size() == this_size, "[ExecExprVisitor]Chunk result size not equal to expected size");
-        results.emplace_back(std::move(result));
+        results[chunk_id] = std::move(result);
+    };
+    if (data_barrier > 1 && data_barrier * size_per_chunk >= kParallelEvalRowThreshold) {
+        tbb::parallel_for(tbb::blocked_range<int64_t>(0, data_barrier),
+                          [&](const tbb::blocked_range<int64_t>& range) {
+                              for (auto chunk_id = range.begin(); chunk_id != range.end(); ++chunk_id) {
+                                  eval_chunk(chunk_id);
+                              }
+                          });
+    } else {
+        for (auto chunk_id = 0; chunk_id < data_barrier; ++chunk_id) {
+            eval_chunk(chunk_id);
+        }
     }
 
     // if sealed segment has loaded scalar index for this field, then index_barrier = 1 and data_barrier = 0
     // in this case, sealed segment execute expr plan using scalar index
     using Index = scalar::ScalarIndex<T>;
     for (auto chunk_id = data_barrier; chunk_id < indexing_barrier; ++chunk_id) {
+        cancellation.ThrowIfCancelled();
         auto& indexing = segment_.chunk_scalar_index<T>(field_id, chunk_id);
         auto this_size = const_cast<Index*>(&indexing)->Count();
         BitsetType result(this_size);
         for (int offset = 0; offset < this_size; ++offset) {
             result[offset] = index_func(const_cast<Index*>(&indexing), offset);
         }
-        results.emplace_back(std::move(result));
+        results[chunk_id] = std::move(result);
     }
 
     auto final_result = Assemble(results);
@@ -236,36 +461,109 @@ ExecExprVisitor::ExecUnaryRangeVisitorDispatcher(UnaryRangeExpr& expr_raw) -> Bi
     using Index = scalar::ScalarIndex<T>;
     auto op = expr.op_type_;
     auto val = expr.value_;
+    // strings: the generic elem funcs below would re-run std::string's
+    // byte-at-a-time compare for every row, so route them through the
+    // prefixed SIMD comparator instead; numeric types keep the plain functor
+    auto make_elem_func = [&val](auto cmp) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            StringOperand operand(val);
+            if constexpr (std::is_same_v<decltype(cmp), std::equal_to<>>) {
+                return [operand = std::move(operand)](std::string_view x) { return PrefixedEquals(x, operand); };
+            } else if constexpr (std::is_same_v<decltype(cmp), std::not_equal_to<>>) {
+                return [operand = std::move(operand)](std::string_view x) { return !PrefixedEquals(x, operand); };
+            } else {
+                return [operand = std::move(operand), cmp](std::string_view x) {
+                    return cmp(PrefixedCompare(x, operand), 0);
+                };
+            }
+        } else {
+            return [val, cmp](const auto& x) { return cmp(x, val); };
+        }
+    };
     switch (op) {
         case OpType::Equal: {
             auto index_func = [val](Index* index) { return index->In(1, &val); };
-            auto elem_func = [val](T x) { return (x == val); };
-            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+            auto elem_func = make_elem_func(std::equal_to<>{});
+            auto skip_func = [val](const auto& min, const auto& max) {
+                if (val < min || max < val) {
+                    return ChunkVerdict::AllFalse;
+                }
+                if (min == max && min == val) {
+                    return ChunkVerdict::AllTrue;
+                }
+                return ChunkVerdict::Scan;
+            };
+            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func, skip_func);
         }
         case OpType::NotEqual: {
             auto index_func = [val](Index* index) { return index->NotIn(1, &val); };
-            auto elem_func = [val](T x) { return (x != val); };
-            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+            auto elem_func = make_elem_func(std::not_equal_to<>{});
+            auto skip_func = [val](const auto& min, const auto& max) {
+                if (val < min || max < val) {
+                    return ChunkVerdict::AllTrue;
+                }
+                if (min == max && min == val) {
+                    return ChunkVerdict::AllFalse;
+                }
+                return ChunkVerdict::Scan;
+            };
+            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func, skip_func);
         }
         case OpType::GreaterEqual: {
             auto index_func = [val](Index* index) { return index->Range(val, OpType::GreaterEqual); };
-            auto elem_func = [val](T x) { return (x >= val); };
-            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+            auto elem_func = make_elem_func(std::greater_equal<>{});
+            auto skip_func = [val](const auto& min, const auto& max) {
+                if (min >= val) {
+                    return ChunkVerdict::AllTrue;
+                }
+                if (max < val) {
+                    return ChunkVerdict::AllFalse;
+                }
+                return ChunkVerdict::Scan;
+            };
+            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func, skip_func);
         }
         case OpType::GreaterThan: {
             auto index_func = [val](Index* index) { return index->Range(val, OpType::GreaterThan); };
-            auto elem_func = [val](T x) { return (x > val); };
-            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+            auto elem_func = make_elem_func(std::greater<>{});
+            auto skip_func = [val](const auto& min, const auto& max) {
+                if (min > val) {
+                    return ChunkVerdict::AllTrue;
+                }
+                if (max <= val) {
+                    return ChunkVerdict::AllFalse;
+                }
+                return ChunkVerdict::Scan;
+            };
+            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func, skip_func);
         }
         case OpType::LessEqual: {
             auto index_func = [val](Index* index) { return index->Range(val, OpType::LessEqual); };
-            auto elem_func = [val](T x) { return (x <= val); };
-            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+            auto elem_func = make_elem_func(std::less_equal<>{});
+            auto skip_func = [val](const auto& min, const auto& max) {
+                if (max <= val) {
+                    return ChunkVerdict::AllTrue;
+                }
+                if (min > val) {
+                    return ChunkVerdict::AllFalse;
+                }
+                return ChunkVerdict::Scan;
+            };
+            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func, skip_func);
         }
         case OpType::LessThan: {
             auto index_func = [val](Index* index) { return index->Range(val, OpType::LessThan); };
-            auto elem_func = [val](T x) { return (x < val); };
-            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+            auto elem_func = make_elem_func(std::less<>{});
+            auto skip_func = [val](const auto& min, const auto& max) {
+                if (max < val) {
+                    return ChunkVerdict::AllTrue;
+                }
+                if (min >= val) {
+                    return ChunkVerdict::AllFalse;
+                }
+                return ChunkVerdict::Scan;
+            };
+            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func, skip_func);
         }
         case OpType::PrefixMatch: {
             auto index_func = [val](Index* index) {
@@ -274,8 +572,15 @@ ExecExprVisitor::ExecUnaryRangeVisitorDispatcher(UnaryRangeExpr& expr_raw) -> Bi
                 dataset->Set(scalar::PREFIX_VALUE, val);
                 return index->Query(std::move(dataset));
             };
-            auto elem_func = [val, op](T x) { return Match(x, val, op); };
-            return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+            if constexpr (std::is_same_v<T, std::string>) {
+                auto elem_func = [operand = StringOperand(val)](std::string_view x) {
+                    return PrefixedStartsWith(x, operand);
+                };
+                return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+            } else {
+                auto elem_func = [val, op](const auto& x) { return Match(x, val, op); };
+                return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+            }
         }
         // TODO: PostfixMatch
         default: {
@@ -416,18 +721,56 @@ ExecExprVisitor::ExecBinaryRangeVisitorDispatcher(BinaryRangeExpr& expr_raw) ->
     T val2 = expr.upper_value_;
 
     auto index_func = [=](Index* index) { return index->Range(val1, lower_inclusive, val2, upper_inclusive); };
+    // the chunk is decided without a scan when its [min, max] lies fully
+    // inside or fully outside the queried interval
     if (lower_inclusive && upper_inclusive) {
-        auto elem_func = [val1, val2](T x) { return (val1 <= x && x <= val2); };
-        return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+        auto elem_func = [val1, val2](const auto& x) { return (val1 <= x && x <= val2); };
+        auto skip_func = [val1, val2](const auto& min, const auto& max) {
+            if (val1 <= min && max <= val2) {
+                return ChunkVerdict::AllTrue;
+            }
+            if (max < val1 || val2 < min) {
+                return ChunkVerdict::AllFalse;
+            }
+            return ChunkVerdict::Scan;
+        };
+        return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func, skip_func);
     } else if (lower_inclusive && !upper_inclusive) {
-        auto elem_func = [val1, val2](T x) { return (val1 <= x && x < val2); };
-        return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+        auto elem_func = [val1, val2](const auto& x) { return (val1 <= x && x < val2); };
+        auto skip_func = [val1, val2](const auto& min, const auto& max) {
+            if (val1 <= min && max < val2) {
+                return ChunkVerdict::AllTrue;
+            }
+            if (max < val1 || val2 <= min) {
+                return ChunkVerdict::AllFalse;
+            }
+            return ChunkVerdict::Scan;
+        };
+        return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func, skip_func);
     } else if (!lower_inclusive && upper_inclusive) {
-        auto elem_func = [val1, val2](T x) { return (val1 < x && x <= val2); };
-        return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+        auto elem_func = [val1, val2](const auto& x) { return (val1 < x && x <= val2); };
+        auto skip_func = [val1, val2](const auto& min, const auto& max) {
+            if (val1 < min && max <= val2) {
+                return ChunkVerdict::AllTrue;
+            }
+            if (max <= val1 || val2 < min) {
+                return ChunkVerdict::AllFalse;
+            }
+            return ChunkVerdict::Scan;
+        };
+        return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func, skip_func);
     } else {
-        auto elem_func = [val1, val2](T x) { return (val1 < x && x < val2); };
-        return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
+        auto elem_func = [val1, val2](const auto& x) { return (val1 < x && x < val2); };
+        auto skip_func = [val1, val2](const auto& min, const auto& max) {
+            if (val1 < min && max < val2) {
+                return ChunkVerdict::AllTrue;
+            }
+            if (max <= val1 || val2 <= min) {
+                return ChunkVerdict::AllFalse;
+            }
+            return ChunkVerdict::Scan;
+        };
+        return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func, skip_func);
     }
 }
 #pragma clang diagnostic pop
@@ -595,8 +938,88 @@ ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op) -> BitsetTy
     AssertInfo(std::max(right_data_barrier, right_indexing_barrier) == num_chunk,
                "max(right_data_barrier, right_indexing_barrier) not equal to num_chunk");
 
+    // fused columnar kernel: when both sides are raw primitive columns the
+    // comparison runs directly over the two spans, 64 rows per bitset block,
+    // instead of boxing every element into a variant behind a std::function
+    auto typed_chunk_compare = [&](int64_t chunk_id, int64_t size, BitsetType& bitset) -> bool {
+        auto dispatch_primitive = [](DataType type, auto fn) -> bool {
+            switch (type) {
+                case DataType::BOOL:
+                    fn(bool());
+                    return true;
+                case DataType::INT8:
+                    fn(int8_t());
+                    return true;
+                case DataType::INT16:
+                    fn(int16_t());
+                    return true;
+                case DataType::INT32:
+                    fn(int32_t());
+                    return true;
+                case DataType::INT64:
+                    fn(int64_t());
+                    return true;
+                case DataType::FLOAT:
+                    fn(float());
+                    return true;
+                case DataType::DOUBLE:
+                    fn(double());
+                    return true;
+                default:
+                    // varchar keeps the type-erased path
+                    return false;
+            }
+        };
+        // varchar against varchar on raw chunks: compare the string_view
+        // spans directly with the SIMD first-difference comparator and feed
+        // the three-way result into the same functor. Only the relational
+        // functors map onto a three-way compare; PrefixMatch stays on the
+        // type-erased path below.
+        constexpr bool is_relational =
+            std::is_same_v<Op, std::equal_to<>> || std::is_same_v<Op, std::not_equal_to<>> ||
+            std::is_same_v<Op, std::greater_equal<>> || std::is_same_v<Op, std::greater<>> ||
+            std::is_same_v<Op, std::less_equal<>> || std::is_same_v<Op, std::less<>>;
+        if constexpr (is_relational) {
+            if (expr.left_data_type_ == DataType::VARCHAR && expr.right_data_type_ == DataType::VARCHAR &&
+                segment_.chunk_string_dict_view(expr.left_field_id_, chunk_id).codes == nullptr &&
+                segment_.chunk_string_dict_view(expr.right_field_id_, chunk_id).codes == nullptr) {
+                auto left_data = segment_.chunk_data<std::string_view>(expr.left_field_id_, chunk_id).data();
+                auto right_data = segment_.chunk_data<std::string_view>(expr.right_field_id_, chunk_id).data();
+                bitset.resize(size);
+                EvalBinaryElementwise(left_data, right_data, size, bitset,
+                                      [&op](const std::string_view& a, const std::string_view& b) {
+                                          return op(CompareStringViews(a, b), 0);
+                                      });
+                return true;
+            }
+        }
+        bool fused = false;
+        dispatch_primitive(expr.left_data_type_, [&](auto left_tag) {
+            dispatch_primitive(expr.right_data_type_, [&](auto right_tag) {
+                using TL = decltype(left_tag);
+                using TR = decltype(right_tag);
+                auto left_data = segment_.chunk_data<TL>(expr.left_field_id_, chunk_id).data();
+                auto right_data = segment_.chunk_data<TR>(expr.right_field_id_, chunk_id).data();
+                bitset.resize(size);
+                EvalBinaryElementwise(left_data, right_data, size, bitset,
+                                      [&op](const TL& a, const TR& b) { return op(a, b); });
+                fused = true;
+            });
+        });
+        return fused;
+    };
+
+    auto cancellation = ScopedTaskOptions::Current().cancellation;
     for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
+        cancellation.ThrowIfCancelled();
         auto size = chunk_id == num_chunk - 1 ? row_count_ - chunk_id * size_per_chunk : size_per_chunk;
+        if (chunk_id < left_data_barrier && chunk_id < right_data_barrier) {
+            BitsetType bitset;
+            if (typed_chunk_compare(chunk_id, size, bitset)) {
+                bitsets.emplace_back(std::move(bitset));
+                continue;
+            }
+        }
         auto getChunkData = [&, chunk_id](DataType type, FieldId field_id,
                                           int64_t data_barrier) -> std::function<const number(int)> {
             switch (type) {
@@ -672,8 +1095,14 @@ ExecExprVisitor::ExecCompareExprDispatcher(CompareExpr& expr, Op op) -> BitsetTy
                 }
                 case DataType::VARCHAR: {
                     if (chunk_id < data_barrier) {
-                        auto chunk_data = segment_.chunk_data<std::string>(field_id, chunk_id).data();
-                        return [chunk_data](int i) -> const number { return chunk_data[i]; };
+                        // dictionary-encoded chunks have no view span; decode
+                        // each probed row through its code
+                        if (auto dict = segment_.chunk_string_dict_view(field_id, chunk_id); dict.codes != nullptr) {
+                            return [dict](int i) -> const number { return std::string(dict.chunk->dict_view(dict.codes[i])); };
+                        }
+                        auto chunk_data = segment_.chunk_data<std::string_view>(field_id, chunk_id).data();
+                        // the variant wants an owning string
+                        return [chunk_data](int i) -> const number { return std::string(chunk_data[i]); };
                     } else {
                         // for case, sealed segment has loaded index for scalar field instead of raw data
                         auto& indexing = segment_.chunk_scalar_index<std::string>(field_id, chunk_id);
@@ -796,21 +1225,18 @@ ExecExprVisitor::ExecTermVisitorImpl(TermExpr& expr_raw) -> BitsetType {
     }
 
     // not use pk index
-    std::deque<BitsetType> bitsets;
-    auto size_per_chunk = segment_.size_per_chunk();
-    auto num_chunk = upper_div(row_count_, size_per_chunk);
-    std::unordered_set<T> term_set(expr.terms_.begin(), expr.terms_.end());
-    for (int64_t chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
-        Span<T> chunk = segment_.chunk_data<T>(field_id, chunk_id);
-        auto chunk_data = chunk.data();
-        auto size = (chunk_id == num_chunk - 1) ? row_count_ - chunk_id * size_per_chunk : size_per_chunk;
-        BitsetType bitset(size);
-        for (int i = 0; i < size; ++i) {
-            bitset[i] = (term_set.find(chunk_data[i]) != term_set.end());
-        }
-        bitsets.emplace_back(std::move(bitset));
-    }
-    auto final_result = Assemble(bitsets);
+    using Index = scalar::ScalarIndex<T>;
+    const auto& terms = expr.terms_;
+    auto n = terms.size();
+    TermLookup<T> lookup(terms);
+    // flat copy for index pushdown (std::vector<bool> has no data())
+    FixedVector<T> terms_flat(terms.begin(), terms.end());
+
+    // chunks with a small index answer the whole IN list in one call
+    auto index_func = [&terms_flat, n](Index* index) { return index->In(n, terms_flat.data()); };
+    auto elem_func = [&lookup](T x) { return lookup(x); };
+
+    auto final_result = ExecRangeVisitorImpl<T>(field_id, index_func, elem_func);
     AssertInfo(final_result.size() == row_count_, "[ExecExprVisitor]Size of results not equal row count");
     return final_result;
 }
@@ -827,13 +1253,14 @@ ExecExprVisitor::ExecTermVisitorImpl<std::string>(TermExpr& expr_raw) -> BitsetT
     using Index = scalar::ScalarIndex<T>;
     const auto& terms = expr.terms_;
     auto n = terms.size();
-    std::unordered_set<T> term_set(expr.terms_.begin(), expr.terms_.end());
+    // sorted array + binary search: unlike unordered_set, probing it with the
+    // string_views handed out by the chunks needs no owning-string temporary
+    std::vector<T> sorted_terms(terms.begin(), terms.end());
+    std::sort(sorted_terms.begin(), sorted_terms.end());
 
     auto index_func = [&terms, n](Index* index) { return index->In(n, terms.data()); };
-    auto elem_func = [&terms, &term_set](T x) {
-        //// terms has already been sorted.
-        // return std::binary_search(terms.begin(), terms.end(), x);
-        return term_set.find(x) != term_set.end();
+    auto elem_func = [&sorted_terms](std::string_view x) {
+        return std::binary_search(sorted_terms.begin(), sorted_terms.end(), x);
     };
 
     return ExecRangeVisitorImpl<T>(expr.field_id_, index_func, elem_func);
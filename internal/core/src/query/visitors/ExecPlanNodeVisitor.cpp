@@ -9,8 +9,14 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+#include <numeric>
 #include <utility>
 
+#include "common/Metrics.h"
+#include "common/ThreadPool.h"
+#include "query/ExprFingerprint.h"
+#include "query/LoweredExpr.h"
 #include "query/PlanImpl.h"
 #include "query/generated/ExecPlanNodeVisitor.h"
 #include "query/generated/ExecExprVisitor.h"
@@ -55,6 +61,38 @@ class ExecPlanNodeVisitor : PlanNodeVisitor {
 };
 }  // namespace impl
 
+// Evaluates a predicate, serving repeated ones from the segment's filter
+// cache when it has one (sealed segments). Only the raw predicate bitset is
+// cached, so a hit still goes through the timestamp and delete masking that
+// follows at the call sites; the active count participates in the key
+// because it sizes the result.
+static BitsetType
+ExecutePredicate(const segcore::SegmentInternalInterface& segment,
+                 Expr& expr,
+                 int64_t active_count,
+                 Timestamp timestamp) {
+    auto key = FingerprintExpr(expr, segment.get_schema());
+    BitsetType bitset;
+    if (key.has_value()) {
+        key->append(reinterpret_cast<const char*>(&active_count), sizeof(active_count));
+        if (segment.get_cached_filter(key.value(), bitset)) {
+            return bitset;
+        }
+    }
+    // simple conjunctions of range leaves run through the lowered,
+    // devirtualized form; everything else through the visitor tree
+    auto lowered_res = TryExecLoweredExpr(segment, active_count, expr);
+    if (lowered_res.has_value()) {
+        bitset = std::move(lowered_res.value());
+    } else {
+        bitset = ExecExprVisitor(segment, active_count, timestamp).call_child(expr);
+    }
+    if (key.has_value()) {
+        segment.cache_filter(key.value(), bitset);
+    }
+    return bitset;
+}
+
 static SearchResult
 empty_search_result(int64_t num_queries, SearchInfo& search_info) {
     SearchResult final_result;
@@ -88,23 +126,61 @@ ExecPlanNodeVisitor::VectorVisitorImpl(VectorPlanNode& node) {
         return;
     }
 
-    BitsetType bitset_holder;
-    if (node.predicate_.has_value()) {
-        bitset_holder = ExecExprVisitor(*segment, active_count, timestamp_).call_child(*node.predicate_.value());
-        bitset_holder.flip();
-    } else {
-        bitset_holder.resize(active_count, false);
+    // clean-segment fast path: no predicate and every row visible means no
+    // bitset needs to exist at all; the null view flows end to end and
+    // knowhere skips per-row testing entirely
+    if (!node.predicate_.has_value() && segment->all_visible_at(timestamp_)) {
+        search_result.profile_.rows_scanned_ = active_count;
+        static auto& selectivity_hist = MetricsRegistry::GetInstance().GetHistogram("segcore.search.selectivity_pct");
+        selectivity_hist.Observe(100);
+        {
+            ProfileTimer timer(search_result.profile_.vector_search_ns_);
+            auto status =
+                segment->vector_search(node.search_info_, src_data, num_queries, timestamp_, BitsetView(), search_result);
+            // the status channel ends here: a failed search surfaces to the
+            // C boundary as one exception, converted to a CStatus as before
+            AssertInfo(status.ok(), status.ToString());
+        }
+        search_result_opt_ = std::move(search_result);
+        return;
     }
-    segment->mask_with_timestamps(bitset_holder, timestamp_);
 
-    segment->mask_with_delete(bitset_holder, active_count, timestamp_);
+    // the masking bitset is query-lifetime scratch sized to the segment's
+    // active count; it cycles through the thread-local pool so back-to-back
+    // queries reuse the same buffer
+    BitsetType bitset_holder = ScratchBuffers::Local().TakeBitset();
+    {
+        ProfileTimer timer(search_result.profile_.predicate_ns_);
+        if (node.predicate_.has_value()) {
+            bitset_holder = ExecutePredicate(*segment, *node.predicate_.value(), active_count, timestamp_);
+            bitset_holder.flip();
+        } else {
+            bitset_holder.resize(active_count, false);
+        }
+        segment->mask_with_visibility(bitset_holder, active_count, timestamp_);
+    }
+    // phase boundary: a query abandoned during filtering skips the vector
+    // scan entirely
+    ScopedTaskOptions::Current().cancellation.ThrowIfCancelled();
+    search_result.profile_.rows_scanned_ = active_count;
+    search_result.profile_.rows_filtered_ = bitset_holder.count();
+    // fraction of the segment the vector scan will actually see, in percent
+    static auto& selectivity_hist = MetricsRegistry::GetInstance().GetHistogram("segcore.search.selectivity_pct");
+    selectivity_hist.Observe((active_count - search_result.profile_.rows_filtered_) * 100 / active_count);
     // if bitset_holder is all 1's, we got empty result
     if (bitset_holder.count() == bitset_holder.size()) {
         search_result_opt_ = empty_search_result(num_queries, node.search_info_);
+        ScratchBuffers::Local().Recycle(std::move(bitset_holder));
         return;
     }
     BitsetView final_view = bitset_holder;
-    segment->vector_search(node.search_info_, src_data, num_queries, timestamp_, final_view, search_result);
+    {
+        ProfileTimer timer(search_result.profile_.vector_search_ns_);
+        auto status = segment->vector_search(node.search_info_, src_data, num_queries, timestamp_, final_view,
+                                             search_result);
+        AssertInfo(status.ok(), status.ToString());
+    }
+    ScratchBuffers::Local().Recycle(std::move(bitset_holder));
 
     search_result_opt_ = std::move(search_result);
 }
@@ -123,28 +199,62 @@ ExecPlanNodeVisitor::visit(RetrievePlanNode& node) {
         return;
     }
 
-    BitsetType bitset_holder;
+    // clean-segment fast path: with no predicate and every row visible the
+    // result is just the leading offsets, no bitset or scan required
+    if (node.predicate_ == nullptr && segment->all_visible_at(timestamp_)) {
+        auto count = node.limit_ >= 0 ? std::min(node.limit_, active_count) : active_count;
+        retrieve_result.result_offsets_.resize(count);
+        std::iota(retrieve_result.result_offsets_.begin(), retrieve_result.result_offsets_.end(), int64_t(0));
+        retrieve_result_opt_ = std::move(retrieve_result);
+        return;
+    }
+
+    BitsetType bitset_holder = ScratchBuffers::Local().TakeBitset();
     if (node.predicate_ != nullptr) {
-        bitset_holder = ExecExprVisitor(*segment, active_count, timestamp_).call_child(*(node.predicate_));
+        bitset_holder = ExecutePredicate(*segment, *node.predicate_, active_count, timestamp_);
         bitset_holder.flip();
     }
 
-    segment->mask_with_timestamps(bitset_holder, timestamp_);
-
-    segment->mask_with_delete(bitset_holder, active_count, timestamp_);
+    segment->mask_with_visibility(bitset_holder, active_count, timestamp_);
     // if bitset_holder is all 1's, we got empty result
     if (bitset_holder.count() == bitset_holder.size()) {
         retrieve_result_opt_ = std::move(retrieve_result);
+        ScratchBuffers::Local().Recycle(std::move(bitset_holder));
         return;
     }
 
     BitsetView final_view = bitset_holder;
-    auto seg_offsets = segment->search_ids(final_view, timestamp_);
+    auto seg_offsets = segment->search_ids(final_view, timestamp_, node.limit_);
     retrieve_result.result_offsets_.assign((int64_t*)seg_offsets.data(),
                                            (int64_t*)seg_offsets.data() + seg_offsets.size());
+    ScratchBuffers::Local().Recycle(std::move(bitset_holder));
     retrieve_result_opt_ = std::move(retrieve_result);
 }
 
+int64_t
+ExecCount(const segcore::SegmentInternalInterface& segment, const RetrievePlanNode& node, Timestamp timestamp) {
+    auto active_count = segment.get_active_count(timestamp);
+    if (active_count == 0) {
+        return 0;
+    }
+    // clean-segment fast path: nothing filters, so the count is the barrier
+    if (node.predicate_ == nullptr && segment.all_visible_at(timestamp)) {
+        return active_count;
+    }
+    BitsetType bitset_holder = ScratchBuffers::Local().TakeBitset();
+    if (node.predicate_ != nullptr) {
+        bitset_holder = ExecutePredicate(segment, *node.predicate_, active_count, timestamp);
+        bitset_holder.flip();
+    } else {
+        bitset_holder.resize(active_count, false);
+    }
+    segment.mask_with_visibility(bitset_holder, active_count, timestamp);
+    // the holder marks excluded rows, so the survivors are the clear bits
+    auto count = static_cast<int64_t>(bitset_holder.size() - bitset_holder.count());
+    ScratchBuffers::Local().Recycle(std::move(bitset_holder));
+    return count;
+}
+
 void
 ExecPlanNodeVisitor::visit(FloatVectorANNS& node) {
     VectorVisitorImpl<FloatVector>(node);
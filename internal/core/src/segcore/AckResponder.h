@@ -12,9 +12,9 @@
 #pragma once
 
 #include <atomic>
-#include <mutex>
-#include <set>
-#include <shared_mutex>
+#include <cstdint>
+
+#include <tbb/concurrent_hash_map.h>
 
 namespace milvus::segcore {
 
@@ -40,41 +40,50 @@ example() {
 }
 #endif
 
+// Ack tracking is on the ingest hot path (once per insert batch per field),
+// so the contiguous watermark lives in one atomic advanced by CAS; only
+// ranges that arrive out of order touch the parked map, and readers never
+// take any lock.
 class AckResponder {
  public:
     // specify that segment [seg_begin, seg_end) has been processed
     // WARN: segments shouldn't overlap
     void
     AddSegment(int64_t seg_begin, int64_t seg_end) {
-        std::lock_guard lck(mutex_);
-        fetch_and_flip(seg_end);
-        auto old_begin = fetch_and_flip(seg_begin);
-        if (old_begin) {
-            minimum_ = *acks_.begin();
+        // fast path: the range extends the contiguous prefix directly
+        auto expected = seg_begin;
+        if (!ack_.compare_exchange_strong(expected, seg_end)) {
+            parked_.insert({seg_begin, seg_end});
+        }
+        // drain parked ranges that have become contiguous; inserting before
+        // draining guarantees whoever observes the gap closed also sees the
+        // parked entry, so no range is stranded
+        while (true) {
+            auto cur = ack_.load();
+            ParkedMap::accessor entry;
+            if (!parked_.find(entry, cur)) {
+                break;
+            }
+            // the accessor is exclusive, so at most one thread applies this
+            // entry; ranges don't overlap, so nobody else can move ack_ off
+            // `cur` while we hold it
+            if (ack_.compare_exchange_strong(cur, entry->second)) {
+                parked_.erase(entry);
+            }
         }
     }
 
     // return ack
     int64_t
     GetAck() const {
-        return minimum_;
+        return ack_.load();
     }
 
  private:
-    bool
-    fetch_and_flip(int64_t endpoint) {
-        if (acks_.count(endpoint)) {
-            acks_.erase(endpoint);
-            return true;
-        } else {
-            acks_.insert(endpoint);
-            return false;
-        }
-    }
+    using ParkedMap = tbb::concurrent_hash_map<int64_t, int64_t>;
 
- private:
-    std::shared_mutex mutex_;
-    std::set<int64_t> acks_ = {0};
-    std::atomic<int64_t> minimum_ = 0;
+    std::atomic<int64_t> ack_ = 0;
+    // seg_begin => seg_end of ranges waiting for the prefix to catch up
+    ParkedMap parked_;
 };
 }  // namespace milvus::segcore
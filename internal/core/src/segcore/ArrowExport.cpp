@@ -0,0 +1,152 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/ArrowExport.h"
+
+#include <string>
+#include <vector>
+
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include <arrow/type.h>
+#include <arrow/util/key_value_metadata.h>
+
+#include "common/Types.h"
+#include "exceptions/EasyAssert.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+void
+OkOrThrow(const arrow::Status& status) {
+    AssertInfo(status.ok(), "arrow export failed: " + status.ToString());
+}
+
+std::shared_ptr<arrow::Array>
+FinishOrThrow(arrow::ArrayBuilder& builder) {
+    std::shared_ptr<arrow::Array> array;
+    OkOrThrow(builder.Finish(&array));
+    return array;
+}
+
+std::shared_ptr<arrow::Array>
+ConvertColumn(const DataArray& field_data, arrow::MemoryPool* pool) {
+    switch (DataType(field_data.type())) {
+        case DataType::BOOL: {
+            arrow::BooleanBuilder builder(pool);
+            auto& src = field_data.scalars().bool_data().data();
+            OkOrThrow(builder.Reserve(src.size()));
+            for (auto v : src) {
+                builder.UnsafeAppend(v);
+            }
+            return FinishOrThrow(builder);
+        }
+        case DataType::INT8: {
+            arrow::Int8Builder builder(pool);
+            auto& src = field_data.scalars().int_data().data();
+            OkOrThrow(builder.Reserve(src.size()));
+            for (auto v : src) {
+                builder.UnsafeAppend(static_cast<int8_t>(v));
+            }
+            return FinishOrThrow(builder);
+        }
+        case DataType::INT16: {
+            arrow::Int16Builder builder(pool);
+            auto& src = field_data.scalars().int_data().data();
+            OkOrThrow(builder.Reserve(src.size()));
+            for (auto v : src) {
+                builder.UnsafeAppend(static_cast<int16_t>(v));
+            }
+            return FinishOrThrow(builder);
+        }
+        case DataType::INT32: {
+            arrow::Int32Builder builder(pool);
+            auto& src = field_data.scalars().int_data().data();
+            OkOrThrow(builder.AppendValues(src.data(), src.size()));
+            return FinishOrThrow(builder);
+        }
+        case DataType::INT64: {
+            arrow::Int64Builder builder(pool);
+            auto& src = field_data.scalars().long_data().data();
+            OkOrThrow(builder.AppendValues(src.data(), src.size()));
+            return FinishOrThrow(builder);
+        }
+        case DataType::FLOAT: {
+            arrow::FloatBuilder builder(pool);
+            auto& src = field_data.scalars().float_data().data();
+            OkOrThrow(builder.AppendValues(src.data(), src.size()));
+            return FinishOrThrow(builder);
+        }
+        case DataType::DOUBLE: {
+            arrow::DoubleBuilder builder(pool);
+            auto& src = field_data.scalars().double_data().data();
+            OkOrThrow(builder.AppendValues(src.data(), src.size()));
+            return FinishOrThrow(builder);
+        }
+        case DataType::VARCHAR: {
+            arrow::StringBuilder builder(pool);
+            auto& src = field_data.scalars().string_data().data();
+            for (auto& str : src) {
+                OkOrThrow(builder.Append(str));
+            }
+            return FinishOrThrow(builder);
+        }
+        case DataType::VECTOR_FLOAT: {
+            auto dim = field_data.vectors().dim();
+            AssertInfo(dim > 0, "vector field has no dim");
+            auto& src = field_data.vectors().float_vector().data();
+            arrow::FloatBuilder child(pool);
+            OkOrThrow(child.AppendValues(src.data(), src.size()));
+            auto values = FinishOrThrow(child);
+            return std::make_shared<arrow::FixedSizeListArray>(arrow::fixed_size_list(arrow::float32(), dim),
+                                                               src.size() / dim, values);
+        }
+        case DataType::VECTOR_BINARY: {
+            auto dim = field_data.vectors().dim();
+            AssertInfo(dim > 0 && dim % 8 == 0, "binary vector dim must be a positive multiple of 8");
+            auto width = static_cast<int32_t>(dim / 8);
+            auto& bytes = field_data.vectors().binary_vector();
+            arrow::FixedSizeBinaryBuilder builder(arrow::fixed_size_binary(width), pool);
+            auto num_rows = static_cast<int64_t>(bytes.size()) / width;
+            OkOrThrow(builder.Reserve(num_rows));
+            for (int64_t i = 0; i < num_rows; ++i) {
+                builder.UnsafeAppend(reinterpret_cast<const uint8_t*>(bytes.data()) + i * width);
+            }
+            return FinishOrThrow(builder);
+        }
+        default: {
+            PanicInfo("unsupported data type for arrow export");
+        }
+    }
+}
+
+}  // namespace
+
+std::shared_ptr<arrow::RecordBatch>
+RetrieveResultsToArrow(const proto::segcore::RetrieveResults& results, arrow::MemoryPool* pool) {
+    auto num_rows = static_cast<int64_t>(results.offset_size());
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    std::vector<std::shared_ptr<arrow::Array>> columns;
+    fields.reserve(results.fields_data_size());
+    columns.reserve(results.fields_data_size());
+    for (auto& field_data : results.fields_data()) {
+        auto column = ConvertColumn(field_data, pool);
+        AssertInfo(column->length() == num_rows, "arrow column row count mismatch for field " +
+                                                     std::to_string(field_data.field_id()));
+        auto metadata = arrow::key_value_metadata({"field_id"}, {std::to_string(field_data.field_id())});
+        fields.push_back(arrow::field(field_data.field_name(), column->type(), /*nullable=*/false, metadata));
+        columns.push_back(std::move(column));
+    }
+    return arrow::RecordBatch::Make(arrow::schema(std::move(fields)), num_rows, std::move(columns));
+}
+
+}  // namespace milvus::segcore
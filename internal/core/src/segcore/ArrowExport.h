@@ -0,0 +1,32 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <memory>
+
+#include <arrow/record_batch.h>
+
+#include "pb/segcore.pb.h"
+
+namespace milvus::segcore {
+
+// Builds an arrow RecordBatch holding the retrieve results' columns, one
+// field per column in plan order, allocated from the given pool. Each
+// column's field metadata carries its "field_id" so consumers need not
+// match by name. This is the single copy on the arrow retrieve path: the
+// batch is then handed across the C API via the Arrow C data interface
+// with no serialization, and its release callback returns the buffers to
+// the pool.
+std::shared_ptr<arrow::RecordBatch>
+RetrieveResultsToArrow(const proto::segcore::RetrieveResults& results, arrow::MemoryPool* pool);
+
+}  // namespace milvus::segcore
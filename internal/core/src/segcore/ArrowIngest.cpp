@@ -0,0 +1,131 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/ArrowIngest.h"
+
+#include <arrow/array.h>
+#include <arrow/type.h>
+
+#include "exceptions/EasyAssert.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+void
+CheckArrowType(const arrow::Array& array, arrow::Type::type expected, FieldId field_id) {
+    AssertInfo(array.type_id() == expected, "arrow column type mismatch for field " + std::to_string(field_id.get()) +
+                                                ": got " + array.type()->ToString());
+}
+
+}  // namespace
+
+std::vector<InsertColumnView>
+MakeInsertColumns(const arrow::RecordBatch& batch, const Schema& schema, ArrowColumnScratch& scratch) {
+    auto num_rows = batch.num_rows();
+    std::vector<InsertColumnView> columns;
+    columns.reserve(batch.num_columns());
+    for (int i = 0; i < batch.num_columns(); ++i) {
+        auto& arrow_field = *batch.schema()->field(i);
+        auto metadata = arrow_field.metadata();
+        AssertInfo(metadata != nullptr && metadata->Contains("field_id"),
+                   "arrow column '" + arrow_field.name() + "' carries no field_id metadata");
+        auto field_id = FieldId(std::stoll(metadata->Get("field_id").ValueOrDie()));
+        auto& field_meta = schema[field_id];
+        auto array = batch.column(i);
+        AssertInfo(array->length() == num_rows, "arrow column row count mismatch for field " +
+                                                    std::to_string(field_id.get()));
+        AssertInfo(array->null_count() == 0,
+                   "arrow column for field " + std::to_string(field_id.get()) + " contains nulls");
+
+        InsertColumnView column{field_id};
+        switch (field_meta.get_data_type()) {
+            case DataType::BOOL: {
+                // arrow packs bools to bits; the chunks store one byte per
+                // row, so this is the one column type that cannot alias
+                CheckArrowType(*array, arrow::Type::BOOL, field_id);
+                auto& typed = static_cast<const arrow::BooleanArray&>(*array);
+                auto& bytes = scratch.bool_bytes.emplace_back(num_rows);
+                for (int64_t row = 0; row < num_rows; ++row) {
+                    bytes[row] = typed.Value(row) ? 1 : 0;
+                }
+                column.data = bytes.data();
+                break;
+            }
+            case DataType::INT8: {
+                CheckArrowType(*array, arrow::Type::INT8, field_id);
+                column.data = static_cast<const arrow::Int8Array&>(*array).raw_values();
+                break;
+            }
+            case DataType::INT16: {
+                CheckArrowType(*array, arrow::Type::INT16, field_id);
+                column.data = static_cast<const arrow::Int16Array&>(*array).raw_values();
+                break;
+            }
+            case DataType::INT32: {
+                CheckArrowType(*array, arrow::Type::INT32, field_id);
+                column.data = static_cast<const arrow::Int32Array&>(*array).raw_values();
+                break;
+            }
+            case DataType::INT64: {
+                CheckArrowType(*array, arrow::Type::INT64, field_id);
+                column.data = static_cast<const arrow::Int64Array&>(*array).raw_values();
+                break;
+            }
+            case DataType::FLOAT: {
+                CheckArrowType(*array, arrow::Type::FLOAT, field_id);
+                column.data = static_cast<const arrow::FloatArray&>(*array).raw_values();
+                break;
+            }
+            case DataType::DOUBLE: {
+                CheckArrowType(*array, arrow::Type::DOUBLE, field_id);
+                column.data = static_cast<const arrow::DoubleArray&>(*array).raw_values();
+                break;
+            }
+            case DataType::VARCHAR: {
+                CheckArrowType(*array, arrow::Type::STRING, field_id);
+                auto& typed = static_cast<const arrow::StringArray&>(*array);
+                auto& views = scratch.string_views.emplace_back(num_rows);
+                for (int64_t row = 0; row < num_rows; ++row) {
+                    auto value = typed.GetView(row);
+                    views[row] = std::string_view(value.data(), value.size());
+                }
+                column.views = views.data();
+                break;
+            }
+            case DataType::VECTOR_FLOAT: {
+                CheckArrowType(*array, arrow::Type::FIXED_SIZE_LIST, field_id);
+                auto& typed = static_cast<const arrow::FixedSizeListArray&>(*array);
+                AssertInfo(typed.value_length() == field_meta.get_dim(),
+                           "float vector dim mismatch for field " + std::to_string(field_id.get()));
+                auto values = std::static_pointer_cast<arrow::FloatArray>(typed.values());
+                CheckArrowType(*values, arrow::Type::FLOAT, field_id);
+                column.data = values->raw_values() + typed.value_offset(0);
+                break;
+            }
+            case DataType::VECTOR_BINARY: {
+                CheckArrowType(*array, arrow::Type::FIXED_SIZE_BINARY, field_id);
+                auto& typed = static_cast<const arrow::FixedSizeBinaryArray&>(*array);
+                AssertInfo(typed.byte_width() * 8 == field_meta.get_dim(),
+                           "binary vector dim mismatch for field " + std::to_string(field_id.get()));
+                column.data = num_rows > 0 ? typed.GetValue(0) : nullptr;
+                break;
+            }
+            default: {
+                PanicInfo("unsupported data type for arrow ingest");
+            }
+        }
+        columns.push_back(column);
+    }
+    return columns;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,42 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <deque>
+#include <string_view>
+#include <vector>
+
+#include <arrow/record_batch.h>
+
+#include "common/Schema.h"
+#include "segcore/SegmentGrowing.h"
+
+namespace milvus::segcore {
+
+// Buffers the column views may point into when the arrow layout differs
+// from the segment's (bit-packed bools become one byte per row, string
+// columns get one view per row into the arrow value buffer). Must outlive
+// the Insert call the views feed.
+struct ArrowColumnScratch {
+    std::deque<std::vector<uint8_t>> bool_bytes;
+    std::deque<std::vector<std::string_view>> string_views;
+};
+
+// Maps one imported record batch to insert columns, matching arrow columns
+// to schema fields by their "field_id" metadata (the same convention the
+// arrow export uses). Fixed-width columns are zero-copy pointers into the
+// arrow buffers; nothing is re-encoded. Nullable columns are rejected —
+// the insert path has no null representation.
+std::vector<InsertColumnView>
+MakeInsertColumns(const arrow::RecordBatch& batch, const Schema& schema, ArrowColumnScratch& scratch);
+
+}  // namespace milvus::segcore
@@ -0,0 +1,378 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "common/Numa.h"
+#include "exceptions/EasyAssert.h"
+
+namespace milvus::segcore {
+
+// Bump allocator for growing-segment chunks. Chunks are allocated once, never
+// resized and all die together with the segment, so individual frees are
+// pointless: allocation is a pointer bump inside a large slab and the whole
+// arena is released in one pass when the segment is dropped. This keeps the
+// hundreds of per-field chunk allocations of a segment physically clustered
+// instead of fragmenting the global heap.
+class ChunkArena {
+ public:
+    static constexpr int64_t kSlabSize = 16 << 20;  // 16 MiB
+    // every chunk starts on a cache line, which is also the widest vector
+    // load: brute-force kernels may use aligned AVX-512 accesses on any
+    // chunk and rows never straddle a line at offset zero
+    static constexpr int64_t kChunkAlignment = 64;
+
+    ChunkArena() = default;
+    ChunkArena(const ChunkArena&) = delete;
+    ChunkArena&
+    operator=(const ChunkArena&) = delete;
+
+    virtual ~ChunkArena() {
+        // subclasses must have released their own slabs by now
+        for (auto& slab : slabs_) {
+            release_slab(slab);
+        }
+    }
+
+    void*
+    allocate(size_t bytes, size_t alignment) {
+        Assert((alignment & (alignment - 1)) == 0);
+        auto align = std::max<int64_t>(static_cast<int64_t>(alignment), kChunkAlignment);
+        std::lock_guard lck(mutex_);
+        auto offset = (offset_ + align - 1) & ~(align - 1);
+        if (slabs_.empty() || offset + static_cast<int64_t>(bytes) > slabs_.back().size) {
+            slabs_.push_back(acquire_slab(std::max<int64_t>(kSlabSize, bytes)));
+            if (numa_node_ >= 0) {
+                // fresh slab, no pages touched yet: the policy decides where
+                // the whole slab lands
+                numa::BindMemoryToNode(slabs_.back().data, slabs_.back().size, numa_node_);
+            }
+            offset = 0;
+        }
+        offset_ = offset + bytes;
+        allocated_bytes_ += bytes;
+        return static_cast<char*>(slabs_.back().data) + offset;
+    }
+
+    int64_t
+    allocated_bytes() const {
+        std::lock_guard lck(mutex_);
+        return allocated_bytes_;
+    }
+
+    // Returns the physical pages of a retired chunk to the kernel while its
+    // addresses stay valid: only whole pages strictly inside the range are
+    // dropped, so slab neighbours are untouched and a reader that slips in
+    // anyway sees zeros instead of faulting. Works on any private anonymous
+    // mapping, which covers heap chunks as well as plain arena slabs.
+    // Returns the bytes actually released.
+    static int64_t
+    ReleaseInteriorPages(void* data, int64_t bytes) {
+        auto page_size = static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+        auto addr = reinterpret_cast<uintptr_t>(data);
+        auto beg = (addr + page_size - 1) & ~static_cast<uintptr_t>(page_size - 1);
+        auto end = (addr + bytes) & ~static_cast<uintptr_t>(page_size - 1);
+        if (end <= beg) {
+            return 0;
+        }
+        auto ret = madvise(reinterpret_cast<void*>(beg), end - beg, MADV_DONTNEED);
+        return ret == 0 ? static_cast<int64_t>(end - beg) : 0;
+    }
+
+    // releases one chunk's memory without freeing its address range; the
+    // bump layout cannot reuse the hole, so this only makes sense for
+    // chunks that are never read again (e.g. raw data an index replaced)
+    virtual int64_t
+    release_chunk_memory(void* data, int64_t bytes) {
+        return ReleaseInteriorPages(data, bytes);
+    }
+
+    // future slabs prefer this node; call before data starts flowing in
+    void
+    set_numa_node(int64_t node) {
+        std::lock_guard lck(mutex_);
+        numa_node_ = node;
+    }
+
+    int64_t
+    numa_node() const {
+        std::lock_guard lck(mutex_);
+        return numa_node_;
+    }
+
+ protected:
+    struct Slab {
+        void* data;
+        int64_t size;
+    };
+
+    virtual Slab
+    acquire_slab(int64_t size) {
+        // malloc only guarantees max_align_t, so chunk alignment needs the
+        // slab base aligned too
+        size = (size + kChunkAlignment - 1) & ~(kChunkAlignment - 1);
+        auto data = std::aligned_alloc(kChunkAlignment, size);
+        AssertInfo(data != nullptr, "chunk arena slab allocation failed");
+        return {data, size};
+    }
+
+    virtual void
+    release_slab(const Slab& slab) {
+        std::free(slab.data);
+    }
+
+    std::vector<Slab> slabs_;
+
+ private:
+    mutable std::mutex mutex_;
+    int64_t offset_ = 0;
+    int64_t allocated_bytes_ = 0;
+    int64_t numa_node_ = -1;
+};
+
+using ChunkArenaPtr = std::shared_ptr<ChunkArena>;
+
+// File-backed arena used by sealed segments: slabs are MAP_SHARED mappings of
+// a per-segment scratch file, so loaded columns live in the page cache and the
+// kernel can write cold pages back and reclaim them without dropping the
+// segment. The scratch file is unlinked right after creation, which keeps the
+// disk space reclaim automatic even on crash. If the file cannot be created
+// the arena degrades to plain heap slabs.
+class MmapChunkArena : public ChunkArena {
+ public:
+    static constexpr int64_t kHugePageSize = 2 << 20;  // 2 MiB
+
+    // opt-in explicit hugepage slabs for sealed columns: a multi-GB column
+    // scanned by brute force stops paying a 4 KiB TLB walk every page.
+    // Hugepage slabs are anonymous, so they give up the scratch-file
+    // reclaim path — that is the operator's trade to make; with no
+    // hugepages reserved the arena silently stays file-backed.
+    static void
+    set_use_hugepages(bool value) {
+        hugepages_flag().store(value, std::memory_order_relaxed);
+    }
+
+    MmapChunkArena() {
+        char path[] = "/tmp/milvus_mmap_XXXXXX";
+        fd_ = mkstemp(path);
+        if (fd_ >= 0) {
+            unlink(path);
+        }
+    }
+
+    ~MmapChunkArena() override {
+        for (auto& slab : slabs_) {
+            release_slab(slab);
+        }
+        slabs_.clear();
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    // MADV_DONTNEED on a MAP_SHARED slab round-trips the pages through the
+    // scratch file and hugetlb slabs reject 4 KiB advice; sealed columns
+    // never retire chunks, so declining costs nothing
+    int64_t
+    release_chunk_memory(void* data, int64_t bytes) override {
+        return 0;
+    }
+
+ protected:
+    Slab
+    acquire_slab(int64_t size) override {
+#ifdef MAP_HUGETLB
+        // called under the arena mutex, so the bookkeeping needs no lock
+        if (hugepages_flag().load(std::memory_order_relaxed) && !huge_exhausted_) {
+            auto huge_size = (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+            auto data = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (data != MAP_FAILED) {
+                huge_slabs_.insert(data);
+                return {data, huge_size};
+            }
+            // pool exhausted or not configured; stop asking for this arena
+            huge_exhausted_ = true;
+        }
+#endif
+        if (fd_ < 0) {
+            return ChunkArena::acquire_slab(size);
+        }
+        auto page_size = static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+        size = (size + page_size - 1) & ~(page_size - 1);
+        auto ret = ftruncate(fd_, file_size_ + size);
+        AssertInfo(ret == 0, std::string("failed to grow mmap scratch file: ") + strerror(errno));
+        auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, file_size_);
+        AssertInfo(data != MAP_FAILED, std::string("failed to map sealed column slab: ") + strerror(errno));
+        file_size_ += size;
+        return {data, size};
+    }
+
+    void
+    release_slab(const Slab& slab) override {
+        if (huge_slabs_.count(slab.data) > 0) {
+            munmap(slab.data, slab.size);
+            return;
+        }
+        if (fd_ < 0) {
+            ChunkArena::release_slab(slab);
+            return;
+        }
+        munmap(slab.data, slab.size);
+    }
+
+ private:
+    static std::atomic<bool>&
+    hugepages_flag() {
+        static std::atomic<bool> flag{false};
+        return flag;
+    }
+
+    int fd_ = -1;
+    int64_t file_size_ = 0;
+    std::unordered_set<void*> huge_slabs_;
+    bool huge_exhausted_ = false;
+};
+
+// Anonymous arena for deserialized index memory (see load_index_c.cpp):
+// slabs come straight from the explicit 2 MiB page pool so the pointer
+// chasing of a loaded graph stops paying a 4 KiB TLB walk per hop. When the
+// pool is empty or unconfigured the arena falls back to plain anonymous
+// slabs advised MADV_HUGEPAGE, letting khugepaged recover most of the win.
+// The split between the two is kept per arena so each loaded index can
+// report what backing it actually got.
+class HugepageArena : public ChunkArena {
+ public:
+    static constexpr int64_t kHugePageSize = MmapChunkArena::kHugePageSize;
+
+    ~HugepageArena() override {
+        for (auto& slab : slabs_) {
+            release_slab(slab);
+        }
+        slabs_.clear();
+    }
+
+    int64_t
+    huge_bytes() const {
+        return huge_bytes_.load(std::memory_order_relaxed);
+    }
+
+    int64_t
+    fallback_bytes() const {
+        return fallback_bytes_.load(std::memory_order_relaxed);
+    }
+
+ protected:
+    Slab
+    acquire_slab(int64_t size) override {
+        auto huge_size = (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+#ifdef MAP_HUGETLB
+        // called under the arena mutex, so the exhaustion flag needs no lock
+        if (!huge_exhausted_) {
+            auto data = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (data != MAP_FAILED) {
+                huge_bytes_.fetch_add(huge_size, std::memory_order_relaxed);
+                return {data, huge_size};
+            }
+            huge_exhausted_ = true;
+        }
+#endif
+        auto data = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        AssertInfo(data != MAP_FAILED, std::string("failed to map index arena slab: ") + strerror(errno));
+#ifdef MADV_HUGEPAGE
+        madvise(data, huge_size, MADV_HUGEPAGE);
+#endif
+        fallback_bytes_.fetch_add(huge_size, std::memory_order_relaxed);
+        return {data, huge_size};
+    }
+
+    void
+    release_slab(const Slab& slab) override {
+        munmap(slab.data, slab.size);
+    }
+
+ private:
+    std::atomic<int64_t> huge_bytes_{0};
+    std::atomic<int64_t> fallback_bytes_{0};
+    bool huge_exhausted_ = false;
+};
+
+// Allocator handle over a shared ChunkArena. deallocate() is a no-op for
+// arena-backed memory; without an arena it degrades to the global heap so
+// containers stay usable outside a segment (tests, sealed segments).
+template <typename T>
+class ArenaAllocator {
+ public:
+    using value_type = T;
+
+    ArenaAllocator() = default;
+    explicit ArenaAllocator(ChunkArenaPtr arena) : arena_(std::move(arena)) {
+    }
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {
+    }
+
+    T*
+    allocate(size_t n) {
+        if (arena_) {
+            return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    void
+    deallocate(T* ptr, size_t n) {
+        if (!arena_) {
+            std::allocator<T>().deallocate(ptr, n);
+        }
+        // arena memory is bulk-released when the owning segment is dropped
+    }
+
+    const ChunkArenaPtr&
+    arena() const {
+        return arena_;
+    }
+
+ private:
+    ChunkArenaPtr arena_;
+};
+
+template <typename T, typename U>
+bool
+operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+    return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U>
+bool
+operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+    return !(lhs == rhs);
+}
+
+}  // namespace milvus::segcore
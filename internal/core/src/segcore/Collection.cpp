@@ -9,6 +9,9 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <mutex>
+#include <unordered_map>
+
 #include <google/protobuf/text_format.h>
 
 #include "pb/schema.pb.h"
@@ -16,6 +19,26 @@
 
 namespace milvus::segcore {
 
+namespace {
+
+struct ParsedCollectionMeta {
+    std::string collection_name;
+    SchemaPtr schema;
+};
+
+// Process-wide cache keyed by the serialized schema text, which fully
+// determines the parsed result. A node holding thousands of segments of the
+// same collection calls NewCollection with identical text on every
+// rebalance; sharing one Schema makes those calls near-free and collapses
+// the duplicate metadata. Cached schemas are shared and must never be
+// mutated. The cache is cleared when it grows past distinct-schema counts
+// no deployment reaches.
+std::mutex schema_cache_mutex;
+std::unordered_map<std::string, ParsedCollectionMeta> schema_cache;
+constexpr size_t kMaxCachedSchemas = 256;
+
+}  // namespace
+
 Collection::Collection(const std::string& collection_proto) : schema_proto_(collection_proto) {
     parse();
 }
@@ -34,6 +57,16 @@ Collection::parse() {
     // }
 
     Assert(!schema_proto_.empty());
+    {
+        std::lock_guard lock(schema_cache_mutex);
+        auto it = schema_cache.find(schema_proto_);
+        if (it != schema_cache.end()) {
+            collection_name_ = it->second.collection_name;
+            schema_ = it->second.schema;
+            return;
+        }
+    }
+
     milvus::proto::schema::CollectionSchema collection_schema;
     auto suc = google::protobuf::TextFormat::ParseFromString(schema_proto_, &collection_schema);
 
@@ -43,6 +76,12 @@ Collection::parse() {
 
     collection_name_ = collection_schema.name();
     schema_ = Schema::ParseFrom(collection_schema);
+
+    std::lock_guard lock(schema_cache_mutex);
+    if (schema_cache.size() >= kMaxCachedSchemas) {
+        schema_cache.clear();
+    }
+    schema_cache.emplace(schema_proto_, ParsedCollectionMeta{collection_name_, schema_});
 }
 
 }  // namespace milvus::segcore
@@ -33,16 +33,15 @@ VectorBase::set_data_raw(ssize_t element_offset,
             return set_data_raw(element_offset, data->scalars().bool_data().data().data(), element_count);
         }
         case DataType::INT8: {
-            auto src_data = data->scalars().int_data().data();
-            std::vector<int8_t> data_raw(src_data.size());
-            std::copy_n(src_data.data(), src_data.size(), data_raw.data());
-            return set_data_raw(element_offset, data_raw.data(), element_count);
+            // narrow straight into the chunks, no staging vector
+            auto vec = dynamic_cast<ConcurrentVector<int8_t>*>(this);
+            Assert(vec);
+            return vec->set_data_from(element_offset, data->scalars().int_data().data().data(), element_count);
         }
         case DataType::INT16: {
-            auto src_data = data->scalars().int_data().data();
-            std::vector<int16_t> data_raw(src_data.size());
-            std::copy_n(src_data.data(), src_data.size(), data_raw.data());
-            return set_data_raw(element_offset, data_raw.data(), element_count);
+            auto vec = dynamic_cast<ConcurrentVector<int16_t>*>(this);
+            Assert(vec);
+            return vec->set_data_from(element_offset, data->scalars().int_data().data().data(), element_count);
         }
         case DataType::INT32: {
             return set_data_raw(element_offset, data->scalars().int_data().data().data(), element_count);
@@ -57,10 +56,11 @@ VectorBase::set_data_raw(ssize_t element_offset,
             return set_data_raw(element_offset, data->scalars().double_data().data().data(), element_count);
         }
         case DataType::VARCHAR: {
-            auto begin = data->scalars().string_data().data().begin();
-            auto end = data->scalars().string_data().data().end();
-            std::vector<std::string> data_raw(begin, end);
-            return set_data_raw(element_offset, data_raw.data(), element_count);
+            // copy each payload straight into the chunk's byte blocks; the
+            // staging vector duplicated every payload byte
+            auto vec = dynamic_cast<ConcurrentVector<std::string>*>(this);
+            Assert(vec);
+            return vec->set_data_from(element_offset, data->scalars().string_data().data().begin(), element_count);
         }
         default: {
             PanicInfo("unsupported");
@@ -70,6 +70,9 @@ VectorBase::set_data_raw(ssize_t element_offset,
 
 void
 VectorBase::fill_chunk_data(ssize_t element_count, const DataArray* data, const FieldMeta& field_meta) {
+    if (element_count == 0) {
+        return;
+    }
     if (field_meta.is_vector()) {
         if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
             return fill_chunk_data(data->vectors().float_vector().data().data(), element_count);
@@ -85,16 +88,18 @@ VectorBase::fill_chunk_data(ssize_t element_count, const DataArray* data, const
             return fill_chunk_data(data->scalars().bool_data().data().data(), element_count);
         }
         case DataType::INT8: {
-            auto src_data = data->scalars().int_data().data();
-            std::vector<int8_t> data_raw(src_data.size());
-            std::copy_n(src_data.data(), src_data.size(), data_raw.data());
-            return fill_chunk_data(data_raw.data(), element_count);
+            // narrow straight into the chunk: the staging vector would be a
+            // second full copy of the column
+            auto& src_data = data->scalars().int_data().data();
+            auto dst_data = static_cast<int8_t*>(fill_chunk_uninitialized(element_count));
+            std::copy_n(src_data.data(), element_count, dst_data);
+            return;
         }
         case DataType::INT16: {
-            auto src_data = data->scalars().int_data().data();
-            std::vector<int16_t> data_raw(src_data.size());
-            std::copy_n(src_data.data(), src_data.size(), data_raw.data());
-            return fill_chunk_data(data_raw.data(), element_count);
+            auto& src_data = data->scalars().int_data().data();
+            auto dst_data = static_cast<int16_t*>(fill_chunk_uninitialized(element_count));
+            std::copy_n(src_data.data(), element_count, dst_data);
+            return;
         }
         case DataType::INT32: {
             return fill_chunk_data(data->scalars().int_data().data().data(), element_count);
@@ -109,10 +114,11 @@ VectorBase::fill_chunk_data(ssize_t element_count, const DataArray* data, const
             return fill_chunk_data(data->scalars().double_data().data().data(), element_count);
         }
         case DataType::VARCHAR: {
-            auto begin = data->scalars().string_data().data().begin();
-            auto end = data->scalars().string_data().data().end();
-            std::vector<std::string> data_raw(begin, end);
-            return fill_chunk_data(data_raw.data(), element_count);
+            // copy each payload straight from the proto into the chunk's
+            // byte blocks, bypassing any owning-string staging
+            auto vec = dynamic_cast<ConcurrentVector<std::string>*>(this);
+            Assert(vec);
+            return vec->fill_chunk_from(data->scalars().string_data().data().begin(), element_count);
         }
         default: {
             PanicInfo("unsupported");
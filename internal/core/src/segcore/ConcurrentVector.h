@@ -11,19 +11,27 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
-#include <deque>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
-#include <shared_mutex>
 #include <utility>
 #include <vector>
 
 #include <tbb/concurrent_vector.h>
 
 #include "common/FieldMeta.h"
+#include "common/Float16.h"
+#include "segcore/ChunkArena.h"
+#include "segcore/NonTemporalCopy.h"
 #include "common/Span.h"
 #include "common/Types.h"
 #include "common/Utils.h"
@@ -31,51 +39,110 @@
 
 namespace milvus::segcore {
 
+// Vector with a lock-free read path: elements live in exponentially growing
+// buckets whose addresses never change once published, so readers locate an
+// element with two acquire loads (size check + bucket pointer) and never
+// contend with growth. Growth itself is rare and serialized by a mutex.
 template <typename Type>
 class ThreadSafeVector {
  public:
+    ThreadSafeVector() = default;
+    ThreadSafeVector(const ThreadSafeVector&) = delete;
+    ThreadSafeVector&
+    operator=(const ThreadSafeVector&) = delete;
+
+    ~ThreadSafeVector() {
+        destroy();
+    }
+
     template <typename... Args>
     void
     emplace_to_at_least(int64_t size, Args... args) {
-        if (size <= size_) {
+        if (size <= size_.load(std::memory_order_acquire)) {
             return;
         }
         std::lock_guard lck(mutex_);
-        while (vec_.size() < size) {
-            vec_.emplace_back(std::forward<Args...>(args...));
-            ++size_;
+        auto current = size_.load(std::memory_order_relaxed);
+        while (current < size) {
+            auto [bucket_id, offset] = locate(current);
+            auto bucket = buckets_[bucket_id].load(std::memory_order_relaxed);
+            if (bucket == nullptr) {
+                bucket = std::allocator<Type>().allocate(bucket_size(bucket_id));
+                // publish the bucket before any element in it becomes visible
+                buckets_[bucket_id].store(bucket, std::memory_order_release);
+            }
+            new (bucket + offset) Type(args...);
+            ++current;
+            // publish after construction so readers never see a raw slot
+            size_.store(current, std::memory_order_release);
         }
     }
+
     const Type&
     operator[](int64_t index) const {
-        Assert(index < size_);
-        std::shared_lock lck(mutex_);
-        return vec_[index];
+        Assert(index < size_.load(std::memory_order_acquire));
+        auto [bucket_id, offset] = locate(index);
+        return buckets_[bucket_id].load(std::memory_order_acquire)[offset];
     }
 
     Type&
     operator[](int64_t index) {
-        Assert(index < size_);
-        std::shared_lock lck(mutex_);
-        return vec_[index];
+        Assert(index < size_.load(std::memory_order_acquire));
+        auto [bucket_id, offset] = locate(index);
+        return buckets_[bucket_id].load(std::memory_order_acquire)[offset];
     }
 
     int64_t
     size() const {
-        return size_;
+        return size_.load(std::memory_order_acquire);
     }
 
+    // not concurrency-safe against readers, same contract as before:
+    // the owning segment must be quiesced when it is cleared
     void
     clear() {
         std::lock_guard lck(mutex_);
-        size_ = 0;
-        vec_.clear();
+        destroy();
     }
 
  private:
+    // bucket k holds (kInitialSize << k) elements, starting at logical index
+    // (kInitialSize << k) - kInitialSize; 58 buckets cover any int64 index
+    static constexpr int64_t kInitialBit = 6;
+    static constexpr int64_t kInitialSize = 1 << kInitialBit;
+    static constexpr int64_t kMaxBuckets = 64 - kInitialBit;
+
+    static int64_t
+    bucket_size(int64_t bucket_id) {
+        return kInitialSize << bucket_id;
+    }
+
+    static std::pair<int64_t, int64_t>
+    locate(int64_t index) {
+        auto adjusted = static_cast<uint64_t>(index) + kInitialSize;
+        auto msb = 63 - __builtin_clzll(adjusted);
+        return {msb - kInitialBit, static_cast<int64_t>(adjusted - (uint64_t(1) << msb))};
+    }
+
+    void
+    destroy() {
+        auto size = size_.load(std::memory_order_relaxed);
+        for (int64_t i = 0; i < size; ++i) {
+            auto [bucket_id, offset] = locate(i);
+            buckets_[bucket_id].load(std::memory_order_relaxed)[offset].~Type();
+        }
+        size_.store(0, std::memory_order_release);
+        for (int64_t bucket_id = 0; bucket_id < kMaxBuckets; ++bucket_id) {
+            if (auto bucket = buckets_[bucket_id].load(std::memory_order_relaxed)) {
+                std::allocator<Type>().deallocate(bucket, bucket_size(bucket_id));
+                buckets_[bucket_id].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+    }
+
     std::atomic<int64_t> size_ = 0;
-    std::deque<Type> vec_;
-    mutable std::shared_mutex mutex_;
+    std::array<std::atomic<Type*>, kMaxBuckets> buckets_ = {};
+    mutable std::mutex mutex_;
 };
 
 class VectorBase {
@@ -99,6 +166,12 @@ class VectorBase {
     void
     fill_chunk_data(ssize_t element_count, const DataArray* data, const FieldMeta& field_meta);
 
+    // allocates the single sealed chunk and hands out its storage, so a
+    // caller that must convert element types can write in place instead
+    // of staging a converted copy first
+    virtual void*
+    fill_chunk_uninitialized(ssize_t element_count) = 0;
+
     virtual SpanBase
     get_span_base(int64_t chunk_id) const = 0;
 
@@ -110,21 +183,65 @@ class VectorBase {
     virtual const void*
     get_chunk_data(ssize_t chunk_index) const = 0;
 
+    // per-chunk min/max ("zone map") recorded while the column filled;
+    // min/max must point at the column's element type. Returns false when
+    // the column keeps no statistics or the chunk's range is unknown, and
+    // the recorded range always covers at least the chunk's visible rows,
+    // so a filter may use it to skip a chunk, never to include one.
+    virtual bool
+    get_chunk_minmax(ssize_t chunk_index, void* min_value, void* max_value) const {
+        return false;
+    }
+
     virtual ssize_t
     num_chunk() const = 0;
 
     virtual bool
     empty() = 0;
 
+    // Releases the physical memory of one chunk while its addresses stay
+    // valid, for columns whose rows an index can reconstruct; returns the
+    // bytes released. The caller must hold the owning segment's exclusive
+    // lock so no reader is inside the chunk. Default keeps everything.
+    virtual int64_t
+    release_chunk(ssize_t chunk_index) {
+        return 0;
+    }
+
+    virtual bool
+    chunk_released(ssize_t chunk_index) const {
+        return false;
+    }
+
+    // released chunks in total; a zero lets gather paths skip the per-row
+    // released check entirely
+    virtual int64_t
+    num_released_chunks() const {
+        return 0;
+    }
+
  protected:
     const int64_t size_per_chunk_;
 };
 
+// Zone map entry of one chunk: the min/max of every row written so far,
+// merged under CAS loops so concurrent inserts at reserved offsets need no
+// extra lock. Starts as an empty (min > max) range meaning "unknown".
+template <typename Type>
+struct ChunkMinMax {
+    std::atomic<Type> min_{std::numeric_limits<Type>::max()};
+    std::atomic<Type> max_{std::numeric_limits<Type>::lowest()};
+};
+
+// placeholder for columns that keep no per-chunk statistics
+struct NoChunkMinMax {};
+
 template <typename Type, bool is_scalar = false>
 class ConcurrentVectorImpl : public VectorBase {
  public:
     // constants
-    using Chunk = FixedVector<Type>;
+    using ChunkAllocator = ArenaAllocator<Type>;
+    using Chunk = boost::container::vector<Type, ChunkAllocator>;
     ConcurrentVectorImpl(ConcurrentVectorImpl&&) = delete;
     ConcurrentVectorImpl(const ConcurrentVectorImpl&) = delete;
 
@@ -133,19 +250,23 @@ class ConcurrentVectorImpl : public VectorBase {
     ConcurrentVectorImpl&
     operator=(const ConcurrentVectorImpl&) = delete;
 
-    using TraitType =
-        std::conditional_t<is_scalar, Type, std::conditional_t<std::is_same_v<Type, float>, FloatVector, BinaryVector>>;
+    using TraitType = std::conditional_t<
+        is_scalar,
+        Type,
+        std::conditional_t<std::is_same_v<Type, float>,
+                           FloatVector,
+                           std::conditional_t<std::is_same_v<Type, uint16_t>, Float16Vector, BinaryVector>>>;
 
  public:
-    explicit ConcurrentVectorImpl(ssize_t dim, int64_t size_per_chunk)
-        : VectorBase(size_per_chunk), Dim(is_scalar ? 1 : dim) {
+    explicit ConcurrentVectorImpl(ssize_t dim, int64_t size_per_chunk, ChunkArenaPtr arena = nullptr)
+        : VectorBase(size_per_chunk), Dim(is_scalar ? 1 : dim), chunk_allocator_(std::move(arena)) {
         // Assert(is_scalar ? dim == 1 : dim != 1);
     }
 
     void
     grow_to_at_least(int64_t element_count) override {
         auto chunk_count = upper_div(element_count, size_per_chunk_);
-        chunks_.emplace_to_at_least(chunk_count, Dim * size_per_chunk_);
+        chunks_.emplace_to_at_least(chunk_count, Dim * size_per_chunk_, chunk_allocator_);
     }
 
     Span<TraitType>
@@ -173,10 +294,21 @@ class ConcurrentVectorImpl : public VectorBase {
             return;
         }
         AssertInfo(chunks_.size() == 0, "no empty concurrent vector");
-        chunks_.emplace_to_at_least(1, Dim * element_count);
+        chunks_.emplace_to_at_least(1, Dim * element_count, chunk_allocator_);
         set_data(0, static_cast<const Type*>(source), element_count);
     }
 
+    void*
+    fill_chunk_uninitialized(ssize_t element_count) override {
+        if (element_count == 0) {
+            return nullptr;
+        }
+        AssertInfo(chunks_.size() == 0, "no empty concurrent vector");
+        chunks_.emplace_to_at_least(1, Dim * element_count, chunk_allocator_);
+        Chunk& chunk = chunks_[0];
+        return chunk.data();
+    }
+
     void
     set_data_raw(ssize_t element_offset, const void* source, ssize_t element_count) override {
         if (element_count == 0) {
@@ -219,6 +351,53 @@ class ConcurrentVectorImpl : public VectorBase {
         }
     }
 
+    // walks the destination chunks like set_data but assigns through the
+    // caller's iterator, so proto columns whose element type differs from
+    // the chunk type convert in place instead of staging a converted copy
+    template <typename SourceIt>
+    void
+    set_data_from(ssize_t element_offset, SourceIt source, ssize_t element_count) {
+        static_assert(is_scalar);
+        if (element_count == 0) {
+            return;
+        }
+        this->grow_to_at_least(element_offset + element_count);
+        auto chunk_id = element_offset / size_per_chunk_;
+        auto chunk_offset = element_offset % size_per_chunk_;
+        while (element_count > 0) {
+            auto run = std::min(element_count, size_per_chunk_ - chunk_offset);
+            Chunk& chunk = chunks_[chunk_id];
+            std::copy_n(source, run, chunk.data() + chunk_offset);
+            merge_stats(chunk_id, chunk.data() + chunk_offset, run);
+            source += run;
+            element_count -= run;
+            chunk_offset = 0;
+            ++chunk_id;
+        }
+    }
+
+    bool
+    get_chunk_minmax(ssize_t chunk_index, void* min_value, void* max_value) const override {
+        if constexpr (is_scalar && std::is_arithmetic_v<Type>) {
+            if (chunk_index >= chunk_stats_.size()) {
+                return false;
+            }
+            auto& stats = chunk_stats_[chunk_index];
+            auto lo = stats.min_.load(std::memory_order_relaxed);
+            auto hi = stats.max_.load(std::memory_order_relaxed);
+            if (lo > hi) {
+                // nothing recorded, e.g. the chunk was filled in place
+                // through fill_chunk_uninitialized
+                return false;
+            }
+            *static_cast<Type*>(min_value) = lo;
+            *static_cast<Type*>(max_value) = hi;
+            return true;
+        } else {
+            return false;
+        }
+    }
+
     const Chunk&
     get_chunk(ssize_t chunk_index) const {
         return chunks_[chunk_index];
@@ -266,6 +445,36 @@ class ConcurrentVectorImpl : public VectorBase {
         chunks_.clear();
     }
 
+    int64_t
+    release_chunk(ssize_t chunk_index) override {
+        Chunk& chunk = chunks_[chunk_index];
+        auto bytes = static_cast<int64_t>(chunk.size() * sizeof(Type));
+        auto& arena = chunk_allocator_.arena();
+        // the arena decides whether its backing store tolerates a page
+        // release; heap chunks are private anonymous memory and always do
+        auto released = arena != nullptr ? arena->release_chunk_memory(chunk.data(), bytes)
+                                         : ChunkArena::ReleaseInteriorPages(chunk.data(), bytes);
+        if (released > 0) {
+            released_flags_.emplace_to_at_least(chunk_index + 1);
+            released_flags_[chunk_index].store(true, std::memory_order_relaxed);
+            num_released_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return released;
+    }
+
+    bool
+    chunk_released(ssize_t chunk_index) const override {
+        if (chunk_index >= released_flags_.size()) {
+            return false;
+        }
+        return released_flags_[chunk_index].load(std::memory_order_relaxed);
+    }
+
+    int64_t
+    num_released_chunks() const override {
+        return num_released_.load(std::memory_order_relaxed);
+    }
+
  private:
     void
     fill_chunk(
@@ -277,37 +486,427 @@ class ConcurrentVectorImpl : public VectorBase {
         Assert(chunk_id < chunk_max_size);
         Chunk& chunk = chunks_[chunk_id];
         auto ptr = chunk.data();
-        std::copy_n(source + source_offset * Dim, element_count * Dim, ptr + chunk_offset * Dim);
+        bulk_copy(source + source_offset * Dim, element_count * Dim, ptr + chunk_offset * Dim);
+        merge_stats(chunk_id, source + source_offset, element_count);
+    }
+
+    // merges the min/max of a freshly written run into the chunk's zone map
+    void
+    merge_stats(ssize_t chunk_id, const Type* data, ssize_t element_count) {
+        if constexpr (is_scalar && std::is_arithmetic_v<Type>) {
+            Type lo = data[0];
+            Type hi = data[0];
+            for (ssize_t i = 1; i < element_count; ++i) {
+                lo = std::min(lo, data[i]);
+                hi = std::max(hi, data[i]);
+            }
+            if constexpr (std::is_floating_point_v<Type>) {
+                for (ssize_t i = 0; i < element_count; ++i) {
+                    if (std::isnan(data[i])) {
+                        // NaN compares false against any bound, so a range
+                        // excluding it would lie; widen to never-skip
+                        lo = std::numeric_limits<Type>::lowest();
+                        hi = std::numeric_limits<Type>::max();
+                        break;
+                    }
+                }
+            }
+            chunk_stats_.emplace_to_at_least(chunk_id + 1);
+            auto& stats = chunk_stats_[chunk_id];
+            // relaxed is enough: the insert ack that makes these rows
+            // visible to queries is also the release/acquire edge that
+            // publishes their statistics
+            auto cur = stats.min_.load(std::memory_order_relaxed);
+            while (lo < cur && !stats.min_.compare_exchange_weak(cur, lo, std::memory_order_relaxed)) {
+            }
+            cur = stats.max_.load(std::memory_order_relaxed);
+            while (hi > cur && !stats.max_.compare_exchange_weak(cur, hi, std::memory_order_relaxed)) {
+            }
+        }
     }
 
     const ssize_t Dim;
+    const ChunkAllocator chunk_allocator_;
 
  private:
+    using ChunkStats = std::conditional_t<is_scalar && std::is_arithmetic_v<Type>, ChunkMinMax<Type>, NoChunkMinMax>;
+
     ThreadSafeVector<Chunk> chunks_;
+    ThreadSafeVector<ChunkStats> chunk_stats_;
+    // set under the segment's exclusive lock; gathers may read the flags
+    // relaxed because a released chunk never becomes live again
+    ThreadSafeVector<std::atomic<bool>> released_flags_;
+    std::atomic<int64_t> num_released_ = 0;
 };
 
 template <typename Type>
 class ConcurrentVector : public ConcurrentVectorImpl<Type, true> {
  public:
     static_assert(IsScalar<Type> || std::is_same_v<Type, PkType>);
-    explicit ConcurrentVector(int64_t size_per_chunk)
-        : ConcurrentVectorImpl<Type, true>::ConcurrentVectorImpl(1, size_per_chunk) {
+    explicit ConcurrentVector(int64_t size_per_chunk, ChunkArenaPtr arena = nullptr)
+        : ConcurrentVectorImpl<Type, true>::ConcurrentVectorImpl(1, size_per_chunk, std::move(arena)) {
+    }
+};
+
+// One chunk of a VarChar column: rows are string_views into a few large byte
+// blocks owned by the chunk, so a predicate scan walks a dense 16-byte slot
+// array and contiguous payload instead of chasing one heap allocation per
+// row. Blocks are never reallocated once a row points into them, which keeps
+// published views valid while concurrent writers fill reserved offsets in
+// any order; the mutex only serializes payload appends, slot stores follow
+// the same plain-write-then-ack model as the other column types.
+class StringChunk {
+ public:
+    // Dictionary mode (enum-like columns): each row stores a 4-byte code
+    // into a chunk-local dictionary of distinct values instead of a 16-byte
+    // view plus its own payload copy. Predicates translate to integer
+    // compares over the code array and only final hits decode; the dense
+    // view array does not exist in this mode, so data() must not be called.
+    explicit StringChunk(int64_t capacity, ArenaAllocator<char> allocator, bool dictionary_encoded = false)
+        : views_(dictionary_encoded ? 0 : capacity, ArenaAllocator<std::string_view>(allocator)),
+          codes_(dictionary_encoded ? capacity : 0, ArenaAllocator<int32_t>(allocator)),
+          capacity_(capacity),
+          dictionary_encoded_(dictionary_encoded),
+          byte_allocator_(std::move(allocator)) {
+    }
+    StringChunk(const StringChunk&) = delete;
+    StringChunk&
+    operator=(const StringChunk&) = delete;
+
+    ~StringChunk() {
+        for (auto& block : blocks_) {
+            byte_allocator_.deallocate(block.data, block.capacity);
+        }
+    }
+
+    void
+    set(ssize_t chunk_offset, std::string_view value) {
+        if (dictionary_encoded_) {
+            codes_[chunk_offset] = intern(value);
+            return;
+        }
+        if (value.empty()) {
+            views_[chunk_offset] = std::string_view();
+            return;
+        }
+        views_[chunk_offset] = std::string_view(copy_bytes(value.data(), value.size()), value.size());
+    }
+
+    const std::string_view&
+    view(ssize_t chunk_offset) const {
+        if (dictionary_encoded_) {
+            return dict_view(codes_[chunk_offset]);
+        }
+        return views_[chunk_offset];
+    }
+
+    const std::string_view*
+    data() const {
+        AssertInfo(!dictionary_encoded_, "dictionary-encoded chunk has no dense view array");
+        return views_.data();
+    }
+
+    // address of the row's slot — view (dense) or code (dictionary);
+    // gather loops prefetch it ahead of the copy
+    const void*
+    element_address(ssize_t chunk_offset) const {
+        if (dictionary_encoded_) {
+            return &codes_[chunk_offset];
+        }
+        return &views_[chunk_offset];
+    }
+
+    int64_t
+    size() const {
+        return capacity_;
+    }
+
+    bool
+    dictionary_encoded() const {
+        return dictionary_encoded_;
+    }
+
+    const int32_t*
+    codes() const {
+        AssertInfo(dictionary_encoded_, "codes exist only on dictionary-encoded chunks");
+        return codes_.data();
+    }
+
+    // distinct values interned so far; every code of an acked row is below
+    // the count read after that row's ack
+    int32_t
+    dict_size() const {
+        return static_cast<int32_t>(dict_views_.size());
+    }
+
+    const std::string_view&
+    dict_view(int32_t code) const {
+        return dict_views_[code];
+    }
+
+    // code of `value`, or -1 when no row interned it — a filter answering
+    // -1 is AllFalse without touching the code array
+    int32_t
+    lookup_code(std::string_view value) const {
+        std::lock_guard lck(mutex_);
+        auto iter = dict_map_.find(value);
+        return iter == dict_map_.end() ? -1 : iter->second;
+    }
+
+ private:
+    int32_t
+    intern(std::string_view value) {
+        std::lock_guard lck(mutex_);
+        auto iter = dict_map_.find(value);
+        if (iter != dict_map_.end()) {
+            return iter->second;
+        }
+        auto code = static_cast<int32_t>(dict_views_.size());
+        std::string_view owned =
+            value.empty() ? std::string_view() : std::string_view(copy_bytes_locked(value.data(), value.size()), value.size());
+        // the entry publishes before this row's ack, so a reader holding
+        // an acked row's code always finds its view in place
+        dict_views_.emplace_to_at_least(code + 1, owned);
+        dict_map_.emplace(owned, code);
+        return code;
+    }
+
+    const char*
+    copy_bytes(const char* source, size_t size) {
+        std::lock_guard lck(mutex_);
+        return copy_bytes_locked(source, size);
     }
+
+    const char*
+    copy_bytes_locked(const char* source, size_t size) {
+        if (blocks_.empty() || blocks_.back().used + size > blocks_.back().capacity) {
+            auto capacity = std::max(kBlockSize, size);
+            blocks_.push_back({byte_allocator_.allocate(capacity), 0, capacity});
+        }
+        auto& block = blocks_.back();
+        auto dst = block.data + block.used;
+        std::memcpy(dst, source, size);
+        block.used += size;
+        return dst;
+    }
+
+    static constexpr size_t kBlockSize = 256 * 1024;
+
+    struct Block {
+        char* data;
+        size_t used;
+        size_t capacity;
+    };
+
+    boost::container::vector<std::string_view, ArenaAllocator<std::string_view>> views_;
+    // dictionary mode: per-row codes plus interned distinct values; the
+    // entry storage has stable addresses so readers never lock
+    boost::container::vector<int32_t, ArenaAllocator<int32_t>> codes_;
+    ThreadSafeVector<std::string_view> dict_views_;
+    std::unordered_map<std::string_view, int32_t> dict_map_;
+    const int64_t capacity_;
+    const bool dictionary_encoded_;
+    ArenaAllocator<char> byte_allocator_;
+    std::vector<Block> blocks_;
+    mutable std::mutex mutex_;
+};
+
+// VarChar columns keep an offset-array layout (see StringChunk) instead of
+// std::string elements; readers see the rows as Span<std::string_view>.
+// With dictionary_encoded set, every chunk stores codes into a chunk-local
+// dictionary instead (see the StringChunk doc); span access is unavailable
+// then and scans must go through the chunks' code arrays.
+template <>
+class ConcurrentVector<std::string> : public VectorBase {
+ public:
+    explicit ConcurrentVector(int64_t size_per_chunk, ChunkArenaPtr arena = nullptr, bool dictionary_encoded = false)
+        : VectorBase(size_per_chunk), byte_allocator_(std::move(arena)), dictionary_encoded_(dictionary_encoded) {
+    }
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector&
+    operator=(const ConcurrentVector&) = delete;
+
+    void
+    grow_to_at_least(int64_t element_count) override {
+        auto chunk_count = upper_div(element_count, size_per_chunk_);
+        chunks_.emplace_to_at_least(chunk_count, size_per_chunk_, byte_allocator_, dictionary_encoded_);
+    }
+
+    void
+    set_data_raw(ssize_t element_offset, const void* source, ssize_t element_count) override {
+        set_data_from(element_offset, static_cast<const std::string*>(source), element_count);
+    }
+
+    void
+    fill_chunk_data(const void* source, ssize_t element_count) override {
+        fill_chunk_from(static_cast<const std::string*>(source), element_count);
+    }
+
+    void*
+    fill_chunk_uninitialized(ssize_t element_count) override {
+        // rows are views into chunk-owned byte blocks; there is no flat
+        // storage a caller could fill in place
+        PanicInfo("unsupported");
+    }
+
+    // writes element_count rows from any iterator whose value type converts
+    // to string_view (std::string columns, proto RepeatedPtrField<string>)
+    template <typename SourceIt>
+    void
+    set_data_from(ssize_t element_offset, SourceIt source, ssize_t element_count) {
+        if (element_count == 0) {
+            return;
+        }
+        this->grow_to_at_least(element_offset + element_count);
+        auto chunk_id = element_offset / size_per_chunk_;
+        auto chunk_offset = element_offset % size_per_chunk_;
+        while (element_count > 0) {
+            auto run = std::min(element_count, size_per_chunk_ - chunk_offset);
+            StringChunk& chunk = chunks_[chunk_id];
+            for (ssize_t i = 0; i < run; ++i, ++source) {
+                chunk.set(chunk_offset + i, std::string_view(*source));
+            }
+            element_count -= run;
+            chunk_offset = 0;
+            ++chunk_id;
+        }
+    }
+
+    // sealed path: one chunk sized exactly to the column
+    template <typename SourceIt>
+    void
+    fill_chunk_from(SourceIt source, ssize_t element_count) {
+        if (element_count == 0) {
+            return;
+        }
+        AssertInfo(chunks_.size() == 0, "no empty concurrent vector");
+        chunks_.emplace_to_at_least(1, element_count, byte_allocator_, dictionary_encoded_);
+        set_data_from(0, source, element_count);
+    }
+
+    Span<std::string_view>
+    get_span(int64_t chunk_id) const {
+        auto& chunk = get_chunk(chunk_id);
+        return Span<std::string_view>(chunk.data(), chunk.size());
+    }
+
+    SpanBase
+    get_span_base(int64_t chunk_id) const override {
+        return get_span(chunk_id);
+    }
+
+    const StringChunk&
+    get_chunk(ssize_t chunk_index) const {
+        return chunks_[chunk_index];
+    }
+
+    const void*
+    get_chunk_data(ssize_t chunk_index) const override {
+        return chunks_[chunk_index].data();
+    }
+
+    const std::string_view&
+    operator[](ssize_t element_index) const {
+        auto chunk_id = element_index / size_per_chunk_;
+        auto chunk_offset = element_index % size_per_chunk_;
+        return get_chunk(chunk_id).view(chunk_offset);
+    }
+
+    // prefetch anchor for gather loops (see bulk_subscript_impl)
+    const void*
+    get_element(ssize_t element_index) const {
+        auto chunk_id = element_index / size_per_chunk_;
+        auto chunk_offset = element_index % size_per_chunk_;
+        return get_chunk(chunk_id).element_address(chunk_offset);
+    }
+
+    ssize_t
+    num_chunk() const override {
+        return chunks_.size();
+    }
+
+    bool
+    empty() override {
+        for (size_t i = 0; i < chunks_.size(); i++) {
+            if (get_chunk(i).size() > 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void
+    clear() {
+        chunks_.clear();
+    }
+
+    bool
+    dictionary_encoded() const {
+        return dictionary_encoded_;
+    }
+
+ private:
+    const ArenaAllocator<char> byte_allocator_;
+    const bool dictionary_encoded_ = false;
+    ThreadSafeVector<StringChunk> chunks_;
 };
 
 template <>
 class ConcurrentVector<FloatVector> : public ConcurrentVectorImpl<float, false> {
  public:
-    ConcurrentVector(int64_t dim, int64_t size_per_chunk)
-        : ConcurrentVectorImpl<float, false>::ConcurrentVectorImpl(dim, size_per_chunk) {
+    ConcurrentVector(int64_t dim, int64_t size_per_chunk, ChunkArenaPtr arena = nullptr)
+        : ConcurrentVectorImpl<float, false>::ConcurrentVectorImpl(dim, size_per_chunk, std::move(arena)) {
+    }
+};
+
+// Half-precision storage mode for a VECTOR_FLOAT column (opted into via
+// SegcoreConfig): rows arrive as float32 and are converted once on insert,
+// so every chunk holds half the bytes and scans read half the bandwidth.
+// Readers that need float32 (index training, output fill) up-convert at
+// their boundary.
+template <>
+class ConcurrentVector<Float16Vector> : public ConcurrentVectorImpl<uint16_t, false> {
+ public:
+    ConcurrentVector(int64_t dim, int64_t size_per_chunk, ChunkArenaPtr arena = nullptr)
+        : ConcurrentVectorImpl<uint16_t, false>::ConcurrentVectorImpl(dim, size_per_chunk, std::move(arena)),
+          dim_(dim) {
+    }
+
+    void
+    set_data_raw(ssize_t element_offset, const void* source, ssize_t element_count) override {
+        if (element_count == 0) {
+            return;
+        }
+        aligned_vector<uint16_t> staging(element_count * dim_);
+        Float32ToFloat16Batch(static_cast<const float*>(source), staging.data(), staging.size());
+        ConcurrentVectorImpl<uint16_t, false>::set_data_raw(element_offset, staging.data(), element_count);
     }
+
+    void
+    fill_chunk_data(const void* source, ssize_t element_count) override {
+        if (element_count == 0) {
+            return;
+        }
+        aligned_vector<uint16_t> staging(element_count * dim_);
+        Float32ToFloat16Batch(static_cast<const float*>(source), staging.data(), staging.size());
+        ConcurrentVectorImpl<uint16_t, false>::fill_chunk_data(staging.data(), element_count);
+    }
+
+    int64_t
+    get_dim() const {
+        return dim_;
+    }
+
+ private:
+    int64_t dim_;
 };
 
 template <>
 class ConcurrentVector<BinaryVector> : public ConcurrentVectorImpl<uint8_t, false> {
  public:
-    explicit ConcurrentVector(int64_t dim, int64_t size_per_chunk)
-        : binary_dim_(dim), ConcurrentVectorImpl(dim / 8, size_per_chunk) {
+    explicit ConcurrentVector(int64_t dim, int64_t size_per_chunk, ChunkArenaPtr arena = nullptr)
+        : binary_dim_(dim), ConcurrentVectorImpl(dim / 8, size_per_chunk, std::move(arena)) {
         Assert(dim % 8 == 0);
     }
 
@@ -11,10 +11,15 @@
 
 #pragma once
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <utility>
 
 #include "AckResponder.h"
+#include "common/BitsetUtils.h"
+#include "common/Metrics.h"
 #include "common/Schema.h"
 #include "segcore/Record.h"
 #include "ConcurrentVector.h"
@@ -26,68 +31,140 @@ struct DeletedRecord {
         // Just for query
         int64_t del_barrier = 0;
         BitsetTypePtr bitmap_ptr;
-
-        std::shared_ptr<TmpBitmap>
-        clone(int64_t capacity);
     };
     static constexpr int64_t deprecated_size_per_chunk = 32 * 1024;
-    DeletedRecord()
-        : lru_(std::make_shared<TmpBitmap>()), timestamps_(deprecated_size_per_chunk), pks_(deprecated_size_per_chunk) {
-        lru_->bitmap_ptr = std::make_shared<BitsetType>();
-    }
 
-    auto
-    get_lru_entry() {
-        std::shared_lock lck(shared_mutex_);
-        return lru_;
+    // the pk column is monomorphic: its type is fixed by the schema here, so
+    // int64 pks live in flat chunks instead of string-capable variant slots
+    explicit DeletedRecord(const Schema& schema) : timestamps_(deprecated_size_per_chunk) {
+        auto pk_field_id = schema.get_primary_field_id();
+        if (!pk_field_id.has_value()) {
+            return;
+        }
+        pk_type_ = schema[pk_field_id.value()].get_data_type();
+        switch (pk_type_) {
+            case DataType::INT64: {
+                pks_ = std::make_unique<ConcurrentVector<int64_t>>(deprecated_size_per_chunk);
+                break;
+            }
+            case DataType::VARCHAR: {
+                pks_ = std::make_unique<ConcurrentVector<std::string>>(deprecated_size_per_chunk);
+                break;
+            }
+            default: {
+                PanicInfo("unsupported pk type");
+            }
+        }
     }
 
-    std::shared_ptr<TmpBitmap>
-    clone_lru_entry(int64_t insert_barrier, int64_t del_barrier, int64_t& old_del_barrier, bool& hit_cache) {
-        std::shared_lock lck(shared_mutex_);
-        auto res = lru_->clone(insert_barrier);
-        old_del_barrier = lru_->del_barrier;
+    DataType
+    pk_type() const {
+        return pk_type_;
+    }
 
-        if (lru_->bitmap_ptr->size() == insert_barrier && lru_->del_barrier == del_barrier) {
-            hit_cache = true;
-        } else {
-            res->del_barrier = del_barrier;
-        }
+    template <typename T>
+    ConcurrentVector<T>&
+    pks() {
+        auto ptr = dynamic_cast<ConcurrentVector<T>*>(pks_.get());
+        Assert(ptr);
+        return *ptr;
+    }
 
-        return res;
+    template <typename T>
+    const ConcurrentVector<T>&
+    pks() const {
+        auto ptr = dynamic_cast<const ConcurrentVector<T>*>(pks_.get());
+        Assert(ptr);
+        return *ptr;
     }
 
+    // Applies delete records [accum_del_barrier_, del_barrier) to the master
+    // bitmap exactly once across all queries; apply(bitmap, start, end) runs
+    // under the exclusive lock. No-op when the barrier was already reached,
+    // so concurrent queries pay at most one delta application.
+    template <typename Apply>
     void
-    insert_lru_entry(std::shared_ptr<TmpBitmap> new_entry, bool force = false) {
+    advance_accumulated(int64_t del_barrier, int64_t insert_barrier, Apply&& apply) {
         std::lock_guard lck(shared_mutex_);
-        if (new_entry->del_barrier <= lru_->del_barrier) {
-            if (!force || new_entry->bitmap_ptr->size() <= lru_->bitmap_ptr->size()) {
-                // DO NOTHING
-                return;
-            }
+        if (del_barrier <= accum_del_barrier_) {
+            return;
+        }
+        if (static_cast<int64_t>(accum_bitmap_.size()) < insert_barrier) {
+            accum_bitmap_.resize(insert_barrier, false);
         }
-        lru_ = std::move(new_entry);
+        static auto& advance_count = MetricsRegistry::GetInstance().GetCounter("segcore.delete.bitmap_advances");
+        advance_count.Increment();
+        apply(accum_bitmap_, accum_del_barrier_, del_barrier);
+        accum_del_barrier_ = del_barrier;
+        // one word-popcount pass per advance keeps the live-delete count
+        // readable in constant time (see accumulated_popcount)
+        accum_set_bits_ = static_cast<int64_t>(accum_bitmap_.count());
+    }
+
+    // number of rows the accumulated bitmap marks deleted, together with the
+    // delete barrier that count reflects; both read under one lock so they
+    // are mutually consistent. Lets get_real_count answer without
+    // materializing any bitset.
+    std::pair<int64_t, int64_t>
+    accumulated_popcount() const {
+        std::shared_lock lck(shared_mutex_);
+        return {accum_set_bits_, accum_del_barrier_};
+    }
+
+    // ORs the master bitmap straight into the caller's query bitset, 64 bits
+    // a step, with no snapshot allocation. Only valid when the query sees
+    // exactly the applied prefix of the log; returns false otherwise and the
+    // caller falls back to a private snapshot.
+    bool
+    or_accumulated(int64_t del_barrier, BitsetType& bitset) const {
+        std::shared_lock lck(shared_mutex_);
+        if (del_barrier != accum_del_barrier_ || accum_bitmap_.size() > bitset.size()) {
+            return false;
+        }
+        AppendBitset(bitset, 0, accum_bitmap_);
+        return true;
+    }
+
+    // Snapshots the master bitmap (a word-level copy, no per-pk work),
+    // resized to insert_barrier; reports the barrier the snapshot reflects.
+    std::shared_ptr<TmpBitmap>
+    snapshot_accumulated(int64_t insert_barrier, int64_t& accum_del_barrier) const {
+        // queries land here only when they cannot ride the master bitmap
+        // in place; a rising rate means private rebuilds are back
+        static auto& snapshot_count = MetricsRegistry::GetInstance().GetCounter("segcore.delete.bitmap_snapshots");
+        snapshot_count.Increment();
+        std::shared_lock lck(shared_mutex_);
+        auto res = std::make_shared<TmpBitmap>();
+        res->del_barrier = accum_del_barrier_;
+        res->bitmap_ptr = std::make_shared<BitsetType>(accum_bitmap_);
+        res->bitmap_ptr->resize(insert_barrier, false);
+        accum_del_barrier = accum_del_barrier_;
+        return res;
     }
 
  public:
     std::atomic<int64_t> reserved = 0;
     AckResponder ack_responder_;
     ConcurrentVector<Timestamp> timestamps_;
-    ConcurrentVector<PkType> pks_;
+
+    // live delete batches park here until they are contiguous with the acked
+    // log, then stage_delete_records merges them into one timestamp-sorted
+    // run; keyed by the reserved offset of each batch
+    struct StagedBatchBase {
+        virtual ~StagedBatchBase() = default;
+    };
+    std::mutex staging_mutex_;
+    std::map<int64_t, std::unique_ptr<StagedBatchBase>> staged_batches_;
 
  private:
-    std::shared_ptr<TmpBitmap> lru_;
-    std::shared_mutex shared_mutex_;
-};
+    DataType pk_type_ = DataType::NONE;
+    std::unique_ptr<VectorBase> pks_;
 
-inline auto
-DeletedRecord::TmpBitmap::clone(int64_t capacity) -> std::shared_ptr<TmpBitmap> {
-    auto res = std::make_shared<TmpBitmap>();
-    res->del_barrier = this->del_barrier;
-    res->bitmap_ptr = std::make_shared<BitsetType>();
-    *(res->bitmap_ptr) = *(this->bitmap_ptr);
-    res->bitmap_ptr->resize(capacity, false);
-    return res;
-}
+    // deletes applied once, in delete-record order, never recomputed per query
+    BitsetType accum_bitmap_;
+    int64_t accum_del_barrier_ = 0;
+    int64_t accum_set_bits_ = 0;
+    mutable std::shared_mutex shared_mutex_;
+};
 
 }  // namespace milvus::segcore
@@ -9,40 +9,200 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <thread>
+#include "index/BoolIndex.h"
 #include "index/ScalarIndexSort.h"
 #include "index/StringIndexSort.h"
 
+#include "common/Float16.h"
 #include "common/SystemProperty.h"
+#include "knowhere/index/vector_index/IndexBinaryIVF.h"
+#include "knowhere/index/vector_index/IndexHNSW.h"
 #include "knowhere/index/vector_index/IndexIVF.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include "segcore/FieldIndexing.h"
 
 namespace milvus::segcore {
 
+template <typename VectorType, typename IndexType>
 void
-VectorFieldIndexing::BuildIndexRange(int64_t ack_beg, int64_t ack_end, const VectorBase* vec_base) {
-    AssertInfo(field_meta_.get_data_type() == DataType::VECTOR_FLOAT, "Data type of vector field is not VECTOR_FLOAT");
+VectorFieldIndexing::build_index_range_impl(int64_t ack_beg, int64_t ack_end, const VectorBase* vec_base) {
     auto dim = field_meta_.get_dim();
 
-    auto source = dynamic_cast<const ConcurrentVector<FloatVector>*>(vec_base);
-    AssertInfo(source, "vec_base can't cast to ConcurrentVector type");
-    auto num_chunk = source->num_chunk();
+    auto source = dynamic_cast<const ConcurrentVector<VectorType>*>(vec_base);
+    const ConcurrentVector<Float16Vector>* half_source = nullptr;
+    if constexpr (std::is_same_v<VectorType, FloatVector>) {
+        half_source = dynamic_cast<const ConcurrentVector<Float16Vector>*>(vec_base);
+    }
+    AssertInfo(source || half_source, "vec_base can't cast to ConcurrentVector type");
+    auto num_chunk = vec_base->num_chunk();
     AssertInfo(ack_end <= num_chunk, "ack_end is bigger than num_chunk");
     auto conf = get_build_params();
+    auto size_per_chunk = vec_base->get_size_per_chunk();
     data_.grow_to_at_least(ack_end);
+    aligned_vector<float> staging;
     for (int chunk_id = ack_beg; chunk_id < ack_end; chunk_id++) {
-        const auto& chunk = source->get_chunk(chunk_id);
+        const void* chunk_data;
+        if (half_source != nullptr) {
+            // the trainers want float32; staging one chunk costs far less
+            // than teaching every index type to read half-precision input
+            staging.resize(size_per_chunk * dim);
+            Float16ToFloat32Batch(static_cast<const uint16_t*>(half_source->get_chunk_data(chunk_id)), staging.data(),
+                                  staging.size());
+            chunk_data = staging.data();
+        } else {
+            chunk_data = source->get_chunk(chunk_id).data();
+        }
         // build index for chunk
-        auto indexing = std::make_unique<knowhere::IVF>();
-        auto dataset = knowhere::GenDataset(source->get_size_per_chunk(), dim, chunk.data());
-        indexing->Train(dataset, conf);
-        indexing->AddWithoutIds(dataset, conf);
+        auto indexing = std::make_unique<IndexType>();
+        auto dataset = knowhere::GenDataset(size_per_chunk, dim, chunk_data);
+        if constexpr (std::is_same_v<IndexType, knowhere::IVF> || std::is_same_v<IndexType, knowhere::BinaryIVF>) {
+            // consecutive chunks of one segment share distribution, and
+            // k-means is the bulk of the per-chunk build; train once,
+            // snapshot the trained-but-empty index, and rebuild later
+            // chunks from the snapshot. The interval caps centroid
+            // staleness if the stream drifts.
+            std::unique_lock lck(quantizer_mutex_);
+            if (trained_at_chunk_ < 0 || chunk_id - trained_at_chunk_ >= kQuantizerRetrainInterval) {
+                indexing->Train(dataset, conf);
+                trained_quantizer_ = indexing->Serialize(conf);
+                trained_at_chunk_ = chunk_id;
+            } else {
+                indexing->Load(trained_quantizer_);
+            }
+            lck.unlock();
+            indexing->AddWithoutIds(dataset, conf);
+        } else {
+            indexing->Train(dataset, conf);
+            indexing->AddWithoutIds(dataset, conf);
+        }
         data_[chunk_id] = std::move(indexing);
     }
 }
 
+template <typename VectorType, typename IndexType>
+void
+VectorFieldIndexing::compact_index_range_impl(int64_t chunk_beg, int64_t chunk_end, const VectorBase* vec_base) {
+    auto dim = field_meta_.get_dim();
+    auto source = dynamic_cast<const ConcurrentVector<VectorType>*>(vec_base);
+    const ConcurrentVector<Float16Vector>* half_source = nullptr;
+    if constexpr (std::is_same_v<VectorType, FloatVector>) {
+        half_source = dynamic_cast<const ConcurrentVector<Float16Vector>*>(vec_base);
+    }
+    AssertInfo(source || half_source, "vec_base can't cast to ConcurrentVector type");
+    auto size_per_chunk = vec_base->get_size_per_chunk();
+    auto num_rows = (chunk_end - chunk_beg) * size_per_chunk;
+
+    // stage the run contiguously; every chunk below the ack is immutable,
+    // so the copy needs no synchronization with writers
+    constexpr bool is_binary = std::is_same_v<VectorType, BinaryVector>;
+    const int64_t row_bytes = is_binary ? dim / 8 : dim * static_cast<int64_t>(sizeof(float));
+    aligned_vector<char> staging(num_rows * row_bytes);
+    for (auto chunk_id = chunk_beg; chunk_id < chunk_end; ++chunk_id) {
+        auto* dst = staging.data() + (chunk_id - chunk_beg) * size_per_chunk * row_bytes;
+        if (half_source != nullptr) {
+            Float16ToFloat32Batch(static_cast<const uint16_t*>(half_source->get_chunk_data(chunk_id)),
+                                  reinterpret_cast<float*>(dst), size_per_chunk * dim);
+        } else {
+            std::memcpy(dst, source->get_chunk_data(chunk_id), size_per_chunk * row_bytes);
+        }
+    }
+
+    auto conf = get_build_params();
+    auto indexing = std::make_unique<IndexType>();
+    auto dataset = knowhere::GenDataset(num_rows, dim, staging.data());
+    indexing->Train(dataset, conf);
+    indexing->AddWithoutIds(dataset, conf);
+
+    auto run = std::make_shared<CompactedRun>();
+    run->chunk_beg = chunk_beg;
+    run->chunk_end = chunk_end;
+    run->index = std::move(indexing);
+    std::unique_lock lck(compact_mutex_);
+    compacted_runs_.push_back(std::move(run));
+}
+
+void
+VectorFieldIndexing::CompactIndexRange(int64_t ack_end, const VectorBase* vec_base) {
+    // one compactor at a time; a racing build's own ack re-triggers soon
+    // enough that nothing is left behind permanently
+    std::unique_lock compaction(compaction_mutex_, std::try_to_lock);
+    if (!compaction.owns_lock()) {
+        return;
+    }
+    while (compacted_until_.load(std::memory_order_relaxed) + kCompactionFanIn <= ack_end) {
+        auto chunk_beg = compacted_until_.load(std::memory_order_relaxed);
+        auto chunk_end = chunk_beg + kCompactionFanIn;
+        switch (field_meta_.get_data_type()) {
+            case DataType::VECTOR_FLOAT: {
+                auto type_opt = field_meta_.get_metric_type();
+                if (segcore_config_.at(type_opt.value()).index_type == "HNSW") {
+                    compact_index_range_impl<FloatVector, knowhere::IndexHNSW>(chunk_beg, chunk_end, vec_base);
+                } else {
+                    compact_index_range_impl<FloatVector, knowhere::IVF>(chunk_beg, chunk_end, vec_base);
+                }
+                break;
+            }
+            case DataType::VECTOR_BINARY:
+                compact_index_range_impl<BinaryVector, knowhere::BinaryIVF>(chunk_beg, chunk_end, vec_base);
+                break;
+            default:
+                PanicInfo("unsupported vector type for growing index");
+        }
+        // publish after the run itself so an eviction that observes the
+        // watermark finds the run's chunk indexes already in place
+        compacted_until_.store(chunk_end, std::memory_order_release);
+    }
+}
+
+void
+VectorFieldIndexing::BuildIndexRange(int64_t ack_beg, int64_t ack_end, const VectorBase* vec_base) {
+    switch (field_meta_.get_data_type()) {
+        case DataType::VECTOR_FLOAT: {
+            auto type_opt = field_meta_.get_metric_type();
+            if (segcore_config_.at(type_opt.value()).index_type == "HNSW") {
+                build_index_range_impl<FloatVector, knowhere::IndexHNSW>(ack_beg, ack_end, vec_base);
+            } else {
+                build_index_range_impl<FloatVector, knowhere::IVF>(ack_beg, ack_end, vec_base);
+            }
+            break;
+        }
+        case DataType::VECTOR_BINARY:
+            build_index_range_impl<BinaryVector, knowhere::BinaryIVF>(ack_beg, ack_end, vec_base);
+            break;
+        default:
+            PanicInfo("unsupported vector type for growing index");
+    }
+}
+
+bool
+VectorFieldIndexing::reconstruct_from_index(int64_t chunk_id,
+                                            const int64_t* chunk_offsets,
+                                            int64_t count,
+                                            void* output) const {
+    if (chunk_id >= static_cast<int64_t>(data_.size()) || data_[chunk_id] == nullptr) {
+        return false;
+    }
+    auto dim = field_meta_.get_dim();
+    try {
+        auto dataset = knowhere::GenDatasetWithIds(count, dim, chunk_offsets);
+        auto result = data_[chunk_id]->GetVectorById(dataset, get_build_params());
+        auto tensor = knowhere::GetDatasetTensor(result);
+        if (tensor == nullptr) {
+            return false;
+        }
+        std::memcpy(output, tensor, count * field_meta_.get_sizeof());
+        return true;
+    } catch (std::exception&) {
+        // flat-list families hand back stored rows; quantizing or
+        // graph-only families throw here and keep their raw chunks
+        return false;
+    }
+}
+
 knowhere::Config
 VectorFieldIndexing::get_build_params() const {
     // TODO
@@ -52,7 +212,12 @@ VectorFieldIndexing::get_build_params() const {
     auto& config = segcore_config_.at(metric_type);
     auto base_params = config.build_params;
 
-    AssertInfo(base_params.count("nlist"), "Can't get nlist from index params");
+    if (config.index_type == "HNSW") {
+        AssertInfo(base_params.count("M"), "Can't get M from index params");
+        AssertInfo(base_params.count("efConstruction"), "Can't get efConstruction from index params");
+    } else {
+        AssertInfo(base_params.count("nlist"), "Can't get nlist from index params");
+    }
     knowhere::SetMetaDim(base_params, field_meta_.get_dim());
     knowhere::SetMetaMetricType(base_params, metric_type);
 
@@ -68,7 +233,14 @@ VectorFieldIndexing::get_search_params(int top_K) const {
     auto& config = segcore_config_.at(metric_type);
 
     auto base_params = config.search_params;
-    AssertInfo(base_params.count("nprobe"), "Can't get nprobe from base params");
+    if (config.index_type == "HNSW") {
+        AssertInfo(base_params.count("ef"), "Can't get ef from base params");
+        // the graph search must widen its candidate queue to at least topk;
+        // the configured ef only acts as a recall floor below that
+        base_params["ef"] = std::max(base_params["ef"].get<int64_t>(), static_cast<int64_t>(top_K));
+    } else {
+        AssertInfo(base_params.count("nprobe"), "Can't get nprobe from base params");
+    }
     knowhere::SetMetaTopk(base_params, top_K);
     knowhere::SetMetaMetricType(base_params, metric_type);
 
@@ -89,13 +261,35 @@ IndexingRecord::UpdateResourceAck(int64_t chunk_ack, const InsertRecord& record)
     resource_ack_ = chunk_ack;
     lck.unlock();
 
-    //    std::thread([this, old_ack, chunk_ack, &record] {
+    if (field_indexings_.empty()) {
+        finished_ack_.AddSegment(old_ack, chunk_ack);
+        return;
+    }
+
+    // hand the per-field builds to the shared pool so the inserting thread
+    // only pays for the copy into the chunk, not for training small indexes;
+    // searches consult finished_ack_ and brute-force not-yet-indexed chunks
+    auto& pool = ThreadPool::GetInstance(ThreadPoolRole::Build);
+    auto pending = std::make_shared<std::atomic<int64_t>>(field_indexings_.size());
     for (auto& [field_offset, entry] : field_indexings_) {
         auto vec_base = record.get_field_data_base(field_offset);
-        entry->BuildIndexRange(old_ack, chunk_ack, vec_base);
+        inflight_.fetch_add(1);
+        pool.Submit([this, old_ack, chunk_ack, vec_base, entry = entry.get(), pending] {
+            entry->BuildIndexRange(old_ack, chunk_ack, vec_base);
+            // chunks below the ack are final; fold eligible runs before the
+            // ack lands so searches see either per-chunk indexes or a fully
+            // published run, never something in between
+            entry->CompactIndexRange(chunk_ack, vec_base);
+            if (pending->fetch_sub(1) == 1) {
+                finished_ack_.AddSegment(old_ack, chunk_ack);
+            }
+            {
+                std::lock_guard lck(mutex_);
+                inflight_.fetch_sub(1);
+            }
+            drain_cv_.notify_all();
+        });
     }
-    finished_ack_.AddSegment(old_ack, chunk_ack);
-    //    }).detach();
 }
 
 template <typename T>
@@ -111,7 +305,21 @@ ScalarFieldIndexing<T>::BuildIndexRange(int64_t ack_beg, int64_t ack_end, const
         // build index for chunk
         // TODO
         if constexpr (std::is_same_v<T, std::string>) {
+            // string chunks hand out views; the sort index wants owning
+            // strings, so stage a copy for the build only. Row-wise so a
+            // dictionary-encoded chunk decodes through its codes
+            std::vector<std::string> rows;
+            rows.reserve(chunk.size());
+            for (int64_t i = 0; i < chunk.size(); ++i) {
+                rows.emplace_back(chunk.view(i));
+            }
             auto indexing = scalar::CreateStringIndexSort();
+            indexing->Build(vec_base->get_size_per_chunk(), rows.data());
+            data_[chunk_id] = std::move(indexing);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            // sorting booleans is wasted work; the two-bitmap index answers
+            // every predicate directly
+            auto indexing = scalar::CreateBoolIndex();
             indexing->Build(vec_base->get_size_per_chunk(), chunk.data());
             data_[chunk_id] = std::move(indexing);
         } else {
@@ -125,11 +333,13 @@ ScalarFieldIndexing<T>::BuildIndexRange(int64_t ack_beg, int64_t ack_end, const
 std::unique_ptr<FieldIndexing>
 CreateIndex(const FieldMeta& field_meta, const SegcoreConfig& segcore_config) {
     if (field_meta.is_vector()) {
-        if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
-            return std::make_unique<VectorFieldIndexing>(field_meta, segcore_config);
-        } else {
-            // TODO
-            PanicInfo("unsupported");
+        switch (field_meta.get_data_type()) {
+            case DataType::VECTOR_FLOAT:
+            case DataType::VECTOR_BINARY:
+                return std::make_unique<VectorFieldIndexing>(field_meta, segcore_config);
+            default:
+                // TODO
+                PanicInfo("unsupported");
         }
     }
     switch (field_meta.get_data_type()) {
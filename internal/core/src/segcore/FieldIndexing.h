@@ -14,6 +14,9 @@
 #include <optional>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
 
 #include <tbb/concurrent_vector.h>
 #include <index/Index.h>
@@ -21,6 +24,7 @@
 
 #include "AckResponder.h"
 #include "InsertRecord.h"
+#include "common/ThreadPool.h"
 #include "common/Schema.h"
 #include "knowhere/index/VecIndex.h"
 #include "segcore/SegcoreConfig.h"
@@ -56,6 +60,12 @@ class FieldIndexing {
     virtual knowhere::Index*
     get_chunk_indexing(int64_t chunk_id) const = 0;
 
+    // merges already-built per-chunk indexes into larger runs in the
+    // background; a no-op for fields whose index type has nothing to gain
+    virtual void
+    CompactIndexRange(int64_t ack_end, const VectorBase* vec_base) {
+    }
+
  protected:
     // additional info
     const FieldMeta& field_meta_;
@@ -95,6 +105,41 @@ class VectorFieldIndexing : public FieldIndexing {
         return data_.at(chunk_id).get();
     }
 
+    void
+    CompactIndexRange(int64_t ack_end, const VectorBase* vec_base) override;
+
+    // a run of consecutive chunks whose per-chunk indexes were folded into
+    // one index over all their rows; result offsets inside the index are
+    // relative to chunk_beg * size_per_chunk
+    struct CompactedRun {
+        int64_t chunk_beg;
+        int64_t chunk_end;  // exclusive
+        std::unique_ptr<knowhere::VecIndex> index;
+    };
+
+    // snapshot of the published runs, ordered by first chunk; shared
+    // ownership keeps a run alive for queries that already picked it up
+    std::vector<std::shared_ptr<CompactedRun>>
+    get_compacted_runs() const {
+        std::shared_lock lck(compact_mutex_);
+        return compacted_runs_;
+    }
+
+    // chunks below this are folded into published runs; monotonic, so a
+    // reader may act on a stale value safely
+    int64_t
+    compacted_until() const {
+        return compacted_until_.load(std::memory_order_acquire);
+    }
+
+    // Copies `count` stored rows of one indexed chunk into `output`;
+    // offsets are chunk-local (AddWithoutIds assigns them in insertion
+    // order). Returns false and leaves `output` untouched when the chunk
+    // has no index yet or its family keeps codes instead of rows, in which
+    // case the raw chunk must stay resident.
+    bool
+    reconstruct_from_index(int64_t chunk_id, const int64_t* chunk_offsets, int64_t count, void* output) const;
+
     knowhere::Config
     get_build_params() const;
 
@@ -102,6 +147,34 @@ class VectorFieldIndexing : public FieldIndexing {
     get_search_params(int top_k) const;
 
  private:
+    template <typename VectorType, typename IndexType>
+    void
+    build_index_range_impl(int64_t ack_beg, int64_t ack_end, const VectorBase* vec_base);
+
+    template <typename VectorType, typename IndexType>
+    void
+    compact_index_range_impl(int64_t chunk_beg, int64_t chunk_end, const VectorBase* vec_base);
+
+    // trained-but-empty IVF snapshot reused across chunk builds; retrained
+    // every kQuantizerRetrainInterval chunks as a drift guard. Chunk builds
+    // of one field may overlap on the Build pool, hence the mutex.
+    static constexpr int64_t kQuantizerRetrainInterval = 8;
+    std::mutex quantizer_mutex_;
+    knowhere::BinarySet trained_quantizer_;
+    int64_t trained_at_chunk_ = -1;
+
+    // slow ingest leaves long-lived segments with hundreds of tiny chunk
+    // indexes; once kCompactionFanIn consecutive chunks are final their
+    // indexes are rebuilt as one run so per-chunk search and merge costs
+    // track data size, not ingest burstiness. Raw chunk storage is never
+    // moved — published chunks back concurrent readers.
+    static constexpr int64_t kCompactionFanIn = 8;
+    std::mutex compaction_mutex_;  // single compactor at a time
+    // writes guarded by compaction_mutex_; atomic so eviction may read it
+    std::atomic<int64_t> compacted_until_ = 0;
+    mutable std::shared_mutex compact_mutex_;
+    std::vector<std::shared_ptr<CompactedRun>> compacted_runs_;
+
     tbb::concurrent_vector<std::unique_ptr<knowhere::VecIndex>> data_;
 };
 
@@ -115,6 +188,12 @@ class IndexingRecord {
         Initialize();
     }
 
+    ~IndexingRecord() {
+        // drain in-flight background builds before field indexings die
+        std::unique_lock lck(mutex_);
+        drain_cv_.wait(lck, [this] { return inflight_ == 0; });
+    }
+
     void
     Initialize() {
         int offset_id = 0;
@@ -122,10 +201,6 @@ class IndexingRecord {
             ++offset_id;
 
             if (field_meta.is_vector()) {
-                // TODO: skip binary small index now, reenable after config.yaml is ready
-                if (field_meta.get_data_type() == DataType::VECTOR_BINARY) {
-                    continue;
-                }
                 // flat should be skipped
                 if (!field_meta.get_metric_type().has_value()) {
                     continue;
@@ -185,6 +260,9 @@ class IndexingRecord {
     //    std::atomic<int64_t> finished_ack_ = 0;
     AckResponder finished_ack_;
     std::mutex mutex_;
+    // background build bookkeeping
+    std::atomic<int64_t> inflight_ = 0;
+    std::condition_variable drain_cv_;
 
  private:
     // field_offset => indexing
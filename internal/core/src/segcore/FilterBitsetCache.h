@@ -0,0 +1,81 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+// Bounded LRU of predicate bitsets keyed by expression fingerprint.
+// Dashboard-style workloads re-issue identical boolean filters against
+// sealed segments thousands of times per minute, and a sealed column never
+// changes, so the bitset is stable until data is (re)loaded or dropped;
+// the owning segment clears the cache on such mutations. Only the raw
+// predicate bitset is cached — timestamp and delete masking run per
+// request on top of it.
+class FilterBitsetCache {
+ public:
+    static constexpr size_t kCapacity = 32;
+
+    bool
+    Get(const std::string& key, BitsetType& bitset) {
+        std::lock_guard lck(mutex_);
+        auto iter = map_.find(key);
+        if (iter == map_.end()) {
+            return false;
+        }
+        lru_.splice(lru_.begin(), lru_, iter->second);
+        bitset = iter->second->bitset;
+        return true;
+    }
+
+    void
+    Put(const std::string& key, const BitsetType& bitset) {
+        std::lock_guard lck(mutex_);
+        auto iter = map_.find(key);
+        if (iter != map_.end()) {
+            lru_.splice(lru_.begin(), lru_, iter->second);
+            return;
+        }
+        lru_.push_front(Entry{key, bitset});
+        map_[key] = lru_.begin();
+        if (lru_.size() > kCapacity) {
+            map_.erase(lru_.back().key);
+            lru_.pop_back();
+        }
+    }
+
+    void
+    Clear() {
+        std::lock_guard lck(mutex_);
+        map_.clear();
+        lru_.clear();
+    }
+
+ private:
+    struct Entry {
+        std::string key;
+        BitsetType bitset;
+    };
+
+    std::mutex mutex_;
+    std::list<Entry> lru_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> map_;
+};
+
+}  // namespace milvus::segcore
@@ -0,0 +1,138 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "common/Consts.h"
+#include "common/SimdDispatch.h"
+#include "common/Span.h"
+
+namespace milvus::segcore {
+
+namespace detail {
+
+#if defined(__x86_64__)
+// Masked hardware gathers over a contiguous column; lanes whose offset is
+// INVALID_SEG_OFFSET read nothing and store zero, matching the scalar loop
+// over zero-initialized output. Only compiled with AVX2 codegen here and
+// selected at runtime, the rest of segcore stays baseline x86-64.
+template <typename T>
+__attribute__((target("avx2"))) void
+GatherAvx2(const T* src, const int64_t* seg_offsets, int64_t count, T* dst) {
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+    auto minus_one = _mm256_set1_epi64x(-1);
+    int64_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto vindex = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(seg_offsets + i));
+        auto valid = _mm256_cmpgt_epi64(vindex, minus_one);
+        if constexpr (sizeof(T) == 8) {
+            auto values = _mm256_mask_i64gather_epi64(_mm256_setzero_si256(),
+                                                      reinterpret_cast<const long long*>(src), vindex, valid, 8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), values);
+        } else {
+            // compress the 4x64 validity lanes into the 4x32 mask the
+            // 32-bit gather expects
+            auto valid32 = _mm256_castsi256_si128(
+                _mm256_permutevar8x32_epi32(valid, _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0)));
+            auto values = _mm256_mask_i64gather_epi32(_mm_setzero_si128(), reinterpret_cast<const int*>(src), vindex,
+                                                      valid32, 4);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), values);
+        }
+    }
+    for (; i < count; ++i) {
+        auto offset = seg_offsets[i];
+        if (offset != INVALID_SEG_OFFSET) {
+            dst[i] = src[offset];
+        }
+    }
+}
+#endif
+
+}  // namespace detail
+
+// dst[i] = src[seg_offsets[i]] over a contiguous column, skipping
+// INVALID_SEG_OFFSET entries; 4- and 8-byte elements take hardware gathers
+// when the CPU has AVX2.
+template <typename T>
+void
+gather_scalar(const T* src, const int64_t* seg_offsets, int64_t count, T* dst) {
+#if defined(__x86_64__)
+    if constexpr (std::is_trivially_copyable_v<T> && (sizeof(T) == 4 || sizeof(T) == 8)) {
+        if (UseSimdAvx2()) {
+            detail::GatherAvx2(src, seg_offsets, count, dst);
+            return;
+        }
+    }
+#endif
+    for (int64_t i = 0; i < count; ++i) {
+        // random offsets defeat the stream prefetcher; fetch ahead by hand
+        if (i + kSpanPrefetchRows < count) {
+            auto ahead = seg_offsets[i + kSpanPrefetchRows];
+            if (ahead != INVALID_SEG_OFFSET) {
+                PrefetchRead(src + ahead);
+            }
+        }
+        auto offset = seg_offsets[i];
+        if (offset != INVALID_SEG_OFFSET) {
+            dst[i] = src[offset];
+        }
+    }
+}
+
+// Above this many rows it pays to visit the column in ascending address
+// order: retrieval offsets are effectively random, and wide rows make every
+// touch a cache (or, for mmapped columns, page) miss.
+constexpr int64_t kSortedGatherRows = 128;
+
+// Copies rows of element_sizeof bytes from a contiguous column into dst in
+// offset-list order. Large batches are walked through a permutation sorted
+// by source offset so the column is read sequentially.
+inline void
+gather_rows(const char* src, int64_t element_sizeof, const int64_t* seg_offsets, int64_t count, char* dst) {
+    if (count >= kSortedGatherRows) {
+        std::vector<int32_t> perm(count);
+        std::iota(perm.begin(), perm.end(), 0);
+        std::sort(perm.begin(), perm.end(),
+                  [&seg_offsets](int32_t lhs, int32_t rhs) { return seg_offsets[lhs] < seg_offsets[rhs]; });
+        for (int64_t j = 0; j < count; ++j) {
+            // ascending but non-uniform row strides; prefetch the head line
+            // of an upcoming source row so wide rows don't stall per touch
+            if (j + kSpanPrefetchRows < count) {
+                auto ahead = seg_offsets[perm[j + kSpanPrefetchRows]];
+                if (ahead != INVALID_SEG_OFFSET) {
+                    PrefetchRead(src + ahead * element_sizeof);
+                }
+            }
+            auto i = perm[j];
+            auto offset = seg_offsets[i];
+            if (offset == INVALID_SEG_OFFSET) {
+                std::memset(dst + i * element_sizeof, 0, element_sizeof);
+            } else {
+                std::memcpy(dst + i * element_sizeof, src + offset * element_sizeof, element_sizeof);
+            }
+        }
+        return;
+    }
+    GatherSpanRows(src, element_sizeof, seg_offsets, count, dst);
+}
+
+}  // namespace milvus::segcore
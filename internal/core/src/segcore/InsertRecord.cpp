@@ -14,8 +14,12 @@
 
 namespace milvus::segcore {
 
-InsertRecord::InsertRecord(const Schema& schema, int64_t size_per_chunk)
-    : row_ids_(size_per_chunk), timestamps_(size_per_chunk) {
+InsertRecord::InsertRecord(const Schema& schema,
+                           int64_t size_per_chunk,
+                           ChunkArenaPtr chunk_arena,
+                           bool fp16_vector_storage,
+                           bool dict_varchar_storage)
+    : timestamps_(size_per_chunk, chunk_arena), row_ids_(size_per_chunk, chunk_arena), chunk_arena_(std::move(chunk_arena)) {
     std::optional<FieldId> pk_field_id = schema.get_primary_field_id();
 
     for (auto& field : schema) {
@@ -35,7 +39,11 @@ InsertRecord::InsertRecord(const Schema& schema, int64_t size_per_chunk)
         }
         if (field_meta.is_vector()) {
             if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
-                this->append_field_data<FloatVector>(field_id, field_meta.get_dim(), size_per_chunk);
+                if (fp16_vector_storage) {
+                    this->append_field_data<Float16Vector>(field_id, field_meta.get_dim(), size_per_chunk);
+                } else {
+                    this->append_field_data<FloatVector>(field_id, field_meta.get_dim(), size_per_chunk);
+                }
                 continue;
             } else if (field_meta.get_data_type() == DataType::VECTOR_BINARY) {
                 this->append_field_data<BinaryVector>(field_id, field_meta.get_dim(), size_per_chunk);
@@ -74,7 +82,13 @@ InsertRecord::InsertRecord(const Schema& schema, int64_t size_per_chunk)
                 break;
             }
             case DataType::VARCHAR: {
-                this->append_field_data<std::string>(field_id, size_per_chunk);
+                // pk columns stay plain: their values are near-unique, so a
+                // dictionary would store every value once plus a code per row
+                auto dict_encoded =
+                    dict_varchar_storage && !(pk_field_id.has_value() && pk_field_id.value() == field_id);
+                fields_data_.emplace(field_id, std::make_unique<ConcurrentVector<std::string>>(size_per_chunk,
+                                                                                               chunk_arena_,
+                                                                                               dict_encoded));
                 break;
             }
             default: {
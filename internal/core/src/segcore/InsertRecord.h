@@ -11,7 +11,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <shared_mutex>
 #include <vector>
 #include <unordered_map>
 #include <utility>
@@ -19,6 +22,7 @@
 #include "common/Schema.h"
 #include "segcore/AckResponder.h"
 #include "segcore/ConcurrentVector.h"
+#include "segcore/PkBloomFilter.h"
 #include "segcore/Record.h"
 #include "TimestampIndex.h"
 
@@ -37,18 +41,68 @@ class OffsetMap {
     virtual void
     insert(const PkType pk, int64_t offset) = 0;
 
+    // capacity hint for the pk bloom filter; only effective while the map is
+    // still empty (sealed segments call it once the pk row count is known)
+    virtual void
+    reserve(int64_t num_pks) = 0;
+
+    // folds an installed scan snapshot into the map and retires it; no-op
+    // when no snapshot is pending. See OffsetHashMap::install_scan_snapshot.
+    virtual void
+    publish_from_snapshot() {
+    }
+
     virtual bool
     empty() const = 0;
 };
 
+// Sharded by pk hash so that concurrent inserts and delete lookups mostly
+// land on different locks; each shard is internally synchronized, callers
+// need no extra locking.
 template <typename T>
 class OffsetHashMap : public OffsetMap {
  public:
     std::vector<SegOffset>
     find_with_timestamp(const PkType pk, Timestamp timestamp, const ConcurrentVector<Timestamp>& timestamps) const {
+        return find_with_timestamp(std::get<T>(pk), timestamp, timestamps);
+    }
+
+    std::vector<SegOffset>
+    find_with_barrier(const PkType pk, int64_t barrier) const {
+        return find_with_barrier(std::get<T>(pk), barrier);
+    }
+
+    void
+    insert(const PkType pk, int64_t offset) {
+        insert(std::get<T>(pk), offset);
+    }
+
+    // typed overloads for callers that already resolved the schema pk type;
+    // no variant is built or inspected on these paths
+    std::vector<SegOffset>
+    find_with_timestamp(const T& key, Timestamp timestamp, const ConcurrentVector<Timestamp>& timestamps) const {
         std::vector<SegOffset> res_offsets;
-        auto offset_iter = map_.find(std::get<T>(pk));
-        if (offset_iter != map_.end()) {
+        // before the bloom filter: while a sealed load's map build is still
+        // pending, the filter is unpopulated and the snapshot is the truth
+        if (auto snapshot = scan_snapshot()) {
+            auto [lo, hi] = scan_range(*snapshot, key);
+            for (auto offset = lo; offset < hi; ++offset) {
+                if (timestamps[offset] <= timestamp) {
+                    res_offsets.push_back(SegOffset(offset));
+                }
+            }
+            return res_offsets;
+        }
+        // delete replay probes every segment with the partition's pks, so
+        // most keys belong elsewhere; answer those from the bloom filter
+        // without touching a shard lock
+        if (!bloom_.may_contain(PkBloomFilter::hash_pk(key))) {
+            return res_offsets;
+        }
+        auto& shard = get_shard(key);
+        std::shared_lock lck(shard.mutex);
+        auto offset_iter = shard.map.find(key);
+        if (offset_iter != shard.map.end()) {
             for (auto offset : offset_iter->second) {
                 if (timestamps[offset] <= timestamp) {
                     res_offsets.push_back(SegOffset(offset));
@@ -59,10 +113,24 @@ class OffsetHashMap : public OffsetMap {
     }
 
     std::vector<SegOffset>
-    find_with_barrier(const PkType pk, int64_t barrier) const {
+    find_with_barrier(const T& key, int64_t barrier) const {
         std::vector<SegOffset> res_offsets;
-        auto offset_iter = map_.find(std::get<T>(pk));
-        if (offset_iter != map_.end()) {
+        if (auto snapshot = scan_snapshot()) {
+            auto [lo, hi] = scan_range(*snapshot, key);
+            for (auto offset = lo; offset < hi; ++offset) {
+                if (offset <= barrier) {
+                    res_offsets.push_back(SegOffset(offset));
+                }
+            }
+            return res_offsets;
+        }
+        if (!bloom_.may_contain(PkBloomFilter::hash_pk(key))) {
+            return res_offsets;
+        }
+        auto& shard = get_shard(key);
+        std::shared_lock lck(shard.mutex);
+        auto offset_iter = shard.map.find(key);
+        if (offset_iter != shard.map.end()) {
             for (auto offset : offset_iter->second) {
                 if (offset <= barrier) {
                     res_offsets.push_back(SegOffset(offset));
@@ -73,17 +141,185 @@ class OffsetHashMap : public OffsetMap {
     }
 
     void
-    insert(const PkType pk, int64_t offset) {
-        map_[std::get<T>(pk)].emplace_back(offset);
+    insert(const T& key, int64_t offset) {
+        // bloom first: a reader that finds the key in the map (after the
+        // lock below publishes it) must already see the filter bits set
+        bloom_.add(PkBloomFilter::hash_pk(key));
+        auto& shard = get_shard(key);
+        std::lock_guard lck(shard.mutex);
+        shard.map[key].emplace_back(offset);
+    }
+
+    // publishes one writer's reserved range [start_offset, start_offset +
+    // keys.size()) in a single pass: rows are bucketed per shard up front so
+    // each shard lock is taken once per batch instead of once per row
+    void
+    insert_batch(const std::vector<T>& keys, int64_t start_offset) {
+        insert_batch(keys.data(), static_cast<int64_t>(keys.size()), start_offset);
+    }
+
+    // pointer form so a bulk builder can slice one pk column across workers
+    // without copying; concurrent calls are safe (shard locks plus the
+    // atomic bloom filter), each slice keying its offsets off its own base
+    void
+    insert_batch(const T* keys, int64_t count, int64_t start_offset) {
+        std::array<std::vector<int64_t>, kNumShards> buckets;
+        for (int64_t i = 0; i < count; ++i) {
+            bloom_.add(PkBloomFilter::hash_pk(keys[i]));
+            auto shard_id = std::hash<T>{}(keys[i]) & (kNumShards - 1);
+            buckets[shard_id].push_back(i);
+        }
+        for (size_t shard_id = 0; shard_id < kNumShards; ++shard_id) {
+            if (buckets[shard_id].empty()) {
+                continue;
+            }
+            auto& shard = shards_[shard_id];
+            std::lock_guard lck(shard.mutex);
+            for (auto i : buckets[shard_id]) {
+                shard.map[keys[i]].emplace_back(start_offset + i);
+            }
+        }
+    }
+
+    // batch probe for delete-log replay: keys are partitioned per shard so
+    // each shard lock is taken once for the whole batch, and the per-key
+    // offset storage is prefetched while later probes resolve. consume(i,
+    // offset) fires for every offset of keys[i] at or below the barrier.
+    template <typename Consumer>
+    void
+    find_batch_with_barrier(const std::vector<T>& keys, int64_t barrier, Consumer&& consume) const {
+        if (auto snapshot = scan_snapshot()) {
+            for (int64_t i = 0; i < static_cast<int64_t>(keys.size()); ++i) {
+                auto [lo, hi] = scan_range(*snapshot, keys[i]);
+                for (auto offset = lo; offset < hi; ++offset) {
+                    if (offset <= barrier) {
+                        consume(i, offset);
+                    }
+                }
+            }
+            return;
+        }
+        std::array<std::vector<int64_t>, kNumShards> buckets;
+        for (int64_t i = 0; i < static_cast<int64_t>(keys.size()); ++i) {
+            // the bloom filter eliminates keys that belong to other segments
+            // before any shard lock or hash-map probe
+            if (!bloom_.may_contain(PkBloomFilter::hash_pk(keys[i]))) {
+                continue;
+            }
+            auto shard_id = std::hash<T>{}(keys[i]) & (kNumShards - 1);
+            buckets[shard_id].push_back(i);
+        }
+        std::vector<const std::vector<int64_t>*> hits;
+        for (size_t shard_id = 0; shard_id < kNumShards; ++shard_id) {
+            auto& probe_order = buckets[shard_id];
+            if (probe_order.empty()) {
+                continue;
+            }
+            auto& shard = shards_[shard_id];
+            std::shared_lock lck(shard.mutex);
+            // resolve every node first; by the time the offsets are walked
+            // below, the prefetched lines have had the full shard pass to
+            // arrive
+            hits.assign(probe_order.size(), nullptr);
+            for (size_t j = 0; j < probe_order.size(); ++j) {
+                auto offset_iter = shard.map.find(keys[probe_order[j]]);
+                if (offset_iter != shard.map.end()) {
+                    hits[j] = &offset_iter->second;
+                    __builtin_prefetch(offset_iter->second.data());
+                }
+            }
+            for (size_t j = 0; j < probe_order.size(); ++j) {
+                if (hits[j] == nullptr) {
+                    continue;
+                }
+                for (auto offset : *hits[j]) {
+                    if (offset <= barrier) {
+                        consume(probe_order[j], offset);
+                    }
+                }
+            }
+        }
+    }
+
+    void
+    reserve(int64_t num_pks) override {
+        if (empty()) {
+            bloom_.reset(num_pks);
+        }
+    }
+
+    // Hands over a pk column whose rows are already in key order (flush
+    // writes sealed pk columns sorted), so lookups can binary-search it —
+    // a matching key's positions are exactly its row offsets. The hash map
+    // is then built from the snapshot off the serving path and swapped in
+    // by publish_from_snapshot(). Only valid while the map is empty.
+    void
+    install_scan_snapshot(std::vector<T>&& keys) {
+        Assert(std::is_sorted(keys.begin(), keys.end()));
+        Assert(empty());
+        std::atomic_store_explicit(&snapshot_, std::make_shared<const std::vector<T>>(std::move(keys)),
+                                   std::memory_order_release);
+    }
+
+    void
+    publish_from_snapshot() override {
+        auto snapshot = scan_snapshot();
+        if (snapshot == nullptr) {
+            return;
+        }
+        bloom_.reset(static_cast<int64_t>(snapshot->size()));
+        insert_batch(*snapshot, 0);
+        // readers racing the retirement keep their own reference; anyone who
+        // loads null afterwards finds the rows under the shard locks instead
+        std::atomic_store_explicit(&snapshot_, std::shared_ptr<const std::vector<T>>(), std::memory_order_release);
     }
 
     bool
     empty() const {
-        return map_.empty();
+        if (scan_snapshot() != nullptr) {
+            return false;
+        }
+        for (auto& shard : shards_) {
+            std::shared_lock lck(shard.mutex);
+            if (!shard.map.empty()) {
+                return false;
+            }
+        }
+        return true;
     }
 
  private:
-    std::unordered_map<T, std::vector<int64_t>> map_;
+    static constexpr size_t kNumShards = 16;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<T, std::vector<int64_t>> map;
+    };
+
+    Shard&
+    get_shard(const T& key) const {
+        return shards_[std::hash<T>{}(key) & (kNumShards - 1)];
+    }
+
+    std::shared_ptr<const std::vector<T>>
+    scan_snapshot() const {
+        return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+    }
+
+    // contiguous run of rows equal to key; positions double as offsets
+    static std::pair<int64_t, int64_t>
+    scan_range(const std::vector<T>& keys, const T& key) {
+        auto [first, last] = std::equal_range(keys.begin(), keys.end(), key);
+        return {first - keys.begin(), last - keys.begin()};
+    }
+
+    mutable std::array<Shard, kNumShards> shards_;
+    // growing segments start at the default capacity and keep adding; the
+    // filter degrades gracefully past it, it never gives a false negative
+    PkBloomFilter bloom_;
+    // sorted pk column serving lookups until the shards are populated;
+    // accessed only through the atomic shared_ptr free functions
+    std::shared_ptr<const std::vector<T>> snapshot_;
 };
 
 struct InsertRecord {
@@ -100,29 +336,118 @@ struct InsertRecord {
     // pks to row offset
     std::unique_ptr<OffsetMap> pk2offset_;
 
-    explicit InsertRecord(const Schema& schema, int64_t size_per_chunk);
+    explicit InsertRecord(const Schema& schema,
+                          int64_t size_per_chunk,
+                          ChunkArenaPtr chunk_arena = nullptr,
+                          bool fp16_vector_storage = false,
+                          bool dict_varchar_storage = false);
 
     std::vector<SegOffset>
     search_pk(const PkType pk, Timestamp timestamp) const {
-        std::shared_lock lck(shared_mutex_);
         return pk2offset_->find_with_timestamp(pk, timestamp, timestamps_);
     }
 
     std::vector<SegOffset>
     search_pk(const PkType pk, int64_t insert_barrier) const {
-        std::shared_lock lck(shared_mutex_);
         return pk2offset_->find_with_barrier(pk, insert_barrier);
     }
 
     void
     insert_pk(const PkType pk, int64_t offset) {
-        std::lock_guard lck(shared_mutex_);
         pk2offset_->insert(pk, offset);
     }
 
+    // sizes the pk bloom filter before a sealed load's insert loop; no-op
+    // once pks exist
+    void
+    reserve_pks(int64_t num_pks) {
+        pk2offset_->reserve(num_pks);
+    }
+
+    // monomorphic fast paths: a caller that has already switched on the
+    // schema pk type goes straight to the concrete map, paying no variant
+    // construction or tag dispatch per pk
+    std::vector<SegOffset>
+    search_pk(int64_t pk, Timestamp timestamp) const {
+        return typed_map<int64_t>()->find_with_timestamp(pk, timestamp, timestamps_);
+    }
+
+    std::vector<SegOffset>
+    search_pk(int64_t pk, int64_t insert_barrier) const {
+        return typed_map<int64_t>()->find_with_barrier(pk, insert_barrier);
+    }
+
+    std::vector<SegOffset>
+    search_pk(const std::string& pk, Timestamp timestamp) const {
+        return typed_map<std::string>()->find_with_timestamp(pk, timestamp, timestamps_);
+    }
+
+    std::vector<SegOffset>
+    search_pk(const std::string& pk, int64_t insert_barrier) const {
+        return typed_map<std::string>()->find_with_barrier(pk, insert_barrier);
+    }
+
+    void
+    insert_pk(int64_t pk, int64_t offset) {
+        typed_map<int64_t>()->insert(pk, offset);
+    }
+
+    void
+    insert_pk(const std::string& pk, int64_t offset) {
+        typed_map<std::string>()->insert(pk, offset);
+    }
+
+    // batch publication for ingest lanes: each writer owns a reserved range
+    // and lands its pks with one pass over the shards
+    void
+    insert_pks(const std::vector<int64_t>& pks, int64_t start_offset) {
+        typed_map<int64_t>()->insert_batch(pks, start_offset);
+    }
+
+    void
+    insert_pks(const std::vector<std::string>& pks, int64_t start_offset) {
+        typed_map<std::string>()->insert_batch(pks, start_offset);
+    }
+
+    // slice form for parallel bulk builds: several workers may land disjoint
+    // ranges of the same pk column concurrently
+    void
+    insert_pks(const int64_t* pks, int64_t count, int64_t start_offset) {
+        typed_map<int64_t>()->insert_batch(pks, count, start_offset);
+    }
+
+    void
+    insert_pks(const std::string* pks, int64_t count, int64_t start_offset) {
+        typed_map<std::string>()->insert_batch(pks, count, start_offset);
+    }
+
+    // sealed fast path: lookups binary-search the sorted pk column while the
+    // hash map builds in the background; publish_pk_index() swaps the map in
+    void
+    install_pk_scan_snapshot(std::vector<int64_t>&& pks) {
+        typed_map<int64_t>()->install_scan_snapshot(std::move(pks));
+    }
+
+    void
+    install_pk_scan_snapshot(std::vector<std::string>&& pks) {
+        typed_map<std::string>()->install_scan_snapshot(std::move(pks));
+    }
+
+    void
+    publish_pk_index() {
+        pk2offset_->publish_from_snapshot();
+    }
+
+    // batch counterpart of search_pk for delete-log replay: one locked pass
+    // per shard for the whole pk batch instead of a dependent lookup per pk
+    template <typename T, typename Consumer>
+    void
+    search_pks(const std::vector<T>& pks, int64_t insert_barrier, Consumer&& consume) const {
+        typed_map<T>()->find_batch_with_barrier(pks, insert_barrier, std::forward<Consumer>(consume));
+    }
+
     bool
     empty_pks() const {
-        std::shared_lock lck(shared_mutex_);
         return pk2offset_->empty();
     }
 
@@ -160,7 +485,7 @@ struct InsertRecord {
     void
     append_field_data(FieldId field_id, int64_t size_per_chunk) {
         static_assert(IsScalar<Type>);
-        fields_data_.emplace(field_id, std::make_unique<ConcurrentVector<Type>>(size_per_chunk));
+        fields_data_.emplace(field_id, std::make_unique<ConcurrentVector<Type>>(size_per_chunk, chunk_arena_));
     }
 
     // append a column of vector type
@@ -168,7 +493,7 @@ struct InsertRecord {
     void
     append_field_data(FieldId field_id, int64_t dim, int64_t size_per_chunk) {
         static_assert(std::is_base_of_v<VectorTrait, VectorType>);
-        fields_data_.emplace(field_id, std::make_unique<ConcurrentVector<VectorType>>(dim, size_per_chunk));
+        fields_data_.emplace(field_id, std::make_unique<ConcurrentVector<VectorType>>(dim, size_per_chunk, chunk_arena_));
     }
 
     void
@@ -177,9 +502,18 @@ struct InsertRecord {
     }
 
  private:
+    template <typename T>
+    OffsetHashMap<T>*
+    typed_map() const {
+        auto ptr = dynamic_cast<OffsetHashMap<T>*>(pk2offset_.get());
+        Assert(ptr);
+        return ptr;
+    }
+
+    // all chunks of this record draw from the segment's arena (may be null)
+    ChunkArenaPtr chunk_arena_;
     //    std::vector<std::unique_ptr<VectorBase>> fields_data_;
     std::unordered_map<FieldId, std::unique_ptr<VectorBase>> fields_data_;
-    mutable std::shared_mutex shared_mutex_;
 };
 
 }  // namespace milvus::segcore
@@ -0,0 +1,93 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <chrono>
+
+#include "common/Metrics.h"
+#include "segcore/LoadAdmission.h"
+
+namespace milvus::segcore {
+
+LoadAdmission&
+LoadAdmission::GetInstance() {
+    static LoadAdmission instance;
+    return instance;
+}
+
+void
+LoadAdmission::SetBudget(int64_t bytes) {
+    {
+        std::lock_guard lck(mutex_);
+        budget_ = bytes;
+    }
+    // a larger budget may admit queued loads; a disabled one admits all
+    cv_.notify_all();
+}
+
+void
+LoadAdmission::Acquire(int64_t bytes) {
+    // in-use bytes and queued loads as running counters, so the metrics
+    // snapshot shows the admission state a rebalance wave is in
+    static auto& in_use_counter = MetricsRegistry::GetInstance().GetCounter("segcore.load.admission_bytes_in_use");
+    static auto& waiters_counter = MetricsRegistry::GetInstance().GetCounter("segcore.load.admission_queued");
+    static auto& wait_hist = MetricsRegistry::GetInstance().GetHistogram("segcore.load.admission_wait_ns");
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::unique_lock lck(mutex_);
+        ++waiters_;
+        waiters_counter.Increment();
+        cv_.wait(lck, [&] {
+            // oversized requests go alone once the budget has drained, so a
+            // segment bigger than the whole budget still loads
+            return budget_ == 0 || in_use_ + bytes <= budget_ || in_use_ == 0;
+        });
+        --waiters_;
+        waiters_counter.Increment(-1);
+        // charged even while admission is disabled, so the in-use bytes
+        // stay an honest gauge of transient load memory either way
+        in_use_ += bytes;
+        in_use_counter.Increment(bytes);
+    }
+    auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    wait_hist.Observe(waited.count());
+}
+
+void
+LoadAdmission::Release(int64_t bytes) {
+    static auto& in_use_counter = MetricsRegistry::GetInstance().GetCounter("segcore.load.admission_bytes_in_use");
+    {
+        std::lock_guard lck(mutex_);
+        in_use_ -= bytes;
+        in_use_counter.Increment(-bytes);
+    }
+    cv_.notify_all();
+}
+
+int64_t
+LoadAdmission::budget() const {
+    std::lock_guard lck(mutex_);
+    return budget_;
+}
+
+int64_t
+LoadAdmission::bytes_in_use() const {
+    std::lock_guard lck(mutex_);
+    return in_use_;
+}
+
+int64_t
+LoadAdmission::queue_depth() const {
+    std::lock_guard lck(mutex_);
+    return waiters_;
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,88 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+#include <utility>
+
+namespace milvus::segcore {
+
+// Node-wide byte budget for the transient cost of segment loads. Decoding a
+// binlog or index blob briefly needs roughly twice its wire size (proto plus
+// decoded column), so a rebalance wave of concurrent loads can OOM a node
+// whose steady state fits comfortably. Loads declare their estimated
+// transient bytes up front and block here until the bytes fit, turning that
+// spike into queuing on the load path.
+//
+// A budget of zero (the default) disables admission entirely. A single
+// request larger than the whole budget is admitted once nothing else holds
+// bytes, so an oversized segment degrades to serialized loading instead of
+// deadlocking.
+class LoadAdmission {
+ public:
+    static LoadAdmission&
+    GetInstance();
+
+    // zero disables admission; shrinking below the bytes currently held
+    // only affects future admissions
+    void
+    SetBudget(int64_t bytes);
+
+    // blocks until bytes fit in the budget
+    void
+    Acquire(int64_t bytes);
+
+    void
+    Release(int64_t bytes);
+
+    int64_t
+    budget() const;
+
+    int64_t
+    bytes_in_use() const;
+
+    // loads currently blocked waiting for budget; with the in-use bytes
+    // this is the backlog the Go side watches during a rebalance wave
+    int64_t
+    queue_depth() const;
+
+ private:
+    LoadAdmission() = default;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    int64_t budget_ = 0;
+    int64_t in_use_ = 0;
+    int64_t waiters_ = 0;
+};
+
+// holds admitted bytes for one load operation; releases on destruction so
+// every early return and exception path gives the budget back
+class LoadAdmissionGuard {
+ public:
+    explicit LoadAdmissionGuard(int64_t bytes) : bytes_(bytes) {
+        LoadAdmission::GetInstance().Acquire(bytes_);
+    }
+    LoadAdmissionGuard(const LoadAdmissionGuard&) = delete;
+    LoadAdmissionGuard&
+    operator=(const LoadAdmissionGuard&) = delete;
+    ~LoadAdmissionGuard() {
+        LoadAdmission::GetInstance().Release(bytes_);
+    }
+
+ private:
+    int64_t bytes_;
+};
+
+}  // namespace milvus::segcore
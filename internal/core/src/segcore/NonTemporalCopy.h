@@ -0,0 +1,81 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(MILVUS_USE_NON_TEMPORAL_COPY) && defined(__SSE2__)
+#include <emmintrin.h>
+#define MILVUS_NON_TEMPORAL_COPY_ENABLED 1
+#endif
+
+namespace milvus::segcore {
+
+// Copies below this size stay in the cache hierarchy: the data is likely to
+// be searched soon and fits without evicting much. Above it (a handful of
+// 768-dim float rows already crosses this) the copy is a pure stream and
+// non-temporal stores keep it from flushing the search working set.
+constexpr size_t kNonTemporalCopyThreshold = 256 << 10;
+
+#ifdef MILVUS_NON_TEMPORAL_COPY_ENABLED
+inline void
+nt_copy_bytes(void* dst, const void* src, size_t bytes) {
+    auto d = static_cast<char*>(dst);
+    auto s = static_cast<const char*>(src);
+    // chunks are allocator-aligned, but tolerate odd offsets from partial fills
+    auto head = (16 - (reinterpret_cast<uintptr_t>(d) & 15)) & 15;
+    head = std::min(head, bytes);
+    std::memcpy(d, s, head);
+    d += head;
+    s += head;
+    bytes -= head;
+    while (bytes >= 64) {
+        auto x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        auto x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+        auto x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+        auto x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d), x0);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), x1);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), x2);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), x3);
+        d += 64;
+        s += 64;
+        bytes -= 64;
+    }
+    std::memcpy(d, s, bytes);
+    // make streamed data visible to other cores before the ack is published
+    _mm_sfence();
+}
+#endif
+
+// Drop-in replacement for std::copy_n on chunk fills: small or non-trivial
+// element copies take the plain path, large trivially-copyable ones bypass
+// the cache with streaming stores.
+template <typename T>
+inline void
+bulk_copy(const T* src, size_t count, T* dst) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+#ifdef MILVUS_NON_TEMPORAL_COPY_ENABLED
+        auto bytes = count * sizeof(T);
+        if (bytes >= kNonTemporalCopyThreshold) {
+            nt_copy_bytes(dst, src, bytes);
+            return;
+        }
+#endif
+    }
+    std::copy_n(src, count, dst);
+}
+
+}  // namespace milvus::segcore
@@ -0,0 +1,116 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace milvus::segcore {
+
+// Blocked bloom filter over a segment's primary-key set. Delete propagation
+// replays the partition's whole delete log against every segment, so almost
+// all pk probes miss; the filter answers those misses from one cache line
+// instead of a shard lock plus a hash-map lookup. All probe bits of a key
+// live in a single 64-byte block selected by the upper hash bits, inserts
+// OR words atomically (growing segments add pks concurrently with delete
+// replay), and queries are wait-free. False positives only cost the probe
+// that would have happened anyway; false negatives cannot occur.
+class PkBloomFilter {
+ public:
+    // sized for ~10 bits per key at the nominal capacity (~1% false
+    // positives); past capacity the filter stays correct and degrades to
+    // answering "maybe" more often
+    explicit PkBloomFilter(int64_t capacity = kDefaultCapacity) {
+        reset(capacity);
+    }
+
+    // re-sizes an empty filter; only valid before any add (sealed segments
+    // call this once the pk row count is known, ahead of the insert loop)
+    void
+    reset(int64_t capacity) {
+        int64_t blocks_needed = (capacity * kBitsPerKey + kBitsPerBlock - 1) / kBitsPerBlock;
+        int64_t num_blocks = 1;
+        while (num_blocks < blocks_needed) {
+            num_blocks <<= 1;
+        }
+        block_mask_ = num_blocks - 1;
+        words_ = std::make_unique<std::atomic<uint64_t>[]>(num_blocks * kWordsPerBlock);
+        for (int64_t i = 0; i < num_blocks * kWordsPerBlock; ++i) {
+            words_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void
+    add(uint64_t hash) {
+        auto base = block_of(hash) * kWordsPerBlock;
+        uint64_t h1 = hash;
+        uint64_t h2 = hash >> 17 | hash << 47;
+        for (int i = 0; i < kProbes; ++i) {
+            auto bit = (h1 + i * h2) & (kBitsPerBlock - 1);
+            words_[base + (bit >> 6)].fetch_or(uint64_t(1) << (bit & 63), std::memory_order_relaxed);
+        }
+    }
+
+    bool
+    may_contain(uint64_t hash) const {
+        auto base = block_of(hash) * kWordsPerBlock;
+        uint64_t h1 = hash;
+        uint64_t h2 = hash >> 17 | hash << 47;
+        for (int i = 0; i < kProbes; ++i) {
+            auto bit = (h1 + i * h2) & (kBitsPerBlock - 1);
+            if ((words_[base + (bit >> 6)].load(std::memory_order_relaxed) & (uint64_t(1) << (bit & 63))) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // finalizer mix (murmur3 fmix64) so sequential int64 pks spread over
+    // blocks; std::hash is identity for integers on common stdlibs
+    static uint64_t
+    hash_pk(int64_t pk) {
+        auto h = static_cast<uint64_t>(pk);
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    static uint64_t
+    hash_pk(const std::string& pk) {
+        return hash_pk(static_cast<int64_t>(std::hash<std::string>{}(pk)));
+    }
+
+ private:
+    static constexpr int64_t kDefaultCapacity = 1 << 20;  // growing segments size up front
+    static constexpr int64_t kBitsPerKey = 10;
+    static constexpr int64_t kBitsPerBlock = 512;  // one cache line
+    static constexpr int64_t kWordsPerBlock = kBitsPerBlock / 64;
+    static constexpr int kProbes = 7;
+
+    int64_t
+    block_of(uint64_t hash) const {
+        // block selection uses the top bits, probe bits the bottom; keeps
+        // the two independent for power-of-two block counts
+        return static_cast<int64_t>(hash >> 32) & block_mask_;
+    }
+
+    std::unique_ptr<std::atomic<uint64_t>[]> words_;
+    int64_t block_mask_ = 0;
+};
+
+}  // namespace milvus::segcore
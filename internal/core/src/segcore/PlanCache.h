@@ -0,0 +1,110 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "query/Plan.h"
+
+namespace milvus::segcore {
+
+// LRU cache of compiled search plans, keyed by schema identity plus the
+// serialized plan bytes. Applications issue a handful of plan shapes with
+// only placeholder values changing, so repeated requests can skip protobuf
+// parsing and plan-tree construction entirely. Plans handed through the C
+// API are pinned so a cached plan stays alive until every Go-side handle
+// has been deleted, even after LRU eviction.
+class PlanCache {
+ public:
+    static constexpr size_t kCapacity = 64;
+
+    static PlanCache&
+    GetInstance() {
+        static PlanCache cache;
+        return cache;
+    }
+
+    // returns the cached plan for key, or compiles one via creator
+    template <typename Creator>
+    std::shared_ptr<query::Plan>
+    GetOrCreate(const std::string& key, Creator creator) {
+        {
+            std::lock_guard lck(mutex_);
+            auto iter = map_.find(key);
+            if (iter != map_.end()) {
+                lru_.splice(lru_.begin(), lru_, iter->second);
+                return iter->second->plan;
+            }
+        }
+        auto plan = creator();
+        std::lock_guard lck(mutex_);
+        auto iter = map_.find(key);
+        if (iter != map_.end()) {
+            // lost a compile race; keep the incumbent so handles stay shared
+            lru_.splice(lru_.begin(), lru_, iter->second);
+            return iter->second->plan;
+        }
+        lru_.push_front(Entry{key, plan});
+        map_[key] = lru_.begin();
+        if (lru_.size() > kCapacity) {
+            map_.erase(lru_.back().key);
+            lru_.pop_back();
+        }
+        return plan;
+    }
+
+    // keeps the plan alive while a raw handle is held across the C boundary
+    void
+    Pin(std::shared_ptr<query::Plan> plan) {
+        std::lock_guard lck(mutex_);
+        auto& pin = pins_[plan.get()];
+        pin.plan = std::move(plan);
+        ++pin.refs;
+    }
+
+    // releases one handle; returns false when the pointer was never pinned
+    // (e.g. a plan created outside the cache), so the caller must delete it
+    bool
+    Unpin(const query::Plan* plan) {
+        std::lock_guard lck(mutex_);
+        auto iter = pins_.find(plan);
+        if (iter == pins_.end()) {
+            return false;
+        }
+        if (--iter->second.refs == 0) {
+            pins_.erase(iter);
+        }
+        return true;
+    }
+
+ private:
+    struct Entry {
+        std::string key;
+        std::shared_ptr<query::Plan> plan;
+    };
+    struct PinEntry {
+        std::shared_ptr<query::Plan> plan;
+        int64_t refs = 0;
+    };
+
+    std::mutex mutex_;
+    std::list<Entry> lru_;
+    std::unordered_map<std::string, std::list<Entry>::iterator> map_;
+    std::unordered_map<const query::Plan*, PinEntry> pins_;
+};
+
+}  // namespace milvus::segcore
@@ -10,18 +10,58 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <cstdint>
+#include <cstring>
+#include <future>
+#include <numeric>
+#include <unordered_set>
 #include <vector>
 #include <algorithm>
+#include <arrow/util/compression.h>
+#include <google/protobuf/arena.h>
 #include <log/Log.h>
 
 #include "Reduce.h"
+#include "common/Metrics.h"
+#include "common/ThreadPool.h"
 #include "pkVisitor.h"
+#include "SegcoreConfig.h"
 #include "SegmentInterface.h"
 #include "ReduceStructure.h"
 #include "Utils.h"
 
 namespace milvus::segcore {
 
+namespace {
+
+// runs fn(i) for i in [0, n) on the shared worker pool; a single item (or
+// none) stays on the caller's thread
+template <typename Fn>
+void
+ParallelForIndex(int64_t n, Fn fn) {
+    if (n <= 1) {
+        for (int64_t i = 0; i < n; ++i) {
+            fn(i);
+        }
+        return;
+    }
+    auto& pool = ThreadPool::GetInstance(ThreadPoolRole::Search);
+    std::vector<std::future<void>> futures;
+    futures.reserve(n);
+    for (int64_t i = 0; i < n; ++i) {
+        futures.emplace_back(pool.Submit([&fn, i] { fn(i); }));
+    }
+    // wait for everything before get() may rethrow, so no task outlives
+    // the captured state
+    for (auto& future : futures) {
+        future.wait();
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+}  // namespace
+
 void
 ReduceHelper::Initialize() {
     AssertInfo(search_results_.size() > 0, "empty search result");
@@ -49,21 +89,86 @@ ReduceHelper::Initialize() {
 
 void
 ReduceHelper::Reduce() {
+    // checkpoints between phases: an abandoned query stops gathering entry
+    // data it will never ship
+    auto cancellation = ScopedTaskOptions::Current().cancellation;
     FillPrimaryKey();
+    cancellation.ThrowIfCancelled();
     ReduceResultData();
+    cancellation.ThrowIfCancelled();
     RefreshSearchResult();
+    cancellation.ThrowIfCancelled();
     FillEntryData();
 }
 
 void
 ReduceHelper::Marshal() {
-    // get search result data blobs of slices
+    ScopedTaskOptions::Current().cancellation.ThrowIfCancelled();
+    // phase 1: slices only read the reduced results, so assemble the protos
+    // in parallel, each on its own arena
+    std::vector<std::unique_ptr<google::protobuf::Arena>> arenas(num_slices_);
+    std::vector<milvus::proto::schema::SearchResultData*> slices(num_slices_);
+    for (auto& arena : arenas) {
+        arena = std::make_unique<google::protobuf::Arena>();
+    }
+    ParallelForIndex(num_slices_, [&](int64_t i) { slices[i] = GetSearchResultDataSlice(i, *arenas[i]); });
+
     search_result_data_blobs_ = std::make_unique<milvus::segcore::SearchResultDataBlobs>();
-    search_result_data_blobs_->blobs.resize(num_slices_);
-    for (int i = 0; i < num_slices_; i++) {
-        auto proto = GetSearchResultDataSlice(i);
-        search_result_data_blobs_->blobs[i] = proto;
+    auto& result = *search_result_data_blobs_;
+
+    // with compression on, serialize and compress every slice on the worker
+    // threads too, where cycles are cheap next to the cross-node bytes they
+    // save; each wire blob is a little-endian uncompressed-size header
+    // followed by one zstd frame
+    auto zstd_level = SegcoreConfig::default_config().get_result_blob_zstd_level();
+    if (zstd_level > 0) {
+        std::vector<std::vector<char>> compressed(num_slices_);
+        ParallelForIndex(num_slices_, [&](int64_t i) {
+            int64_t byte_size = slices[i]->ByteSize();
+            std::vector<char> scratch(byte_size);
+            slices[i]->SerializePartialToArray(scratch.data(), byte_size);
+
+            auto codec = arrow::util::Codec::Create(arrow::Compression::ZSTD, static_cast<int>(zstd_level));
+            AssertInfo(codec.ok(), "failed to create zstd codec: " + codec.status().ToString());
+            auto max_len = (*codec)->MaxCompressedLen(byte_size, reinterpret_cast<const uint8_t*>(scratch.data()));
+            std::vector<char> blob(sizeof(int64_t) + max_len);
+            std::memcpy(blob.data(), &byte_size, sizeof(int64_t));
+            auto compressed_len =
+                (*codec)->Compress(byte_size, reinterpret_cast<const uint8_t*>(scratch.data()), max_len,
+                                   reinterpret_cast<uint8_t*>(blob.data()) + sizeof(int64_t));
+            AssertInfo(compressed_len.ok(), "failed to compress search result blob: " +
+                                                compressed_len.status().ToString());
+            blob.resize(sizeof(int64_t) + *compressed_len);
+            compressed[i] = std::move(blob);
+        });
+
+        std::vector<int64_t> offsets(num_slices_ + 1, 0);
+        for (int64_t i = 0; i < num_slices_; ++i) {
+            offsets[i + 1] = offsets[i] + compressed[i].size();
+        }
+        result.buffer.resize(offsets[num_slices_]);
+        result.blobs.resize(num_slices_);
+        for (int64_t i = 0; i < num_slices_; ++i) {
+            std::copy(compressed[i].begin(), compressed[i].end(), result.buffer.begin() + offsets[i]);
+            result.blobs[i] = std::string_view(result.buffer.data() + offsets[i], compressed[i].size());
+        }
+        return;
     }
+
+    // phase 2: pack the serialized slices back to back into one buffer; the
+    // CGo side then reads every blob out of a single allocation instead of
+    // one vector per slice
+    std::vector<int64_t> offsets(num_slices_ + 1, 0);
+    for (int64_t i = 0; i < num_slices_; ++i) {
+        offsets[i + 1] = offsets[i] + slices[i]->ByteSize();
+    }
+    result.buffer.resize(offsets[num_slices_]);
+    result.blobs.resize(num_slices_);
+    ParallelForIndex(num_slices_, [&](int64_t i) {
+        auto size = offsets[i + 1] - offsets[i];
+        slices[i]->SerializePartialToArray(result.buffer.data() + offsets[i], size);
+        result.blobs[i] = std::string_view(result.buffer.data() + offsets[i], size);
+    });
 }
 
 void
@@ -99,13 +204,18 @@ ReduceHelper::FilterInvalidSearchResult(SearchResult* search_result) {
 
 void
 ReduceHelper::FillPrimaryKey() {
-    std::vector<SearchResult*> valid_search_results;
-    // get primary keys for duplicates removal
-    for (auto search_result : search_results_) {
+    // get primary keys for duplicates removal; segments are independent
+    ParallelForIndex(num_segments_, [&](int64_t i) {
+        auto search_result = search_results_[i];
         FilterInvalidSearchResult(search_result);
         if (search_result->get_total_result_count() > 0) {
             auto segment = static_cast<SegmentInterface*>(search_result->segment_);
             segment->FillPrimaryKeys(plan_, *search_result);
+        }
+    });
+    std::vector<SearchResult*> valid_search_results;
+    for (auto search_result : search_results_) {
+        if (search_result->get_total_result_count() > 0) {
             valid_search_results.emplace_back(search_result);
         }
     }
@@ -115,7 +225,7 @@ ReduceHelper::FillPrimaryKey() {
 
 void
 ReduceHelper::RefreshSearchResult() {
-    for (int i = 0; i < num_segments_; i++) {
+    ParallelForIndex(num_segments_, [&](int64_t i) {
         std::vector<int64_t> real_topks(total_nq_, 0);
         auto search_result = search_results_[i];
         if (search_result->result_offsets_.size() != 0) {
@@ -135,19 +245,41 @@ ReduceHelper::RefreshSearchResult() {
             search_result->seg_offsets_ = std::move(seg_offsets);
         }
         std::partial_sum(real_topks.begin(), real_topks.end(), search_result->topk_per_nq_prefix_sum_.begin() + 1);
-    }
+    });
 }
 
 void
 ReduceHelper::FillEntryData() {
-    for (auto search_result : search_results_) {
-        auto segment = static_cast<milvus::segcore::SegmentInterface*>(search_result->segment_);
-        segment->FillTargetEntry(plan_, *search_result);
+    // flat (segment, field) tasks: output fields are independent gathers
+    // over the segment's one refreshed seg_offsets_ batch, so a wide target
+    // list no longer runs its passes serially on a single worker. Flat
+    // tasks also keep workers from blocking on a nested fan-out.
+    auto num_fields = static_cast<int64_t>(plan_->target_entries_.size());
+    if (num_fields == 0) {
+        return;
+    }
+    std::vector<std::vector<std::unique_ptr<DataArray>>> columns(num_segments_);
+    for (auto& segment_columns : columns) {
+        segment_columns.resize(num_fields);
+    }
+    ParallelForIndex(num_segments_ * num_fields, [&](int64_t task) {
+        auto i = task / num_fields;
+        auto f = task % num_fields;
+        auto search_result = search_results_[i];
+        auto segment = static_cast<milvus::segcore::SegmentInternalInterface*>(search_result->segment_);
+        columns[i][f] = segment->FillTargetEntryField(plan_->target_entries_[f], *search_result);
+    });
+    // publish on this thread: the per-result field map is not safe for
+    // concurrent inserts
+    for (int64_t i = 0; i < num_segments_; ++i) {
+        for (int64_t f = 0; f < num_fields; ++f) {
+            search_results_[i]->output_fields_data_[plan_->target_entries_[f]] = std::move(columns[i][f]);
+        }
     }
 }
 
 int64_t
-ReduceHelper::ReduceSearchResultForOneNQ(int64_t qi, int64_t topk, int64_t& offset) {
+ReduceHelper::ReduceSearchResultForOneNQ(int64_t qi, int64_t topk, std::vector<int64_t>& selected_segments) {
     std::vector<SearchResultPair> result_pairs;
     for (int i = 0; i < num_segments_; i++) {
         auto search_result = search_results_[i];
@@ -166,12 +298,16 @@ ReduceHelper::ReduceSearchResultForOneNQ(int64_t qi, int64_t topk, int64_t& offs
         return 0;
     }
 
+    // keep a heap over the per-segment cursors instead of re-sorting the
+    // whole pair list for every output slot; each pop costs O(log segments)
+    auto heap_less = [](const SearchResultPair& lhs, const SearchResultPair& rhs) { return rhs > lhs; };
+    std::make_heap(result_pairs.begin(), result_pairs.end(), heap_less);
+
     int64_t dup_cnt = 0;
     std::unordered_set<milvus::PkType> pk_set;
-    int64_t prev_offset = offset;
-    while (offset - prev_offset < topk) {
-        std::sort(result_pairs.begin(), result_pairs.end(), std::greater<>());
-        auto& pilot = result_pairs[0];
+    pk_set.reserve(topk);
+    while (static_cast<int64_t>(selected_segments.size()) < topk) {
+        auto& pilot = result_pairs.front();
         auto index = pilot.segment_index_;
         auto pk = pilot.primary_key_;
         // no valid search result for this nq, break to next
@@ -180,14 +316,17 @@ ReduceHelper::ReduceSearchResultForOneNQ(int64_t qi, int64_t topk, int64_t& offs
         }
         // remove duplicates
         if (pk_set.count(pk) == 0) {
-            pilot.search_result_->result_offsets_.push_back(offset++);
+            selected_segments.push_back(index);
             final_search_records_[index][qi].push_back(pilot.offset_);
             pk_set.insert(pk);
         } else {
             // skip entity with same primary key
             dup_cnt++;
         }
-        pilot.reset();
+        // advance the winning cursor and sift it back into place
+        std::pop_heap(result_pairs.begin(), result_pairs.end(), heap_less);
+        result_pairs.back().reset();
+        std::push_heap(result_pairs.begin(), result_pairs.end(), heap_less);
     }
     return dup_cnt;
 }
@@ -203,24 +342,50 @@ ReduceHelper::ReduceResultData() {
         AssertInfo(search_result->primary_keys_.size() == result_count, "incorrect search result primary key size");
     }
 
-    int64_t skip_dup_cnt = 0;
+    std::vector<int64_t> topk_by_qi(total_nq_);
     for (int64_t slice_index = 0; slice_index < num_slices_; slice_index++) {
         auto nq_begin = slice_nqs_prefix_sum_[slice_index];
         auto nq_end = slice_nqs_prefix_sum_[slice_index + 1];
+        for (int64_t qi = nq_begin; qi < nq_end; qi++) {
+            topk_by_qi[qi] = slice_topKs_[slice_index];
+        }
+    }
+
+    // each qi reduces into its own final_search_records_ slots and its own
+    // selection order, so all queries run in parallel
+    std::vector<std::vector<int64_t>> selected_segments(total_nq_);
+    std::vector<int64_t> dup_cnts(total_nq_, 0);
+    ParallelForIndex(total_nq_,
+                     [&](int64_t qi) { dup_cnts[qi] = ReduceSearchResultForOneNQ(qi, topk_by_qi[qi], selected_segments[qi]); });
 
-        // reduce search results
+    // replay the selection order serially to hand out the slice-local result
+    // offsets, exactly as the single-threaded reduce did
+    for (int64_t slice_index = 0; slice_index < num_slices_; slice_index++) {
+        auto nq_begin = slice_nqs_prefix_sum_[slice_index];
+        auto nq_end = slice_nqs_prefix_sum_[slice_index + 1];
         int64_t result_offset = 0;
         for (int64_t qi = nq_begin; qi < nq_end; qi++) {
-            skip_dup_cnt += ReduceSearchResultForOneNQ(qi, slice_topKs_[slice_index], result_offset);
+            for (auto segment_index : selected_segments[qi]) {
+                search_results_[segment_index]->result_offsets_.push_back(result_offset++);
+            }
         }
     }
+
+    auto skip_dup_cnt = std::accumulate(dup_cnts.begin(), dup_cnts.end(), int64_t(0));
     if (skip_dup_cnt > 0) {
         LOG_SEGCORE_DEBUG_ << "skip duplicated search result, count = " << skip_dup_cnt;
     }
+
+    int64_t merged_hits = 0;
+    for (auto& selected : selected_segments) {
+        merged_hits += selected.size();
+    }
+    static auto& merge_size_hist = MetricsRegistry::GetInstance().GetHistogram("segcore.reduce.merged_hits");
+    merge_size_hist.Observe(merged_hits);
 }
 
-std::vector<char>
-ReduceHelper::GetSearchResultDataSlice(int slice_index) {
+milvus::proto::schema::SearchResultData*
+ReduceHelper::GetSearchResultDataSlice(int slice_index, google::protobuf::Arena& arena) {
     auto nq_begin = slice_nqs_prefix_sum_[slice_index];
     auto nq_end = slice_nqs_prefix_sum_[slice_index + 1];
 
@@ -232,7 +397,9 @@ ReduceHelper::GetSearchResultDataSlice(int slice_index) {
             search_result->topk_per_nq_prefix_sum_[nq_end] - search_result->topk_per_nq_prefix_sum_[nq_begin];
     }
 
-    auto search_result_data = std::make_unique<milvus::proto::schema::SearchResultData>();
+    // build the proto on the caller's arena so repeated-field and string
+    // allocations are bump-allocated and freed wholesale after serialization
+    auto search_result_data = google::protobuf::Arena::CreateMessage<milvus::proto::schema::SearchResultData>(&arena);
     // set unify_topK and total_nq
     search_result_data->set_top_k(slice_topKs_[slice_index]);
     search_result_data->set_num_queries(nq_end - nq_begin);
@@ -247,17 +414,15 @@ ReduceHelper::GetSearchResultDataSlice(int slice_index) {
     auto pk_type = plan_->schema_[primary_field_id].get_data_type();
     switch (pk_type) {
         case milvus::DataType::INT64: {
-            auto ids = std::make_unique<milvus::proto::schema::LongArray>();
-            ids->mutable_data()->Resize(result_count, 0);
-            search_result_data->mutable_ids()->set_allocated_int_id(ids.release());
+            search_result_data->mutable_ids()->mutable_int_id()->mutable_data()->Resize(result_count, 0);
             break;
         }
         case milvus::DataType::VARCHAR: {
-            auto ids = std::make_unique<milvus::proto::schema::StringArray>();
-            std::vector<std::string> string_pks(result_count);
-            // TODO: prevent mem copy
-            *ids->mutable_data() = {string_pks.begin(), string_pks.end()};
-            search_result_data->mutable_ids()->set_allocated_str_id(ids.release());
+            auto str_ids = search_result_data->mutable_ids()->mutable_str_id();
+            str_ids->mutable_data()->Reserve(result_count);
+            for (int64_t i = 0; i < result_count; i++) {
+                str_ids->add_data();
+            }
             break;
         }
         default: {
@@ -325,12 +490,148 @@ ReduceHelper::GetSearchResultDataSlice(int slice_index) {
         search_result_data->mutable_fields_data()->AddAllocated(field_data.release());
     }
 
-    // SearchResultData to blob
-    auto size = search_result_data->ByteSize();
-    auto buffer = std::vector<char>(size);
-    search_result_data->SerializePartialToArray(buffer.data(), size);
+    return search_result_data;
+}
 
-    return buffer;
+void
+StreamReduceHelper::AddSearchResult(SearchResult* search_result) {
+    AssertInfo(!finished_, "stream reduce already finished");
+    AssertInfo(search_result != nullptr, "null search result added to stream reduce");
+    if (total_nq_ == 0) {
+        // the first arrival fixes the query layout for the whole session
+        total_nq_ = search_result->total_nq_;
+        slice_nqs_prefix_sum_.resize(num_slices_ + 1);
+        std::partial_sum(slice_nqs_.begin(), slice_nqs_.end(), slice_nqs_prefix_sum_.begin() + 1);
+        AssertInfo(slice_nqs_prefix_sum_[num_slices_] == total_nq_,
+                   "illegal req sizes, slice_nqs_prefix_sum_[last] = " +
+                       std::to_string(slice_nqs_prefix_sum_[num_slices_]) +
+                       ", total_nq = " + std::to_string(total_nq_));
+        topk_by_qi_.resize(total_nq_);
+        for (int64_t slice_index = 0; slice_index < num_slices_; slice_index++) {
+            auto nq_begin = slice_nqs_prefix_sum_[slice_index];
+            auto nq_end = slice_nqs_prefix_sum_[slice_index + 1];
+            for (auto qi = nq_begin; qi < nq_end; qi++) {
+                topk_by_qi_[qi] = slice_topKs_[slice_index];
+            }
+        }
+        merged_hits_.resize(total_nq_);
+        admitted_pks_.resize(total_nq_);
+    } else {
+        AssertInfo(search_result->total_nq_ == total_nq_, "unaligned total_nq between added search results");
+    }
+
+    FilterInvalidSearchResult(search_result);
+    if (search_result->get_total_result_count() == 0) {
+        // nothing to merge and nothing to marshal from this segment
+        return;
+    }
+    auto segment = static_cast<SegmentInterface*>(search_result->segment_);
+    segment->FillPrimaryKeys(plan_, *search_result);
+
+    auto segment_index = num_segments_;
+    search_results_.push_back(search_result);
+    final_search_records_.emplace_back(total_nq_);
+    num_segments_++;
+
+    // queries merge into disjoint per-qi state, so they run in parallel
+    ParallelForIndex(total_nq_, [&](int64_t qi) { MergeHitsForOneNQ(qi, search_result, segment_index); });
+}
+
+void
+StreamReduceHelper::MergeHitsForOneNQ(int64_t qi, SearchResult* search_result, int64_t segment_index) {
+    auto offset_beg = search_result->topk_per_nq_prefix_sum_[qi];
+    auto offset_end = search_result->topk_per_nq_prefix_sum_[qi + 1];
+    if (offset_beg == offset_end) {
+        return;
+    }
+
+    auto& merged = merged_hits_[qi];
+    auto& admitted = admitted_pks_[qi];
+    auto topk = topk_by_qi_[qi];
+
+    // keep only incoming hits that can still matter: a pk already admitted
+    // with a better distance drops here, one admitted with a worse distance
+    // is superseded by this segment's instance
+    std::vector<StreamHit> incoming;
+    incoming.reserve(offset_end - offset_beg);
+    std::unordered_set<milvus::PkType> superseded;
+    std::unordered_set<milvus::PkType> seen_this_round;
+    for (auto offset = offset_beg; offset < offset_end; offset++) {
+        auto& pk = search_result->primary_keys_[offset];
+        auto distance = search_result->distances_[offset];
+        // within one segment the best instance of a duplicated pk comes first
+        if (seen_this_round.count(pk) != 0) {
+            continue;
+        }
+        auto it = admitted.find(pk);
+        if (it != admitted.end()) {
+            if (distance <= it->second) {
+                continue;
+            }
+            superseded.insert(pk);
+        }
+        incoming.push_back(StreamHit{pk, distance, segment_index, offset});
+        seen_this_round.insert(pk);
+    }
+    if (incoming.empty()) {
+        return;
+    }
+
+    // both lists are sorted by distance descending; merge and re-cap
+    std::vector<StreamHit> out;
+    out.reserve(std::min(static_cast<size_t>(topk), merged.size() + incoming.size()));
+    size_t mi = 0;
+    size_t ii = 0;
+    while (static_cast<int64_t>(out.size()) < topk && (mi < merged.size() || ii < incoming.size())) {
+        if (mi < merged.size() && superseded.count(merged[mi].primary_key_) != 0) {
+            mi++;
+            continue;
+        }
+        if (ii >= incoming.size() || (mi < merged.size() && merged[mi].distance_ >= incoming[ii].distance_)) {
+            out.push_back(std::move(merged[mi++]));
+        } else {
+            out.push_back(std::move(incoming[ii++]));
+        }
+    }
+    merged.swap(out);
+
+    // pks evicted past the cap may be re-admitted later with a better
+    // distance, so the admitted set always mirrors the capped list
+    admitted.clear();
+    admitted.reserve(merged.size());
+    for (auto& hit : merged) {
+        admitted.emplace(hit.primary_key_, hit.distance_);
+    }
+}
+
+void
+StreamReduceHelper::Finish() {
+    AssertInfo(!finished_, "stream reduce already finished");
+    AssertInfo(total_nq_ > 0, "no search result was added before finish");
+    finished_ = true;
+
+    // replay the merged selections exactly as the batch reduce replays its
+    // heap order: per-segment records for the refresh, slice-local result
+    // offsets for the marshal
+    for (int64_t qi = 0; qi < total_nq_; qi++) {
+        for (auto& hit : merged_hits_[qi]) {
+            final_search_records_[hit.segment_index_][qi].push_back(hit.offset_);
+        }
+    }
+    for (int64_t slice_index = 0; slice_index < num_slices_; slice_index++) {
+        auto nq_begin = slice_nqs_prefix_sum_[slice_index];
+        auto nq_end = slice_nqs_prefix_sum_[slice_index + 1];
+        int64_t result_offset = 0;
+        for (int64_t qi = nq_begin; qi < nq_end; qi++) {
+            for (auto& hit : merged_hits_[qi]) {
+                search_results_[hit.segment_index_]->result_offsets_.push_back(result_offset++);
+            }
+        }
+    }
+
+    RefreshSearchResult();
+    FillEntryData();
+    Marshal();
 }
 
 }  // namespace milvus::segcore
@@ -14,8 +14,12 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#include <google/protobuf/arena.h>
+
 #include "utils/Status.h"
 #include "common/type_c.h"
 #include "common/QueryResult.h"
@@ -23,9 +27,11 @@
 
 namespace milvus::segcore {
 
-// SearchResultDataBlobs contains the marshal blobs of many `milvus::proto::schema::SearchResultData`
+// SearchResultDataBlobs contains the marshal blobs of many `milvus::proto::schema::SearchResultData`,
+// serialized back to back into one contiguous buffer; blobs[i] views into it
 struct SearchResultDataBlobs {
-    std::vector<std::vector<char>> blobs;
+    std::vector<char> buffer;
+    std::vector<std::string_view> blobs;
 };
 
 class ReduceHelper {
@@ -53,7 +59,20 @@ class ReduceHelper {
         return search_result_data_blobs_.release();
     }
 
- private:
+ protected:
+    // for streaming subclasses: fixes the slice layout up front and leaves
+    // the per-segment state to grow as results arrive
+    ReduceHelper(milvus::query::Plan* plan, int64_t* slice_nqs, int64_t* slice_topKs, int64_t slice_num)
+        : slice_topKs_(slice_topKs, slice_topKs + slice_num),
+          slice_nqs_(slice_nqs, slice_nqs + slice_num),
+          total_nq_(0),
+          num_segments_(0),
+          num_slices_(slice_num),
+          plan_(plan) {
+        AssertInfo(slice_nqs_.size() > 0, "empty slice_nqs");
+        AssertInfo(slice_nqs_.size() == slice_topKs_.size(), "unaligned slice_nqs and slice_topKs");
+    }
+
     void
     Initialize();
 
@@ -69,16 +88,20 @@ class ReduceHelper {
     void
     FillEntryData();
 
+    // fills final_search_records_ and the per-qi selection order; the caller
+    // replays that order to assign result offsets
     int64_t
-    ReduceSearchResultForOneNQ(int64_t qi, int64_t topk, int64_t& result_offset);
+    ReduceSearchResultForOneNQ(int64_t qi, int64_t topk, std::vector<int64_t>& selected_segments);
 
     void
     ReduceResultData();
 
-    std::vector<char>
-    GetSearchResultDataSlice(int slice_index_);
+    // assembles one slice's proto on the given arena; Marshal serializes all
+    // slices into the shared output buffer afterwards
+    milvus::proto::schema::SearchResultData*
+    GetSearchResultDataSlice(int slice_index_, google::protobuf::Arena& arena);
 
- private:
+ protected:
     std::vector<int64_t> slice_topKs_;
     std::vector<int64_t> slice_nqs_;
     int64_t total_nq_;
@@ -86,7 +109,7 @@ class ReduceHelper {
     int64_t num_slices_;
 
     milvus::query::Plan* plan_;
-    std::vector<SearchResult*>& search_results_;
+    std::vector<SearchResult*> search_results_;
 
     std::vector<int64_t> slice_nqs_prefix_sum_;
 
@@ -97,4 +120,48 @@ class ReduceHelper {
     std::unique_ptr<SearchResultDataBlobs> search_result_data_blobs_;
 };
 
+// Reduces per-segment results incrementally as they arrive instead of
+// waiting for the whole fan-out: each AddSearchResult merges one segment's
+// hits into running per-query topk lists, so when the slowest segment
+// lands only its own merge plus the refresh/marshal tail remains. Added
+// SearchResults must stay alive until Finish() has marshalled the blobs
+class StreamReduceHelper : protected ReduceHelper {
+ public:
+    explicit StreamReduceHelper(milvus::query::Plan* plan, int64_t* slice_nqs, int64_t* slice_topKs, int64_t slice_num)
+        : ReduceHelper(plan, slice_nqs, slice_topKs, slice_num) {
+    }
+
+    // merges one segment's result into the running topk lists; adds are
+    // serialized by the caller, queries merge in parallel inside
+    void
+    AddSearchResult(SearchResult* search_result);
+
+    // replays the merged selections into the per-segment records, then runs
+    // the same refresh/fill/marshal tail as the batch reduce
+    void
+    Finish();
+
+    using ReduceHelper::GetSearchResultDataBlobs;
+
+ private:
+    void
+    MergeHitsForOneNQ(int64_t qi, SearchResult* search_result, int64_t segment_index);
+
+ private:
+    // one admitted hit: where the winning row lives and how good it is
+    struct StreamHit {
+        milvus::PkType primary_key_;
+        float distance_;
+        int64_t segment_index_;
+        int64_t offset_;
+    };
+
+    // per query: admitted hits sorted by distance descending and capped at
+    // the query's topk, plus each admitted pk's distance for dedup
+    std::vector<std::vector<StreamHit>> merged_hits_;
+    std::vector<std::unordered_map<milvus::PkType, float>> admitted_pks_;
+    std::vector<int64_t> topk_by_qi_;
+    bool finished_ = false;
+};
+
 }  // namespace milvus::segcore
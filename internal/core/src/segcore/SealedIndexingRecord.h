@@ -11,13 +11,12 @@
 
 #pragma once
 
-#include <map>
-#include <unordered_map>
 #include <memory>
 #include <shared_mutex>
 #include <utility>
-#include <tbb/concurrent_hash_map.h>
+#include <vector>
 
+#include "common/Consts.h"
 #include "common/Types.h"
 #include "exceptions/EasyAssert.h"
 #include "knowhere/index/VecIndex.h"
@@ -31,38 +30,60 @@ struct SealedIndexingEntry {
 
 using SealedIndexingEntryPtr = std::unique_ptr<SealedIndexingEntry>;
 
+// Entries live in a dense array indexed by the field id's offset from
+// START_USER_FIELDID (schemas assign user field ids sequentially from
+// there), so the per-search resolution is a bounds-checked array read
+// instead of a hash probe.
 struct SealedIndexingRecord {
     void
     append_field_indexing(FieldId field_id, const knowhere::MetricType& metric_type, knowhere::VecIndexPtr indexing) {
         auto ptr = std::make_unique<SealedIndexingEntry>();
         ptr->indexing_ = indexing;
         ptr->metric_type_ = metric_type;
+        auto offset = field_offset(field_id);
+        AssertInfo(offset >= 0, "invalid field_id");
         std::unique_lock lck(mutex_);
-        field_indexings_[field_id] = std::move(ptr);
+        if (offset >= static_cast<int64_t>(field_indexings_.size())) {
+            field_indexings_.resize(offset + 1);
+        }
+        field_indexings_[offset] = std::move(ptr);
     }
 
     const SealedIndexingEntry*
     get_field_indexing(FieldId field_id) const {
+        auto offset = field_offset(field_id);
         std::shared_lock lck(mutex_);
-        AssertInfo(field_indexings_.count(field_id), "field_id not found");
-        return field_indexings_.at(field_id).get();
+        AssertInfo(offset >= 0 && offset < static_cast<int64_t>(field_indexings_.size()) &&
+                       field_indexings_[offset] != nullptr,
+                   "field_id not found");
+        return field_indexings_[offset].get();
     }
 
     void
     drop_field_indexing(FieldId field_id) {
+        auto offset = field_offset(field_id);
         std::unique_lock lck(mutex_);
-        field_indexings_.erase(field_id);
+        if (offset >= 0 && offset < static_cast<int64_t>(field_indexings_.size())) {
+            field_indexings_[offset].reset();
+        }
     }
 
     bool
     is_ready(FieldId field_id) const {
+        auto offset = field_offset(field_id);
         std::shared_lock lck(mutex_);
-        return field_indexings_.count(field_id);
+        return offset >= 0 && offset < static_cast<int64_t>(field_indexings_.size()) &&
+               field_indexings_[offset] != nullptr;
     }
 
  private:
-    // field_offset -> SealedIndexingEntry
-    std::unordered_map<FieldId, SealedIndexingEntryPtr> field_indexings_;
+    static int64_t
+    field_offset(FieldId field_id) {
+        return field_id.get() - START_USER_FIELDID;
+    }
+
+    // field offset -> SealedIndexingEntry
+    std::vector<SealedIndexingEntryPtr> field_indexings_;
     mutable std::shared_mutex mutex_;
 };
 
@@ -9,6 +9,8 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+
 #include "common/Schema.h"
 #include "SegcoreConfig.h"
 #include "utils/Json.h"
@@ -42,6 +44,22 @@ apply_parser(const YAML::Node& node, Func func) {
     return results;
 }
 
+int64_t
+SegcoreConfig::get_chunk_rows(const Schema& schema) const {
+    if (target_chunk_bytes_ <= 0) {
+        return chunk_rows_;
+    }
+    int64_t widest = 1;
+    for (auto& [field_id, field_meta] : schema.get_fields()) {
+        widest = std::max(widest, static_cast<int64_t>(field_meta.get_sizeof()));
+    }
+    auto rows = chunk_rows_;
+    while (rows > kMinChunkRows && rows * widest > target_chunk_bytes_) {
+        rows /= 2;
+    }
+    return rows;
+}
+
 void
 SegcoreConfig::parse_from(const std::string& config_path) {
     try {
@@ -51,6 +69,21 @@ SegcoreConfig::parse_from(const std::string& config_path) {
         auto chunk_rows = subnode(seg_config, "chunk_rows").as<int64_t>();
         this->chunk_rows_ = chunk_rows;
 
+        auto fp16_node = seg_config["fp16_vector_storage"];
+        if (fp16_node.IsDefined()) {
+            this->fp16_vector_storage_ = fp16_node.as<bool>();
+        }
+
+        auto coalescing_node = seg_config["search_coalescing"];
+        if (coalescing_node.IsDefined()) {
+            this->search_coalescing_ = coalescing_node.as<bool>();
+        }
+
+        auto small_index_node = seg_config["small_index_type"];
+        if (small_index_node.IsDefined()) {
+            set_small_index_type(small_index_node.as<std::string>());
+        }
+
 #if 0
         auto index_list = subnode(seg_config, "small_index");
 
@@ -18,6 +18,10 @@
 #include "exceptions/EasyAssert.h"
 #include "utils/Json.h"
 
+namespace milvus {
+class Schema;
+}
+
 namespace milvus::segcore {
 
 struct SmallIndexConf {
@@ -29,13 +33,7 @@ struct SmallIndexConf {
 class SegcoreConfig {
  private:
     SegcoreConfig() {
-        // hard code configurations for small index
-        SmallIndexConf sub_conf;
-        sub_conf.build_params["nlist"] = nlist_;
-        sub_conf.search_params["nprobe"] = nprobe_;
-        sub_conf.index_type = "IVF";
-        table_[knowhere::metric::L2] = sub_conf;
-        table_[knowhere::metric::IP] = sub_conf;
+        rebuild_small_index_table();
     }
 
  public:
@@ -65,14 +63,106 @@ class SegcoreConfig {
         chunk_rows_ = chunk_rows;
     }
 
+    // Resolves the chunk row count for one segment's schema. Chunk ids must
+    // stay aligned across a segment's columns, so the width-adaptive policy
+    // yields a single value: the configured count, halved until the widest
+    // field's chunk fits within target_chunk_bytes_. Narrow schemas keep
+    // the configured count unchanged.
+    int64_t
+    get_chunk_rows(const Schema& schema) const;
+
+    // copy of this config with chunk_rows_ resolved for `schema`
+    SegcoreConfig
+    adapt_to_schema(const Schema& schema) const {
+        SegcoreConfig adapted = *this;
+        adapted.chunk_rows_ = get_chunk_rows(schema);
+        return adapted;
+    }
+
+    int64_t
+    get_target_chunk_bytes() const {
+        return target_chunk_bytes_;
+    }
+
+    void
+    set_target_chunk_bytes(int64_t target_chunk_bytes) {
+        target_chunk_bytes_ = target_chunk_bytes;
+    }
+
+    bool
+    get_evict_indexed_vector_chunks() const {
+        return evict_indexed_vector_chunks_;
+    }
+
+    void
+    set_evict_indexed_vector_chunks(bool evict) {
+        evict_indexed_vector_chunks_ = evict;
+    }
+
+    bool
+    get_fp16_vector_storage() const {
+        return fp16_vector_storage_;
+    }
+
+    void
+    set_fp16_vector_storage(bool fp16_vector_storage) {
+        fp16_vector_storage_ = fp16_vector_storage;
+    }
+
+    bool
+    get_dict_varchar_storage() const {
+        return dict_varchar_storage_;
+    }
+
+    void
+    set_dict_varchar_storage(bool dict_varchar_storage) {
+        dict_varchar_storage_ = dict_varchar_storage;
+    }
+
+    int64_t
+    get_result_blob_zstd_level() const {
+        return result_blob_zstd_level_;
+    }
+
+    // compress marshalled search-result blobs before they cross nodes; the
+    // Go side enables its decompressor from the same config knob
+    void
+    set_result_blob_zstd_level(int64_t level) {
+        AssertInfo(level >= 0 && level <= 22, "invalid zstd level: " + std::to_string(level));
+        result_blob_zstd_level_ = level;
+    }
+
+    bool
+    get_search_coalescing() const {
+        return search_coalescing_;
+    }
+
+    void
+    set_search_coalescing(bool search_coalescing) {
+        search_coalescing_ = search_coalescing;
+    }
+
+    int64_t
+    get_search_concurrency() const {
+        return search_concurrency_;
+    }
+
+    void
+    set_search_concurrency(int64_t search_concurrency) {
+        Assert(search_concurrency >= 1);
+        search_concurrency_ = search_concurrency;
+    }
+
     void
     set_nlist(int64_t nlist) {
         nlist_ = nlist;
+        rebuild_small_index_table();
     }
 
     void
     set_nprobe(int64_t nprobe) {
         nprobe_ = nprobe;
+        rebuild_small_index_table();
     }
 
     void
@@ -80,10 +170,85 @@ class SegcoreConfig {
         table_[metric_type] = small_index_conf;
     }
 
+    const std::string&
+    get_small_index_type() const {
+        return small_index_type_;
+    }
+
+    // selects the per-chunk index family for float vectors; applies to
+    // segments created after the call
+    void
+    set_small_index_type(const std::string& index_type) {
+        AssertInfo(index_type == "IVF" || index_type == "HNSW", "unsupported small index type: " + index_type);
+        small_index_type_ = index_type;
+        rebuild_small_index_table();
+    }
+
  private:
+    void
+    rebuild_small_index_table() {
+        SmallIndexConf float_conf;
+        if (small_index_type_ == "HNSW") {
+            // the graph index has no training pass: rows are inserted
+            // incrementally during the chunk build, so sealing a chunk
+            // skips the IVF k-means stall
+            float_conf.index_type = "HNSW";
+            float_conf.build_params["M"] = hnsw_m_;
+            float_conf.build_params["efConstruction"] = ef_construction_;
+            float_conf.search_params["ef"] = ef_;
+        } else {
+            float_conf.index_type = "IVF";
+            float_conf.build_params["nlist"] = nlist_;
+            float_conf.search_params["nprobe"] = nprobe_;
+        }
+        table_[knowhere::metric::L2] = float_conf;
+        table_[knowhere::metric::IP] = float_conf;
+
+        // binary vectors always ride BinaryIVF; knowhere's HNSW is
+        // float-only
+        SmallIndexConf bin_conf;
+        bin_conf.index_type = "BIN_IVF";
+        bin_conf.build_params["nlist"] = nlist_;
+        bin_conf.search_params["nprobe"] = nprobe_;
+        table_[knowhere::metric::HAMMING] = bin_conf;
+        table_[knowhere::metric::JACCARD] = bin_conf;
+    }
+    // floor for width-adapted chunk sizing; below this the per-chunk
+    // overhead (span setup, index units, merge steps) dominates
+    static constexpr int64_t kMinChunkRows = 1024;
+
     int64_t chunk_rows_ = 32 * 1024;
+    // byte budget for one chunk of a segment's widest field; 0 disables
+    // width-adaptive chunk sizing
+    int64_t target_chunk_bytes_ = 32 * 1024 * 1024;
+    // max worker tasks one query may fan chunk searches out to; 1 keeps the
+    // search fully on the caller's thread
+    int64_t search_concurrency_ = 4;
+    // release raw vector chunks whose small index is built, row-verified
+    // and folded into a compacted run; retrieval reconstructs evicted rows
+    // from the per-chunk index
+    bool evict_indexed_vector_chunks_ = false;
+    // store growing float vector chunks as IEEE half bits; halves growing
+    // memory and brute-force bandwidth at a small precision cost
+    bool fp16_vector_storage_ = false;
+    // store non-pk VarChar columns as per-chunk dictionaries plus integer
+    // codes; string predicates become integer compares and low-cardinality
+    // columns shrink to a code per row
+    bool dict_varchar_storage_ = false;
+    // batch concurrent identical searches on a segment into one execution;
+    // trades a small wait window on every search for shared filter
+    // evaluation and higher-nq vector scans under bursty traffic
+    bool search_coalescing_ = false;
+    // zstd level for marshalled search-result blobs; 0 ships them raw
+    int64_t result_blob_zstd_level_ = 0;
+    std::string small_index_type_ = "IVF";
     int64_t nlist_ = 100;
     int64_t nprobe_ = 4;
+    // HNSW small-index knobs; a modest M keeps the per-chunk graphs
+    // compact, ef is a floor that get_search_params raises to topk
+    int64_t hnsw_m_ = 16;
+    int64_t ef_construction_ = 200;
+    int64_t ef_ = 64;
     std::map<knowhere::MetricType, SmallIndexConf> table_;
 };
 
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include "common/LoadInfo.h"
@@ -23,11 +24,32 @@
 
 namespace milvus::segcore {
 
+// One decoded column on the columnar insert path (arrow ingestion).
+// Fixed-width columns point at a contiguous buffer laid out exactly like
+// the segment's elements; VARCHAR columns carry one view per row into
+// caller-owned payload. The buffers only need to live until Insert
+// returns — the chunks copy out of them.
+struct InsertColumnView {
+    FieldId field_id;
+    const void* data = nullptr;               // every type but VARCHAR
+    const std::string_view* views = nullptr;  // VARCHAR only
+};
+
 class SegmentGrowing : public SegmentInternalInterface {
  public:
     virtual void
     disable_small_index() = 0;
 
+    // Opt-in clustered ingest for multi-tenant collections: every insert
+    // batch is reordered so rows sharing the given scalar field's value
+    // land contiguously, which keeps the per-chunk zone maps tight enough
+    // for tenant filters to skip most chunks. Must be called before the
+    // first insert. Because rows move within their batch, timestamps are
+    // no longer sorted inside a batch and query visibility rounds down to
+    // whole insert batches.
+    virtual void
+    enable_clustered_ingest(FieldId cluster_key) = 0;
+
     virtual int64_t
     PreInsert(int64_t size) = 0;
 
@@ -38,6 +60,27 @@ class SegmentGrowing : public SegmentInternalInterface {
            const Timestamp* timestamps,
            const InsertData* insert_data) = 0;
 
+    // columnar variant fed by the arrow ingest path: the buffers are
+    // bulk-copied straight into the chunks, no proto decode in between
+    virtual void
+    Insert(int64_t reserved_offset,
+           int64_t size,
+           const int64_t* row_ids,
+           const Timestamp* timestamps,
+           const std::vector<InsertColumnView>& columns) = 0;
+
+    // One-shot backfill for import: takes every row of an empty segment in
+    // a single call, fills each column with its own load-pool task, and
+    // builds the pk map with the sealed loader's bulk machinery instead of
+    // per-batch bookkeeping. Rows must be pre-validated and in timestamp
+    // order, as flushed import files are. The segment comes out sealed:
+    // PreInsert rejects further batches, deletes still apply.
+    virtual void
+    BulkImport(int64_t size,
+               const int64_t* row_ids,
+               const Timestamp* timestamps,
+               const std::vector<InsertColumnView>& columns) = 0;
+
     // virtual int64_t
     // PreDelete(int64_t size) = 0;
 
@@ -10,12 +10,18 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <algorithm>
+#include <cstring>
+#include <deque>
+#include <future>
 #include <numeric>
 #include <queue>
 #include <thread>
 #include <boost/iterator/counting_iterator.hpp>
 
 #include "common/Consts.h"
+#include "common/Metrics.h"
+#include "common/ThreadPool.h"
+#include "common/Span.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include "query/PlanNode.h"
 #include "query/SearchOnSealed.h"
@@ -28,6 +34,7 @@ namespace milvus::segcore {
 
 int64_t
 SegmentGrowingImpl::PreInsert(int64_t size) {
+    AssertInfo(!import_sealed_, "segment was sealed by a bulk import, no further inserts");
     auto reserved_begin = insert_record_.reserved.fetch_add(size);
     return reserved_begin;
 }
@@ -44,6 +51,10 @@ SegmentGrowingImpl::mask_with_delete(BitsetType& bitset, int64_t ins_barrier, Ti
     if (del_barrier == 0) {
         return;
     }
+    // common case: the query sees the whole applied log, merge in place
+    if (deleted_record_.or_accumulated(del_barrier, bitset)) {
+        return;
+    }
     auto bitmap_holder = get_deleted_bitmap(del_barrier, ins_barrier, deleted_record_, insert_record_, timestamp);
     if (!bitmap_holder || !bitmap_holder->bitmap_ptr) {
         return;
@@ -53,6 +64,35 @@ SegmentGrowingImpl::mask_with_delete(BitsetType& bitset, int64_t ins_barrier, Ti
     bitset |= delete_bitset;
 }
 
+int64_t
+SegmentGrowingImpl::get_real_count() const {
+    auto insert_cnt = get_row_count();
+    auto del_barrier = get_barrier(get_deleted_record(), MAX_TIMESTAMP);
+    if (del_barrier == 0) {
+        return insert_cnt;
+    }
+    // fold any unapplied suffix of the delete log into the accumulated
+    // bitmap (a no-op when queries already advanced it), then read the
+    // maintained popcount instead of building a bitset
+    advance_deleted_bitmap(deleted_record_, insert_record_, del_barrier, insert_cnt);
+    auto [deleted, applied_barrier] = deleted_record_.accumulated_popcount();
+    if (applied_barrier >= del_barrier) {
+        return insert_cnt - deleted;
+    }
+    // a concurrent delete moved the log mid-read; take the exact path
+    return SegmentInternalInterface::get_real_count();
+}
+
+void
+SegmentGrowingImpl::enable_clustered_ingest(FieldId cluster_key) {
+    AssertInfo(insert_record_.ack_responder_.GetAck() == 0 && clustered_batches_.empty(),
+               "clustered ingest must be enabled before the first insert");
+    auto data_type = schema_->operator[](cluster_key).get_data_type();
+    AssertInfo(data_type == DataType::INT64 || data_type == DataType::VARCHAR,
+               "cluster key must be an INT64 or VARCHAR scalar field");
+    cluster_key_field_ = cluster_key;
+}
+
 void
 SegmentGrowingImpl::Insert(int64_t reserved_offset,
                            int64_t size,
@@ -74,60 +114,415 @@ SegmentGrowingImpl::Insert(int64_t reserved_offset,
     // step 2: sort timestamp
     // query node already guarantees that the timestamp is ordered, avoid field data copy in c++
 
+    // step 2.5: clustered ingest reorders the batch by the cluster-key value
+    // so each chunk holds few distinct values and the zone maps stay tight.
+    // Row ids, timestamps and every column move together, so pk lookups and
+    // MVCC stay exact; only the intra-batch timestamp order is given up,
+    // which get_active_count compensates for with a batch-granular cut.
+    std::vector<int64_t> perm;
+    std::vector<int64_t> permuted_row_ids;
+    std::vector<Timestamp> permuted_timestamps;
+    std::vector<std::unique_ptr<DataArray>> permuted_fields;
+    if (cluster_key_field_.has_value()) {
+        auto key_fid = cluster_key_field_.value();
+        AssertInfo(field_id_to_offset.count(key_fid), "cluster key field missing from insert data");
+        auto& key_data = insert_data->fields_data(field_id_to_offset[key_fid]);
+        perm.resize(size);
+        std::iota(perm.begin(), perm.end(), 0);
+        if (schema_->operator[](key_fid).get_data_type() == DataType::INT64) {
+            auto& keys = key_data.scalars().long_data().data();
+            std::stable_sort(perm.begin(), perm.end(), [&](int64_t a, int64_t b) { return keys[a] < keys[b]; });
+        } else {
+            auto& keys = key_data.scalars().string_data().data();
+            std::stable_sort(perm.begin(), perm.end(), [&](int64_t a, int64_t b) { return keys[a] < keys[b]; });
+        }
+        permuted_row_ids.resize(size);
+        permuted_timestamps.resize(size);
+        for (int64_t i = 0; i < size; ++i) {
+            permuted_row_ids[i] = row_ids[perm[i]];
+            permuted_timestamps[i] = timestamps_raw[perm[i]];
+        }
+        row_ids = permuted_row_ids.data();
+        timestamps_raw = permuted_timestamps.data();
+        permuted_fields.resize(insert_data->fields_data_size());
+    }
+
     // step 3: fill into Segment.ConcurrentVector
     insert_record_.timestamps_.set_data_raw(reserved_offset, timestamps_raw, size);
     insert_record_.row_ids_.set_data_raw(reserved_offset, row_ids, size);
     for (auto [field_id, field_meta] : schema_->get_fields()) {
         AssertInfo(field_id_to_offset.count(field_id), "Cannot find field_id");
         auto data_offset = field_id_to_offset[field_id];
-        insert_record_.get_field_data_base(field_id)->set_data_raw(reserved_offset, size,
-                                                                   &insert_data->fields_data(data_offset), field_meta);
+        const DataArray* field_data = &insert_data->fields_data(data_offset);
+        if (cluster_key_field_.has_value()) {
+            permuted_fields[data_offset] = PermuteDataArray(*field_data, field_meta, perm);
+            field_data = permuted_fields[data_offset].get();
+        }
+        insert_record_.get_field_data_base(field_id)->set_data_raw(reserved_offset, size, field_data, field_meta);
     }
 
     // step 4: set pks to offset
     auto field_id = schema_->get_primary_field_id().value_or(FieldId(-1));
     AssertInfo(field_id.get() != INVALID_FIELD_ID, "Primary key is -1");
-    std::vector<PkType> pks(size);
-    ParsePksFromFieldData(pks, insert_data->fields_data(field_id_to_offset[field_id]));
-    for (int i = 0; i < size; ++i) {
-        insert_record_.insert_pk(pks[i], reserved_offset + i);
+    auto pk_data_offset = field_id_to_offset[field_id];
+    const DataArray& pk_data = cluster_key_field_.has_value() ? *permuted_fields[pk_data_offset]
+                                                              : insert_data->fields_data(pk_data_offset);
+    // dispatch on the pk type once, then publish the whole reserved range
+    // as one batch: concurrent writers each take every pk shard lock at
+    // most once per insert instead of once per row
+    switch (schema_->operator[](field_id).get_data_type()) {
+        case DataType::INT64: {
+            std::vector<int64_t> pks(size);
+            ParsePksFromFieldData(pks, pk_data);
+            insert_record_.insert_pks(pks, reserved_offset);
+            break;
+        }
+        case DataType::VARCHAR: {
+            std::vector<std::string> pks(size);
+            ParsePksFromFieldData(pks, pk_data);
+            insert_record_.insert_pks(pks, reserved_offset);
+            break;
+        }
+        default: {
+            PanicInfo("unsupported pk type");
+        }
     }
 
-    // step 5: update small indexes
+    // step 5: ack the range, update small indexes, publish batch metadata
+    publish_insert_batch(reserved_offset, size, timestamps_raw);
+}
+
+void
+SegmentGrowingImpl::publish_insert_batch(int64_t reserved_offset, int64_t size, const Timestamp* timestamps_raw) {
     insert_record_.ack_responder_.AddSegment(reserved_offset, reserved_offset + size);
     if (enable_small_index_) {
         int64_t chunk_rows = segcore_config_.get_chunk_rows();
         indexing_record_.UpdateResourceAck(insert_record_.ack_responder_.GetAck() / chunk_rows, insert_record_);
+        // builds finish asynchronously, so each batch sweeps up whatever
+        // earlier batches left covered; the raw tail after ingest stops
+        // stays resident, bounded by the compaction fan-in
+        if (segcore_config_.get_evict_indexed_vector_chunks()) {
+            evict_indexed_raw_chunks();
+        }
+    }
+
+    // the batch's timestamp envelope feeds the clustered visibility cut;
+    // kept sorted by begin offset
+    if (cluster_key_field_.has_value()) {
+        Timestamp max_ts = size == 0 ? 0 : *std::max_element(timestamps_raw, timestamps_raw + size);
+        std::unique_lock lck(batch_meta_mutex_);
+        auto iter = std::lower_bound(clustered_batches_.begin(), clustered_batches_.end(), reserved_offset,
+                                     [](const IngestBatch& batch, int64_t begin) { return batch.begin < begin; });
+        clustered_batches_.insert(iter, IngestBatch{reserved_offset, reserved_offset + size, max_ts});
     }
 }
 
+void
+SegmentGrowingImpl::evict_indexed_raw_chunks() {
+    // one evictor at a time; the next batch's ack re-triggers soon enough
+    std::unique_lock eviction(eviction_mutex_, std::try_to_lock);
+    if (!eviction.owns_lock()) {
+        return;
+    }
+    static auto& evicted_bytes = MetricsRegistry::GetInstance().GetCounter("segcore.growing.evicted_raw_bytes");
+    auto finished_ack = indexing_record_.get_finished_ack();
+    auto size_per_chunk = segcore_config_.get_chunk_rows();
+    for (auto& [field_id, field_meta] : schema_->get_fields()) {
+        if (!field_meta.is_vector() || !field_meta.get_metric_type().has_value() ||
+            !indexing_record_.is_in(field_id)) {
+            continue;
+        }
+        auto& state = eviction_state_[field_id];
+        if (state.unsupported) {
+            continue;
+        }
+        auto vec_base = insert_record_.get_field_data_base(field_id);
+        if (dynamic_cast<const ConcurrentVector<Float16Vector>*>(vec_base) != nullptr) {
+            // half storage already halved the column, and its indexes hold
+            // up-converted float32 rows the fp16 gather path cannot serve
+            state.unsupported = true;
+            continue;
+        }
+        auto& indexing = indexing_record_.get_vec_field_indexing(field_id);
+        // stop below the compaction watermark: the compactor re-stages raw
+        // chunks of runs still being folded on the build pool without the
+        // segment lock, so those must stay resident until their run lands
+        auto ceiling = std::min(finished_ack, indexing.compacted_until());
+        if (state.evicted_until >= ceiling) {
+            continue;
+        }
+
+        auto row_bytes = field_meta.get_sizeof();
+        aligned_vector<char> probe(row_bytes);
+        // retrieval holds the shared lock for its whole gather, so rows it
+        // already resolved to raw pointers stay resident until it finishes
+        std::unique_lock seg_lock(mutex_);
+        while (state.evicted_until < ceiling) {
+            auto chunk_id = state.evicted_until;
+            auto raw = static_cast<const char*>(vec_base->get_chunk_data(chunk_id));
+            // "verified" is literal: the index must hand back the chunk's
+            // stored rows bit-exactly before the originals go away
+            bool verified = true;
+            for (int64_t probe_offset : {int64_t(0), size_per_chunk - 1}) {
+                if (!indexing.reconstruct_from_index(chunk_id, &probe_offset, 1, probe.data()) ||
+                    std::memcmp(probe.data(), raw + probe_offset * row_bytes, row_bytes) != 0) {
+                    verified = false;
+                    break;
+                }
+            }
+            if (!verified) {
+                // the chunk's index family keeps codes, not rows; raw stays
+                // for the whole field from here on
+                state.unsupported = true;
+                break;
+            }
+            evicted_bytes.Increment(vec_base->release_chunk(chunk_id));
+            state.evicted_until = chunk_id + 1;
+        }
+    }
+}
+
+void
+SegmentGrowingImpl::Insert(int64_t reserved_offset,
+                           int64_t size,
+                           const int64_t* row_ids,
+                           const Timestamp* timestamps_raw,
+                           const std::vector<InsertColumnView>& columns) {
+    std::unordered_map<FieldId, const InsertColumnView*> field_columns;
+    for (auto& column : columns) {
+        AssertInfo(!field_columns.count(column.field_id), "duplicate field data");
+        field_columns.emplace(column.field_id, &column);
+    }
+
+    // clustered ingest: same batch reorder as the proto path, applied to
+    // the raw buffers through scratch copies
+    std::vector<int64_t> perm;
+    std::vector<int64_t> permuted_row_ids;
+    std::vector<Timestamp> permuted_timestamps;
+    std::deque<std::vector<char>> permuted_buffers;
+    std::deque<std::vector<std::string_view>> permuted_views;
+    std::vector<InsertColumnView> permuted_columns;
+    if (cluster_key_field_.has_value()) {
+        auto key_fid = cluster_key_field_.value();
+        auto key_iter = field_columns.find(key_fid);
+        AssertInfo(key_iter != field_columns.end(), "cluster key field missing from insert data");
+        perm.resize(size);
+        std::iota(perm.begin(), perm.end(), 0);
+        if (schema_->operator[](key_fid).get_data_type() == DataType::INT64) {
+            auto keys = static_cast<const int64_t*>(key_iter->second->data);
+            std::stable_sort(perm.begin(), perm.end(), [&](int64_t a, int64_t b) { return keys[a] < keys[b]; });
+        } else {
+            auto keys = key_iter->second->views;
+            std::stable_sort(perm.begin(), perm.end(), [&](int64_t a, int64_t b) { return keys[a] < keys[b]; });
+        }
+        permuted_row_ids.resize(size);
+        permuted_timestamps.resize(size);
+        for (int64_t i = 0; i < size; ++i) {
+            permuted_row_ids[i] = row_ids[perm[i]];
+            permuted_timestamps[i] = timestamps_raw[perm[i]];
+        }
+        row_ids = permuted_row_ids.data();
+        timestamps_raw = permuted_timestamps.data();
+
+        permuted_columns.reserve(columns.size());
+        for (auto& column : columns) {
+            auto& field_meta = schema_->operator[](column.field_id);
+            if (field_meta.get_data_type() == DataType::VARCHAR) {
+                auto& views = permuted_views.emplace_back(size);
+                for (int64_t i = 0; i < size; ++i) {
+                    views[i] = column.views[perm[i]];
+                }
+                permuted_columns.push_back(InsertColumnView{column.field_id, nullptr, views.data()});
+            } else {
+                auto row_bytes = field_meta.get_sizeof();
+                auto& buffer = permuted_buffers.emplace_back(size * row_bytes);
+                auto src = static_cast<const char*>(column.data);
+                for (int64_t i = 0; i < size; ++i) {
+                    std::memcpy(buffer.data() + i * row_bytes, src + perm[i] * row_bytes, row_bytes);
+                }
+                permuted_columns.push_back(InsertColumnView{column.field_id, buffer.data(), nullptr});
+            }
+        }
+        for (auto& column : permuted_columns) {
+            field_columns[column.field_id] = &column;
+        }
+    }
+
+    // fill into Segment.ConcurrentVector: fixed-width buffers land via one
+    // bulk copy per chunk, string views via the chunk's payload blocks
+    insert_record_.timestamps_.set_data_raw(reserved_offset, timestamps_raw, size);
+    insert_record_.row_ids_.set_data_raw(reserved_offset, row_ids, size);
+    for (auto [field_id, field_meta] : schema_->get_fields()) {
+        auto iter = field_columns.find(field_id);
+        AssertInfo(iter != field_columns.end(), "Cannot find field_id");
+        auto* column = iter->second;
+        if (field_meta.get_data_type() == DataType::VARCHAR) {
+            AssertInfo(column->views != nullptr, "VARCHAR column carries no views");
+            auto vec = dynamic_cast<ConcurrentVector<std::string>*>(insert_record_.get_field_data_base(field_id));
+            Assert(vec);
+            vec->set_data_from(reserved_offset, column->views, size);
+        } else {
+            AssertInfo(column->data != nullptr, "column carries no data");
+            insert_record_.get_field_data_base(field_id)->set_data_raw(reserved_offset, column->data, size);
+        }
+    }
+
+    // publish pks straight from the column buffer
+    auto pk_field_id = schema_->get_primary_field_id().value_or(FieldId(-1));
+    AssertInfo(pk_field_id.get() != INVALID_FIELD_ID, "Primary key is -1");
+    auto* pk_column = field_columns.at(pk_field_id);
+    switch (schema_->operator[](pk_field_id).get_data_type()) {
+        case DataType::INT64: {
+            auto data = static_cast<const int64_t*>(pk_column->data);
+            std::vector<int64_t> pks(data, data + size);
+            insert_record_.insert_pks(pks, reserved_offset);
+            break;
+        }
+        case DataType::VARCHAR: {
+            std::vector<std::string> pks;
+            pks.reserve(size);
+            for (int64_t i = 0; i < size; ++i) {
+                pks.emplace_back(pk_column->views[i]);
+            }
+            insert_record_.insert_pks(pks, reserved_offset);
+            break;
+        }
+        default: {
+            PanicInfo("unsupported pk type");
+        }
+    }
+
+    publish_insert_batch(reserved_offset, size, timestamps_raw);
+}
+
+template <typename T>
+void
+SegmentGrowingImpl::import_pk_map(std::vector<T>&& pks) {
+    insert_record_.reserve_pks(static_cast<int64_t>(pks.size()));
+    auto& pool = ThreadPool::GetInstance(ThreadPoolRole::Load);
+    if (std::is_sorted(pks.begin(), pks.end())) {
+        // import files flush the pk column sorted: lookups binary-search the
+        // snapshot right away while the shard map builds behind it, same as
+        // a sealed load
+        insert_record_.install_pk_scan_snapshot(std::move(pks));
+        pk_index_future_ = pool.Submit([this] { insert_record_.publish_pk_index(); });
+        return;
+    }
+    // unsorted files still build in bulk: disjoint slices of the column land
+    // concurrently, safe under the shard locks and the atomic bloom filter
+    constexpr int64_t kPksPerTask = 1 << 20;
+    auto shared_pks = std::make_shared<std::vector<T>>(std::move(pks));
+    auto total = static_cast<int64_t>(shared_pks->size());
+    std::vector<std::future<void>> futures;
+    futures.reserve(upper_div(total, kPksPerTask));
+    for (int64_t begin = 0; begin < total; begin += kPksPerTask) {
+        auto count = std::min(kPksPerTask, total - begin);
+        futures.emplace_back(pool.Submit(
+            [this, shared_pks, begin, count] { insert_record_.insert_pks(shared_pks->data() + begin, count, begin); }));
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
+void
+SegmentGrowingImpl::BulkImport(int64_t size,
+                               const int64_t* row_ids,
+                               const Timestamp* timestamps_raw,
+                               const std::vector<InsertColumnView>& columns) {
+    AssertInfo(size > 0, "empty bulk import");
+    AssertInfo(!import_sealed_ && insert_record_.reserved == 0 && insert_record_.ack_responder_.GetAck() == 0,
+               "bulk import requires an empty segment");
+    AssertInfo(!cluster_key_field_.has_value(), "bulk import keeps file order; cluster the import files upstream");
+    std::unordered_map<FieldId, const InsertColumnView*> field_columns;
+    for (auto& column : columns) {
+        AssertInfo(!field_columns.count(column.field_id), "duplicate field data");
+        field_columns.emplace(column.field_id, &column);
+    }
+
+    insert_record_.reserved.fetch_add(size);
+
+    // one load-pool task per column: each fills its own ConcurrentVector in
+    // chunk-sized bulk copies, so the import uses every core instead of
+    // replaying the fields serially batch by batch
+    auto& pool = ThreadPool::GetInstance(ThreadPoolRole::Load);
+    std::vector<std::future<void>> futures;
+    futures.reserve(schema_->get_fields().size() + 2);
+    futures.emplace_back(pool.Submit([&] { insert_record_.timestamps_.set_data_raw(0, timestamps_raw, size); }));
+    futures.emplace_back(pool.Submit([&] { insert_record_.row_ids_.set_data_raw(0, row_ids, size); }));
+    for (auto [field_id, field_meta] : schema_->get_fields()) {
+        auto iter = field_columns.find(field_id);
+        AssertInfo(iter != field_columns.end(), "Cannot find field_id");
+        auto* column = iter->second;
+        auto is_varchar = field_meta.get_data_type() == DataType::VARCHAR;
+        futures.emplace_back(pool.Submit([this, fid = field_id, column, size, is_varchar] {
+            if (is_varchar) {
+                AssertInfo(column->views != nullptr, "VARCHAR column carries no views");
+                auto vec = dynamic_cast<ConcurrentVector<std::string>*>(insert_record_.get_field_data_base(fid));
+                Assert(vec);
+                vec->set_data_from(0, column->views, size);
+            } else {
+                AssertInfo(column->data != nullptr, "column carries no data");
+                insert_record_.get_field_data_base(fid)->set_data_raw(0, column->data, size);
+            }
+        }));
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    // the pk map builds from the whole column at once; sorted columns keep
+    // serving lookups off the snapshot while the shard map retires in the
+    // background
+    auto pk_field_id = schema_->get_primary_field_id().value_or(FieldId(-1));
+    AssertInfo(pk_field_id.get() != INVALID_FIELD_ID, "Primary key is -1");
+    auto* pk_column = field_columns.at(pk_field_id);
+    switch (schema_->operator[](pk_field_id).get_data_type()) {
+        case DataType::INT64: {
+            auto data = static_cast<const int64_t*>(pk_column->data);
+            import_pk_map(std::vector<int64_t>(data, data + size));
+            break;
+        }
+        case DataType::VARCHAR: {
+            std::vector<std::string> pks;
+            pks.reserve(size);
+            for (int64_t i = 0; i < size; ++i) {
+                pks.emplace_back(pk_column->views[i]);
+            }
+            import_pk_map(std::move(pks));
+            break;
+        }
+        default: {
+            PanicInfo("unsupported pk type");
+        }
+    }
+
+    // import files are timestamp-ordered, so the filled timestamps_ column
+    // is the timestamp index: get_barrier binary-searches it directly.
+    // Acking the whole range at once also kicks the small indexes for every
+    // covered chunk in one sweep.
+    publish_insert_batch(0, size, timestamps_raw);
+    import_sealed_ = true;
+}
+
 Status
 SegmentGrowingImpl::Delete(int64_t reserved_begin, int64_t size, const IdArray* ids, const Timestamp* timestamps_raw) {
     auto field_id = schema_->get_primary_field_id().value_or(FieldId(-1));
     AssertInfo(field_id.get() != -1, "Primary key is -1");
-    auto& field_meta = schema_->operator[](field_id);
-    std::vector<PkType> pks(size);
-    ParsePksFromIDs(pks, field_meta.get_data_type(), *ids);
-
-    // step 1: sort timestamp
-    std::vector<std::tuple<Timestamp, PkType>> ordering(size);
-    for (int i = 0; i < size; i++) {
-        ordering[i] = std::make_tuple(timestamps_raw[i], pks[i]);
-    }
-    std::sort(ordering.begin(), ordering.end());
-    std::vector<PkType> sort_pks(size);
-    std::vector<Timestamp> sort_timestamps(size);
 
-    for (int i = 0; i < size; i++) {
-        auto [t, pk] = ordering[i];
-        sort_timestamps[i] = t;
-        sort_pks[i] = pk;
-    }
+    // step 1 & 2: sort by timestamp and merge into the delete log together
+    // with any staged concurrent batches
+    stage_delete_records(deleted_record_, *ids, timestamps_raw, size, reserved_begin);
 
-    // step 2: fill delete record
-    deleted_record_.timestamps_.set_data_raw(reserved_begin, sort_timestamps.data(), size);
-    deleted_record_.pks_.set_data_raw(reserved_begin, sort_pks.data(), size);
-    deleted_record_.ack_responder_.AddSegment(reserved_begin, reserved_begin + size);
+    // step 3: fold the acked prefix into the accumulated bitmap here, off the query path
+    advance_deleted_bitmap(deleted_record_, insert_record_, deleted_record_.ack_responder_.GetAck(),
+                           insert_record_.ack_responder_.GetAck());
     return Status::OK();
 }
 
@@ -136,12 +531,34 @@ SegmentGrowingImpl::GetMemoryUsageInBytes() const {
     int64_t total_bytes = 0;
     auto chunk_rows = segcore_config_.get_chunk_rows();
     int64_t ins_n = upper_align(insert_record_.reserved, chunk_rows);
-    total_bytes += ins_n * (schema_->get_total_sizeof() + 16 + 1);
+    int64_t row_bytes = schema_->get_total_sizeof() + 16 + 1;
+    if (segcore_config_.get_fp16_vector_storage()) {
+        for (auto& [fid, field_meta] : schema_->get_fields()) {
+            if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
+                row_bytes -= field_meta.get_sizeof() / 2;
+            }
+        }
+    }
+    total_bytes += ins_n * row_bytes;
     int64_t del_n = upper_align(deleted_record_.reserved, chunk_rows);
     total_bytes += del_n * (16 * 2);
     return total_bytes;
 }
 
+int64_t
+SegmentGrowingImpl::GetFieldMemoryUsageInBytes(FieldId field_id) const {
+    // column capacity is deterministic from the reserved row count, so the
+    // per-field breakdown needs no extra state
+    auto chunk_rows = segcore_config_.get_chunk_rows();
+    int64_t ins_n = upper_align(insert_record_.reserved, chunk_rows);
+    auto& field_meta = schema_->operator[](field_id);
+    int64_t row_bytes = field_meta.get_sizeof();
+    if (segcore_config_.get_fp16_vector_storage() && field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
+        row_bytes /= 2;
+    }
+    return ins_n * row_bytes;
+}
+
 void
 SegmentGrowingImpl::LoadDeletedRecord(const LoadDeletedRecordInfo& info) {
     AssertInfo(info.row_count > 0, "The row count of deleted record is 0");
@@ -150,17 +567,15 @@ SegmentGrowingImpl::LoadDeletedRecord(const LoadDeletedRecordInfo& info) {
     // step 1: get pks and timestamps
     auto field_id = schema_->get_primary_field_id().value_or(FieldId(INVALID_FIELD_ID));
     AssertInfo(field_id.get() != INVALID_FIELD_ID, "Primary key has invalid field id");
-    auto& field_meta = schema_->operator[](field_id);
     int64_t size = info.row_count;
-    std::vector<PkType> pks(size);
-    ParsePksFromIDs(pks, field_meta.get_data_type(), *info.primary_keys);
     auto timestamps = reinterpret_cast<const Timestamp*>(info.timestamps);
 
     // step 2: fill pks and timestamps
     auto reserved_begin = deleted_record_.reserved.fetch_add(size);
-    deleted_record_.pks_.set_data_raw(reserved_begin, pks.data(), size);
-    deleted_record_.timestamps_.set_data_raw(reserved_begin, timestamps, size);
-    deleted_record_.ack_responder_.AddSegment(reserved_begin, reserved_begin + size);
+    append_delete_records(deleted_record_, *info.primary_keys, timestamps, size, reserved_begin, false);
+
+    advance_deleted_bitmap(deleted_record_, insert_record_, deleted_record_.ack_responder_.GetAck(),
+                           insert_record_.ack_responder_.GetAck());
 }
 
 SpanBase
@@ -169,13 +584,60 @@ SegmentGrowingImpl::chunk_data_impl(FieldId field_id, int64_t chunk_id) const {
     return vec->get_span_base(chunk_id);
 }
 
+SegmentInternalInterface::StringDictView
+SegmentGrowingImpl::chunk_string_dict_view(FieldId field_id, int64_t chunk_id) const {
+    if ((*schema_)[field_id].get_data_type() != DataType::VARCHAR) {
+        return {};
+    }
+    auto vec = dynamic_cast<const ConcurrentVector<std::string>*>(insert_record_.get_field_data_base(field_id));
+    if (vec == nullptr || !vec->dictionary_encoded() || chunk_id >= vec->num_chunk()) {
+        return {};
+    }
+    auto& chunk = vec->get_chunk(chunk_id);
+    return {chunk.codes(), &chunk};
+}
+
+std::shared_ptr<const SegmentGrowingImpl::TailChunkSnapshot>
+SegmentGrowingImpl::get_tail_chunk_snapshot(FieldId field_id, int64_t chunk_id, int64_t visible_rows) const {
+    auto& field_meta = (*schema_)[field_id];
+    AssertInfo(field_meta.is_vector(), "tail chunk snapshot only supports vector fields");
+    auto vec = get_insert_record().get_field_data_base(field_id);
+    auto row_size = field_meta.get_sizeof();
+    if (dynamic_cast<const ConcurrentVector<Float16Vector>*>(vec) != nullptr) {
+        // the column stores half bits, not the schema's float32 rows
+        row_size /= 2;
+    }
+
+    std::lock_guard lck(tail_snapshot_mutex_);
+    auto& cached = tail_snapshots_[field_id];
+    // a snapshot taken at a later barrier covers every earlier one: rows
+    // below the requester's barrier were already published when it was copied
+    if (cached != nullptr && cached->chunk_id == chunk_id && cached->visible_rows >= visible_rows) {
+        return cached;
+    }
+
+    auto snapshot = std::make_shared<TailChunkSnapshot>();
+    snapshot->chunk_id = chunk_id;
+    snapshot->visible_rows = visible_rows;
+    snapshot->data.resize(visible_rows * row_size);
+    memcpy(snapshot->data.data(), vec->get_chunk_data(chunk_id), visible_rows * row_size);
+    cached = snapshot;
+    return snapshot;
+}
+
+bool
+SegmentGrowingImpl::chunk_min_max_impl(FieldId field_id, int64_t chunk_id, void* min_value, void* max_value) const {
+    auto vec = get_insert_record().get_field_data_base(field_id);
+    return vec->get_chunk_minmax(chunk_id, min_value, max_value);
+}
+
 int64_t
 SegmentGrowingImpl::num_chunk() const {
     auto size = get_insert_record().ack_responder_.GetAck();
     return upper_div(size, segcore_config_.get_chunk_rows());
 }
 
-void
+Status
 SegmentGrowingImpl::vector_search(query::SearchInfo& search_info,
                                   const void* query_data,
                                   int64_t query_count,
@@ -184,11 +646,10 @@ SegmentGrowingImpl::vector_search(query::SearchInfo& search_info,
                                   SearchResult& output) const {
     auto& sealed_indexing = this->get_sealed_indexing_record();
     if (sealed_indexing.is_ready(search_info.field_id_)) {
-        query::SearchOnSealedIndex(this->get_schema(), sealed_indexing, search_info, query_data, query_count, bitset,
-                                   output);
-    } else {
-        query::SearchOnGrowing(*this, search_info, query_data, query_count, timestamp, bitset, output);
+        return query::SearchOnSealedIndex(this->get_schema(), sealed_indexing, search_info, query_data, query_count,
+                                          bitset, output);
     }
+    return query::SearchOnGrowing(*this, search_info, query_data, query_count, timestamp, bitset, output);
 }
 
 std::unique_ptr<DataArray>
@@ -199,9 +660,21 @@ SegmentGrowingImpl::bulk_subscript(FieldId field_id, const int64_t* seg_offsets,
     if (field_meta.is_vector()) {
         aligned_vector<char> output(field_meta.get_sizeof() * count);
         if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
-            bulk_subscript_impl<FloatVector>(field_meta.get_sizeof(), *vec_ptr, seg_offsets, count, output.data());
+            if (auto half_ptr = dynamic_cast<const ConcurrentVector<Float16Vector>*>(vec_ptr)) {
+                bulk_subscript_fp16_impl(*half_ptr, seg_offsets, count, reinterpret_cast<float*>(output.data()));
+            } else if (vec_ptr->num_released_chunks() > 0) {
+                bulk_subscript_reconstruct_impl<FloatVector>(field_id, field_meta.get_sizeof(), *vec_ptr, seg_offsets,
+                                                             count, output.data());
+            } else {
+                bulk_subscript_impl<FloatVector>(field_meta.get_sizeof(), *vec_ptr, seg_offsets, count, output.data());
+            }
         } else if (field_meta.get_data_type() == DataType::VECTOR_BINARY) {
-            bulk_subscript_impl<BinaryVector>(field_meta.get_sizeof(), *vec_ptr, seg_offsets, count, output.data());
+            if (vec_ptr->num_released_chunks() > 0) {
+                bulk_subscript_reconstruct_impl<BinaryVector>(field_id, field_meta.get_sizeof(), *vec_ptr, seg_offsets,
+                                                              count, output.data());
+            } else {
+                bulk_subscript_impl<BinaryVector>(field_meta.get_sizeof(), *vec_ptr, seg_offsets, count, output.data());
+            }
         } else {
             PanicInfo("logical error");
         }
@@ -270,6 +743,14 @@ SegmentGrowingImpl::bulk_subscript_impl(int64_t element_sizeof,
     std::vector<uint8_t> empty(element_sizeof, 0);
     auto output_base = reinterpret_cast<char*>(output_raw);
     for (int i = 0; i < count; ++i) {
+        // retrieval offsets are effectively random across chunks; fetch an
+        // upcoming row's head line ahead of the copy loop
+        if (i + kSpanPrefetchRows < count) {
+            auto ahead = seg_offsets[i + kSpanPrefetchRows];
+            if (ahead != INVALID_SEG_OFFSET) {
+                PrefetchRead(vec.get_element(ahead));
+            }
+        }
         auto dst = output_base + i * element_sizeof;
         auto offset = seg_offsets[i];
         const uint8_t* src = (offset == INVALID_SEG_OFFSET ? empty.data() : (const uint8_t*)vec.get_element(offset));
@@ -277,6 +758,65 @@ SegmentGrowingImpl::bulk_subscript_impl(int64_t element_sizeof,
     }
 }
 
+template <typename T>
+void
+SegmentGrowingImpl::bulk_subscript_reconstruct_impl(FieldId field_id,
+                                                    int64_t element_sizeof,
+                                                    const VectorBase& vec_raw,
+                                                    const int64_t* seg_offsets,
+                                                    int64_t count,
+                                                    void* output_raw) const {
+    static_assert(IsVector<T>);
+    auto vec_ptr = dynamic_cast<const ConcurrentVector<T>*>(&vec_raw);
+    AssertInfo(vec_ptr, "Pointer of vec_raw is nullptr");
+    auto& vec = *vec_ptr;
+    auto& indexing = indexing_record_.get_vec_field_indexing(field_id);
+    auto size_per_chunk = vec.get_size_per_chunk();
+    std::vector<uint8_t> empty(element_sizeof, 0);
+    auto output_base = reinterpret_cast<char*>(output_raw);
+    for (int64_t i = 0; i < count; ++i) {
+        auto dst = output_base + i * element_sizeof;
+        auto offset = seg_offsets[i];
+        if (offset == INVALID_SEG_OFFSET) {
+            memcpy(dst, empty.data(), element_sizeof);
+            continue;
+        }
+        auto chunk_id = offset / size_per_chunk;
+        if (vec.chunk_released(chunk_id)) {
+            // eviction only drops a chunk after verifying its index hands
+            // stored rows back, so failure here means a logic error
+            int64_t chunk_offset = offset % size_per_chunk;
+            auto ok = indexing.reconstruct_from_index(chunk_id, &chunk_offset, 1, dst);
+            AssertInfo(ok, "evicted chunk lost its reconstructing index");
+        } else {
+            memcpy(dst, vec.get_element(offset), element_sizeof);
+        }
+    }
+}
+
+void
+SegmentGrowingImpl::bulk_subscript_fp16_impl(const ConcurrentVector<Float16Vector>& vec,
+                                             const int64_t* seg_offsets,
+                                             int64_t count,
+                                             float* output) const {
+    auto dim = vec.get_dim();
+    for (int64_t i = 0; i < count; ++i) {
+        if (i + kSpanPrefetchRows < count) {
+            auto ahead = seg_offsets[i + kSpanPrefetchRows];
+            if (ahead != INVALID_SEG_OFFSET) {
+                PrefetchRead(vec.get_element(ahead));
+            }
+        }
+        auto dst = output + i * dim;
+        auto offset = seg_offsets[i];
+        if (offset == INVALID_SEG_OFFSET) {
+            std::fill_n(dst, dim, 0.0f);
+        } else {
+            Float16ToFloat32Batch(vec.get_element(offset), dst, dim);
+        }
+    }
+}
+
 template <typename T>
 void
 SegmentGrowingImpl::bulk_subscript_impl(const VectorBase& vec_raw,
@@ -289,6 +829,12 @@ SegmentGrowingImpl::bulk_subscript_impl(const VectorBase& vec_raw,
     auto& vec = *vec_ptr;
     auto output = reinterpret_cast<T*>(output_raw);
     for (int64_t i = 0; i < count; ++i) {
+        if (i + kSpanPrefetchRows < count) {
+            auto ahead = seg_offsets[i + kSpanPrefetchRows];
+            if (ahead != INVALID_SEG_OFFSET) {
+                PrefetchRead(vec.get_element(ahead));
+            }
+        }
         auto offset = seg_offsets[i];
         if (offset != INVALID_SEG_OFFSET) {
             output[i] = vec[offset];
@@ -342,39 +888,18 @@ SegmentGrowingImpl::search_ids(const BitsetView& bitset, Timestamp timestamp) co
     return res_offsets;
 }
 
+std::vector<SegOffset>
+SegmentGrowingImpl::search_ids(const BitsetView& bitset, Timestamp timestamp, int64_t limit) const {
+    return search_ids_with_limit(insert_record_, bitset, timestamp, limit);
+}
+
 std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
 SegmentGrowingImpl::search_ids(const IdArray& id_array, Timestamp timestamp) const {
     AssertInfo(id_array.has_int_id(), "Id array doesn't have int_id element");
     auto field_id = schema_->get_primary_field_id().value_or(FieldId(-1));
     AssertInfo(field_id.get() != -1, "Primary key is -1");
     auto& field_meta = schema_->operator[](field_id);
-    auto data_type = field_meta.get_data_type();
-    auto ids_size = GetSizeOfIdArray(id_array);
-    std::vector<PkType> pks(ids_size);
-    ParsePksFromIDs(pks, data_type, id_array);
-
-    auto res_id_arr = std::make_unique<IdArray>();
-    std::vector<SegOffset> res_offsets;
-    for (auto pk : pks) {
-        auto segOffsets = insert_record_.search_pk(pk, timestamp);
-        for (auto offset : segOffsets) {
-            switch (data_type) {
-                case DataType::INT64: {
-                    res_id_arr->mutable_int_id()->add_data(std::get<int64_t>(pk));
-                    break;
-                }
-                case DataType::VARCHAR: {
-                    res_id_arr->mutable_str_id()->add_data(std::get<std::string>(pk));
-                    break;
-                }
-                default: {
-                    PanicInfo("unsupported type");
-                }
-            }
-            res_offsets.push_back(offset);
-        }
-    }
-    return {std::move(res_id_arr), std::move(res_offsets)};
+    return search_ids_by_pks(insert_record_, id_array, field_meta.get_data_type(), timestamp);
 }
 
 std::string
@@ -385,6 +910,20 @@ SegmentGrowingImpl::debug() const {
 int64_t
 SegmentGrowingImpl::get_active_count(Timestamp ts) const {
     auto row_count = this->get_row_count();
+    if (cluster_key_field_.has_value()) {
+        // rows inside a batch are no longer timestamp-sorted, so the cut is
+        // batch-granular: the longest contiguous acked run of batches whose
+        // every timestamp is visible at ts
+        std::shared_lock lck(batch_meta_mutex_);
+        int64_t active = 0;
+        for (auto& batch : clustered_batches_) {
+            if (batch.begin != active || batch.max_ts > ts || batch.end > row_count) {
+                break;
+            }
+            active = batch.end;
+        }
+        return active;
+    }
     auto& ts_vec = this->get_insert_record().timestamps_;
     auto iter = std::upper_bound(boost::make_counting_iterator((int64_t)0), boost::make_counting_iterator(row_count),
                                  ts, [&](Timestamp ts, int64_t index) { return ts < ts_vec[index]; });
@@ -12,9 +12,13 @@
 #pragma once
 
 #include <deque>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <tbb/concurrent_priority_queue.h>
 #include <tbb/concurrent_unordered_map.h>
 #include <tbb/concurrent_vector.h>
@@ -48,6 +52,19 @@ class SegmentGrowingImpl : public SegmentGrowing {
            const Timestamp* timestamps,
            const InsertData* insert_data) override;
 
+    void
+    Insert(int64_t reserved_offset,
+           int64_t size,
+           const int64_t* row_ids,
+           const Timestamp* timestamps,
+           const std::vector<InsertColumnView>& columns) override;
+
+    void
+    BulkImport(int64_t size,
+               const int64_t* row_ids,
+               const Timestamp* timestamps,
+               const std::vector<InsertColumnView>& columns) override;
+
     int64_t
     PreDelete(int64_t size) override;
 
@@ -58,6 +75,9 @@ class SegmentGrowingImpl : public SegmentGrowing {
     int64_t
     GetMemoryUsageInBytes() const override;
 
+    int64_t
+    GetFieldMemoryUsageInBytes(FieldId field_id) const override;
+
     void
     LoadDeletedRecord(const LoadDeletedRecordInfo& info) override;
 
@@ -69,6 +89,17 @@ class SegmentGrowingImpl : public SegmentGrowing {
         return id_;
     }
 
+    void
+    SetNumaNode(int64_t numa_node) override {
+        numa_node_ = numa_node;
+        chunk_arena_->set_numa_node(numa_node);
+    }
+
+    int64_t
+    numa_node() const override {
+        return numa_node_;
+    }
+
  public:
     const InsertRecord&
     get_insert_record() const {
@@ -95,6 +126,20 @@ class SegmentGrowingImpl : public SegmentGrowing {
         return *schema_;
     }
 
+    // stable copy of the visible prefix of a still-filling vector chunk.
+    // Searches scanning the copy stop sharing cache lines with the inserts
+    // that are appending to the live chunk; the copy is refreshed only when
+    // the insert barrier has advanced, so concurrent searches at the same
+    // barrier share one snapshot
+    struct TailChunkSnapshot {
+        int64_t chunk_id = -1;
+        int64_t visible_rows = 0;
+        aligned_vector<char> data;
+    };
+
+    std::shared_ptr<const TailChunkSnapshot>
+    get_tail_chunk_snapshot(FieldId field_id, int64_t chunk_id, int64_t visible_rows) const;
+
     // return count of index that has index, i.e., [0, num_chunk_index) have built index
     int64_t
     num_chunk_index(FieldId field_id) const final {
@@ -119,6 +164,11 @@ class SegmentGrowingImpl : public SegmentGrowing {
         return segcore_config_.get_chunk_rows();
     }
 
+    const SegcoreConfig&
+    get_segcore_config() const {
+        return segcore_config_;
+    }
+
  public:
     // only for debug
     void
@@ -126,6 +176,16 @@ class SegmentGrowingImpl : public SegmentGrowing {
         enable_small_index_ = false;
     }
 
+    void
+    enable_clustered_ingest(FieldId cluster_key) override;
+
+    // Releases raw vector chunks that a verified small index fully covers;
+    // the insert path calls this after each batch when the eviction mode is
+    // on, and it is a cheap no-op while nothing new is covered. Public so
+    // tests can drive it without racing the background builds.
+    void
+    evict_indexed_raw_chunks();
+
     int64_t
     get_row_count() const override {
         return insert_record_.ack_responder_.GetAck();
@@ -136,6 +196,10 @@ class SegmentGrowingImpl : public SegmentGrowing {
         return deleted_record_.ack_responder_.GetAck();
     }
 
+    // visible rows from the maintained delete popcount, no bitset build
+    int64_t
+    get_real_count() const override;
+
     int64_t
     get_active_count(Timestamp ts) const override;
 
@@ -152,6 +216,25 @@ class SegmentGrowingImpl : public SegmentGrowing {
                         int64_t count,
                         void* output_raw) const;
 
+    // gather for a vector column that evicted some raw chunks: rows in a
+    // live chunk copy as usual, rows in a released chunk come back out of
+    // the chunk's small index
+    template <typename T>
+    void
+    bulk_subscript_reconstruct_impl(FieldId field_id,
+                                    int64_t element_sizeof,
+                                    const VectorBase& vec_raw,
+                                    const int64_t* seg_offsets,
+                                    int64_t count,
+                                    void* output_raw) const;
+
+    // half-precision float vector columns up-convert on output
+    void
+    bulk_subscript_fp16_impl(const ConcurrentVector<Float16Vector>& vec,
+                             const int64_t* seg_offsets,
+                             int64_t count,
+                             float* output) const;
+
     void
     bulk_subscript(SystemFieldType system_type, const int64_t* seg_offsets, int64_t count, void* output) const override;
 
@@ -163,17 +246,27 @@ class SegmentGrowingImpl : public SegmentGrowing {
     CreateGrowingSegment(SchemaPtr schema, const SegcoreConfig& segcore_config, int64_t segment_id);
 
     explicit SegmentGrowingImpl(SchemaPtr schema, const SegcoreConfig& segcore_config, int64_t segment_id)
-        : segcore_config_(segcore_config),
+        : segcore_config_(segcore_config.adapt_to_schema(*schema)),
           schema_(std::move(schema)),
-          insert_record_(*schema_, segcore_config.get_chunk_rows()),
+          chunk_arena_(std::make_shared<ChunkArena>()),
+          insert_record_(*schema_, segcore_config_.get_chunk_rows(), chunk_arena_,
+                         segcore_config_.get_fp16_vector_storage(), segcore_config_.get_dict_varchar_storage()),
           indexing_record_(*schema_, segcore_config_),
+          deleted_record_(*schema_),
           id_(segment_id) {
     }
 
+    ~SegmentGrowingImpl() override {
+        // an import's background pk map build captures `this`
+        if (pk_index_future_.valid()) {
+            pk_index_future_.wait();
+        }
+    }
+
     void
     mask_with_timestamps(BitsetType& bitset_chunk, Timestamp timestamp) const override;
 
-    void
+    Status
     vector_search(query::SearchInfo& search_info,
                   const void* query_data,
                   int64_t query_count,
@@ -194,6 +287,9 @@ class SegmentGrowingImpl : public SegmentGrowing {
     std::vector<SegOffset>
     search_ids(const BitsetView& view, Timestamp timestamp) const override;
 
+    std::vector<SegOffset>
+    search_ids(const BitsetView& view, Timestamp timestamp, int64_t limit) const override;
+
     bool
     HasIndex(FieldId field_id) const override {
         return true;
@@ -204,6 +300,10 @@ class SegmentGrowingImpl : public SegmentGrowing {
         return true;
     }
 
+ public:
+    StringDictView
+    chunk_string_dict_view(FieldId field_id, int64_t chunk_id) const override;
+
  protected:
     int64_t
     num_chunk() const override;
@@ -211,12 +311,28 @@ class SegmentGrowingImpl : public SegmentGrowing {
     SpanBase
     chunk_data_impl(FieldId field_id, int64_t chunk_id) const override;
 
+    bool
+    chunk_min_max_impl(FieldId field_id, int64_t chunk_id, void* min_value, void* max_value) const override;
+
     void
     check_search(const query::Plan* plan) const override {
         Assert(plan);
     }
 
  private:
+    // ack the reserved range, kick the small indexes, and record the batch
+    // timestamp envelope when clustered ingest is on; shared tail of both
+    // insert variants
+    void
+    publish_insert_batch(int64_t reserved_offset, int64_t size, const Timestamp* timestamps_raw);
+
+    // bulk pk map build for BulkImport: sorted columns go through the scan
+    // snapshot and retire on the load pool, unsorted ones land slice-wise in
+    // parallel
+    template <typename T>
+    void
+    import_pk_map(std::vector<T>&& pks);
+
     SegcoreConfig segcore_config_;
     SchemaPtr schema_;
 
@@ -225,15 +341,50 @@ class SegmentGrowingImpl : public SegmentGrowing {
     SealedIndexingRecord sealed_indexing_record_;  // not used
 
     // inserted fields data and row_ids, timestamps
+    // owns the chunk memory of insert_record_; released wholesale on drop
+    ChunkArenaPtr chunk_arena_;
     InsertRecord insert_record_;
 
     // deleted pks
     mutable DeletedRecord deleted_record_;
 
+    // per vector field, the snapshot of the chunk the writers are filling
+    mutable std::mutex tail_snapshot_mutex_;
+    mutable std::unordered_map<FieldId, std::shared_ptr<const TailChunkSnapshot>> tail_snapshots_;
+
     int64_t id_;
+    int64_t numa_node_ = -1;
+
+    // clustered ingest: each insert batch is reordered by this field's value
+    // before the columns land in chunks; unset means rows keep arrival order
+    std::optional<FieldId> cluster_key_field_;
+    // ingest batches in offset order; max_ts is the batch's largest insert
+    // timestamp, used for the batch-granular visibility cut
+    struct IngestBatch {
+        int64_t begin;
+        int64_t end;
+        Timestamp max_ts;
+    };
+    mutable std::shared_mutex batch_meta_mutex_;
+    std::vector<IngestBatch> clustered_batches_;
+
+    // raw-chunk eviction bookkeeping: per-field progress and verdict, only
+    // touched under eviction_mutex_; the releases themselves additionally
+    // take an exclusive mutex_ to fence out retrieval mid-gather
+    struct EvictionState {
+        int64_t evicted_until = 0;
+        bool unsupported = false;
+    };
+    std::mutex eviction_mutex_;
+    std::unordered_map<FieldId, EvictionState> eviction_state_;
 
  private:
     bool enable_small_index_ = true;
+    // set once a BulkImport finishes; the segment then serves reads (and
+    // deletes) only, so PreInsert refuses further batches
+    bool import_sealed_ = false;
+    // retires the import's pk scan snapshot in the background
+    std::future<void> pk_index_future_;
 };
 
 inline SegmentGrowingPtr
@@ -9,7 +9,17 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <chrono>
+#include <cstring>
+#include <thread>
+
 #include "SegmentInterface.h"
+#include "SegcoreConfig.h"
+#include "common/Metrics.h"
+#include "common/Numa.h"
+#include "query/ExprFingerprint.h"
+#include "query/PlanImpl.h"
+#include "query/ScratchBuffers.h"
 #include "query/generated/ExecPlanNodeVisitor.h"
 #include "Utils.h"
 
@@ -37,24 +47,94 @@ SegmentInternalInterface::FillPrimaryKeys(const query::Plan* plan, SearchResult&
 
 void
 SegmentInternalInterface::FillTargetEntry(const query::Plan* plan, SearchResult& results) const {
-    std::shared_lock lck(mutex_);
     AssertInfo(plan, "empty plan");
-    auto size = results.distances_.size();
-    AssertInfo(results.seg_offsets_.size() == size, "Size of result distances is not equal to size of ids");
 
     // fill other entries except primary key by result_offset
     for (auto field_id : plan->target_entries_) {
-        auto field_data = bulk_subscript(field_id, results.seg_offsets_.data(), size);
-        results.output_fields_data_[field_id] = std::move(field_data);
+        results.output_fields_data_[field_id] = FillTargetEntryField(field_id, results);
     }
 }
 
+std::unique_ptr<DataArray>
+SegmentInternalInterface::FillTargetEntryField(FieldId field_id, const SearchResult& results) const {
+    std::shared_lock lck(mutex_);
+    auto size = results.distances_.size();
+    AssertInfo(results.seg_offsets_.size() == size, "Size of result distances is not equal to size of ids");
+    return bulk_subscript(field_id, results.seg_offsets_.data(), size);
+}
+
+// how long a coalescing leader waits for identical searches to pile on;
+// bursts arrive within this budget and the delay stays below the cost of
+// one chunk scan
+static constexpr auto kCoalesceWindow = std::chrono::microseconds(200);
+
+// searches may share one execution only when every input that shapes the
+// result matches: predicate, timestamp, search params and query layout.
+// nullopt means the plan has no stable fingerprint and must run alone.
+static std::optional<std::string>
+coalesce_key(const query::Plan* plan,
+             const query::PlaceholderGroup* placeholder_group,
+             Timestamp timestamp,
+             const Schema& schema) {
+    auto& node = *plan->plan_node_;
+    std::string key;
+    if (node.predicate_.has_value()) {
+        auto fingerprint = query::FingerprintExpr(*node.predicate_.value(), schema);
+        if (!fingerprint.has_value()) {
+            return std::nullopt;
+        }
+        key = std::move(fingerprint.value());
+    }
+    auto& info = node.search_info_;
+    auto& placeholder = placeholder_group->at(0);
+    key += '|';
+    key += info.metric_type_;
+    key += '|' + std::to_string(info.topk_) + '|' + std::to_string(info.round_decimal_) + '|' +
+           std::to_string(info.field_id_.get()) + '|' + std::to_string(placeholder.line_sizeof_) + '|' +
+           std::to_string(timestamp) + '|' + info.search_params_.dump();
+    return key;
+}
+
+// the nq slice [nq_begin, nq_begin + nq_count) of a batched result
+static std::unique_ptr<SearchResult>
+slice_search_result(const SearchResult& combined, int64_t nq_begin, int64_t nq_count) {
+    auto topk = combined.unity_topK_;
+    auto out = std::make_unique<SearchResult>();
+    out->total_nq_ = nq_count;
+    out->unity_topK_ = topk;
+    out->segment_ = combined.segment_;
+    out->profile_ = combined.profile_;
+    auto begin = nq_begin * topk;
+    auto end = (nq_begin + nq_count) * topk;
+    out->seg_offsets_.assign(combined.seg_offsets_.begin() + begin, combined.seg_offsets_.begin() + end);
+    out->distances_.assign(combined.distances_.begin() + begin, combined.distances_.begin() + end);
+    return out;
+}
+
 std::unique_ptr<SearchResult>
 SegmentInternalInterface::Search(const query::Plan* plan,
                                  const query::PlaceholderGroup* placeholder_group,
                                  Timestamp timestamp) const {
+    static auto& search_count = MetricsRegistry::GetInstance().GetCounter("segcore.search.count");
+    search_count.Increment();
+    if (SegcoreConfig::default_config().get_search_coalescing()) {
+        auto key = coalesce_key(plan, placeholder_group, timestamp, get_schema());
+        if (key.has_value()) {
+            return search_coalesced(key.value(), plan, placeholder_group, timestamp);
+        }
+    }
+    return search_solo(plan, placeholder_group, timestamp);
+}
+
+std::unique_ptr<SearchResult>
+SegmentInternalInterface::search_solo(const query::Plan* plan,
+                                      const query::PlaceholderGroup* placeholder_group,
+                                      Timestamp timestamp) const {
     std::shared_lock lck(mutex_);
     check_search(plan);
+    // run next to the segment's memory on dual-socket nodes; a no-op when no
+    // placement was requested
+    numa::ScopedThreadNodeBind numa_guard(numa_node());
     query::ExecPlanNodeVisitor visitor(*this, timestamp, placeholder_group);
     auto results = std::make_unique<SearchResult>();
     *results = visitor.get_moved_result(*plan->plan_node_);
@@ -62,6 +142,119 @@ SegmentInternalInterface::Search(const query::Plan* plan,
     return results;
 }
 
+std::unique_ptr<SearchResult>
+SegmentInternalInterface::search_coalesced(const std::string& key,
+                                           const query::Plan* plan,
+                                           const query::PlaceholderGroup* placeholder_group,
+                                           Timestamp timestamp) const {
+    std::shared_ptr<CoalesceGroup> group;
+    size_t member_index = 0;
+    bool leader = false;
+    {
+        std::lock_guard map_lck(coalesce_mutex_);
+        auto it = coalesce_groups_.find(key);
+        if (it != coalesce_groups_.end()) {
+            std::lock_guard group_lck(it->second->mutex);
+            if (!it->second->closed) {
+                group = it->second;
+                member_index = group->member_groups.size();
+                group->member_groups.push_back(placeholder_group);
+            }
+        }
+        if (!group) {
+            group = std::make_shared<CoalesceGroup>();
+            coalesce_groups_[key] = group;
+            leader = true;
+        }
+    }
+
+    if (!leader) {
+        std::unique_lock lck(group->mutex);
+        group->cv.wait(lck, [&group] { return group->done; });
+        auto result = std::move(group->member_results[member_index]);
+        lck.unlock();
+        if (result) {
+            return result;
+        }
+        // the leader's execution failed; don't share its fate
+        return search_solo(plan, placeholder_group, timestamp);
+    }
+
+    std::this_thread::sleep_for(kCoalesceWindow);
+
+    std::vector<const query::PlaceholderGroup*> followers;
+    {
+        std::scoped_lock lck(coalesce_mutex_, group->mutex);
+        group->closed = true;
+        followers = group->member_groups;
+        auto it = coalesce_groups_.find(key);
+        if (it != coalesce_groups_.end() && it->second == group) {
+            coalesce_groups_.erase(it);
+        }
+    }
+    if (followers.empty()) {
+        return search_solo(plan, placeholder_group, timestamp);
+    }
+
+    try {
+        auto& leader_placeholder = placeholder_group->at(0);
+        const int64_t line_sizeof = leader_placeholder.line_sizeof_;
+        int64_t total_nq = leader_placeholder.num_of_queries_;
+        for (auto follower : followers) {
+            total_nq += follower->at(0).num_of_queries_;
+        }
+
+        // one placeholder holding every member's queries back to back; the
+        // blob rides the scratch pool and recycles with the group
+        auto blob = query::ScratchBuffers::Local().TakeBlob();
+        blob.resize(total_nq * line_sizeof);
+        char* cursor = blob.data();
+        auto append = [&cursor, line_sizeof](const query::Placeholder& placeholder) {
+            auto bytes = placeholder.num_of_queries_ * line_sizeof;
+            std::memcpy(cursor, placeholder.get_blob<char>(), bytes);
+            cursor += bytes;
+        };
+        append(leader_placeholder);
+        for (auto follower : followers) {
+            append(follower->at(0));
+        }
+        query::PlaceholderGroup merged;
+        auto& merged_placeholder = merged.emplace_back();
+        merged_placeholder.tag_ = leader_placeholder.tag_;
+        merged_placeholder.num_of_queries_ = total_nq;
+        merged_placeholder.line_sizeof_ = line_sizeof;
+        merged_placeholder.blob_ = std::move(blob);
+
+        auto combined = search_solo(plan, &merged, timestamp);
+
+        std::vector<std::unique_ptr<SearchResult>> member_results;
+        member_results.reserve(followers.size());
+        int64_t nq_cursor = leader_placeholder.num_of_queries_;
+        for (auto follower : followers) {
+            auto nq = follower->at(0).num_of_queries_;
+            member_results.push_back(slice_search_result(*combined, nq_cursor, nq));
+            nq_cursor += nq;
+        }
+        auto my_result = slice_search_result(*combined, 0, leader_placeholder.num_of_queries_);
+        {
+            std::lock_guard lck(group->mutex);
+            group->member_results = std::move(member_results);
+            group->done = true;
+        }
+        group->cv.notify_all();
+        return my_result;
+    } catch (...) {
+        // release the followers with empty slots so they retry solo
+        {
+            std::lock_guard lck(group->mutex);
+            group->member_results.resize(followers.size());
+            group->done = true;
+        }
+        group->cv.notify_all();
+        throw;
+    }
+}
+
 std::unique_ptr<proto::segcore::RetrieveResults>
 SegmentInternalInterface::Retrieve(const query::RetrievePlan* plan, Timestamp timestamp) const {
     std::shared_lock lck(mutex_);
@@ -70,42 +263,186 @@ SegmentInternalInterface::Retrieve(const query::RetrievePlan* plan, Timestamp ti
     auto retrieve_results = visitor.get_retrieve_result(*plan->plan_node_);
     retrieve_results.segment_ = (void*)this;
 
-    results->mutable_offset()->Add(retrieve_results.result_offsets_.begin(), retrieve_results.result_offsets_.end());
+    fill_retrieve_results(plan, retrieve_results.result_offsets_.data(), retrieve_results.result_offsets_.size(),
+                          *results);
+    return results;
+}
+
+int64_t
+SegmentInternalInterface::Count(const query::RetrievePlan* plan, Timestamp timestamp) const {
+    std::shared_lock lck(mutex_);
+    return query::ExecCount(*this, *plan->plan_node_, timestamp);
+}
+
+std::unique_ptr<RetrieveViewsResult>
+SegmentInternalInterface::RetrieveViews(const query::RetrievePlan* plan, Timestamp timestamp, bool accept_views) const {
+    auto result = std::make_unique<RetrieveViewsResult>();
+    // unlike Retrieve, the lock moves into the result: borrowed column
+    // memory must stay valid until the caller releases it
+    result->pin = std::shared_lock(mutex_);
+    query::ExecPlanNodeVisitor visitor(*this, timestamp);
+    auto retrieve_results = visitor.get_retrieve_result(*plan->plan_node_);
+    auto& offsets = retrieve_results.result_offsets_;
+    auto count = static_cast<int64_t>(offsets.size());
+
+    // views only pay off when the hits form one run of consecutive rows,
+    // the common shape after a sorted gather or a full export
+    bool contiguous = accept_views && count > 0;
+    for (int64_t i = 1; contiguous && i < count; ++i) {
+        contiguous = offsets[i] == offsets[0] + i;
+    }
+    if (!contiguous) {
+        fill_retrieve_results(plan, offsets.data(), count, result->fallback);
+        return result;
+    }
 
-    auto fields_data = results->mutable_fields_data();
-    auto ids = results->mutable_ids();
+    auto base = offsets.front();
+    result->fallback.mutable_offset()->Add(offsets.data(), offsets.data() + count);
+    auto pk_field_id = plan->schema_.get_primary_field_id();
+    for (auto field_id : plan->field_ids_) {
+        auto& field_meta = plan->schema_[field_id];
+        auto span = get_borrowable_column(field_id);
+        if (span.has_value() && base + count <= span->row_count()) {
+            auto data = static_cast<const char*>(span->data()) + base * span->element_sizeof();
+            result->views.push_back({field_id, field_meta.get_data_type(), data, count, span->element_sizeof()});
+            if (pk_field_id.has_value() && pk_field_id.value() == field_id) {
+                // only fixed-width pks are borrowable, so this is INT64
+                auto pks = reinterpret_cast<const int64_t*>(data);
+                result->fallback.mutable_ids()->mutable_int_id()->mutable_data()->Add(pks, pks + count);
+            }
+            continue;
+        }
+        // not borrowable: the field rides in the fallback proto and its
+        // view slot stays empty
+        result->views.push_back({field_id, field_meta.get_data_type(), nullptr, 0, 0});
+        auto col_data = bulk_subscript(field_id, offsets.data(), count).release();
+        result->fallback.mutable_fields_data()->AddAllocated(col_data);
+        if (pk_field_id.has_value() && pk_field_id.value() == field_id) {
+            fill_ids_from_column(*col_data, field_meta, result->fallback);
+        }
+    }
+    return result;
+}
+
+void
+SegmentInternalInterface::fill_ids_from_column(const DataArray& col_data,
+                                               const FieldMeta& field_meta,
+                                               proto::segcore::RetrieveResults& results) {
+    auto ids = results.mutable_ids();
+    switch (field_meta.get_data_type()) {
+        case DataType::INT64: {
+            auto int_ids = ids->mutable_int_id();
+            auto src_data = col_data.scalars().long_data();
+            int_ids->mutable_data()->Add(src_data.data().begin(), src_data.data().end());
+            break;
+        }
+        case DataType::VARCHAR: {
+            auto str_ids = ids->mutable_str_id();
+            auto src_data = col_data.scalars().string_data();
+            for (auto i = 0; i < src_data.data_size(); ++i)
+                *(str_ids->mutable_data()->Add()) = src_data.data(i);
+            break;
+        }
+        default: {
+            PanicInfo("unsupported data type");
+        }
+    }
+}
+
+void
+SegmentInternalInterface::fill_retrieve_results(const query::RetrievePlan* plan,
+                                                const int64_t* offsets,
+                                                int64_t count,
+                                                proto::segcore::RetrieveResults& results) const {
+    results.mutable_offset()->Add(offsets, offsets + count);
+
+    auto fields_data = results.mutable_fields_data();
     auto pk_field_id = plan->schema_.get_primary_field_id();
     for (auto field_id : plan->field_ids_) {
         auto& field_mata = plan->schema_[field_id];
 
-        auto col =
-            bulk_subscript(field_id, retrieve_results.result_offsets_.data(), retrieve_results.result_offsets_.size());
+        auto col = bulk_subscript(field_id, offsets, count);
         auto col_data = col.release();
         fields_data->AddAllocated(col_data);
         if (pk_field_id.has_value() && pk_field_id.value() == field_id) {
-            switch (field_mata.get_data_type()) {
-                case DataType::INT64: {
-                    auto int_ids = ids->mutable_int_id();
-                    auto src_data = col_data->scalars().long_data();
-                    int_ids->mutable_data()->Add(src_data.data().begin(), src_data.data().end());
-                    break;
-                }
-                case DataType::VARCHAR: {
-                    auto str_ids = ids->mutable_str_id();
-                    auto src_data = col_data->scalars().string_data();
-                    for (auto i = 0; i < src_data.data_size(); ++i)
-                        *(str_ids->mutable_data()->Add()) = src_data.data(i);
-                    break;
-                }
-                default: {
-                    PanicInfo("unsupported data type");
-                }
+            fill_ids_from_column(*col_data, field_mata, results);
+        }
+    }
+}
+
+RetrieveCursor::RetrieveCursor(const SegmentInternalInterface& segment,
+                               const query::RetrievePlan* plan,
+                               Timestamp timestamp)
+    : segment_(segment), plan_(plan) {
+    std::shared_lock lck(segment.mutex_);
+    query::ExecPlanNodeVisitor visitor(segment, timestamp);
+    auto retrieve_results = visitor.get_retrieve_result(*plan->plan_node_);
+    offsets_ = std::move(retrieve_results.result_offsets_);
+}
+
+bool
+RetrieveCursor::Next(int64_t batch_size) {
+    AssertInfo(batch_size > 0, "retrieve batch size must be positive");
+    batch_.Clear();
+    auto total = static_cast<int64_t>(offsets_.size());
+    if (position_ >= total) {
+        return false;
+    }
+    auto count = std::min(batch_size, total - position_);
+    // the segment lock is held per batch, not across the whole export, so
+    // concurrent loads and deletes only wait one batch at most
+    std::shared_lock lck(segment_.mutex_);
+    segment_.fill_retrieve_results(plan_, offsets_.data() + position_, count, batch_);
+    position_ += count;
+    return true;
+}
+
+void
+SegmentInternalInterface::mask_with_visibility(BitsetType& bitset, int64_t ins_barrier, Timestamp timestamp) const {
+    // most historical segments sit entirely below the query's guarantee
+    // timestamp with no deletes: fully visible, nothing to OR in, and no
+    // mask or cache entry to build
+    if (all_visible_at(timestamp)) {
+        return;
+    }
+    // callers that hand in an unsized bitset (legacy no-predicate paths)
+    // keep the uncached behavior
+    if (static_cast<int64_t>(bitset.size()) != ins_barrier) {
+        mask_with_timestamps(bitset, timestamp);
+        mask_with_delete(bitset, ins_barrier, timestamp);
+        return;
+    }
+    {
+        std::lock_guard lck(visibility_cache_.mutex);
+        if (visibility_cache_.mask != nullptr && visibility_cache_.timestamp == timestamp &&
+            visibility_cache_.ins_barrier == ins_barrier &&
+            visibility_cache_.delete_version == get_deleted_count()) {
+            if (!visibility_cache_.all_clear) {
+                bitset |= *visibility_cache_.mask;
             }
+            return;
         }
     }
-    return results;
+    // read the version before building: a delete landing mid-build may leak
+    // into the mask, but then the stored version is stale and the entry can
+    // only miss, never serve a wrong answer
+    auto delete_version = get_deleted_count();
+    auto mask = std::make_shared<BitsetType>();
+    mask->resize(ins_barrier, false);
+    mask_with_timestamps(*mask, timestamp);
+    mask_with_delete(*mask, ins_barrier, timestamp);
+    bitset |= *mask;
+
+    std::lock_guard lck(visibility_cache_.mutex);
+    visibility_cache_.timestamp = timestamp;
+    visibility_cache_.ins_barrier = ins_barrier;
+    visibility_cache_.delete_version = delete_version;
+    visibility_cache_.all_clear = mask->none();
+    visibility_cache_.mask = std::move(mask);
 }
 
+// exact but bitset-building fallback; the segment impls override this with
+// the maintained delete popcount and only come back here on a barrier race
 int64_t
 SegmentInternalInterface::get_real_count() const {
     auto insert_cnt = get_row_count();
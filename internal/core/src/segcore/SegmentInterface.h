@@ -11,8 +11,13 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <deque>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -31,9 +36,65 @@
 #include "query/PlanNode.h"
 #include "pb/schema.pb.h"
 #include "pb/segcore.pb.h"
+#include "utils/Status.h"
 
 namespace milvus::segcore {
 
+class SegmentInternalInterface;
+class StringChunk;
+
+// Streams one segment's retrieve result in fixed-size batches: the filter
+// is evaluated once at construction, each Next() fills the internal batch
+// proto from the next slice of matching offsets. Exports of large result
+// sets thus run at constant memory instead of materializing every row
+// before the first byte crosses the CGO boundary.
+class RetrieveCursor {
+ public:
+    RetrieveCursor(const SegmentInternalInterface& segment, const query::RetrievePlan* plan, Timestamp timestamp);
+
+    // advances by up to batch_size rows, rewriting batch() in place so its
+    // allocations are recycled across calls; false once offsets are exhausted
+    bool
+    Next(int64_t batch_size);
+
+    const proto::segcore::RetrieveResults&
+    batch() const {
+        return batch_;
+    }
+
+ private:
+    const SegmentInternalInterface& segment_;
+    const query::RetrievePlan* plan_;
+    std::vector<int64_t> offsets_;
+    int64_t position_ = 0;
+    proto::segcore::RetrieveResults batch_;
+};
+
+// Zero-copy retrieve output. When the matching rows form one contiguous
+// run, each fixed-width field comes back as a (pointer, rows, element
+// size) descriptor aimed straight at sealed column memory instead of a
+// copied DataArray; `pin` keeps the segment's read lock, so the borrowed
+// memory stays valid until the result is released. Fields that cannot be
+// borrowed ride in `fallback` as usual, as does the whole result when the
+// offsets are scattered or the caller opted out of views.
+struct RetrieveViewsResult {
+    struct FieldView {
+        FieldId field_id;
+        DataType data_type;
+        // nullptr: this field was copied into `fallback` instead
+        const void* data = nullptr;
+        int64_t row_count = 0;
+        int64_t element_sizeof = 0;
+    };
+    // one entry per requested field, in plan order; empty when the whole
+    // result fell back to the copying path
+    std::vector<FieldView> views;
+    // always carries offsets and pk ids; field columns only for fields
+    // without a view
+    proto::segcore::RetrieveResults fallback;
+    std::shared_lock<std::shared_mutex> pin;
+};
+
 // common interface of SegmentSealed and SegmentGrowing used by C API
 class SegmentInterface {
  public:
@@ -55,6 +116,10 @@ class SegmentInterface {
     virtual int64_t
     GetMemoryUsageInBytes() const = 0;
 
+    // bytes attributed to one field's column data; a slice of the total above
+    virtual int64_t
+    GetFieldMemoryUsageInBytes(FieldId field_id) const = 0;
+
     virtual int64_t
     get_row_count() const = 0;
 
@@ -78,6 +143,15 @@ class SegmentInterface {
 
     virtual int64_t
     get_segment_id() const = 0;
+
+    // prefers the given NUMA node for future column allocations and for the
+    // threads searching this segment; -1 (the default) leaves placement to
+    // the OS. Set right after creation, before data flows in.
+    virtual void
+    SetNumaNode(int64_t numa_node) = 0;
+
+    virtual int64_t
+    numa_node() const = 0;
 };
 
 // internal API for DSL calculation
@@ -90,6 +164,30 @@ class SegmentInternalInterface : public SegmentInterface {
         return static_cast<Span<T>>(chunk_data_impl(field_id, chunk_id));
     }
 
+    // per-chunk min/max of a scalar field's raw data; T must match the
+    // field's element type. False when no statistics exist for the chunk,
+    // and the range is a superset of the visible rows, so callers may skip
+    // a chunk on its verdict but never widen one.
+    template <typename T>
+    bool
+    chunk_min_max(FieldId field_id, int64_t chunk_id, T& min_value, T& max_value) const {
+        return chunk_min_max_impl(field_id, chunk_id, &min_value, &max_value);
+    }
+
+    // dictionary view of one VarChar chunk: the per-row code array plus the
+    // chunk owning the interned values. codes is nullptr when the chunk is
+    // stored plain (or the field is not VarChar), in which case callers
+    // scan the view span as usual.
+    struct StringDictView {
+        const int32_t* codes = nullptr;
+        const StringChunk* chunk = nullptr;
+    };
+
+    virtual StringDictView
+    chunk_string_dict_view(FieldId field_id, int64_t chunk_id) const {
+        return {};
+    }
+
     template <typename T>
     const scalar::ScalarIndex<T>&
     chunk_scalar_index(FieldId field_id, int64_t chunk_id) const {
@@ -112,9 +210,29 @@ class SegmentInternalInterface : public SegmentInterface {
     void
     FillTargetEntry(const query::Plan* plan, SearchResult& results) const override;
 
+    // one output field of FillTargetEntry, split out so the reduce path can
+    // fan the independent per-field gathers over the worker pool; the caller
+    // publishes the returned column into results.output_fields_data_ itself,
+    // keeping the map writes on a single thread
+    std::unique_ptr<DataArray>
+    FillTargetEntryField(FieldId field_id, const SearchResult& results) const;
+
     std::unique_ptr<proto::segcore::RetrieveResults>
     Retrieve(const query::RetrievePlan* plan, Timestamp timestamp) const override;
 
+    // zero-copy variant of Retrieve: when the caller accepts views and the
+    // hits are one contiguous run, fixed-width columns are lent out instead
+    // of copied; otherwise the result degenerates to plain Retrieve output
+    // inside the fallback proto
+    std::unique_ptr<RetrieveViewsResult>
+    RetrieveViews(const query::RetrievePlan* plan, Timestamp timestamp, bool accept_views) const;
+
+    // rows the retrieve plan's filter keeps at `timestamp`; a popcount over
+    // the predicate and visibility bitsets, far cheaper than a Retrieve
+    // whose output would be thrown away
+    int64_t
+    Count(const query::RetrievePlan* plan, Timestamp timestamp) const;
+
     virtual bool
     HasIndex(FieldId field_id) const = 0;
 
@@ -128,7 +246,10 @@ class SegmentInternalInterface : public SegmentInterface {
     get_real_count() const override;
 
  public:
-    virtual void
+    // search failures come back through the returned Status so the chunk
+    // and stripe loops below run exception-free; the plan layer converts a
+    // bad status for the C boundary
+    virtual Status
     vector_search(query::SearchInfo& search_info,
                   const void* query_data,
                   int64_t query_count,
@@ -139,6 +260,36 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual void
     mask_with_delete(BitsetType& bitset, int64_t ins_barrier, Timestamp timestamp) const = 0;
 
+    // ORs the rows invisible at `timestamp` — outside the insert window or
+    // deleted — into `bitset`. Guarantee timestamps quantize upstream to
+    // coarse epochs, so back-to-back queries repeat the same (timestamp,
+    // ins_barrier, delete log) triple; the combined mask is cached for the
+    // most recent triple and a hit replaces both per-query materializations
+    // with one OR.
+    void
+    mask_with_visibility(BitsetType& bitset, int64_t ins_barrier, Timestamp timestamp) const;
+
+    // true when every row is visible at `timestamp` — the segment's max
+    // timestamp is at or below it and no deletes are loaded — so the
+    // visibility step can skip without touching the timestamp column. The
+    // default never triggers; only sealed segments know their time bounds.
+    virtual bool
+    all_visible_at(Timestamp timestamp) const {
+        return false;
+    }
+
+    // request-level cache of predicate bitsets, keyed by expression
+    // fingerprint. The defaults never hit, so mutable segments always
+    // recompute; only SegmentSealedImpl backs them with storage.
+    virtual bool
+    get_cached_filter(const std::string& key, BitsetType& bitset) const {
+        return false;
+    }
+
+    virtual void
+    cache_filter(const std::string& key, const BitsetType& bitset) const {
+    }
+
     // count of chunk that has index available
     virtual int64_t
     num_chunk_index(FieldId field_id) const = 0;
@@ -167,6 +318,11 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual std::vector<SegOffset>
     search_ids(const BitsetView& view, Timestamp timestamp) const = 0;
 
+    // stops after `limit` hits (-1: unbounded) with word-skipping
+    // iteration, so limit-style retrieves never walk the whole bitset
+    virtual std::vector<SegOffset>
+    search_ids(const BitsetView& view, Timestamp timestamp, int64_t limit) const = 0;
+
     virtual std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
     search_ids(const IdArray& id_array, Timestamp timestamp) const = 0;
 
@@ -175,6 +331,10 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual SpanBase
     chunk_data_impl(FieldId field_id, int64_t chunk_id) const = 0;
 
+    // internal API: type-erased counterpart of chunk_min_max
+    virtual bool
+    chunk_min_max_impl(FieldId field_id, int64_t chunk_id, void* min_value, void* max_value) const = 0;
+
     // internal API: return chunk_index in span, support scalar index only
     virtual const knowhere::Index*
     chunk_index_impl(FieldId field_id, int64_t chunk_id) const = 0;
@@ -191,8 +351,75 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual void
     check_search(const query::Plan* plan) const = 0;
 
+    // a single-chunk column whose in-memory elements match the wire layout
+    // may be lent to RetrieveViews; the default lends nothing, which keeps
+    // growing segments (chunked, mutable) on the copying path
+    virtual std::optional<SpanBase>
+    get_borrowable_column(FieldId field_id) const {
+        return std::nullopt;
+    }
+
+    // appends the rows at the given offsets to `results`; shared by
+    // Retrieve (whole offset range) and RetrieveCursor (one slice per call)
+    void
+    fill_retrieve_results(const query::RetrievePlan* plan,
+                          const int64_t* offsets,
+                          int64_t count,
+                          proto::segcore::RetrieveResults& results) const;
+
+    // copies the pk column's values into the result's ids; shared by the
+    // copying and borrowing retrieve paths
+    static void
+    fill_ids_from_column(const DataArray& col_data, const FieldMeta& field_meta,
+                         proto::segcore::RetrieveResults& results);
+
+    friend class RetrieveCursor;
+
  protected:
     mutable std::shared_mutex mutex_;
+
+ private:
+    // one plan traversal with the caller's own placeholder group; the body
+    // of Search before coalescing existed
+    std::unique_ptr<SearchResult>
+    search_solo(const query::Plan* plan, const query::PlaceholderGroup* placeholder_group, Timestamp timestamp) const;
+
+    // groups this search with concurrent ones sharing `key`: the first
+    // arrival leads, waits out a short window, then runs one execution over
+    // the concatenated query vectors and hands each member its slice
+    std::unique_ptr<SearchResult>
+    search_coalesced(const std::string& key,
+                     const query::Plan* plan,
+                     const query::PlaceholderGroup* placeholder_group,
+                     Timestamp timestamp) const;
+
+    // parking spot for searches that joined a leader's batch
+    struct CoalesceGroup {
+        std::mutex mutex;
+        std::condition_variable cv;
+        // leader snapshotted the members; late arrivals start a new group
+        bool closed = false;
+        bool done = false;
+        std::vector<const query::PlaceholderGroup*> member_groups;
+        // parallel to member_groups once done; a null slot tells the member
+        // to fall back to a solo search
+        std::vector<std::unique_ptr<SearchResult>> member_results;
+    };
+    mutable std::mutex coalesce_mutex_;
+    mutable std::map<std::string, std::shared_ptr<CoalesceGroup>> coalesce_groups_;
+
+    // single-entry cache behind mask_with_visibility; the delete log only
+    // ever appends, so the deleted count doubles as its version
+    struct VisibilityCache {
+        std::mutex mutex;
+        Timestamp timestamp = 0;
+        int64_t ins_barrier = -1;
+        int64_t delete_version = -1;
+        // precomputed mask.none(): fully-visible segments skip the OR on hit
+        bool all_clear = false;
+        std::shared_ptr<const BitsetType> mask;
+    };
+    mutable VisibilityCache visibility_cache_;
 };
 
 }  // namespace milvus::segcore
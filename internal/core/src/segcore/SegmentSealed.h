@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "common/LoadInfo.h"
 #include "pb/segcore.pb.h"
@@ -20,6 +21,8 @@
 
 namespace milvus::segcore {
 
+class SegmentGrowing;
+
 class SegmentSealed : public SegmentInternalInterface {
  public:
     virtual void
@@ -28,10 +31,23 @@ class SegmentSealed : public SegmentInternalInterface {
     LoadSegmentMeta(const milvus::proto::segcore::LoadSegmentMeta& meta) = 0;
     virtual void
     LoadFieldData(const LoadFieldDataInfo& info) = 0;
+    // bulk variant: decodes and installs all fields concurrently
+    virtual void
+    LoadFieldDatas(const std::vector<LoadFieldDataInfo>& infos) = 0;
+    // in-process seal: adopts a co-resident growing segment's columns,
+    // delete log and timestamps directly, skipping the flush/binlog
+    // round-trip; the source must be quiesced (no in-flight writes)
+    virtual void
+    LoadFromGrowing(const SegmentGrowing& segment) = 0;
     virtual void
     DropIndex(const FieldId field_id) = 0;
     virtual void
     DropFieldData(const FieldId field_id) = 0;
+    // memory-pressure hook: releases raw columns that a loaded covering
+    // index can serve until the segment fits target_bytes; returns the
+    // bytes released
+    virtual int64_t
+    EvictCoveredFieldData(int64_t target_bytes) = 0;
 };
 
 using SegmentSealedPtr = std::unique_ptr<SegmentSealed>;
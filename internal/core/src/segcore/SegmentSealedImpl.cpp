@@ -9,8 +9,16 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+#include <cstring>
+#include <future>
+
+#include "Gather.h"
+#include "SegmentGrowingImpl.h"
 #include "SegmentSealedImpl.h"
 #include "common/Consts.h"
+#include "common/Float16.h"
+#include "common/ThreadPool.h"
 #include "query/SearchBruteForce.h"
 #include "query/SearchOnSealed.h"
 #include "query/ScalarIndex.h"
@@ -119,9 +127,9 @@ SegmentSealedImpl::LoadScalarIndex(const LoadIndexInfo& info) {
     AssertInfo(row_count > 0, "Index count is 0");
 
     std::unique_lock lck(mutex_);
-    // Don't allow scalar raw data and index exist at the same time
-    AssertInfo(!get_bit(field_data_ready_bitset_, field_id),
-               "scalar index can't be loaded when raw data exists at field " + std::to_string(field_id.get()));
+    // raw data may still be resident: a scalar index covers both search and
+    // reconstruction, so the column becomes an eviction candidate instead of
+    // a conflict (see EvictCoveredFieldData)
     AssertInfo(!get_bit(index_ready_bitset_, field_id),
                "scalar index has been exist at " + std::to_string(field_id.get()));
     if (row_count_opt_.has_value()) {
@@ -132,10 +140,11 @@ SegmentSealedImpl::LoadScalarIndex(const LoadIndexInfo& info) {
     }
 
     scalar_indexings_[field_id] = index;
-    // reverse pk from scalar index and set pks to offset
-    if (schema_->get_primary_field_id() == field_id) {
+    // reverse pk from scalar index and set pks to offset; skipped when the
+    // map was already built from the raw column
+    if (schema_->get_primary_field_id() == field_id && insert_record_.empty_pks()) {
         AssertInfo(field_id.get() != -1, "Primary key is -1");
-        AssertInfo(insert_record_.empty_pks(), "already exists");
+        insert_record_.reserve_pks(row_count);
         switch (field_meta.get_data_type()) {
             case DataType::INT64: {
                 auto int64_index = std::dynamic_pointer_cast<scalar::ScalarIndex<int64_t>>(info.index);
@@ -159,9 +168,24 @@ SegmentSealedImpl::LoadScalarIndex(const LoadIndexInfo& info) {
 
     set_bit(index_ready_bitset_, field_id, true);
     update_row_count(row_count);
+    filter_cache_.Clear();
     lck.unlock();
 }
 
+// actual bytes a loaded column occupies; strings are measured from the
+// payload instead of being charged max_length
+static int64_t
+get_field_data_size(const FieldMeta& field_meta, const DataArray* data, int64_t row_count) {
+    if (field_meta.is_string()) {
+        int64_t bytes = 0;
+        for (auto& str : data->scalars().string_data().data()) {
+            bytes += str.size();
+        }
+        return bytes;
+    }
+    return row_count * field_meta.get_sizeof();
+}
+
 void
 SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
     // print(info);
@@ -170,11 +194,14 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
     auto field_id = FieldId(info.field_id);
     AssertInfo(info.field_data != nullptr, "Field info blob is null");
     auto size = info.row_count;
-    if (row_count_opt_.has_value()) {
-        AssertInfo(row_count_opt_.value() == size, "field (" + std::to_string(field_id.get()) +
-                                                       ") data has different row count (" + std::to_string(size) +
-                                                       ") than other column's row count (" +
-                                                       std::to_string(row_count_opt_.value()) + ")");
+    {
+        std::shared_lock lck(mutex_);
+        if (row_count_opt_.has_value()) {
+            AssertInfo(row_count_opt_.value() == size, "field (" + std::to_string(field_id.get()) +
+                                                           ") data has different row count (" + std::to_string(size) +
+                                                           ") than other column's row count (" +
+                                                           std::to_string(row_count_opt_.value()) + ")");
+        }
     }
 
     if (SystemProperty::Instance().IsSystem(field_id)) {
@@ -183,17 +210,26 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
             auto timestamps = reinterpret_cast<const Timestamp*>(info.field_data->scalars().long_data().data().data());
 
             TimestampIndex index;
-            auto min_slice_length = size < 4096 ? 1 : 4096;
-            auto meta = GenerateFakeSlices(timestamps, size, min_slice_length);
-            index.set_length_meta(std::move(meta));
-            index.build_with(timestamps, size);
+            if (std::is_sorted(timestamps, timestamps + size)) {
+                // flushed segments almost always arrive time-ordered; skip
+                // slice construction entirely
+                index.build_monotonic(timestamps, size);
+            } else {
+                auto min_slice_length = size < 4096 ? 1 : 4096;
+                auto meta = GenerateFakeSlices(timestamps, size, min_slice_length);
+                index.set_length_meta(std::move(meta));
+                index.build_with(timestamps, size);
+            }
 
             // use special index
             std::unique_lock lck(mutex_);
             AssertInfo(insert_record_.timestamps_.empty(), "already exists");
             insert_record_.timestamps_.fill_chunk_data(timestamps, size);
+            timestamp_range_opt_ = std::make_pair(index.get_min_timestamp(), index.get_max_timestamp());
             insert_record_.timestamp_index_ = std::move(index);
             AssertInfo(insert_record_.timestamps_.num_chunk() == 1, "num chunk not equal to 1 for sealed segment");
+            field_mem_sizes_[field_id] = size * static_cast<int64_t>(sizeof(Timestamp));
+            mem_size_ += size * static_cast<int64_t>(sizeof(Timestamp));
         } else {
             AssertInfo(system_field_type == SystemFieldType::RowId, "System field type of id column is not RowId");
             auto row_ids = reinterpret_cast<const idx_t*>(info.field_data->scalars().long_data().data().data());
@@ -202,6 +238,8 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
             AssertInfo(insert_record_.row_ids_.empty(), "already exists");
             insert_record_.row_ids_.fill_chunk_data(row_ids, size);
             AssertInfo(insert_record_.row_ids_.num_chunk() == 1, "num chunk not equal to 1 for sealed segment");
+            field_mem_sizes_[field_id] = size * static_cast<int64_t>(sizeof(idx_t));
+            mem_size_ += size * static_cast<int64_t>(sizeof(idx_t));
         }
         ++system_ready_count_;
     } else {
@@ -211,32 +249,104 @@ SegmentSealedImpl::LoadFieldData(const LoadFieldDataInfo& info) {
         AssertInfo(data_type == DataType(info.field_data->type()),
                    "field type of load data is inconsistent with the schema");
 
-        // write data under lock
-        std::unique_lock lck(mutex_);
-
-        // Don't allow raw data and index exist at the same time
-        AssertInfo(!get_bit(index_ready_bitset_, field_id), "field data can't be loaded when indexing exists");
+        {
+            // Don't allow raw data and index exist at the same time
+            std::shared_lock lck(mutex_);
+            AssertInfo(!get_bit(index_ready_bitset_, field_id), "field data can't be loaded when indexing exists");
+        }
         auto field_data = insert_record_.get_field_data_base(field_id);
         AssertInfo(field_data->empty(), "already exists");
 
-        // insert data to insertRecord
-        field_data->fill_chunk_data(size, info.field_data, field_meta);
-        AssertInfo(field_data->num_chunk() == 1, "num chunk not equal to 1 for sealed segment");
+        if (info.owned_data != nullptr && !field_meta.is_vector() && schema_->get_primary_field_id() != field_id) {
+            // cold scalar columns are registered only; the payload is kept
+            // alive and materialized into insert_record_ on first access
+            auto lazy = std::make_shared<LazyField>();
+            lazy->data = info.owned_data;
+            lazy->row_count = size;
+            std::unique_lock lazy_lck(lazy_mutex_);
+            lazy_fields_[field_id] = std::move(lazy);
+        } else {
+            // decode and copy outside the mutex: the column belongs to this
+            // loader alone until the ready bit is published below, so
+            // concurrent field loads only serialize on the short publish step
+            field_data->fill_chunk_data(size, info.field_data, field_meta);
+            AssertInfo(field_data->num_chunk() == 1, "num chunk not equal to 1 for sealed segment");
+        }
 
         // set pks to offset
         if (schema_->get_primary_field_id() == field_id) {
             AssertInfo(field_id.get() != -1, "Primary key is -1");
             AssertInfo(insert_record_.empty_pks(), "already exists");
-            std::vector<PkType> pks(size);
-            ParsePksFromFieldData(pks, *info.field_data);
-            for (int i = 0; i < size; ++i) {
-                insert_record_.insert_pk(pks[i], i);
+            insert_record_.reserve_pks(size);
+            // dispatch on the pk type once so the build stays variant-free
+            switch (field_meta.get_data_type()) {
+                case DataType::INT64: {
+                    std::vector<int64_t> pks(size);
+                    ParsePksFromFieldData(pks, *info.field_data);
+                    load_pk_index(std::move(pks));
+                    break;
+                }
+                case DataType::VARCHAR: {
+                    std::vector<std::string> pks(size);
+                    ParsePksFromFieldData(pks, *info.field_data);
+                    load_pk_index(std::move(pks));
+                    break;
+                }
+                default: {
+                    PanicInfo("unsupported pk type");
+                }
             }
         }
 
+        auto data_size = get_field_data_size(field_meta, info.field_data, size);
+
+        std::unique_lock lck(mutex_);
         set_bit(field_data_ready_bitset_, field_id, true);
+        field_mem_sizes_[field_id] = data_size;
+        mem_size_ += data_size;
     }
+    std::unique_lock lck(mutex_);
     update_row_count(info.row_count);
+    filter_cache_.Clear();
+}
+
+template <typename T>
+void
+SegmentSealedImpl::load_pk_index(std::vector<T>&& pks) {
+    if (!std::is_sorted(pks.begin(), pks.end())) {
+        // pre-sorting flush format: nothing to binary-search, build inline
+        insert_record_.insert_pks(pks, 0);
+        return;
+    }
+    // serve lookups off the sorted column right away and move the hash-map
+    // build to the load pool; publication retires the scan path atomically
+    insert_record_.install_pk_scan_snapshot(std::move(pks));
+    auto& pool = ThreadPool::GetInstance(ThreadPoolRole::Load);
+    pk_index_future_ = pool.Submit([this] { insert_record_.publish_pk_index(); });
+}
+
+void
+SegmentSealedImpl::LoadFieldDatas(const std::vector<LoadFieldDataInfo>& infos) {
+    if (infos.size() <= 1) {
+        for (auto& info : infos) {
+            LoadFieldData(info);
+        }
+        return;
+    }
+    // every field decodes into its own column (and the pk/timestamp indexes
+    // build behind their own fields), so recovery loads all of them at once
+    auto& pool = ThreadPool::GetInstance(ThreadPoolRole::Load);
+    std::vector<std::future<void>> futures;
+    futures.reserve(infos.size());
+    for (auto& info : infos) {
+        futures.emplace_back(pool.Submit([this, &info] { LoadFieldData(info); }));
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
 }
 
 void
@@ -247,17 +357,220 @@ SegmentSealedImpl::LoadDeletedRecord(const LoadDeletedRecordInfo& info) {
     // step 1: get pks and timestamps
     auto field_id = schema_->get_primary_field_id().value_or(FieldId(-1));
     AssertInfo(field_id.get() != -1, "Primary key is -1");
-    auto& field_meta = schema_->operator[](field_id);
     int64_t size = info.row_count;
-    std::vector<PkType> pks(size);
-    ParsePksFromIDs(pks, field_meta.get_data_type(), *info.primary_keys);
     auto timestamps = reinterpret_cast<const Timestamp*>(info.timestamps);
 
     // step 2: fill pks and timestamps
     auto reserved_begin = deleted_record_.reserved.fetch_add(size);
-    deleted_record_.pks_.set_data_raw(reserved_begin, pks.data(), size);
-    deleted_record_.timestamps_.set_data_raw(reserved_begin, timestamps, size);
-    deleted_record_.ack_responder_.AddSegment(reserved_begin, reserved_begin + size);
+    append_delete_records(deleted_record_, *info.primary_keys, timestamps, size, reserved_begin, false);
+
+    auto insert_barrier = row_count_opt_.value_or(0);
+    if (insert_barrier > 0) {
+        advance_deleted_bitmap(deleted_record_, insert_record_, deleted_record_.ack_responder_.GetAck(),
+                               insert_barrier);
+    }
+    filter_cache_.Clear();
+}
+
+void
+SegmentSealedImpl::materialize_field(FieldId field_id) const {
+    std::shared_ptr<LazyField> lazy;
+    {
+        std::shared_lock lck(lazy_mutex_);
+        auto iter = lazy_fields_.find(field_id);
+        if (iter == lazy_fields_.end()) {
+            return;
+        }
+        lazy = iter->second;
+    }
+    // singleflight: exactly one faulting thread fills the column, the rest
+    // block here until it is installed
+    std::call_once(lazy->once, [&] {
+        auto& field_meta = schema_->operator[](field_id);
+        auto field_data = insert_record_.get_field_data_base(field_id);
+        field_data->fill_chunk_data(lazy->row_count, lazy->data.get(), field_meta);
+        AssertInfo(field_data->num_chunk() == 1, "num chunk not equal to 1 for sealed segment");
+        lazy->data.reset();
+    });
+    std::unique_lock lck(lazy_mutex_);
+    lazy_fields_.erase(field_id);
+}
+
+// copies the visible rows of a chunked growing column into the single
+// sealed chunk; element layout is identical on both sides
+static void
+compact_fixed_chunks(const VectorBase& src, int64_t row_count, int64_t element_sizeof, VectorBase& dst) {
+    auto size_per_chunk = src.get_size_per_chunk();
+    auto* dst_bytes = static_cast<char*>(dst.fill_chunk_uninitialized(row_count));
+    for (int64_t copied = 0, chunk_id = 0; copied < row_count; ++chunk_id) {
+        auto rows = std::min(size_per_chunk, row_count - copied);
+        std::memcpy(dst_bytes + copied * element_sizeof, src.get_chunk_data(chunk_id), rows * element_sizeof);
+        copied += rows;
+    }
+}
+
+// row iterator over a string column; fill_chunk_from/set_data_from advance
+// it a row at a time and read each element through a string_view
+struct StringRowIt {
+    const ConcurrentVector<std::string>* column;
+    int64_t offset;
+
+    const std::string_view&
+    operator*() const {
+        return (*column)[offset];
+    }
+
+    StringRowIt&
+    operator++() {
+        ++offset;
+        return *this;
+    }
+};
+
+void
+SegmentSealedImpl::LoadFromGrowing(const SegmentGrowing& segment) {
+    auto growing = dynamic_cast<const SegmentGrowingImpl*>(&segment);
+    AssertInfo(growing != nullptr, "unsupported growing segment implementation");
+    auto& src_record = growing->get_insert_record();
+    // the acked prefix is the quiesced source's full content; anything past
+    // it would be an in-flight write the caller promised not to have
+    auto row_count = src_record.ack_responder_.GetAck();
+    AssertInfo(row_count > 0, "growing segment is empty");
+
+    // one-shot conversion into a fresh segment; everything publishes at once
+    std::unique_lock lck(mutex_);
+    AssertInfo(!row_count_opt_.has_value() && system_ready_count_ == 0, "segment already holds loaded data");
+    AssertInfo(index_ready_bitset_.none(), "can't convert into a segment with loaded indexes");
+
+    // system columns first; the timestamp index builds straight from the
+    // compacted sealed chunk, no serialization round-trip
+    AssertInfo(insert_record_.timestamps_.empty(), "already exists");
+    compact_fixed_chunks(src_record.timestamps_, row_count, sizeof(Timestamp), insert_record_.timestamps_);
+    auto timestamps = static_cast<const Timestamp*>(insert_record_.timestamps_.get_chunk_data(0));
+    TimestampIndex index;
+    if (std::is_sorted(timestamps, timestamps + row_count)) {
+        index.build_monotonic(timestamps, row_count);
+    } else {
+        auto min_slice_length = row_count < 4096 ? 1 : 4096;
+        index.set_length_meta(GenerateFakeSlices(timestamps, row_count, min_slice_length));
+        index.build_with(timestamps, row_count);
+    }
+    timestamp_range_opt_ = std::make_pair(index.get_min_timestamp(), index.get_max_timestamp());
+    insert_record_.timestamp_index_ = std::move(index);
+    field_mem_sizes_[TimestampFieldID] = row_count * static_cast<int64_t>(sizeof(Timestamp));
+    mem_size_ += row_count * static_cast<int64_t>(sizeof(Timestamp));
+    ++system_ready_count_;
+
+    AssertInfo(insert_record_.row_ids_.empty(), "already exists");
+    compact_fixed_chunks(src_record.row_ids_, row_count, sizeof(idx_t), insert_record_.row_ids_);
+    field_mem_sizes_[RowFieldID] = row_count * static_cast<int64_t>(sizeof(idx_t));
+    mem_size_ += row_count * static_cast<int64_t>(sizeof(idx_t));
+    ++system_ready_count_;
+
+    for (auto& [field_id, field_meta] : schema_->get_fields()) {
+        auto src = src_record.get_field_data_base(field_id);
+        auto dst = insert_record_.get_field_data_base(field_id);
+        // the eviction mode may have replaced raw chunks with their small
+        // indexes; this one-shot copy has no reconstruction path
+        AssertInfo(src->num_released_chunks() == 0, "can't seal a growing segment that evicted raw chunks");
+        AssertInfo(dst->empty(), "already exists");
+        int64_t field_bytes = 0;
+        if (field_meta.is_string()) {
+            auto src_str = dynamic_cast<const ConcurrentVector<std::string>*>(src);
+            auto dst_str = dynamic_cast<ConcurrentVector<std::string>*>(dst);
+            AssertInfo(src_str != nullptr && dst_str != nullptr, "string column type mismatch");
+            // rows are views into chunk-owned byte blocks, so strings move row-wise
+            dst_str->fill_chunk_from(StringRowIt{src_str, 0}, row_count);
+            for (int64_t i = 0; i < row_count; ++i) {
+                field_bytes += static_cast<int64_t>((*src_str)[i].size());
+            }
+        } else if (auto half_src = dynamic_cast<const ConcurrentVector<Float16Vector>*>(src)) {
+            // the growing column may hold half-precision bits; the sealed
+            // column is always float32, so up-convert while compacting
+            auto dim = field_meta.get_dim();
+            auto* dst_floats = static_cast<float*>(dst->fill_chunk_uninitialized(row_count));
+            auto size_per_chunk = half_src->get_size_per_chunk();
+            for (int64_t copied = 0, chunk_id = 0; copied < row_count; ++chunk_id) {
+                auto rows = std::min(size_per_chunk, row_count - copied);
+                Float16ToFloat32Batch(static_cast<const uint16_t*>(half_src->get_chunk_data(chunk_id)),
+                                      dst_floats + copied * dim, rows * dim);
+                copied += rows;
+            }
+            field_bytes = row_count * field_meta.get_sizeof();
+        } else {
+            compact_fixed_chunks(*src, row_count, field_meta.get_sizeof(), *dst);
+            field_bytes = row_count * field_meta.get_sizeof();
+        }
+        AssertInfo(dst->num_chunk() == 1, "num chunk not equal to 1 for sealed segment");
+
+        // the pk index rebuilds from the compacted column, which is cheaper
+        // than a binlog parse and keeps offsets identical to the source
+        if (schema_->get_primary_field_id() == field_id) {
+            AssertInfo(insert_record_.empty_pks(), "already exists");
+            insert_record_.reserve_pks(row_count);
+            switch (field_meta.get_data_type()) {
+                case DataType::INT64: {
+                    auto data = static_cast<const int64_t*>(dst->get_chunk_data(0));
+                    std::vector<int64_t> pks(data, data + row_count);
+                    insert_record_.insert_pks(pks, 0);
+                    break;
+                }
+                case DataType::VARCHAR: {
+                    auto& dst_str = *dynamic_cast<const ConcurrentVector<std::string>*>(dst);
+                    for (int64_t i = 0; i < row_count; ++i) {
+                        insert_record_.insert_pk(std::string(dst_str[i]), i);
+                    }
+                    break;
+                }
+                default: {
+                    PanicInfo("unsupported pk type");
+                }
+            }
+        }
+
+        set_bit(field_data_ready_bitset_, field_id, true);
+        field_mem_sizes_[field_id] = field_bytes;
+        mem_size_ += field_bytes;
+    }
+
+    // the delete log rides along verbatim so visibility after the handoff
+    // matches the source exactly; the accumulated bitmap rebuilds lazily on
+    // the first masked query
+    auto& src_deleted = growing->get_deleted_record();
+    auto del_count = src_deleted.ack_responder_.GetAck();
+    if (del_count > 0) {
+        auto size_per_chunk = src_deleted.timestamps_.get_size_per_chunk();
+        for (int64_t copied = 0, chunk_id = 0; copied < del_count; ++chunk_id) {
+            auto rows = std::min(size_per_chunk, del_count - copied);
+            deleted_record_.timestamps_.set_data_raw(copied, src_deleted.timestamps_.get_chunk_data(chunk_id), rows);
+            copied += rows;
+        }
+        switch (src_deleted.pk_type()) {
+            case DataType::INT64: {
+                auto& src_pks = src_deleted.pks<int64_t>();
+                auto pk_chunk_rows = src_pks.get_size_per_chunk();
+                for (int64_t copied = 0, chunk_id = 0; copied < del_count; ++chunk_id) {
+                    auto rows = std::min(pk_chunk_rows, del_count - copied);
+                    deleted_record_.pks<int64_t>().set_data_raw(copied, src_pks.get_chunk_data(chunk_id), rows);
+                    copied += rows;
+                }
+                break;
+            }
+            case DataType::VARCHAR: {
+                auto& src_pks = src_deleted.pks<std::string>();
+                deleted_record_.pks<std::string>().set_data_from(0, StringRowIt{&src_pks, 0}, del_count);
+                break;
+            }
+            default: {
+                PanicInfo("unsupported pk type");
+            }
+        }
+        deleted_record_.ack_responder_.AddSegment(0, del_count);
+        deleted_record_.reserved = del_count;
+    }
+
+    update_row_count(row_count);
+    filter_cache_.Clear();
 }
 
 // internal API: support scalar index only
@@ -273,6 +586,7 @@ SegmentSealedImpl::num_chunk_index(FieldId field_id) const {
 
 int64_t
 SegmentSealedImpl::num_chunk_data(FieldId field_id) const {
+    materialize_field(field_id);
     auto field_data = insert_record_.get_field_data_base(field_id);
     AssertInfo(field_data != nullptr, "null field data ptr");
     return field_data->num_chunk();
@@ -288,8 +602,34 @@ SegmentSealedImpl::size_per_chunk() const {
     return get_row_count();
 }
 
+std::optional<SpanBase>
+SegmentSealedImpl::get_borrowable_column(FieldId field_id) const {
+    auto& field_meta = schema_->operator[](field_id);
+    // string rows are views into chunk-interned blocks, not a flat buffer
+    // a caller could point into
+    if (field_meta.is_string()) {
+        return std::nullopt;
+    }
+    if (!get_bit(field_data_ready_bitset_, field_id)) {
+        return std::nullopt;
+    }
+    materialize_field(field_id);
+    auto field_data = insert_record_.get_field_data_base(field_id);
+    if (field_data->num_chunk() != 1) {
+        return std::nullopt;
+    }
+    auto span = field_data->get_span_base(0);
+    // a chunk stored re-coded does not match the wire element layout and
+    // must go through bulk_subscript's conversion
+    if (span.element_sizeof() != field_meta.get_sizeof()) {
+        return std::nullopt;
+    }
+    return span;
+}
+
 SpanBase
 SegmentSealedImpl::chunk_data_impl(FieldId field_id, int64_t chunk_id) const {
+    materialize_field(field_id);
     std::shared_lock lck(mutex_);
     AssertInfo(get_bit(field_data_ready_bitset_, field_id),
                "Can't get bitset element at " + std::to_string(field_id.get()));
@@ -300,6 +640,37 @@ SegmentSealedImpl::chunk_data_impl(FieldId field_id, int64_t chunk_id) const {
     return field_data->get_span_base(0);
 }
 
+SegmentInternalInterface::StringDictView
+SegmentSealedImpl::chunk_string_dict_view(FieldId field_id, int64_t chunk_id) const {
+    if (schema_->operator[](field_id).get_data_type() != DataType::VARCHAR) {
+        return {};
+    }
+    materialize_field(field_id);
+    std::shared_lock lck(mutex_);
+    if (!get_bit(field_data_ready_bitset_, field_id)) {
+        return {};
+    }
+    auto vec = dynamic_cast<const ConcurrentVector<std::string>*>(insert_record_.get_field_data_base(field_id));
+    if (vec == nullptr || !vec->dictionary_encoded() || chunk_id >= vec->num_chunk()) {
+        return {};
+    }
+    auto& chunk = vec->get_chunk(chunk_id);
+    return {chunk.codes(), &chunk};
+}
+
+bool
+SegmentSealedImpl::chunk_min_max_impl(FieldId field_id, int64_t chunk_id, void* min_value, void* max_value) const {
+    {
+        std::shared_lock lck(mutex_);
+        if (!get_bit(field_data_ready_bitset_, field_id)) {
+            return false;
+        }
+    }
+    materialize_field(field_id);
+    auto field_data = insert_record_.get_field_data_base(field_id);
+    return field_data->get_chunk_minmax(chunk_id, min_value, max_value);
+}
+
 const knowhere::Index*
 SegmentSealedImpl::chunk_index_impl(FieldId field_id, int64_t chunk_id) const {
     AssertInfo(scalar_indexings_.find(field_id) != scalar_indexings_.end(),
@@ -311,9 +682,16 @@ SegmentSealedImpl::chunk_index_impl(FieldId field_id, int64_t chunk_id) const {
 int64_t
 SegmentSealedImpl::GetMemoryUsageInBytes() const {
     // TODO: add estimate for index
+    // maintained incrementally at load/drop/delete time; only counts columns
+    // that are actually loaded
+    return mem_size_.load() + deleted_record_.reserved * (16 * 2);
+}
+
+int64_t
+SegmentSealedImpl::GetFieldMemoryUsageInBytes(FieldId field_id) const {
     std::shared_lock lck(mutex_);
-    auto row_count = row_count_opt_.value_or(0);
-    return schema_->get_total_sizeof() * row_count;
+    auto iter = field_mem_sizes_.find(field_id);
+    return iter == field_mem_sizes_.end() ? 0 : iter->second;
 }
 
 int64_t
@@ -333,12 +711,35 @@ SegmentSealedImpl::get_schema() const {
     return *schema_;
 }
 
+int64_t
+SegmentSealedImpl::get_real_count() const {
+    auto insert_cnt = get_row_count();
+    auto del_barrier = get_barrier(get_deleted_record(), MAX_TIMESTAMP);
+    if (del_barrier == 0) {
+        return insert_cnt;
+    }
+    // fold any unapplied suffix of the delete log into the accumulated
+    // bitmap (a no-op when queries already advanced it), then read the
+    // maintained popcount instead of building a bitset
+    advance_deleted_bitmap(deleted_record_, insert_record_, del_barrier, insert_cnt);
+    auto [deleted, applied_barrier] = deleted_record_.accumulated_popcount();
+    if (applied_barrier >= del_barrier) {
+        return insert_cnt - deleted;
+    }
+    // a concurrent delete moved the log mid-read; take the exact path
+    return SegmentInternalInterface::get_real_count();
+}
+
 void
 SegmentSealedImpl::mask_with_delete(BitsetType& bitset, int64_t ins_barrier, Timestamp timestamp) const {
     auto del_barrier = get_barrier(get_deleted_record(), timestamp);
     if (del_barrier == 0) {
         return;
     }
+    // common case: the query sees the whole applied log, merge in place
+    if (deleted_record_.or_accumulated(del_barrier, bitset)) {
+        return;
+    }
     auto bitmap_holder = get_deleted_bitmap(del_barrier, ins_barrier, deleted_record_, insert_record_, timestamp);
     if (!bitmap_holder || !bitmap_holder->bitmap_ptr) {
         return;
@@ -348,7 +749,7 @@ SegmentSealedImpl::mask_with_delete(BitsetType& bitset, int64_t ins_barrier, Tim
     bitset |= delete_bitset;
 }
 
-void
+Status
 SegmentSealedImpl::vector_search(query::SearchInfo& search_info,
                                  const void* query_data,
                                  int64_t query_count,
@@ -363,15 +764,15 @@ SegmentSealedImpl::vector_search(query::SearchInfo& search_info,
     if (get_bit(index_ready_bitset_, field_id)) {
         AssertInfo(vector_indexings_.is_ready(field_id),
                    "vector indexes isn't ready for field " + std::to_string(field_id.get()));
-        query::SearchOnSealedIndex(*schema_, vector_indexings_, search_info, query_data, query_count, bitset, output);
-    } else {
-        AssertInfo(get_bit(field_data_ready_bitset_, field_id),
-                   "Field Data is not loaded: " + std::to_string(field_id.get()));
-        AssertInfo(row_count_opt_.has_value(), "Can't get row count value");
-        auto row_count = row_count_opt_.value();
-        query::SearchOnSealed(*schema_, insert_record_, search_info, query_data, query_count, row_count, bitset,
-                              output);
+        return query::SearchOnSealedIndex(*schema_, vector_indexings_, search_info, query_data, query_count, bitset,
+                                          output);
     }
+    AssertInfo(get_bit(field_data_ready_bitset_, field_id),
+               "Field Data is not loaded: " + std::to_string(field_id.get()));
+    AssertInfo(row_count_opt_.has_value(), "Can't get row count value");
+    auto row_count = row_count_opt_.value();
+    return query::SearchOnSealed(*schema_, insert_record_, search_info, query_data, query_count, row_count, bitset,
+                                 output);
 }
 
 void
@@ -386,14 +787,29 @@ SegmentSealedImpl::DropFieldData(const FieldId field_id) {
         } else if (system_field_type == SystemFieldType::Timestamp) {
             insert_record_.timestamps_.clear();
         }
+        auto iter = field_mem_sizes_.find(field_id);
+        if (iter != field_mem_sizes_.end()) {
+            mem_size_ -= iter->second;
+            field_mem_sizes_.erase(iter);
+        }
         lck.unlock();
     } else {
         auto& field_meta = schema_->operator[](field_id);
+        {
+            std::unique_lock lazy_lck(lazy_mutex_);
+            lazy_fields_.erase(field_id);
+        }
         std::unique_lock lck(mutex_);
         set_bit(field_data_ready_bitset_, field_id, false);
         insert_record_.drop_field_data(field_id);
+        auto iter = field_mem_sizes_.find(field_id);
+        if (iter != field_mem_sizes_.end()) {
+            mem_size_ -= iter->second;
+            field_mem_sizes_.erase(iter);
+        }
         lck.unlock();
     }
+    filter_cache_.Clear();
 }
 
 void
@@ -409,6 +825,45 @@ SegmentSealedImpl::DropIndex(const FieldId field_id) {
     set_bit(index_ready_bitset_, field_id, false);
 }
 
+int64_t
+SegmentSealedImpl::EvictCoveredFieldData(int64_t target_bytes) {
+    // candidates are scalar columns whose loaded index also holds the
+    // values: search runs against the index and bulk_subscript reverses
+    // rows out of it, so the raw bytes are pure redundancy. Vector indexes
+    // can't reconstruct rows, so vector columns are never candidates (and
+    // never coexist with an index in the first place).
+    std::vector<std::pair<int64_t, FieldId>> candidates;
+    {
+        std::shared_lock lck(mutex_);
+        if (mem_size_ <= target_bytes) {
+            return 0;
+        }
+        for (auto& [field_id, bytes] : field_mem_sizes_) {
+            if (SystemProperty::Instance().IsSystem(field_id)) {
+                continue;
+            }
+            if (!get_bit(field_data_ready_bitset_, field_id) || !get_bit(index_ready_bitset_, field_id)) {
+                continue;
+            }
+            if (schema_->operator[](field_id).is_vector()) {
+                continue;
+            }
+            candidates.emplace_back(bytes, field_id);
+        }
+    }
+    // largest first, so each drop buys the most headroom
+    std::sort(candidates.rbegin(), candidates.rend());
+    int64_t released = 0;
+    for (auto& [bytes, field_id] : candidates) {
+        if (mem_size_ <= target_bytes) {
+            break;
+        }
+        DropFieldData(field_id);
+        released += bytes;
+    }
+    return released;
+}
+
 void
 SegmentSealedImpl::check_search(const query::Plan* plan) const {
     AssertInfo(plan, "Search plan is null");
@@ -433,13 +888,23 @@ SegmentSealedImpl::check_search(const query::Plan* plan) const {
 
 SegmentSealedImpl::SegmentSealedImpl(SchemaPtr schema, int64_t segment_id)
     : schema_(schema),
-      insert_record_(*schema, MAX_ROW_COUNT),
+      chunk_arena_(std::make_shared<MmapChunkArena>()),
+      insert_record_(*schema, MAX_ROW_COUNT, chunk_arena_, /*fp16_vector_storage=*/false,
+                     SegcoreConfig::default_config().get_dict_varchar_storage()),
+      deleted_record_(*schema),
       field_data_ready_bitset_(schema->size()),
       index_ready_bitset_(schema->size()),
       scalar_indexings_(schema->size()),
       id_(segment_id) {
 }
 
+SegmentSealedImpl::~SegmentSealedImpl() {
+    // the background pk map build captures `this`
+    if (pk_index_future_.valid()) {
+        pk_index_future_.wait();
+    }
+}
+
 void
 SegmentSealedImpl::bulk_subscript(SystemFieldType system_type,
                                   const int64_t* seg_offsets,
@@ -458,27 +923,15 @@ SegmentSealedImpl::bulk_subscript_impl(const void* src_raw, const int64_t* seg_o
     static_assert(IsScalar<T>);
     auto src = reinterpret_cast<const T*>(src_raw);
     auto dst = reinterpret_cast<T*>(dst_raw);
-    for (int64_t i = 0; i < count; ++i) {
-        auto offset = seg_offsets[i];
-        if (offset != INVALID_SEG_OFFSET) {
-            dst[i] = src[offset];
-        }
-    }
+    gather_scalar(src, seg_offsets, count, dst);
 }
 
 // for vector
 void
 SegmentSealedImpl::bulk_subscript_impl(
     int64_t element_sizeof, const void* src_raw, const int64_t* seg_offsets, int64_t count, void* dst_raw) {
-    auto src_vec = reinterpret_cast<const char*>(src_raw);
-    auto dst_vec = reinterpret_cast<char*>(dst_raw);
-    std::vector<char> none(element_sizeof, 0);
-    for (int64_t i = 0; i < count; ++i) {
-        auto offset = seg_offsets[i];
-        auto dst = dst_vec + i * element_sizeof;
-        const char* src = (offset == INVALID_SEG_OFFSET ? none.data() : (src_vec + element_sizeof * offset));
-        memcpy(dst, src, element_sizeof);
-    }
+    gather_rows(reinterpret_cast<const char*>(src_raw), element_sizeof, seg_offsets, count,
+                reinterpret_cast<char*>(dst_raw));
 }
 
 std::unique_ptr<DataArray>
@@ -552,6 +1005,7 @@ SegmentSealedImpl::bulk_subscript(FieldId field_id, const int64_t* seg_offsets,
     }
 
     Assert(get_bit(field_data_ready_bitset_, field_id));
+    materialize_field(field_id);
     auto field_data = insert_record_.get_field_data_base(field_id);
     AssertInfo(field_data->num_chunk() == 1, std::string("num chunk not equal to 1 for sealed segment, num_chunk: ") +
                                                  std::to_string(field_data->num_chunk()));
@@ -593,8 +1047,13 @@ SegmentSealedImpl::bulk_subscript(FieldId field_id, const int64_t* seg_offsets,
             return CreateScalarDataArrayFrom(output.data(), count, field_meta);
         }
         case DataType::VARCHAR: {
+            // the chunk stores views into its byte blocks; the proto wants
+            // owning strings
+            auto src = reinterpret_cast<const std::string_view*>(src_vec);
             FixedVector<std::string> output(count);
-            bulk_subscript_impl<std::string>(src_vec, seg_offsets, count, output.data());
+            for (int64_t i = 0; i < count; ++i) {
+                output[i] = src[seg_offsets[i]];
+            }
             return CreateScalarDataArrayFrom(output.data(), count, field_meta);
         }
 
@@ -635,60 +1094,25 @@ SegmentSealedImpl::search_ids(const IdArray& id_array, Timestamp timestamp) cons
     auto field_id = schema_->get_primary_field_id().value_or(FieldId(-1));
     AssertInfo(field_id.get() != -1, "Primary key is -1");
     auto& field_meta = schema_->operator[](field_id);
-    auto data_type = field_meta.get_data_type();
-    auto ids_size = GetSizeOfIdArray(id_array);
-    std::vector<PkType> pks(ids_size);
-    ParsePksFromIDs(pks, data_type, id_array);
-
-    auto res_id_arr = std::make_unique<IdArray>();
-    std::vector<SegOffset> res_offsets;
-    for (auto pk : pks) {
-        auto segOffsets = insert_record_.search_pk(pk, timestamp);
-        for (auto offset : segOffsets) {
-            switch (data_type) {
-                case DataType::INT64: {
-                    res_id_arr->mutable_int_id()->add_data(std::get<int64_t>(pk));
-                    break;
-                }
-                case DataType::VARCHAR: {
-                    res_id_arr->mutable_str_id()->add_data(std::get<std::string>(pk));
-                    break;
-                }
-                default: {
-                    PanicInfo("unsupported type");
-                }
-            }
-            res_offsets.push_back(offset);
-        }
-    }
-    return {std::move(res_id_arr), std::move(res_offsets)};
+    return search_ids_by_pks(insert_record_, id_array, field_meta.get_data_type(), timestamp);
 }
 
 Status
 SegmentSealedImpl::Delete(int64_t reserved_offset, int64_t size, const IdArray* ids, const Timestamp* timestamps_raw) {
     auto field_id = schema_->get_primary_field_id().value_or(FieldId(-1));
     AssertInfo(field_id.get() != -1, "Primary key is -1");
-    auto& field_meta = schema_->operator[](field_id);
-    std::vector<PkType> pks(size);
-    ParsePksFromIDs(pks, field_meta.get_data_type(), *ids);
-
-    // step 1: sort timestamp
-    std::vector<std::tuple<Timestamp, PkType>> ordering(size);
-    for (int i = 0; i < size; i++) {
-        ordering[i] = std::make_tuple(timestamps_raw[i], pks[i]);
-    }
-    std::sort(ordering.begin(), ordering.end());
-    std::vector<PkType> sort_pks(size);
-    std::vector<Timestamp> sort_timestamps(size);
-
-    for (int i = 0; i < size; i++) {
-        auto [t, pk] = ordering[i];
-        sort_timestamps[i] = t;
-        sort_pks[i] = pk;
-    }
-    deleted_record_.timestamps_.set_data_raw(reserved_offset, sort_timestamps.data(), size);
-    deleted_record_.pks_.set_data_raw(reserved_offset, sort_pks.data(), size);
-    deleted_record_.ack_responder_.AddSegment(reserved_offset, reserved_offset + size);
+    // sort by timestamp and merge into the delete log together with any
+    // staged concurrent batches
+    stage_delete_records(deleted_record_, *ids, timestamps_raw, size, reserved_offset);
+
+    // fold the acked prefix into the accumulated bitmap here, off the query
+    // path; before any field data is loaded there are no rows to mark yet
+    auto insert_barrier = row_count_opt_.value_or(0);
+    if (insert_barrier > 0) {
+        advance_deleted_bitmap(deleted_record_, insert_record_, deleted_record_.ack_responder_.GetAck(),
+                               insert_barrier);
+    }
+    filter_cache_.Clear();
     return Status::OK();
 }
 
@@ -720,6 +1144,11 @@ SegmentSealedImpl::search_ids(const BitsetView& bitset, Timestamp timestamp) con
     return dst_offset;
 }
 
+std::vector<SegOffset>
+SegmentSealedImpl::search_ids(const BitsetView& bitset, Timestamp timestamp, int64_t limit) const {
+    return search_ids_with_limit(insert_record_, bitset, timestamp, limit);
+}
+
 std::string
 SegmentSealedImpl::debug() const {
     std::string log_str;
@@ -745,6 +1174,18 @@ SegmentSealedImpl::get_active_count(Timestamp ts) const {
     return this->get_row_count();
 }
 
+bool
+SegmentSealedImpl::all_visible_at(Timestamp timestamp) const {
+    {
+        std::shared_lock lck(mutex_);
+        if (!timestamp_range_opt_.has_value() || timestamp < timestamp_range_opt_->second) {
+            return false;
+        }
+    }
+    // taken outside the block above: get_deleted_count locks mutex_ itself
+    return get_deleted_count() == 0;
+}
+
 void
 SegmentSealedImpl::mask_with_timestamps(BitsetType& bitset_chunk, Timestamp timestamp) const {
     // TODO change the
@@ -766,7 +1207,27 @@ SegmentSealedImpl::mask_with_timestamps(BitsetType& bitset_chunk, Timestamp time
         bitset_chunk.set();
         return;
     }
-    auto mask = TimestampIndex::GenerateBitset(timestamp, range, timestamps_data.data(), timestamps_data.size());
+    // empty undecided range elsewhere: [0, beg) is visible, the rest is not,
+    // so the mask is two solid runs with no per-row compares at all
+    if (range.first == range.second) {
+        BitsetType mask;
+        mask.resize(range.first, false);
+        mask.resize(timestamps_data.size(), true);
+        bitset_chunk |= mask;
+        return;
+    }
+    // a sorted boundary slice splits by binary search instead of per-row compares
+    auto split = insert_record_.timestamp_index_.search_active_split(timestamp, range, timestamps_data.data());
+    if (split >= 0) {
+        BitsetType mask;
+        mask.resize(split, false);
+        mask.resize(timestamps_data.size(), true);
+        bitset_chunk |= mask;
+        return;
+    }
+    // undecided slice: compare in the frame-of-reference delta domain so
+    // the scan streams the packed column instead of 8 bytes per row
+    auto mask = insert_record_.timestamp_index_.generate_compressed_bitset(timestamp, range, timestamps_data.size());
     bitset_chunk |= mask;
 }
 
@@ -12,9 +12,12 @@
 #pragma once
 
 #include <deque>
+#include <future>
 #include <unordered_map>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -23,6 +26,7 @@
 
 #include "ConcurrentVector.h"
 #include "DeletedRecord.h"
+#include "FilterBitsetCache.h"
 #include "ScalarIndex.h"
 #include "SealedIndexingRecord.h"
 #include "SegmentSealed.h"
@@ -33,18 +37,25 @@ namespace milvus::segcore {
 class SegmentSealedImpl : public SegmentSealed {
  public:
     explicit SegmentSealedImpl(SchemaPtr schema, int64_t segment_id);
+    ~SegmentSealedImpl() override;
     void
     LoadIndex(const LoadIndexInfo& info) override;
     void
     LoadFieldData(const LoadFieldDataInfo& info) override;
     void
+    LoadFieldDatas(const std::vector<LoadFieldDataInfo>& infos) override;
+    void
     LoadDeletedRecord(const LoadDeletedRecordInfo& info) override;
     void
     LoadSegmentMeta(const milvus::proto::segcore::LoadSegmentMeta& segment_meta) override;
     void
+    LoadFromGrowing(const SegmentGrowing& segment) override;
+    void
     DropIndex(const FieldId field_id) override;
     void
     DropFieldData(const FieldId field_id) override;
+    int64_t
+    EvictCoveredFieldData(int64_t target_bytes) override;
     bool
     HasIndex(FieldId field_id) const override;
     bool
@@ -55,16 +66,34 @@ class SegmentSealedImpl : public SegmentSealed {
         return id_;
     }
 
+    void
+    SetNumaNode(int64_t numa_node) override {
+        numa_node_ = numa_node;
+        chunk_arena_->set_numa_node(numa_node);
+    }
+
+    int64_t
+    numa_node() const override {
+        return numa_node_;
+    }
+
  public:
     int64_t
     GetMemoryUsageInBytes() const override;
 
+    int64_t
+    GetFieldMemoryUsageInBytes(FieldId field_id) const override;
+
     int64_t
     get_row_count() const override;
 
     int64_t
     get_deleted_count() const override;
 
+    // visible rows from the maintained delete popcount, no bitset build
+    int64_t
+    get_real_count() const override;
+
     const Schema&
     get_schema() const override;
 
@@ -92,11 +121,27 @@ class SegmentSealedImpl : public SegmentSealed {
     Status
     Delete(int64_t reserved_offset, int64_t size, const IdArray* pks, const Timestamp* timestamps) override;
 
+    StringDictView
+    chunk_string_dict_view(FieldId field_id, int64_t chunk_id) const override;
+
+    bool
+    get_cached_filter(const std::string& key, BitsetType& bitset) const override {
+        return filter_cache_.Get(key, bitset);
+    }
+
+    void
+    cache_filter(const std::string& key, const BitsetType& bitset) const override {
+        filter_cache_.Put(key, bitset);
+    }
+
  protected:
     // blob and row_count
     SpanBase
     chunk_data_impl(FieldId field_id, int64_t chunk_id) const override;
 
+    bool
+    chunk_min_max_impl(FieldId field_id, int64_t chunk_id, void* min_value, void* max_value) const override;
+
     const knowhere::Index*
     chunk_index_impl(FieldId field_id, int64_t chunk_id) const override;
 
@@ -113,9 +158,16 @@ class SegmentSealedImpl : public SegmentSealed {
     void
     check_search(const query::Plan* plan) const override;
 
+    // lends a loaded single-chunk fixed-width column to RetrieveViews
+    std::optional<SpanBase>
+    get_borrowable_column(FieldId field_id) const override;
+
     int64_t
     get_active_count(Timestamp ts) const override;
 
+    bool
+    all_visible_at(Timestamp timestamp) const override;
+
  private:
     template <typename T>
     static void
@@ -128,6 +180,11 @@ class SegmentSealedImpl : public SegmentSealed {
     std::unique_ptr<DataArray>
     fill_with_empty(FieldId field_id, int64_t count) const;
 
+    // faults a lazily-registered column into insert_record_; no-op for
+    // eagerly loaded fields, singleflight per field otherwise
+    void
+    materialize_field(FieldId field_id) const;
+
     void
     update_row_count(int64_t row_count) {
         if (row_count_opt_.has_value()) {
@@ -140,7 +197,7 @@ class SegmentSealedImpl : public SegmentSealed {
     void
     mask_with_timestamps(BitsetType& bitset_chunk, Timestamp timestamp) const override;
 
-    void
+    Status
     vector_search(query::SearchInfo& search_info,
                   const void* query_data,
                   int64_t query_count,
@@ -170,12 +227,24 @@ class SegmentSealedImpl : public SegmentSealed {
     std::vector<SegOffset>
     search_ids(const BitsetType& view, Timestamp timestamp) const override;
 
+    std::vector<SegOffset>
+    search_ids(const BitsetView& view, Timestamp timestamp, int64_t limit) const override;
+
     void
     LoadVecIndex(const LoadIndexInfo& info);
 
     void
     LoadScalarIndex(const LoadIndexInfo& info);
 
+    // Publishes the pk lookup for a freshly parsed pk column. Flush writes
+    // the column in key order, so lookups binary-search a snapshot of it
+    // while the hash map builds on the load pool instead of on the load
+    // path; an unsorted column (pre-sorting flush format) falls back to the
+    // inline build.
+    template <typename T>
+    void
+    load_pk_index(std::vector<T>&& pks);
+
  private:
     // segment loading state
     BitsetType field_data_ready_bitset_;
@@ -186,19 +255,50 @@ class SegmentSealedImpl : public SegmentSealed {
     // TODO: generate index for scalar
     std::optional<int64_t> row_count_opt_;
 
+    // segment time bounds captured when the timestamp column loads; a
+    // query whose guarantee timestamp clears the max needs no timestamp
+    // filtering at all
+    std::optional<std::pair<Timestamp, Timestamp>> timestamp_range_opt_;
+
+    // byte accounting maintained at load/drop time so the polled getters
+    // never walk the columns; the total is lock-free, the per-field
+    // breakdown lives under mutex_
+    std::atomic<int64_t> mem_size_ = 0;
+    std::unordered_map<FieldId, int64_t> field_mem_sizes_;
+
     // scalar field index
     std::unordered_map<FieldId, knowhere::IndexPtr> scalar_indexings_;
     // vector field index
     SealedIndexingRecord vector_indexings_;
 
+    // scalar columns loaded with owned payloads keep the decoded proto here
+    // and materialize into insert_record_ on first access
+    struct LazyField {
+        std::shared_ptr<const milvus::DataArray> data;
+        int64_t row_count;
+        std::once_flag once;
+    };
+    mutable std::shared_mutex lazy_mutex_;
+    mutable std::unordered_map<FieldId, std::shared_ptr<LazyField>> lazy_fields_;
+
     // inserted fields data and row_ids, timestamps
+    // columns are backed by a file mapping, so cold fields can be paged out
+    ChunkArenaPtr chunk_arena_;
     InsertRecord insert_record_;
 
     // deleted pks
     mutable DeletedRecord deleted_record_;
 
+    // repeated-predicate bitsets; cleared whenever the segment mutates
+    mutable FilterBitsetCache filter_cache_;
+
+    // background pk hash-map build kicked by the pk column load; the
+    // destructor drains it so the task never outlives the segment
+    std::future<void> pk_index_future_;
+
     SchemaPtr schema_;
     int64_t id_;
+    int64_t numa_node_ = -1;
 };
 
 inline SegmentSealedPtr
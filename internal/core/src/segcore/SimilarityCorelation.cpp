@@ -0,0 +1,55 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/SimilarityCorelation.h"
+
+#include "common/SimdDispatch.h"
+
+namespace milvus::segcore {
+
+namespace {
+
+// the same trivial body compiled twice; the AVX2 clone lets the vectorizer
+// flip eight lanes per vxorps instead of one scalar at a time, which is
+// what keeps this pass invisible at large nq x topk
+#define MILVUS_NEGATE_DISTANCES_BODY        \
+    for (int64_t i = 0; i < count; ++i) {   \
+        distances[i] = -distances[i];       \
+    }
+
+void
+NegateDistancesImpl(float* distances, int64_t count) {
+    MILVUS_NEGATE_DISTANCES_BODY
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) void
+NegateDistancesAvx2(float* distances, int64_t count) {
+    MILVUS_NEGATE_DISTANCES_BODY
+}
+#endif
+
+#undef MILVUS_NEGATE_DISTANCES_BODY
+
+}  // namespace
+
+void
+NegateDistances(float* distances, int64_t count) {
+#if defined(__x86_64__)
+    if (UseSimdAvx2()) {
+        NegateDistancesAvx2(distances, count);
+        return;
+    }
+#endif
+    NegateDistancesImpl(distances, count);
+}
+
+}  // namespace milvus::segcore
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <knowhere/index/vector_index/helpers/IndexParameter.h>
 
 namespace milvus::segcore {
@@ -18,4 +20,10 @@ static inline bool
 PositivelyRelated(const knowhere::MetricType& metric_type) {
     return metric_type == knowhere::metric::IP;
 }
+
+// flips distances in place so larger is always better upstream; one pass,
+// AVX2 when available. Callers skip the call entirely for positively
+// related metrics, where the transform is the identity.
+void
+NegateDistances(float* distances, int64_t count);
 }  // namespace milvus::segcore
@@ -11,8 +11,93 @@
 
 #include "TimestampIndex.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <numeric>
+
+#include "common/BitsetUtils.h"
+#include "common/ThreadPool.h"
+#include "common/Utils.h"
+
 namespace milvus::segcore {
 
+namespace {
+
+// shared between the calling thread and its load-pool helpers; a helper
+// scheduled after the scan is drained finds an exhausted counter and
+// returns without touching the (by then gone) local state behind fn
+struct ScanContext {
+    std::function<void(int64_t)> fn;
+    int64_t total;
+    std::atomic<int64_t> next{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+    int64_t completed = 0;
+    std::exception_ptr error;
+};
+
+void
+RunClaimedScanItems(const std::shared_ptr<ScanContext>& ctx) {
+    for (;;) {
+        auto item = ctx->next.fetch_add(1);
+        if (item >= ctx->total) {
+            return;
+        }
+        std::exception_ptr error;
+        try {
+            ctx->fn(item);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        {
+            std::lock_guard lck(ctx->mutex);
+            if (error != nullptr && ctx->error == nullptr) {
+                ctx->error = error;
+            }
+            if (++ctx->completed == ctx->total) {
+                ctx->cv.notify_all();
+            }
+        }
+    }
+}
+
+// runs fn(i) for i in [0, n) with load-pool helpers; the calling thread
+// claims items like any helper, so the scan finishes even when it already
+// runs on a saturated pool worker and no helper ever gets a thread
+template <typename Fn>
+void
+ParallelScan(int64_t n, Fn fn) {
+    if (n <= 1) {
+        for (int64_t i = 0; i < n; ++i) {
+            fn(i);
+        }
+        return;
+    }
+    constexpr int64_t kMaxHelpers = 7;
+    auto& pool = ThreadPool::GetInstance(ThreadPoolRole::Load);
+    auto helpers = std::min<int64_t>({kMaxHelpers, n - 1, static_cast<int64_t>(pool.num_threads())});
+    auto ctx = std::make_shared<ScanContext>();
+    ctx->fn = std::move(fn);
+    ctx->total = n;
+    for (int64_t i = 0; i < helpers; ++i) {
+        pool.Submit([ctx] { RunClaimedScanItems(ctx); });
+    }
+    RunClaimedScanItems(ctx);
+
+    std::unique_lock lck(ctx->mutex);
+    ctx->cv.wait(lck, [&] { return ctx->completed == ctx->total; });
+    if (ctx->error != nullptr) {
+        std::rethrow_exception(ctx->error);
+    }
+}
+
+}  // namespace
+
 void
 TimestampIndex::set_length_meta(std::vector<int64_t> lengths) {
     lengths_ = std::move(lengths);
@@ -20,32 +105,132 @@ TimestampIndex::set_length_meta(std::vector<int64_t> lengths) {
 
 void
 TimestampIndex::build_with(const Timestamp* timestamps, int64_t size) {
-    auto num_slice = lengths_.size();
+    auto num_slice = static_cast<int64_t>(lengths_.size());
     Assert(num_slice > 0);
-    std::vector<int64_t> prefix_sums;
-    int offset = 0;
-    prefix_sums.push_back(offset);
-    std::vector<Timestamp> timestamp_barriers;
+    std::vector<int64_t> prefix_sums(num_slice + 1, 0);
+    std::partial_sum(lengths_.begin(), lengths_.end(), prefix_sums.begin() + 1);
+    Assert(prefix_sums[num_slice] == size);
+
+    // slices only read their own rows, so the min/max/sortedness scan runs
+    // in parallel; the ordering asserts replay serially afterwards
+    std::vector<Timestamp> slice_mins(num_slice);
+    std::vector<Timestamp> slice_maxes(num_slice);
+    // staged as bytes: vector<bool> words are not write-independent
+    std::vector<uint8_t> sorted_flags(num_slice);
+    ParallelScan(num_slice, [&](int64_t slice_id) {
+        auto beg = prefix_sums[slice_id];
+        auto end = prefix_sums[slice_id + 1];
+        auto [min_v, max_v] = std::minmax_element(timestamps + beg, timestamps + end);
+        slice_mins[slice_id] = *min_v;
+        slice_maxes[slice_id] = *max_v;
+        sorted_flags[slice_id] = std::is_sorted(timestamps + beg, timestamps + end) ? 1 : 0;
+    });
+
+    std::vector<Timestamp> timestamp_barriers(num_slice + 1);
+    std::vector<bool> slice_sorted(num_slice);
     Timestamp last_max_v = 0;
-    for (int slice_id = 0; slice_id < num_slice; ++slice_id) {
-        auto length = lengths_[slice_id];
-        auto [min_v, max_v] = std::minmax_element(timestamps + offset, timestamps + offset + length);
-        Assert(last_max_v <= *min_v);
-        offset += length;
-        prefix_sums.push_back(offset);
-        timestamp_barriers.push_back(*min_v);
-        last_max_v = *max_v;
-    }
-    timestamp_barriers.push_back(last_max_v);
+    for (int64_t slice_id = 0; slice_id < num_slice; ++slice_id) {
+        Assert(last_max_v <= slice_mins[slice_id]);
+        timestamp_barriers[slice_id] = slice_mins[slice_id];
+        slice_sorted[slice_id] = sorted_flags[slice_id] != 0;
+        last_max_v = slice_maxes[slice_id];
+    }
+    timestamp_barriers[num_slice] = last_max_v;
     Assert(std::is_sorted(timestamp_barriers.begin(), timestamp_barriers.end()));
-    Assert(offset == size);
-    auto min_ts = timestamp_barriers[0];
 
     this->size_ = size;
     this->start_locs_ = std::move(prefix_sums);
-    this->min_timestamp_ = min_ts;
+    this->min_timestamp_ = timestamp_barriers[0];
     this->max_timestamp_ = last_max_v;
     this->timestamp_barriers_ = std::move(timestamp_barriers);
+    this->slice_maxes_ = std::move(slice_maxes);
+    this->slice_sorted_ = std::move(slice_sorted);
+    this->monotonic_ = false;
+
+    build_compressed_column(timestamps, size, false);
+}
+
+void
+TimestampIndex::build_monotonic(const Timestamp* timestamps, int64_t size) {
+    Assert(size > 0);
+    Assert(std::is_sorted(timestamps, timestamps + size));
+    // the sorted column needs no slice scan; one slice covering everything
+    // keeps the slice-level accessors valid, and get_active_range resolves
+    // the exact split by binary search instead
+    this->lengths_ = {size};
+    this->size_ = size;
+    this->start_locs_ = {0, size};
+    this->min_timestamp_ = timestamps[0];
+    this->max_timestamp_ = timestamps[size - 1];
+    this->timestamp_barriers_ = {min_timestamp_, max_timestamp_};
+    this->slice_maxes_ = {max_timestamp_};
+    this->slice_sorted_ = {true};
+    this->monotonic_ = true;
+
+    build_compressed_column(timestamps, size, true);
+}
+
+void
+TimestampIndex::build_compressed_column(const Timestamp* timestamps, int64_t size, bool monotonic) {
+    // frame-of-reference compression of the column for the visibility scan
+    auto num_blocks = (size + kDeltaBlockSize - 1) / kDeltaBlockSize;
+    std::vector<DeltaBlock> delta_blocks(num_blocks);
+
+    // phase 1: per-block extremes fix each block's packed width; a sorted
+    // column reads them off the block endpoints
+    ParallelScan(num_blocks, [&](int64_t block_id) {
+        auto block_start = block_id * kDeltaBlockSize;
+        auto block_len = std::min(kDeltaBlockSize, size - block_start);
+        auto& block = delta_blocks[block_id];
+        if (monotonic) {
+            block.base = timestamps[block_start];
+            block.max_delta = timestamps[block_start + block_len - 1] - block.base;
+        } else {
+            auto [block_min, block_max] =
+                std::minmax_element(timestamps + block_start, timestamps + block_start + block_len);
+            block.base = *block_min;
+            block.max_delta = *block_max - *block_min;
+        }
+        block.width = block.max_delta <= UINT8_MAX    ? 1
+                      : block.max_delta <= UINT16_MAX ? 2
+                      : block.max_delta <= UINT32_MAX ? 4
+                                                      : 8;
+    });
+
+    // phase 2: alignment chains the byte offsets, so assign them serially
+    int64_t total_bytes = 0;
+    for (int64_t block_id = 0; block_id < num_blocks; ++block_id) {
+        auto block_len = std::min(kDeltaBlockSize, size - block_id * kDeltaBlockSize);
+        auto& block = delta_blocks[block_id];
+        // aligned so the compare kernel can walk the block as typed deltas
+        block.byte_offset = upper_align(total_bytes, static_cast<int64_t>(block.width));
+        total_bytes = block.byte_offset + block_len * block.width;
+    }
+    std::vector<uint8_t> packed_deltas(total_bytes);
+
+    // phase 3: with offsets fixed the blocks pack independently
+    ParallelScan(num_blocks, [&](int64_t block_id) {
+        auto block_start = block_id * kDeltaBlockSize;
+        auto block_len = std::min(kDeltaBlockSize, size - block_start);
+        auto& block = delta_blocks[block_id];
+        auto* out = packed_deltas.data() + block.byte_offset;
+        for (int64_t i = 0; i < block_len; ++i) {
+            uint64_t delta = timestamps[block_start + i] - block.base;
+            std::memcpy(out + i * block.width, &delta, block.width);
+        }
+    });
+
+    this->delta_blocks_ = std::move(delta_blocks);
+    this->packed_deltas_ = std::move(packed_deltas);
+}
+
+Timestamp
+TimestampIndex::decode_at(int64_t offset) const {
+    auto& block = delta_blocks_[offset / kDeltaBlockSize];
+    uint64_t delta = 0;
+    std::memcpy(&delta, packed_deltas_.data() + block.byte_offset + (offset % kDeltaBlockSize) * block.width,
+                block.width);
+    return block.base + delta;
 }
 
 std::pair<int64_t, int64_t>
@@ -57,12 +242,47 @@ TimestampIndex::get_active_range(Timestamp query_timestamp) const {
     if (query_timestamp < min_timestamp_) {
         return {0, 0};
     }
+    if (monotonic_) {
+        // sorted column: one binary search over the compressed copy finds
+        // the exact split, nothing is left undecided
+        int64_t lo = 0;
+        int64_t hi = size_;
+        while (lo < hi) {
+            auto mid = lo + (hi - lo) / 2;
+            if (decode_at(mid) <= query_timestamp) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return {lo, lo};
+    }
     auto iter = std::upper_bound(timestamp_barriers_.begin(), timestamp_barriers_.end(), query_timestamp);
     int block_id = (iter - timestamp_barriers_.begin()) - 1;
     Assert(0 <= block_id && block_id < lengths_.size());
+    if (query_timestamp >= slice_maxes_[block_id]) {
+        // the boundary slice is fully visible, nothing is left undecided
+        return {start_locs_[block_id + 1], start_locs_[block_id + 1]};
+    }
     return {start_locs_[block_id], start_locs_[block_id + 1]};
 }
 
+int64_t
+TimestampIndex::search_active_split(Timestamp query_timestamp,
+                                    std::pair<int64_t, int64_t> active_range,
+                                    const Timestamp* timestamps) const {
+    auto [beg, end] = active_range;
+    Assert(beg < end);
+    auto iter = std::upper_bound(start_locs_.begin(), start_locs_.end(), beg);
+    int64_t block_id = (iter - start_locs_.begin()) - 1;
+    Assert(0 <= block_id && block_id < static_cast<int64_t>(slice_sorted_.size()));
+    Assert(start_locs_[block_id] == beg && start_locs_[block_id + 1] == end);
+    if (!slice_sorted_[block_id]) {
+        return -1;
+    }
+    return std::upper_bound(timestamps + beg, timestamps + end, query_timestamp) - timestamps;
+}
+
 BitsetType
 TimestampIndex::GenerateBitset(Timestamp query_timestamp,
                                std::pair<int64_t, int64_t> active_range,
@@ -71,12 +291,107 @@ TimestampIndex::GenerateBitset(Timestamp query_timestamp,
     auto [beg, end] = active_range;
     Assert(beg < end);
     BitsetType bitset;
-    bitset.reserve(size);
-    bitset.resize(beg, false);
+    bitset.resize(end, false);
+    // peel bits until the write cursor is block-aligned, then the shared
+    // word-level kernels compare the timestamps in SIMD and store packed
+    // 64-bit words straight into the result — no staging bitset to stitch
+    auto cur = beg;
+    auto aligned = std::min(end, upper_align(beg, kBitsetBlockBits));
+    for (; cur < aligned; ++cur) {
+        bitset[cur] = timestamps[cur] > query_timestamp;
+    }
+    if (cur < end) {
+        EvalElementwiseAt(timestamps + cur, end - cur, bitset, cur,
+                          [query_timestamp](Timestamp ts) { return ts > query_timestamp; });
+    }
     bitset.resize(size, true);
-    for (int64_t i = beg; i < end; ++i) {
-        bitset[i] = timestamps[i] > query_timestamp;
+    return bitset;
+}
+
+namespace {
+
+// writes a solid run of set bits; `lo` must be 64-aligned, and bits past
+// `hi` in the tail word are left clear to keep dynamic_bitset's invariant
+void
+fill_set_run(BitsetType& bitset, int64_t lo, int64_t hi) {
+    auto blocks = BitsetBlocks(bitset);
+    auto word = lo >> 6;
+    for (; (word << 6) + kBitsetBlockBits <= hi; ++word) {
+        blocks[word] = ~uint64_t(0);
+    }
+    if ((word << 6) < hi) {
+        blocks[word] = (uint64_t(1) << (hi - (word << 6))) - 1;
+    }
+}
+
+// compares one run of packed deltas against the threshold in the delta
+// domain, storing packed result words starting at `blocks`
+template <typename D>
+void
+eval_delta_run(const D* deltas, int64_t count, D threshold, uint64_t* blocks) {
+    auto func = [threshold](D delta) { return delta > threshold; };
+#if defined(__x86_64__)
+    if (UseSimdAvx2()) {
+        detail::EvalBlocksAvx2(deltas, count, blocks, func);
+        return;
+    }
+#endif
+    detail::EvalBlocks(deltas, count, blocks, func);
+}
+
+}  // namespace
+
+BitsetType
+TimestampIndex::generate_compressed_bitset(Timestamp query_timestamp,
+                                           std::pair<int64_t, int64_t> active_range,
+                                           int64_t size) const {
+    auto [beg, end] = active_range;
+    Assert(beg < end);
+    Assert(!delta_blocks_.empty());
+    BitsetType bitset;
+    bitset.resize(end, false);
+    // peel to a 64-bit boundary; past it every delta-block edge stays
+    // aligned (the block length is a multiple of the bitset word), so runs
+    // can be stored as whole words
+    auto cur = beg;
+    auto aligned = std::min(end, upper_align(beg, kBitsetBlockBits));
+    for (; cur < aligned; ++cur) {
+        bitset[cur] = decode_at(cur) > query_timestamp;
+    }
+    while (cur < end) {
+        auto block_id = cur / kDeltaBlockSize;
+        auto& block = delta_blocks_[block_id];
+        auto hi = std::min(end, (block_id + 1) * kDeltaBlockSize);
+        auto count = hi - cur;
+        if (query_timestamp < block.base) {
+            // the whole block is newer than the query
+            fill_set_run(bitset, cur, hi);
+        } else if (query_timestamp - block.base < block.max_delta) {
+            // undecided: compare in the packed domain, no 8-byte decode
+            auto threshold = query_timestamp - block.base;
+            auto* packed = packed_deltas_.data() + block.byte_offset + (cur - block_id * kDeltaBlockSize) * block.width;
+            auto* blocks = BitsetBlocks(bitset) + (cur >> 6);
+            switch (block.width) {
+                case 1:
+                    eval_delta_run(packed, count, static_cast<uint8_t>(threshold), blocks);
+                    break;
+                case 2:
+                    eval_delta_run(reinterpret_cast<const uint16_t*>(packed), count,
+                                   static_cast<uint16_t>(threshold), blocks);
+                    break;
+                case 4:
+                    eval_delta_run(reinterpret_cast<const uint32_t*>(packed), count,
+                                   static_cast<uint32_t>(threshold), blocks);
+                    break;
+                default:
+                    eval_delta_run(reinterpret_cast<const uint64_t*>(packed), count, threshold, blocks);
+                    break;
+            }
+        }
+        // else: every delta is at or below the threshold, bits stay clear
+        cur = hi;
     }
+    bitset.resize(size, true);
     return bitset;
 }
 
@@ -26,6 +26,12 @@ class TimestampIndex {
 
     void
     build_with(const Timestamp* timestamps, int64_t size);
+
+    // fast path for an already-sorted column (the usual shape of flushed
+    // segments): skips the slice scan entirely and marks the index so
+    // get_active_range resolves the exact split with one binary search
+    void
+    build_monotonic(const Timestamp* timestamps, int64_t size);
     // output bitset
 
     // Return range [beg, end) that is undecided
@@ -34,12 +40,50 @@ class TimestampIndex {
     std::pair<int64_t, int64_t>
     get_active_range(Timestamp query_timestamp) const;
 
+    // Returns split s in [beg, end] with timestamps[beg, s) <= query_timestamp
+    // < timestamps[s, end), found by binary search when the boundary slice is
+    // a sorted run; -1 when the slice is unsorted and needs per-row compares.
+    int64_t
+    search_active_split(Timestamp query_timestamp,
+                        std::pair<int64_t, int64_t> active_range,
+                        const Timestamp* timestamps) const;
+
     static BitsetType
     GenerateBitset(Timestamp query_timestamp,
                    std::pair<int64_t, int64_t> active_range,
                    const Timestamp* timestamps,
                    int64_t size);
 
+    // Decompress-free counterpart of GenerateBitset over the frame-of-
+    // reference column built by build_with: whole delta blocks are decided
+    // from their header, and undecided ones compare packed deltas against
+    // (query - base), so the scan streams the narrow column instead of
+    // 8 bytes per row.
+    BitsetType
+    generate_compressed_bitset(Timestamp query_timestamp, std::pair<int64_t, int64_t> active_range, int64_t size) const;
+
+    bool
+    has_compressed_column() const {
+        return !delta_blocks_.empty();
+    }
+
+    Timestamp
+    get_min_timestamp() const {
+        return min_timestamp_;
+    }
+
+    Timestamp
+    get_max_timestamp() const {
+        return max_timestamp_;
+    }
+
+ private:
+    Timestamp
+    decode_at(int64_t offset) const;
+
+    void
+    build_compressed_column(const Timestamp* timestamps, int64_t size, bool monotonic);
+
  private:
     // numSlice
     std::vector<int64_t> lengths_;
@@ -50,6 +94,26 @@ class TimestampIndex {
     Timestamp max_timestamp_;
     // numSlice + 1
     std::vector<Timestamp> timestamp_barriers_;
+    // per-slice max and sortedness, so whole slices are decided without
+    // touching their rows and sorted boundary slices are binary-searched
+    std::vector<Timestamp> slice_maxes_;
+    std::vector<bool> slice_sorted_;
+    // the whole column is sorted; active ranges collapse to an exact split
+    bool monotonic_ = false;
+
+    // frame-of-reference compressed copy of the column: per-block minimum
+    // plus deltas packed at the narrowest byte width that fits the block.
+    // Hybrid timestamps inside a segment are nearly monotonic with small
+    // deltas, so blocks mostly pack to 1-2 bytes per row.
+    static constexpr int64_t kDeltaBlockSize = 4096;
+    struct DeltaBlock {
+        Timestamp base;       // block minimum
+        Timestamp max_delta;  // largest delta in the block
+        int64_t byte_offset;  // into packed_deltas_, aligned to width
+        uint8_t width;        // bytes per packed delta: 1, 2, 4 or 8
+    };
+    std::vector<DeltaBlock> delta_blocks_;
+    std::vector<uint8_t> packed_deltas_;
 };
 
 std::vector<int64_t>
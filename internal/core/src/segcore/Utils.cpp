@@ -9,6 +9,10 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
 #include "segcore/Utils.h"
 #include "index/ScalarIndex.h"
 
@@ -52,6 +56,34 @@ ParsePksFromIDs(std::vector<PkType>& pks, DataType data_type, const IdArray& dat
     }
 }
 
+void
+ParsePksFromFieldData(std::vector<int64_t>& pks, const DataArray& data) {
+    AssertInfo(DataType(data.type()) == DataType::INT64, "pk field data is not int64");
+    auto source_data = reinterpret_cast<const int64_t*>(data.scalars().long_data().data().data());
+    std::copy_n(source_data, pks.size(), pks.data());
+}
+
+void
+ParsePksFromFieldData(std::vector<std::string>& pks, const DataArray& data) {
+    AssertInfo(DataType(data.type()) == DataType::VARCHAR, "pk field data is not varchar");
+    auto src_data = data.scalars().string_data().data();
+    std::copy(src_data.begin(), src_data.end(), pks.begin());
+}
+
+void
+ParsePksFromIDs(std::vector<int64_t>& pks, const IdArray& data) {
+    AssertInfo(data.has_int_id(), "pk id array is not int64");
+    auto source_data = reinterpret_cast<const int64_t*>(data.int_id().data().data());
+    std::copy_n(source_data, pks.size(), pks.data());
+}
+
+void
+ParsePksFromIDs(std::vector<std::string>& pks, const IdArray& data) {
+    AssertInfo(data.has_str_id(), "pk id array is not varchar");
+    auto source_data = data.str_id().data();
+    std::copy(source_data.begin(), source_data.end(), pks.begin());
+}
+
 int64_t
 GetSizeOfIdArray(const IdArray& data) {
     if (data.has_int_id()) {
@@ -76,52 +108,65 @@ CreateScalarDataArrayFrom(const void* data_raw, int64_t count, const FieldMeta&
 
     auto scalar_array = data_array->mutable_scalars();
     switch (data_type) {
+        // fixed-width columns are resized once and written wholesale; growing
+        // the repeated field element by element dominated retrieve latency
         case DataType::BOOL: {
             auto data = reinterpret_cast<const bool*>(data_raw);
             auto obj = scalar_array->mutable_bool_data();
-            obj->mutable_data()->Add(data, data + count);
+            obj->mutable_data()->Resize(count, false);
+            std::memcpy(obj->mutable_data()->mutable_data(), data, count * sizeof(bool));
             break;
         }
         case DataType::INT8: {
             auto data = reinterpret_cast<const int8_t*>(data_raw);
             auto obj = scalar_array->mutable_int_data();
-            obj->mutable_data()->Add(data, data + count);
+            obj->mutable_data()->Resize(count, 0);
+            std::copy_n(data, count, obj->mutable_data()->mutable_data());
             break;
         }
         case DataType::INT16: {
             auto data = reinterpret_cast<const int16_t*>(data_raw);
             auto obj = scalar_array->mutable_int_data();
-            obj->mutable_data()->Add(data, data + count);
+            obj->mutable_data()->Resize(count, 0);
+            std::copy_n(data, count, obj->mutable_data()->mutable_data());
             break;
         }
         case DataType::INT32: {
             auto data = reinterpret_cast<const int32_t*>(data_raw);
             auto obj = scalar_array->mutable_int_data();
-            obj->mutable_data()->Add(data, data + count);
+            obj->mutable_data()->Resize(count, 0);
+            std::memcpy(obj->mutable_data()->mutable_data(), data, count * sizeof(int32_t));
             break;
         }
         case DataType::INT64: {
             auto data = reinterpret_cast<const int64_t*>(data_raw);
             auto obj = scalar_array->mutable_long_data();
-            obj->mutable_data()->Add(data, data + count);
+            obj->mutable_data()->Resize(count, 0);
+            std::memcpy(obj->mutable_data()->mutable_data(), data, count * sizeof(int64_t));
             break;
         }
         case DataType::FLOAT: {
             auto data = reinterpret_cast<const float*>(data_raw);
             auto obj = scalar_array->mutable_float_data();
-            obj->mutable_data()->Add(data, data + count);
+            obj->mutable_data()->Resize(count, 0);
+            std::memcpy(obj->mutable_data()->mutable_data(), data, count * sizeof(float));
             break;
         }
         case DataType::DOUBLE: {
             auto data = reinterpret_cast<const double*>(data_raw);
             auto obj = scalar_array->mutable_double_data();
-            obj->mutable_data()->Add(data, data + count);
+            obj->mutable_data()->Resize(count, 0);
+            std::memcpy(obj->mutable_data()->mutable_data(), data, count * sizeof(double));
             break;
         }
         case DataType::VARCHAR: {
             auto data = reinterpret_cast<const std::string*>(data_raw);
             auto obj = scalar_array->mutable_string_data();
-            for (auto i = 0; i < count; i++) *(obj->mutable_data()->Add()) = data[i];
+            // one pointer-array allocation up front, then one copy per string
+            obj->mutable_data()->Reserve(count);
+            for (auto i = 0; i < count; i++) {
+                obj->add_data(data[i]);
+            }
             break;
         }
         default: {
@@ -147,7 +192,8 @@ CreateVectorDataArrayFrom(const void* data_raw, int64_t count, const FieldMeta&
             auto length = count * dim;
             auto data = reinterpret_cast<const float*>(data_raw);
             auto obj = vector_array->mutable_float_vector();
-            obj->mutable_data()->Add(data, data + length);
+            obj->mutable_data()->Resize(length, 0);
+            std::memcpy(obj->mutable_data()->mutable_data(), data, length * sizeof(float));
             break;
         }
         case DataType::VECTOR_BINARY: {
@@ -176,81 +222,234 @@ CreateDataArrayFrom(const void* data_raw, int64_t count, const FieldMeta& field_
     return CreateVectorDataArrayFrom(data_raw, count, field_meta);
 }
 
-// TODO remove merge dataArray, instead fill target entity when get data slice
 std::unique_ptr<DataArray>
-MergeDataArray(std::vector<std::pair<milvus::SearchResult*, int64_t>>& result_offsets, const FieldMeta& field_meta) {
-    auto data_type = field_meta.get_data_type();
+PermuteDataArray(const DataArray& src, const FieldMeta& field_meta, const std::vector<int64_t>& perm) {
+    auto count = static_cast<int64_t>(perm.size());
     auto data_array = std::make_unique<DataArray>();
-    data_array->set_field_id(field_meta.get_id().get());
-    data_array->set_type(milvus::proto::schema::DataType(field_meta.get_data_type()));
-
-    for (auto& result_pair : result_offsets) {
-        auto src_field_data = result_pair.first->output_fields_data_[field_meta.get_id()].get();
-        auto src_offset = result_pair.second;
-        AssertInfo(data_type == DataType(src_field_data->type()), "merge field data type not consistent");
-        if (field_meta.is_vector()) {
-            auto vector_array = data_array->mutable_vectors();
-            auto dim = field_meta.get_dim();
-            vector_array->set_dim(dim);
-            if (field_meta.get_data_type() == DataType::VECTOR_FLOAT) {
-                auto data = src_field_data->vectors().float_vector().data().data();
+    data_array->set_field_id(src.field_id());
+    data_array->set_type(src.type());
+
+    if (field_meta.is_vector()) {
+        auto vector_array = data_array->mutable_vectors();
+        auto dim = field_meta.get_dim();
+        vector_array->set_dim(dim);
+        switch (field_meta.get_data_type()) {
+            case DataType::VECTOR_FLOAT: {
+                auto& data = src.vectors().float_vector().data();
                 auto obj = vector_array->mutable_float_vector();
-                obj->mutable_data()->Add(data + src_offset * dim, data + (src_offset + 1) * dim);
-            } else if (field_meta.get_data_type() == DataType::VECTOR_BINARY) {
-                AssertInfo(dim % 8 == 0, "Binary vector field dimension is not a multiple of 8");
-                auto num_bytes = dim / 8;
-                auto data = src_field_data->vectors().binary_vector().data();
+                obj->mutable_data()->Resize(count * dim, 0);
+                auto dst = obj->mutable_data()->mutable_data();
+                for (int64_t i = 0; i < count; ++i) {
+                    std::memcpy(dst + i * dim, data.data() + perm[i] * dim, dim * sizeof(float));
+                }
+                break;
+            }
+            case DataType::VECTOR_BINARY: {
+                AssertInfo(field_meta.get_dim() % 8 == 0, "Binary vector field dimension is not a multiple of 8");
+                auto bytes_per_row = dim / 8;
+                auto& data = src.vectors().binary_vector();
                 auto obj = vector_array->mutable_binary_vector();
-                obj->assign(data + src_offset * num_bytes, num_bytes);
-            } else {
-                PanicInfo("logical error");
+                obj->resize(count * bytes_per_row);
+                for (int64_t i = 0; i < count; ++i) {
+                    std::memcpy(obj->data() + i * bytes_per_row, data.data() + perm[i] * bytes_per_row,
+                                bytes_per_row);
+                }
+                break;
+            }
+            default: {
+                PanicInfo("unsupported datatype");
             }
-            continue;
         }
+        return data_array;
+    }
 
-        auto scalar_array = data_array->mutable_scalars();
-        switch (data_type) {
-            case DataType::BOOL: {
-                auto data = src_field_data->scalars().bool_data().data().data();
-                auto obj = scalar_array->mutable_bool_data();
-                *(obj->mutable_data()->Add()) = data[src_offset];
-                continue;
+    auto scalar_array = data_array->mutable_scalars();
+    // fixed-width columns copy element-wise through the permutation; the
+    // repeated fields are sized once up front like CreateScalarDataArrayFrom
+    switch (field_meta.get_data_type()) {
+        case DataType::BOOL: {
+            auto& data = src.scalars().bool_data().data();
+            auto obj = scalar_array->mutable_bool_data();
+            obj->mutable_data()->Resize(count, false);
+            for (int64_t i = 0; i < count; ++i) {
+                obj->mutable_data()->Set(i, data.Get(perm[i]));
             }
-            case DataType::INT8:
-            case DataType::INT16:
-            case DataType::INT32: {
-                auto data = src_field_data->scalars().int_data().data().data();
-                auto obj = scalar_array->mutable_int_data();
-                *(obj->mutable_data()->Add()) = data[src_offset];
-                continue;
+            break;
+        }
+        case DataType::INT8:
+        case DataType::INT16:
+        case DataType::INT32: {
+            auto& data = src.scalars().int_data().data();
+            auto obj = scalar_array->mutable_int_data();
+            obj->mutable_data()->Resize(count, 0);
+            for (int64_t i = 0; i < count; ++i) {
+                obj->mutable_data()->Set(i, data.Get(perm[i]));
             }
-            case DataType::INT64: {
-                auto data = src_field_data->scalars().long_data().data().data();
-                auto obj = scalar_array->mutable_long_data();
-                *(obj->mutable_data()->Add()) = data[src_offset];
-                continue;
+            break;
+        }
+        case DataType::INT64: {
+            auto& data = src.scalars().long_data().data();
+            auto obj = scalar_array->mutable_long_data();
+            obj->mutable_data()->Resize(count, 0);
+            for (int64_t i = 0; i < count; ++i) {
+                obj->mutable_data()->Set(i, data.Get(perm[i]));
             }
-            case DataType::FLOAT: {
-                auto data = src_field_data->scalars().float_data().data().data();
-                auto obj = scalar_array->mutable_float_data();
-                *(obj->mutable_data()->Add()) = data[src_offset];
-                continue;
+            break;
+        }
+        case DataType::FLOAT: {
+            auto& data = src.scalars().float_data().data();
+            auto obj = scalar_array->mutable_float_data();
+            obj->mutable_data()->Resize(count, 0);
+            for (int64_t i = 0; i < count; ++i) {
+                obj->mutable_data()->Set(i, data.Get(perm[i]));
             }
-            case DataType::DOUBLE: {
-                auto data = src_field_data->scalars().double_data().data().data();
-                auto obj = scalar_array->mutable_double_data();
-                *(obj->mutable_data()->Add()) = data[src_offset];
-                continue;
+            break;
+        }
+        case DataType::DOUBLE: {
+            auto& data = src.scalars().double_data().data();
+            auto obj = scalar_array->mutable_double_data();
+            obj->mutable_data()->Resize(count, 0);
+            for (int64_t i = 0; i < count; ++i) {
+                obj->mutable_data()->Set(i, data.Get(perm[i]));
             }
-            case DataType::VARCHAR: {
-                auto data = src_field_data->scalars().string_data();
-                auto obj = scalar_array->mutable_string_data();
-                *(obj->mutable_data()->Add()) = data.data(src_offset);
-                continue;
+            break;
+        }
+        case DataType::VARCHAR: {
+            auto& data = src.scalars().string_data();
+            auto obj = scalar_array->mutable_string_data();
+            obj->mutable_data()->Reserve(count);
+            for (int64_t i = 0; i < count; ++i) {
+                obj->add_data(data.data(perm[i]));
             }
-            default: {
-                PanicInfo("unsupported datatype");
+            break;
+        }
+        default: {
+            PanicInfo("unsupported datatype");
+        }
+    }
+    return data_array;
+}
+
+// TODO remove merge dataArray, instead fill target entity when get data slice
+std::unique_ptr<DataArray>
+MergeDataArray(std::vector<std::pair<milvus::SearchResult*, int64_t>>& result_offsets, const FieldMeta& field_meta) {
+    auto data_type = field_meta.get_data_type();
+    auto data_array = std::make_unique<DataArray>();
+    data_array->set_field_id(field_meta.get_id().get());
+    data_array->set_type(milvus::proto::schema::DataType(field_meta.get_data_type()));
+
+    auto total_count = static_cast<int64_t>(result_offsets.size());
+    auto field_id = field_meta.get_id();
+
+    // visits result_offsets as maximal runs of consecutive rows read from the
+    // same source array, so each run moves with one bulk append instead of
+    // one type dispatch and one element append per row
+    auto for_each_run = [&](auto&& consume) {
+        int64_t i = 0;
+        while (i < total_count) {
+            auto* src_result = result_offsets[i].first;
+            auto begin = result_offsets[i].second;
+            int64_t len = 1;
+            while (i + len < total_count && result_offsets[i + len].first == src_result &&
+                   result_offsets[i + len].second == begin + len) {
+                ++len;
             }
+            auto* src = src_result->output_fields_data_[field_id].get();
+            AssertInfo(data_type == DataType(src->type()), "merge field data type not consistent");
+            consume(*src, begin, len);
+            i += len;
+        }
+    };
+
+    if (field_meta.is_vector()) {
+        auto vector_array = data_array->mutable_vectors();
+        auto dim = field_meta.get_dim();
+        vector_array->set_dim(dim);
+        if (data_type == DataType::VECTOR_FLOAT) {
+            auto obj = vector_array->mutable_float_vector();
+            obj->mutable_data()->Reserve(total_count * dim);
+            for_each_run([&](const DataArray& src, int64_t begin, int64_t len) {
+                auto data = src.vectors().float_vector().data().data();
+                obj->mutable_data()->Add(data + begin * dim, data + (begin + len) * dim);
+            });
+        } else if (data_type == DataType::VECTOR_BINARY) {
+            AssertInfo(dim % 8 == 0, "Binary vector field dimension is not a multiple of 8");
+            auto num_bytes = dim / 8;
+            auto obj = vector_array->mutable_binary_vector();
+            obj->reserve(total_count * num_bytes);
+            for_each_run([&](const DataArray& src, int64_t begin, int64_t len) {
+                auto& data = src.vectors().binary_vector();
+                obj->append(data.data() + begin * num_bytes, len * num_bytes);
+            });
+        } else {
+            PanicInfo("logical error");
+        }
+        return data_array;
+    }
+
+    auto scalar_array = data_array->mutable_scalars();
+    switch (data_type) {
+        case DataType::BOOL: {
+            auto obj = scalar_array->mutable_bool_data();
+            obj->mutable_data()->Reserve(total_count);
+            for_each_run([&](const DataArray& src, int64_t begin, int64_t len) {
+                auto data = src.scalars().bool_data().data().data();
+                obj->mutable_data()->Add(data + begin, data + begin + len);
+            });
+            break;
+        }
+        case DataType::INT8:
+        case DataType::INT16:
+        case DataType::INT32: {
+            auto obj = scalar_array->mutable_int_data();
+            obj->mutable_data()->Reserve(total_count);
+            for_each_run([&](const DataArray& src, int64_t begin, int64_t len) {
+                auto data = src.scalars().int_data().data().data();
+                obj->mutable_data()->Add(data + begin, data + begin + len);
+            });
+            break;
+        }
+        case DataType::INT64: {
+            auto obj = scalar_array->mutable_long_data();
+            obj->mutable_data()->Reserve(total_count);
+            for_each_run([&](const DataArray& src, int64_t begin, int64_t len) {
+                auto data = src.scalars().long_data().data().data();
+                obj->mutable_data()->Add(data + begin, data + begin + len);
+            });
+            break;
+        }
+        case DataType::FLOAT: {
+            auto obj = scalar_array->mutable_float_data();
+            obj->mutable_data()->Reserve(total_count);
+            for_each_run([&](const DataArray& src, int64_t begin, int64_t len) {
+                auto data = src.scalars().float_data().data().data();
+                obj->mutable_data()->Add(data + begin, data + begin + len);
+            });
+            break;
+        }
+        case DataType::DOUBLE: {
+            auto obj = scalar_array->mutable_double_data();
+            obj->mutable_data()->Reserve(total_count);
+            for_each_run([&](const DataArray& src, int64_t begin, int64_t len) {
+                auto data = src.scalars().double_data().data().data();
+                obj->mutable_data()->Add(data + begin, data + begin + len);
+            });
+            break;
+        }
+        case DataType::VARCHAR: {
+            auto obj = scalar_array->mutable_string_data();
+            // one pointer-array allocation up front, then one copy per string
+            obj->mutable_data()->Reserve(total_count);
+            for_each_run([&](const DataArray& src, int64_t begin, int64_t len) {
+                auto& data = src.scalars().string_data();
+                for (int64_t k = 0; k < len; ++k) {
+                    obj->add_data(data.data(begin + k));
+                }
+            });
+            break;
+        }
+        default: {
+            PanicInfo("unsupported datatype");
         }
     }
 
@@ -374,74 +573,332 @@ ReverseDataFromIndex(const knowhere::Index* index,
 // assert old delete record pks = [2, 4, 3, 8, 5], old delete record ts = [100, 100, 150, 200, 400, 500, 500, 500]
 // if delete_barrier = 3, query time = 180, then insert records with pks in [2, 4, 3] will be deleted
 // then the old bitmap = [0, 1, 1, 0, 1, 0, 0, 0]
-std::shared_ptr<DeletedRecord::TmpBitmap>
-get_deleted_bitmap(int64_t del_barrier,
-                   int64_t insert_barrier,
-                   DeletedRecord& delete_record,
-                   const InsertRecord& insert_record,
-                   Timestamp query_timestamp) {
-    // if insert_barrier and del_barrier have not changed, use cache data directly
-    bool hit_cache = false;
-    int64_t old_del_barrier = 0;
-    auto current = delete_record.clone_lru_entry(insert_barrier, del_barrier, old_del_barrier, hit_cache);
-    if (hit_cache) {
-        return current;
-    }
-
-    auto bitmap = current->bitmap_ptr;
-
-    int64_t start, end;
-    if (del_barrier < old_del_barrier) {
-        // in this case, ts of delete record[current_del_barrier : old_del_barrier] > query_timestamp
-        // so these deletion records do not take effect in query/search
-        // so bitmap corresponding to those pks in delete record[current_del_barrier:old_del_barrier] wil be reset to 0
-        // for example, current_del_barrier = 2, query_time = 120, the bitmap will be reset to [0, 1, 1, 0, 0, 0, 0, 0]
-        start = del_barrier;
-        end = old_del_barrier;
-    } else {
-        // the cache is not enough, so update bitmap using new pks in delete record[old_del_barrier:current_del_barrier]
-        // for example, current_del_barrier = 4, query_time = 300, bitmap will be updated to [0, 1, 1, 0, 1, 1, 0, 0]
-        start = old_del_barrier;
-        end = del_barrier;
-    }
-
+// resolves delete record [start, end) against the pk index and applies it
+// to the given bitmap; set == false mirrors the old backward path that
+// clears rows whose deletions are newer than a query's barrier
+template <typename T>
+static void
+resolve_delete_records_typed(DeletedRecord& delete_record,
+                             const InsertRecord& insert_record,
+                             int64_t start,
+                             int64_t end,
+                             int64_t insert_barrier,
+                             BitsetType& bitmap,
+                             bool set) {
+    auto& pks = delete_record.pks<T>();
     // Avoid invalid calculations when there are a lot of repeated delete pks
-    std::unordered_map<PkType, Timestamp> delete_timestamps;
+    std::unordered_map<T, Timestamp> delete_timestamps;
     for (auto del_index = start; del_index < end; ++del_index) {
-        auto pk = delete_record.pks_[del_index];
+        // string columns hand out views; the map needs owning keys
+        T pk(pks[del_index]);
         auto timestamp = delete_record.timestamps_[del_index];
 
         delete_timestamps[pk] = timestamp > delete_timestamps[pk] ? timestamp : delete_timestamps[pk];
     }
 
-    for (auto iter = delete_timestamps.begin(); iter != delete_timestamps.end(); iter++) {
-        auto pk = iter->first;
-        auto delete_timestamp = iter->second;
-        auto segOffsets = insert_record.search_pk(pk, insert_barrier);
+    // flatten the deduped batch so the offset map can partition it by shard
+    // and resolve the whole batch in one pass per shard
+    std::vector<T> batch_pks;
+    std::vector<Timestamp> batch_timestamps;
+    batch_pks.reserve(delete_timestamps.size());
+    batch_timestamps.reserve(delete_timestamps.size());
+    for (auto& [pk, timestamp] : delete_timestamps) {
+        batch_pks.push_back(pk);
+        batch_timestamps.push_back(timestamp);
+    }
+
+    insert_record.search_pks(batch_pks, insert_barrier, [&](int64_t pk_index, int64_t insert_row_offset) {
+        // for now, insert_barrier == insert count of segment, so this Assert will always work
+        AssertInfo(insert_row_offset < insert_barrier, "Timestamp offset is larger than insert barrier");
+
+        if (!set) {
+            bitmap.reset(insert_row_offset);
+            return;
+        }
+
+        // insert after delete with same pk, delete will not take effect on this insert record
+        if (insert_record.timestamps_[insert_row_offset] > batch_timestamps[pk_index]) {
+            bitmap.reset(insert_row_offset);
+            return;
+        }
+        // insert data corresponding to the insert_row_offset will be ignored in search/query
+        bitmap.set(insert_row_offset);
+    });
+}
+
+static void
+resolve_delete_records(DeletedRecord& delete_record,
+                       const InsertRecord& insert_record,
+                       int64_t start,
+                       int64_t end,
+                       int64_t insert_barrier,
+                       BitsetType& bitmap,
+                       bool set) {
+    switch (delete_record.pk_type()) {
+        case DataType::INT64: {
+            resolve_delete_records_typed<int64_t>(delete_record, insert_record, start, end, insert_barrier, bitmap,
+                                                  set);
+            break;
+        }
+        case DataType::VARCHAR: {
+            resolve_delete_records_typed<std::string>(delete_record, insert_record, start, end, insert_barrier, bitmap,
+                                                      set);
+            break;
+        }
+        default: {
+            PanicInfo("unsupported pk type");
+        }
+    }
+}
+
+template <typename T>
+static void
+append_delete_records_typed(DeletedRecord& delete_record,
+                            const IdArray& ids,
+                            const Timestamp* timestamps_raw,
+                            int64_t size,
+                            int64_t reserved_offset,
+                            bool sort_by_timestamp) {
+    std::vector<T> pks(size);
+    ParsePksFromIDs(pks, ids);
+    std::vector<Timestamp> timestamps(timestamps_raw, timestamps_raw + size);
+
+    if (sort_by_timestamp) {
+        std::vector<std::tuple<Timestamp, T>> ordering(size);
+        for (int64_t i = 0; i < size; i++) {
+            ordering[i] = std::make_tuple(timestamps[i], std::move(pks[i]));
+        }
+        std::sort(ordering.begin(), ordering.end());
+        for (int64_t i = 0; i < size; i++) {
+            timestamps[i] = std::get<0>(ordering[i]);
+            pks[i] = std::move(std::get<1>(ordering[i]));
+        }
+    }
+
+    delete_record.timestamps_.set_data_raw(reserved_offset, timestamps.data(), size);
+    delete_record.pks<T>().set_data_raw(reserved_offset, pks.data(), size);
+    delete_record.ack_responder_.AddSegment(reserved_offset, reserved_offset + size);
+}
+
+void
+append_delete_records(DeletedRecord& delete_record,
+                      const IdArray& ids,
+                      const Timestamp* timestamps_raw,
+                      int64_t size,
+                      int64_t reserved_offset,
+                      bool sort_by_timestamp) {
+    switch (delete_record.pk_type()) {
+        case DataType::INT64: {
+            append_delete_records_typed<int64_t>(delete_record, ids, timestamps_raw, size, reserved_offset,
+                                                 sort_by_timestamp);
+            break;
+        }
+        case DataType::VARCHAR: {
+            append_delete_records_typed<std::string>(delete_record, ids, timestamps_raw, size, reserved_offset,
+                                                     sort_by_timestamp);
+            break;
+        }
+        default: {
+            PanicInfo("unsupported pk type");
+        }
+    }
+}
+
+template <typename T>
+struct StagedDeleteBatch : DeletedRecord::StagedBatchBase {
+    // sorted by timestamp on arrival
+    std::vector<std::tuple<Timestamp, T>> records;
+};
+
+// merges the staged prefix that is contiguous with the acked log into one
+// sorted run and publishes it; caller holds staging_mutex_
+template <typename T>
+static void
+drain_staged_deletes_typed(DeletedRecord& delete_record) {
+    auto cursor = delete_record.ack_responder_.GetAck();
+    auto next = cursor;
+    std::vector<std::tuple<Timestamp, T>> merged;
+    for (auto it = delete_record.staged_batches_.begin();
+         it != delete_record.staged_batches_.end() && it->first == next;) {
+        auto* batch = static_cast<StagedDeleteBatch<T>*>(it->second.get());
+        auto mid = merged.size();
+        merged.insert(merged.end(), std::make_move_iterator(batch->records.begin()),
+                      std::make_move_iterator(batch->records.end()));
+        // both halves are sorted, so one merge pass keeps the run sorted
+        std::inplace_merge(merged.begin(), merged.begin() + mid, merged.end(),
+                           [](auto& a, auto& b) { return std::get<0>(a) < std::get<0>(b); });
+        next += merged.size() - mid;
+        it = delete_record.staged_batches_.erase(it);
+    }
+    if (next == cursor) {
+        return;
+    }
+
+    auto total = next - cursor;
+    std::vector<Timestamp> timestamps(total);
+    std::vector<T> pks(total);
+    for (int64_t i = 0; i < total; i++) {
+        timestamps[i] = std::get<0>(merged[i]);
+        pks[i] = std::move(std::get<1>(merged[i]));
+    }
+    delete_record.timestamps_.set_data_raw(cursor, timestamps.data(), total);
+    delete_record.pks<T>().set_data_raw(cursor, pks.data(), total);
+    delete_record.ack_responder_.AddSegment(cursor, next);
+}
+
+template <typename T>
+static void
+stage_delete_records_typed(DeletedRecord& delete_record,
+                           const IdArray& ids,
+                           const Timestamp* timestamps_raw,
+                           int64_t size,
+                           int64_t reserved_offset) {
+    std::vector<T> pks(size);
+    ParsePksFromIDs(pks, ids);
+
+    auto batch = std::make_unique<StagedDeleteBatch<T>>();
+    batch->records.resize(size);
+    for (int64_t i = 0; i < size; i++) {
+        batch->records[i] = std::make_tuple(timestamps_raw[i], std::move(pks[i]));
+    }
+    std::sort(batch->records.begin(), batch->records.end(),
+              [](auto& a, auto& b) { return std::get<0>(a) < std::get<0>(b); });
+
+    std::lock_guard lck(delete_record.staging_mutex_);
+    delete_record.staged_batches_.emplace(reserved_offset, std::move(batch));
+    drain_staged_deletes_typed<T>(delete_record);
+}
+
+void
+stage_delete_records(DeletedRecord& delete_record,
+                     const IdArray& ids,
+                     const Timestamp* timestamps_raw,
+                     int64_t size,
+                     int64_t reserved_offset) {
+    switch (delete_record.pk_type()) {
+        case DataType::INT64: {
+            stage_delete_records_typed<int64_t>(delete_record, ids, timestamps_raw, size, reserved_offset);
+            break;
+        }
+        case DataType::VARCHAR: {
+            stage_delete_records_typed<std::string>(delete_record, ids, timestamps_raw, size, reserved_offset);
+            break;
+        }
+        default: {
+            PanicInfo("unsupported pk type");
+        }
+    }
+}
+
+template <typename T>
+static std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
+search_ids_by_pks_typed(const InsertRecord& insert_record,
+                        const IdArray& id_array,
+                        Timestamp timestamp,
+                        void (*add_id)(IdArray&, const T&)) {
+    auto ids_size = GetSizeOfIdArray(id_array);
+    std::vector<T> pks(ids_size);
+    ParsePksFromIDs(pks, id_array);
+
+    auto res_id_arr = std::make_unique<IdArray>();
+    std::vector<SegOffset> res_offsets;
+    for (auto& pk : pks) {
+        auto segOffsets = insert_record.search_pk(pk, timestamp);
         for (auto offset : segOffsets) {
-            int64_t insert_row_offset = offset.get();
-            // for now, insert_barrier == insert count of segment, so this Assert will always work
-            AssertInfo(insert_row_offset < insert_barrier, "Timestamp offset is larger than insert barrier");
-
-            // insert after delete with same pk, delete will not task effect on this insert record
-            // and reset bitmap to 0
-            if (insert_record.timestamps_[insert_row_offset] > delete_timestamp) {
-                bitmap->reset(insert_row_offset);
-                continue;
-            }
+            add_id(*res_id_arr, pk);
+            res_offsets.push_back(offset);
+        }
+    }
+    return {std::move(res_id_arr), std::move(res_offsets)};
+}
 
-            // the deletion record do not take effect in search/query
-            // and reset bitmap to 0
-            if (delete_timestamp > query_timestamp) {
-                bitmap->reset(insert_row_offset);
-                continue;
+std::vector<SegOffset>
+search_ids_with_limit(const InsertRecord& insert_record, const BitsetView& bitset, Timestamp timestamp, int64_t limit) {
+    std::vector<SegOffset> res_offsets;
+    if (limit == 0) {
+        return res_offsets;
+    }
+    const int64_t num_bits = bitset.size();
+    // retrieve hands whole-segment bitmaps in here, never mid-byte subviews
+    AssertInfo(bitset.byte_aligned(), "search_ids_with_limit expects a byte-aligned bitset");
+    const uint8_t* data = bitset.data();
+    for (int64_t base = 0; base < num_bits; base += 64) {
+        uint64_t word = 0;
+        auto bytes = std::min<int64_t>(8, (num_bits - base + 7) / 8);
+        std::memcpy(&word, data + (base >> 3), bytes);
+        // set bits are the filtered rows; survivors come from the inverse
+        word = ~word;
+        if (num_bits - base < 64) {
+            word &= (uint64_t(1) << (num_bits - base)) - 1;
+        }
+        while (word != 0) {
+            auto offset = base + __builtin_ctzll(word);
+            word &= word - 1;
+            if (insert_record.timestamps_[offset] <= timestamp) {
+                res_offsets.emplace_back(offset);
+                if (limit > 0 && static_cast<int64_t>(res_offsets.size()) >= limit) {
+                    return res_offsets;
+                }
             }
-            // insert data corresponding to the insert_row_offset will be ignored in search/query
-            bitmap->set(insert_row_offset);
         }
     }
+    return res_offsets;
+}
+
+std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
+search_ids_by_pks(const InsertRecord& insert_record, const IdArray& id_array, DataType pk_type, Timestamp timestamp) {
+    switch (pk_type) {
+        case DataType::INT64: {
+            return search_ids_by_pks_typed<int64_t>(
+                insert_record, id_array, timestamp,
+                [](IdArray& arr, const int64_t& pk) { arr.mutable_int_id()->add_data(pk); });
+        }
+        case DataType::VARCHAR: {
+            return search_ids_by_pks_typed<std::string>(
+                insert_record, id_array, timestamp,
+                [](IdArray& arr, const std::string& pk) { arr.mutable_str_id()->add_data(pk); });
+        }
+        default: {
+            PanicInfo("unsupported pk type");
+        }
+    }
+}
+
+void
+advance_deleted_bitmap(DeletedRecord& delete_record,
+                       const InsertRecord& insert_record,
+                       int64_t del_barrier,
+                       int64_t insert_barrier) {
+    // fold the new slice of the delete log into the shared accumulated bitmap;
+    // applying every record is timestamp-independent, queries behind the
+    // barrier rewind their private snapshot instead
+    delete_record.advance_accumulated(del_barrier, insert_barrier, [&](BitsetType& bitmap, int64_t start, int64_t end) {
+        resolve_delete_records(delete_record, insert_record, start, end, insert_barrier, bitmap, true);
+    });
+}
+
+std::shared_ptr<DeletedRecord::TmpBitmap>
+get_deleted_bitmap(int64_t del_barrier,
+                   int64_t insert_barrier,
+                   DeletedRecord& delete_record,
+                   const InsertRecord& insert_record,
+                   Timestamp query_timestamp) {
+    // by construction of get_barrier all ts in delete record[0 : del_barrier)
+    // are visible to this query, so advancing up to it is always safe
+    advance_deleted_bitmap(delete_record, insert_record, del_barrier, insert_barrier);
+
+    int64_t accum_del_barrier = 0;
+    auto current = delete_record.snapshot_accumulated(insert_barrier, accum_del_barrier);
+    current->del_barrier = del_barrier;
+
+    if (del_barrier < accum_del_barrier) {
+        // ts of delete record[del_barrier : accum_del_barrier] > query_timestamp,
+        // so these deletion records do not take effect in this query/search and
+        // are cleared on the private copy only
+        resolve_delete_records(delete_record, insert_record, del_barrier, accum_del_barrier, insert_barrier,
+                               *current->bitmap_ptr, false);
+    }
 
-    delete_record.insert_lru_entry(current);
     return current;
 }
 
@@ -17,6 +17,7 @@
 #include <utility>
 #include <vector>
 
+#include "common/BitsetView.h"
 #include "common/QueryResult.h"
 #include "knowhere/index/Index.h"
 #include "segcore/DeletedRecord.h"
@@ -30,6 +31,20 @@ ParsePksFromFieldData(std::vector<PkType>& pks, const DataArray& data);
 void
 ParsePksFromIDs(std::vector<PkType>& pks, DataType data_type, const IdArray& data);
 
+// typed overloads: the hot insert/delete paths resolve the schema pk type
+// once per batch and copy straight into flat vectors
+void
+ParsePksFromFieldData(std::vector<int64_t>& pks, const DataArray& data);
+
+void
+ParsePksFromFieldData(std::vector<std::string>& pks, const DataArray& data);
+
+void
+ParsePksFromIDs(std::vector<int64_t>& pks, const IdArray& data);
+
+void
+ParsePksFromIDs(std::vector<std::string>& pks, const IdArray& data);
+
 int64_t
 GetSizeOfIdArray(const IdArray& data);
 
@@ -48,6 +63,52 @@ CreateDataArrayFrom(const void* data_raw, int64_t count, const FieldMeta& field_
 std::unique_ptr<DataArray>
 MergeDataArray(std::vector<std::pair<milvus::SearchResult*, int64_t>>& result_offsets, const FieldMeta& field_meta);
 
+// copy of src with row i holding src's row perm[i]; clustered ingest uses
+// it to reorder an insert batch before the columns land in chunks
+std::unique_ptr<DataArray>
+PermuteDataArray(const DataArray& src, const FieldMeta& field_meta, const std::vector<int64_t>& perm);
+
+// appends size delete records into the record's typed pk column, optionally
+// sorted by timestamp; the pk type is dispatched once for the whole batch
+void
+append_delete_records(DeletedRecord& delete_record,
+                      const IdArray& ids,
+                      const Timestamp* timestamps_raw,
+                      int64_t size,
+                      int64_t reserved_offset,
+                      bool sort_by_timestamp);
+
+// Stages one live delete batch and merges every staged batch that became
+// contiguous with the acked log into a single timestamp-sorted run, so
+// concurrent Delete calls cannot interleave independently sorted ranges
+// into the log that get_barrier binary-searches.
+void
+stage_delete_records(DeletedRecord& delete_record,
+                     const IdArray& ids,
+                     const Timestamp* timestamps_raw,
+                     int64_t size,
+                     int64_t reserved_offset);
+
+// resolves each id against the pk index and echoes back the ids that hit;
+// dispatches on the pk type per batch instead of per pk
+std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
+search_ids_by_pks(const InsertRecord& insert_record, const IdArray& id_array, DataType pk_type, Timestamp timestamp);
+
+// offsets of the first `limit` clear bits of `bitset` (the filter's
+// survivors) whose insert timestamps are visible at `timestamp`; limit < 0
+// collects every match. Scans word-wise and skips fully-set words, so a
+// small limit touches only the leading words of a large segment.
+std::vector<SegOffset>
+search_ids_with_limit(const InsertRecord& insert_record, const BitsetView& bitset, Timestamp timestamp, int64_t limit);
+
+// folds delete record [0, del_barrier) into the record's accumulated bitmap;
+// called as deletes arrive so query-time application stays constant
+void
+advance_deleted_bitmap(DeletedRecord& delete_record,
+                       const InsertRecord& insert_record,
+                       int64_t del_barrier,
+                       int64_t insert_barrier);
+
 std::shared_ptr<DeletedRecord::TmpBitmap>
 get_deleted_bitmap(int64_t del_barrier,
                    int64_t insert_barrier,
@@ -9,14 +9,37 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <cstring>
+#include <future>
+#include <vector>
+
 #include "common/CDataType.h"
 #include "common/LoadInfo.h"
+#include "common/Metrics.h"
+#include "common/ThreadPool.h"
 #include "exceptions/EasyAssert.h"
 #include "index/IndexFactory.h"
 #include "knowhere/common/BinarySet.h"
 #include "knowhere/index/VecIndexFactory.h"
+#include "segcore/ChunkArena.h"
+#include "segcore/LoadAdmission.h"
 #include "segcore/load_index_c.h"
 
+namespace {
+
+// deserializing an index transiently holds the binary set alongside the
+// built index, roughly doubling its wire size
+int64_t
+estimated_load_bytes(const knowhere::BinarySet& binary_set) {
+    int64_t total = 0;
+    for (auto& [key, binary] : binary_set.binary_map_) {
+        total += binary->size;
+    }
+    return 2 * total;
+}
+
+}  // namespace
+
 CStatus
 NewLoadIndexInfo(CLoadIndexInfo* c_load_index_info) {
     try {
@@ -79,6 +102,16 @@ AppendFieldInfo(CLoadIndexInfo c_load_index_info, int64_t field_id, enum CDataTy
     }
 }
 
+CStatus
+AppendIndexEnableHugepages(CLoadIndexInfo c_load_index_info, bool enable) {
+    auto load_index_info = (LoadIndexInfo*)c_load_index_info;
+    load_index_info->enable_hugepages = enable;
+    auto status = CStatus();
+    status.error_code = Success;
+    status.error_msg = "";
+    return status;
+}
+
 CStatus
 appendVecIndex(CLoadIndexInfo c_load_index_info, CBinarySet c_binary_set) {
     try {
@@ -139,8 +172,80 @@ CStatus
 AppendIndex(CLoadIndexInfo c_load_index_info, CBinarySet c_binary_set) {
     auto load_index_info = (LoadIndexInfo*)c_load_index_info;
     auto field_type = load_index_info->field_type;
+    auto binary_set = (knowhere::BinarySet*)c_binary_set;
+    milvus::segcore::LoadAdmissionGuard admission(estimated_load_bytes(*binary_set));
     if (milvus::IsVectorType(field_type)) {
         return appendVecIndex(c_load_index_info, c_binary_set);
     }
     return appendScalarIndex(c_load_index_info, c_binary_set);
 }
+
+CStatus
+AppendIndexSlices(CLoadIndexInfo c_load_index_info,
+                  const char* const* keys,
+                  const uint8_t* const* slice_datas,
+                  const int64_t* slice_sizes,
+                  int64_t num_slices) {
+    try {
+        AssertInfo(num_slices > 0, "empty slice batch passed to AppendIndexSlices");
+        auto load_index_info = (LoadIndexInfo*)c_load_index_info;
+        // hugepage staging: the slice copies land in 2 MiB-page slabs, and
+        // every buffer's shared_ptr owns the arena, so whatever the index
+        // keeps after Load stays hugepage-backed for its whole lifetime
+        // while an index that copies lets the arena die with the binary set
+        std::shared_ptr<milvus::segcore::HugepageArena> arena;
+        if (load_index_info->enable_hugepages) {
+            arena = std::make_shared<milvus::segcore::HugepageArena>();
+        }
+        // duplicate the blobs on the load pool: slices are independent, so
+        // a node re-loading many indexes after restart fans the copies out
+        // across cores instead of walking them one CGO call at a time
+        std::vector<std::shared_ptr<uint8_t[]>> buffers(num_slices);
+        auto& pool = milvus::ThreadPool::GetInstance(milvus::ThreadPoolRole::Load);
+        std::vector<std::future<void>> futures;
+        futures.reserve(num_slices);
+        for (int64_t i = 0; i < num_slices; ++i) {
+            futures.emplace_back(pool.Submit([&, i] {
+                if (arena != nullptr) {
+                    auto dup = static_cast<uint8_t*>(
+                        arena->allocate(slice_sizes[i], milvus::segcore::ChunkArena::kChunkAlignment));
+                    memcpy(dup, slice_datas[i], slice_sizes[i]);
+                    buffers[i] = std::shared_ptr<uint8_t[]>(arena, dup);
+                    return;
+                }
+                auto dup = new uint8_t[slice_sizes[i]];
+                memcpy(dup, slice_datas[i], slice_sizes[i]);
+                buffers[i] = std::shared_ptr<uint8_t[]>(dup);
+            }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+
+        knowhere::BinarySet binary_set;
+        for (int64_t i = 0; i < num_slices; ++i) {
+            binary_set.Append(keys[i], buffers[i], slice_sizes[i]);
+        }
+        auto status = AppendIndex(c_load_index_info, (CBinarySet)&binary_set);
+        if (arena != nullptr && status.error_code == Success) {
+            // arena stays reachable on the info for per-index inspection;
+            // the registry aggregates what backing loads actually got
+            load_index_info->index_arena = arena;
+            static auto& huge_bytes =
+                milvus::MetricsRegistry::GetInstance().GetCounter("segcore.load.index_hugepage_bytes");
+            static auto& fallback_bytes =
+                milvus::MetricsRegistry::GetInstance().GetCounter("segcore.load.index_hugepage_fallback_bytes");
+            static auto& arena_bytes =
+                milvus::MetricsRegistry::GetInstance().GetHistogram("segcore.load.index_arena_bytes");
+            huge_bytes.Increment(arena->huge_bytes());
+            fallback_bytes.Increment(arena->fallback_bytes());
+            arena_bytes.Observe(arena->allocated_bytes());
+        }
+        return status;
+    } catch (std::exception& e) {
+        auto status = CStatus();
+        status.error_code = UnexpectedError;
+        status.error_msg = strdup(e.what());
+        return status;
+    }
+}
@@ -35,9 +35,27 @@ AppendIndexParam(CLoadIndexInfo c_load_index_info, const char* index_key, const
 CStatus
 AppendFieldInfo(CLoadIndexInfo c_load_index_info, int64_t field_id, enum CDataType field_type);
 
+// place this index's deserialized binary buffers into an explicit 2 MiB
+// hugepage arena (falling back to transparent-hugepage advice when the
+// pool is empty); call before AppendIndexSlices
+CStatus
+AppendIndexEnableHugepages(CLoadIndexInfo c_load_index_info, bool enable);
+
 CStatus
 AppendIndex(CLoadIndexInfo c_load_index_info, CBinarySet c_binary_set);
 
+// batched alternative to NewBinarySet + per-slice AppendIndexBinary +
+// AppendIndex: takes every serialized slice in one call, copies them into
+// the binary set on the load worker pool in parallel, then loads the index.
+// Slice i is slice_datas[i] with slice_sizes[i] bytes under keys[i]; the
+// caller may free the slices as soon as the call returns.
+CStatus
+AppendIndexSlices(CLoadIndexInfo c_load_index_info,
+                  const char* const* keys,
+                  const uint8_t* const* slice_datas,
+                  const int64_t* slice_sizes,
+                  int64_t num_slices);
+
 #ifdef __cplusplus
 }
 #endif
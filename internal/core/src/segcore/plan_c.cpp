@@ -13,6 +13,7 @@
 #include "pb/segcore.pb.h"
 #include "query/Plan.h"
 #include "segcore/Collection.h"
+#include "segcore/PlanCache.h"
 #include "segcore/plan_c.h"
 
 CStatus
@@ -49,13 +50,26 @@ CreateSearchPlanByExpr(CCollection c_col, const void* serialized_expr_plan, cons
     auto col = (milvus::segcore::Collection*)c_col;
 
     try {
-        auto res = milvus::query::CreateSearchPlanByExpr(*col->get_schema(), serialized_expr_plan, size);
+        auto schema = col->get_schema();
+        // cache key: schema identity + the serialized plan bytes (placeholder
+        // values travel separately, so identical bytes mean identical plans)
+        std::string key;
+        key.reserve(sizeof(uintptr_t) + size);
+        auto schema_tag = reinterpret_cast<uintptr_t>(schema.get());
+        key.append(reinterpret_cast<const char*>(&schema_tag), sizeof(schema_tag));
+        key.append(static_cast<const char*>(serialized_expr_plan), size);
+
+        auto& cache = milvus::segcore::PlanCache::GetInstance();
+        auto res = cache.GetOrCreate(key, [&] {
+            return std::shared_ptr<milvus::query::Plan>(
+                milvus::query::CreateSearchPlanByExpr(*schema, serialized_expr_plan, size).release());
+        });
+        cache.Pin(res);
 
         auto status = CStatus();
         status.error_code = Success;
         status.error_msg = "";
-        auto plan = (CSearchPlan)res.release();
-        *res_plan = plan;
+        *res_plan = (CSearchPlan)res.get();
         return status;
     } catch (milvus::SegcoreError& e) {
         auto status = CStatus();
@@ -130,7 +144,11 @@ GetMetricType(CSearchPlan plan) {
 void
 DeleteSearchPlan(CSearchPlan cPlan) {
     auto plan = (milvus::query::Plan*)cPlan;
-    delete plan;
+    // cached plans are reference-counted by the cache; only plans created
+    // outside it (the DSL path) are owned by the handle
+    if (!milvus::segcore::PlanCache::GetInstance().Unpin(plan)) {
+        delete plan;
+    }
 }
 
 void
@@ -170,6 +188,12 @@ CreateRetrievePlanByExpr(CCollection c_col,
     }
 }
 
+void
+SetRetrievePlanLimit(CRetrievePlan c_plan, const int64_t limit) {
+    auto plan = (milvus::query::RetrievePlan*)c_plan;
+    plan->plan_node_->limit_ = limit;
+}
+
 void
 DeleteRetrievePlan(CRetrievePlan c_plan) {
     auto plan = (milvus::query::RetrievePlan*)c_plan;
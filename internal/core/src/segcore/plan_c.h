@@ -60,6 +60,11 @@ CreateRetrievePlanByExpr(CCollection c_col,
                          const int64_t size,
                          CRetrievePlan* res_plan);
 
+// caps how many matching rows a retrieve collects; the offset scan stops
+// at the cap instead of walking the whole segment. -1 restores unbounded.
+void
+SetRetrievePlanLimit(CRetrievePlan plan, const int64_t limit);
+
 void
 DeleteRetrievePlan(CRetrievePlan plan);
 
@@ -68,6 +68,56 @@ GetSearchResultDataBlob(CProto* searchResultDataBlob,
     }
 }
 
+CStatus
+NewStreamReduce(CStreamReduce* c_stream_reduce,
+                CSearchPlan c_plan,
+                int64_t* slice_nqs,
+                int64_t* slice_topKs,
+                int64_t num_slices) {
+    try {
+        auto plan = static_cast<milvus::query::Plan*>(c_plan);
+        AssertInfo(num_slices > 0, "num_slices must be greater than 0");
+        auto stream_reduce =
+            std::make_unique<milvus::segcore::StreamReduceHelper>(plan, slice_nqs, slice_topKs, num_slices);
+        *c_stream_reduce = stream_reduce.release();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+CStatus
+StreamReduceAddSearchResult(CStreamReduce c_stream_reduce, CSearchResult c_search_result) {
+    try {
+        auto stream_reduce = static_cast<milvus::segcore::StreamReduceHelper*>(c_stream_reduce);
+        stream_reduce->AddSearchResult(static_cast<SearchResult*>(c_search_result));
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+CStatus
+FinishStreamReduce(CSearchResultDataBlobs* cSearchResultDataBlobs, CStreamReduce c_stream_reduce) {
+    try {
+        auto stream_reduce = static_cast<milvus::segcore::StreamReduceHelper*>(c_stream_reduce);
+        stream_reduce->Finish();
+        *cSearchResultDataBlobs = stream_reduce->GetSearchResultDataBlobs();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+void
+DeleteStreamReduce(CStreamReduce c_stream_reduce) {
+    if (c_stream_reduce == nullptr) {
+        return;
+    }
+    auto stream_reduce = static_cast<milvus::segcore::StreamReduceHelper*>(c_stream_reduce);
+    delete stream_reduce;
+}
+
 void
 DeleteSearchResultDataBlobs(CSearchResultDataBlobs cSearchResultDataBlobs) {
     if (cSearchResultDataBlobs == nullptr) {
@@ -18,6 +18,7 @@ extern "C" {
 #include "segcore/segment_c.h"
 
 typedef void* CSearchResultDataBlobs;
+typedef void* CStreamReduce;
 
 CStatus
 ReduceSearchResultsAndFillData(CSearchResultDataBlobs* cSearchResultDataBlobs,
@@ -36,6 +37,25 @@ GetSearchResultDataBlob(CProto* searchResultDataBlob,
 void
 DeleteSearchResultDataBlobs(CSearchResultDataBlobs cSearchResultDataBlobs);
 
+// incremental variant of ReduceSearchResultsAndFillData: feed each segment's
+// result as it completes, then finish to get the marshalled blobs; added
+// search results must outlive FinishStreamReduce
+CStatus
+NewStreamReduce(CStreamReduce* c_stream_reduce,
+                CSearchPlan c_plan,
+                int64_t* slice_nqs,
+                int64_t* slice_topKs,
+                int64_t num_slices);
+
+CStatus
+StreamReduceAddSearchResult(CStreamReduce c_stream_reduce, CSearchResult c_search_result);
+
+CStatus
+FinishStreamReduce(CSearchResultDataBlobs* cSearchResultDataBlobs, CStreamReduce c_stream_reduce);
+
+void
+DeleteStreamReduce(CStreamReduce c_stream_reduce);
+
 #ifdef __cplusplus
 }
 #endif
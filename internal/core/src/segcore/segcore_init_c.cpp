@@ -9,8 +9,14 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include "common/Metrics.h"
+#include "common/SimdDispatch.h"
+#include "common/ThreadPool.h"
 #include "config/ConfigKnowhere.h"
+#include "log/AsyncLogSink.h"
 #include "log/Log.h"
+#include "segcore/ChunkArena.h"
+#include "segcore/LoadAdmission.h"
 #include "segcore/SegcoreConfig.h"
 #include "segcore/segcore_init_c.h"
 
@@ -27,6 +33,12 @@ SegcoreSetChunkRows(const int64_t value) {
     config.set_chunk_rows(value);
 }
 
+extern "C" void
+SegcoreSetSearchConcurrency(const int64_t value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_search_concurrency(value);
+}
+
 extern "C" void
 SegcoreSetNlist(const int64_t value) {
     milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
@@ -39,6 +51,50 @@ SegcoreSetNprobe(const int64_t value) {
     config.set_nprobe(value);
 }
 
+extern "C" void
+SegcoreSetSearchCoalescing(const bool value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_search_coalescing(value);
+}
+
+extern "C" void
+SegcoreSetResultBlobCompression(const int64_t zstd_level) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_result_blob_zstd_level(zstd_level);
+}
+
+extern "C" void
+SegcoreSetSmallIndexType(const char* value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_small_index_type(value);
+}
+
+extern "C" void
+SegcoreSetFp16VectorStorage(const bool value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_fp16_vector_storage(value);
+}
+
+extern "C" void
+SegcoreSetEvictIndexedVectorChunks(const bool value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_evict_indexed_vector_chunks(value);
+    LOG_SEGCORE_DEBUG_ << "set config evict indexed vector chunks: " << std::boolalpha << value;
+}
+
+extern "C" void
+SegcoreSetDictVarcharStorage(const bool value) {
+    milvus::segcore::SegcoreConfig& config = milvus::segcore::SegcoreConfig::default_config();
+    config.set_dict_varchar_storage(value);
+    LOG_SEGCORE_DEBUG_ << "set config dict varchar storage: " << std::boolalpha << value;
+}
+
+extern "C" void
+SegcoreSetEnableHugepages(const bool value) {
+    milvus::segcore::MmapChunkArena::set_use_hugepages(value);
+    LOG_SEGCORE_DEBUG_ << "set config enable hugepages: " << std::boolalpha << value;
+}
+
 // return value must be freed by the caller
 extern "C" char*
 SegcoreSetSimdType(const char* value) {
@@ -50,10 +106,85 @@ SegcoreSetSimdType(const char* value) {
     return ret;
 }
 
+// return value must be freed by the caller
+extern "C" char*
+SegcoreGetSimdLevel() {
+    std::string name = milvus::SimdLevelName(milvus::GetEffectiveSimdLevel());
+    char* ret = reinterpret_cast<char*>(malloc(name.length() + 1));
+    memcpy(ret, name.c_str(), name.length());
+    ret[name.length()] = 0;
+    return ret;
+}
+
 extern "C" void
 SegcoreSetIndexSliceSize(const int64_t value) {
     milvus::config::KnowhereSetIndexSliceSize(value);
     LOG_SEGCORE_DEBUG_ << "set config index slice size: " << value;
 }
 
+extern "C" void
+SegcoreSetSearchPoolSize(const int64_t value) {
+    milvus::ThreadPool::SetNumThreads(milvus::ThreadPoolRole::Search, value);
+    LOG_SEGCORE_DEBUG_ << "set search pool size: " << value;
+}
+
+extern "C" void
+SegcoreSetBuildPoolSize(const int64_t value) {
+    milvus::ThreadPool::SetNumThreads(milvus::ThreadPoolRole::Build, value);
+    LOG_SEGCORE_DEBUG_ << "set build pool size: " << value;
+}
+
+extern "C" void
+SegcoreSetLoadPoolSize(const int64_t value) {
+    milvus::ThreadPool::SetNumThreads(milvus::ThreadPoolRole::Load, value);
+    LOG_SEGCORE_DEBUG_ << "set load pool size: " << value;
+}
+
+extern "C" void
+SegcoreSetLoadMemoryBudget(const int64_t bytes) {
+    milvus::segcore::LoadAdmission::GetInstance().SetBudget(bytes);
+    LOG_SEGCORE_DEBUG_ << "set load memory budget: " << bytes;
+}
+
+extern "C" void
+SegcoreSetEnableAsyncLogging(const bool value) {
+    if (value) {
+        milvus::AsyncLogSink::Enable();
+        LOG_SEGCORE_DEBUG_ << "enable async logging";
+    } else {
+        LOG_SEGCORE_DEBUG_ << "disable async logging";
+        milvus::AsyncLogSink::Disable();
+    }
+}
+
+// return value must be freed by the caller
+extern "C" char*
+SegcoreGetMetricsSnapshot() {
+    std::string snapshot = milvus::MetricsRegistry::GetInstance().Snapshot();
+    char* ret = reinterpret_cast<char*>(malloc(snapshot.length() + 1));
+    memcpy(ret, snapshot.c_str(), snapshot.length());
+    ret[snapshot.length()] = 0;
+    return ret;
+}
+
+extern "C" int64_t
+SegcoreGetSearchPoolQueueDepth() {
+    return milvus::ThreadPool::GetInstance(milvus::ThreadPoolRole::Search).queue_depth();
+}
+
+extern "C" int64_t
+SegcoreGetBuildPoolQueueDepth() {
+    return milvus::ThreadPool::GetInstance(milvus::ThreadPoolRole::Build).queue_depth();
+}
+
+extern "C" int64_t
+SegcoreGetLoadPoolQueueDepth() {
+    return milvus::ThreadPool::GetInstance(milvus::ThreadPoolRole::Load).queue_depth();
+}
+
+extern "C" int64_t
+SegcoreGetLoadAdmissionQueueDepth() {
+    return milvus::segcore::LoadAdmission::GetInstance().queue_depth();
+}
+
 }  // namespace milvus::segcore
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -21,19 +23,108 @@ SegcoreInit(const char*);
 void
 SegcoreSetChunkRows(const int64_t);
 
+void
+SegcoreSetSearchConcurrency(const int64_t);
+
 void
 SegcoreSetNlist(const int64_t);
 
 void
 SegcoreSetNprobe(const int64_t);
 
+// batch concurrent identical searches on a segment into one execution
+void
+SegcoreSetSearchCoalescing(const bool);
+
+// zstd-compress marshalled search-result blobs at the given level before
+// they cross nodes; 0 ships them raw. Both sides read the same config, so
+// the flag is the negotiation
+void
+SegcoreSetResultBlobCompression(const int64_t);
+
+// per-chunk index family for growing float vectors ("IVF" or "HNSW");
+// applies to segments created after the call
+void
+SegcoreSetSmallIndexType(const char*);
+
+// store growing float vector chunks as half precision; applies to
+// segments created after the call
+void
+SegcoreSetFp16VectorStorage(const bool);
+
+// release raw vector chunks of growing segments once their per-chunk
+// index is built and verified to return stored rows; retrieval then
+// reconstructs those rows from the index. Applies to segments created
+// after the call
+void
+SegcoreSetEvictIndexedVectorChunks(const bool);
+
+// store non-pk VarChar columns dictionary-encoded (per-chunk dictionary
+// plus integer codes); applies to segments created after the call
+void
+SegcoreSetDictVarcharStorage(const bool);
+
+// back sealed column slabs with explicit 2 MiB hugepages when the host has
+// some reserved; falls back to file-backed slabs when the pool is empty
+void
+SegcoreSetEnableHugepages(const bool);
+
 // return value must be freed by the caller
 char*
 SegcoreSetSimdType(const char*);
 
+// instruction-set level segcore's own kernels actually selected
+// ("avx2", "sse4_2" or "scalar"); return value must be freed by the caller
+char*
+SegcoreGetSimdLevel();
+
 void
 SegcoreSetIndexSliceSize(const int64_t);
 
+// pool sizes must be set before the first search/build/load runs; once the
+// workers are up the size sticks for the process lifetime
+void
+SegcoreSetSearchPoolSize(const int64_t);
+
+void
+SegcoreSetBuildPoolSize(const int64_t);
+
+void
+SegcoreSetLoadPoolSize(const int64_t);
+
+// node-wide byte budget for the transient memory of concurrent segment
+// loads (decode buffers plus decoded columns); loads beyond the budget
+// queue instead of allocating. 0 (the default) disables admission. May be
+// changed at runtime
+void
+SegcoreSetLoadMemoryBudget(const int64_t);
+
+// route log writes through a background writer thread instead of the
+// logging thread; disabling drains pending entries before returning
+void
+SegcoreSetEnableAsyncLogging(const bool);
+
+// json snapshot of segcore's always-on counters and histograms for the
+// metrics scraper; return value must be freed by the caller
+char*
+SegcoreGetMetricsSnapshot();
+
+// tasks waiting for a worker in the respective pool
+int64_t
+SegcoreGetSearchPoolQueueDepth();
+
+int64_t
+SegcoreGetBuildPoolQueueDepth();
+
+int64_t
+SegcoreGetLoadPoolQueueDepth();
+
+// loads currently queued behind the load memory budget; the in-use and
+// queued bytes also appear in the metrics snapshot under
+// segcore.load.admission_*
+int64_t
+SegcoreGetLoadAdmissionQueueDepth();
+
 #ifdef __cplusplus
 }
 #endif
@@ -9,17 +9,28 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <chrono>
+#include <future>
+#include <vector>
+
+#include <arrow/c/bridge.h>
+
 #include "common/CGoHelper.h"
 #include "common/LoadInfo.h"
+#include "common/ThreadPool.h"
 #include "common/Types.h"
 #include "common/type_c.h"
 #include "log/Log.h"
 
+#include "segcore/ArrowExport.h"
+#include "segcore/ArrowIngest.h"
 #include "segcore/Collection.h"
+#include "segcore/LoadAdmission.h"
 #include "segcore/SegmentGrowingImpl.h"
 #include "segcore/SegmentSealedImpl.h"
 #include "segcore/SimilarityCorelation.h"
 #include "segcore/segment_c.h"
+#include "storage/ArrowMemoryPool.h"
 #include "google/protobuf/text_format.h"
 
 //////////////////////////////    common interfaces    //////////////////////////////
@@ -60,6 +71,17 @@ DeleteSearchResult(CSearchResult search_result) {
     delete res;
 }
 
+CStatus
+GetSearchProfile(CSearchResult search_result, const char** profile_json) {
+    try {
+        auto res = (milvus::SearchResult*)search_result;
+        *profile_json = strdup(res->profile_.ToJson().c_str());
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
 CStatus
 Search(CSegmentInterface c_segment,
        CSearchPlan c_plan,
@@ -72,9 +94,8 @@ Search(CSegmentInterface c_segment,
         auto phg_ptr = reinterpret_cast<const milvus::query::PlaceholderGroup*>(c_placeholder_group);
         auto search_result = segment->Search(plan, phg_ptr, timestamp);
         if (!milvus::segcore::PositivelyRelated(plan->plan_node_->search_info_.metric_type_)) {
-            for (auto& dis : search_result->distances_) {
-                dis *= -1;
-            }
+            milvus::segcore::NegateDistances(search_result->distances_.data(),
+                                             static_cast<int64_t>(search_result->distances_.size()));
         }
         *result = search_result.release();
         return milvus::SuccessCStatus();
@@ -83,6 +104,206 @@ Search(CSegmentInterface c_segment,
     }
 }
 
+namespace {
+
+milvus::TaskOptions
+ToTaskOptions(const CQueryOptions& options) {
+    milvus::TaskOptions task_options;
+    switch (options.priority) {
+        case 0: {
+            task_options.priority = milvus::TaskPriority::Interactive;
+            break;
+        }
+        case 2: {
+            task_options.priority = milvus::TaskPriority::Batch;
+            break;
+        }
+        default: {
+            task_options.priority = milvus::TaskPriority::Normal;
+        }
+    }
+    if (options.timeout_ms > 0) {
+        task_options.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(options.timeout_ms);
+    }
+    return task_options;
+}
+
+}  // namespace
+
+CStatus
+SearchWithOptions(CSegmentInterface c_segment,
+                  CSearchPlan c_plan,
+                  CPlaceholderGroup c_placeholder_group,
+                  uint64_t timestamp,
+                  CQueryOptions options,
+                  CSearchResult* result) {
+    // installing the options on this thread is enough: every pool submit
+    // the search fans out inherits them, and workers re-install them around
+    // nested tasks
+    milvus::ScopedTaskOptions scope(ToTaskOptions(options));
+    return Search(c_segment, c_plan, c_placeholder_group, timestamp, result);
+}
+
+CStatus
+SearchBatch(CSegmentInterface* c_segments,
+            int64_t num_segments,
+            CSearchPlan c_plan,
+            CPlaceholderGroup c_placeholder_group,
+            uint64_t timestamp,
+            CSearchResult* results) {
+    try {
+        AssertInfo(c_segments != nullptr && results != nullptr, "null segment or result array");
+        auto plan = (milvus::query::Plan*)c_plan;
+        auto phg_ptr = reinterpret_cast<const milvus::query::PlaceholderGroup*>(c_placeholder_group);
+        auto negatively_related = !milvus::segcore::PositivelyRelated(plan->plan_node_->search_info_.metric_type_);
+
+        // one crossing for the whole batch: the parsed plan and placeholder
+        // group are shared while the per-segment searches fan out on the pool
+        std::vector<std::future<std::unique_ptr<milvus::SearchResult>>> futures;
+        futures.reserve(num_segments);
+        for (int64_t i = 0; i < num_segments; ++i) {
+            auto segment = (milvus::segcore::SegmentInterface*)c_segments[i];
+            futures.emplace_back(
+                milvus::ThreadPool::GetInstance(milvus::ThreadPoolRole::Search)
+                    .Submit([segment, plan, phg_ptr, timestamp, negatively_related] {
+                    auto search_result = segment->Search(plan, phg_ptr, timestamp);
+                    if (negatively_related) {
+                        milvus::segcore::NegateDistances(search_result->distances_.data(),
+                                                         static_cast<int64_t>(search_result->distances_.size()));
+                    }
+                    return search_result;
+                }));
+        }
+        for (auto& future : futures) {
+            future.wait();
+        }
+        // collect before releasing anything so a failed segment leaks nothing
+        std::vector<std::unique_ptr<milvus::SearchResult>> search_results;
+        search_results.reserve(num_segments);
+        for (auto& future : futures) {
+            search_results.emplace_back(future.get());
+        }
+        for (int64_t i = 0; i < num_segments; ++i) {
+            results[i] = search_results[i].release();
+        }
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+namespace {
+
+// state shared between the submitting thread, the pool worker and the
+// eventual SearchAsyncGetResult call; the future is the synchronization
+// point for the result fields
+struct AsyncSearchTask {
+    std::future<void> future;
+    std::unique_ptr<milvus::SearchResult> result;
+    std::string error;
+    bool failed = false;
+    // armed per search; the worker installs it in its task options so every
+    // checkpoint the search reaches down the line polls this flag
+    milvus::CancellationToken cancellation = milvus::CancellationToken::Make();
+};
+
+}  // namespace
+
+CStatus
+SearchAsync(CSegmentInterface c_segment,
+            CSearchPlan c_plan,
+            CPlaceholderGroup c_placeholder_group,
+            uint64_t timestamp,
+            CSearchCallback callback,
+            void* callback_context,
+            CSearchFuture* c_future) {
+    try {
+        auto segment = (milvus::segcore::SegmentInterface*)c_segment;
+        auto plan = (milvus::query::Plan*)c_plan;
+        auto phg_ptr = reinterpret_cast<const milvus::query::PlaceholderGroup*>(c_placeholder_group);
+        auto negatively_related = !milvus::segcore::PositivelyRelated(plan->plan_node_->search_info_.metric_type_);
+
+        auto task = std::make_unique<AsyncSearchTask>();
+        auto* task_ptr = task.get();
+        task_ptr->future = milvus::ThreadPool::GetInstance(milvus::ThreadPoolRole::Search)
+                               .Submit([segment, phg_ptr, timestamp, negatively_related, plan, callback,
+                                        callback_context, task_ptr] {
+                                   try {
+                                       // thread the token through the task options so nested
+                                       // submits and chunk loops inherit it; the up-front check
+                                       // frees a queued-then-cancelled search without running it
+                                       auto options = milvus::ScopedTaskOptions::Current();
+                                       options.cancellation = task_ptr->cancellation;
+                                       milvus::ScopedTaskOptions scope(options);
+                                       task_ptr->cancellation.ThrowIfCancelled();
+                                       auto search_result = segment->Search(plan, phg_ptr, timestamp);
+                                       if (negatively_related) {
+                                           milvus::segcore::NegateDistances(
+                                               search_result->distances_.data(),
+                                               static_cast<int64_t>(search_result->distances_.size()));
+                                       }
+                                       task_ptr->result = std::move(search_result);
+                                   } catch (std::exception& e) {
+                                       task_ptr->failed = true;
+                                       task_ptr->error = e.what();
+                                   }
+                                   // the callback may only signal; the result itself is handed
+                                   // out by SearchAsyncGetResult, whose future wait publishes
+                                   // the writes above
+                                   if (callback != nullptr) {
+                                       callback(callback_context);
+                                   }
+                               });
+        *c_future = task.release();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+CStatus
+CancelSearch(CSearchFuture c_future) {
+    try {
+        auto task = static_cast<AsyncSearchTask*>(c_future);
+        AssertInfo(task != nullptr, "null search future");
+        task->cancellation.Cancel();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+CStatus
+SearchAsyncGetResult(CSearchFuture c_future, CSearchResult* result) {
+    try {
+        auto task = static_cast<AsyncSearchTask*>(c_future);
+        AssertInfo(task != nullptr, "null search future");
+        task->future.wait();
+        if (task->failed) {
+            *result = nullptr;
+            return milvus::FailureCStatus(UnexpectedError, task->error);
+        }
+        AssertInfo(task->result != nullptr, "search result already taken from this future");
+        *result = task->result.release();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+void
+DeleteSearchFuture(CSearchFuture c_future) {
+    if (c_future == nullptr) {
+        return;
+    }
+    auto task = static_cast<AsyncSearchTask*>(c_future);
+    // never free under a running worker
+    if (task->future.valid()) {
+        task->future.wait();
+    }
+    delete task;
+}
+
 void
 DeleteRetrieveResult(CRetrieveResult* retrieve_result) {
     std::free((void*)(retrieve_result->proto_blob));
@@ -107,6 +328,150 @@ Retrieve(CSegmentInterface c_segment, CRetrievePlan c_plan, uint64_t timestamp,
     }
 }
 
+CStatus
+RetrieveWithOptions(CSegmentInterface c_segment,
+                    CRetrievePlan c_plan,
+                    uint64_t timestamp,
+                    CQueryOptions options,
+                    CRetrieveResult* result) {
+    milvus::ScopedTaskOptions scope(ToTaskOptions(options));
+    return Retrieve(c_segment, c_plan, timestamp, result);
+}
+
+CStatus
+RetrieveArrow(CSegmentInterface c_segment,
+              CRetrievePlan c_plan,
+              uint64_t timestamp,
+              struct ArrowArray* c_array,
+              struct ArrowSchema* c_schema) {
+    try {
+        auto segment = (const milvus::segcore::SegmentInterface*)c_segment;
+        auto plan = (const milvus::query::RetrievePlan*)c_plan;
+        auto retrieve_result = segment->Retrieve(plan, timestamp);
+
+        auto pool = milvus::storage::GetArrowPool(milvus::storage::ArrowPoolScope::RetrieveExport);
+        auto batch = milvus::segcore::RetrieveResultsToArrow(*retrieve_result, pool);
+        auto status = arrow::ExportRecordBatch(*batch, c_array, c_schema);
+        AssertInfo(status.ok(), "arrow c-data export failed: " + status.ToString());
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+CStatus
+Count(CSegmentInterface c_segment, CRetrievePlan c_plan, uint64_t timestamp, int64_t* count) {
+    try {
+        auto segment_interface = reinterpret_cast<const milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment = dynamic_cast<const milvus::segcore::SegmentInternalInterface*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        auto plan = (const milvus::query::RetrievePlan*)c_plan;
+        *count = segment->Count(plan, timestamp);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+CStatus
+NewRetrieveCursor(CSegmentInterface c_segment, CRetrievePlan c_plan, uint64_t timestamp, CRetrieveCursor* cursor) {
+    try {
+        auto segment_interface = reinterpret_cast<const milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment = dynamic_cast<const milvus::segcore::SegmentInternalInterface*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        auto plan = (const milvus::query::RetrievePlan*)c_plan;
+        auto retrieve_cursor = std::make_unique<milvus::segcore::RetrieveCursor>(*segment, plan, timestamp);
+        *cursor = retrieve_cursor.release();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+CStatus
+RetrieveCursorNext(CRetrieveCursor cursor, int64_t batch_size, CRetrieveResult* result, bool* has_more) {
+    try {
+        auto retrieve_cursor = (milvus::segcore::RetrieveCursor*)cursor;
+        if (!retrieve_cursor->Next(batch_size)) {
+            *has_more = false;
+            return milvus::SuccessCStatus();
+        }
+        auto& batch = retrieve_cursor->batch();
+        auto size = batch.ByteSize();
+        void* buffer = malloc(size);
+        batch.SerializePartialToArray(buffer, size);
+
+        result->proto_blob = buffer;
+        result->proto_size = size;
+        *has_more = true;
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+void
+DeleteRetrieveCursor(CRetrieveCursor cursor) {
+    auto retrieve_cursor = (milvus::segcore::RetrieveCursor*)cursor;
+    delete retrieve_cursor;
+}
+
+// keeps the borrowed C++ result alive behind the C handle, plus the flat
+// descriptor array and the fallback blob the getters hand out
+struct RetrieveViewsResultWrapper {
+    std::unique_ptr<milvus::segcore::RetrieveViewsResult> result;
+    std::vector<CFieldDataView> views;
+    std::vector<uint8_t> fallback_blob;
+};
+
+CStatus
+RetrieveWithViews(CSegmentInterface c_segment,
+                  CRetrievePlan c_plan,
+                  uint64_t timestamp,
+                  bool accept_views,
+                  CRetrieveViewsResult* result) {
+    try {
+        auto segment_interface = reinterpret_cast<const milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment = dynamic_cast<const milvus::segcore::SegmentInternalInterface*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        auto plan = (const milvus::query::RetrievePlan*)c_plan;
+        auto wrapper = std::make_unique<RetrieveViewsResultWrapper>();
+        wrapper->result = segment->RetrieveViews(plan, timestamp, accept_views);
+        wrapper->views.reserve(wrapper->result->views.size());
+        for (auto& view : wrapper->result->views) {
+            // CDataType values mirror milvus::DataType, so the cast is exact
+            wrapper->views.push_back(CFieldDataView{view.field_id.get(), static_cast<CDataType>(view.data_type),
+                                                    view.data, view.row_count, view.element_sizeof});
+        }
+        auto size = wrapper->result->fallback.ByteSize();
+        wrapper->fallback_blob.resize(size);
+        wrapper->result->fallback.SerializePartialToArray(wrapper->fallback_blob.data(), size);
+        *result = wrapper.release();
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
+int64_t
+GetRetrieveViews(CRetrieveViewsResult result, const CFieldDataView** views) {
+    auto wrapper = static_cast<RetrieveViewsResultWrapper*>(result);
+    *views = wrapper->views.data();
+    return static_cast<int64_t>(wrapper->views.size());
+}
+
+CProto
+GetRetrieveViewsFallback(CRetrieveViewsResult result) {
+    auto wrapper = static_cast<RetrieveViewsResultWrapper*>(result);
+    return CProto{wrapper->fallback_blob.data(), static_cast<int64_t>(wrapper->fallback_blob.size())};
+}
+
+void
+DeleteRetrieveViewsResult(CRetrieveViewsResult result) {
+    // dropping the wrapper releases the segment read pin with it
+    delete static_cast<RetrieveViewsResultWrapper*>(result);
+}
+
 int64_t
 GetMemoryUsageInBytes(CSegmentInterface c_segment) {
     auto segment = (milvus::segcore::SegmentInterface*)c_segment;
@@ -114,6 +479,12 @@ GetMemoryUsageInBytes(CSegmentInterface c_segment) {
     return mem_size;
 }
 
+int64_t
+GetFieldMemoryUsageInBytes(CSegmentInterface c_segment, int64_t field_id) {
+    auto segment = (milvus::segcore::SegmentInterface*)c_segment;
+    return segment->GetFieldMemoryUsageInBytes(milvus::FieldId(field_id));
+}
+
 int64_t
 GetRowCount(CSegmentInterface c_segment) {
     auto segment = (milvus::segcore::SegmentInterface*)c_segment;
@@ -137,6 +508,17 @@ GetRealCount(CSegmentInterface c_segment) {
     return segment->get_real_count();
 }
 
+CStatus
+SetSegmentNumaNode(CSegmentInterface c_segment, int64_t numa_node) {
+    try {
+        auto segment = reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        segment->SetNumaNode(numa_node);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
 //////////////////////////////    interfaces for growing segment    //////////////////////////////
 CStatus
 Insert(CSegmentInterface c_segment,
@@ -159,6 +541,32 @@ Insert(CSegmentInterface c_segment,
     }
 }
 
+CStatus
+InsertArrow(CSegmentInterface c_segment,
+            int64_t reserved_offset,
+            int64_t size,
+            const int64_t* row_ids,
+            const uint64_t* timestamps,
+            struct ArrowArray* c_array,
+            struct ArrowSchema* c_schema) {
+    try {
+        auto segment = (milvus::segcore::SegmentGrowing*)c_segment;
+        // the import moves ownership: the batch holds the caller's buffers
+        // alive and runs their release callbacks when it goes out of scope
+        auto batch_result = arrow::ImportRecordBatch(c_array, c_schema);
+        AssertInfo(batch_result.ok(), "failed to import arrow record batch: " + batch_result.status().ToString());
+        auto batch = batch_result.ValueOrDie();
+        AssertInfo(batch->num_rows() == size, "Entities_raw count not equal to insert size");
+
+        milvus::segcore::ArrowColumnScratch scratch;
+        auto columns = milvus::segcore::MakeInsertColumns(*batch, segment->get_schema(), scratch);
+        segment->Insert(reserved_offset, size, row_ids, timestamps, columns);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
 CStatus
 PreInsert(CSegmentInterface c_segment, int64_t size, int64_t* offset) {
     try {
@@ -203,11 +611,14 @@ LoadFieldData(CSegmentInterface c_segment, CLoadFieldDataInfo load_field_data_in
         auto segment_interface = reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
         auto segment = dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
         AssertInfo(segment != nullptr, "segment conversion failed");
-        auto field_data = std::make_unique<milvus::DataArray>();
+        // decode transiently holds the proto blob plus the decoded column,
+        // so charge ~2x the wire size against the node load budget
+        milvus::segcore::LoadAdmissionGuard admission(2 * load_field_data_info.blob_size);
+        auto field_data = std::make_shared<milvus::DataArray>();
         auto suc = field_data->ParseFromArray(load_field_data_info.blob, load_field_data_info.blob_size);
         AssertInfo(suc, "unmarshal field data string failed");
-        auto load_info =
-            LoadFieldDataInfo{load_field_data_info.field_id, field_data.get(), load_field_data_info.row_count};
+        auto load_info = LoadFieldDataInfo{load_field_data_info.field_id, field_data.get(),
+                                           load_field_data_info.row_count, field_data};
         segment->LoadFieldData(load_info);
         return milvus::SuccessCStatus();
     } catch (std::exception& e) {
@@ -215,6 +626,39 @@ LoadFieldData(CSegmentInterface c_segment, CLoadFieldDataInfo load_field_data_in
     }
 }
 
+CStatus
+LoadFieldDataOwned(CSegmentInterface c_segment,
+                   CLoadFieldDataInfo load_field_data_info,
+                   void (*release_cb)(void*),
+                   void* release_ctx) {
+    auto release = [&release_cb, release_ctx] {
+        if (release_cb != nullptr) {
+            release_cb(release_ctx);
+            release_cb = nullptr;
+        }
+    };
+    try {
+        auto segment_interface = reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment = dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        // decode transiently holds the proto blob plus the decoded column,
+        // so charge ~2x the wire size against the node load budget
+        milvus::segcore::LoadAdmissionGuard admission(2 * load_field_data_info.blob_size);
+        auto field_data = std::make_shared<milvus::DataArray>();
+        auto suc = field_data->ParseFromArray(load_field_data_info.blob, load_field_data_info.blob_size);
+        // the blob is spent once decoding is done, whatever the outcome
+        release();
+        AssertInfo(suc, "unmarshal field data string failed");
+        auto load_info = LoadFieldDataInfo{load_field_data_info.field_id, field_data.get(),
+                                           load_field_data_info.row_count, field_data};
+        segment->LoadFieldData(load_info);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        release();
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
 CStatus
 LoadDeletedRecord(CSegmentInterface c_segment, CLoadDeletedRecordInfo deleted_record_info) {
     try {
@@ -232,6 +676,22 @@ LoadDeletedRecord(CSegmentInterface c_segment, CLoadDeletedRecordInfo deleted_re
     }
 }
 
+CStatus
+LoadFromGrowingSegment(CSegmentInterface c_segment, CSegmentInterface c_growing_segment) {
+    try {
+        auto segment_interface = reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment = dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        auto growing_interface = reinterpret_cast<milvus::segcore::SegmentInterface*>(c_growing_segment);
+        auto growing = dynamic_cast<milvus::segcore::SegmentGrowing*>(growing_interface);
+        AssertInfo(growing != nullptr, "growing segment conversion failed");
+        segment->LoadFromGrowing(*growing);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
 CStatus
 UpdateSealedSegmentIndex(CSegmentInterface c_segment, CLoadIndexInfo c_load_index_info) {
     try {
@@ -271,3 +731,16 @@ DropSealedSegmentIndex(CSegmentInterface c_segment, int64_t field_id) {
         return milvus::FailureCStatus(UnexpectedError, e.what());
     }
 }
+
+CStatus
+EvictCoveredFieldData(CSegmentInterface c_segment, int64_t target_bytes, int64_t* released_bytes) {
+    try {
+        auto segment_interface = reinterpret_cast<milvus::segcore::SegmentInterface*>(c_segment);
+        auto segment = dynamic_cast<milvus::segcore::SegmentSealed*>(segment_interface);
+        AssertInfo(segment != nullptr, "segment conversion failed");
+        *released_bytes = segment->EvictCoveredFieldData(target_bytes);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
@@ -37,6 +37,12 @@ DeleteSegment(CSegmentInterface c_segment);
 void
 DeleteSearchResult(CSearchResult search_result);
 
+// renders the execution profile collected while producing search_result as a
+// json string (phase timings, rows scanned/filtered, index vs brute-force
+// chunk split); the caller owns *profile_json and frees it with free()
+CStatus
+GetSearchProfile(CSearchResult search_result, const char** profile_json);
+
 CStatus
 Search(CSegmentInterface c_segment,
        CSearchPlan c_plan,
@@ -44,15 +50,179 @@ Search(CSegmentInterface c_segment,
        uint64_t timestamp,
        CSearchResult* result);
 
+// scheduling hints carried to the segcore worker pools. priority is the
+// dispatch class: 0 = interactive, 1 = normal, 2 = batch; interactive
+// dispatches dominate the weighted queues while batch keeps a minority
+// share. timeout_ms > 0 is a deadline hint: once the query is nearly
+// expired it skips ahead of the weighted queues. Zero-initialize for the
+// plain Search/Retrieve behavior.
+typedef struct CQueryOptions {
+    int32_t priority;
+    uint64_t timeout_ms;
+} CQueryOptions;
+
+// like Search, but every piece of pool work the search fans out (per-chunk
+// scans, per-segment batches) runs under the given scheduling options
+CStatus
+SearchWithOptions(CSegmentInterface c_segment,
+                  CSearchPlan c_plan,
+                  CPlaceholderGroup c_placeholder_group,
+                  uint64_t timestamp,
+                  CQueryOptions options,
+                  CSearchResult* result);
+
+// searches num_segments segments against one plan/placeholder pair in a
+// single crossing; results must hold num_segments slots and is only
+// populated when the returned status is Success
+CStatus
+SearchBatch(CSegmentInterface* c_segments,
+            int64_t num_segments,
+            CSearchPlan c_plan,
+            CPlaceholderGroup c_placeholder_group,
+            uint64_t timestamp,
+            CSearchResult* results);
+
+typedef void* CSearchFuture;
+
+// invoked exactly once on a search pool worker when the search completes,
+// success or failure; must be lightweight and must not call back into
+// segcore from inside the callback
+typedef void (*CSearchCallback)(void* context);
+
+// submits the search onto segcore's search pool and returns immediately;
+// the caller thread never parks. callback may be null when the caller polls
+// with SearchAsyncGetResult instead. plan, placeholder group and segment
+// must stay alive until the search completes
+CStatus
+SearchAsync(CSegmentInterface c_segment,
+            CSearchPlan c_plan,
+            CPlaceholderGroup c_placeholder_group,
+            uint64_t timestamp,
+            CSearchCallback callback,
+            void* callback_context,
+            CSearchFuture* c_future);
+
+// waits for completion if needed and returns the search outcome; on Success
+// the caller owns *result. The future stays valid until DeleteSearchFuture
+CStatus
+SearchAsyncGetResult(CSearchFuture c_future, CSearchResult* result);
+
+// requests cooperative cancellation of an in-flight async search: a queued
+// search returns immediately, a running one stops at its next chunk or
+// phase checkpoint. Returns without waiting; SearchAsyncGetResult then
+// reports a failed status. Cancelling a finished search is a harmless no-op
+CStatus
+CancelSearch(CSearchFuture c_future);
+
+// safe to call at any time; blocks until an in-flight search has finished
+// so no worker is left writing into freed state
+void
+DeleteSearchFuture(CSearchFuture c_future);
+
 void
 DeleteRetrieveResult(CRetrieveResult* retrieve_result);
 
 CStatus
 Retrieve(CSegmentInterface c_segment, CRetrievePlan c_plan, uint64_t timestamp, CRetrieveResult* result);
 
+// like Retrieve, but pool work runs under the given scheduling options
+CStatus
+RetrieveWithOptions(CSegmentInterface c_segment,
+                    CRetrievePlan c_plan,
+                    uint64_t timestamp,
+                    CQueryOptions options,
+                    CRetrieveResult* result);
+
+// Arrow C data interface structs (layout fixed by the arrow spec); only
+// pointers cross this header, so forward declarations suffice
+struct ArrowArray;
+struct ArrowSchema;
+
+// retrieve variant that skips the result proto's serialize/reparse round
+// trip: fills one arrow record batch (one column per requested field, each
+// column's metadata carrying its "field_id") and exports it zero-copy via
+// the Arrow C data interface. The caller owns the exported structs and
+// must invoke their release callbacks, which free the batch's buffers
+// back to the accounted arrow pool.
+CStatus
+RetrieveArrow(CSegmentInterface c_segment,
+              CRetrievePlan c_plan,
+              uint64_t timestamp,
+              struct ArrowArray* c_array,
+              struct ArrowSchema* c_schema);
+
+// filter-only count: evaluates the plan's predicate and visibility masks
+// and popcounts the result, materializing no offsets or entry data
+CStatus
+Count(CSegmentInterface c_segment, CRetrievePlan c_plan, uint64_t timestamp, int64_t* count);
+
+typedef void* CRetrieveCursor;
+
+// cursor-based retrieve for large result sets: evaluates the plan's filter
+// once, then streams the matching rows batch by batch instead of
+// materializing the whole result proto up front
+CStatus
+NewRetrieveCursor(CSegmentInterface c_segment, CRetrievePlan c_plan, uint64_t timestamp, CRetrieveCursor* cursor);
+
+// fills *result with up to batch_size rows and sets *has_more; when
+// *has_more comes back false, *result is untouched and the export is done.
+// The caller frees each batch with DeleteRetrieveResult; the plan must
+// outlive the cursor.
+CStatus
+RetrieveCursorNext(CRetrieveCursor cursor, int64_t batch_size, CRetrieveResult* result, bool* has_more);
+
+void
+DeleteRetrieveCursor(CRetrieveCursor cursor);
+
+// one field of a views retrieve; a non-null `data` points straight into
+// segment column memory owned by the result: row_count elements of
+// element_size bytes each. A null `data` means the field was copied into
+// the fallback proto instead.
+typedef struct CFieldDataView {
+    int64_t field_id;
+    CDataType data_type;
+    const void* data;
+    int64_t row_count;
+    int64_t element_size;
+} CFieldDataView;
+
+typedef void* CRetrieveViewsResult;
+
+// retrieve variant that lends fixed-width sealed columns instead of
+// copying them: when the matching rows form one contiguous run, each
+// eligible field comes back as a CFieldDataView into column memory,
+// skipping the DataArray copy, the proto serialize and the CGO blob copy
+// at once. accept_views is the caller's capability flag; when false — or
+// when the segment or offset pattern cannot lend — the call degenerates
+// to Retrieve semantics with everything in the fallback proto. Borrowed
+// pointers stay valid until DeleteRetrieveViewsResult
+CStatus
+RetrieveWithViews(CSegmentInterface c_segment,
+                  CRetrievePlan c_plan,
+                  uint64_t timestamp,
+                  bool accept_views,
+                  CRetrieveViewsResult* result);
+
+// per-field descriptors in plan order; points *views at an array owned by
+// the result and returns its length, zero when the whole call fell back
+int64_t
+GetRetrieveViews(CRetrieveViewsResult result, const CFieldDataView** views);
+
+// serialized RetrieveResults carrying the offsets, the pk ids and every
+// non-borrowed column; the blob is owned by the result — do not free it
+CProto
+GetRetrieveViewsFallback(CRetrieveViewsResult result);
+
+// releases the result and the segment read pin backing its views
+void
+DeleteRetrieveViewsResult(CRetrieveViewsResult result);
+
 int64_t
 GetMemoryUsageInBytes(CSegmentInterface c_segment);
 
+int64_t
+GetFieldMemoryUsageInBytes(CSegmentInterface c_segment, int64_t field_id);
+
 int64_t
 GetRowCount(CSegmentInterface c_segment);
 
@@ -62,6 +232,12 @@ GetDeletedCount(CSegmentInterface c_segment);
 int64_t
 GetRealCount(CSegmentInterface c_segment);
 
+// binds future column allocations and searching threads of this segment to
+// the given NUMA node (-1 resets to OS placement); call right after
+// NewSegment, before any insert or load
+CStatus
+SetSegmentNumaNode(CSegmentInterface c_segment, int64_t numa_node);
+
 //////////////////////////////    interfaces for growing segment    //////////////////////////////
 CStatus
 Insert(CSegmentInterface c_segment,
@@ -75,13 +251,46 @@ Insert(CSegmentInterface c_segment,
 CStatus
 PreInsert(CSegmentInterface c_segment, int64_t size, int64_t* offset);
 
+// Arrow ingestion across the C data interface: the record batch behind
+// (c_array, c_schema) is adopted zero-copy — ownership moves to segcore
+// and the arrow release callbacks fire once the insert is done. Columns
+// are matched to schema fields by their "field_id" metadata (the arrow
+// export convention) and bulk-copied straight into the segment's chunks,
+// with no proto encode on the caller side or decode here.
+CStatus
+InsertArrow(CSegmentInterface c_segment,
+            int64_t reserved_offset,
+            int64_t size,
+            const int64_t* row_ids,
+            const uint64_t* timestamps,
+            struct ArrowArray* c_array,
+            struct ArrowSchema* c_schema);
+
 //////////////////////////////    interfaces for sealed segment    //////////////////////////////
 CStatus
 LoadFieldData(CSegmentInterface c_segment, CLoadFieldDataInfo load_field_data_info);
 
+// ownership-transfer variant of LoadFieldData: the serialized blob belongs
+// to the segment from this call on, and release_cb(release_ctx) fires as
+// soon as the payload has been decoded (on failure too), instead of the
+// caller holding the blob until the whole load returns. Keeps the blob and
+// the installed column from coexisting, which is where load peaks today.
+CStatus
+LoadFieldDataOwned(CSegmentInterface c_segment,
+                   CLoadFieldDataInfo load_field_data_info,
+                   void (*release_cb)(void*),
+                   void* release_ctx);
+
 CStatus
 LoadDeletedRecord(CSegmentInterface c_segment, CLoadDeletedRecordInfo deleted_record_info);
 
+// seals a co-resident growing segment in place: the sealed segment adopts
+// the growing segment's columns, timestamps and delete log directly instead
+// of round-tripping through flush + binlog load. The growing segment must be
+// quiesced (no in-flight inserts or deletes) and stays valid afterwards.
+CStatus
+LoadFromGrowingSegment(CSegmentInterface c_segment, CSegmentInterface c_growing_segment);
+
 CStatus
 UpdateSealedSegmentIndex(CSegmentInterface c_segment, CLoadIndexInfo c_load_index_info);
 
@@ -91,6 +300,13 @@ DropFieldData(CSegmentInterface c_segment, int64_t field_id);
 CStatus
 DropSealedSegmentIndex(CSegmentInterface c_segment, int64_t field_id);
 
+// memory-pressure hook: drops raw scalar columns whose loaded index can
+// serve both search and reconstruction until the segment's resident bytes
+// fit target_bytes; columns without a covering index are never touched.
+// Reports the bytes actually released through released_bytes.
+CStatus
+EvictCoveredFieldData(CSegmentInterface c_segment, int64_t target_bytes, int64_t* released_bytes);
+
 //////////////////////////////    interfaces for SegmentInterface    //////////////////////////////
 CStatus
 Delete(CSegmentInterface c_segment,
@@ -0,0 +1,144 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/ArrowMemoryPool.h"
+
+#include <atomic>
+#include <string>
+
+namespace milvus::storage {
+
+namespace {
+
+// shared across all scopes so one knob bounds total arrow usage
+std::atomic<int64_t> total_bytes{0};
+std::atomic<int64_t> limit_bytes{0};
+
+class AccountedMemoryPool : public arrow::MemoryPool {
+ public:
+    AccountedMemoryPool() : backend_(arrow::default_memory_pool()) {
+    }
+
+    arrow::Status
+    Allocate(int64_t size, uint8_t** out) override {
+        if (WouldExceedLimit(size)) {
+            return arrow::Status::OutOfMemory("arrow pool limit of ", limit_bytes.load(), " bytes exceeded");
+        }
+        auto status = backend_->Allocate(size, out);
+        if (status.ok()) {
+            Account(size);
+        }
+        return status;
+    }
+
+    arrow::Status
+    Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) override {
+        if (WouldExceedLimit(new_size - old_size)) {
+            return arrow::Status::OutOfMemory("arrow pool limit of ", limit_bytes.load(), " bytes exceeded");
+        }
+        auto status = backend_->Reallocate(old_size, new_size, ptr);
+        if (status.ok()) {
+            Account(new_size - old_size);
+        }
+        return status;
+    }
+
+    void
+    Free(uint8_t* buffer, int64_t size) override {
+        backend_->Free(buffer, size);
+        Account(-size);
+    }
+
+    void
+    ReleaseUnused() override {
+        backend_->ReleaseUnused();
+    }
+
+    int64_t
+    bytes_allocated() const override {
+        return bytes_.load();
+    }
+
+    int64_t
+    max_memory() const override {
+        return peak_bytes_.load();
+    }
+
+    std::string
+    backend_name() const override {
+        return backend_->backend_name();
+    }
+
+ private:
+    static bool
+    WouldExceedLimit(int64_t delta) {
+        auto limit = limit_bytes.load(std::memory_order_relaxed);
+        return limit > 0 && delta > 0 && total_bytes.load(std::memory_order_relaxed) + delta > limit;
+    }
+
+    void
+    Account(int64_t delta) {
+        total_bytes.fetch_add(delta, std::memory_order_relaxed);
+        auto current = bytes_.fetch_add(delta, std::memory_order_relaxed) + delta;
+        auto peak = peak_bytes_.load(std::memory_order_relaxed);
+        while (current > peak && !peak_bytes_.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+        }
+    }
+
+    arrow::MemoryPool* backend_;
+    std::atomic<int64_t> bytes_{0};
+    std::atomic<int64_t> peak_bytes_{0};
+};
+
+AccountedMemoryPool&
+PoolFor(ArrowPoolScope scope) {
+    // never destroyed: arrow buffers may outlive static teardown order
+    static auto* read_pool = new AccountedMemoryPool();
+    static auto* write_pool = new AccountedMemoryPool();
+    static auto* export_pool = new AccountedMemoryPool();
+    switch (scope) {
+        case ArrowPoolScope::PayloadRead:
+            return *read_pool;
+        case ArrowPoolScope::PayloadWrite:
+            return *write_pool;
+        default:
+            return *export_pool;
+    }
+}
+
+}  // namespace
+
+arrow::MemoryPool*
+GetArrowPool(ArrowPoolScope scope) {
+    return &PoolFor(scope);
+}
+
+int64_t
+GetArrowPoolBytes(ArrowPoolScope scope) {
+    return PoolFor(scope).bytes_allocated();
+}
+
+int64_t
+GetArrowPoolPeakBytes(ArrowPoolScope scope) {
+    return PoolFor(scope).max_memory();
+}
+
+void
+SetArrowPoolLimit(int64_t limit) {
+    limit_bytes.store(limit < 0 ? 0 : limit);
+}
+
+}  // namespace milvus::storage
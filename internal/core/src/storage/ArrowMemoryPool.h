@@ -0,0 +1,57 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+
+#include <arrow/memory_pool.h>
+
+namespace milvus::storage {
+
+// Which side of the storage layer an arrow allocation belongs to. The
+// storage code never touches arrow::default_memory_pool() directly; it goes
+// through one of these scoped pools so that parquet decode memory (segment
+// loading) and builder/encode memory (binlog production) show up as separate
+// numbers instead of disappearing into the global pool.
+enum class ArrowPoolScope : int {
+    PayloadRead = 0,      // parquet decode while loading binlogs and index files
+    PayloadWrite = 1,     // arrow builders and encode buffers while writing them
+    RetrieveExport = 2,   // retrieve results exported over the Arrow C data
+                          // interface; freed by the consumer's release call
+};
+
+// accounted pool for the given scope; delegates the actual allocation to
+// arrow's default allocator
+arrow::MemoryPool*
+GetArrowPool(ArrowPoolScope scope);
+
+// bytes currently live in the given scope
+int64_t
+GetArrowPoolBytes(ArrowPoolScope scope);
+
+// high-water mark of the given scope since process start
+int64_t
+GetArrowPoolPeakBytes(ArrowPoolScope scope);
+
+// combined ceiling across all scopes, 0 disables the check. An allocation
+// that would cross the limit fails with an arrow OutOfMemory status, which
+// the payload code turns into an exception and the C wrappers into a CStatus
+// like any other storage failure.
+void
+SetArrowPoolLimit(int64_t limit_bytes);
+
+}  // namespace milvus::storage
@@ -0,0 +1,299 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <boost/filesystem.hpp>
+
+#include "CachingChunkManager.h"
+#include "storage/ObjectMetaCache.h"
+
+namespace milvus::storage {
+
+std::string
+CachingChunkManager::cache_file_path(const std::string& filepath) const {
+    return cache_path_prefix_ + "/" + filepath;
+}
+
+int64_t
+CachingChunkManager::parse_collection_id(const std::string& filepath) {
+    size_t pos = 0;
+    while (pos < filepath.size()) {
+        auto end = filepath.find('/', pos);
+        if (end == std::string::npos) {
+            end = filepath.size();
+        }
+        if (end > pos && filepath.find_first_not_of("0123456789", pos) >= end) {
+            return std::stoll(filepath.substr(pos, end - pos));
+        }
+        pos = end + 1;
+    }
+    return -1;
+}
+
+bool
+CachingChunkManager::touch(const std::string& filepath) {
+    std::lock_guard lck(mutex_);
+    auto iter = entries_.find(filepath);
+    if (iter == entries_.end()) {
+        return false;
+    }
+    lru_.splice(lru_.begin(), lru_, iter->second.lru_iter);
+    return true;
+}
+
+std::vector<std::string>
+CachingChunkManager::make_room(uint64_t incoming, int64_t collection_id) {
+    std::vector<std::string> victims;
+    // takes the key by value: the argument often aliases the list node the
+    // body erases
+    auto evict = [&](std::string key) {
+        auto& entry = entries_.at(key);
+        cached_bytes_ -= entry.size;
+        collection_bytes_[entry.collection_id] -= entry.size;
+        lru_.erase(entry.lru_iter);
+        entries_.erase(key);
+        victims.push_back(key);
+    };
+    while (cached_bytes_ + incoming > capacity_ && !lru_.empty()) {
+        evict(lru_.back());
+    }
+    auto quota_iter = collection_quotas_.find(collection_id);
+    if (quota_iter != collection_quotas_.end()) {
+        // evict this collection's coldest objects first; other collections
+        // keep their cache when one collection runs hot. Keys are copied
+        // because evict() mutates lru_ under our feet.
+        std::vector<std::string> candidates;
+        for (auto iter = lru_.rbegin(); iter != lru_.rend(); ++iter) {
+            if (entries_.at(*iter).collection_id == collection_id) {
+                candidates.push_back(*iter);
+            }
+        }
+        for (auto& key : candidates) {
+            if (collection_bytes_[collection_id] + incoming <= quota_iter->second) {
+                break;
+            }
+            evict(key);
+        }
+    }
+    return victims;
+}
+
+void
+CachingChunkManager::erase_entry(const std::string& filepath) {
+    std::string victim;
+    {
+        std::lock_guard lck(mutex_);
+        auto iter = entries_.find(filepath);
+        if (iter == entries_.end()) {
+            return;
+        }
+        cached_bytes_ -= iter->second.size;
+        collection_bytes_[iter->second.collection_id] -= iter->second.size;
+        lru_.erase(iter->second.lru_iter);
+        entries_.erase(iter);
+        victim = filepath;
+    }
+    LocalChunkManager::GetInstance().Remove(cache_file_path(victim));
+}
+
+void
+CachingChunkManager::populate(const std::string& filepath, void* buf, uint64_t size) {
+    if (size > capacity_) {
+        return;
+    }
+    auto collection_id = parse_collection_id(filepath);
+    std::vector<std::string> victims;
+    {
+        std::lock_guard lck(mutex_);
+        if (entries_.count(filepath) > 0) {
+            return;
+        }
+        auto quota_iter = collection_quotas_.find(collection_id);
+        if (quota_iter != collection_quotas_.end() && size > quota_iter->second) {
+            return;
+        }
+        victims = make_room(size, collection_id);
+    }
+    auto& local = LocalChunkManager::GetInstance();
+    for (auto& victim : victims) {
+        local.Remove(cache_file_path(victim));
+    }
+
+    auto cache_path = cache_file_path(filepath);
+    boost::filesystem::create_directories(boost::filesystem::path(cache_path).parent_path());
+    local.Write(cache_path, buf, size);
+    {
+        std::lock_guard lck(mutex_);
+        if (entries_.count(filepath) > 0) {
+            return;
+        }
+        lru_.push_front(filepath);
+        entries_[filepath] = CacheEntry{lru_.begin(), size, collection_id};
+        cached_bytes_ += size;
+        collection_bytes_[collection_id] += size;
+    }
+    // a whole-object download pins down existence and size, so metadata
+    // queries for this object stop at the shared cache even after the disk
+    // copy is evicted
+    ObjectMetaCache::GetInstance().PutPositive(filepath, size);
+}
+
+bool
+CachingChunkManager::Exist(const std::string& filepath) {
+    {
+        std::lock_guard lck(mutex_);
+        if (entries_.count(filepath) > 0) {
+            return true;
+        }
+    }
+    return MinioChunkManager::GetInstance().Exist(filepath);
+}
+
+uint64_t
+CachingChunkManager::Size(const std::string& filepath) {
+    {
+        std::lock_guard lck(mutex_);
+        auto iter = entries_.find(filepath);
+        if (iter != entries_.end()) {
+            return iter->second.size;
+        }
+    }
+    return MinioChunkManager::GetInstance().Size(filepath);
+}
+
+uint64_t
+CachingChunkManager::Read(const std::string& filepath, void* buf, uint64_t len) {
+    if (touch(filepath)) {
+        try {
+            return LocalChunkManager::GetInstance().Read(cache_file_path(filepath), buf, len);
+        } catch (std::exception& e) {
+            // evicted between the lookup and the read; fetch remotely below
+        }
+    }
+    auto size = MinioChunkManager::GetInstance().Read(filepath, buf, len);
+    populate(filepath, buf, size);
+    return size;
+}
+
+uint64_t
+CachingChunkManager::Read(const std::string& filepath, uint64_t offset, void* buf, uint64_t len) {
+    if (touch(filepath)) {
+        try {
+            return LocalChunkManager::GetInstance().Read(cache_file_path(filepath), offset, buf, len);
+        } catch (std::exception& e) {
+            // evicted between the lookup and the read; fetch remotely below
+        }
+    }
+    // partial fetches do not populate: caching a range under the whole-object
+    // key would serve truncated reads later
+    return MinioChunkManager::GetInstance().Read(filepath, offset, buf, len);
+}
+
+void
+CachingChunkManager::Write(const std::string& filepath, void* buf, uint64_t len) {
+    MinioChunkManager::GetInstance().Write(filepath, buf, len);
+    populate(filepath, buf, len);
+}
+
+void
+CachingChunkManager::Write(const std::string& filepath, uint64_t offset, void* buf, uint64_t len) {
+    // a ranged write would leave the cached copy stale
+    erase_entry(filepath);
+    MinioChunkManager::GetInstance().Write(filepath, offset, buf, len);
+}
+
+std::vector<std::string>
+CachingChunkManager::ListWithPrefix(const std::string& filepath) {
+    return MinioChunkManager::GetInstance().ListWithPrefix(filepath);
+}
+
+void
+CachingChunkManager::Remove(const std::string& filepath) {
+    erase_entry(filepath);
+    MinioChunkManager::GetInstance().Remove(filepath);
+}
+
+void
+CachingChunkManager::SetCollectionQuota(int64_t collection_id, uint64_t bytes) {
+    std::vector<std::string> victims;
+    {
+        std::lock_guard lck(mutex_);
+        if (bytes == 0) {
+            collection_quotas_.erase(collection_id);
+            return;
+        }
+        collection_quotas_[collection_id] = bytes;
+        victims = make_room(0, collection_id);
+    }
+    auto& local = LocalChunkManager::GetInstance();
+    for (auto& victim : victims) {
+        local.Remove(cache_file_path(victim));
+    }
+}
+
+uint64_t
+CachingChunkManager::GetCachedBytes() const {
+    std::lock_guard lck(mutex_);
+    return cached_bytes_;
+}
+
+void
+CachingChunkManager::Prefetch(const std::vector<std::string>& filepaths,
+                              TaskPriority priority,
+                              std::chrono::steady_clock::time_point deadline) {
+    auto& pool = ThreadPool::GetInstance(ThreadPoolRole::Load);
+    for (auto& filepath : filepaths) {
+        {
+            std::lock_guard lck(mutex_);
+            if (entries_.count(filepath) > 0 || prefetching_.count(filepath) > 0) {
+                continue;
+            }
+            prefetching_.insert(filepath);
+        }
+        TaskOptions options;
+        options.priority = priority;
+        options.deadline = deadline;
+        pool.Submit(options, [this, filepath, deadline] {
+            // past the deadline the segment load has started and its demand
+            // reads will fetch anyway; downloading now only steals their
+            // bandwidth
+            auto expired = deadline != std::chrono::steady_clock::time_point{} &&
+                           std::chrono::steady_clock::now() >= deadline;
+            if (!expired && !touch(filepath)) {
+                try {
+                    auto& remote = MinioChunkManager::GetInstance();
+                    auto size = remote.Size(filepath);
+                    if (size > 0 && size <= capacity_) {
+                        auto buffer = std::make_unique<uint8_t[]>(size);
+                        auto read_size = remote.Read(filepath, buffer.get(), size);
+                        populate(filepath, buffer.get(), read_size);
+                    }
+                } catch (std::exception& e) {
+                    // best effort: the demand read retries and reports
+                }
+            }
+            std::lock_guard lck(mutex_);
+            prefetching_.erase(filepath);
+        });
+    }
+}
+
+int64_t
+CachingChunkManager::GetPrefetchInflight() const {
+    std::lock_guard lck(mutex_);
+    return static_cast<int64_t>(prefetching_.size());
+}
+
+}  // namespace milvus::storage
@@ -0,0 +1,166 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/ThreadPool.h"
+#include "storage/LocalChunkManager.h"
+#include "storage/MinioChunkManager.h"
+#include "config/ConfigChunkManager.h"
+
+namespace milvus::storage {
+
+/**
+ * @brief CachingChunkManager keeps a size-bounded LRU copy of immutable
+ * remote objects on local disk, keyed by object path, so rebalanced or
+ * reloaded segments read from NVMe instead of re-downloading through
+ * MinioChunkManager.
+ */
+class CachingChunkManager : public RemoteChunkManager {
+ private:
+    CachingChunkManager(const std::string& cache_path_prefix, uint64_t capacity)
+        : cache_path_prefix_(cache_path_prefix), capacity_(capacity) {
+    }
+
+    CachingChunkManager(const CachingChunkManager&);
+    CachingChunkManager&
+    operator=(const CachingChunkManager&);
+
+ public:
+    virtual ~CachingChunkManager() {
+    }
+
+    static CachingChunkManager&
+    GetInstance() {
+        // thread-safe enough after c++ 11
+        static CachingChunkManager instance(ChunkMangerConfig::GetCachePathPrefix(),
+                                            ChunkMangerConfig::GetCacheCapacity());
+        return instance;
+    }
+
+    virtual bool
+    Exist(const std::string& filepath);
+
+    virtual uint64_t
+    Size(const std::string& filepath);
+
+    virtual uint64_t
+    Read(const std::string& filepath, void* buf, uint64_t len);
+
+    virtual void
+    Write(const std::string& filepath, void* buf, uint64_t len);
+
+    virtual uint64_t
+    Read(const std::string& filepath, uint64_t offset, void* buf, uint64_t len);
+
+    virtual void
+    Write(const std::string& filepath, uint64_t offset, void* buf, uint64_t len);
+
+    virtual std::vector<std::string>
+    ListWithPrefix(const std::string& filepath);
+
+    virtual void
+    Remove(const std::string& filepath);
+
+    virtual std::string
+    GetName() const {
+        return "CachingChunkManager";
+    }
+
+    // byte ceiling for one collection's cached objects; 0 removes the quota
+    void
+    SetCollectionQuota(int64_t collection_id, uint64_t bytes);
+
+    uint64_t
+    GetCachedBytes() const;
+
+    // Warms the cache for objects the coordinator has announced but not yet
+    // read, so the eventual LoadFieldData hits local disk. Each path becomes
+    // one Load-pool task carrying `priority` and `deadline`, and the
+    // multipart part-fetches it fans out inherit the same class — at Batch
+    // the transfer pool's weighted dispatch hands demand reads eight slots
+    // for every prefetch slot, so warming only rides spare bandwidth.
+    // Best effort throughout: cached or already-queued paths are skipped, a
+    // task that starts past its deadline does nothing, and a failed fetch
+    // is simply left for the demand read to retry and report.
+    void
+    Prefetch(const std::vector<std::string>& filepaths,
+             TaskPriority priority = TaskPriority::Batch,
+             std::chrono::steady_clock::time_point deadline = {});
+
+    // prefetches queued or running; the Go side polls this to pace
+    // announcements
+    int64_t
+    GetPrefetchInflight() const;
+
+ private:
+    struct CacheEntry {
+        std::list<std::string>::iterator lru_iter;
+        uint64_t size;
+        int64_t collection_id;
+    };
+
+    std::string
+    cache_file_path(const std::string& filepath) const;
+
+    // object paths embed the collection id as the first numeric segment;
+    // returns -1 when the path has none (quotas then do not apply)
+    static int64_t
+    parse_collection_id(const std::string& filepath);
+
+    // returns true and refreshes recency when filepath is cached
+    bool
+    touch(const std::string& filepath);
+
+    void
+    populate(const std::string& filepath, void* buf, uint64_t size);
+
+    // evicts under mutex_ until both the global bound and the collection's
+    // quota fit `incoming` more bytes; returns the victims' object paths so
+    // their files can be removed outside the lock
+    std::vector<std::string>
+    make_room(uint64_t incoming, int64_t collection_id);
+
+    void
+    erase_entry(const std::string& filepath);
+
+ private:
+    std::string cache_path_prefix_;
+    uint64_t capacity_;
+
+    mutable std::mutex mutex_;
+    // most recently used at the front
+    std::list<std::string> lru_;
+    std::unordered_map<std::string, CacheEntry> entries_;
+    std::unordered_map<int64_t, uint64_t> collection_bytes_;
+    std::unordered_map<int64_t, uint64_t> collection_quotas_;
+    uint64_t cached_bytes_ = 0;
+    // paths with a prefetch task queued or running; reserving here keeps a
+    // repeated announcement from downloading the same object twice
+    std::unordered_set<std::string> prefetching_;
+};
+
+using CachingChunkManagerSPtr = std::shared_ptr<CachingChunkManager>;
+
+}  // namespace milvus::storage
@@ -16,11 +16,15 @@
 
 #pragma once
 
+#include <future>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "common/ThreadPool.h"
+#include "storage/Types.h"
+
 namespace milvus::storage {
 
 /**
@@ -65,6 +69,19 @@ class ChunkManager {
     virtual void
     Write(const std::string& filepath, void* buf, uint64_t len) = 0;
 
+    /**
+     * @brief Write an iovec-style serialized form. The default assembles
+     * the slices once for backends that need contiguous bytes; local
+     * backends override it and stream the slices without assembly
+     * @param filepath
+     * @param sliced
+     */
+    virtual void
+    Write(const std::string& filepath, const SlicedData& sliced) {
+        auto bytes = sliced.flatten();
+        Write(filepath, bytes.data(), bytes.size());
+    }
+
     /**
      * @brief Read file to buffer with offset
      * @param filepath
@@ -84,6 +101,39 @@ class ChunkManager {
     virtual void
     Write(const std::string& filepath, uint64_t offset, void* buf, uint64_t len) = 0;
 
+    /**
+     * @brief Read a range without blocking the caller, resolving to the
+     * bytes read. The default runs the synchronous Read on the shared pool;
+     * backends override it with native async I/O
+     * @param filepath
+     * @param offset
+     * @param buf
+     * @param len
+     * @return std::future<uint64_t>
+     */
+    virtual std::future<uint64_t>
+    ReadAsync(const std::string& filepath, uint64_t offset, void* buf, uint64_t len) {
+        return ThreadPool::GetInstance(ThreadPoolRole::Load).Submit(
+            [this, filepath, offset, buf, len] { return Read(filepath, offset, buf, len); });
+    }
+
+    /**
+     * @brief Write a range without blocking the caller, resolving to the
+     * bytes written
+     * @param filepath
+     * @param offset
+     * @param buf
+     * @param len
+     * @return std::future<uint64_t>
+     */
+    virtual std::future<uint64_t>
+    WriteAsync(const std::string& filepath, uint64_t offset, void* buf, uint64_t len) {
+        return ThreadPool::GetInstance(ThreadPoolRole::Load).Submit([this, filepath, offset, buf, len] {
+            Write(filepath, offset, buf, len);
+            return len;
+        });
+    }
+
     /**
      * @brief List files with same prefix
      * @param filepath
@@ -32,6 +32,22 @@ DeserializeRemoteFileData(PayloadInputStream* input_stream) {
     auto descriptor_fix_part = descriptor_event.event_data.fix_part;
     FieldDataMeta data_meta{descriptor_fix_part.collection_id, descriptor_fix_part.partition_id,
                             descriptor_fix_part.segment_id, descriptor_fix_part.field_id};
+
+    // the checksum in the descriptor extras covers every byte after the
+    // descriptor event; validating here catches corruption up front without
+    // decoding the parquet payload. Binlogs written before the key existed
+    // simply skip the check.
+    auto& des_extras = descriptor_event.event_data.extras;
+    if (auto crc_it = des_extras.find(PAYLOAD_CRC32C_KEY); crc_it != des_extras.end()) {
+        auto pos = input_stream->Tell().ValueOrDie();
+        auto total = input_stream->GetSize().ValueOrDie();
+        auto rest = input_stream->Read(total - pos).ValueOrDie();
+        auto crc = Crc32c(0, rest->data(), rest->size());
+        AssertInfo(std::to_string(crc) == crc_it->second, "binlog payload checksum mismatch");
+        auto ast = input_stream->Seek(pos);
+        AssertInfo(ast.ok(), "seek input stream failed");
+    }
+
     EventHeader header(input_stream);
     switch (header.event_type_) {
         case EventType::InsertEvent: {
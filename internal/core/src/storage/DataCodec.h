@@ -37,6 +37,12 @@ class DataCodec {
     virtual std::vector<uint8_t>
     Serialize(StorageType medium) = 0;
 
+    // iovec-style serialization: payload bytes stay in the parquet buffer
+    // and are handed to ChunkManager::Write as views instead of being
+    // assembled into one contiguous vector
+    virtual SlicedData
+    SerializeToSliced(StorageType medium) = 0;
+
     virtual void
     SetFieldDataMeta(const FieldDataMeta& meta) = 0;
 
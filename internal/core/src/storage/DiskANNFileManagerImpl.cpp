@@ -14,11 +14,17 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <boost/filesystem.hpp>
+#include <deque>
 #include <mutex>
 
 #include "common/Consts.h"
+#include "common/ThreadPool.h"
 #include "storage/DiskANNFileManagerImpl.h"
 #include "storage/LocalChunkManager.h"
 #include "storage/MinioChunkManager.h"
@@ -63,6 +69,12 @@ DiskANNFileManagerImpl::DiskANNFileManagerImpl(const FieldDataMeta& field_mata,
 }
 
 DiskANNFileManagerImpl::~DiskANNFileManagerImpl() {
+    for (auto& [file, regions] : pinned_regions_) {
+        for (auto& region : regions) {
+            munlock(region.addr, region.length);
+            munmap(region.addr, region.length);
+        }
+    }
     auto& local_chunk_manager = LocalChunkManager::GetInstance();
     local_chunk_manager.RemoveDir(GetLocalIndexPathPrefixWithBuildID(index_meta_.build_id));
 }
@@ -90,27 +102,44 @@ DiskANNFileManagerImpl::AddFile(const std::string& file) noexcept {
     auto buf = std::unique_ptr<uint8_t[]>(new uint8_t[fileSize]);
     local_chunk_manager.Read(file, buf.get(), fileSize);
 
-    // Split local data to multi part with specified size
-    int slice_num = 0;
+    transferred_bytes_ = 0;
+    total_bytes_ = int64_t(fileSize);
+
+    // Split local data to multi part with specified size, serializing and
+    // uploading the slices concurrently; every slice touches only its own
+    // range of buf and its own object key
     auto remotePrefix = GetRemoteIndexObjectPrefix();
-    for (int offset = 0; offset < fileSize; slice_num++) {
+    std::vector<std::future<void>> futures;
+    int slice_num = 0;
+    for (int64_t offset = 0; offset < int64_t(fileSize); slice_num++) {
         auto batch_size = std::min(milvus::config::KnowhereGetIndexSliceSize() << 20, int64_t(fileSize) - offset);
+        futures.emplace_back(ThreadPool::GetInstance(ThreadPoolRole::Load).Submit([&, offset, batch_size, slice_num] {
+            auto fieldData = std::make_shared<FieldData>(buf.get() + offset, batch_size);
+            auto indexData = std::make_shared<IndexData>(fieldData);
+            indexData->set_index_meta(index_meta_);
+            indexData->SetFieldDataMeta(field_meta_);
+            auto serialized_index_data = indexData->serialize_to_remote_file();
+            auto serialized_index_size = serialized_index_data.size();
 
-        auto fieldData = std::make_shared<FieldData>(buf.get() + offset, batch_size);
-        auto indexData = std::make_shared<IndexData>(fieldData);
-        indexData->set_index_meta(index_meta_);
-        indexData->SetFieldDataMeta(field_meta_);
-        auto serialized_index_data = indexData->serialize_to_remote_file();
-        auto serialized_index_size = serialized_index_data.size();
-
-        // Put file to remote
-        char objectKey[200];
-        snprintf(objectKey, sizeof(objectKey), "%s/%s_%d", remotePrefix.c_str(), fileName.c_str(), slice_num);
-        remote_chunk_manager.Write(objectKey, serialized_index_data.data(), serialized_index_size);
+            // Put file to remote
+            char objectKey[200];
+            snprintf(objectKey, sizeof(objectKey), "%s/%s_%d", remotePrefix.c_str(), fileName.c_str(), slice_num);
+            remote_chunk_manager.Write(objectKey, serialized_index_data.data(), serialized_index_size);
 
+            transferred_bytes_ += batch_size;
+            // record remote file to save etcd
+            WriteLock lock(mutex_);
+            remote_paths_to_size_[objectKey] = serialized_index_size;
+        }));
         offset += batch_size;
-        // record remote file to save etcd
-        remote_paths_to_size_[objectKey] = serialized_index_size;
+    }
+    // wait before get so every upload has finished with buf by the time an
+    // exception can unwind past it
+    for (auto& future : futures) {
+        future.wait();
+    }
+    for (auto& future : futures) {
+        future.get();
     }
     FILEMANAGER_CATCH
     FILEMANAGER_END
@@ -133,29 +162,187 @@ DiskANNFileManagerImpl::CacheIndexToDisk(std::vector<std::string> remote_files)
         std::sort(slices.second.begin(), slices.second.end());
     }
 
+    transferred_bytes_ = 0;
+    total_bytes_ = 0;
+
     for (auto& slices : index_slices) {
         auto prefix = slices.first;
         auto local_index_file_name = GetLocalIndexObjectPrefix() + prefix.substr(prefix.find_last_of("/") + 1);
-        local_chunk_manager.CreateFile(local_index_file_name);
-        int64_t offset = 0;
-        for (auto iter = slices.second.begin(); iter != slices.second.end(); iter++) {
-            auto origin_file = prefix + "_" + std::to_string(*iter);
-            auto fileSize = remote_chunk_manager.Size(origin_file);
-            auto buf = std::unique_ptr<uint8_t[]>(new uint8_t[fileSize]);
-            remote_chunk_manager.Read(origin_file, buf.get(), fileSize);
-
-            auto decoded_index_data = DeserializeFileData(buf.get(), fileSize);
-            auto index_payload = decoded_index_data->GetPayload();
-            auto index_size = index_payload->rows * sizeof(uint8_t);
-
-            local_chunk_manager.Write(local_index_file_name, offset, const_cast<uint8_t*>(index_payload->raw_data),
-                                      index_size);
-            offset += index_size;
+        // staged writer: preallocated extents plus (when enabled) O_DIRECT
+        // appends keep a multi-GB index from churning the page cache
+        auto staged_file = local_chunk_manager.OpenStagedFile(local_index_file_name);
+
+        // bounded pipeline: remote fetch and decode run on the load pool
+        // while this thread appends finished slices in order. At most
+        // pipeline_depth slices are in flight, so the network and the CPU
+        // stay busy ahead of the local writes without ever staging the
+        // whole file in memory
+        auto& pool = ThreadPool::GetInstance(ThreadPoolRole::Load);
+        size_t pipeline_depth = pool.num_threads() * 2;
+        std::deque<std::future<std::unique_ptr<DataCodec>>> in_flight;
+        auto submit_slice = [&](int slice_id) {
+            auto origin_file = prefix + "_" + std::to_string(slice_id);
+            in_flight.emplace_back(pool.Submit([this, &remote_chunk_manager, origin_file] {
+                auto fileSize = remote_chunk_manager.Size(origin_file);
+                total_bytes_ += int64_t(fileSize);
+                auto buf = std::unique_ptr<uint8_t[]>(new uint8_t[fileSize]);
+                remote_chunk_manager.Read(origin_file, buf.get(), fileSize);
+                transferred_bytes_ += int64_t(fileSize);
+                return DeserializeFileData(buf.get(), fileSize);
+            }));
+        };
+
+        size_t next_slice = 0;
+        try {
+            while (next_slice < slices.second.size() || !in_flight.empty()) {
+                while (next_slice < slices.second.size() && in_flight.size() < pipeline_depth) {
+                    submit_slice(slices.second[next_slice++]);
+                }
+                auto decoded_index_data = in_flight.front().get();
+                in_flight.pop_front();
+                auto index_payload = decoded_index_data->GetPayload();
+                auto index_size = index_payload->rows * sizeof(uint8_t);
+
+                staged_file->Append(index_payload->raw_data, index_size);
+            }
+            staged_file->Finish();
+        } catch (...) {
+            // let the in-flight downloads drain before unwinding
+            for (auto& future : in_flight) {
+                if (future.valid()) {
+                    future.wait();
+                }
+            }
+            throw;
         }
         local_paths_.emplace_back(local_index_file_name);
     }
 }
 
+namespace {
+
+#ifdef __APPLE__
+using MincoreFlag = char;
+#else
+using MincoreFlag = unsigned char;
+#endif
+
+// mmap and mincore both want page-aligned windows; widens [offset, length)
+// leftwards to the page boundary and clamps it to the file end
+bool
+AlignRegion(int64_t file_size, int64_t page_size, int64_t& offset, int64_t& length) {
+    if (offset < 0 || offset >= file_size || length <= 0) {
+        return false;
+    }
+    length = std::min(length, file_size - offset);
+    auto aligned_offset = offset - offset % page_size;
+    length += offset - aligned_offset;
+    offset = aligned_offset;
+    return true;
+}
+
+}  // namespace
+
+bool
+DiskANNFileManagerImpl::WarmupFile(const std::string& localfile, const std::vector<WarmupRegion>& regions) noexcept {
+    auto& local_chunk_manager = LocalChunkManager::GetInstance();
+    int64_t file_size = 0;
+    FILEMANAGER_TRY
+    file_size = local_chunk_manager.Size(localfile);
+    FILEMANAGER_CATCH
+    FILEMANAGER_END
+
+    auto fd = open(localfile.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_SEGCORE_ERROR_C << "open for warmup failed: " << localfile;
+        return false;
+    }
+    auto page_size = static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+    bool all_warmed = true;
+    for (auto region : regions) {
+        auto offset = region.offset;
+        auto length = region.length;
+        if (!AlignRegion(file_size, page_size, offset, length)) {
+            continue;
+        }
+        if (!region.pin) {
+            // readahead without a mapping: the kernel pulls the pages in
+            // the background and keeps them as ordinary cache
+            if (posix_fadvise(fd, offset, length, POSIX_FADV_WILLNEED) != 0) {
+                all_warmed = false;
+            }
+            continue;
+        }
+        auto* addr = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, offset);
+        if (addr == MAP_FAILED) {
+            LOG_SEGCORE_ERROR_C << "mmap for warmup failed: " << localfile << " offset " << offset;
+            all_warmed = false;
+            continue;
+        }
+        if (mlock(addr, length) != 0) {
+            // RLIMIT_MEMLOCK too low: degrade to plain prefetch
+            LOG_SEGCORE_WARNING_C << "mlock failed, falling back to prefetch: " << localfile << " offset " << offset;
+            madvise(addr, length, MADV_WILLNEED);
+            munmap(addr, length);
+            all_warmed = false;
+            continue;
+        }
+        WriteLock lock(mutex_);
+        pinned_regions_[localfile].push_back(PinnedRegion{addr, static_cast<size_t>(length)});
+    }
+    close(fd);
+    return all_warmed;
+}
+
+double
+DiskANNFileManagerImpl::GetResidentRatio(const std::string& localfile, int64_t offset, int64_t length) noexcept {
+    auto fd = open(localfile.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    auto file_size = static_cast<int64_t>(lseek(fd, 0, SEEK_END));
+    auto page_size = static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+    if (!AlignRegion(file_size, page_size, offset, length)) {
+        close(fd);
+        return -1;
+    }
+    auto* addr = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, offset);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        return -1;
+    }
+    auto num_pages = (length + page_size - 1) / page_size;
+    std::vector<MincoreFlag> flags(num_pages);
+    double ratio = -1;
+    if (mincore(addr, length, flags.data()) == 0) {
+        int64_t resident = 0;
+        for (auto flag : flags) {
+            resident += flag & 1;
+        }
+        ratio = static_cast<double>(resident) / num_pages;
+    }
+    munmap(addr, length);
+    return ratio;
+}
+
+void
+DiskANNFileManagerImpl::UnpinFile(const std::string& localfile) noexcept {
+    std::vector<PinnedRegion> regions;
+    {
+        WriteLock lock(mutex_);
+        auto it = pinned_regions_.find(localfile);
+        if (it == pinned_regions_.end()) {
+            return;
+        }
+        regions = std::move(it->second);
+        pinned_regions_.erase(it);
+    }
+    for (auto& region : regions) {
+        munlock(region.addr, region.length);
+        munmap(region.addr, region.length);
+    }
+}
+
 std::string
 DiskANNFileManagerImpl::GetFileName(const std::string& localfile) {
     boost::filesystem::path localPath(localfile);
@@ -181,6 +368,8 @@ DiskANNFileManagerImpl::GetLocalRawDataObjectPrefix() {
 
 bool
 DiskANNFileManagerImpl::RemoveFile(const std::string& file) noexcept {
+    // drop any pinned mappings before the file goes away
+    UnpinFile(file);
     // remove local file
     bool localExist = false;
     auto& local_chunk_manager = LocalChunkManager::GetInstance();
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <shared_mutex>
@@ -62,12 +63,62 @@ class DiskANNFileManagerImpl : public FileManagerImpl {
 
     std::map<std::string, int64_t>
     GetRemotePaths() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
         return remote_paths_to_size_;
     }
 
+    /**
+     * @brief Bytes moved so far by the in-flight AddFile or
+     * CacheIndexToDisk call, for recovery progress reporting.
+     * AddFile knows the total upfront; CacheIndexToDisk grows the
+     * total as slice sizes come back from remote
+     */
+    int64_t
+    GetTransferredBytes() const {
+        return transferred_bytes_.load();
+    }
+
+    int64_t
+    GetTotalBytes() const {
+        return total_bytes_.load();
+    }
+
     void
     CacheIndexToDisk(std::vector<std::string> remote_files);
 
+    /**
+     * @brief One hot byte range of a staged index file (entry points,
+     * first graph levels, PQ codebooks sit at offsets the caller knows
+     * from the index header). Non-pinned regions are prefetched into the
+     * page cache; pinned ones are additionally mlock'd and stay resident
+     * until UnpinFile, RemoveFile or manager teardown
+     */
+    struct WarmupRegion {
+        int64_t offset;
+        int64_t length;
+        bool pin = false;
+    };
+
+    /**
+     * @brief Warms the given regions of a locally staged file so the
+     * first queries after load do not pay cold-read latency. Returns
+     * false when any region could not be warmed (e.g. RLIMIT_MEMLOCK);
+     * such regions degrade to plain prefetch
+     */
+    bool
+    WarmupFile(const std::string& localfile, const std::vector<WarmupRegion>& regions) noexcept;
+
+    /**
+     * @brief Fraction of [offset, offset + length) resident in the page
+     * cache, via mincore, so operators can verify warm state before
+     * admitting traffic; -1 on failure
+     */
+    double
+    GetResidentRatio(const std::string& localfile, int64_t offset, int64_t length) noexcept;
+
+    void
+    UnpinFile(const std::string& localfile) noexcept;
+
     FieldDataMeta
     GetFileDataMeta() const {
         return field_meta_;
@@ -97,8 +148,20 @@ class DiskANNFileManagerImpl : public FileManagerImpl {
     // local file path (abs path)
     std::vector<std::string> local_paths_;
 
-    // remote file path
+    // remote file path, written by concurrent slice uploads
     std::map<std::string, int64_t> remote_paths_to_size_;
+
+    // mlock'd mappings per local file, released on unpin or teardown
+    struct PinnedRegion {
+        void* addr;
+        size_t length;
+    };
+    std::map<std::string, std::vector<PinnedRegion>> pinned_regions_;
+    mutable std::shared_mutex mutex_;
+
+    // transfer progress, updated by the slice pipelines
+    std::atomic<int64_t> transferred_bytes_{0};
+    std::atomic<int64_t> total_bytes_{0};
 };
 
 using DiskANNFileManagerImplPtr = std::shared_ptr<DiskANNFileManagerImpl>;
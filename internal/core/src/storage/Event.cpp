@@ -14,6 +14,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <mutex>
+
 #include "storage/Event.h"
 #include "storage/Util.h"
 #include "storage/PayloadReader.h"
@@ -131,11 +133,56 @@ DescriptorEventDataFixPart::Serialize() {
     return res;
 }
 
+namespace {
+
+// Binlogs written by the same flush carry byte-identical extras except for a
+// handful of distinct sizes, and a load touches millions of them; parsing the
+// json once per distinct byte string and copying the small map on every hit
+// takes the parse and its allocations off the per-binlog open path.
+std::unordered_map<std::string, std::string>
+ParseExtrasCached(const std::vector<uint8_t>& extra_bytes) {
+    static std::mutex mutex;
+    static std::unordered_map<std::string, std::unordered_map<std::string, std::string>> cache;
+    static constexpr size_t kMaxCachedExtras = 4096;
+
+    std::string key(extra_bytes.begin(), extra_bytes.end());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            return it->second;
+        }
+    }
+
+    milvus::json json = milvus::json::parse(key);
+    std::unordered_map<std::string, std::string> extras;
+    for (auto known_key : {ORIGIN_SIZE_KEY, INDEX_BUILD_ID_KEY, PAYLOAD_CRC32C_KEY}) {
+        if (json.contains(known_key)) {
+            extras[known_key] = json[known_key];
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (cache.size() >= kMaxCachedExtras) {
+        cache.clear();
+    }
+    cache.emplace(std::move(key), extras);
+    return extras;
+}
+
+}  // namespace
+
 DescriptorEventData::DescriptorEventData(PayloadInputStream* input) {
     fix_part = DescriptorEventDataFixPart(input);
-    for (auto i = int8_t(EventType::DescriptorEvent); i < int8_t(EventType::EventTypeEnd); i++) {
-        post_header_lengths.push_back(GetEventFixPartSize(EventType(i)));
-    }
+    // the per-event fix-part sizes are format constants; compute them once
+    static const std::vector<uint8_t> post_header_template = [] {
+        std::vector<uint8_t> lengths;
+        for (auto i = int8_t(EventType::DescriptorEvent); i < int8_t(EventType::EventTypeEnd); i++) {
+            lengths.push_back(GetEventFixPartSize(EventType(i)));
+        }
+        return lengths;
+    }();
+    post_header_lengths = post_header_template;
     auto ast = input->Read(post_header_lengths.size(), post_header_lengths.data());
     assert(ast.ok());
     ast = input->Read(sizeof(extra_length), &extra_length);
@@ -144,13 +191,7 @@ DescriptorEventData::DescriptorEventData(PayloadInputStream* input) {
     ast = input->Read(extra_length, extra_bytes.data());
     assert(ast.ok());
 
-    milvus::json json = milvus::json::parse(extra_bytes.begin(), extra_bytes.end());
-    if (json.contains(ORIGIN_SIZE_KEY)) {
-        extras[ORIGIN_SIZE_KEY] = json[ORIGIN_SIZE_KEY];
-    }
-    if (json.contains(INDEX_BUILD_ID_KEY)) {
-        extras[INDEX_BUILD_ID_KEY] = json[INDEX_BUILD_ID_KEY];
-    }
+    extras = ParseExtrasCached(extra_bytes);
 }
 
 std::vector<uint8_t>
@@ -190,8 +231,8 @@ BaseEventData::BaseEventData(PayloadInputStream* input, int event_length, DataTy
 }
 
 // TODO :: handle string and bool type
-std::vector<uint8_t>
-BaseEventData::Serialize() {
+SlicedData
+BaseEventData::SerializeToSliced() {
     auto payload = field_data->get_payload();
     std::shared_ptr<PayloadWriter> payload_writer;
     if (milvus::datatype_is_vector(payload->data_type)) {
@@ -200,19 +241,25 @@ BaseEventData::Serialize() {
     } else {
         payload_writer = std::make_unique<PayloadWriter>(payload->data_type);
     }
+    // the row count is known up front, so the builder never re-grows
+    payload_writer->reserve(payload->rows);
     payload_writer->add_payload(*payload.get());
     payload_writer->finish();
-    auto payload_buffer = payload_writer->get_payload_buffer();
-    auto len = sizeof(start_timestamp) + sizeof(end_timestamp) + payload_buffer.size();
-    std::vector<uint8_t> res(len);
-    int offset = 0;
-    memcpy(res.data() + offset, &start_timestamp, sizeof(start_timestamp));
-    offset += sizeof(start_timestamp);
-    memcpy(res.data() + offset, &end_timestamp, sizeof(end_timestamp));
-    offset += sizeof(end_timestamp);
-    memcpy(res.data() + offset, payload_buffer.data(), payload_buffer.size());
 
-    return res;
+    std::vector<uint8_t> prefix(sizeof(start_timestamp) + sizeof(end_timestamp));
+    memcpy(prefix.data(), &start_timestamp, sizeof(start_timestamp));
+    memcpy(prefix.data() + sizeof(start_timestamp), &end_timestamp, sizeof(end_timestamp));
+
+    SlicedData sliced;
+    sliced.append(std::move(prefix));
+    // take the payload blocks as views; no contiguous assembly needed here
+    payload_writer->append_payload_views(sliced, payload_writer);
+    return sliced;
+}
+
+std::vector<uint8_t>
+BaseEventData::Serialize() {
+    return SerializeToSliced().flatten();
 }
 
 BaseEvent::BaseEvent(PayloadInputStream* input, DataType data_type) {
@@ -221,24 +268,22 @@ BaseEvent::BaseEvent(PayloadInputStream* input, DataType data_type) {
     event_data = BaseEventData(input, event_data_length, data_type);
 }
 
-std::vector<uint8_t>
-BaseEvent::Serialize() {
-    auto data = event_data.Serialize();
-    int data_size = data.size();
+SlicedData
+BaseEvent::SerializeToSliced() {
+    auto data_sliced = event_data.SerializeToSliced();
 
     event_header.next_position_ = GetEventHeaderSize(event_header);
-    event_header.event_length_ = event_header.next_position_ + data_size;
-    auto header = event_header.Serialize();
-    int header_size = header.size();
+    event_header.event_length_ = event_header.next_position_ + static_cast<int32_t>(data_sliced.size());
 
-    int len = header_size + data_size;
-    std::vector<uint8_t> res(len);
-    int offset = 0;
-    memcpy(res.data() + offset, header.data(), header_size);
-    offset += header_size;
-    memcpy(res.data() + offset, data.data(), data_size);
+    SlicedData sliced;
+    sliced.append(event_header.Serialize());
+    sliced.append(std::move(data_sliced));
+    return sliced;
+}
 
-    return res;
+std::vector<uint8_t>
+BaseEvent::Serialize() {
+    return SerializeToSliced().flatten();
 }
 
 DescriptorEvent::DescriptorEvent(PayloadInputStream* input) {
@@ -85,6 +85,11 @@ struct BaseEventData {
 
     std::vector<uint8_t>
     Serialize();
+
+    // iovec-style form: the timestamp prefix is owned, the parquet payload
+    // is borrowed from the finished writer the returned object keeps alive
+    SlicedData
+    SerializeToSliced();
 };
 
 struct DescriptorEvent {
@@ -109,6 +114,9 @@ struct BaseEvent {
 
     std::vector<uint8_t>
     Serialize();
+
+    SlicedData
+    SerializeToSliced();
 };
 
 using InsertEvent = BaseEvent;
@@ -32,6 +32,7 @@ FieldData::FieldData(const Payload& payload) {
         builder = CreateArrowBuilder(data_type_);
     }
 
+    ReserveArrowBuilder(builder, data_type_, payload.rows);
     AddPayloadToArrowBuilder(builder, payload);
     auto ast = builder->Finish(&array_);
     AssertInfo(ast.ok(), "builder failed to finish");
@@ -42,11 +43,10 @@ FieldData::FieldData(std::shared_ptr<arrow::Array> array, DataType data_type) :
 }
 
 FieldData::FieldData(const uint8_t* data, int length) : data_type_(DataType::INT8) {
-    auto builder = std::make_shared<arrow::Int8Builder>();
-    auto ret = builder->AppendValues(data, data + length);
-    AssertInfo(ret.ok(), "append value to builder failed");
-    ret = builder->Finish(&array_);
-    AssertInfo(ret.ok(), "builder failed to finish");
+    // wrap the caller's bytes instead of appending them through a builder;
+    // index blobs run through here and are large enough that the copy shows
+    auto buffer = arrow::Buffer::Wrap(data, length);
+    array_ = std::make_shared<arrow::Int8Array>(length, buffer);
 }
 
 bool
@@ -69,13 +69,27 @@ FieldData::get_one_string_payload(int idx, char** cstr, int* str_size) const {
     *str_size = length;
 }
 
+std::vector<std::string_view>
+FieldData::get_string_views() const {
+    AssertInfo(array_ != nullptr, "null arrow array");
+    AssertInfo(array_->type()->id() == arrow::Type::type::STRING, "inconsistent data type");
+    auto array = std::dynamic_pointer_cast<arrow::StringArray>(array_);
+    std::vector<std::string_view> views;
+    views.reserve(array->length());
+    for (int64_t i = 0; i < array->length(); ++i) {
+        auto view = array->GetView(i);
+        views.emplace_back(view.data(), view.size());
+    }
+    return views;
+}
+
 std::unique_ptr<Payload>
 FieldData::get_payload() const {
     AssertInfo(array_ != nullptr, "null arrow array");
     auto raw_data_info = std::make_unique<Payload>();
     raw_data_info->rows = array_->length();
     raw_data_info->data_type = data_type_;
-    raw_data_info->raw_data = GetRawValuesFromArrowArray(array_, data_type_);
+    raw_data_info->raw_data = get_raw_data();
     if (milvus::datatype_is_vector(data_type_)) {
         raw_data_info->dimension = GetDimensionFromArrowArray(array_, data_type_);
     }
@@ -83,6 +97,12 @@ FieldData::get_payload() const {
     return raw_data_info;
 }
 
+const uint8_t*
+FieldData::get_raw_data() const {
+    AssertInfo(array_ != nullptr, "null arrow array");
+    return GetRawValuesFromArrowArray(array_, data_type_);
+}
+
 // TODO :: handle string type
 int
 FieldData::get_data_size() const {
@@ -18,6 +18,8 @@
 
 #include <iostream>
 #include <memory>
+#include <string_view>
+#include <vector>
 
 #include "arrow/api.h"
 #include "storage/Types.h"
@@ -33,6 +35,8 @@ class FieldData {
 
     explicit FieldData(std::shared_ptr<arrow::Array> raw_data, DataType data_type);
 
+    // aliases the caller's buffer instead of copying it; the caller keeps
+    // `data` alive for as long as this FieldData is used
     explicit FieldData(const uint8_t* data, int length);
 
     //    explicit FieldData(std::unique_ptr<uint8_t[]> data, int length, DataType data_type): data_(std::move(data)),
@@ -51,10 +55,20 @@ class FieldData {
     void
     get_one_string_payload(int idx, char** cstr, int* str_size) const;
 
+    // views into the decoded arrow buffer for every row at once, valid
+    // while this FieldData lives
+    std::vector<std::string_view>
+    get_string_views() const;
+
     // get the bytes stream of the arrow array data
     std::unique_ptr<Payload>
     get_payload() const;
 
+    // pointer into the decoded arrow buffer, valid while this FieldData
+    // lives; lets consumers read the column without another copy
+    const uint8_t*
+    get_raw_data() const;
+
     int
     get_payload_length() const {
         return array_->length();
@@ -18,6 +18,7 @@
 #include "exceptions/EasyAssert.h"
 #include "common/Consts.h"
 #include "storage/Event.h"
+#include "storage/Util.h"
 
 namespace milvus::storage {
 
@@ -45,8 +46,23 @@ IndexData::Serialize(StorageType medium) {
     }
 }
 
-std::vector<uint8_t>
-IndexData::serialize_to_remote_file() {
+SlicedData
+IndexData::SerializeToSliced(StorageType medium) {
+    switch (medium) {
+        case StorageType::Remote:
+            return serialize_to_sliced_remote_file();
+        case StorageType::LocalDisk: {
+            SlicedData sliced;
+            sliced.append(serialize_to_local_file());
+            return sliced;
+        }
+        default:
+            PanicInfo("unsupported medium type");
+    }
+}
+
+SlicedData
+IndexData::serialize_to_sliced_remote_file() {
     AssertInfo(field_data_meta_.has_value(), "field data not exist");
     AssertInfo(index_meta_.has_value(), "index meta not exist");
     AssertInfo(field_data_ != nullptr, "empty field data");
@@ -63,8 +79,6 @@ IndexData::serialize_to_remote_file() {
     // TODO :: set timestamps
     index_event_header.timestamp_ = 0;
 
-    // serialize insert event
-    auto index_event_bytes = index_event.Serialize();
     DataType data_type = field_data_->get_data_type();
 
     // create descriptor event
@@ -88,12 +102,26 @@ IndexData::serialize_to_remote_file() {
     // TODO :: set timestamp
     des_event_header.timestamp_ = 0;
 
-    // serialize descriptor event data
-    auto des_event_bytes = descriptor_event.Serialize();
+    // the index event borrows the parquet payload buffer; serialize it
+    // first so its checksum can go into the descriptor extras, letting
+    // readers validate the payload without decoding it
+    auto payload_sliced = index_event.SerializeToSliced();
+    uint32_t crc = 0;
+    for (auto& slice : payload_sliced.get_slices()) {
+        crc = Crc32c(crc, slice.data, slice.size);
+    }
+    des_event_data.extras[PAYLOAD_CRC32C_KEY] = std::to_string(crc);
 
-    des_event_bytes.insert(des_event_bytes.end(), index_event_bytes.begin(), index_event_bytes.end());
+    // the descriptor event is small and owned
+    SlicedData sliced;
+    sliced.append(descriptor_event.Serialize());
+    sliced.append(std::move(payload_sliced));
+    return sliced;
+}
 
-    return des_event_bytes;
+std::vector<uint8_t>
+IndexData::serialize_to_remote_file() {
+    return serialize_to_sliced_remote_file().flatten();
 }
 
 // Just for test
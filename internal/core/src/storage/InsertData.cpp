@@ -41,9 +41,26 @@ InsertData::Serialize(StorageType medium) {
     }
 }
 
+SlicedData
+InsertData::SerializeToSliced(StorageType medium) {
+    switch (medium) {
+        case StorageType::Remote:
+            return serialize_to_sliced_remote_file();
+        case StorageType::LocalDisk: {
+            // the local format has no large borrowed buffers; one owned
+            // slice keeps it simple
+            SlicedData sliced;
+            sliced.append(serialize_to_local_file());
+            return sliced;
+        }
+        default:
+            PanicInfo("unsupported medium type");
+    }
+}
+
 // TODO :: handle string and bool type
-std::vector<uint8_t>
-InsertData::serialize_to_remote_file() {
+SlicedData
+InsertData::serialize_to_sliced_remote_file() {
     AssertInfo(field_data_meta_.has_value(), "field data not exist");
     AssertInfo(field_data_ != nullptr, "empty field data");
 
@@ -59,8 +76,6 @@ InsertData::serialize_to_remote_file() {
     insert_event_header.timestamp_ = 0;
     insert_event_header.event_type_ = EventType::InsertEvent;
 
-    // serialize insert event
-    auto insert_event_bytes = insert_event.Serialize();
     DataType data_type = field_data_->get_data_type();
 
     // create descriptor event
@@ -83,12 +98,26 @@ InsertData::serialize_to_remote_file() {
     // TODO :: set timestamp
     des_event_header.timestamp_ = 0;
 
-    // serialize descriptor event data
-    auto des_event_bytes = descriptor_event.Serialize();
+    // the insert event borrows the parquet payload buffer; serialize it
+    // first so its checksum can go into the descriptor extras, letting
+    // readers validate the payload without decoding it
+    auto payload_sliced = insert_event.SerializeToSliced();
+    uint32_t crc = 0;
+    for (auto& slice : payload_sliced.get_slices()) {
+        crc = Crc32c(crc, slice.data, slice.size);
+    }
+    des_event_data.extras[PAYLOAD_CRC32C_KEY] = std::to_string(crc);
 
-    des_event_bytes.insert(des_event_bytes.end(), insert_event_bytes.begin(), insert_event_bytes.end());
+    // the descriptor event is small and owned
+    SlicedData sliced;
+    sliced.append(descriptor_event.Serialize());
+    sliced.append(std::move(payload_sliced));
+    return sliced;
+}
 
-    return des_event_bytes;
+std::vector<uint8_t>
+InsertData::serialize_to_remote_file() {
+    return serialize_to_sliced_remote_file().flatten();
 }
 
 // local insert file format
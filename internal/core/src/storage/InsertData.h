@@ -31,6 +31,9 @@ class InsertData : public DataCodec {
     std::vector<uint8_t>
     Serialize(StorageType medium) override;
 
+    SlicedData
+    SerializeToSliced(StorageType medium) override;
+
     void
     SetFieldDataMeta(const FieldDataMeta& meta) override;
 
@@ -38,6 +41,9 @@ class InsertData : public DataCodec {
     std::vector<uint8_t>
     serialize_to_remote_file();
 
+    SlicedData
+    serialize_to_sliced_remote_file();
+
     std::vector<uint8_t>
     serialize_to_local_file();
 
@@ -0,0 +1,73 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/IoMetrics.h"
+
+#include <sstream>
+
+namespace milvus::storage {
+
+void
+IoMetrics::OperationStats::Record(int64_t latency_ns, int64_t op_bytes, bool failed) {
+    count.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(op_bytes, std::memory_order_relaxed);
+    if (failed) {
+        failures.fetch_add(1, std::memory_order_relaxed);
+    }
+    int bucket = 0;
+    while (bucket < kLatencyBuckets - 1 && latency_ns >= (int64_t(2) << bucket)) {
+        ++bucket;
+    }
+    latency_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string
+IoMetrics::ToJson() const {
+    static const char* backend_names[kBackends] = {"local", "remote"};
+    static const char* op_names[kOps] = {"read", "write", "list"};
+
+    std::stringstream out;
+    out << "{";
+    for (int backend = 0; backend < kBackends; ++backend) {
+        out << (backend == 0 ? "" : ",") << "\"" << backend_names[backend] << "\":{";
+        for (int op = 0; op < kOps; ++op) {
+            auto& stats = stats_[backend][op];
+            out << (op == 0 ? "" : ",") << "\"" << op_names[op] << "\":{";
+            out << "\"count\":" << stats.count.load(std::memory_order_relaxed);
+            out << ",\"bytes\":" << stats.bytes.load(std::memory_order_relaxed);
+            out << ",\"failures\":" << stats.failures.load(std::memory_order_relaxed);
+            out << ",\"inflight\":" << stats.inflight.load(std::memory_order_relaxed);
+            // only populated buckets, keyed by the bucket's upper bound in
+            // nanoseconds; the scraper rebuilds a cumulative histogram
+            out << ",\"latency_ns\":{";
+            bool first = true;
+            for (int bucket = 0; bucket < kLatencyBuckets; ++bucket) {
+                auto hits = stats.latency_buckets[bucket].load(std::memory_order_relaxed);
+                if (hits == 0) {
+                    continue;
+                }
+                out << (first ? "" : ",") << "\"" << (int64_t(2) << bucket) << "\":" << hits;
+                first = false;
+            }
+            out << "}}";
+        }
+        out << "}";
+    }
+    out << "}";
+    return out.str();
+}
+
+}  // namespace milvus::storage
@@ -0,0 +1,116 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace milvus::storage {
+
+/**
+ * @brief Process-wide I/O counters for the chunk manager tiers, recorded
+ * lock-free on every operation and rendered to json only when the C API
+ * snapshot is asked for. Latencies land in power-of-two nanosecond
+ * buckets, which is plenty to tell a network stall from a decode stall.
+ */
+class IoMetrics {
+ public:
+    enum class Backend { Local = 0, Remote = 1 };
+    enum class Op { Read = 0, Write = 1, List = 2 };
+
+    static constexpr int kBackends = 2;
+    static constexpr int kOps = 3;
+    static constexpr int kLatencyBuckets = 32;
+
+    struct OperationStats {
+        std::atomic<int64_t> count{0};
+        std::atomic<int64_t> bytes{0};
+        std::atomic<int64_t> failures{0};
+        std::atomic<int64_t> inflight{0};
+        // bucket i counts operations with latency in [2^i, 2^(i+1)) ns;
+        // the last bucket absorbs everything slower
+        std::atomic<int64_t> latency_buckets[kLatencyBuckets]{};
+
+        void
+        Record(int64_t latency_ns, int64_t op_bytes, bool failed);
+    };
+
+    static IoMetrics&
+    GetInstance() {
+        // thread-safe enough after c++ 11
+        static IoMetrics instance;
+        return instance;
+    }
+
+    OperationStats&
+    stats(Backend backend, Op op) {
+        return stats_[static_cast<int>(backend)][static_cast<int>(op)];
+    }
+
+    std::string
+    ToJson() const;
+
+ private:
+    IoMetrics() = default;
+    IoMetrics(const IoMetrics&);
+    IoMetrics&
+    operator=(const IoMetrics&);
+
+    OperationStats stats_[kBackends][kOps];
+};
+
+/**
+ * @brief Scope guard around one chunk manager operation: tracks inflight
+ * while alive and records count, bytes and bucketed latency on exit. An
+ * exception unwinding through the scope counts as a failure, so the call
+ * sites need no explicit error paths
+ */
+class IoRecorder {
+ public:
+    IoRecorder(IoMetrics::Backend backend, IoMetrics::Op op)
+        : stats_(IoMetrics::GetInstance().stats(backend, op)),
+          start_(std::chrono::steady_clock::now()),
+          uncaught_(std::uncaught_exceptions()) {
+        stats_.inflight.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~IoRecorder() {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        auto latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        stats_.inflight.fetch_sub(1, std::memory_order_relaxed);
+        stats_.Record(latency_ns, bytes_, std::uncaught_exceptions() > uncaught_);
+    }
+
+    IoRecorder(const IoRecorder&) = delete;
+    IoRecorder&
+    operator=(const IoRecorder&) = delete;
+
+    void
+    SetBytes(int64_t bytes) {
+        bytes_ = bytes;
+    }
+
+ private:
+    IoMetrics::OperationStats& stats_;
+    std::chrono::steady_clock::time_point start_;
+    int uncaught_;
+    int64_t bytes_ = 0;
+};
+
+}  // namespace milvus::storage
@@ -0,0 +1,254 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <sstream>
+
+#include "IoUringQueue.h"
+#include "Exception.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace milvus::storage {
+
+#if defined(__linux__)
+
+namespace {
+
+int
+sys_io_uring_setup(unsigned entries, io_uring_params* params) {
+    return syscall(__NR_io_uring_setup, entries, params);
+}
+
+int
+sys_io_uring_enter(int ring_fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0);
+}
+
+}  // namespace
+
+// one in-flight request: the reaper fulfills the promise and closes the fd
+struct IoUringQueue::Completion {
+    std::promise<uint64_t> promise;
+    std::string filepath;
+    int fd;
+    uint64_t len;
+    uint8_t opcode;
+};
+
+bool
+IoUringQueue::Available() {
+    static bool available = [] {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        int fd = sys_io_uring_setup(4, &params);
+        if (fd < 0) {
+            return false;
+        }
+        close(fd);
+        return true;
+    }();
+    return available;
+}
+
+IoUringQueue::IoUringQueue(unsigned depth) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ring_fd_ = sys_io_uring_setup(depth, &params);
+    if (ring_fd_ < 0) {
+        std::stringstream err_msg;
+        err_msg << "Error: io_uring_setup failed, " << strerror(errno);
+        throw LocalChunkManagerException(err_msg.str());
+    }
+    depth_ = params.sq_entries;
+
+    sq_ring_bytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    sq_ring_ = mmap(nullptr, sq_ring_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                    IORING_OFF_SQ_RING);
+    sqes_bytes_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(
+        mmap(nullptr, sqes_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES));
+    cq_ring_bytes_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    cq_ring_ = mmap(nullptr, cq_ring_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                    IORING_OFF_CQ_RING);
+    if (sq_ring_ == MAP_FAILED || sqes_ == MAP_FAILED || cq_ring_ == MAP_FAILED) {
+        std::stringstream err_msg;
+        err_msg << "Error: mmap io_uring rings failed, " << strerror(errno);
+        throw LocalChunkManagerException(err_msg.str());
+    }
+
+    auto sq_base = static_cast<char*>(sq_ring_);
+    sq_head_ = reinterpret_cast<unsigned*>(sq_base + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq_base + params.sq_off.tail);
+    sq_ring_mask_ = reinterpret_cast<unsigned*>(sq_base + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned*>(sq_base + params.sq_off.array);
+
+    auto cq_base = static_cast<char*>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned*>(cq_base + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq_base + params.cq_off.tail);
+    cq_ring_mask_ = reinterpret_cast<unsigned*>(cq_base + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq_base + params.cq_off.cqes);
+
+    reaper_ = std::thread([this] { Reap(); });
+}
+
+IoUringQueue::~IoUringQueue() {
+    {
+        std::unique_lock lck(mutex_);
+        cv_.wait(lck, [this] { return in_flight_ < depth_; });
+        stop_ = true;
+        // a NOP wakes the reaper even when nothing else is in flight
+        unsigned tail = *sq_tail_;
+        unsigned index = tail & *sq_ring_mask_;
+        auto& sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_NOP;
+        sqe.user_data = 0;
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        sys_io_uring_enter(ring_fd_, 1, 0, 0);
+    }
+    reaper_.join();
+
+    munmap(sq_ring_, sq_ring_bytes_);
+    munmap(sqes_, sqes_bytes_);
+    munmap(cq_ring_, cq_ring_bytes_);
+    close(ring_fd_);
+}
+
+std::future<uint64_t>
+IoUringQueue::Submit(uint8_t opcode, int fd, const std::string& filepath, void* buf, uint64_t len, uint64_t offset) {
+    auto completion = new Completion{std::promise<uint64_t>(), filepath, fd, len, opcode};
+    auto future = completion->promise.get_future();
+
+    std::unique_lock lck(mutex_);
+    cv_.wait(lck, [this] { return in_flight_ < depth_ || stop_; });
+    if (stop_) {
+        close(fd);
+        delete completion;
+        throw LocalChunkManagerException("Error: io_uring queue is shutting down");
+    }
+    ++in_flight_;
+
+    unsigned tail = *sq_tail_;
+    unsigned index = tail & *sq_ring_mask_;
+    auto& sqe = sqes_[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = opcode;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<uint64_t>(buf);
+    sqe.len = len;
+    sqe.off = offset;
+    sqe.user_data = reinterpret_cast<uint64_t>(completion);
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+    if (sys_io_uring_enter(ring_fd_, 1, 0, 0) < 0) {
+        std::stringstream err_msg;
+        err_msg << "Error: io_uring_enter failed for '" << filepath << "', " << strerror(errno);
+        --in_flight_;
+        close(fd);
+        delete completion;
+        throw LocalChunkManagerException(err_msg.str());
+    }
+    return future;
+}
+
+void
+IoUringQueue::Reap() {
+    for (;;) {
+        unsigned head = *cq_head_;
+        if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+            {
+                std::lock_guard lck(mutex_);
+                if (stop_ && in_flight_ == 0) {
+                    return;
+                }
+            }
+            sys_io_uring_enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+            continue;
+        }
+        auto& cqe = cqes_[head & *cq_ring_mask_];
+        auto completion = reinterpret_cast<Completion*>(cqe.user_data);
+        auto res = cqe.res;
+        __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+        if (completion != nullptr) {
+            if (res < 0) {
+                std::stringstream err_msg;
+                err_msg << "Error: async io on local file '" << completion->filepath << "' failed, " << strerror(-res);
+                if (completion->opcode == IORING_OP_READ) {
+                    completion->promise.set_exception(std::make_exception_ptr(ReadFileException(err_msg.str())));
+                } else {
+                    completion->promise.set_exception(std::make_exception_ptr(WriteFileException(err_msg.str())));
+                }
+            } else if (completion->opcode == IORING_OP_WRITE && static_cast<uint64_t>(res) != completion->len) {
+                std::stringstream err_msg;
+                err_msg << "Error: short write on local file '" << completion->filepath << "'";
+                completion->promise.set_exception(std::make_exception_ptr(WriteFileException(err_msg.str())));
+            } else {
+                completion->promise.set_value(res);
+            }
+            close(completion->fd);
+            delete completion;
+            {
+                std::lock_guard lck(mutex_);
+                --in_flight_;
+            }
+            cv_.notify_all();
+        }
+    }
+}
+
+std::future<uint64_t>
+IoUringQueue::SubmitRead(int fd, const std::string& filepath, void* buf, uint64_t len, uint64_t offset) {
+    return Submit(IORING_OP_READ, fd, filepath, buf, len, offset);
+}
+
+std::future<uint64_t>
+IoUringQueue::SubmitWrite(int fd, const std::string& filepath, void* buf, uint64_t len, uint64_t offset) {
+    return Submit(IORING_OP_WRITE, fd, filepath, buf, len, offset);
+}
+
+#else
+
+bool
+IoUringQueue::Available() {
+    return false;
+}
+
+IoUringQueue::IoUringQueue(unsigned /* depth */) {
+    throw NotImplementedException("IoUringQueue requires linux");
+}
+
+IoUringQueue::~IoUringQueue() = default;
+
+std::future<uint64_t>
+IoUringQueue::SubmitRead(int, const std::string&, void*, uint64_t, uint64_t) {
+    throw NotImplementedException("IoUringQueue requires linux");
+}
+
+std::future<uint64_t>
+IoUringQueue::SubmitWrite(int, const std::string&, void*, uint64_t, uint64_t) {
+    throw NotImplementedException("IoUringQueue requires linux");
+}
+
+#endif
+
+}  // namespace milvus::storage
@@ -0,0 +1,107 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#endif
+
+namespace milvus::storage {
+
+/**
+ * @brief IoUringQueue wraps one io_uring submission/completion queue pair.
+ * Submissions return futures and complete on a single reaper thread, so
+ * callers keep many requests in flight on NVMe without one thread per
+ * request. The owned fd is closed when its request completes.
+ */
+class IoUringQueue {
+ public:
+    explicit IoUringQueue(unsigned depth = kDefaultDepth);
+    ~IoUringQueue();
+
+    IoUringQueue(const IoUringQueue&) = delete;
+    IoUringQueue&
+    operator=(const IoUringQueue&) = delete;
+
+    // whether this kernel accepts io_uring_setup; checked once per process
+    static bool
+    Available();
+
+    static IoUringQueue&
+    GetInstance() {
+        // thread-safe enough after c++ 11
+        static IoUringQueue instance;
+        return instance;
+    }
+
+    // takes ownership of fd; resolves to the bytes read (short at EOF)
+    std::future<uint64_t>
+    SubmitRead(int fd, const std::string& filepath, void* buf, uint64_t len, uint64_t offset);
+
+    // takes ownership of fd; short writes resolve to an exception
+    std::future<uint64_t>
+    SubmitWrite(int fd, const std::string& filepath, void* buf, uint64_t len, uint64_t offset);
+
+ private:
+    static constexpr unsigned kDefaultDepth = 256;
+
+#if defined(__linux__)
+    struct Completion;
+
+    std::future<uint64_t>
+    Submit(uint8_t opcode, int fd, const std::string& filepath, void* buf, uint64_t len, uint64_t offset);
+
+    void
+    Reap();
+
+    int ring_fd_ = -1;
+    unsigned depth_ = 0;
+
+    // submission ring (tail owned by submitters under mutex_)
+    void* sq_ring_ = nullptr;
+    size_t sq_ring_bytes_ = 0;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_ring_mask_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqes_bytes_ = 0;
+
+    // completion ring (head owned by the reaper)
+    void* cq_ring_ = nullptr;
+    size_t cq_ring_bytes_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned* cq_ring_mask_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    unsigned in_flight_ = 0;
+    bool stop_ = false;
+    std::thread reaper_;
+#endif
+};
+
+}  // namespace milvus::storage
@@ -25,6 +25,59 @@
 
 namespace milvus::storage {
 
+/**
+ * @brief Sequential staging writer for multi-GB files (DiskANN indexes,
+ * typically) that something mmaps or reads back right after. The extent
+ * grows through fallocate ahead of the appends, so the file stays
+ * contiguous instead of fragmenting append by append; with direct I/O
+ * enabled the bytes leave through O_DIRECT aligned block writes from a
+ * reusable buffer pool, so staging stops evicting the page cache that
+ * sealed segments' mmap'd columns depend on
+ */
+class LocalStagingFile {
+ public:
+    // `expected_size` preallocates the whole extent up front when known;
+    // pass 0 to grow in fixed extents as appends arrive
+    LocalStagingFile(const std::string& filepath, uint64_t expected_size, bool direct_io);
+    ~LocalStagingFile();
+
+    LocalStagingFile(const LocalStagingFile&) = delete;
+    LocalStagingFile&
+    operator=(const LocalStagingFile&) = delete;
+
+    void
+    Append(const void* buf, uint64_t len);
+
+    /**
+     * @brief Flush the tail block and trim the file to the bytes actually
+     * appended; the destructor implies it (swallowing errors), so call it
+     * explicitly on the happy path
+     */
+    void
+    Finish();
+
+    uint64_t
+    size() const {
+        return size_;
+    }
+
+ private:
+    void
+    ensure_allocated(uint64_t target);
+    void
+    flush_block(uint64_t len);
+
+    std::string filepath_;
+    int fd_ = -1;
+    bool direct_ = false;
+    // pooled aligned buffer; appends batch up here before hitting the disk
+    void* block_ = nullptr;
+    uint64_t fill_ = 0;
+    uint64_t size_ = 0;
+    uint64_t allocated_ = 0;
+    bool prealloc_supported_ = true;
+};
+
 /**
  * @brief LocalChunkManager is responsible for read and write local file
  * that inherited from ChunkManager
@@ -75,6 +128,15 @@ class LocalChunkManager : public ChunkManager {
     virtual void
     Write(const std::string& filepath, void* buf, uint64_t len);
 
+    /**
+     * @brief Write an iovec-style serialized form slice by slice, so
+     * binlog payload bytes are never assembled into one buffer first
+     * @param filepath
+     * @param sliced
+     */
+    virtual void
+    Write(const std::string& filepath, const SlicedData& sliced);
+
     /**
      * @brief Write buf to file with specified location.
      *  if file not exist, will throw exception instead of create it
@@ -90,6 +152,31 @@ class LocalChunkManager : public ChunkManager {
     virtual void
     Write(const std::string& filepath, uint64_t offset, void* buf, uint64_t len);
 
+    /**
+     * @brief Read a range asynchronously through the process io_uring
+     * queue when the kernel supports it; otherwise the pool-backed
+     * default from ChunkManager applies
+     * @param filepath
+     * @param offset
+     * @param buf
+     * @param len
+     * @return std::future<uint64_t>
+     */
+    virtual std::future<uint64_t>
+    ReadAsync(const std::string& filepath, uint64_t offset, void* buf, uint64_t len);
+
+    /**
+     * @brief Write a range asynchronously, same dispatch as ReadAsync.
+     * Like the synchronous offset Write, the file must already exist
+     * @param filepath
+     * @param offset
+     * @param buf
+     * @param len
+     * @return std::future<uint64_t>
+     */
+    virtual std::future<uint64_t>
+    WriteAsync(const std::string& filepath, uint64_t offset, void* buf, uint64_t len);
+
     virtual std::vector<std::string>
     ListWithPrefix(const std::string& filepath);
 
@@ -119,6 +206,23 @@ class LocalChunkManager : public ChunkManager {
     bool
     CreateFile(const std::string& filepath);
 
+    /**
+     * @brief Open a staging file for sequential appends, creating parent
+     * directories like CreateFile does; honors the direct staging knob
+     * @param filepath
+     * @param expected_size total size when known, 0 otherwise
+     * @return std::unique_ptr<LocalStagingFile>
+     */
+    std::unique_ptr<LocalStagingFile>
+    OpenStagedFile(const std::string& filepath, uint64_t expected_size = 0);
+
+    // O_DIRECT for staged files; filesystems that reject the flag fall
+    // back to buffered staging per file
+    inline void
+    SetDirectStagingIO(bool enable) {
+        staging_direct_io_ = enable;
+    }
+
  public:
     bool
     DirExist(const std::string& dir);
@@ -145,6 +249,7 @@ class LocalChunkManager : public ChunkManager {
 
  private:
     std::string path_prefix_;
+    bool staging_direct_io_ = false;
 };
 
 using LocalChunkManagerSPtr = std::shared_ptr<milvus::storage::LocalChunkManager>;
@@ -15,18 +15,27 @@
 // limitations under the License.
 
 #include <fstream>
+#include <mutex>
 #include <aws/core/auth/AWSCredentials.h>
 #include <aws/s3/model/CreateBucketRequest.h>
 #include <aws/s3/model/DeleteBucketRequest.h>
 #include <aws/s3/model/DeleteObjectRequest.h>
 #include <aws/s3/model/HeadObjectRequest.h>
 #include <aws/s3/model/ListObjectsRequest.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
+#include <aws/s3/model/CompletedMultipartUpload.h>
+#include <aws/s3/model/CompletedPart.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
 
 #include "MinioChunkManager.h"
 
 #include "log/Log.h"
+#include "storage/IoMetrics.h"
+#include "storage/ObjectMetaCache.h"
 
 #define THROWS3ERROR(FUNCTION)                                                                         \
     do {                                                                                               \
@@ -96,37 +105,142 @@ MinioChunkManager::~MinioChunkManager() {
 
 uint64_t
 MinioChunkManager::Size(const std::string& filepath) {
-    return GetObjectSize(default_bucket_name_, filepath);
+    // binlogs are immutable once uploaded, so a cached size never goes stale
+    auto& cache = ObjectMetaCache::GetInstance();
+    if (auto cached = cache.Size(filepath)) {
+        return cached.value();
+    }
+    auto size = GetObjectSize(default_bucket_name_, filepath);
+    cache.PutPositive(filepath, size);
+    return size;
 }
 
 bool
 MinioChunkManager::Exist(const std::string& filepath) {
-    return ObjectExists(default_bucket_name_, filepath);
+    auto& cache = ObjectMetaCache::GetInstance();
+    if (auto cached = cache.Exists(filepath)) {
+        return cached.value();
+    }
+    auto exists = ObjectExists(default_bucket_name_, filepath);
+    if (exists) {
+        // size stays unknown until someone asks for it
+        cache.PutPositive(filepath, -1);
+    } else {
+        cache.PutNegative(filepath);
+    }
+    return exists;
 }
 
 void
 MinioChunkManager::Remove(const std::string& filepath) {
     DeleteObject(default_bucket_name_, filepath);
+    ObjectMetaCache::GetInstance().Invalidate(filepath);
 }
 
 std::vector<std::string>
 MinioChunkManager::ListWithPrefix(const std::string& filepath) {
-    return ListObjects(default_bucket_name_.c_str(), filepath.c_str());
+    std::vector<std::string> objects_vec;
+    ListWithPrefixStream(filepath, [&](std::vector<std::string> page) {
+        objects_vec.insert(objects_vec.end(), std::make_move_iterator(page.begin()),
+                           std::make_move_iterator(page.end()));
+    });
+    return objects_vec;
+}
+
+void
+MinioChunkManager::ListWithPrefixStream(const std::string& filepath, const ListBatchCallback& callback) {
+    IoRecorder recorder(IoMetrics::Backend::Remote, IoMetrics::Op::List);
+    // shard listings run concurrently, so pages must queue up for the consumer
+    std::mutex sink_mutex;
+    auto sink = [&](std::vector<std::string> page) {
+        std::lock_guard lck(sink_mutex);
+        callback(std::move(page));
+    };
+
+    // the delimiter scan delivers the keys sitting directly under the prefix
+    // and discovers the sub-prefixes to fan out over
+    auto shards = ListShards(filepath, sink);
+    if (shards.empty()) {
+        return;
+    }
+    std::vector<std::future<void>> futures;
+    futures.reserve(shards.size());
+    for (auto& shard : shards) {
+        futures.emplace_back(transfer_pool_.Submit([&, shard] { ListObjectsPaged(shard, sink); }));
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
 }
 
 uint64_t
 MinioChunkManager::Read(const std::string& filepath, void* buf, uint64_t size) {
-    if (!ObjectExists(default_bucket_name_, filepath)) {
+    IoRecorder recorder(IoMetrics::Backend::Remote, IoMetrics::Op::Read);
+    // Exist() serves the preflight from the metadata cache: a segment load
+    // reading dozens of binlogs pays at most one HEAD per object
+    if (!Exist(filepath)) {
+        std::stringstream err_msg;
+        err_msg << "object('" << default_bucket_name_ << "', " << filepath << "') not exists";
+        throw ObjectNotExistException(err_msg.str());
+    }
+    uint64_t read_size;
+    if (size > part_size_) {
+        read_size = GetObjectBufferParallel(default_bucket_name_, filepath, buf, size);
+    } else {
+        read_size = GetObjectBuffer(default_bucket_name_, filepath, buf, size);
+    }
+    recorder.SetBytes(read_size);
+    return read_size;
+}
+
+uint64_t
+MinioChunkManager::Read(const std::string& filepath, uint64_t offset, void* buf, uint64_t size) {
+    IoRecorder recorder(IoMetrics::Backend::Remote, IoMetrics::Op::Read);
+    if (!Exist(filepath)) {
+        std::stringstream err_msg;
+        err_msg << "object('" << default_bucket_name_ << "', " << filepath << "') not exists";
+        throw ObjectNotExistException(err_msg.str());
+    }
+    auto read_size = GetObjectBufferRange(default_bucket_name_, filepath, offset, buf, size);
+    recorder.SetBytes(read_size);
+    return read_size;
+}
+
+std::vector<uint64_t>
+MinioChunkManager::MultiRead(const std::string& filepath, const std::vector<ReadRange>& ranges) {
+    IoRecorder recorder(IoMetrics::Backend::Remote, IoMetrics::Op::Read);
+    if (!Exist(filepath)) {
         std::stringstream err_msg;
         err_msg << "object('" << default_bucket_name_ << "', " << filepath << "') not exists";
         throw ObjectNotExistException(err_msg.str());
     }
-    return GetObjectBuffer(default_bucket_name_, filepath, buf, size);
+    // one ranged GET per range: S3 accepts a single range per request, and
+    // existence is checked only once for the whole batch
+    std::vector<uint64_t> read_sizes;
+    read_sizes.reserve(ranges.size());
+    uint64_t total = 0;
+    for (auto& range : ranges) {
+        read_sizes.push_back(GetObjectBufferRange(default_bucket_name_, filepath, range.offset, range.buf, range.len));
+        total += read_sizes.back();
+    }
+    recorder.SetBytes(total);
+    return read_sizes;
 }
 
 void
 MinioChunkManager::Write(const std::string& filepath, void* buf, uint64_t size) {
-    PutObjectBuffer(default_bucket_name_, filepath, buf, size);
+    IoRecorder recorder(IoMetrics::Backend::Remote, IoMetrics::Op::Write);
+    if (size > part_size_) {
+        PutObjectMultipart(default_bucket_name_, filepath, buf, size);
+    } else {
+        PutObjectBuffer(default_bucket_name_, filepath, buf, size);
+    }
+    recorder.SetBytes(size);
+    // we just uploaded it, so existence and size are known for free
+    ObjectMetaCache::GetInstance().PutPositive(filepath, size);
 }
 
 bool
@@ -287,25 +401,212 @@ MinioChunkManager::GetObjectBuffer(const std::string& bucket_name,
     return realSize;
 }
 
-std::vector<std::string>
-MinioChunkManager::ListObjects(const char* bucket_name, const char* prefix) {
-    std::vector<std::string> objects_vec;
-    Aws::S3::Model::ListObjectsRequest request;
-    request.WithBucket(bucket_name);
-    if (prefix != NULL) {
-        request.SetPrefix(prefix);
+uint64_t
+MinioChunkManager::GetObjectBufferRange(
+    const std::string& bucket_name, const std::string& object_name, uint64_t offset, void* buf, uint64_t size) {
+    Aws::S3::Model::GetObjectRequest request;
+    request.SetBucket(bucket_name.c_str());
+    request.SetKey(object_name.c_str());
+    // HTTP Range is inclusive on both ends
+    std::stringstream range;
+    range << "bytes=" << offset << "-" << (offset + size - 1);
+    request.SetRange(range.str().c_str());
+
+    auto outcome = client_->GetObject(request);
+
+    if (!outcome.IsSuccess()) {
+        THROWS3ERROR(GetObjectBufferRange);
+    }
+    // the body is at most `size` bytes by construction of the range, so it
+    // streams straight into the caller's buffer
+    auto result = outcome.GetResultWithOwnership();
+    auto& body = result.GetBody();
+    body.read(reinterpret_cast<char*>(buf), size);
+    return static_cast<uint64_t>(body.gcount());
+}
+
+uint64_t
+MinioChunkManager::GetObjectBufferParallel(const std::string& bucket_name,
+                                           const std::string& object_name,
+                                           void* buf,
+                                           uint64_t size) {
+    auto total = std::min(static_cast<uint64_t>(GetObjectSize(bucket_name, object_name)), size);
+    if (total <= part_size_) {
+        return GetObjectBuffer(bucket_name, object_name, buf, size);
+    }
+    // each part lands at its own offset of the destination buffer, so the
+    // ranged GETs run fully independent on the transfer pool
+    auto num_parts = (total + part_size_ - 1) / part_size_;
+    std::vector<std::future<uint64_t>> futures;
+    futures.reserve(num_parts);
+    for (uint64_t part = 0; part < num_parts; ++part) {
+        futures.emplace_back(transfer_pool_.Submit([&, part] {
+            auto offset = part * part_size_;
+            auto len = std::min(part_size_, total - offset);
+            return GetObjectBufferRange(bucket_name, object_name, offset, reinterpret_cast<char*>(buf) + offset, len);
+        }));
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+    uint64_t read_size = 0;
+    for (auto& future : futures) {
+        read_size += future.get();
+    }
+    return read_size;
+}
+
+bool
+MinioChunkManager::PutObjectMultipart(const std::string& bucket_name,
+                                      const std::string& object_name,
+                                      void* buf,
+                                      uint64_t size) {
+    Aws::S3::Model::CreateMultipartUploadRequest create_request;
+    create_request.SetBucket(bucket_name.c_str());
+    create_request.SetKey(object_name.c_str());
+
+    auto create_outcome = client_->CreateMultipartUpload(create_request);
+    if (!create_outcome.IsSuccess()) {
+        auto& outcome = create_outcome;
+        THROWS3ERROR(PutObjectMultipart);
+    }
+    auto upload_id = create_outcome.GetResult().GetUploadId();
+
+    auto num_parts = (size + part_size_ - 1) / part_size_;
+    std::vector<Aws::S3::Model::CompletedPart> completed_parts(num_parts);
+    std::vector<std::future<void>> futures;
+    futures.reserve(num_parts);
+    for (uint64_t part = 0; part < num_parts; ++part) {
+        futures.emplace_back(transfer_pool_.Submit([&, part] {
+            auto offset = part * part_size_;
+            auto len = std::min(part_size_, size - offset);
+            Aws::S3::Model::UploadPartRequest request;
+            request.SetBucket(bucket_name.c_str());
+            request.SetKey(object_name.c_str());
+            request.SetUploadId(upload_id);
+            request.SetPartNumber(part + 1);
+            auto stream = Aws::MakeShared<Aws::StringStream>("");
+            stream->write(reinterpret_cast<char*>(buf) + offset, len);
+            request.SetBody(stream);
+
+            auto outcome = client_->UploadPart(request);
+            if (!outcome.IsSuccess()) {
+                THROWS3ERROR(UploadPart);
+            }
+            completed_parts[part].SetPartNumber(part + 1);
+            completed_parts[part].SetETag(outcome.GetResult().GetETag());
+        }));
+    }
+    for (auto& future : futures) {
+        future.wait();
+    }
+    try {
+        for (auto& future : futures) {
+            future.get();
+        }
+    } catch (...) {
+        // drop the partial upload so the bucket does not accumulate orphans
+        Aws::S3::Model::AbortMultipartUploadRequest abort_request;
+        abort_request.SetBucket(bucket_name.c_str());
+        abort_request.SetKey(object_name.c_str());
+        abort_request.SetUploadId(upload_id);
+        client_->AbortMultipartUpload(abort_request);
+        throw;
     }
 
-    auto outcome = client_->ListObjects(request);
+    Aws::S3::Model::CompletedMultipartUpload completed_upload;
+    for (auto& completed_part : completed_parts) {
+        completed_upload.AddParts(completed_part);
+    }
+    Aws::S3::Model::CompleteMultipartUploadRequest complete_request;
+    complete_request.SetBucket(bucket_name.c_str());
+    complete_request.SetKey(object_name.c_str());
+    complete_request.SetUploadId(upload_id);
+    complete_request.SetMultipartUpload(completed_upload);
 
+    auto outcome = client_->CompleteMultipartUpload(complete_request);
     if (!outcome.IsSuccess()) {
-        THROWS3ERROR(ListObjects);
+        THROWS3ERROR(PutObjectMultipart);
+    }
+    return true;
+}
+
+void
+MinioChunkManager::ListObjectsPaged(const std::string& prefix,
+                                    const std::function<void(std::vector<std::string>)>& sink) {
+    Aws::S3::Model::ListObjectsRequest request;
+    request.WithBucket(default_bucket_name_.c_str());
+    request.SetPrefix(prefix.c_str());
+
+    // marker continuation: the previous single-shot listing silently dropped
+    // everything past the first thousand keys
+    while (true) {
+        auto outcome = client_->ListObjects(request);
+        if (!outcome.IsSuccess()) {
+            THROWS3ERROR(ListObjectsPaged);
+        }
+        auto& result = outcome.GetResult();
+        std::vector<std::string> page;
+        page.reserve(result.GetContents().size());
+        for (auto& obj : result.GetContents()) {
+            page.emplace_back(obj.GetKey().c_str());
+        }
+        std::string marker;
+        if (!result.GetNextMarker().empty()) {
+            marker = ConvertFromAwsString(result.GetNextMarker());
+        } else if (!page.empty()) {
+            marker = page.back();
+        }
+        auto truncated = result.GetIsTruncated();
+        if (!page.empty()) {
+            sink(std::move(page));
+        }
+        if (!truncated) {
+            return;
+        }
+        request.SetMarker(marker.c_str());
     }
-    auto objects = outcome.GetResult().GetContents();
-    for (auto& obj : objects) {
-        objects_vec.emplace_back(obj.GetKey().c_str());
+}
+
+std::vector<std::string>
+MinioChunkManager::ListShards(const std::string& prefix, const std::function<void(std::vector<std::string>)>& sink) {
+    Aws::S3::Model::ListObjectsRequest request;
+    request.WithBucket(default_bucket_name_.c_str());
+    request.SetPrefix(prefix.c_str());
+    request.SetDelimiter("/");
+
+    std::vector<std::string> shards;
+    while (true) {
+        auto outcome = client_->ListObjects(request);
+        if (!outcome.IsSuccess()) {
+            THROWS3ERROR(ListShards);
+        }
+        auto& result = outcome.GetResult();
+        std::vector<std::string> page;
+        page.reserve(result.GetContents().size());
+        for (auto& obj : result.GetContents()) {
+            page.emplace_back(obj.GetKey().c_str());
+        }
+        for (auto& common : result.GetCommonPrefixes()) {
+            shards.emplace_back(common.GetPrefix().c_str());
+        }
+        std::string marker;
+        if (!result.GetNextMarker().empty()) {
+            marker = ConvertFromAwsString(result.GetNextMarker());
+        } else if (!page.empty()) {
+            marker = page.back();
+        } else if (!shards.empty()) {
+            marker = shards.back();
+        }
+        auto truncated = result.GetIsTruncated();
+        if (!page.empty()) {
+            sink(std::move(page));
+        }
+        if (!truncated) {
+            return shards;
+        }
+        request.SetMarker(marker.c_str());
     }
-    return objects_vec;
 }
 
 }  // namespace milvus::storage
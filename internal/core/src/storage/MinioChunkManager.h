@@ -18,6 +18,7 @@
 
 #include <aws/core/Aws.h>
 #include <aws/s3/S3Client.h>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -25,6 +26,7 @@
 
 #include "ChunkManager.h"
 #include "Exception.h"
+#include "common/ThreadPool.h"
 #include "config/ConfigChunkManager.h"
 
 namespace milvus::storage {
@@ -63,9 +65,19 @@ class MinioChunkManager : public RemoteChunkManager {
     Size(const std::string& filepath);
 
     virtual uint64_t
-    Read(const std::string& filepath, uint64_t offset, void* buf, uint64_t len) {
-        throw NotImplementedException(GetName() + "Read with offset not implement");
-    }
+    Read(const std::string& filepath, uint64_t offset, void* buf, uint64_t len);
+
+    // one byte range of a vectored read; buf receives [offset, offset + len)
+    struct ReadRange {
+        uint64_t offset;
+        void* buf;
+        uint64_t len;
+    };
+
+    // fetches several ranges of one object with ranged GETs, returning the
+    // bytes read per range; whole-object downloads stay on Read(filepath, ...)
+    virtual std::vector<uint64_t>
+    MultiRead(const std::string& filepath, const std::vector<ReadRange>& ranges);
 
     virtual void
     Write(const std::string& filepath, uint64_t offset, void* buf, uint64_t len) {
@@ -81,6 +93,19 @@ class MinioChunkManager : public RemoteChunkManager {
     virtual std::vector<std::string>
     ListWithPrefix(const std::string& filepath);
 
+    // receives one page of object keys while later pages are still being
+    // fetched; invocations are serialized, so the consumer needs no locking
+    using ListBatchCallback = std::function<void(std::vector<std::string>)>;
+
+    // streams every key under `filepath` to `callback` page by page. The
+    // sub-prefixes one delimiter level down (segment directories under a
+    // collection, typically) fan out over the transfer pool, so a scan over
+    // millions of objects runs concurrent paginated listings and the caller
+    // overlaps processing with the remaining pages. Must not be called from
+    // a transfer pool thread.
+    virtual void
+    ListWithPrefixStream(const std::string& filepath, const ListBatchCallback& callback);
+
     virtual void
     Remove(const std::string& filepath);
 
@@ -99,6 +124,17 @@ class MinioChunkManager : public RemoteChunkManager {
         default_bucket_name_ = bucket_name;
     }
 
+    inline uint64_t
+    GetPartSize() {
+        return part_size_;
+    }
+
+    // objects above this size move as concurrent parts; call before transfers
+    inline void
+    SetPartSize(uint64_t part_size) {
+        part_size_ = part_size;
+    }
+
     bool
     BucketExists(const std::string& bucket_name);
 
@@ -122,13 +158,33 @@ class MinioChunkManager : public RemoteChunkManager {
     PutObjectBuffer(const std::string& bucket_name, const std::string& object_name, void* buf, uint64_t size);
     uint64_t
     GetObjectBuffer(const std::string& bucket_name, const std::string& object_name, void* buf, uint64_t size);
+    uint64_t
+    GetObjectBufferRange(
+        const std::string& bucket_name, const std::string& object_name, uint64_t offset, void* buf, uint64_t size);
+    uint64_t
+    GetObjectBufferParallel(const std::string& bucket_name, const std::string& object_name, void* buf, uint64_t size);
+    bool
+    PutObjectMultipart(const std::string& bucket_name, const std::string& object_name, void* buf, uint64_t size);
+    // pages through one prefix with marker continuation, handing every page
+    // to `sink` as it arrives
+    void
+    ListObjectsPaged(const std::string& prefix, const std::function<void(std::vector<std::string>)>& sink);
+    // one delimiter-level scan: keys directly under `prefix` go to `sink`,
+    // the common prefixes below it are returned for fan-out
     std::vector<std::string>
-    ListObjects(const char* bucket_name, const char* prefix = NULL);
+    ListShards(const std::string& prefix, const std::function<void(std::vector<std::string>)>& sink);
 
  private:
     Aws::SDKOptions sdk_options_;
     std::shared_ptr<Aws::S3::S3Client> client_;
     std::string default_bucket_name_;
+
+    // transfers larger than one part fan out across this pool; owned by the
+    // chunk manager so bulk storage traffic has its own executor
+    static constexpr uint64_t kDefaultPartSize = 16 << 20;
+    static constexpr int kTransferThreads = 8;
+    uint64_t part_size_ = kDefaultPartSize;
+    ThreadPool transfer_pool_{kTransferThreads};
 };
 
 using MinioChunkManagerSPtr = std::shared_ptr<MinioChunkManager>;
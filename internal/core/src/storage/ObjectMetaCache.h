@@ -0,0 +1,150 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace milvus::storage {
+
+/**
+ * @brief Process-wide existence/size cache for immutable remote objects,
+ * shared by MinioChunkManager and the local disk cache tier. Binlogs never
+ * change after upload, so a positive answer stays valid until the object is
+ * removed through this process; load orchestration can then re-ask
+ * Exist/Size per segment wave without re-issuing HeadObject. Negative
+ * answers expire after a short TTL, because the missing object is usually
+ * a binlog another node is still flushing.
+ */
+class ObjectMetaCache {
+ private:
+    ObjectMetaCache() = default;
+    ObjectMetaCache(const ObjectMetaCache&);
+    ObjectMetaCache&
+    operator=(const ObjectMetaCache&);
+
+ public:
+    // entries are ~100 bytes; past this point the cache flushes whole and
+    // repopulates, which costs one HEAD per hot object instead of tracking
+    // recency on every lookup
+    static constexpr size_t kMaxEntries = 1 << 20;
+
+    static ObjectMetaCache&
+    GetInstance() {
+        // thread-safe enough after c++ 11
+        static ObjectMetaCache instance;
+        return instance;
+    }
+
+    // nullopt means the cache cannot answer and the backend must be asked
+    std::optional<bool>
+    Exists(const std::string& filepath) {
+        std::lock_guard lck(mutex_);
+        auto iter = find_live(filepath);
+        if (iter == entries_.end()) {
+            return std::nullopt;
+        }
+        return iter->second.exists;
+    }
+
+    std::optional<uint64_t>
+    Size(const std::string& filepath) {
+        std::lock_guard lck(mutex_);
+        auto iter = find_live(filepath);
+        if (iter == entries_.end() || !iter->second.exists || iter->second.size < 0) {
+            return std::nullopt;
+        }
+        return static_cast<uint64_t>(iter->second.size);
+    }
+
+    // records an existing object; pass size -1 when only existence is known
+    // (a HEAD driven by Exist) — a known size is never downgraded
+    void
+    PutPositive(const std::string& filepath, int64_t size) {
+        std::lock_guard lck(mutex_);
+        reserve_slot();
+        auto& entry = entries_[filepath];
+        if (size < 0 && entry.exists && entry.size >= 0) {
+            return;
+        }
+        entry = Entry{true, size, {}};
+    }
+
+    void
+    PutNegative(const std::string& filepath) {
+        std::lock_guard lck(mutex_);
+        reserve_slot();
+        entries_[filepath] = Entry{false, -1, std::chrono::steady_clock::now() + negative_ttl_};
+    }
+
+    void
+    Invalidate(const std::string& filepath) {
+        std::lock_guard lck(mutex_);
+        entries_.erase(filepath);
+    }
+
+    void
+    Clear() {
+        std::lock_guard lck(mutex_);
+        entries_.clear();
+    }
+
+    void
+    SetNegativeTtl(std::chrono::milliseconds ttl) {
+        std::lock_guard lck(mutex_);
+        negative_ttl_ = ttl;
+    }
+
+ private:
+    struct Entry {
+        bool exists;
+        int64_t size;
+        // meaningful only for negative entries; positive ones never expire
+        std::chrono::steady_clock::time_point expires_at;
+    };
+
+    // caller holds mutex_
+    std::unordered_map<std::string, Entry>::iterator
+    find_live(const std::string& filepath) {
+        auto iter = entries_.find(filepath);
+        if (iter == entries_.end()) {
+            return entries_.end();
+        }
+        if (!iter->second.exists && std::chrono::steady_clock::now() >= iter->second.expires_at) {
+            entries_.erase(iter);
+            return entries_.end();
+        }
+        return iter;
+    }
+
+    // caller holds mutex_
+    void
+    reserve_slot() {
+        if (entries_.size() >= kMaxEntries) {
+            entries_.clear();
+        }
+    }
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::chrono::milliseconds negative_ttl_{std::chrono::seconds(10)};
+};
+
+}  // namespace milvus::storage
@@ -14,10 +14,74 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <arrow/array/concatenate.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 #include "storage/PayloadReader.h"
+#include "storage/ArrowMemoryPool.h"
+#include "common/ThreadPool.h"
 #include "exceptions/EasyAssert.h"
 
 namespace milvus::storage {
+
+namespace {
+
+// per-reader cap: a handful of concurrent segment loads must not blanket
+// the load pool with row-group decode tasks
+constexpr int64_t kMaxDecodeParallelism = 8;
+
+// shared between the calling thread and its decode helpers; owned by
+// shared_ptr so a helper the pool schedules late finds only drained work,
+// never dangling state
+struct RowGroupDecodeContext {
+    explicit RowGroupDecodeContext(int num_row_groups) : parts(num_row_groups) {
+    }
+
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> parts;
+    std::atomic<int> next_group{0};
+    std::mutex mutex;
+    std::condition_variable cv;
+    int completed = 0;
+    std::exception_ptr error;
+};
+
+// claims row groups off the shared counter and decodes them with `reader`;
+// every claimed group is marked completed even on failure, so the waiter
+// always unblocks and can rethrow the recorded error
+void
+DecodeClaimedRowGroups(parquet::arrow::FileReader& reader,
+                       const std::shared_ptr<RowGroupDecodeContext>& ctx,
+                       int num_row_groups) {
+    for (;;) {
+        auto group = ctx->next_group.fetch_add(1);
+        if (group >= num_row_groups) {
+            return;
+        }
+        std::shared_ptr<arrow::ChunkedArray> part;
+        std::exception_ptr error;
+        try {
+            auto st = reader.RowGroup(group)->Column(0)->Read(&part);
+            AssertInfo(st.ok(), "failed to read parquet row group");
+        } catch (...) {
+            error = std::current_exception();
+        }
+        {
+            std::lock_guard lck(ctx->mutex);
+            ctx->parts[group] = std::move(part);
+            if (error != nullptr && ctx->error == nullptr) {
+                ctx->error = error;
+            }
+            if (++ctx->completed == num_row_groups) {
+                ctx->cv.notify_all();
+            }
+        }
+    }
+}
+
+}  // namespace
 PayloadReader::PayloadReader(std::shared_ptr<PayloadInputStream> input, DataType data_type) : column_type_(data_type) {
     init(input);
 }
@@ -29,18 +93,75 @@ PayloadReader::PayloadReader(const uint8_t* data, int length, DataType data_type
 
 void
 PayloadReader::init(std::shared_ptr<PayloadInputStream> input) {
-    auto mem_pool = arrow::default_memory_pool();
-    // TODO :: Stream read file data, avoid copying
+    auto mem_pool = GetArrowPool(ArrowPoolScope::PayloadRead);
     std::unique_ptr<parquet::arrow::FileReader> reader;
     auto st = parquet::arrow::OpenFile(input, mem_pool, &reader);
     AssertInfo(st.ok(), "failed to get arrow file reader");
-    std::shared_ptr<arrow::Table> table;
-    st = reader->ReadTable(&table);
-    AssertInfo(st.ok(), "failed to get reader data to arrow table");
-    auto column = table->column(0);
+    // decode the single column straight into one arrow array: no table
+    // wrapper, and FieldData exposes the decoded buffer by pointer from
+    // here on instead of copying values out
+    std::shared_ptr<arrow::ChunkedArray> column;
+    auto num_row_groups = reader->parquet_reader()->metadata()->num_row_groups();
+    if (num_row_groups > 1) {
+        // row groups decode in parallel on the load pool. Parquet readers
+        // are not safe for concurrent reads, so every helper opens its own
+        // reader over the same immutable buffer; the calling thread decodes
+        // with the reader already open and claims groups like any helper,
+        // which also means nothing deadlocks when init itself runs on a
+        // load pool worker and the helpers never get a thread.
+        auto& pool = ThreadPool::GetInstance(ThreadPoolRole::Load);
+        auto parallelism = std::min<int64_t>(
+            {kMaxDecodeParallelism, static_cast<int64_t>(num_row_groups), static_cast<int64_t>(pool.num_threads())});
+        auto ctx = std::make_shared<RowGroupDecodeContext>(num_row_groups);
+        auto* data = input->data();
+        auto data_size = input->size();
+        for (int64_t i = 1; i < parallelism; ++i) {
+            pool.Submit([ctx, data, data_size, mem_pool, num_row_groups] {
+                std::unique_ptr<parquet::arrow::FileReader> helper_reader;
+                auto helper_input = std::make_shared<PayloadInputStream>(data, data_size);
+                if (!parquet::arrow::OpenFile(helper_input, mem_pool, &helper_reader).ok()) {
+                    // the calling thread drains the remaining groups
+                    return;
+                }
+                DecodeClaimedRowGroups(*helper_reader, ctx, num_row_groups);
+            });
+        }
+        DecodeClaimedRowGroups(*reader, ctx, num_row_groups);
+
+        std::unique_lock lck(ctx->mutex);
+        ctx->cv.wait(lck, [&] { return ctx->completed == num_row_groups; });
+        if (ctx->error != nullptr) {
+            std::rethrow_exception(ctx->error);
+        }
+        // reassemble in row-group order; arrival order only decided who
+        // decoded what
+        arrow::ArrayVector chunks;
+        chunks.reserve(num_row_groups);
+        for (auto& part : ctx->parts) {
+            for (auto& chunk : part->chunks()) {
+                chunks.push_back(chunk);
+            }
+        }
+        column = std::make_shared<arrow::ChunkedArray>(std::move(chunks), ctx->parts[0]->type());
+    } else {
+        st = reader->ReadColumn(0, &column);
+        AssertInfo(st.ok(), "failed to read arrow column from parquet");
+    }
     AssertInfo(column != nullptr, "returned arrow column is null");
-    AssertInfo(column->chunks().size() == 1, "arrow chunk size in arrow column should be 1");
-    auto array = column->chunk(0);
+    std::shared_ptr<arrow::Array> array;
+    if (column->num_chunks() == 1) {
+        array = column->chunk(0);
+    } else if (column->num_chunks() > 1) {
+        // streamed payloads carry one chunk per flushed row group
+        auto res = arrow::Concatenate(column->chunks(), mem_pool);
+        AssertInfo(res.ok(), "failed to concatenate arrow chunks");
+        array = res.ValueOrDie();
+    } else {
+        // a payload finished with zero rows decodes to a chunkless column
+        auto res = arrow::MakeArrayOfNull(column->type(), 0);
+        AssertInfo(res.ok(), "failed to make empty arrow array");
+        array = res.ValueOrDie();
+    }
     AssertInfo(array != nullptr, "empty arrow array of PayloadReader");
     field_data_ = std::make_shared<FieldData>(array, column_type_);
 }
@@ -14,6 +14,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+
 #include "arrow/api.h"
 
 #include "storage/PayloadStream.h"
@@ -21,9 +23,15 @@
 
 namespace milvus::storage {
 
-PayloadOutputStream::PayloadOutputStream() {
-    buffer_.reserve(1024 * 1024);
-    closed_ = false;
+namespace {
+// the first block matches the old 1 MB up-front reserve so small payloads
+// stay cheap; each further block doubles up to the rope cap
+constexpr int64_t INITIAL_BLOCK_BYTES = 1 << 20;
+constexpr int64_t MAX_BLOCK_BYTES = 16 << 20;
+}  // namespace
+
+PayloadOutputStream::PayloadOutputStream()
+    : next_block_bytes_(INITIAL_BLOCK_BYTES), size_(0), flat_valid_(false), closed_(false) {
 }
 
 PayloadOutputStream::~PayloadOutputStream() noexcept {
@@ -37,7 +45,7 @@ PayloadOutputStream::Close() {
 
 arrow::Result<int64_t>
 PayloadOutputStream::Tell() const {
-    return arrow::Result<int64_t>(buffer_.size());
+    return arrow::Result<int64_t>(size_);
 }
 
 bool
@@ -45,13 +53,33 @@ PayloadOutputStream::closed() const {
     return closed_;
 }
 
+void
+PayloadOutputStream::add_block() {
+    blocks_.emplace_back();
+    blocks_.back().reserve(next_block_bytes_);
+    next_block_bytes_ = std::min(next_block_bytes_ * 2, MAX_BLOCK_BYTES);
+}
+
 arrow::Status
 PayloadOutputStream::Write(const void* data, int64_t nbytes) {
     if (nbytes <= 0)
         return arrow::Status::OK();
-    auto size = buffer_.size();
-    buffer_.resize(size + nbytes);
-    std::memcpy(buffer_.data() + size, data, nbytes);
+    auto src = static_cast<const uint8_t*>(data);
+    while (nbytes > 0) {
+        if (blocks_.empty() || blocks_.back().size() == blocks_.back().capacity()) {
+            add_block();
+        }
+        auto& block = blocks_.back();
+        auto room = static_cast<int64_t>(block.capacity() - block.size());
+        auto n = std::min(room, nbytes);
+        // filling within the reserved capacity never reallocates, so each
+        // written byte moves exactly once
+        block.insert(block.end(), src, src + n);
+        src += n;
+        nbytes -= n;
+        size_ += n;
+    }
+    flat_valid_ = false;
     return arrow::Status::OK();
 }
 
@@ -62,7 +90,63 @@ PayloadOutputStream::Flush() {
 
 const std::vector<uint8_t>&
 PayloadOutputStream::Buffer() const {
-    return buffer_;
+    if (blocks_.size() == 1) {
+        return blocks_.front();
+    }
+    if (!flat_valid_) {
+        flat_.clear();
+        flat_.reserve(size_);
+        for (auto& block : blocks_) {
+            flat_.insert(flat_.end(), block.begin(), block.end());
+        }
+        flat_valid_ = true;
+    }
+    return flat_;
+}
+
+void
+PayloadOutputStream::AppendViews(SlicedData& sliced, std::shared_ptr<void> owner) const {
+    for (auto& block : blocks_) {
+        sliced.append_view(block.data(), static_cast<int64_t>(block.size()), std::move(owner));
+        owner = nullptr;
+    }
+}
+
+CallbackOutputStream::CallbackOutputStream(WriteFunc write_func)
+    : write_func_(std::move(write_func)), position_(0), closed_(false) {
+}
+
+CallbackOutputStream::~CallbackOutputStream() noexcept {
+}
+
+arrow::Status
+CallbackOutputStream::Close() {
+    closed_ = true;
+    return arrow::Status::OK();
+}
+
+arrow::Result<int64_t>
+CallbackOutputStream::Tell() const {
+    return arrow::Result<int64_t>(position_);
+}
+
+bool
+CallbackOutputStream::closed() const {
+    return closed_;
+}
+
+arrow::Status
+CallbackOutputStream::Write(const void* data, int64_t nbytes) {
+    if (nbytes <= 0)
+        return arrow::Status::OK();
+    write_func_(static_cast<const uint8_t*>(data), nbytes);
+    position_ += nbytes;
+    return arrow::Status::OK();
+}
+
+arrow::Status
+CallbackOutputStream::Flush() {
+    return arrow::Status::OK();
 }
 
 PayloadInputStream::PayloadInputStream(const uint8_t* data, int64_t size)
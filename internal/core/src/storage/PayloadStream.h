@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 #include <memory>
 
@@ -36,6 +37,13 @@ struct Payload {
     std::optional<int> dimension;
 };
 
+/**
+ * @brief PayloadOutputStream accumulates written bytes in a rope of
+ * fixed-capacity blocks instead of one growing vector, so serializing a
+ * large column never reallocates and re-copies what is already written.
+ * Scatter-gather consumers take the blocks as views through AppendViews();
+ * Buffer() assembles a contiguous copy lazily for legacy callers
+ */
 class PayloadOutputStream : public arrow::io::OutputStream {
  public:
     PayloadOutputStream();
@@ -53,11 +61,56 @@ class PayloadOutputStream : public arrow::io::OutputStream {
     Flush() override;
 
  public:
+    // contiguous bytes for consumers that need a single span; assembled
+    // on first call and cached, except the single-block case which is
+    // already contiguous
     const std::vector<uint8_t>&
     Buffer() const;
 
+    // appends one view per block with no assembly; `owner` must keep this
+    // stream alive for the lifetime of `sliced`
+    void
+    AppendViews(SlicedData& sliced, std::shared_ptr<void> owner) const;
+
+ private:
+    void
+    add_block();
+
+    std::vector<std::vector<uint8_t>> blocks_;
+    int64_t next_block_bytes_;
+    int64_t size_;
+    mutable std::vector<uint8_t> flat_;
+    mutable bool flat_valid_;
+    bool closed_;
+};
+
+/**
+ * @brief CallbackOutputStream hands every written byte range to the caller
+ * as it arrives instead of accumulating a buffer, so a streaming payload
+ * writer can push completed row groups to a file or multipart upload with
+ * bounded memory
+ */
+class CallbackOutputStream : public arrow::io::OutputStream {
+ public:
+    using WriteFunc = std::function<void(const uint8_t* data, int64_t size)>;
+
+    explicit CallbackOutputStream(WriteFunc write_func);
+    ~CallbackOutputStream();
+
+    arrow::Status
+    Close() override;
+    arrow::Result<int64_t>
+    Tell() const override;
+    bool
+    closed() const override;
+    arrow::Status
+    Write(const void* data, int64_t nbytes) override;
+    arrow::Status
+    Flush() override;
+
  private:
-    std::vector<uint8_t> buffer_;
+    WriteFunc write_func_;
+    int64_t position_;
     bool closed_;
 };
 
@@ -81,6 +134,18 @@ class PayloadInputStream : public arrow::io::RandomAccessFile {
     arrow::Result<int64_t>
     GetSize() override;
 
+    // the wrapped immutable bytes, so parallel decoders can open
+    // independent streams over the same buffer
+    const uint8_t*
+    data() const {
+        return data_;
+    }
+
+    int64_t
+    size() const {
+        return size_;
+    }
+
  private:
     const uint8_t* data_;
     const int64_t size_;
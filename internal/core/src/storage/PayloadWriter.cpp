@@ -14,7 +14,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+
 #include "storage/PayloadWriter.h"
+#include "storage/ArrowMemoryPool.h"
 #include "exceptions/EasyAssert.h"
 #include "common/FieldMeta.h"
 #include "storage/Util.h"
@@ -25,11 +28,77 @@ namespace milvus::storage {
 PayloadWriter::PayloadWriter(const DataType column_type) : column_type_(column_type) {
     builder_ = CreateArrowBuilder(column_type);
     schema_ = CreateArrowSchema(column_type);
+    writer_props_ = CreateWriterProperties(DEFAULT_ZSTD_LEVEL, true);
 }
 
 // create payload writer for vector data type
 PayloadWriter::PayloadWriter(const DataType column_type, int dim) : column_type_(column_type) {
     init_dimension(dim);
+    // vector bytes are close to incompressible; dictionary pages only
+    // add decode work
+    writer_props_ = CreateWriterProperties(DEFAULT_ZSTD_LEVEL, false);
+}
+
+// create streaming payload writer for numeric data type
+PayloadWriter::PayloadWriter(const DataType column_type,
+                             std::shared_ptr<arrow::io::OutputStream> sink,
+                             int64_t row_group_rows)
+    : column_type_(column_type), sink_(std::move(sink)), row_group_rows_(row_group_rows) {
+    AssertInfo(row_group_rows_ > 0, "invalid row group size");
+    builder_ = CreateArrowBuilder(column_type);
+    schema_ = CreateArrowSchema(column_type);
+    writer_props_ = CreateWriterProperties(DEFAULT_ZSTD_LEVEL, true);
+}
+
+// create streaming payload writer for vector data type
+PayloadWriter::PayloadWriter(const DataType column_type,
+                             int dim,
+                             std::shared_ptr<arrow::io::OutputStream> sink,
+                             int64_t row_group_rows)
+    : column_type_(column_type), sink_(std::move(sink)), row_group_rows_(row_group_rows) {
+    AssertInfo(row_group_rows_ > 0, "invalid row group size");
+    init_dimension(dim);
+    writer_props_ = CreateWriterProperties(DEFAULT_ZSTD_LEVEL, false);
+}
+
+void
+PayloadWriter::set_compression(int zstd_level, bool enable_dictionary) {
+    AssertInfo(!finished_, "payload writer has been finished");
+    AssertInfo(rows_ == 0 && file_writer_ == nullptr, "compression must be set before adding rows");
+    writer_props_ = CreateWriterProperties(zstd_level, enable_dictionary);
+}
+
+void
+PayloadWriter::reserve(int64_t rows_hint, int64_t bytes_hint) {
+    AssertInfo(!finished_, "payload writer has been finished");
+    reserved_rows_ = std::max(reserved_rows_, rows_hint);
+    reserved_bytes_ = std::max(reserved_bytes_, bytes_hint);
+    ReserveArrowBuilder(builder_, column_type_, rows_hint, bytes_hint);
+}
+
+void
+PayloadWriter::open_file_writer() {
+    auto mem_pool = GetArrowPool(ArrowPoolScope::PayloadWrite);
+    auto ast = parquet::arrow::FileWriter::Open(*schema_, mem_pool, sink_, writer_props_, &file_writer_);
+    AssertInfo(ast.ok(), "open parquet file writer failed");
+}
+
+void
+PayloadWriter::flush_row_group() {
+    // opened on first flush so set_compression can still run after the
+    // streaming constructor
+    if (file_writer_ == nullptr) {
+        open_file_writer();
+    }
+    if (builder_->length() == 0) {
+        return;
+    }
+    std::shared_ptr<arrow::Array> array;
+    auto ast = builder_->Finish(&array);
+    AssertInfo(ast.ok(), "builder failed to finish");
+    auto table = arrow::Table::Make(schema_, {array});
+    ast = file_writer_->WriteTable(*table, array->length());
+    AssertInfo(ast.ok(), "write row group to sink failed");
 }
 
 void
@@ -46,15 +115,29 @@ PayloadWriter::init_dimension(int dim) {
 
 void
 PayloadWriter::add_one_string_payload(const char* str, int str_size) {
-    AssertInfo(output_ == nullptr, "payload writer has been finished");
+    AssertInfo(!finished_, "payload writer has been finished");
     AssertInfo(milvus::datatype_is_string(column_type_), "mismatch data type");
     AddOneStringToArrowBuilder(builder_, str, str_size);
     rows_.fetch_add(1);
+    if (sink_ != nullptr && builder_->length() >= row_group_rows_) {
+        flush_row_group();
+    }
+}
+
+void
+PayloadWriter::add_string_payloads(const std::string_view* strs, int64_t num_strs) {
+    AssertInfo(!finished_, "payload writer has been finished");
+    AssertInfo(milvus::datatype_is_string(column_type_), "mismatch data type");
+    AddStringsToArrowBuilder(builder_, strs, num_strs);
+    rows_.fetch_add(num_strs);
+    if (sink_ != nullptr && builder_->length() >= row_group_rows_) {
+        flush_row_group();
+    }
 }
 
 void
 PayloadWriter::add_payload(const Payload& raw_data) {
-    AssertInfo(output_ == nullptr, "payload writer has been finished");
+    AssertInfo(!finished_, "payload writer has been finished");
     AssertInfo(column_type_ == raw_data.data_type, "mismatch data type");
     AssertInfo(builder_ != nullptr, "empty arrow builder");
     if (milvus::datatype_is_vector(column_type_)) {
@@ -64,27 +147,53 @@ PayloadWriter::add_payload(const Payload& raw_data) {
 
     AddPayloadToArrowBuilder(builder_, raw_data);
     rows_.fetch_add(raw_data.rows);
+    if (sink_ != nullptr && builder_->length() >= row_group_rows_) {
+        flush_row_group();
+    }
 }
 
 void
 PayloadWriter::finish() {
-    AssertInfo(output_ == nullptr, "payload writer has been finished");
+    AssertInfo(!finished_, "payload writer has been finished");
+    if (sink_ != nullptr) {
+        // streaming mode: the sink already holds every completed row group
+        flush_row_group();
+        auto ast = file_writer_->Close();
+        AssertInfo(ast.ok(), "close parquet file writer failed");
+        finished_ = true;
+        return;
+    }
+
     std::shared_ptr<arrow::Array> array;
     auto ast = builder_->Finish(&array);
     AssertInfo(ast.ok(), "builder failed to finish");
 
     auto table = arrow::Table::Make(schema_, {array});
     output_ = std::make_shared<storage::PayloadOutputStream>();
-    auto mem_pool = arrow::default_memory_pool();
-    ast = parquet::arrow::WriteTable(
-        *table, mem_pool, output_, 1024 * 1024 * 1024,
-        parquet::WriterProperties::Builder().compression(arrow::Compression::ZSTD)->compression_level(3)->build());
+    auto mem_pool = GetArrowPool(ArrowPoolScope::PayloadWrite);
+    ast = parquet::arrow::WriteTable(*table, mem_pool, output_, 1024 * 1024 * 1024, writer_props_);
     AssertInfo(ast.ok(), "write data to output stream failed");
+    finished_ = true;
+}
+
+void
+PayloadWriter::reset() {
+    AssertInfo(sink_ == nullptr, "streaming payload writer cannot be reset");
+    builder_->Reset();
+    // Reset() released the builder buffers; re-reserve the high-water row
+    // count so the next user of a pooled writer never re-grows from scratch
+    reserved_rows_ = std::max<int64_t>(reserved_rows_, rows_);
+    ReserveArrowBuilder(builder_, column_type_, reserved_rows_, reserved_bytes_);
+    output_.reset();
+    // a pooled writer must not inherit the previous user's codec choice
+    writer_props_ = CreateWriterProperties(DEFAULT_ZSTD_LEVEL, !milvus::datatype_is_vector(column_type_));
+    rows_ = 0;
+    finished_ = false;
 }
 
 bool
 PayloadWriter::has_finished() {
-    return output_ != nullptr;
+    return finished_;
 }
 
 const std::vector<uint8_t>&
@@ -93,4 +202,10 @@ PayloadWriter::get_payload_buffer() const {
     return output_->Buffer();
 }
 
+void
+PayloadWriter::append_payload_views(SlicedData& sliced, std::shared_ptr<void> owner) const {
+    AssertInfo(output_ != nullptr, "payload writer has not been finished");
+    output_->AppendViews(sliced, std::move(owner));
+}
+
 }  // namespace milvus::storage
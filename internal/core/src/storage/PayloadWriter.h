@@ -17,6 +17,7 @@
 #pragma once
 
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include "storage/PayloadStream.h"
@@ -27,23 +28,76 @@ class PayloadWriter {
  public:
     explicit PayloadWriter(const DataType column_type);
     explicit PayloadWriter(const DataType column_type, int dim);
+
+    // streaming mode: completed row groups are written to `sink` every
+    // `row_group_rows` rows, so peak memory stays at one row group no
+    // matter how large the column grows. get_payload_buffer() does not
+    // apply; the sink has already received the bytes
+    PayloadWriter(const DataType column_type, std::shared_ptr<arrow::io::OutputStream> sink, int64_t row_group_rows);
+    PayloadWriter(const DataType column_type,
+                  int dim,
+                  std::shared_ptr<arrow::io::OutputStream> sink,
+                  int64_t row_group_rows);
+
     ~PayloadWriter() = default;
 
+    // choose the column codec; must be called before any rows are added
+    void
+    set_compression(int zstd_level, bool enable_dictionary);
+
+    // pre-sizes the builder for a known row count (strings may also pass
+    // the total value byte size) so adding the payload never grows arrow
+    // buffers; the high-water hint is re-applied by reset(), so pooled
+    // writers keep their capacity across reuse
+    void
+    reserve(int64_t rows_hint, int64_t bytes_hint = 0);
+
     void
     add_payload(const Payload& raw_data);
 
     void
     add_one_string_payload(const char* str, int str_size);
 
+    // bulk variant of add_one_string_payload: validates once and reserves
+    // builder storage for the whole batch
+    void
+    add_string_payloads(const std::string_view* strs, int64_t num_strs);
+
     void
     finish();
 
     bool
     has_finished();
 
+    // returns the writer to its freshly-constructed state so a pool can hand
+    // it out again; builder capacity survives, compression falls back to the
+    // default. Streaming writers own a sink and cannot be reset.
+    void
+    reset();
+
+    bool
+    resettable() const {
+        return sink_ == nullptr;
+    }
+
+    DataType
+    get_column_type() const {
+        return column_type_;
+    }
+
+    std::optional<int>
+    get_dimension() const {
+        return dimension_;
+    }
+
     const std::vector<uint8_t>&
     get_payload_buffer() const;
 
+    // appends the finished payload as block views with no assembly copy;
+    // `owner` must keep this writer alive for the lifetime of `sliced`
+    void
+    append_payload_views(SlicedData& sliced, std::shared_ptr<void> owner) const;
+
     int
     get_payload_length() const {
         return rows_;
@@ -53,6 +107,12 @@ class PayloadWriter {
     void
     init_dimension(int dim);
 
+    void
+    open_file_writer();
+
+    void
+    flush_row_group();
+
  private:
     DataType column_type_;
     std::shared_ptr<arrow::ArrayBuilder> builder_;
@@ -60,5 +120,14 @@ class PayloadWriter {
     std::shared_ptr<PayloadOutputStream> output_;
     std::atomic<int> rows_ = 0;
     std::optional<int> dimension_;  // binary vector, float vector
+    std::shared_ptr<parquet::WriterProperties> writer_props_;
+
+    // streaming mode only
+    std::shared_ptr<arrow::io::OutputStream> sink_;
+    std::unique_ptr<parquet::arrow::FileWriter> file_writer_;
+    int64_t row_group_rows_ = 0;
+    int64_t reserved_rows_ = 0;
+    int64_t reserved_bytes_ = 0;
+    bool finished_ = false;
 };
 }  // namespace milvus::storage
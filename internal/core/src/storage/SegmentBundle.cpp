@@ -0,0 +1,157 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "storage/SegmentBundle.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "exceptions/EasyAssert.h"
+
+namespace milvus::storage {
+
+namespace {
+
+constexpr uint32_t BUNDLE_MAGIC = 0x424e444c;  // "BNDL"
+constexpr uint64_t TRAILER_SIZE = sizeof(uint32_t) * 2;
+// tail probe sized to cover the trailer plus the footer of any reasonable
+// schema, so a typical load spends exactly one ranged read on metadata
+constexpr uint64_t FOOTER_PROBE_SIZE = 64 * 1024;
+
+void
+PutU32(std::vector<uint8_t>& out, uint32_t value) {
+    auto pos = out.size();
+    out.resize(pos + sizeof(value));
+    std::memcpy(out.data() + pos, &value, sizeof(value));
+}
+
+void
+PutU64(std::vector<uint8_t>& out, uint64_t value) {
+    auto pos = out.size();
+    out.resize(pos + sizeof(value));
+    std::memcpy(out.data() + pos, &value, sizeof(value));
+}
+
+uint32_t
+GetU32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+uint64_t
+GetU64(const uint8_t* data) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+}  // namespace
+
+void
+SegmentBundleWriter::Append(const std::string& key, std::vector<uint8_t> payload) {
+    SlicedData sliced;
+    sliced.append(std::move(payload));
+    Append(key, std::move(sliced));
+}
+
+void
+SegmentBundleWriter::Append(const std::string& key, SlicedData&& payload) {
+    AssertInfo(entries_.count(key) == 0, "duplicate key in segment bundle: " + key);
+    entries_[key] = BundleEntry{static_cast<uint64_t>(data_.size()), static_cast<uint64_t>(payload.size())};
+    data_.append(std::move(payload));
+}
+
+void
+SegmentBundleWriter::Write(ChunkManager& chunk_manager, const std::string& filepath) {
+    AssertInfo(!entries_.empty(), "refusing to write an empty segment bundle");
+    std::vector<uint8_t> footer;
+    PutU32(footer, static_cast<uint32_t>(entries_.size()));
+    for (auto& [key, entry] : entries_) {
+        PutU32(footer, static_cast<uint32_t>(key.size()));
+        auto pos = footer.size();
+        footer.resize(pos + key.size());
+        std::memcpy(footer.data() + pos, key.data(), key.size());
+        PutU64(footer, entry.offset);
+        PutU64(footer, entry.size);
+    }
+    PutU32(footer, static_cast<uint32_t>(footer.size()));
+    PutU32(footer, BUNDLE_MAGIC);
+    data_.append(std::move(footer));
+    chunk_manager.Write(filepath, data_);
+}
+
+SegmentBundleReader::SegmentBundleReader(ChunkManager& chunk_manager, const std::string& filepath)
+    : chunk_manager_(chunk_manager), filepath_(filepath) {
+    auto object_size = chunk_manager_.Size(filepath_);
+    AssertInfo(object_size >= TRAILER_SIZE, "segment bundle too small: " + filepath_);
+    std::vector<uint8_t> tail(std::min(object_size, FOOTER_PROBE_SIZE));
+    auto read = chunk_manager_.Read(filepath_, object_size - tail.size(), tail.data(), tail.size());
+    AssertInfo(read == tail.size(), "short read of segment bundle footer: " + filepath_);
+
+    auto magic = GetU32(tail.data() + tail.size() - sizeof(uint32_t));
+    AssertInfo(magic == BUNDLE_MAGIC, "not a segment bundle: " + filepath_);
+    auto footer_size = static_cast<uint64_t>(GetU32(tail.data() + tail.size() - TRAILER_SIZE));
+    AssertInfo(footer_size + TRAILER_SIZE <= object_size, "corrupt segment bundle footer: " + filepath_);
+    if (footer_size + TRAILER_SIZE > tail.size()) {
+        // wide schema outgrew the probe; one more ranged read for the rest
+        tail.resize(footer_size + TRAILER_SIZE);
+        read = chunk_manager_.Read(filepath_, object_size - tail.size(), tail.data(), tail.size());
+        AssertInfo(read == tail.size(), "short read of segment bundle footer: " + filepath_);
+    }
+
+    auto payload_size = object_size - footer_size - TRAILER_SIZE;
+    const uint8_t* cursor = tail.data() + tail.size() - TRAILER_SIZE - footer_size;
+    const uint8_t* end = tail.data() + tail.size() - TRAILER_SIZE;
+    AssertInfo(cursor + sizeof(uint32_t) <= end, "truncated segment bundle footer: " + filepath_);
+    auto count = GetU32(cursor);
+    cursor += sizeof(uint32_t);
+    for (uint32_t i = 0; i < count; ++i) {
+        AssertInfo(cursor + sizeof(uint32_t) <= end, "truncated segment bundle footer: " + filepath_);
+        auto key_size = GetU32(cursor);
+        cursor += sizeof(uint32_t);
+        AssertInfo(cursor + key_size + sizeof(uint64_t) * 2 <= end,
+                   "truncated segment bundle footer: " + filepath_);
+        std::string key(reinterpret_cast<const char*>(cursor), key_size);
+        cursor += key_size;
+        auto offset = GetU64(cursor);
+        cursor += sizeof(uint64_t);
+        auto size = GetU64(cursor);
+        cursor += sizeof(uint64_t);
+        AssertInfo(offset + size <= payload_size, "segment bundle entry out of range: " + key);
+        entries_[std::move(key)] = BundleEntry{offset, size};
+    }
+}
+
+std::vector<uint8_t>
+SegmentBundleReader::Read(const std::string& key) const {
+    auto iter = entries_.find(key);
+    AssertInfo(iter != entries_.end(), "key not in segment bundle: " + key);
+    std::vector<uint8_t> payload(iter->second.size);
+    auto read = chunk_manager_.Read(filepath_, iter->second.offset, payload.data(), payload.size());
+    AssertInfo(read == payload.size(), "short read of bundled payload: " + key);
+    return payload;
+}
+
+std::future<std::vector<uint8_t>>
+SegmentBundleReader::ReadAsync(const std::string& key) const {
+    // entry lookup happens eagerly so a bad key throws here, not in the pool
+    auto iter = entries_.find(key);
+    AssertInfo(iter != entries_.end(), "key not in segment bundle: " + key);
+    return ThreadPool::GetInstance(ThreadPoolRole::Load).Submit([this, key] { return Read(key); });
+}
+
+}  // namespace milvus::storage
@@ -0,0 +1,101 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/ChunkManager.h"
+#include "storage/Types.h"
+
+namespace milvus::storage {
+
+// Single-object segment format: the serialized binlogs belonging to one
+// segment (field data, statistics, delete logs) are concatenated into one
+// object followed by a footer mapping each log key to its byte range:
+//
+//   [payload 0] ... [payload n-1] [footer] [footer size:u32] [magic:u32]
+//
+// One PUT replaces the per-log uploads, and a loader fetches the footer
+// with a single ranged read and then pulls only the ranges it needs, so
+// the object-store request count per segment stops scaling with the
+// schema width.
+
+// byte range of one bundled payload inside the object
+struct BundleEntry {
+    uint64_t offset;
+    uint64_t size;
+};
+
+class SegmentBundleWriter {
+ public:
+    // appends one serialized payload under `key`; callers use the binlog
+    // key the payload would have been stored under on its own
+    void
+    Append(const std::string& key, std::vector<uint8_t> payload);
+
+    // sliced variant: splices a DataCodec::SerializeToSliced form without
+    // assembling it into contiguous bytes first
+    void
+    Append(const std::string& key, SlicedData&& payload);
+
+    // uploads payloads, footer and trailer as one object
+    void
+    Write(ChunkManager& chunk_manager, const std::string& filepath);
+
+ private:
+    SlicedData data_;
+    std::map<std::string, BundleEntry> entries_;
+};
+
+class SegmentBundleReader {
+ public:
+    // fetches and parses the footer: one ranged read for typical footers,
+    // a second one only when the footer outgrows the tail probe
+    SegmentBundleReader(ChunkManager& chunk_manager, const std::string& filepath);
+
+    bool
+    Contains(const std::string& key) const {
+        return entries_.count(key) > 0;
+    }
+
+    const std::map<std::string, BundleEntry>&
+    entries() const {
+        return entries_;
+    }
+
+    // ranged read of one payload
+    std::vector<uint8_t>
+    Read(const std::string& key) const;
+
+    // resolves to the payload bytes without blocking, so a loader can have
+    // every field range in flight at once; the reader must outlive the
+    // returned future
+    std::future<std::vector<uint8_t>>
+    ReadAsync(const std::string& key) const;
+
+ private:
+    ChunkManager& chunk_manager_;
+    std::string filepath_;
+    std::map<std::string, BundleEntry> entries_;
+};
+
+}  // namespace milvus::storage
@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <cstring>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "common/Types.h"
 
@@ -70,6 +73,80 @@ enum CodecType {
     IndexDataType = 2,
 };
 
+/**
+ * @brief SlicedData is an iovec-style serialized form: small owned header
+ * chunks interleaved with views over payload buffers, so binlog bytes can
+ * reach a chunk manager without being assembled into one contiguous copy
+ */
+class SlicedData {
+ public:
+    struct Slice {
+        const uint8_t* data;
+        int64_t size;
+    };
+
+    // takes ownership of a (small) byte chunk, typically an event header
+    void
+    append(std::vector<uint8_t> bytes) {
+        owned_.emplace_back(std::move(bytes));
+        slices_.push_back(Slice{owned_.back().data(), static_cast<int64_t>(owned_.back().size())});
+    }
+
+    // borrows a payload buffer; `owner` keeps it alive for this object's
+    // lifetime
+    void
+    append_view(const uint8_t* data, int64_t size, std::shared_ptr<void> owner) {
+        slices_.push_back(Slice{data, size});
+        if (owner != nullptr) {
+            owners_.emplace_back(std::move(owner));
+        }
+    }
+
+    // splices another sliced form onto the end; moved buffers keep their
+    // heap addresses, so the views stay valid
+    void
+    append(SlicedData&& other) {
+        slices_.insert(slices_.end(), other.slices_.begin(), other.slices_.end());
+        for (auto& bytes : other.owned_) {
+            owned_.emplace_back(std::move(bytes));
+        }
+        for (auto& owner : other.owners_) {
+            owners_.emplace_back(std::move(owner));
+        }
+    }
+
+    const std::vector<Slice>&
+    get_slices() const {
+        return slices_;
+    }
+
+    int64_t
+    size() const {
+        int64_t total = 0;
+        for (auto& slice : slices_) {
+            total += slice.size;
+        }
+        return total;
+    }
+
+    // assemble once, for consumers that need contiguous bytes
+    std::vector<uint8_t>
+    flatten() const {
+        std::vector<uint8_t> res(size());
+        int64_t offset = 0;
+        for (auto& slice : slices_) {
+            std::memcpy(res.data() + offset, slice.data, slice.size);
+            offset += slice.size;
+        }
+        return res;
+    }
+
+ private:
+    std::vector<Slice> slices_;
+    std::vector<std::vector<uint8_t>> owned_;
+    std::vector<std::shared_ptr<void>> owners_;
+};
+
 // index meta information corresponding to index file data
 struct IndexMeta {
     int64_t segment_id;
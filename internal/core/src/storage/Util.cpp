@@ -14,9 +14,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
+#include <cstring>
+#include <memory>
+
 #include "storage/Util.h"
+#include "storage/ArrowMemoryPool.h"
+#include "common/SimdDispatch.h"
 #include "exceptions/EasyAssert.h"
 #include "common/Consts.h"
+#include "common/FieldMeta.h"
 #include "config/ConfigChunkManager.h"
 
 namespace milvus::storage {
@@ -119,33 +126,54 @@ AddOneStringToArrowBuilder(std::shared_ptr<arrow::ArrayBuilder> builder, const c
     AssertInfo(ast.ok(), "append value to arrow builder failed");
 }
 
+void
+AddStringsToArrowBuilder(std::shared_ptr<arrow::ArrayBuilder> builder, const std::string_view* strs, int64_t num_strs) {
+    AssertInfo(builder != nullptr, "empty arrow builder");
+    auto string_builder = std::dynamic_pointer_cast<arrow::StringBuilder>(builder);
+    AssertInfo(string_builder != nullptr, "builder is not a string builder");
+    int64_t total_bytes = 0;
+    for (int64_t i = 0; i < num_strs; ++i) {
+        total_bytes += static_cast<int64_t>(strs[i].size());
+    }
+    auto ast = string_builder->Reserve(num_strs);
+    AssertInfo(ast.ok(), "reserve string slots in arrow builder failed");
+    ast = string_builder->ReserveData(total_bytes);
+    AssertInfo(ast.ok(), "reserve string storage in arrow builder failed");
+    for (int64_t i = 0; i < num_strs; ++i) {
+        string_builder->UnsafeAppend(strs[i].data(), static_cast<arrow::StringBuilder::offset_type>(strs[i].size()));
+    }
+}
+
 std::shared_ptr<arrow::ArrayBuilder>
 CreateArrowBuilder(DataType data_type) {
+    // builders only exist on the write path, so their buffers are charged
+    // to the write pool
+    auto pool = GetArrowPool(ArrowPoolScope::PayloadWrite);
     switch (static_cast<DataType>(data_type)) {
         case DataType::BOOL: {
-            return std::make_shared<arrow::BooleanBuilder>();
+            return std::make_shared<arrow::BooleanBuilder>(pool);
         }
         case DataType::INT8: {
-            return std::make_shared<arrow::Int8Builder>();
+            return std::make_shared<arrow::Int8Builder>(pool);
         }
         case DataType::INT16: {
-            return std::make_shared<arrow::Int16Builder>();
+            return std::make_shared<arrow::Int16Builder>(pool);
         }
         case DataType::INT32: {
-            return std::make_shared<arrow::Int32Builder>();
+            return std::make_shared<arrow::Int32Builder>(pool);
         }
         case DataType::INT64: {
-            return std::make_shared<arrow::Int64Builder>();
+            return std::make_shared<arrow::Int64Builder>(pool);
         }
         case DataType::FLOAT: {
-            return std::make_shared<arrow::FloatBuilder>();
+            return std::make_shared<arrow::FloatBuilder>(pool);
         }
         case DataType::DOUBLE: {
-            return std::make_shared<arrow::DoubleBuilder>();
+            return std::make_shared<arrow::DoubleBuilder>(pool);
         }
         case DataType::VARCHAR:
         case DataType::STRING: {
-            return std::make_shared<arrow::StringBuilder>();
+            return std::make_shared<arrow::StringBuilder>(pool);
         }
         default: {
             PanicInfo("unsupported numeric data type");
@@ -158,11 +186,13 @@ CreateArrowBuilder(DataType data_type, int dim) {
     switch (static_cast<DataType>(data_type)) {
         case DataType::VECTOR_FLOAT: {
             AssertInfo(dim > 0, "invalid dim value");
-            return std::make_shared<arrow::FixedSizeBinaryBuilder>(arrow::fixed_size_binary(dim * sizeof(float)));
+            return std::make_shared<arrow::FixedSizeBinaryBuilder>(arrow::fixed_size_binary(dim * sizeof(float)),
+                                                                   GetArrowPool(ArrowPoolScope::PayloadWrite));
         }
         case DataType::VECTOR_BINARY: {
             AssertInfo(dim % 8 == 0 && dim > 0, "invalid dim value");
-            return std::make_shared<arrow::FixedSizeBinaryBuilder>(arrow::fixed_size_binary(dim / 8));
+            return std::make_shared<arrow::FixedSizeBinaryBuilder>(arrow::fixed_size_binary(dim / 8),
+                                                                   GetArrowPool(ArrowPoolScope::PayloadWrite));
         }
         default: {
             PanicInfo("unsupported vector data type");
@@ -170,6 +200,24 @@ CreateArrowBuilder(DataType data_type, int dim) {
     }
 }
 
+void
+ReserveArrowBuilder(std::shared_ptr<arrow::ArrayBuilder> builder,
+                    DataType data_type,
+                    int64_t rows_hint,
+                    int64_t bytes_hint) {
+    AssertInfo(builder != nullptr, "empty arrow builder");
+    if (rows_hint <= 0) {
+        return;
+    }
+    auto ast = builder->Reserve(rows_hint);
+    AssertInfo(ast.ok(), "reserve arrow builder failed");
+    if (milvus::datatype_is_string(data_type) && bytes_hint > 0) {
+        auto string_builder = std::dynamic_pointer_cast<arrow::StringBuilder>(builder);
+        ast = string_builder->ReserveData(bytes_hint);
+        AssertInfo(ast.ok(), "reserve string storage in arrow builder failed");
+    }
+}
+
 std::shared_ptr<arrow::Schema>
 CreateArrowSchema(DataType data_type) {
     switch (static_cast<DataType>(data_type)) {
@@ -221,6 +269,18 @@ CreateArrowSchema(DataType data_type, int dim) {
     }
 }
 
+std::shared_ptr<parquet::WriterProperties>
+CreateWriterProperties(int zstd_level, bool enable_dictionary) {
+    parquet::WriterProperties::Builder builder;
+    builder.compression(arrow::Compression::ZSTD)->compression_level(zstd_level);
+    if (enable_dictionary) {
+        builder.enable_dictionary();
+    } else {
+        builder.disable_dictionary();
+    }
+    return builder.build();
+}
+
 // TODO ::handle string type
 int64_t
 GetPayloadSize(const Payload* payload) {
@@ -342,4 +402,65 @@ GetLocalRawDataPathPrefixWithBuildID(int64_t segment_id) {
            std::to_string(segment_id);
 }
 
+namespace {
+
+// reflected Castagnoli polynomial table, built on first use
+const uint32_t*
+Crc32cTable() {
+    static const auto table = [] {
+        auto t = std::make_unique<std::array<uint32_t, 256>>();
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ ((crc & 1) ? 0x82F63B78u : 0);
+            }
+            (*t)[i] = crc;
+        }
+        return t;
+    }();
+    return table->data();
+}
+
+uint32_t
+Crc32cSoftware(uint32_t crc, const uint8_t* data, int64_t size) {
+    auto table = Crc32cTable();
+    for (int64_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) uint32_t
+Crc32cHardware(uint32_t crc, const uint8_t* data, int64_t size) {
+    uint64_t state = crc;
+    while (size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        state = __builtin_ia32_crc32di(state, word);
+        data += 8;
+        size -= 8;
+    }
+    auto tail = static_cast<uint32_t>(state);
+    while (size > 0) {
+        tail = __builtin_ia32_crc32qi(tail, *data++);
+        --size;
+    }
+    return tail;
+}
+#endif
+
+}  // namespace
+
+uint32_t
+Crc32c(uint32_t crc, const uint8_t* data, int64_t size) {
+    crc = ~crc;
+#if defined(__x86_64__)
+    if (milvus::UseSimdSse42()) {
+        return ~Crc32cHardware(crc, data, size);
+    }
+#endif
+    return ~Crc32cSoftware(crc, data, size);
+}
+
 }  // namespace milvus::storage
@@ -18,6 +18,9 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
+
+#include <parquet/properties.h>
 
 #include "storage/PayloadStream.h"
 #include "storage/FileManager.h"
@@ -34,18 +37,41 @@ AddPayloadToArrowBuilder(std::shared_ptr<arrow::ArrayBuilder> builder, const Pay
 void
 AddOneStringToArrowBuilder(std::shared_ptr<arrow::ArrayBuilder> builder, const char* str, int str_size);
 
+// bulk counterpart of AddOneStringToArrowBuilder: one validation and one
+// reservation for the whole batch, then unchecked appends
+void
+AddStringsToArrowBuilder(std::shared_ptr<arrow::ArrayBuilder> builder, const std::string_view* strs, int64_t num_strs);
+
 std::shared_ptr<arrow::ArrayBuilder>
 CreateArrowBuilder(DataType data_type);
 
 std::shared_ptr<arrow::ArrayBuilder>
 CreateArrowBuilder(DataType data_type, int dim);
 
+// pre-sizes a builder for a known row count so appends never trigger
+// internal arrow buffer growth; strings additionally take the total value
+// byte size (fixed-width builders size their value buffer from the row
+// count alone)
+void
+ReserveArrowBuilder(std::shared_ptr<arrow::ArrayBuilder> builder,
+                    DataType data_type,
+                    int64_t rows_hint,
+                    int64_t bytes_hint = 0);
+
 std::shared_ptr<arrow::Schema>
 CreateArrowSchema(DataType data_type);
 
 std::shared_ptr<arrow::Schema>
 CreateArrowSchema(DataType data_type, int dim);
 
+constexpr int DEFAULT_ZSTD_LEVEL = 3;
+
+// writer properties for payload columns: ZSTD at the given level, with
+// dictionary encoding on or off (worth it for low-cardinality VarChar and
+// int8 label columns, wasted effort for vectors)
+std::shared_ptr<parquet::WriterProperties>
+CreateWriterProperties(int zstd_level, bool enable_dictionary);
+
 int64_t
 GetPayloadSize(const Payload* payload);
 
@@ -70,4 +96,9 @@ GetLocalRawDataPathPrefixWithBuildID(int64_t segment_id);
 FileManagerImplPtr
 CreateFileManager(knowhere::IndexType index_type, const FieldDataMeta& field_meta, const IndexMeta& index_meta);
 
+// CRC32C (Castagnoli) over a byte range, chained through `crc` (pass 0 to
+// start); uses the SSE4.2 crc32 instruction when the CPU has it
+uint32_t
+Crc32c(uint32_t crc, const uint8_t* data, int64_t size);
+
 }  // namespace milvus::storage
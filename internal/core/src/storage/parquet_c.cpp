@@ -14,7 +14,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
 #include "storage/parquet_c.h"
+#include "storage/ArrowMemoryPool.h"
 #include "storage/PayloadReader.h"
 #include "storage/PayloadWriter.h"
 #include "common/CGoHelper.h"
@@ -23,6 +29,72 @@ using Payload = milvus::storage::Payload;
 using PayloadWriter = milvus::storage::PayloadWriter;
 using PayloadReader = milvus::storage::PayloadReader;
 
+namespace {
+
+// Writers released through the C API come back here and are handed out again
+// by (column type, dim) instead of rebuilding the arrow builder, schema and
+// writer properties per binlog; DataNode flushes create thousands of writers
+// per minute over a handful of distinct shapes. dim is -1 for scalar columns.
+class PayloadWriterPool {
+ public:
+    static PayloadWriterPool&
+    Instance() {
+        static PayloadWriterPool pool;
+        return pool;
+    }
+
+    PayloadWriter*
+    Acquire(int column_type, int dim) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = idle_.find(std::make_pair(column_type, dim));
+            if (it != idle_.end() && !it->second.empty()) {
+                auto writer = std::move(it->second.back());
+                it->second.pop_back();
+                return writer.release();
+            }
+        }
+        auto data_type = static_cast<milvus::DataType>(column_type);
+        if (dim >= 0) {
+            return std::make_unique<PayloadWriter>(data_type, dim).release();
+        }
+        return std::make_unique<PayloadWriter>(data_type).release();
+    }
+
+    void
+    Release(PayloadWriter* writer) {
+        if (writer == nullptr) {
+            return;
+        }
+        std::unique_ptr<PayloadWriter> owned(writer);
+        if (!owned->resettable()) {
+            return;
+        }
+        auto key = std::make_pair(static_cast<int>(owned->get_column_type()), owned->get_dimension().value_or(-1));
+        try {
+            owned->reset();
+        } catch (std::exception& e) {
+            // a writer that fails to reset is simply not recycled
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& bucket = idle_[key];
+        if (bucket.size() < kMaxIdlePerKey) {
+            bucket.emplace_back(std::move(owned));
+        }
+    }
+
+ private:
+    // enough for the concurrent flushes of one DataNode without pinning
+    // builder memory forever
+    static constexpr size_t kMaxIdlePerKey = 16;
+
+    std::mutex mutex_;
+    std::map<std::pair<int, int>, std::vector<std::unique_ptr<PayloadWriter>>> idle_;
+};
+
+}  // namespace
+
 static const char*
 ErrorMsg(const std::string& msg) {
     if (msg.empty())
@@ -35,18 +107,23 @@ ErrorMsg(const std::string& msg) {
 
 extern "C" CPayloadWriter
 NewPayloadWriter(int columnType) {
-    auto data_type = static_cast<milvus::DataType>(columnType);
-    auto p = std::make_unique<PayloadWriter>(data_type);
-
-    return reinterpret_cast<CPayloadWriter>(p.release());
+    return reinterpret_cast<CPayloadWriter>(PayloadWriterPool::Instance().Acquire(columnType, -1));
 }
 
 CPayloadWriter
 NewVectorPayloadWriter(int columnType, int dim) {
-    auto data_type = static_cast<milvus::DataType>(columnType);
-    auto p = std::make_unique<PayloadWriter>(data_type, dim);
+    return reinterpret_cast<CPayloadWriter>(PayloadWriterPool::Instance().Acquire(columnType, dim));
+}
 
-    return reinterpret_cast<CPayloadWriter>(p.release());
+extern "C" CStatus
+SetPayloadWriterCompression(CPayloadWriter payloadWriter, int zstd_level, bool enable_dictionary) {
+    try {
+        auto p = reinterpret_cast<PayloadWriter*>(payloadWriter);
+        p->set_compression(zstd_level, enable_dictionary);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
 }
 
 CStatus
@@ -113,6 +190,22 @@ AddOneStringToPayload(CPayloadWriter payloadWriter, char* cstr, int str_size) {
     }
 }
 
+extern "C" CStatus
+AddStringsToPayload(CPayloadWriter payloadWriter, const char* strs_data, const int64_t* offsets, int num_strs) {
+    try {
+        auto p = reinterpret_cast<PayloadWriter*>(payloadWriter);
+        std::vector<std::string_view> strs;
+        strs.reserve(num_strs);
+        for (int i = 0; i < num_strs; ++i) {
+            strs.emplace_back(strs_data + offsets[i], offsets[i + 1] - offsets[i]);
+        }
+        p->add_string_payloads(strs.data(), num_strs);
+        return milvus::SuccessCStatus();
+    } catch (std::exception& e) {
+        return milvus::FailureCStatus(UnexpectedError, e.what());
+    }
+}
+
 extern "C" CStatus
 AddBinaryVectorToPayload(CPayloadWriter payloadWriter, uint8_t* values, int dimension, int length) {
     try {
@@ -174,9 +267,8 @@ GetPayloadLengthFromWriter(CPayloadWriter payloadWriter) {
 extern "C" void
 ReleasePayloadWriter(CPayloadWriter handler) {
     auto p = reinterpret_cast<PayloadWriter*>(handler);
-    if (p != nullptr)
-        delete p;
-    arrow::default_memory_pool()->ReleaseUnused();
+    PayloadWriterPool::Instance().Release(p);
+    milvus::storage::GetArrowPool(milvus::storage::ArrowPoolScope::PayloadWrite)->ReleaseUnused();
 }
 
 extern "C" CPayloadReader
@@ -350,5 +442,30 @@ extern "C" void
 ReleasePayloadReader(CPayloadReader payloadReader) {
     auto p = reinterpret_cast<PayloadReader*>(payloadReader);
     delete (p);
-    arrow::default_memory_pool()->ReleaseUnused();
+    milvus::storage::GetArrowPool(milvus::storage::ArrowPoolScope::PayloadRead)->ReleaseUnused();
+}
+
+extern "C" int64_t
+GetArrowReadPoolBytes() {
+    return milvus::storage::GetArrowPoolBytes(milvus::storage::ArrowPoolScope::PayloadRead);
+}
+
+extern "C" int64_t
+GetArrowWritePoolBytes() {
+    return milvus::storage::GetArrowPoolBytes(milvus::storage::ArrowPoolScope::PayloadWrite);
+}
+
+extern "C" int64_t
+GetArrowReadPoolPeakBytes() {
+    return milvus::storage::GetArrowPoolPeakBytes(milvus::storage::ArrowPoolScope::PayloadRead);
+}
+
+extern "C" int64_t
+GetArrowWritePoolPeakBytes() {
+    return milvus::storage::GetArrowPoolPeakBytes(milvus::storage::ArrowPoolScope::PayloadWrite);
+}
+
+extern "C" void
+SetArrowPoolLimit(int64_t limit_bytes) {
+    milvus::storage::SetArrowPoolLimit(limit_bytes);
 }
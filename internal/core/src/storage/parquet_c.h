@@ -36,6 +36,10 @@ CPayloadWriter
 NewPayloadWriter(int columnType);
 CPayloadWriter
 NewVectorPayloadWriter(int columnType, int dim);
+// per-field codec: ZSTD level plus dictionary encoding; call before any
+// values are added
+CStatus
+SetPayloadWriterCompression(CPayloadWriter payloadWriter, int zstd_level, bool enable_dictionary);
 CStatus
 AddBooleanToPayload(CPayloadWriter payloadWriter, bool* values, int length);
 CStatus
@@ -52,6 +56,11 @@ CStatus
 AddDoubleToPayload(CPayloadWriter payloadWriter, double* values, int length);
 CStatus
 AddOneStringToPayload(CPayloadWriter payloadWriter, char* cstr, int str_size);
+// packed batch of strings: string i occupies strs_data[offsets[i], offsets[i+1]),
+// so offsets holds num_strs + 1 entries and the whole column crosses the
+// boundary in one call
+CStatus
+AddStringsToPayload(CPayloadWriter payloadWriter, const char* strs_data, const int64_t* offsets, int num_strs);
 CStatus
 AddBinaryVectorToPayload(CPayloadWriter payloadWriter, uint8_t* values, int dimension, int length);
 CStatus
@@ -96,6 +105,27 @@ GetPayloadLengthFromReader(CPayloadReader payloadReader);
 void
 ReleasePayloadReader(CPayloadReader payloadReader);
 
+//============= arrow memory accounting ======================
+// All arrow allocations made by payload readers/writers go through scoped
+// accounted pools, so segment loading can see (and bound) parquet decode
+// memory instead of overshooting node limits on concurrent loads.
+
+// live arrow bytes held on behalf of payload readers (parquet decode)
+int64_t
+GetArrowReadPoolBytes();
+// live arrow bytes held on behalf of payload writers (builders, encoding)
+int64_t
+GetArrowWritePoolBytes();
+// high-water marks of the two pools since process start
+int64_t
+GetArrowReadPoolPeakBytes();
+int64_t
+GetArrowWritePoolPeakBytes();
+// combined ceiling for both pools; 0 disables the limit. Allocations past
+// the limit fail, surfacing as a CStatus error from the payload call
+void
+SetArrowPoolLimit(int64_t limit_bytes);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,31 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <cstring>
+
+#include "storage/IoMetrics.h"
+#include "storage/storage_metrics_c.h"
+
+// return value must be freed by the caller
+extern "C" char*
+GetStorageIoMetrics() {
+    auto snapshot = milvus::storage::IoMetrics::GetInstance().ToJson();
+    char* ret = reinterpret_cast<char*>(malloc(snapshot.length() + 1));
+    memcpy(ret, snapshot.c_str(), snapshot.length());
+    ret[snapshot.length()] = 0;
+    return ret;
+}
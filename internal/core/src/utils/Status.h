@@ -13,7 +13,9 @@
 
 #include "Error.h"
 
+#include <optional>
 #include <string>
+#include <utility>
 
 namespace milvus {
 
@@ -76,4 +78,41 @@ class Status {
     std::string state_;
 };  // Status
 
+// Expected-style carrier for execution paths that produce a value or fail
+// without unwinding: holds either a T or the Status explaining its absence.
+// Converts implicitly from both, so `return sub_result;` and
+// `return Status(code, msg);` both read naturally at the call sites.
+template <typename T>
+class StatusOr {
+ public:
+    StatusOr(T value) : value_(std::move(value)) {
+    }
+    StatusOr(Status status) : status_(std::move(status)) {
+    }
+
+    bool
+    ok() const {
+        return value_.has_value();
+    }
+
+    const Status&
+    status() const {
+        return status_;
+    }
+
+    T&
+    value() {
+        return value_.value();
+    }
+
+    const T&
+    value() const {
+        return value_.value();
+    }
+
+ private:
+    Status status_;
+    std::optional<T> value_;
+};  // StatusOr
+
 }  // namespace milvus
@@ -0,0 +1,209 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "common/BitsetUtils.h"
+#include "common/BitsetView.h"
+#include "common/Types.h"
+#include "perf_counters.h"
+
+using namespace milvus;
+
+namespace {
+
+// per-chunk result size in ExecExprVisitor's Assemble pattern: one chunk of
+// rows at the default chunk_rows
+constexpr int64_t kChunkBits = 32 * 1024;
+
+BitsetType
+make_random_bitset(int64_t size, uint64_t seed) {
+    BitsetType bitset;
+    bitset.resize(size);
+    std::default_random_engine er(seed);
+    auto blocks = BitsetBlocks(bitset);
+    auto num_blocks = (size + kBitsetBlockBits - 1) / kBitsetBlockBits;
+    for (int64_t i = 0; i < num_blocks; ++i) {
+        blocks[i] = (static_cast<uint64_t>(er()) << 32) | er();
+    }
+    // dynamic_bitset requires zero bits past size
+    if (auto rem = size & (kBitsetBlockBits - 1); rem != 0) {
+        blocks[num_blocks - 1] &= (uint64_t(1) << rem) - 1;
+    }
+    return bitset;
+}
+
+}  // namespace
+
+// whole-bitset logical ops as the boolean spine of an expression tree runs
+// them. arg: bits
+static void
+Bitset_And(benchmark::State& state) {
+    auto size = state.range(0);
+    auto dst = make_random_bitset(size, 42);
+    const auto src = make_random_bitset(size, 43);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        dst &= src;
+        benchmark::DoNotOptimize(BitsetBlocks(dst));
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * (size / 8));
+}
+
+static void
+Bitset_Or(benchmark::State& state) {
+    auto size = state.range(0);
+    auto dst = make_random_bitset(size, 42);
+    const auto src = make_random_bitset(size, 43);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        dst |= src;
+        benchmark::DoNotOptimize(BitsetBlocks(dst));
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * (size / 8));
+}
+
+static void
+Bitset_Flip(benchmark::State& state) {
+    auto size = state.range(0);
+    auto dst = make_random_bitset(size, 42);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        dst.flip();
+        benchmark::DoNotOptimize(BitsetBlocks(dst));
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * (size / 8));
+}
+
+static void
+Bitset_Count(benchmark::State& state) {
+    auto size = state.range(0);
+    const auto bitset = make_random_bitset(size, 42);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bitset.count());
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * (size / 8));
+}
+
+BENCHMARK(Bitset_And)->Arg(10'000)->Arg(1'000'000)->Arg(10'000'000)->Arg(100'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Bitset_Or)->Arg(10'000)->Arg(1'000'000)->Arg(10'000'000)->Arg(100'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Bitset_Flip)->Arg(10'000)->Arg(1'000'000)->Arg(10'000'000)->Arg(100'000'000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Bitset_Count)->Arg(10'000)->Arg(1'000'000)->Arg(10'000'000)->Arg(100'000'000)->Unit(benchmark::kMicrosecond);
+
+// LazyBitset's fused complement pass: NOT(a) AND b in a single block walk,
+// versus the flip-then-and two passes it replaces. Flipping dst before every
+// combine forces the masked path each iteration. arg: bits
+static void
+Bitset_LazyNotAnd(benchmark::State& state) {
+    auto size = state.range(0);
+    LazyBitset dst(make_random_bitset(size, 42));
+    LazyBitset src(make_random_bitset(size, 43));
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        dst.flip();
+        dst.logical_and(std::move(src));
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * (size / 8));
+}
+
+BENCHMARK(Bitset_LazyNotAnd)
+    ->Arg(10'000)
+    ->Arg(1'000'000)
+    ->Arg(10'000'000)
+    ->Arg(100'000'000)
+    ->Unit(benchmark::kMicrosecond);
+
+// stitching per-chunk results into one segment-wide bitset, exactly the
+// Assemble pattern: resize the destination, then AppendBitset chunk by
+// chunk at running bit offsets (not block-aligned for the tail schema).
+// arg: total bits
+static void
+Bitset_Assemble(benchmark::State& state) {
+    auto size = state.range(0);
+    std::vector<BitsetType> chunks;
+    for (int64_t done = 0; done < size; done += kChunkBits) {
+        auto chunk_size = std::min(kChunkBits, size - done);
+        chunks.push_back(make_random_bitset(chunk_size, 42 + done / kChunkBits));
+    }
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        BitsetType res;
+        res.resize(size);
+        int64_t counter = 0;
+        for (auto& chunk : chunks) {
+            AppendBitset(res, counter, chunk);
+            counter += chunk.size();
+        }
+        benchmark::DoNotOptimize(BitsetBlocks(res));
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * (size / 8));
+}
+
+BENCHMARK(Bitset_Assemble)->Arg(10'000)->Arg(1'000'000)->Arg(10'000'000)->Arg(100'000'000)->Unit(benchmark::kMicrosecond);
+
+// chunked subview walk the way SearchOnGrowing hands per-chunk masks to
+// knowhere, then a test() probe per bit as brute force does. subview only
+// supports byte-aligned offsets, so offset 8 is the finest misalignment
+// expressible: every chunk view starts off the 64-bit block grid.
+// args: bits, starting bit offset
+static void
+Bitset_SubviewScan(benchmark::State& state) {
+    auto size = state.range(0);
+    auto start = state.range(1);
+    const auto bitset = make_random_bitset(size, 42);
+    BitsetView view(bitset);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        int64_t hits = 0;
+        for (int64_t done = start; done < size; done += kChunkBits) {
+            auto chunk_size = std::min(kChunkBits, size - done);
+            auto sub_view = view.subview(done, chunk_size);
+            for (int64_t i = 0; i < chunk_size; ++i) {
+                hits += sub_view.test(i);
+            }
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * (size / 8));
+}
+
+BENCHMARK(Bitset_SubviewScan)
+    ->ArgsProduct({{1'000'000, 100'000'000}, {0, 8}})
+    ->Unit(benchmark::kMicrosecond);
+
+// BitsetType -> BitsetView handoff to knowhere. This must stay O(1): the
+// view aliases the bitset's blocks, and a replacement engine that forces a
+// copy here would show up as size-dependent time. arg: bits
+static void
+Bitset_ViewConversion(benchmark::State& state) {
+    auto size = state.range(0);
+    const auto bitset = make_random_bitset(size, 42);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        BitsetView view(bitset);
+        benchmark::DoNotOptimize(view);
+    }
+    counters.Report(state);
+}
+
+BENCHMARK(Bitset_ViewConversion)->Arg(10'000)->Arg(100'000'000);
@@ -0,0 +1,228 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "segcore/SegmentGrowing.h"
+#include "segcore/SegmentGrowingImpl.h"
+#include "test_utils/DataGen.h"
+#include "perf_counters.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int kDim = 128;
+
+enum PkKind {
+    kInt64Pk = 0,
+    kVarCharPk = 1,
+};
+
+SchemaPtr
+make_schema(int pk_kind) {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, kDim, knowhere::metric::L2);
+    auto pk = schema->AddDebugField("pk", pk_kind == kVarCharPk ? DataType::VARCHAR : DataType::INT64);
+    schema->set_primary_field_id(pk);
+    return schema;
+}
+
+// IdArray batches covering the segment's actual pks, in insert order, so
+// every delete hits a live row
+std::vector<std::shared_ptr<IdArray>>
+make_delete_batches(const GeneratedData& dataset, int pk_kind, int64_t batch_size) {
+    auto pk_fid = dataset.schema_->get_primary_field_id().value();
+    std::vector<std::shared_ptr<IdArray>> batches;
+    auto num_rows = dataset.raw_->num_rows();
+    if (pk_kind == kVarCharPk) {
+        auto pks = dataset.get_col<std::string>(pk_fid);
+        for (int64_t beg = 0; beg + batch_size <= num_rows; beg += batch_size) {
+            auto arr = std::make_unique<milvus::proto::schema::StringArray>();
+            for (int64_t i = beg; i < beg + batch_size; i++) {
+                arr->add_data(pks[i]);
+            }
+            auto ids = std::make_shared<IdArray>();
+            ids->set_allocated_str_id(arr.release());
+            batches.push_back(std::move(ids));
+        }
+    } else {
+        auto pks = dataset.get_col<int64_t>(pk_fid);
+        for (int64_t beg = 0; beg + batch_size <= num_rows; beg += batch_size) {
+            batches.push_back(GenPKs(pks.begin() + beg, pks.begin() + beg + batch_size));
+        }
+    }
+    return batches;
+}
+
+}  // namespace
+
+// delete ingestion rate: fresh segment per iteration, then PreDelete/Delete
+// over every row in batches. args: pk kind, batch size
+static void
+Delete_Ingest(benchmark::State& state) {
+    auto pk_kind = static_cast<int>(state.range(0));
+    auto batch_size = state.range(1);
+    constexpr int64_t N = 64 * 1024;
+
+    auto schema = make_schema(pk_kind);
+    const auto dataset = DataGen(schema, N);
+    const auto batches = make_delete_batches(dataset, pk_kind, batch_size);
+
+    int64_t deleted_rows = 0;
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto segment = CreateGrowingSegment(schema);
+        segment->disable_small_index();
+        auto offset = segment->PreInsert(N);
+        segment->Insert(offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+        state.ResumeTiming();
+
+        Timestamp del_ts = N;
+        for (auto& batch : batches) {
+            auto tss = GenTss(batch_size, del_ts);
+            del_ts += batch_size;
+            auto del_offset = segment->PreDelete(batch_size);
+            segment->Delete(del_offset, batch_size, batch.get(), tss.data());
+        }
+        deleted_rows += static_cast<int64_t>(batches.size()) * batch_size;
+
+        state.PauseTiming();
+        segment.reset();
+        state.ResumeTiming();
+    }
+    counters.Report(state);
+    state.SetItemsProcessed(deleted_rows);
+}
+
+BENCHMARK(Delete_Ingest)
+    ->ArgsProduct({{kInt64Pk, kVarCharPk}, {64, 1024, 8192}})
+    ->Unit(benchmark::kMillisecond);
+
+// query-time visibility mask build versus delete-log size. Alternating
+// timestamps defeat the single-entry visibility cache, so every call pays
+// the real bitmap construction. args: pk kind, deleted rows
+static void
+Delete_BitmapBuild(benchmark::State& state) {
+    auto pk_kind = static_cast<int>(state.range(0));
+    auto log_size = state.range(1);
+    constexpr int64_t N = 256 * 1024;
+
+    auto schema = make_schema(pk_kind);
+    const auto dataset = DataGen(schema, N);
+    auto segment = CreateGrowingSegment(schema);
+    segment->disable_small_index();
+    auto offset = segment->PreInsert(N);
+    segment->Insert(offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    const auto batches = make_delete_batches(dataset, pk_kind, log_size);
+    auto tss = GenTss(log_size, N);
+    auto del_offset = segment->PreDelete(log_size);
+    segment->Delete(del_offset, log_size, batches[0].get(), tss.data());
+
+    auto internal = dynamic_cast<SegmentInternalInterface*>(segment.get());
+    auto ins_barrier = internal->get_active_count(MAX_TIMESTAMP);
+    int64_t iteration = 0;
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        BitsetType bitset;
+        bitset.resize(ins_barrier, false);
+        Timestamp ts = N + log_size + (iteration++ & 1);
+        internal->mask_with_visibility(bitset, ins_barrier, ts);
+        benchmark::DoNotOptimize(bitset.count());
+    }
+    counters.Report(state);
+}
+
+BENCHMARK(Delete_BitmapBuild)
+    ->ArgsProduct({{kInt64Pk, kVarCharPk}, {1024, 16 * 1024, 128 * 1024}})
+    ->Unit(benchmark::kMicrosecond);
+
+// search latency on a segment under concurrent insert and delete load.
+// args: pk kind
+static void
+Delete_MixedInterference(benchmark::State& state) {
+    auto pk_kind = static_cast<int>(state.range(0));
+    constexpr int64_t N = 64 * 1024;
+    constexpr int64_t kBatch = 1024;
+
+    auto schema = make_schema(pk_kind);
+    const auto dataset = DataGen(schema, N);
+    auto segment = CreateGrowingSegment(schema);
+    segment->disable_small_index();
+    auto offset = segment->PreInsert(N);
+    segment->Insert(offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    std::string dsl = R"({
+        "bool": {
+            "vector": {
+                "fakevec": {
+                    "metric_type": "L2",
+                    "params": {"nprobe": 10},
+                    "query": "$0",
+                    "topk": 10,
+                    "round_decimal": -1
+                }
+            }
+        }
+    })";
+    auto plan = CreatePlan(*schema, dsl);
+    auto ph_group_raw = CreatePlaceholderGroup(10, kDim, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+
+    const auto delete_batches = make_delete_batches(dataset, pk_kind, kBatch);
+    std::atomic<bool> stop{false};
+
+    std::thread inserter([&] {
+        uint64_t seed = 1000;
+        while (!stop.load(std::memory_order_relaxed)) {
+            auto batch = DataGen(schema, kBatch, seed++, /*ts_offset=*/seed * kBatch);
+            auto ins_offset = segment->PreInsert(kBatch);
+            segment->Insert(ins_offset, kBatch, batch.row_ids_.data(), batch.timestamps_.data(), batch.raw_);
+        }
+    });
+    std::thread deleter([&] {
+        size_t i = 0;
+        Timestamp del_ts = N;
+        while (!stop.load(std::memory_order_relaxed)) {
+            auto& batch = delete_batches[i++ % delete_batches.size()];
+            auto tss = GenTss(kBatch, del_ts);
+            del_ts += kBatch;
+            auto del_offset = segment->PreDelete(kBatch);
+            segment->Delete(del_offset, kBatch, batch.get(), tss.data());
+        }
+    });
+
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        auto qr = segment->Search(plan.get(), ph_group.get(), MAX_TIMESTAMP);
+        benchmark::DoNotOptimize(qr);
+    }
+    counters.Report(state);
+
+    stop.store(true);
+    inserter.join();
+    deleter.join();
+}
+
+BENCHMARK(Delete_MixedInterference)
+    ->ArgsProduct({{kInt64Pk, kVarCharPk}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
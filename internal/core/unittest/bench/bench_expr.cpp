@@ -0,0 +1,276 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+#include <boost/format.hpp>
+#include <cstdint>
+#include <string>
+
+#include "query/generated/ExecExprVisitor.h"
+#include "segcore/SegmentGrowing.h"
+#include "segcore/SegmentSealed.h"
+#include "test_utils/DataGen.h"
+#include "perf_counters.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+static int dim = 16;
+static int64_t N = 1024 * 1024;
+
+const auto schema = []() {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->AddDebugField("height", DataType::INT32);
+    schema->AddDebugField("address", DataType::VARCHAR);
+    schema->set_primary_field_id(i64_fid);
+    return schema;
+}();
+
+const auto dataset_ = [] {
+    auto dataset_ = DataGen(schema, N);
+    return dataset_;
+}();
+
+// wraps a predicate in the minimal vector_anns plan so CreateSearchPlanByExpr
+// accepts it; only the predicate is evaluated by the benchmarks
+static std::unique_ptr<Plan>
+make_plan(const std::string& predicate) {
+    auto text_plan = boost::format(R"(vector_anns: <
+                                        field_id: %1%
+                                        predicates: <
+                                            %2%
+                                        >
+                                        query_info: <
+                                            topk: 10
+                                            round_decimal: -1
+                                            metric_type: "L2"
+                                            search_params: "{\"nprobe\": 10}"
+                                        >
+                                        placeholder_tag: "$0"
+     >)") % (*schema)[FieldName("fakevec")].get_id().get() %
+                     predicate;
+    auto binary_plan = translate_text_plan_to_binary_plan(text_plan.str().data());
+    return CreateSearchPlanByExpr(*schema, binary_plan.data(), binary_plan.size());
+}
+
+// "age" is sequential 0..N-1, so a GreaterEqual cutoff at pct% of N keeps
+// (100 - pct)% of the rows
+static std::string
+range_predicate(int64_t pct) {
+    auto cutoff = N * pct / 100;
+    return (boost::format(R"(unary_range_expr: <
+        column_info: <
+            field_id: %1%
+            data_type: Int64
+        >
+        op: GreaterEqual
+        value: <
+            int64_val: %2%
+        >
+    >)") % (*schema)[FieldName("age")].get_id().get() %
+            cutoff)
+        .str();
+}
+
+static std::string
+term_predicate() {
+    std::string values;
+    for (int i = 0; i < 10; ++i) {
+        values += (boost::format("values: < int64_val: %1% > ") % (i * 1000)).str();
+    }
+    return (boost::format(R"(term_expr: <
+        column_info: <
+            field_id: %1%
+            data_type: Int64
+        >
+        %2%
+    >)") % (*schema)[FieldName("age")].get_id().get() %
+            values)
+        .str();
+}
+
+static std::string
+compare_predicate() {
+    return (boost::format(R"(compare_expr: <
+        left_column_info: <
+            field_id: %1%
+            data_type: Int32
+        >
+        right_column_info: <
+            field_id: %2%
+            data_type: Int64
+        >
+        op: LessThan
+    >)") % (*schema)[FieldName("height")].get_id().get() %
+            (*schema)[FieldName("age")].get_id().get())
+        .str();
+}
+
+static std::string
+arith_predicate() {
+    return (boost::format(R"(binary_arith_op_eval_range_expr: <
+        column_info: <
+            field_id: %1%
+            data_type: Int64
+        >
+        arith_op: Add
+        right_operand: <
+            int64_val: 500
+        >
+        op: Equal
+        value: <
+            int64_val: 2000
+        >
+    >)") % (*schema)[FieldName("age")].get_id().get())
+        .str();
+}
+
+// "address" holds stringified random numbers, so a leading-digit cutoff gives
+// a roughly uniform selectivity sweep
+static std::string
+string_range_predicate() {
+    return (boost::format(R"(unary_range_expr: <
+        column_info: <
+            field_id: %1%
+            data_type: VarChar
+        >
+        op: GreaterEqual
+        value: <
+            string_val: "5"
+        >
+    >)") % (*schema)[FieldName("address")].get_id().get())
+        .str();
+}
+
+static SegmentGrowingPtr
+make_growing_segment(int64_t chunk_rows) {
+    auto segconf = SegcoreConfig::default_config();
+    segconf.set_chunk_rows(chunk_rows);
+    auto segment = CreateGrowingSegment(schema, -1, segconf);
+    segment->disable_small_index();
+    segment->PreInsert(N);
+    segment->Insert(0, N, dataset_.row_ids_.data(), dataset_.timestamps_.data(), dataset_.raw_);
+    return segment;
+}
+
+static void
+Expr_Range_Growing(benchmark::State& state) {
+    auto plan = make_plan(range_predicate(state.range(0)));
+    auto segment = make_growing_segment(state.range(1) * 1024);
+    ExecExprVisitor visitor(*segment, segment->get_row_count(), MAX_TIMESTAMP);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
+        benchmark::DoNotOptimize(final);
+    }
+    counters.Report(state);
+}
+
+// selectivity sweep crossed with chunk granularity
+BENCHMARK(Expr_Range_Growing)->MinTime(5)->ArgsProduct({{1, 50, 99}, {8, 32}});
+
+static void
+Expr_Range_Sealed(benchmark::State& state) {
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset_, *segment);
+    auto plan = make_plan(range_predicate(state.range(0)));
+    ExecExprVisitor visitor(*segment, segment->get_row_count(), MAX_TIMESTAMP);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
+        benchmark::DoNotOptimize(final);
+    }
+    counters.Report(state);
+}
+
+BENCHMARK(Expr_Range_Sealed)->MinTime(5)->Arg(1)->Arg(50)->Arg(99);
+
+static void
+Expr_Term_Sealed(benchmark::State& state) {
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset_, *segment);
+    auto plan = make_plan(term_predicate());
+    ExecExprVisitor visitor(*segment, segment->get_row_count(), MAX_TIMESTAMP);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
+        benchmark::DoNotOptimize(final);
+    }
+    counters.Report(state);
+}
+
+BENCHMARK(Expr_Term_Sealed)->MinTime(5);
+
+static void
+Expr_Compare_Sealed(benchmark::State& state) {
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset_, *segment);
+    auto plan = make_plan(compare_predicate());
+    ExecExprVisitor visitor(*segment, segment->get_row_count(), MAX_TIMESTAMP);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
+        benchmark::DoNotOptimize(final);
+    }
+    counters.Report(state);
+}
+
+BENCHMARK(Expr_Compare_Sealed)->MinTime(5);
+
+static void
+Expr_Arith_Sealed(benchmark::State& state) {
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset_, *segment);
+    auto plan = make_plan(arith_predicate());
+    ExecExprVisitor visitor(*segment, segment->get_row_count(), MAX_TIMESTAMP);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
+        benchmark::DoNotOptimize(final);
+    }
+    counters.Report(state);
+}
+
+BENCHMARK(Expr_Arith_Sealed)->MinTime(5);
+
+static void
+Expr_StringRange_Growing(benchmark::State& state) {
+    auto plan = make_plan(string_range_predicate());
+    auto segment = make_growing_segment(32 * 1024);
+    ExecExprVisitor visitor(*segment, segment->get_row_count(), MAX_TIMESTAMP);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
+        benchmark::DoNotOptimize(final);
+    }
+    counters.Report(state);
+}
+
+BENCHMARK(Expr_StringRange_Growing)->MinTime(5);
+
+static void
+Expr_StringRange_Sealed(benchmark::State& state) {
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset_, *segment);
+    auto plan = make_plan(string_range_predicate());
+    ExecExprVisitor visitor(*segment, segment->get_row_count(), MAX_TIMESTAMP);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        auto final = visitor.call_child(*plan->plan_node_->predicate_.value());
+        benchmark::DoNotOptimize(final);
+    }
+    counters.Report(state);
+}
+
+BENCHMARK(Expr_StringRange_Sealed)->MinTime(5);
@@ -0,0 +1,210 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "segcore/SegmentGrowing.h"
+#include "segcore/SegmentGrowingImpl.h"
+#include "test_utils/DataGen.h"
+#include "perf_counters.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+// allocation counter for the whole binary: the insert path's per-row cost is
+// dominated by what it allocates, so regressions show up here before they
+// show up in rows/sec
+static std::atomic<int64_t> g_alloc_count{0};
+
+void*
+operator new(std::size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void
+operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace {
+
+enum SchemaKind {
+    kVec128 = 0,
+    kVec768 = 1,
+    kVec1536 = 2,
+    kWideScalar = 3,
+    kVarChar = 4,
+};
+
+SchemaPtr
+make_schema(int kind) {
+    auto schema = std::make_shared<Schema>();
+    switch (kind) {
+        case kVec128:
+        case kVec768:
+        case kVec1536: {
+            int dim = kind == kVec128 ? 128 : kind == kVec768 ? 768 : 1536;
+            schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+            break;
+        }
+        case kWideScalar: {
+            // wide scalar mix: the per-row fan-out across many narrow
+            // columns stresses the laned ingest rather than memcpy width
+            for (int i = 0; i < 4; ++i) {
+                schema->AddDebugField("i32_" + std::to_string(i), DataType::INT32);
+                schema->AddDebugField("f32_" + std::to_string(i), DataType::FLOAT);
+                schema->AddDebugField("f64_" + std::to_string(i), DataType::DOUBLE);
+            }
+            break;
+        }
+        case kVarChar: {
+            schema->AddDebugField("str", DataType::VARCHAR);
+            break;
+        }
+    }
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    return schema;
+}
+
+// pre-generated batches are claimed round-robin by the writer threads, so
+// the timed region contains only PreInsert/Insert
+struct InsertWorkload {
+    SchemaPtr schema;
+    std::vector<GeneratedData> batches;
+    int64_t batch_rows;
+};
+
+InsertWorkload
+make_workload(int schema_kind, int64_t total_rows, int64_t batch_rows) {
+    InsertWorkload workload;
+    workload.schema = make_schema(schema_kind);
+    workload.batch_rows = batch_rows;
+    auto num_batches = total_rows / batch_rows;
+    workload.batches.reserve(num_batches);
+    for (int64_t i = 0; i < num_batches; ++i) {
+        workload.batches.push_back(DataGen(workload.schema, batch_rows, /*seed=*/42 + i, /*ts_offset=*/i * batch_rows));
+    }
+    return workload;
+}
+
+}  // namespace
+
+// args: schema kind, writer threads, batch rows, chunk rows
+static void
+Insert_Growing(benchmark::State& state) {
+    auto schema_kind = static_cast<int>(state.range(0));
+    auto num_threads = static_cast<int>(state.range(1));
+    auto batch_rows = state.range(2);
+    auto chunk_rows = state.range(3);
+
+    // enough batches that every thread stays busy, independent of sweep point
+    const int64_t total_rows = 64 * 1024;
+    static std::map<std::pair<int, int64_t>, InsertWorkload> workload_cache;
+    auto key = std::make_pair(schema_kind, batch_rows);
+    if (workload_cache.count(key) == 0) {
+        workload_cache.emplace(key, make_workload(schema_kind, total_rows, batch_rows));
+    }
+    auto& workload = workload_cache.at(key);
+
+    auto conf = SegcoreConfig::default_config();
+    conf.set_chunk_rows(chunk_rows);
+
+    int64_t inserted_rows = 0;
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto segment = CreateGrowingSegment(workload.schema, -1, conf);
+        segment->disable_small_index();
+        std::atomic<size_t> next_batch{0};
+        auto alloc_before = g_alloc_count.load(std::memory_order_relaxed);
+        state.ResumeTiming();
+
+        auto writer = [&] {
+            while (true) {
+                auto i = next_batch.fetch_add(1, std::memory_order_relaxed);
+                if (i >= workload.batches.size()) {
+                    return;
+                }
+                auto& batch = workload.batches[i];
+                auto offset = segment->PreInsert(workload.batch_rows);
+                segment->Insert(offset, workload.batch_rows, batch.row_ids_.data(), batch.timestamps_.data(),
+                                batch.raw_);
+            }
+        };
+        if (num_threads == 1) {
+            writer();
+        } else {
+            std::vector<std::thread> threads;
+            threads.reserve(num_threads);
+            for (int t = 0; t < num_threads; ++t) {
+                threads.emplace_back(writer);
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        auto rows = static_cast<int64_t>(workload.batches.size()) * workload.batch_rows;
+        inserted_rows += rows;
+        state.counters["allocs_per_row"] =
+            static_cast<double>(g_alloc_count.load(std::memory_order_relaxed) - alloc_before) / rows;
+
+        // destruction is part of neither ingest nor the measurement
+        state.PauseTiming();
+        segment.reset();
+        state.ResumeTiming();
+    }
+    counters.Report(state);
+    state.SetItemsProcessed(inserted_rows);
+}
+
+// thread sweep on the default-ish vector schema
+BENCHMARK(Insert_Growing)
+    ->ArgsProduct({{kVec128}, {1, 2, 4, 8}, {1024}, {32 * 1024}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// batch size sweep: small batches stress PreInsert/ack overhead, large ones
+// stress the chunk fill
+BENCHMARK(Insert_Growing)
+    ->ArgsProduct({{kVec128}, {4}, {128, 1024, 8192}, {32 * 1024}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// field mixes: vector widths, a wide scalar schema and VarChar
+BENCHMARK(Insert_Growing)
+    ->ArgsProduct({{kVec128, kVec768, kVec1536, kWideScalar, kVarChar}, {4}, {1024}, {32 * 1024}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// chunk size sweep
+BENCHMARK(Insert_Growing)
+    ->ArgsProduct({{kVec768}, {4}, {1024}, {8 * 1024, 32 * 1024, 128 * 1024}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
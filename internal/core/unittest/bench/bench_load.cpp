@@ -0,0 +1,277 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "segcore/SegmentSealed.h"
+#include "segcore/SegmentSealedImpl.h"
+#include "test_utils/DataGen.h"
+#include "test_utils/SyntheticChunkManager.h"
+#include "perf_counters.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+namespace {
+
+enum SchemaKind {
+    kVec128 = 0,
+    kVec768Scalars = 1,
+    kVarCharHeavy = 2,
+};
+
+// fetch cost model applied by the synthetic chunk manager
+enum IoProfile {
+    kInstant = 0,      // free reads: isolates parse + LoadFieldData CPU
+    kSsd = 1,          // 100us, 2 GB/s
+    kObjectStore = 2,  // 20ms, 200 MB/s
+};
+
+std::pair<int64_t, int64_t>
+io_profile_params(int profile) {
+    switch (profile) {
+        case kSsd:
+            return {100, 2'000'000'000};
+        case kObjectStore:
+            return {20'000, 200'000'000};
+        default:
+            return {0, 0};
+    }
+}
+
+SchemaPtr
+make_schema(int kind) {
+    auto schema = std::make_shared<Schema>();
+    switch (kind) {
+        case kVec768Scalars:
+            schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 768, knowhere::metric::L2);
+            schema->AddDebugField("counter", DataType::INT64);
+            schema->AddDebugField("double", DataType::DOUBLE);
+            break;
+        case kVarCharHeavy:
+            schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 128, knowhere::metric::L2);
+            schema->AddDebugField("str0", DataType::VARCHAR);
+            schema->AddDebugField("str1", DataType::VARCHAR);
+            break;
+        default:
+            schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 128, knowhere::metric::L2);
+            break;
+    }
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    return schema;
+}
+
+// the serialized "remote" form of one segment: every field (system fields
+// included) as the proto blob the load path receives
+struct LoadWorkload {
+    SchemaPtr schema;
+    GeneratedData dataset;
+    std::vector<std::pair<int64_t, std::string>> blobs;  // field_id -> bytes
+    int64_t payload_bytes = 0;
+    int dim = 0;
+    knowhere::VecIndexPtr vec_index;  // built on first use
+};
+
+LoadWorkload
+make_workload(int schema_kind, int64_t rows) {
+    LoadWorkload workload;
+    workload.schema = make_schema(schema_kind);
+    workload.dim = schema_kind == kVec768Scalars ? 768 : 128;
+    workload.dataset = DataGen(workload.schema, rows);
+    {
+        FieldMeta field_meta(FieldName("RowID"), RowFieldID, DataType::INT64);
+        auto array = CreateScalarDataArrayFrom(workload.dataset.row_ids_.data(), rows, field_meta);
+        workload.blobs.emplace_back(RowFieldID.get(), array->SerializeAsString());
+    }
+    {
+        FieldMeta field_meta(FieldName("Timestamp"), TimestampFieldID, DataType::INT64);
+        auto array = CreateScalarDataArrayFrom(workload.dataset.timestamps_.data(), rows, field_meta);
+        workload.blobs.emplace_back(TimestampFieldID.get(), array->SerializeAsString());
+    }
+    for (auto& field_data : workload.dataset.raw_->fields_data()) {
+        workload.blobs.emplace_back(field_data.field_id(), field_data.SerializeAsString());
+    }
+    for (auto& [field_id, bytes] : workload.blobs) {
+        workload.payload_bytes += static_cast<int64_t>(bytes.size());
+    }
+    return workload;
+}
+
+LoadWorkload&
+cached_workload(int schema_kind, int64_t rows) {
+    static std::map<std::pair<int, int64_t>, LoadWorkload> cache;
+    auto key = std::make_pair(schema_kind, rows);
+    if (cache.count(key) == 0) {
+        cache.emplace(key, make_workload(schema_kind, rows));
+    }
+    return cache.at(key);
+}
+
+std::string
+blob_path(int64_t field_id) {
+    return "synthetic/field_" + std::to_string(field_id);
+}
+
+// current resident set, for the peak-memory-per-payload-byte counter
+int64_t
+read_vm_rss_bytes() {
+    auto file = std::fopen("/proc/self/status", "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    int64_t rss_kb = 0;
+    char line[256];
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        if (std::sscanf(line, "VmRSS: %ld kB", &rss_kb) == 1) {
+            break;
+        }
+    }
+    std::fclose(file);
+    return rss_kb * 1024;
+}
+
+}  // namespace
+
+// end-to-end sealed load: fetch every field blob through the synthetic
+// chunk manager, parse, LoadFieldData (or LoadIndex for the vector field),
+// then run the first search. The iteration time is time-to-queryable.
+// args: schema kind, rows, io profile, use vector index
+static void
+Load_Sealed(benchmark::State& state) {
+    auto schema_kind = static_cast<int>(state.range(0));
+    auto rows = state.range(1);
+    auto [latency_us, bandwidth_bps] = io_profile_params(static_cast<int>(state.range(2)));
+    bool use_index = state.range(3) != 0;
+
+    auto& workload = cached_workload(schema_kind, rows);
+    auto vec_fid = workload.schema->get_field_id(FieldName("fakevec"));
+    if (use_index && workload.vec_index == nullptr) {
+        auto fakevec = workload.dataset.get_col<float>(vec_fid);
+        workload.vec_index = GenVecIndexing(rows, workload.dim, fakevec.data());
+    }
+
+    storage::SyntheticChunkManager cm(latency_us, bandwidth_bps);
+    int64_t staged_bytes = 0;
+    for (auto& [field_id, bytes] : workload.blobs) {
+        if (use_index && field_id == vec_fid.get()) {
+            continue;
+        }
+        cm.Write(blob_path(field_id), const_cast<char*>(bytes.data()), bytes.size());
+        staged_bytes += static_cast<int64_t>(bytes.size());
+    }
+
+    std::string dsl = R"({
+        "bool": {
+            "vector": {
+                "fakevec": {
+                    "metric_type": "L2",
+                    "params": {"nprobe": 10},
+                    "query": "$0",
+                    "topk": 10,
+                    "round_decimal": -1
+                }
+            }
+        }
+    })";
+    auto plan = CreatePlan(*workload.schema, dsl);
+    auto ph_group_raw = CreatePlaceholderGroup(5, workload.dim, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+
+    std::vector<char> scratch;
+    double max_rss_delta = 0;
+    int64_t iterations = 0;
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto segment = CreateSealedSegment(workload.schema);
+        auto rss_before = read_vm_rss_bytes();
+        state.ResumeTiming();
+
+        for (auto& [field_id, bytes] : workload.blobs) {
+            if (use_index && field_id == vec_fid.get()) {
+                continue;
+            }
+            auto path = blob_path(field_id);
+            auto len = cm.Size(path);
+            scratch.resize(len);
+            cm.Read(path, scratch.data(), len);
+
+            auto array = std::make_shared<DataArray>();
+            AssertInfo(array->ParseFromArray(scratch.data(), len), "blob parse failed");
+            LoadFieldDataInfo info;
+            info.field_id = field_id;
+            info.field_data = array.get();
+            info.row_count = rows;
+            info.owned_data = array;
+            segment->LoadFieldData(info);
+        }
+        if (use_index) {
+            LoadIndexInfo index_info;
+            index_info.field_id = vec_fid.get();
+            index_info.index = workload.vec_index;
+            index_info.index_params["metric_type"] = knowhere::metric::L2;
+            segment->LoadIndex(index_info);
+        }
+        auto sr = segment->Search(plan.get(), ph_group.get(), MAX_TIMESTAMP);
+        benchmark::DoNotOptimize(sr);
+
+        auto rss_after = read_vm_rss_bytes();
+        max_rss_delta = std::max(max_rss_delta, static_cast<double>(rss_after - rss_before));
+        iterations++;
+
+        state.PauseTiming();
+        segment.reset();
+        state.ResumeTiming();
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(iterations * staged_bytes);
+    state.counters["payload_mb"] = static_cast<double>(staged_bytes) / (1 << 20);
+    state.counters["rss_peak_delta_mb"] = max_rss_delta / (1 << 20);
+    // >1 means the load path re-reads bytes it already fetched
+    state.counters["fetched_per_payload_byte"] =
+        static_cast<double>(cm.TotalBytesRead()) / (static_cast<double>(staged_bytes) * iterations);
+}
+
+// row-count sweep on the small vector schema
+BENCHMARK(Load_Sealed)
+    ->ArgsProduct({{kVec128}, {16 * 1024, 64 * 1024, 256 * 1024}, {kInstant}, {0}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// schema sweep: wide vectors with scalars and a VarChar-heavy mix
+BENCHMARK(Load_Sealed)
+    ->ArgsProduct({{kVec128, kVec768Scalars, kVarCharHeavy}, {64 * 1024}, {kInstant}, {0}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// fetch cost sweep: the gap between kInstant and the throttled profiles is
+// the headroom a pipelined loader could reclaim
+BENCHMARK(Load_Sealed)
+    ->ArgsProduct({{kVec128}, {64 * 1024}, {kInstant, kSsd, kObjectStore}, {0}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// index instead of raw vectors
+BENCHMARK(Load_Sealed)
+    ->ArgsProduct({{kVec128}, {64 * 1024}, {kInstant}, {1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
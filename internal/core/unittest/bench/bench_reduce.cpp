@@ -0,0 +1,148 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+#include <boost/format.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "segcore/SegmentGrowing.h"
+#include "segcore/reduce_c.h"
+#include "test_utils/DataGen.h"
+#include "perf_counters.h"
+
+using namespace milvus;
+using namespace milvus::query;
+using namespace milvus::segcore;
+
+static int dim = 16;
+static int64_t N = 4096;
+
+const auto schema = []() {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    return schema;
+}();
+
+static std::unique_ptr<Plan>
+make_plan(int64_t topk) {
+    auto dsl = boost::format(R"({
+        "bool": {
+            "vector": {
+                "fakevec": {
+                    "metric_type": "L2",
+                    "params": {
+                        "nprobe": 10
+                    },
+                    "query": "$0",
+                    "topk": %1%,
+                    "round_decimal": -1
+                }
+            }
+        }
+    })") % topk;
+    return CreatePlan(*schema, dsl.str());
+}
+
+// one searched result per segment; with distinct_pks every segment gets its
+// own pk range, otherwise all segments share pks 0..N-1 and the reduce
+// dedupes the whole fanout down to one segment's worth of hits
+struct ReduceInputs {
+    std::vector<SegmentGrowingPtr> segments;
+    std::vector<SearchResult> master_results;
+
+    ReduceInputs(Plan* plan, const PlaceholderGroup* ph_group, int64_t num_segments, bool distinct_pks) {
+        auto dataset_ = DataGen(schema, N);
+        auto pk_fid = schema->get_primary_field_id().value();
+        for (int64_t i = 0; i < num_segments; ++i) {
+            auto patched = *dataset_.raw_;
+            if (distinct_pks && i > 0) {
+                for (auto& field : *patched.mutable_fields_data()) {
+                    if (field.field_id() == pk_fid.get()) {
+                        for (auto& pk : *field.mutable_scalars()->mutable_long_data()->mutable_data()) {
+                            pk += i * N;
+                        }
+                    }
+                }
+            }
+            auto segment = CreateGrowingSegment(schema, -1);
+            segment->disable_small_index();
+            segment->PreInsert(N);
+            segment->Insert(0, N, dataset_.row_ids_.data(), dataset_.timestamps_.data(), &patched);
+            auto result = segment->Search(plan, ph_group, MAX_TIMESTAMP);
+            master_results.emplace_back(*result);
+            segments.emplace_back(std::move(segment));
+        }
+    }
+};
+
+// the reduce mutates its inputs, so every iteration works on a fresh copy of
+// the searched results; the copy runs outside the timed region
+static void
+run_reduce(benchmark::State& state, Plan* plan, ReduceInputs& inputs, int64_t nq, int64_t topk) {
+    auto num_segments = static_cast<int64_t>(inputs.master_results.size());
+    std::vector<int64_t> slice_nqs{nq};
+    std::vector<int64_t> slice_topKs{topk};
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto results = inputs.master_results;
+        std::vector<CSearchResult> c_results;
+        c_results.reserve(num_segments);
+        for (auto& result : results) {
+            c_results.push_back(&result);
+        }
+        state.ResumeTiming();
+
+        CSearchResultDataBlobs blobs;
+        auto status = ReduceSearchResultsAndFillData(&blobs, plan, c_results.data(), num_segments, slice_nqs.data(),
+                                                     slice_topKs.data(), slice_nqs.size());
+        AssertInfo(status.error_code == Success, "reduce failed");
+        CProto blob;
+        status = GetSearchResultDataBlob(&blob, blobs, 0);
+        AssertInfo(status.error_code == Success, "get blob failed");
+        benchmark::DoNotOptimize(blob);
+        DeleteSearchResultDataBlobs(blobs);
+    }
+    counters.Report(state);
+}
+
+static void
+Reduce_Segments(benchmark::State& state) {
+    int64_t nq = 10;
+    int64_t topk = 10;
+    auto plan = make_plan(topk);
+    auto ph_group_raw = CreatePlaceholderGroup(nq, dim, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    ReduceInputs inputs(plan.get(), ph_group.get(), state.range(0), state.range(1));
+    run_reduce(state, plan.get(), inputs, nq, topk);
+}
+
+// fanout sweep, crossed with fully-duplicated vs disjoint pks across segments
+BENCHMARK(Reduce_Segments)->MinTime(5)->ArgsProduct({{1, 16, 64, 256}, {false, true}});
+
+static void
+Reduce_NqTopk(benchmark::State& state) {
+    int64_t num_segments = 4;
+    auto nq = state.range(0);
+    auto topk = state.range(1);
+    auto plan = make_plan(topk);
+    auto ph_group_raw = CreatePlaceholderGroup(nq, dim, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    ReduceInputs inputs(plan.get(), ph_group.get(), num_segments, true);
+    run_reduce(state, plan.get(), inputs, nq, topk);
+}
+
+BENCHMARK(Reduce_NqTopk)->MinTime(5)->ArgsProduct({{1, 100, 1000}, {1, 100, 1000}});
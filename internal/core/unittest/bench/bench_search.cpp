@@ -15,6 +15,7 @@
 #include "segcore/SegmentGrowing.h"
 #include "segcore/SegmentSealed.h"
 #include "test_utils/DataGen.h"
+#include "perf_counters.h"
 
 using namespace milvus;
 using namespace milvus::query;
@@ -83,9 +84,11 @@ Search_SmallIndex(benchmark::State& state) {
 
     Timestamp time = 10000000;
 
+    milvus::bench::PerfCounters counters;
     for (auto _ : state) {
         auto qr = segment->Search(plan.get(), ph_group.get(), time);
     }
+    counters.Report(state);
 }
 
 BENCHMARK(Search_SmallIndex)->MinTime(5)->ArgsProduct({{true, false}, {8, 16, 32}});
@@ -116,9 +119,11 @@ Search_Sealed(benchmark::State& state) {
         segment->LoadIndex(info);
     }
     Timestamp time = 10000000;
+    milvus::bench::PerfCounters counters;
     for (auto _ : state) {
         auto qr = segment->Search(plan.get(), ph_group.get(), time);
     }
+    counters.Report(state);
 }
 
 BENCHMARK(Search_Sealed)->MinTime(5)->Arg(1)->Arg(0);
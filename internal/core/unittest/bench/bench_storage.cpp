@@ -0,0 +1,223 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "storage/DataCodec.h"
+#include "storage/InsertData.h"
+#include "storage/PayloadReader.h"
+#include "storage/PayloadWriter.h"
+#include "perf_counters.h"
+
+using namespace milvus;
+
+static int64_t N = 64 * 1024;
+
+static std::vector<int64_t>
+gen_int64_col() {
+    std::vector<int64_t> data(N);
+    std::default_random_engine er(42);
+    for (auto& x : data) {
+        x = er();
+    }
+    return data;
+}
+
+static std::vector<float>
+gen_vector_col(int dim) {
+    std::vector<float> data(N * dim);
+    std::default_random_engine er(42);
+    std::normal_distribution<float> distr(0, 1);
+    for (auto& x : data) {
+        x = distr(er);
+    }
+    return data;
+}
+
+static std::vector<std::string>
+gen_varchar_col(int str_len) {
+    std::vector<std::string> data(N);
+    std::default_random_engine er(42);
+    for (auto& x : data) {
+        x.resize(str_len);
+        for (auto& c : x) {
+            c = 'a' + er() % 26;
+        }
+    }
+    return data;
+}
+
+static void
+Payload_Write_Int64(benchmark::State& state) {
+    auto data = gen_int64_col();
+    storage::Payload payload{storage::DataType::INT64, reinterpret_cast<const uint8_t*>(data.data()), int(N)};
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        storage::PayloadWriter writer(storage::DataType::INT64);
+        writer.add_payload(payload);
+        writer.finish();
+        benchmark::DoNotOptimize(writer.get_payload_buffer());
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * N * sizeof(int64_t));
+}
+
+BENCHMARK(Payload_Write_Int64)->MinTime(5);
+
+static void
+Payload_Write_VectorFloat(benchmark::State& state) {
+    int dim = state.range(0);
+    auto data = gen_vector_col(dim);
+    storage::Payload payload{storage::DataType::VECTOR_FLOAT, reinterpret_cast<const uint8_t*>(data.data()), int(N),
+                             dim};
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        storage::PayloadWriter writer(storage::DataType::VECTOR_FLOAT, dim);
+        writer.add_payload(payload);
+        writer.finish();
+        benchmark::DoNotOptimize(writer.get_payload_buffer());
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * N * dim * sizeof(float));
+}
+
+BENCHMARK(Payload_Write_VectorFloat)->MinTime(5)->Arg(128)->Arg(768)->Arg(1536);
+
+static void
+Payload_Write_VarChar(benchmark::State& state) {
+    int str_len = state.range(0);
+    auto data = gen_varchar_col(str_len);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        storage::PayloadWriter writer(storage::DataType::VARCHAR);
+        for (auto& str : data) {
+            writer.add_one_string_payload(str.c_str(), str.size());
+        }
+        writer.finish();
+        benchmark::DoNotOptimize(writer.get_payload_buffer());
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * N * str_len);
+}
+
+// short identifier-like strings vs document-sized ones
+BENCHMARK(Payload_Write_VarChar)->MinTime(5)->Arg(16)->Arg(256);
+
+static std::vector<uint8_t>
+serialize_payload(storage::DataType data_type, const storage::Payload& payload) {
+    storage::PayloadWriter writer =
+        payload.dimension.has_value() ? storage::PayloadWriter(data_type, payload.dimension.value())
+                                      : storage::PayloadWriter(data_type);
+    writer.add_payload(payload);
+    writer.finish();
+    return writer.get_payload_buffer();
+}
+
+static void
+Payload_Read_Int64(benchmark::State& state) {
+    auto data = gen_int64_col();
+    storage::Payload payload{storage::DataType::INT64, reinterpret_cast<const uint8_t*>(data.data()), int(N)};
+    auto bytes = serialize_payload(storage::DataType::INT64, payload);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        storage::PayloadReader reader(bytes.data(), bytes.size(), storage::DataType::INT64);
+        benchmark::DoNotOptimize(reader.get_payload());
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * N * sizeof(int64_t));
+}
+
+BENCHMARK(Payload_Read_Int64)->MinTime(5);
+
+static void
+Payload_Read_VectorFloat(benchmark::State& state) {
+    int dim = state.range(0);
+    auto data = gen_vector_col(dim);
+    storage::Payload payload{storage::DataType::VECTOR_FLOAT, reinterpret_cast<const uint8_t*>(data.data()), int(N),
+                             dim};
+    auto bytes = serialize_payload(storage::DataType::VECTOR_FLOAT, payload);
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        storage::PayloadReader reader(bytes.data(), bytes.size(), storage::DataType::VECTOR_FLOAT);
+        benchmark::DoNotOptimize(reader.get_payload());
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * N * dim * sizeof(float));
+}
+
+BENCHMARK(Payload_Read_VectorFloat)->MinTime(5)->Arg(128)->Arg(768)->Arg(1536);
+
+static void
+Payload_Read_VarChar(benchmark::State& state) {
+    int str_len = state.range(0);
+    auto data = gen_varchar_col(str_len);
+    std::vector<uint8_t> bytes = [&] {
+        storage::PayloadWriter writer(storage::DataType::VARCHAR);
+        for (auto& str : data) {
+            writer.add_one_string_payload(str.c_str(), str.size());
+        }
+        writer.finish();
+        return writer.get_payload_buffer();
+    }();
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        storage::PayloadReader reader(bytes.data(), bytes.size(), storage::DataType::VARCHAR);
+        benchmark::DoNotOptimize(reader.get_field_data());
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * N * str_len);
+}
+
+BENCHMARK(Payload_Read_VarChar)->MinTime(5)->Arg(16)->Arg(256);
+
+// full DataCodec path: InsertData serialize with event framing plus
+// DeserializeFileData back into a payload
+static void
+run_codec_round_trip(benchmark::State& state, const storage::Payload& payload, int64_t raw_bytes) {
+    milvus::bench::PerfCounters counters;
+    for (auto _ : state) {
+        auto field_data = std::make_shared<storage::FieldData>(payload);
+        storage::InsertData insert_data(field_data);
+        storage::FieldDataMeta field_data_meta{100, 101, 102, 103};
+        insert_data.SetFieldDataMeta(field_data_meta);
+        insert_data.SetTimestamps(0, 100);
+        auto serialized_bytes = insert_data.Serialize(storage::StorageType::Remote);
+        auto new_insert_data = storage::DeserializeFileData(
+            reinterpret_cast<const uint8_t*>(serialized_bytes.data()), serialized_bytes.size());
+        benchmark::DoNotOptimize(new_insert_data);
+    }
+    counters.Report(state);
+    state.SetBytesProcessed(state.iterations() * raw_bytes);
+}
+
+static void
+Codec_RoundTrip_Int64(benchmark::State& state) {
+    auto data = gen_int64_col();
+    storage::Payload payload{storage::DataType::INT64, reinterpret_cast<const uint8_t*>(data.data()), int(N)};
+    run_codec_round_trip(state, payload, N * sizeof(int64_t));
+}
+
+BENCHMARK(Codec_RoundTrip_Int64)->MinTime(5);
+
+static void
+Codec_RoundTrip_VectorFloat(benchmark::State& state) {
+    int dim = state.range(0);
+    auto data = gen_vector_col(dim);
+    storage::Payload payload{storage::DataType::VECTOR_FLOAT, reinterpret_cast<const uint8_t*>(data.data()), int(N),
+                             dim};
+    run_codec_round_trip(state, payload, int64_t(N) * dim * sizeof(float));
+}
+
+BENCHMARK(Codec_RoundTrip_VectorFloat)->MinTime(5)->Arg(128)->Arg(768)->Arg(1536);
@@ -0,0 +1,120 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#if defined(MILVUS_BENCH_PERF_COUNTERS)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstring>
+#endif
+
+namespace milvus::bench {
+
+// Samples a fixed set of hardware counters around the timed loop and
+// registers the per-iteration averages as custom google-benchmark counters
+// (cycles, instrs, llc_miss, dtlb_miss), so a regression report shows
+// whether the time went into cache misses, TLB walks, or plain extra work.
+//
+// Construct before the `for (auto _ : state)` loop and call Report(state)
+// after it:
+//
+//     PerfCounters counters;
+//     for (auto _ : state) { ... }
+//     counters.Report(state);
+//
+// Counting is per calling thread (threads spawned after construction are
+// inherited); events the kernel or hardware refuse to open — hardened
+// perf_event_paranoid, VMs without a PMU — are skipped silently so the
+// benches keep running anywhere. Off Linux the class is a no-op.
+class PerfCounters {
+#if defined(MILVUS_BENCH_PERF_COUNTERS)
+ public:
+    PerfCounters() {
+        fds_[0] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        fds_[1] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fds_[2] = open_counter(PERF_TYPE_HW_CACHE, cache_config(PERF_COUNT_HW_CACHE_LL));
+        fds_[3] = open_counter(PERF_TYPE_HW_CACHE, cache_config(PERF_COUNT_HW_CACHE_DTLB));
+        for (auto fd : fds_) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    ~PerfCounters() {
+        for (auto fd : fds_) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters&
+    operator=(const PerfCounters&) = delete;
+
+    void
+    Report(benchmark::State& state) {
+        static const char* names[kNumEvents] = {"cycles", "instrs", "llc_miss", "dtlb_miss"};
+        for (size_t i = 0; i < kNumEvents; ++i) {
+            if (fds_[i] < 0) {
+                continue;
+            }
+            ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t value = 0;
+            if (read(fds_[i], &value, sizeof(value)) == sizeof(value)) {
+                // kAvgIterations divides by the iteration count at report time
+                state.counters[names[i]] =
+                    benchmark::Counter(static_cast<double>(value), benchmark::Counter::kAvgIterations);
+            }
+        }
+    }
+
+ private:
+    static constexpr size_t kNumEvents = 4;
+
+    static int
+    open_counter(uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.inherit = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static constexpr uint64_t
+    cache_config(uint64_t cache_id) {
+        return cache_id | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+    int fds_[kNumEvents] = {-1, -1, -1, -1};
+#else
+ public:
+    void
+    Report(benchmark::State&) {
+    }
+#endif
+};
+
+}  // namespace milvus::bench
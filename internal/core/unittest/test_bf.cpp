@@ -114,10 +114,15 @@ class TestFloatSearchBruteForce : public ::testing::Test {
 
         dataset::SearchDataset dataset{metric_type, nq, topk, -1, dim, query.data()};
         if (!is_supported_float_metric(metric_type)) {
-            ASSERT_ANY_THROW(BruteForceSearch(dataset, base.data(), nb, bitset_view));
+            // an unsupported metric is a status now, not an unwind
+            auto bad = BruteForceSearch(dataset, base.data(), nb, bitset_view);
+            ASSERT_FALSE(bad.ok());
+            ASSERT_NE(bad.status().code(), 0);
             return;
         }
-        auto result = BruteForceSearch(dataset, base.data(), nb, bitset_view);
+        auto sub_qr = BruteForceSearch(dataset, base.data(), nb, bitset_view);
+        ASSERT_TRUE(sub_qr.ok()) << sub_qr.status().ToString();
+        auto& result = sub_qr.value();
         for (int i = 0; i < nq; i++) {
             auto ref = Ref(base.data(), query.data() + i * dim, nb, dim, topk, metric_type);
             auto ans = result.get_seg_offsets() + i * topk;
@@ -137,3 +142,86 @@ TEST_F(TestFloatSearchBruteForce, IP) {
 TEST_F(TestFloatSearchBruteForce, NotSupported) {
     Run(100, 10, 5, 128, "aaaaaaaaaaaa");
 }
+
+// nq <= 4 takes the native tiled scan instead of the knowhere staging path
+TEST_F(TestFloatSearchBruteForce, SmallNqL2) {
+    Run(1000, 2, 5, 128, knowhere::metric::L2);
+}
+
+TEST_F(TestFloatSearchBruteForce, SmallNqIP) {
+    Run(1000, 3, 5, 128, knowhere::metric::IP);
+}
+
+TEST_F(TestFloatSearchBruteForce, SmallNqSingleQuery) {
+    Run(1000, 1, 7, 256, knowhere::metric::L2);
+}
+
+// a dim without a compile-time specialization exercises the runtime kernel
+TEST_F(TestFloatSearchBruteForce, SmallNqRuntimeDim) {
+    Run(500, 4, 5, 60, knowhere::metric::L2);
+}
+
+class TestSelectiveFilterBruteForce : public ::testing::Test {
+ public:
+    // filters out all but `alive` rows and checks the gather-compact path
+    // against a reference ranking restricted to the survivors
+    void
+    Run(int nb, int nq, int topk, int dim, int alive, const knowhere::MetricType& metric_type) {
+        auto bitset = std::make_shared<BitsetType>();
+        bitset->resize(nb);
+        bitset->set();
+        std::vector<int> alive_rows;
+        std::default_random_engine er(2023);
+        for (int i = 0; i < alive; i++) {
+            int row = er() % nb;
+            if (!bitset->test(row)) {
+                continue;
+            }
+            bitset->reset(row);
+            alive_rows.push_back(row);
+        }
+        auto bitset_view = BitsetView(*bitset);
+
+        auto base = GenFloatVecs(dim, nb, metric_type);
+        auto query = GenFloatVecs(dim, nq, metric_type);
+
+        // reference over the surviving rows only
+        std::vector<float> alive_base(alive_rows.size() * dim);
+        for (size_t i = 0; i < alive_rows.size(); i++) {
+            std::copy_n(base.data() + alive_rows[i] * dim, dim, alive_base.data() + i * dim);
+        }
+
+        dataset::SearchDataset dataset{metric_type, nq, topk, -1, dim, query.data()};
+        auto sub_qr = BruteForceSearch(dataset, base.data(), nb, bitset_view);
+        ASSERT_TRUE(sub_qr.ok()) << sub_qr.status().ToString();
+        auto& result = sub_qr.value();
+        auto ref_k = std::min<int>(topk, alive_rows.size());
+        for (int i = 0; i < nq; i++) {
+            auto ref = Ref(alive_base.data(), query.data() + i * dim, alive_rows.size(), dim, ref_k, metric_type);
+            auto ans = result.get_seg_offsets() + i * topk;
+            for (int k = 0; k < topk; k++) {
+                if (k < ref_k) {
+                    ASSERT_EQ(ans[k], alive_rows[ref[k]]) << "query " << i << " rank " << k;
+                } else {
+                    ASSERT_EQ(ans[k], -1) << "query " << i << " rank " << k;
+                }
+            }
+        }
+    }
+};
+
+TEST_F(TestSelectiveFilterBruteForce, L2) {
+    Run(1000, 10, 5, 128, 15, knowhere::metric::L2);
+}
+
+TEST_F(TestSelectiveFilterBruteForce, IP) {
+    Run(1000, 10, 5, 128, 15, knowhere::metric::IP);
+}
+
+TEST_F(TestSelectiveFilterBruteForce, FewerAliveThanTopk) {
+    Run(1000, 5, 10, 32, 3, knowhere::metric::L2);
+}
+
+TEST_F(TestSelectiveFilterBruteForce, AllFiltered) {
+    Run(1000, 5, 10, 32, 0, knowhere::metric::L2);
+}
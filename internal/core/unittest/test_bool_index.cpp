@@ -157,6 +157,42 @@ TEST_F(BoolIndexTest, NotIn) {
     }
 }
 
+TEST_F(BoolIndexTest, Range) {
+    auto index = milvus::scalar::CreateBoolIndex();
+    index->BuildWithDataset(half_ds);
+
+    {
+        auto bitset = index->Range(true, milvus::OpType::LessThan);
+        for (size_t i = 0; i < n; i++) {
+            ASSERT_EQ(bitset->test(i), (i % 2) != 0);
+        }
+    }
+
+    {
+        auto bitset = index->Range(false, milvus::OpType::GreaterEqual);
+        ASSERT_TRUE(bitset->all());
+    }
+
+    {
+        auto bitset = index->Range(false, true, true, true);
+        ASSERT_TRUE(bitset->all());
+    }
+
+    {
+        auto bitset = index->Range(false, false, true, false);
+        ASSERT_TRUE(bitset->none());
+    }
+}
+
+TEST_F(BoolIndexTest, ReverseLookup) {
+    auto index = milvus::scalar::CreateBoolIndex();
+    index->BuildWithDataset(half_ds);
+
+    for (size_t i = 0; i < n; i++) {
+        ASSERT_EQ(index->Reverse_Lookup(i), (i % 2) == 0);
+    }
+}
+
 TEST_F(BoolIndexTest, Codec) {
     auto true_test = std::make_unique<bool>(true);
     auto false_test = std::make_unique<bool>(false);
@@ -9,25 +9,39 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+#include <atomic>
 #include <boost/format.hpp>
 #include <chrono>
+#include <cstring>
+#include <future>
 #include <google/protobuf/text_format.h>
 #include <gtest/gtest.h>
 #include <iostream>
 #include <random>
 #include <string>
+#include <thread>
 #include <unordered_set>
 
 #include "common/LoadInfo.h"
+#include "common/ThreadPool.h"
 #include "knowhere/index/VecIndexFactory.h"
 #include "knowhere/index/vector_index/IndexIVFPQ.h"
 #include "knowhere/index/vector_index/helpers/IndexParameter.h"
 #include "knowhere/index/vector_index/adapter/VectorAdapter.h"
 #include "pb/plan.pb.h"
 #include "query/ExprImpl.h"
+#include <arrow/array.h>
+#include <arrow/builder.h>
+#include <arrow/c/bridge.h>
+#include <arrow/record_batch.h>
+#include <arrow/util/compression.h>
+#include "segcore/ChunkArena.h"
 #include "segcore/Collection.h"
+#include "storage/ArrowMemoryPool.h"
 #include "segcore/reduce_c.h"
 #include "segcore/Reduce.h"
+#include "segcore/SegcoreConfig.h"
 #include "test_utils/DataGen.h"
 
 namespace chrono = std::chrono;
@@ -193,6 +207,18 @@ TEST(CApiTest, CollectionTest) {
     DeleteCollection(collection);
 }
 
+TEST(CApiTest, CollectionSchemaSharedTest) {
+    // the same schema text must yield one shared Schema object, not a
+    // fresh parse per NewCollection
+    auto collection1 = NewCollection(get_default_schema_config());
+    auto collection2 = NewCollection(get_default_schema_config());
+    auto schema1 = ((milvus::segcore::Collection*)collection1)->get_schema();
+    auto schema2 = ((milvus::segcore::Collection*)collection2)->get_schema();
+    ASSERT_EQ(schema1.get(), schema2.get());
+    DeleteCollection(collection1);
+    DeleteCollection(collection2);
+}
+
 TEST(CApiTest, GetCollectionNameTest) {
     auto collection = NewCollection(get_default_schema_config());
     auto name = GetCollectionName(collection);
@@ -207,6 +233,21 @@ TEST(CApiTest, SegmentTest) {
     DeleteSegment(segment);
 }
 
+TEST(CApiTest, SegmentNumaNodeTest) {
+    auto collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(collection, Growing, -1);
+
+    // placement is best effort, so the call succeeds even without NUMA
+    auto status = SetSegmentNumaNode(segment, 0);
+    ASSERT_EQ(status.error_code, Success);
+    ASSERT_EQ(((milvus::segcore::SegmentInterface*)segment)->numa_node(), 0);
+    status = SetSegmentNumaNode(segment, -1);
+    ASSERT_EQ(status.error_code, Success);
+
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
 TEST(CApiTest, CPlan) {
     std::string schema_string = generate_collection_schema("JACCARD", DIM, true);
     auto collection = NewCollection(schema_string.c_str());
@@ -831,6 +872,14 @@ TEST(CApiTest, SearchTest) {
     auto res2 = Search(segment, plan, placeholderGroup, ts_offset, &search_result2);
     ASSERT_EQ(res2.error_code, Success);
 
+    const char* profile_json = nullptr;
+    auto profile_res = GetSearchProfile(search_result, &profile_json);
+    ASSERT_EQ(profile_res.error_code, Success);
+    auto profile = milvus::json::parse(profile_json);
+    ASSERT_EQ(profile["rows_scanned"].get<int64_t>(), N);
+    ASSERT_GT(profile["chunks_brute_forced"].get<int64_t>(), 0);
+    free((void*)profile_json);
+
     DeleteSearchPlan(plan);
     DeletePlaceholderGroup(placeholderGroup);
     DeleteSearchResult(search_result);
@@ -839,6 +888,267 @@ TEST(CApiTest, SearchTest) {
     DeleteSegment(segment);
 }
 
+TEST(CApiTest, SearchBatchTest) {
+    auto c_collection = NewCollection(get_default_schema_config());
+    auto col = (milvus::segcore::Collection*)c_collection;
+
+    int N = 10000;
+    constexpr int64_t num_segments = 3;
+    std::vector<CSegmentInterface> segments;
+    for (int64_t i = 0; i < num_segments; i++) {
+        auto segment = NewSegment(c_collection, Growing, -1);
+        auto dataset = DataGen(col->get_schema(), N);
+
+        int64_t offset;
+        PreInsert(segment, N, &offset);
+
+        auto insert_data = serialize(dataset.raw_);
+        auto ins_res = Insert(segment, offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(),
+                              insert_data.data(), insert_data.size());
+        ASSERT_EQ(ins_res.error_code, Success);
+        segments.push_back(segment);
+    }
+
+    const char* dsl_string = R"(
+    {
+        "bool": {
+            "vector": {
+                "fakevec": {
+                    "metric_type": "L2",
+                    "params": {
+                        "nprobe": 10
+                    },
+                    "query": "$0",
+                    "topk": 10,
+                    "round_decimal": 3
+                }
+            }
+        }
+    })";
+
+    int num_queries = 10;
+    auto blob = generate_query_data(num_queries);
+
+    void* plan = nullptr;
+    auto status = CreateSearchPlan(c_collection, dsl_string, &plan);
+    ASSERT_EQ(status.error_code, Success);
+
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(plan, blob.data(), blob.length(), &placeholderGroup);
+    ASSERT_EQ(status.error_code, Success);
+
+    std::vector<CSearchResult> search_results(num_segments);
+    auto res = SearchBatch(segments.data(), num_segments, plan, placeholderGroup, N + 1000, search_results.data());
+    ASSERT_EQ(res.error_code, Success);
+
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    for (auto search_result : search_results) {
+        DeleteSearchResult(search_result);
+    }
+    DeleteCollection(c_collection);
+    for (auto segment : segments) {
+        DeleteSegment(segment);
+    }
+}
+
+namespace {
+void
+MarkSearchDone(void* context) {
+    static_cast<std::atomic<bool>*>(context)->store(true);
+}
+}  // namespace
+
+TEST(CApiTest, SearchAsyncTest) {
+    auto c_collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(c_collection, Growing, -1);
+    auto col = (milvus::segcore::Collection*)c_collection;
+
+    int N = 10000;
+    auto dataset = DataGen(col->get_schema(), N);
+
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment, offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), insert_data.data(),
+                          insert_data.size());
+    ASSERT_EQ(ins_res.error_code, Success);
+
+    const char* dsl_string = R"(
+    {
+        "bool": {
+            "vector": {
+                "fakevec": {
+                    "metric_type": "L2",
+                    "params": {
+                        "nprobe": 10
+                    },
+                    "query": "$0",
+                    "topk": 10,
+                    "round_decimal": 3
+                }
+            }
+        }
+    })";
+
+    int num_queries = 10;
+    auto blob = generate_query_data(num_queries);
+
+    void* plan = nullptr;
+    auto status = CreateSearchPlan(c_collection, dsl_string, &plan);
+    ASSERT_EQ(status.error_code, Success);
+
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(plan, blob.data(), blob.length(), &placeholderGroup);
+    ASSERT_EQ(status.error_code, Success);
+
+    // several in-flight searches from one submitting thread
+    constexpr int num_inflight = 4;
+    std::vector<std::atomic<bool>> done(num_inflight);
+    std::vector<CSearchFuture> futures(num_inflight);
+    for (int i = 0; i < num_inflight; i++) {
+        done[i].store(false);
+        status = SearchAsync(segment, plan, placeholderGroup, N + 1000, MarkSearchDone, &done[i], &futures[i]);
+        ASSERT_EQ(status.error_code, Success);
+    }
+
+    CSearchResult sync_result;
+    status = Search(segment, plan, placeholderGroup, N + 1000, &sync_result);
+    ASSERT_EQ(status.error_code, Success);
+
+    for (int i = 0; i < num_inflight; i++) {
+        CSearchResult async_result;
+        status = SearchAsyncGetResult(futures[i], &async_result);
+        ASSERT_EQ(status.error_code, Success);
+        // the callback ran before the result became retrievable
+        ASSERT_TRUE(done[i].load());
+
+        auto async_sr = (milvus::SearchResult*)async_result;
+        auto sync_sr = (milvus::SearchResult*)sync_result;
+        ASSERT_EQ(async_sr->total_nq_, sync_sr->total_nq_);
+        ASSERT_EQ(async_sr->distances_.size(), sync_sr->distances_.size());
+        for (size_t j = 0; j < sync_sr->distances_.size(); j++) {
+            ASSERT_EQ(async_sr->seg_offsets_[j], sync_sr->seg_offsets_[j]);
+            ASSERT_EQ(async_sr->distances_[j], sync_sr->distances_[j]);
+        }
+        DeleteSearchResult(async_result);
+        DeleteSearchFuture(futures[i]);
+    }
+
+    // polling without a callback also works
+    CSearchFuture future;
+    status = SearchAsync(segment, plan, placeholderGroup, N + 1000, nullptr, nullptr, &future);
+    ASSERT_EQ(status.error_code, Success);
+    CSearchResult async_result;
+    status = SearchAsyncGetResult(future, &async_result);
+    ASSERT_EQ(status.error_code, Success);
+    DeleteSearchResult(async_result);
+    DeleteSearchFuture(future);
+
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    DeleteSearchResult(sync_result);
+    DeleteCollection(c_collection);
+    DeleteSegment(segment);
+}
+
+TEST(CApiTest, CancelSearchTest) {
+    auto c_collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(c_collection, Growing, -1);
+    auto col = (milvus::segcore::Collection*)c_collection;
+
+    int N = 10000;
+    auto dataset = DataGen(col->get_schema(), N);
+
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment, offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), insert_data.data(),
+                          insert_data.size());
+    ASSERT_EQ(ins_res.error_code, Success);
+
+    const char* dsl_string = R"(
+    {
+        "bool": {
+            "vector": {
+                "fakevec": {
+                    "metric_type": "L2",
+                    "params": {
+                        "nprobe": 10
+                    },
+                    "query": "$0",
+                    "topk": 10,
+                    "round_decimal": 3
+                }
+            }
+        }
+    })";
+
+    int num_queries = 10;
+    auto blob = generate_query_data(num_queries);
+
+    void* plan = nullptr;
+    auto status = CreateSearchPlan(c_collection, dsl_string, &plan);
+    ASSERT_EQ(status.error_code, Success);
+
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(plan, blob.data(), blob.length(), &placeholderGroup);
+    ASSERT_EQ(status.error_code, Success);
+
+    // park every search worker behind a gate so the async search stays
+    // queued; cancelling it then must fail it without it ever running
+    auto& pool = milvus::ThreadPool::GetInstance(milvus::ThreadPoolRole::Search);
+    std::promise<void> gate;
+    std::shared_future<void> gate_opened = gate.get_future().share();
+    std::atomic<int> parked{0};
+    std::vector<std::future<void>> blockers;
+    for (int i = 0; i < pool.num_threads(); ++i) {
+        blockers.emplace_back(pool.Submit([gate_opened, &parked] {
+            parked.fetch_add(1);
+            gate_opened.wait();
+        }));
+    }
+    while (parked.load() < pool.num_threads()) {
+        std::this_thread::yield();
+    }
+
+    CSearchFuture future;
+    status = SearchAsync(segment, plan, placeholderGroup, N + 1000, nullptr, nullptr, &future);
+    ASSERT_EQ(status.error_code, Success);
+
+    status = CancelSearch(future);
+    ASSERT_EQ(status.error_code, Success);
+
+    gate.set_value();
+    for (auto& blocker : blockers) {
+        blocker.get();
+    }
+
+    CSearchResult cancelled_result;
+    status = SearchAsyncGetResult(future, &cancelled_result);
+    ASSERT_NE(status.error_code, Success);
+    free((char*)status.error_msg);
+    DeleteSearchFuture(future);
+
+    // cancelling after completion is a harmless no-op
+    status = SearchAsync(segment, plan, placeholderGroup, N + 1000, nullptr, nullptr, &future);
+    ASSERT_EQ(status.error_code, Success);
+    CSearchResult async_result;
+    status = SearchAsyncGetResult(future, &async_result);
+    ASSERT_EQ(status.error_code, Success);
+    status = CancelSearch(future);
+    ASSERT_EQ(status.error_code, Success);
+    DeleteSearchResult(async_result);
+    DeleteSearchFuture(future);
+
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    DeleteCollection(c_collection);
+    DeleteSegment(segment);
+}
+
 TEST(CApiTest, SearchTestWithExpr) {
     auto c_collection = NewCollection(get_default_schema_config());
     auto segment = NewSegment(c_collection, Growing, -1);
@@ -882,49 +1192,491 @@ TEST(CApiTest, SearchTestWithExpr) {
     dataset.timestamps_.clear();
     dataset.timestamps_.push_back(1);
 
-    CSearchResult search_result;
-    auto res = Search(segment, plan, placeholderGroup, dataset.timestamps_[0], &search_result);
+    CSearchResult search_result;
+    auto res = Search(segment, plan, placeholderGroup, dataset.timestamps_[0], &search_result);
+    ASSERT_EQ(res.error_code, Success);
+
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    DeleteSearchResult(search_result);
+    DeleteCollection(c_collection);
+    DeleteSegment(segment);
+}
+
+TEST(CApiTest, RetrieveTestWithExpr) {
+    auto collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(collection, Growing, -1);
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+
+    int N = 10000;
+    auto dataset = DataGen(schema, N);
+
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment, offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), insert_data.data(),
+                          insert_data.size());
+    ASSERT_EQ(ins_res.error_code, Success);
+
+    // create retrieve plan "age in [0]"
+    std::vector<int64_t> values(1, 0);
+    auto term_expr = std::make_unique<query::TermExprImpl<int64_t>>(FieldId(101), DataType::INT64, values);
+
+    plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    plan->plan_node_->predicate_ = std::move(term_expr);
+    std::vector<FieldId> target_field_ids{FieldId(100), FieldId(101)};
+    plan->field_ids_ = target_field_ids;
+
+    CRetrieveResult retrieve_result;
+    auto res = Retrieve(segment, plan.get(), dataset.timestamps_[0], &retrieve_result);
+    ASSERT_EQ(res.error_code, Success);
+
+    DeleteRetrievePlan(plan.release());
+    DeleteRetrieveResult(&retrieve_result);
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
+TEST(CApiTest, RetrieveArrowExportTest) {
+    auto collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(collection, Growing, -1);
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+
+    int N = 10000;
+    auto dataset = DataGen(schema, N);
+
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment, offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), insert_data.data(),
+                          insert_data.size());
+    ASSERT_EQ(ins_res.error_code, Success);
+
+    // retrieve pks in [1, 2, 3] through both output paths
+    std::vector<int64_t> retrieve_pks = {1, 2, 3};
+    auto term_expr = std::make_unique<query::TermExprImpl<int64_t>>(FieldId(101), DataType::INT64, retrieve_pks);
+    plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    plan->plan_node_->predicate_ = std::move(term_expr);
+    std::vector<FieldId> target_field_ids{FieldId(100), FieldId(101)};
+    plan->field_ids_ = target_field_ids;
+
+    CRetrieveResult retrieve_result;
+    auto res = Retrieve(segment, plan.get(), dataset.timestamps_[N - 1], &retrieve_result);
+    ASSERT_EQ(res.error_code, Success);
+    auto proto_result = std::make_unique<proto::segcore::RetrieveResults>();
+    ASSERT_TRUE(proto_result->ParseFromArray(retrieve_result.proto_blob, retrieve_result.proto_size));
+
+    auto bytes_before = milvus::storage::GetArrowPoolBytes(milvus::storage::ArrowPoolScope::RetrieveExport);
+    struct ArrowArray c_array;
+    struct ArrowSchema c_schema;
+    res = RetrieveArrow(segment, plan.get(), dataset.timestamps_[N - 1], &c_array, &c_schema);
+    ASSERT_EQ(res.error_code, Success);
+
+    auto batch_result = arrow::ImportRecordBatch(&c_array, &c_schema);
+    ASSERT_TRUE(batch_result.ok());
+    auto batch = *batch_result;
+
+    auto num_rows = proto_result->offset_size();
+    ASSERT_EQ(num_rows, 3);
+    ASSERT_EQ(batch->num_rows(), num_rows);
+    ASSERT_EQ(batch->num_columns(), 2);
+
+    // columns come in plan order, with the field id in the metadata
+    ASSERT_EQ(batch->schema()->field(0)->name(), "fakevec");
+    ASSERT_EQ(batch->schema()->field(1)->metadata()->Get("field_id").ValueOr(""), "101");
+
+    auto int_col = std::static_pointer_cast<arrow::Int64Array>(batch->column(1));
+    auto& proto_ints = proto_result->fields_data(1).scalars().long_data().data();
+    for (int i = 0; i < num_rows; ++i) {
+        ASSERT_EQ(int_col->Value(i), proto_ints[i]);
+    }
+
+    auto vec_col = std::static_pointer_cast<arrow::FixedSizeListArray>(batch->column(0));
+    auto vec_values = std::static_pointer_cast<arrow::FloatArray>(vec_col->values());
+    auto& proto_vecs = proto_result->fields_data(0).vectors().float_vector().data();
+    ASSERT_EQ(vec_values->length(), proto_vecs.size());
+    for (int64_t i = 0; i < vec_values->length(); ++i) {
+        ASSERT_EQ(vec_values->Value(i), proto_vecs[i]);
+    }
+
+    // dropping the imported batch runs the release callbacks and returns
+    // every exported buffer to the accounted pool
+    batch.reset();
+    ASSERT_EQ(milvus::storage::GetArrowPoolBytes(milvus::storage::ArrowPoolScope::RetrieveExport), bytes_before);
+
+    DeleteRetrievePlan(plan.release());
+    DeleteRetrieveResult(&retrieve_result);
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
+TEST(CApiTest, InsertArrowTest) {
+    auto collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(collection, Growing, -1);
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+
+    int N = 1000;
+    auto dataset = DataGen(schema, N);
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+
+    // hand the generated columns over as one arrow record batch, columns
+    // tagged with the field id the same way the export path tags them
+    auto vec_col = dataset.get_col<float>(FieldId(100));
+    auto age_col = dataset.get_col<int64_t>(FieldId(101));
+
+    arrow::FloatBuilder vec_child;
+    ASSERT_TRUE(vec_child.AppendValues(vec_col.data(), vec_col.size()).ok());
+    std::shared_ptr<arrow::Array> vec_values;
+    ASSERT_TRUE(vec_child.Finish(&vec_values).ok());
+    auto vec_array =
+        std::make_shared<arrow::FixedSizeListArray>(arrow::fixed_size_list(arrow::float32(), 16), N, vec_values);
+
+    arrow::Int64Builder age_builder;
+    ASSERT_TRUE(age_builder.AppendValues(age_col.data(), age_col.size()).ok());
+    std::shared_ptr<arrow::Array> age_array;
+    ASSERT_TRUE(age_builder.Finish(&age_array).ok());
+
+    auto arrow_schema = arrow::schema(
+        {arrow::field("fakevec", vec_array->type(), false, arrow::key_value_metadata({"field_id"}, {"100"})),
+         arrow::field("age", age_array->type(), false, arrow::key_value_metadata({"field_id"}, {"101"}))});
+    auto batch = arrow::RecordBatch::Make(arrow_schema, N, {vec_array, age_array});
+
+    struct ArrowArray c_array;
+    struct ArrowSchema c_schema;
+    ASSERT_TRUE(arrow::ExportRecordBatch(*batch, &c_array, &c_schema).ok());
+
+    auto res =
+        InsertArrow(segment, offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), &c_array, &c_schema);
+    ASSERT_EQ(res.error_code, Success);
+    ASSERT_EQ(GetRowCount(segment), N);
+
+    // the ingested rows are queryable and hold the source payloads
+    std::vector<int64_t> retrieve_pks = {1, 2, 3};
+    auto term_expr = std::make_unique<query::TermExprImpl<int64_t>>(FieldId(101), DataType::INT64, retrieve_pks);
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+    plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    plan->plan_node_->predicate_ = std::move(term_expr);
+    plan->field_ids_ = {FieldId(100), FieldId(101)};
+
+    CRetrieveResult retrieve_result;
+    res = Retrieve(segment, plan.get(), dataset.timestamps_[N - 1], &retrieve_result);
+    ASSERT_EQ(res.error_code, Success);
+    auto proto_result = std::make_unique<proto::segcore::RetrieveResults>();
+    ASSERT_TRUE(proto_result->ParseFromArray(retrieve_result.proto_blob, retrieve_result.proto_size));
+    ASSERT_EQ(proto_result->offset_size(), 3);
+
+    auto& ints = proto_result->fields_data(1).scalars().long_data().data();
+    auto& vecs = proto_result->fields_data(0).vectors().float_vector().data();
+    for (int i = 0; i < 3; ++i) {
+        // DataGen pks are the row offsets, so pk k sits at offset k
+        auto row = retrieve_pks[i];
+        ASSERT_EQ(ints[i], row);
+        for (int d = 0; d < 16; ++d) {
+            ASSERT_EQ(vecs[i * 16 + d], vec_col[row * 16 + d]);
+        }
+    }
+
+    DeleteRetrievePlan(plan.release());
+    DeleteRetrieveResult(&retrieve_result);
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
+TEST(CApiTest, CountTest) {
+    auto collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(collection, Growing, -1);
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+
+    int N = 10000;
+    auto dataset = DataGen(schema, N);
+
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment, offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), insert_data.data(),
+                          insert_data.size());
+    ASSERT_EQ(ins_res.error_code, Success);
+
+    // count plan "age >= 0"; the reference count comes from the raw column
+    auto age_col = dataset.get_col<int64_t>(FieldId(101));
+    int64_t expected = std::count_if(age_col.begin(), age_col.end(), [](int64_t v) { return v >= 0; });
+
+    auto range_expr =
+        std::make_unique<query::UnaryRangeExprImpl<int64_t>>(FieldId(101), DataType::INT64, OpType::GreaterEqual, 0);
+    plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    plan->plan_node_->predicate_ = std::move(range_expr);
+
+    int64_t count = -1;
+    auto res = Count(segment, plan.get(), dataset.timestamps_[N - 1], &count);
+    ASSERT_EQ(res.error_code, Success);
+    ASSERT_EQ(count, expected);
+
+    // no predicate counts every visible row
+    auto full_plan = std::make_unique<query::RetrievePlan>(*schema);
+    full_plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    int64_t full_count = -1;
+    res = Count(segment, full_plan.get(), dataset.timestamps_[N - 1], &full_count);
+    ASSERT_EQ(res.error_code, Success);
+    ASSERT_EQ(full_count, N);
+
+    DeleteRetrievePlan(plan.release());
+    DeleteRetrievePlan(full_plan.release());
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
+TEST(CApiTest, RetrieveCursorTest) {
+    auto collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(collection, Growing, -1);
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+
+    int N = 10000;
+    auto dataset = DataGen(schema, N);
+
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment, offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), insert_data.data(),
+                          insert_data.size());
+    ASSERT_EQ(ins_res.error_code, Success);
+
+    // retrieve plan "age >= INT64_MIN": every row matches
+    auto range_expr = std::make_unique<query::UnaryRangeExprImpl<int64_t>>(FieldId(101), DataType::INT64,
+                                                                          OpType::GreaterEqual, INT64_MIN);
+    plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    plan->plan_node_->predicate_ = std::move(range_expr);
+    std::vector<FieldId> target_field_ids{FieldId(100), FieldId(101)};
+    plan->field_ids_ = target_field_ids;
+
+    CRetrieveCursor cursor;
+    auto res = NewRetrieveCursor(segment, plan.get(), dataset.timestamps_[N - 1], &cursor);
+    ASSERT_EQ(res.error_code, Success);
+
+    const int64_t batch_size = 1024;
+    int64_t total_rows = 0;
+    int batches = 0;
+    while (true) {
+        CRetrieveResult retrieve_result;
+        bool has_more = false;
+        res = RetrieveCursorNext(cursor, batch_size, &retrieve_result, &has_more);
+        ASSERT_EQ(res.error_code, Success);
+        if (!has_more) {
+            break;
+        }
+        auto batch = std::make_unique<milvus::proto::segcore::RetrieveResults>();
+        auto suc = batch->ParseFromArray(retrieve_result.proto_blob, retrieve_result.proto_size);
+        ASSERT_TRUE(suc);
+        ASSERT_LE(batch->offset_size(), batch_size);
+        total_rows += batch->offset_size();
+        ++batches;
+        DeleteRetrieveResult(&retrieve_result);
+    }
+    ASSERT_EQ(total_rows, N);
+    ASSERT_EQ(batches, (N + batch_size - 1) / batch_size);
+
+    DeleteRetrieveCursor(cursor);
+    DeleteRetrievePlan(plan.release());
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
+TEST(CApiTest, RetrieveWithLimitTest) {
+    auto collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(collection, Growing, -1);
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+
+    int N = 10000;
+    auto dataset = DataGen(schema, N);
+
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment, offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), insert_data.data(),
+                          insert_data.size());
+    ASSERT_EQ(ins_res.error_code, Success);
+
+    // every row matches; the limit must stop the scan at the first hits
+    auto range_expr = std::make_unique<query::UnaryRangeExprImpl<int64_t>>(FieldId(101), DataType::INT64,
+                                                                          OpType::GreaterEqual, INT64_MIN);
+    plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    plan->plan_node_->predicate_ = std::move(range_expr);
+    std::vector<FieldId> target_field_ids{FieldId(100), FieldId(101)};
+    plan->field_ids_ = target_field_ids;
+
+    const int64_t limit = 10;
+    SetRetrievePlanLimit(plan.get(), limit);
+
+    CRetrieveResult retrieve_result;
+    auto res = Retrieve(segment, plan.get(), dataset.timestamps_[N - 1], &retrieve_result);
+    ASSERT_EQ(res.error_code, Success);
+
+    auto results = std::make_unique<milvus::proto::segcore::RetrieveResults>();
+    ASSERT_TRUE(results->ParseFromArray(retrieve_result.proto_blob, retrieve_result.proto_size));
+    ASSERT_EQ(results->offset_size(), limit);
+    for (int64_t i = 0; i < limit; ++i) {
+        ASSERT_EQ(results->offset(i), i);
+    }
+
+    DeleteRetrievePlan(plan.release());
+    DeleteRetrieveResult(&retrieve_result);
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
+TEST(CApiTest, RetrieveWithViewsTest) {
+    auto collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(collection, Sealed, -1);
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+
+    int N = 10000;
+    auto dataset = DataGen(schema, N);
+    auto vec_col = dataset.get_col<float>(FieldId(100));
+    auto age_col = dataset.get_col<int64_t>(FieldId(101));
+
+    FieldMeta ts_field_meta(FieldName("Timestamp"), TimestampFieldID, DataType::INT64);
+    auto ts_array = CreateScalarDataArrayFrom(dataset.timestamps_.data(), N, ts_field_meta);
+    auto ts_data = serialize(ts_array.get());
+    auto load_info = CLoadFieldDataInfo{TimestampFieldID.get(), ts_data.data(), ts_data.size(), N};
+    ASSERT_EQ(LoadFieldData(segment, load_info).error_code, Success);
+
+    FieldMeta row_id_field_meta(FieldName("RowID"), RowFieldID, DataType::INT64);
+    auto row_id_array = CreateScalarDataArrayFrom(dataset.row_ids_.data(), N, row_id_field_meta);
+    auto row_id_data = serialize(row_id_array.get());
+    load_info = CLoadFieldDataInfo{RowFieldID.get(), row_id_data.data(), row_id_data.size(), N};
+    ASSERT_EQ(LoadFieldData(segment, load_info).error_code, Success);
+
+    FieldMeta vec_field_meta(FieldName("fakevec"), FieldId(100), DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto vec_array = CreateVectorDataArrayFrom(vec_col.data(), N, vec_field_meta);
+    auto vec_data = serialize(vec_array.get());
+    load_info = CLoadFieldDataInfo{100, vec_data.data(), vec_data.size(), N};
+    ASSERT_EQ(LoadFieldData(segment, load_info).error_code, Success);
+
+    FieldMeta age_field_meta(FieldName("age"), FieldId(101), DataType::INT64);
+    auto age_array = CreateScalarDataArrayFrom(age_col.data(), N, age_field_meta);
+    auto age_data = serialize(age_array.get());
+    load_info = CLoadFieldDataInfo{101, age_data.data(), age_data.size(), N};
+    ASSERT_EQ(LoadFieldData(segment, load_info).error_code, Success);
+
+    // "age >= INT64_MIN" keeps every row: one contiguous offset run
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+    auto range_expr = std::make_unique<query::UnaryRangeExprImpl<int64_t>>(FieldId(101), DataType::INT64,
+                                                                          OpType::GreaterEqual, INT64_MIN);
+    plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    plan->plan_node_->predicate_ = std::move(range_expr);
+    std::vector<FieldId> target_field_ids{FieldId(100), FieldId(101)};
+    plan->field_ids_ = target_field_ids;
+
+    CRetrieveViewsResult views_result;
+    auto res = RetrieveWithViews(segment, plan.get(), dataset.timestamps_[N - 1], true, &views_result);
+    ASSERT_EQ(res.error_code, Success);
+
+    const CFieldDataView* views = nullptr;
+    auto num_views = GetRetrieveViews(views_result, &views);
+    ASSERT_EQ(num_views, 2);
+
+    // both fields are fixed-width, so both come back borrowed
+    ASSERT_EQ(views[0].field_id, 100);
+    ASSERT_EQ(views[0].data_type, CDataType::FloatVector);
+    ASSERT_NE(views[0].data, nullptr);
+    ASSERT_EQ(views[0].row_count, N);
+    ASSERT_EQ(views[0].element_size, int64_t(16 * sizeof(float)));
+    auto borrowed_vecs = static_cast<const float*>(views[0].data);
+    for (int i = 0; i < 16 * 10; ++i) {
+        ASSERT_EQ(borrowed_vecs[i], vec_col[i]);
+    }
+
+    ASSERT_EQ(views[1].field_id, 101);
+    ASSERT_EQ(views[1].data_type, CDataType::Int64);
+    ASSERT_NE(views[1].data, nullptr);
+    ASSERT_EQ(views[1].element_size, int64_t(sizeof(int64_t)));
+    auto borrowed_ages = static_cast<const int64_t*>(views[1].data);
+    for (int i = 0; i < N; ++i) {
+        ASSERT_EQ(borrowed_ages[i], age_col[i]);
+    }
+
+    // offsets and pk ids still travel in the fallback proto; no columns do
+    auto fallback = GetRetrieveViewsFallback(views_result);
+    auto fallback_proto = std::make_unique<milvus::proto::segcore::RetrieveResults>();
+    ASSERT_TRUE(fallback_proto->ParseFromArray(fallback.proto_blob, fallback.proto_size));
+    ASSERT_EQ(fallback_proto->offset_size(), N);
+    ASSERT_EQ(fallback_proto->fields_data_size(), 0);
+    ASSERT_EQ(fallback_proto->ids().int_id().data_size(), N);
+    ASSERT_EQ(fallback_proto->ids().int_id().data(42), age_col[42]);
+    DeleteRetrieveViewsResult(views_result);
+
+    // a caller that cannot take views gets plain Retrieve output
+    res = RetrieveWithViews(segment, plan.get(), dataset.timestamps_[N - 1], false, &views_result);
     ASSERT_EQ(res.error_code, Success);
+    ASSERT_EQ(GetRetrieveViews(views_result, &views), 0);
+    fallback = GetRetrieveViewsFallback(views_result);
+    fallback_proto = std::make_unique<milvus::proto::segcore::RetrieveResults>();
+    ASSERT_TRUE(fallback_proto->ParseFromArray(fallback.proto_blob, fallback.proto_size));
+    ASSERT_EQ(fallback_proto->offset_size(), N);
+    ASSERT_EQ(fallback_proto->fields_data_size(), 2);
+    DeleteRetrieveViewsResult(views_result);
 
-    DeleteSearchPlan(plan);
-    DeletePlaceholderGroup(placeholderGroup);
-    DeleteSearchResult(search_result);
-    DeleteCollection(c_collection);
+    DeleteRetrievePlan(plan.release());
+    DeleteCollection(collection);
     DeleteSegment(segment);
 }
 
-TEST(CApiTest, RetrieveTestWithExpr) {
+TEST(CApiTest, RetrieveWithViewsFallbackOnGrowingTest) {
     auto collection = NewCollection(get_default_schema_config());
     auto segment = NewSegment(collection, Growing, -1);
     auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
-    auto plan = std::make_unique<query::RetrievePlan>(*schema);
 
     int N = 10000;
     auto dataset = DataGen(schema, N);
+    auto age_col = dataset.get_col<int64_t>(FieldId(101));
 
     int64_t offset;
     PreInsert(segment, N, &offset);
-
     auto insert_data = serialize(dataset.raw_);
     auto ins_res = Insert(segment, offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), insert_data.data(),
                           insert_data.size());
     ASSERT_EQ(ins_res.error_code, Success);
 
-    // create retrieve plan "age in [0]"
-    std::vector<int64_t> values(1, 0);
-    auto term_expr = std::make_unique<query::TermExprImpl<int64_t>>(FieldId(101), DataType::INT64, values);
-
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+    auto range_expr = std::make_unique<query::UnaryRangeExprImpl<int64_t>>(FieldId(101), DataType::INT64,
+                                                                          OpType::GreaterEqual, INT64_MIN);
     plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
-    plan->plan_node_->predicate_ = std::move(term_expr);
+    plan->plan_node_->predicate_ = std::move(range_expr);
     std::vector<FieldId> target_field_ids{FieldId(100), FieldId(101)};
     plan->field_ids_ = target_field_ids;
 
-    CRetrieveResult retrieve_result;
-    auto res = Retrieve(segment, plan.get(), dataset.timestamps_[0], &retrieve_result);
+    // growing segments lend nothing: the views come back with empty data
+    // slots and every column rides in the fallback proto
+    CRetrieveViewsResult views_result;
+    auto res = RetrieveWithViews(segment, plan.get(), dataset.timestamps_[N - 1], true, &views_result);
     ASSERT_EQ(res.error_code, Success);
 
+    const CFieldDataView* views = nullptr;
+    auto num_views = GetRetrieveViews(views_result, &views);
+    ASSERT_EQ(num_views, 2);
+    ASSERT_EQ(views[0].data, nullptr);
+    ASSERT_EQ(views[1].data, nullptr);
+
+    auto fallback = GetRetrieveViewsFallback(views_result);
+    auto fallback_proto = std::make_unique<milvus::proto::segcore::RetrieveResults>();
+    ASSERT_TRUE(fallback_proto->ParseFromArray(fallback.proto_blob, fallback.proto_size));
+    ASSERT_EQ(fallback_proto->offset_size(), N);
+    ASSERT_EQ(fallback_proto->fields_data_size(), 2);
+    ASSERT_EQ(fallback_proto->ids().int_id().data_size(), N);
+    ASSERT_EQ(fallback_proto->ids().int_id().data(7), age_col[7]);
+    DeleteRetrieveViewsResult(views_result);
+
     DeleteRetrievePlan(plan.release());
-    DeleteRetrieveResult(&retrieve_result);
     DeleteCollection(collection);
     DeleteSegment(segment);
 }
@@ -1364,6 +2116,223 @@ TEST(CApiTest, ReduceSearchWithExpr) {
     testReduceSearchWithExpr(10000, 10, 10);
 }
 
+TEST(CApiTest, ReduceCompressedBlobs) {
+    int N = 10000;
+    int topK = 10;
+    int num_queries = 10;
+
+    auto collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(collection, Growing, -1);
+
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+    auto dataset = DataGen(schema, N);
+
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment, offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), insert_data.data(),
+                          insert_data.size());
+    assert(ins_res.error_code == Success);
+
+    auto fmt = boost::format(R"(vector_anns: <
+                                            field_id: 100
+                                            query_info: <
+                                                topk: %1%
+                                                metric_type: "L2"
+                                                search_params: "{\"nprobe\": 10}"
+                                            >
+                                            placeholder_tag: "$0">
+                                            output_field_ids: 100)") %
+               topK;
+
+    auto serialized_expr_plan = fmt.str();
+    auto blob = generate_query_data(num_queries);
+
+    void* plan = nullptr;
+    auto binary_plan = translate_text_plan_to_binary_plan(serialized_expr_plan.data());
+    auto status = CreateSearchPlanByExpr(collection, binary_plan.data(), binary_plan.size(), &plan);
+    assert(status.error_code == Success);
+
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(plan, blob.data(), blob.length(), &placeholderGroup);
+    assert(status.error_code == Success);
+
+    // reduce mutates its input, so run the same search once per reduce
+    CSearchResult raw_result;
+    CSearchResult compressed_result;
+    status = Search(segment, plan, placeholderGroup, dataset.timestamps_[N - 1], &raw_result);
+    assert(status.error_code == Success);
+    status = Search(segment, plan, placeholderGroup, dataset.timestamps_[N - 1], &compressed_result);
+    assert(status.error_code == Success);
+
+    auto slice_nqs = std::vector<int64_t>{num_queries / 2, num_queries / 2};
+    auto slice_topKs = std::vector<int64_t>{topK / 2, topK};
+
+    CSearchResultDataBlobs raw_blobs;
+    status = ReduceSearchResultsAndFillData(&raw_blobs, plan, &raw_result, 1, slice_nqs.data(), slice_topKs.data(),
+                                            slice_nqs.size());
+    assert(status.error_code == Success);
+
+    milvus::segcore::SegcoreConfig::default_config().set_result_blob_zstd_level(3);
+    CSearchResultDataBlobs compressed_blobs;
+    status = ReduceSearchResultsAndFillData(&compressed_blobs, plan, &compressed_result, 1, slice_nqs.data(),
+                                            slice_topKs.data(), slice_nqs.size());
+    milvus::segcore::SegcoreConfig::default_config().set_result_blob_zstd_level(0);
+    assert(status.error_code == Success);
+
+    auto raw = reinterpret_cast<milvus::segcore::SearchResultDataBlobs*>(raw_blobs);
+    auto compressed = reinterpret_cast<milvus::segcore::SearchResultDataBlobs*>(compressed_blobs);
+    ASSERT_EQ(raw->blobs.size(), compressed->blobs.size());
+    for (int i = 0; i < slice_nqs.size(); i++) {
+        // wire format: little-endian uncompressed size, then one zstd frame
+        auto& wire = compressed->blobs[i];
+        ASSERT_GT(wire.size(), sizeof(int64_t));
+        int64_t uncompressed_size;
+        std::memcpy(&uncompressed_size, wire.data(), sizeof(int64_t));
+        ASSERT_EQ(uncompressed_size, raw->blobs[i].size());
+
+        auto codec = arrow::util::Codec::Create(arrow::Compression::ZSTD);
+        ASSERT_TRUE(codec.ok());
+        std::vector<uint8_t> decompressed(uncompressed_size);
+        auto decompressed_size = (*codec)->Decompress(
+            wire.size() - sizeof(int64_t), reinterpret_cast<const uint8_t*>(wire.data()) + sizeof(int64_t),
+            uncompressed_size, decompressed.data());
+        ASSERT_TRUE(decompressed_size.ok());
+        ASSERT_EQ(*decompressed_size, uncompressed_size);
+        ASSERT_EQ(memcmp(decompressed.data(), raw->blobs[i].data(), uncompressed_size), 0);
+
+        milvus::proto::schema::SearchResultData search_result_data;
+        ASSERT_TRUE(search_result_data.ParseFromArray(decompressed.data(), uncompressed_size));
+        ASSERT_EQ(search_result_data.num_queries(), slice_nqs[i]);
+        ASSERT_EQ(search_result_data.top_k(), slice_topKs[i]);
+    }
+
+    DeleteSearchResultDataBlobs(raw_blobs);
+    DeleteSearchResultDataBlobs(compressed_blobs);
+    DeleteSearchResult(raw_result);
+    DeleteSearchResult(compressed_result);
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
+TEST(CApiTest, StreamReduceSearchWithExpr) {
+    int N = 10000;
+    int topK = 10;
+    int num_queries = 10;
+
+    auto collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(collection, Growing, -1);
+
+    auto schema = ((milvus::segcore::Collection*)collection)->get_schema();
+    auto dataset = DataGen(schema, N);
+
+    int64_t offset;
+    PreInsert(segment, N, &offset);
+
+    auto insert_data = serialize(dataset.raw_);
+    auto ins_res = Insert(segment, offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), insert_data.data(),
+                          insert_data.size());
+    assert(ins_res.error_code == Success);
+
+    auto fmt = boost::format(R"(vector_anns: <
+                                            field_id: 100
+                                            query_info: <
+                                                topk: %1%
+                                                metric_type: "L2"
+                                                search_params: "{\"nprobe\": 10}"
+                                            >
+                                            placeholder_tag: "$0">
+                                            output_field_ids: 100)") %
+               topK;
+
+    auto serialized_expr_plan = fmt.str();
+    auto blob = generate_query_data(num_queries);
+
+    void* plan = nullptr;
+    auto binary_plan = translate_text_plan_to_binary_plan(serialized_expr_plan.data());
+    auto status = CreateSearchPlanByExpr(collection, binary_plan.data(), binary_plan.size(), &plan);
+    assert(status.error_code == Success);
+
+    void* placeholderGroup = nullptr;
+    status = ParsePlaceholderGroup(plan, blob.data(), blob.length(), &placeholderGroup);
+    assert(status.error_code == Success);
+
+    // reduce mutates its inputs, so run the same search once per reducer
+    std::vector<CSearchResult> batch_results(2);
+    std::vector<CSearchResult> stream_results(2);
+    for (int i = 0; i < 2; i++) {
+        status = Search(segment, plan, placeholderGroup, dataset.timestamps_[N - 1], &batch_results[i]);
+        assert(status.error_code == Success);
+        status = Search(segment, plan, placeholderGroup, dataset.timestamps_[N - 1], &stream_results[i]);
+        assert(status.error_code == Success);
+    }
+
+    auto slice_nqs = std::vector<int64_t>{num_queries / 2, num_queries / 2};
+    auto slice_topKs = std::vector<int64_t>{topK / 2, topK};
+
+    CSearchResultDataBlobs batch_blobs;
+    status = ReduceSearchResultsAndFillData(&batch_blobs, plan, batch_results.data(), batch_results.size(),
+                                            slice_nqs.data(), slice_topKs.data(), slice_nqs.size());
+    assert(status.error_code == Success);
+
+    CStreamReduce stream_reduce;
+    status = NewStreamReduce(&stream_reduce, plan, slice_nqs.data(), slice_topKs.data(), slice_nqs.size());
+    assert(status.error_code == Success);
+    for (auto stream_result : stream_results) {
+        status = StreamReduceAddSearchResult(stream_reduce, stream_result);
+        assert(status.error_code == Success);
+    }
+    CSearchResultDataBlobs stream_blobs;
+    status = FinishStreamReduce(&stream_blobs, stream_reduce);
+    assert(status.error_code == Success);
+
+    // feeding the same results one by one must select the same hits as the
+    // batch reduce
+    auto batch = reinterpret_cast<milvus::segcore::SearchResultDataBlobs*>(batch_blobs);
+    auto stream = reinterpret_cast<milvus::segcore::SearchResultDataBlobs*>(stream_blobs);
+    ASSERT_EQ(batch->blobs.size(), stream->blobs.size());
+    for (int i = 0; i < slice_nqs.size(); i++) {
+        milvus::proto::schema::SearchResultData batch_data;
+        milvus::proto::schema::SearchResultData stream_data;
+        ASSERT_TRUE(batch_data.ParseFromArray(batch->blobs[i].data(), batch->blobs[i].size()));
+        ASSERT_TRUE(stream_data.ParseFromArray(stream->blobs[i].data(), stream->blobs[i].size()));
+        ASSERT_EQ(batch_data.num_queries(), stream_data.num_queries());
+        ASSERT_EQ(batch_data.top_k(), stream_data.top_k());
+        ASSERT_EQ(batch_data.topks().size(), stream_data.topks().size());
+        for (int j = 0; j < batch_data.topks().size(); j++) {
+            ASSERT_EQ(batch_data.topks().at(j), stream_data.topks().at(j));
+        }
+        ASSERT_EQ(batch_data.scores().size(), stream_data.scores().size());
+        for (int j = 0; j < batch_data.scores().size(); j++) {
+            ASSERT_EQ(batch_data.scores().at(j), stream_data.scores().at(j));
+        }
+        ASSERT_EQ(batch_data.ids().int_id().data_size(), stream_data.ids().int_id().data_size());
+        for (int j = 0; j < batch_data.ids().int_id().data_size(); j++) {
+            ASSERT_EQ(batch_data.ids().int_id().data(j), stream_data.ids().int_id().data(j));
+        }
+    }
+
+    // adding after finish must fail instead of corrupting the session
+    status = StreamReduceAddSearchResult(stream_reduce, stream_results[0]);
+    ASSERT_NE(status.error_code, Success);
+    free((char*)status.error_msg);
+
+    DeleteSearchResultDataBlobs(batch_blobs);
+    DeleteSearchResultDataBlobs(stream_blobs);
+    DeleteStreamReduce(stream_reduce);
+    for (int i = 0; i < 2; i++) {
+        DeleteSearchResult(batch_results[i]);
+        DeleteSearchResult(stream_results[i]);
+    }
+    DeleteSearchPlan(plan);
+    DeletePlaceholderGroup(placeholderGroup);
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
 TEST(CApiTest, LoadIndexInfo) {
     // generator index
     constexpr auto TOPK = 10;
@@ -1406,6 +2375,113 @@ TEST(CApiTest, LoadIndexInfo) {
     DeleteLoadIndexInfo(c_load_index_info);
 }
 
+TEST(CApiTest, LoadIndexInfoSlices) {
+    // same index as LoadIndexInfo, loaded through the batched slice API
+    constexpr auto TOPK = 10;
+
+    auto N = 1024 * 10;
+    auto [raw_data, timestamps, uids] = generate_data(N);
+    auto indexing = std::make_shared<knowhere::IVFPQ>();
+    auto conf = knowhere::Config{{knowhere::meta::METRIC_TYPE, knowhere::metric::L2},
+                                 {knowhere::meta::DIM, DIM},
+                                 {knowhere::meta::TOPK, TOPK},
+                                 {knowhere::indexparam::NLIST, 100},
+                                 {knowhere::indexparam::NPROBE, 4},
+                                 {knowhere::indexparam::M, 4},
+                                 {knowhere::indexparam::NBITS, 8},
+                                 {knowhere::meta::DEVICE_ID, 0}};
+
+    auto database = knowhere::GenDataset(N, DIM, raw_data.data());
+    indexing->Train(database, conf);
+    indexing->AddWithoutIds(database, conf);
+    auto binary_set = indexing->Serialize(conf);
+
+    std::vector<const char*> keys;
+    std::vector<const uint8_t*> datas;
+    std::vector<int64_t> sizes;
+    for (auto& [key, binary] : binary_set.binary_map_) {
+        keys.push_back(key.c_str());
+        datas.push_back(binary->data.get());
+        sizes.push_back(binary->size);
+    }
+
+    void* c_load_index_info = nullptr;
+    auto status = NewLoadIndexInfo(&c_load_index_info);
+    assert(status.error_code == Success);
+    std::string index_param_key1 = "index_type";
+    std::string index_param_value1 = "IVF_PQ";
+    status = AppendIndexParam(c_load_index_info, index_param_key1.data(), index_param_value1.data());
+    std::string index_param_key2 = "index_mode";
+    std::string index_param_value2 = "cpu";
+    status = AppendIndexParam(c_load_index_info, index_param_key2.data(), index_param_value2.data());
+    assert(status.error_code == Success);
+    status = AppendFieldInfo(c_load_index_info, 0, CDataType::FloatVector);
+    assert(status.error_code == Success);
+    status = AppendIndexSlices(c_load_index_info, keys.data(), datas.data(), sizes.data(), int64_t(keys.size()));
+    assert(status.error_code == Success);
+    auto loaded = ((LoadIndexInfo*)c_load_index_info)->index;
+    ASSERT_NE(loaded, nullptr);
+    ASSERT_EQ(std::dynamic_pointer_cast<knowhere::VecIndex>(loaded)->Count(), N);
+    DeleteLoadIndexInfo(c_load_index_info);
+}
+
+TEST(CApiTest, LoadIndexInfoSlicesHugepages) {
+    // the hugepage staging path must load identically; without reserved
+    // 2 MiB pages the arena falls back to THP-advised slabs, so the test
+    // holds on any host
+    constexpr auto TOPK = 10;
+
+    auto N = 1024 * 10;
+    auto [raw_data, timestamps, uids] = generate_data(N);
+    auto indexing = std::make_shared<knowhere::IVFPQ>();
+    auto conf = knowhere::Config{{knowhere::meta::METRIC_TYPE, knowhere::metric::L2},
+                                 {knowhere::meta::DIM, DIM},
+                                 {knowhere::meta::TOPK, TOPK},
+                                 {knowhere::indexparam::NLIST, 100},
+                                 {knowhere::indexparam::NPROBE, 4},
+                                 {knowhere::indexparam::M, 4},
+                                 {knowhere::indexparam::NBITS, 8},
+                                 {knowhere::meta::DEVICE_ID, 0}};
+
+    auto database = knowhere::GenDataset(N, DIM, raw_data.data());
+    indexing->Train(database, conf);
+    indexing->AddWithoutIds(database, conf);
+    auto binary_set = indexing->Serialize(conf);
+
+    std::vector<const char*> keys;
+    std::vector<const uint8_t*> datas;
+    std::vector<int64_t> sizes;
+    for (auto& [key, binary] : binary_set.binary_map_) {
+        keys.push_back(key.c_str());
+        datas.push_back(binary->data.get());
+        sizes.push_back(binary->size);
+    }
+
+    void* c_load_index_info = nullptr;
+    auto status = NewLoadIndexInfo(&c_load_index_info);
+    assert(status.error_code == Success);
+    std::string index_param_key1 = "index_type";
+    std::string index_param_value1 = "IVF_PQ";
+    status = AppendIndexParam(c_load_index_info, index_param_key1.data(), index_param_value1.data());
+    std::string index_param_key2 = "index_mode";
+    std::string index_param_value2 = "cpu";
+    status = AppendIndexParam(c_load_index_info, index_param_key2.data(), index_param_value2.data());
+    assert(status.error_code == Success);
+    status = AppendFieldInfo(c_load_index_info, 0, CDataType::FloatVector);
+    assert(status.error_code == Success);
+    status = AppendIndexEnableHugepages(c_load_index_info, true);
+    assert(status.error_code == Success);
+    status = AppendIndexSlices(c_load_index_info, keys.data(), datas.data(), sizes.data(), int64_t(keys.size()));
+    assert(status.error_code == Success);
+    auto info = (LoadIndexInfo*)c_load_index_info;
+    ASSERT_NE(info->index, nullptr);
+    ASSERT_EQ(std::dynamic_pointer_cast<knowhere::VecIndex>(info->index)->Count(), N);
+    // every slice went through the arena; the stats say what backed it
+    ASSERT_NE(info->index_arena, nullptr);
+    ASSERT_GT(info->index_arena->allocated_bytes(), 0);
+    DeleteLoadIndexInfo(c_load_index_info);
+}
+
 TEST(CApiTest, LoadIndex_Search) {
     // generator index
     constexpr auto TOPK = 10;
@@ -2949,6 +4025,41 @@ TEST(CApiTest, SealedSegmentTest) {
     DeleteSegment(segment);
 }
 
+TEST(CApiTest, SealedSegmentLoadFieldDataOwnedTest) {
+    auto collection = NewCollection(get_default_schema_config());
+    auto segment = NewSegment(collection, Sealed, -1);
+
+    int N = 10000;
+    std::default_random_engine e(67);
+    auto ages = std::vector<int64_t>(N);
+    for (auto& age : ages) {
+        age = e() % 2000;
+    }
+    FieldMeta field_meta(FieldName("age"), FieldId(101), DataType::INT64);
+    auto array = CreateScalarDataArrayFrom(ages.data(), N, field_meta);
+    auto age_data = serialize(array.get());
+
+    auto load_info = CLoadFieldDataInfo{101, age_data.data(), age_data.size(), N};
+
+    int released = 0;
+    auto release_cb = [](void* ctx) { ++*static_cast<int*>(ctx); };
+    auto res = LoadFieldDataOwned(segment, load_info, release_cb, &released);
+    assert(res.error_code == Success);
+    ASSERT_EQ(released, 1);
+    auto count = GetRowCount(segment);
+    assert(count == N);
+
+    // failed loads must release the blob too
+    std::vector<uint8_t> garbage = {0xff, 0xff, 0xff, 0xff};
+    auto bad_info = CLoadFieldDataInfo{101, garbage.data(), garbage.size(), N};
+    res = LoadFieldDataOwned(segment, bad_info, release_cb, &released);
+    ASSERT_NE(res.error_code, Success);
+    ASSERT_EQ(released, 2);
+
+    DeleteCollection(collection);
+    DeleteSegment(segment);
+}
+
 TEST(CApiTest, SealedSegment_search_float_Predicate_Range) {
     constexpr auto TOPK = 5;
 
@@ -11,8 +11,10 @@
 
 #include <gtest/gtest.h>
 #include <segcore/ConcurrentVector.h>
+#include "common/KernelRegistry.h"
 #include "common/Types.h"
 #include "common/Span.h"
+#include "common/kernels/Kernels.h"
 
 TEST(Common, Span) {
     using namespace milvus;
@@ -28,3 +30,41 @@ TEST(Common, Span) {
     ASSERT_EQ(r2.row_count(), 10);
     ASSERT_EQ(r2.element_sizeof(), 16 * sizeof(float));
 }
+
+namespace {
+
+int
+ScalarKernel() {
+    return 0;
+}
+
+int
+Avx2Kernel() {
+    return 2;
+}
+
+}  // namespace
+
+TEST(Common, KernelRegistry) {
+    using namespace milvus;
+
+    KernelSlot<int()> slot;
+    ASSERT_EQ(slot.Get(), nullptr);
+
+    slot.Register(SimdLevel::Scalar, &ScalarKernel);
+    ASSERT_EQ(slot.Get(), &ScalarKernel);
+
+    slot.Register(SimdLevel::AVX2, &Avx2Kernel);
+    auto old_cap = GetSimdLevelCap();
+    SetSimdLevelCap(SimdLevel::AVX2);
+    ASSERT_EQ(slot.Get(), &Avx2Kernel);
+
+    // lowering the cap must take effect on the next resolution
+    SetSimdLevelCap(SimdLevel::Scalar);
+    ASSERT_EQ(slot.Get(), &ScalarKernel);
+    SetSimdLevelCap(old_cap);
+
+    // the kernel objects registered their builds at static-init time
+    ASSERT_NE(milvus::kernels::float32_to_float16_batch.Get(), nullptr);
+    ASSERT_NE(milvus::kernels::float16_to_float32_batch.Get(), nullptr);
+}
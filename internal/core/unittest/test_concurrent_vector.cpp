@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 #include <random>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
@@ -94,6 +95,95 @@ TEST(ConcurrentVector, TestMultithreads) {
     }
 }
 
+TEST(ConcurrentVector, TestChunkMinMax) {
+    ConcurrentVector<int64_t> c_vec(32);
+    std::vector<int64_t> values(48);
+    for (int i = 0; i < 48; ++i) {
+        values[i] = 1000 - i;
+    }
+    c_vec.set_data_raw(0, values.data(), 48);
+
+    int64_t min_value, max_value;
+    ASSERT_TRUE(c_vec.get_chunk_minmax(0, &min_value, &max_value));
+    ASSERT_EQ(min_value, 1000 - 31);
+    ASSERT_EQ(max_value, 1000);
+    ASSERT_TRUE(c_vec.get_chunk_minmax(1, &min_value, &max_value));
+    ASSERT_EQ(min_value, 1000 - 47);
+    ASSERT_EQ(max_value, 1000 - 32);
+
+    // later writes into the same chunk widen its recorded range
+    std::vector<int64_t> more{5000, -5000};
+    c_vec.set_data_raw(48, more.data(), 2);
+    ASSERT_TRUE(c_vec.get_chunk_minmax(1, &min_value, &max_value));
+    ASSERT_EQ(min_value, -5000);
+    ASSERT_EQ(max_value, 5000);
+
+    // string columns keep no statistics
+    ConcurrentVector<std::string> s_vec(32);
+    std::vector<std::string> strs{"a", "b"};
+    s_vec.set_data_raw(0, strs.data(), 2);
+    std::string_view lo, hi;
+    ASSERT_FALSE(s_vec.get_chunk_minmax(0, &lo, &hi));
+}
+
+TEST(ConcurrentVector, StringDictionary) {
+    ConcurrentVector<std::string> c_vec(32, nullptr, /*dictionary_encoded=*/true);
+    // enum-like column: 3 distinct values over 64 rows
+    std::vector<std::string> values(64);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = std::to_string(i % 3);
+    }
+    c_vec.set_data_raw(0, values.data(), values.size());
+    ASSERT_TRUE(c_vec.dictionary_encoded());
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        ASSERT_EQ(c_vec[i], values[i]) << i;
+    }
+
+    auto& chunk = c_vec.get_chunk(0);
+    ASSERT_TRUE(chunk.dictionary_encoded());
+    ASSERT_EQ(chunk.dict_size(), 3);
+    // rows with equal values share one code, and codes round-trip to views
+    auto codes = chunk.codes();
+    for (int64_t i = 0; i < 32; ++i) {
+        ASSERT_EQ(codes[i], codes[i % 3]);
+        ASSERT_EQ(chunk.dict_view(codes[i]), values[i]);
+    }
+    ASSERT_EQ(chunk.lookup_code("0"), codes[0]);
+    ASSERT_EQ(chunk.lookup_code("missing"), -1);
+    // the dense view array does not exist in dictionary mode
+    ASSERT_ANY_THROW(chunk.data());
+}
+
+TEST(ConcurrentVector, ReleaseChunk) {
+    auto dim = 8;
+    int64_t size_per_chunk = 1024;  // 32 KiB chunks, so whole pages sit inside
+    ConcurrentVectorImpl<float, false> c_vec(dim, size_per_chunk);
+    std::vector<float> data(3 * size_per_chunk * dim);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<float>(i);
+    }
+    c_vec.set_data_raw(0, data.data(), 3 * size_per_chunk);
+    ASSERT_FALSE(c_vec.chunk_released(0));
+    ASSERT_EQ(c_vec.num_released_chunks(), 0);
+
+    // heap chunks are private anonymous memory, so the release must drop
+    // at least the chunk's interior pages while the addresses stay valid
+    auto released = c_vec.release_chunk(1);
+    ASSERT_GT(released, 0);
+    ASSERT_TRUE(c_vec.chunk_released(1));
+    ASSERT_FALSE(c_vec.chunk_released(0));
+    ASSERT_FALSE(c_vec.chunk_released(2));
+    ASSERT_EQ(c_vec.num_released_chunks(), 1);
+
+    // neighbouring chunks are untouched and the released chunk still
+    // dereferences without faulting
+    ASSERT_EQ(c_vec.get_element(0)[0], 0.0f);
+    auto last = 3 * size_per_chunk - 1;
+    ASSERT_EQ(c_vec.get_element(last)[dim - 1], static_cast<float>(last * dim + dim - 1));
+    (void)c_vec.get_element(size_per_chunk + 1)[0];
+}
+
 TEST(ConcurrentVector, TestAckSingle) {
     std::vector<std::tuple<int64_t, int64_t, int64_t>> raw_data;
     std::default_random_engine e(42);
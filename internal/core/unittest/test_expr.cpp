@@ -13,7 +13,11 @@
 #include <gtest/gtest.h>
 #include <regex>
 
+#include "common/ThreadPool.h"
 #include "query/Expr.h"
+#include "query/ExprImpl.h"
+#include "query/LoweredExpr.h"
+#include "query/generated/FusedExprEval.h"
 #include "query/Plan.h"
 #include "query/PlanNode.h"
 #include "query/generated/ShowPlanNodeVisitor.h"
@@ -508,6 +512,247 @@ TEST(Expr, TestSimpleDsl) {
     }
 }
 
+TEST(Expr, TestLoweredConjunction) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    auto i32_fid = schema->AddDebugField("income", DataType::INT32);
+    schema->set_primary_field_id(i64_fid);
+
+    auto seg = CreateGrowingSegment(schema);
+    // a single open chunk: no per-chunk scalar index yet, so the lowered
+    // path is eligible for every field
+    int N = 1000;
+    auto raw_data = DataGen(schema, N);
+    seg->PreInsert(N);
+    seg->Insert(0, N, raw_data.row_ids_.data(), raw_data.timestamps_.data(), raw_data.raw_);
+
+    auto seg_promote = dynamic_cast<SegmentGrowingImpl*>(seg.get());
+    auto row_count = seg_promote->get_row_count();
+    ExecExprVisitor visitor(*seg_promote, row_count, MAX_TIMESTAMP);
+
+    auto make_and = [](ExprPtr left, ExprPtr right) -> ExprPtr {
+        return std::make_unique<LogicalBinaryExpr>(LogicalBinaryExpr::OpType::LogicalAnd, left, right);
+    };
+    auto age_range = [&](OpType op, int64_t val) -> ExprPtr {
+        return std::make_unique<UnaryRangeExprImpl<int64_t>>(i64_fid, DataType::INT64, op, val);
+    };
+    auto income_range = [&](OpType op, int32_t val) -> ExprPtr {
+        return std::make_unique<UnaryRangeExprImpl<int32_t>>(i32_fid, DataType::INT32, op, val);
+    };
+
+    // lowered execution must agree bit for bit with the visitor tree
+    auto check = [&](ExprPtr expr) {
+        auto lowered = TryExecLoweredExpr(*seg_promote, row_count, *expr);
+        ASSERT_TRUE(lowered.has_value());
+        auto ref = visitor.call_child(*expr);
+        ASSERT_EQ(lowered->size(), ref.size());
+        for (int64_t i = 0; i < row_count; ++i) {
+            ASSERT_EQ((*lowered)[i], ref[i]) << "@" << i;
+        }
+    };
+
+    // same-field conjunction with a NotEqual hole
+    check(make_and(make_and(age_range(OpType::GreaterEqual, 10), age_range(OpType::LessThan, 1500)),
+                   age_range(OpType::NotEqual, 42)));
+    // cross-field conjunction
+    check(make_and(age_range(OpType::GreaterEqual, 0), income_range(OpType::LessThan, 500)));
+
+    // interval intersection proves this one empty without scanning
+    auto empty = TryExecLoweredExpr(
+        *seg_promote, row_count,
+        *make_and(age_range(OpType::GreaterThan, 100), age_range(OpType::LessThan, 50)));
+    ASSERT_TRUE(empty.has_value());
+    ASSERT_TRUE(empty->none());
+
+    // disjunctions don't lower; they stay on the visitor path
+    ExprPtr left = age_range(OpType::GreaterEqual, 10);
+    ExprPtr right = age_range(OpType::LessThan, 5);
+    auto or_expr = std::make_unique<LogicalBinaryExpr>(LogicalBinaryExpr::OpType::LogicalOr, left, right);
+    ASSERT_FALSE(TryExecLoweredExpr(*seg_promote, row_count, *or_expr).has_value());
+}
+
+TEST(Expr, TestFusedConjunction) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    auto bound_fid = schema->AddDebugField("bound", DataType::INT64);
+    auto ts_fid = schema->AddDebugField("ts", DataType::INT64);
+    auto i32_fid = schema->AddDebugField("income", DataType::INT32);
+    schema->set_primary_field_id(i64_fid);
+
+    auto seg = CreateGrowingSegment(schema);
+    // fused kernels only run on raw chunks; keep the small per-chunk
+    // indexes out of the way so every pair stays eligible
+    seg->disable_small_index();
+    int N = 1000;
+    int num_iters = 40;
+    for (int iter = 0; iter < num_iters; ++iter) {
+        auto raw_data = DataGen(schema, N, iter);
+        seg->PreInsert(N);
+        seg->Insert(iter * N, N, raw_data.row_ids_.data(), raw_data.timestamps_.data(), raw_data.raw_);
+    }
+
+    auto seg_promote = dynamic_cast<SegmentGrowingImpl*>(seg.get());
+    auto row_count = seg_promote->get_row_count();
+    ExecExprVisitor visitor(*seg_promote, row_count, MAX_TIMESTAMP);
+
+    // fused evaluation must agree bit for bit with the two split scans
+    auto check = [&](ExprPtr left, ExprPtr right) {
+        auto fused = TryFusedConjunction(*seg_promote, row_count, *left, *right);
+        ASSERT_TRUE(fused.has_value());
+        auto ref = visitor.call_child(*left);
+        ref &= visitor.call_child(*right);
+        ASSERT_EQ(fused->size(), ref.size());
+        for (int64_t i = 0; i < row_count; ++i) {
+            ASSERT_EQ((*fused)[i], ref[i]) << "@" << i;
+        }
+    };
+
+    auto age_term = [&](std::vector<int64_t> terms) -> ExprPtr {
+        return std::make_unique<TermExprImpl<int64_t>>(i64_fid, DataType::INT64, terms);
+    };
+    auto ts_range = [&](OpType op, int64_t val) -> ExprPtr {
+        return std::make_unique<UnaryRangeExprImpl<int64_t>>(ts_fid, DataType::INT64, op, val);
+    };
+    auto age_less_bound = [&]() -> ExprPtr {
+        auto compare = std::make_unique<CompareExpr>();
+        compare->left_field_id_ = i64_fid;
+        compare->right_field_id_ = bound_fid;
+        compare->left_data_type_ = DataType::INT64;
+        compare->right_data_type_ = DataType::INT64;
+        compare->op_type_ = OpType::LessThan;
+        return compare;
+    };
+
+    // term ∧ unary range, both orders
+    check(age_term({1, 5, 111, 2048}), ts_range(OpType::GreaterEqual, 3));
+    check(ts_range(OpType::LessThan, 700), age_term({2, 4, 6, 8, 10}));
+    // term ∧ binary range
+    {
+        ExprPtr term = age_term({3, 7, 500});
+        ExprPtr range = std::make_unique<BinaryRangeExprImpl<int64_t>>(ts_fid, DataType::INT64, true, false, 2, 800);
+        check(std::move(term), std::move(range));
+    }
+    // compare ∧ unary range, both orders
+    check(age_less_bound(), ts_range(OpType::NotEqual, 10));
+    check(ts_range(OpType::GreaterThan, 5), age_less_bound());
+
+    // mixed scalar types never fuse; the split path stays authoritative
+    ExprPtr term = age_term({1, 2});
+    ExprPtr other = std::make_unique<UnaryRangeExprImpl<int32_t>>(i32_fid, DataType::INT32, OpType::LessThan, 100);
+    ASSERT_FALSE(TryFusedConjunction(*seg_promote, row_count, *term, *other).has_value());
+}
+
+TEST(Expr, TestCancellationCheckpoint) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    auto seg = CreateGrowingSegment(schema);
+    int N = 1000;
+    auto raw_data = DataGen(schema, N);
+    seg->PreInsert(N);
+    seg->Insert(0, N, raw_data.row_ids_.data(), raw_data.timestamps_.data(), raw_data.raw_);
+
+    auto seg_promote = dynamic_cast<SegmentGrowingImpl*>(seg.get());
+    auto row_count = seg_promote->get_row_count();
+
+    auto expr = std::make_unique<UnaryRangeExprImpl<int64_t>>(i64_fid, DataType::INT64, OpType::GreaterEqual, 100);
+
+    // an inert (default) token never fires, so plain evaluation still runs
+    {
+        ExecExprVisitor visitor(*seg_promote, row_count, MAX_TIMESTAMP);
+        auto res = visitor.call_child(*expr);
+        ASSERT_EQ(res.size(), row_count);
+    }
+
+    // a fired token installed in the task options stops the scan at its
+    // first chunk checkpoint
+    {
+        auto token = milvus::CancellationToken::Make();
+        token.Cancel();
+        auto options = milvus::ScopedTaskOptions::Current();
+        options.cancellation = token;
+        milvus::ScopedTaskOptions scope(options);
+        ExecExprVisitor visitor(*seg_promote, row_count, MAX_TIMESTAMP);
+        ASSERT_THROW(visitor.call_child(*expr), milvus::CancelledException);
+    }
+
+    // the scope restored the inert token, so evaluation works again
+    {
+        ExecExprVisitor visitor(*seg_promote, row_count, MAX_TIMESTAMP);
+        auto res = visitor.call_child(*expr);
+        ASSERT_EQ(res.size(), row_count);
+    }
+}
+
+TEST(Expr, TestLazyNegation) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    auto seg = CreateGrowingSegment(schema);
+    int N = 1000;
+    auto raw_data = DataGen(schema, N);
+    seg->PreInsert(N);
+    seg->Insert(0, N, raw_data.row_ids_.data(), raw_data.timestamps_.data(), raw_data.raw_);
+    auto age_col = raw_data.get_col<int64_t>(i64_fid);
+
+    auto seg_promote = dynamic_cast<SegmentGrowingImpl*>(seg.get());
+    auto row_count = seg_promote->get_row_count();
+
+    auto make_not = [](ExprPtr child) -> ExprPtr {
+        return std::make_unique<LogicalUnaryExpr>(LogicalUnaryExpr::OpType::LogicalNot, child);
+    };
+    auto make_bin = [](LogicalBinaryExpr::OpType op, ExprPtr left, ExprPtr right) -> ExprPtr {
+        return std::make_unique<LogicalBinaryExpr>(op, left, right);
+    };
+    auto age_range = [&](OpType op, int64_t val) -> ExprPtr {
+        return std::make_unique<UnaryRangeExprImpl<int64_t>>(i64_fid, DataType::INT64, op, val);
+    };
+
+    auto check = [&](ExprPtr expr, std::function<bool(int64_t)> ref) {
+        ExecExprVisitor visitor(*seg_promote, row_count, MAX_TIMESTAMP);
+        auto res = visitor.call_child(*expr);
+        ASSERT_EQ(res.size(), row_count);
+        for (int64_t i = 0; i < row_count; ++i) {
+            ASSERT_EQ(res[i], ref(age_col[i])) << "@" << i;
+        }
+    };
+
+    using BinOp = LogicalBinaryExpr::OpType;
+    // NOT of NOT cancels without any pass over the bits
+    check(make_not(make_not(age_range(OpType::GreaterEqual, 100))), [](int64_t v) { return v >= 100; });
+    // deferred complements fold into every connective
+    check(make_bin(BinOp::LogicalAnd, make_not(age_range(OpType::LessThan, 100)), age_range(OpType::LessThan, 2000)),
+          [](int64_t v) { return !(v < 100) && v < 2000; });
+    check(make_bin(BinOp::LogicalOr, make_not(age_range(OpType::GreaterEqual, 100)),
+                   make_not(age_range(OpType::LessThan, 2000))),
+          [](int64_t v) { return !(v >= 100) || !(v < 2000); });
+    check(make_bin(BinOp::LogicalXor, make_not(age_range(OpType::GreaterEqual, 100)), age_range(OpType::LessThan, 500)),
+          [](int64_t v) { return !(v >= 100) != (v < 500); });
+    check(make_bin(BinOp::LogicalMinus, age_range(OpType::LessThan, 2000), make_not(age_range(OpType::LessThan, 100))),
+          [](int64_t v) { return v < 2000 && v < 100; });
+    // complement above a connective
+    check(make_not(make_bin(BinOp::LogicalAnd, age_range(OpType::GreaterEqual, 100), age_range(OpType::LessThan, 500))),
+          [](int64_t v) { return !(v >= 100 && v < 500); });
+}
+
 TEST(Expr, TestCompare) {
     using namespace milvus::query;
     using namespace milvus::segcore;
@@ -0,0 +1,214 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "common/Float16.h"
+#include "query/SearchBruteForce.h"
+#include "query/SearchOnGrowing.h"
+#include "segcore/ConcurrentVector.h"
+#include "segcore/SegmentGrowing.h"
+#include "segcore/SegmentGrowingImpl.h"
+#include "test_utils/DataGen.h"
+#include "test_utils/Distance.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+using namespace milvus::query;
+
+TEST(Float16, KnownValues) {
+    ASSERT_EQ(Float32ToFloat16(0.0f), 0x0000);
+    ASSERT_EQ(Float32ToFloat16(-0.0f), 0x8000);
+    ASSERT_EQ(Float32ToFloat16(1.0f), 0x3c00);
+    ASSERT_EQ(Float32ToFloat16(-2.0f), 0xc000);
+    // largest finite half, then overflow to infinity
+    ASSERT_EQ(Float32ToFloat16(65504.0f), 0x7bff);
+    ASSERT_EQ(Float32ToFloat16(65536.0f), 0x7c00);
+    // below half the smallest subnormal everything flushes to signed zero
+    ASSERT_EQ(Float32ToFloat16(1e-8f), 0x0000);
+    ASSERT_EQ(Float32ToFloat16(-1e-8f), 0x8000);
+
+    ASSERT_EQ(Float16ToFloat32(0x7c00), std::numeric_limits<float>::infinity());
+    ASSERT_TRUE(std::isnan(Float16ToFloat32(0x7e00)));
+    // smallest subnormal half is 2^-24
+    ASSERT_EQ(Float16ToFloat32(0x0001), std::ldexp(1.0f, -24));
+}
+
+TEST(Float16, ScalarRoundTrip) {
+    // every half pattern must survive half -> float -> half unchanged;
+    // NaNs only need to stay NaNs (conversion quiets them)
+    for (uint32_t h = 0; h < 0x10000; ++h) {
+        auto f = Float16ToFloat32(static_cast<uint16_t>(h));
+        if (std::isnan(f)) {
+            ASSERT_TRUE(std::isnan(Float16ToFloat32(Float32ToFloat16(f))));
+            continue;
+        }
+        ASSERT_EQ(Float32ToFloat16(f), static_cast<uint16_t>(h)) << "half pattern " << h;
+    }
+}
+
+TEST(Float16, BatchMatchesScalar) {
+    std::default_random_engine er(42);
+    std::uniform_real_distribution<float> distribution(-100.0, 100.0);
+    // odd length exercises the vectorized body and its scalar tail
+    size_t n = 1027;
+    std::vector<float> src(n);
+    for (auto& x : src) {
+        x = distribution(er);
+    }
+
+    std::vector<uint16_t> batch_halfs(n);
+    Float32ToFloat16Batch(src.data(), batch_halfs.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(batch_halfs[i], Float32ToFloat16(src[i]));
+    }
+
+    std::vector<float> batch_floats(n);
+    Float16ToFloat32Batch(batch_halfs.data(), batch_floats.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(batch_floats[i], Float16ToFloat32(batch_halfs[i]));
+    }
+}
+
+TEST(Float16, ConcurrentVectorStoresHalf) {
+    int64_t dim = 8;
+    int64_t n = 100;
+    ConcurrentVector<Float16Vector> vec(dim, 32);
+
+    std::default_random_engine er(67);
+    std::uniform_real_distribution<float> distribution(-1.0, 1.0);
+    std::vector<float> source(n * dim);
+    for (auto& x : source) {
+        x = distribution(er);
+    }
+    vec.set_data_raw(0, source.data(), n);
+
+    for (int64_t i = 0; i < n; ++i) {
+        auto row = vec.get_element(i);
+        for (int64_t d = 0; d < dim; ++d) {
+            ASSERT_EQ(row[d], Float32ToFloat16(source[i * dim + d]));
+        }
+    }
+}
+
+class TestFp16BruteForce : public ::testing::Test {
+ public:
+    void
+    Run(int nb, int nq, int topk, int dim, const knowhere::MetricType& metric_type) {
+        auto bitset = std::make_shared<BitsetType>();
+        bitset->resize(nb);
+        auto bitset_view = BitsetView(*bitset);
+
+        auto schema = std::make_shared<Schema>();
+        auto fvec = schema->AddDebugField("fvec", DataType::VECTOR_FLOAT, dim, metric_type);
+        auto base = DataGen(schema, nb, 42).get_col<float>(fvec);
+        auto query = DataGen(schema, nq, 43).get_col<float>(fvec);
+
+        std::vector<uint16_t> halfs(base.size());
+        Float32ToFloat16Batch(base.data(), halfs.data(), halfs.size());
+        // the reference ranking is over what the index actually stores:
+        // the half-rounded values
+        std::vector<float> decoded(base.size());
+        Float16ToFloat32Batch(halfs.data(), decoded.data(), decoded.size());
+
+        dataset::SearchDataset dataset{metric_type, nq, topk, -1, dim, query.data()};
+        auto sub_qr = BruteForceSearchFp16(dataset, halfs.data(), nb, bitset_view);
+        ASSERT_TRUE(sub_qr.ok()) << sub_qr.status().ToString();
+        auto& result = sub_qr.value();
+
+        for (int q = 0; q < nq; ++q) {
+            std::vector<std::pair<float, int>> ref;
+            for (int i = 0; i < nb; ++i) {
+                auto d = metric_type == knowhere::metric::L2 ? L2(decoded.data() + i * dim, query.data() + q * dim, dim)
+                                                             : -IP(decoded.data() + i * dim, query.data() + q * dim, dim);
+                ref.emplace_back(d, i);
+            }
+            std::sort(ref.begin(), ref.end());
+            auto ans = result.get_seg_offsets() + q * topk;
+            for (int k = 0; k < topk; ++k) {
+                ASSERT_EQ(ans[k], ref[k].second) << "query " << q << " rank " << k;
+            }
+        }
+    }
+};
+
+TEST_F(TestFp16BruteForce, L2) {
+    Run(100, 10, 5, 128, knowhere::metric::L2);
+}
+
+TEST_F(TestFp16BruteForce, IP) {
+    Run(100, 10, 5, 128, knowhere::metric::IP);
+}
+
+TEST_F(TestFp16BruteForce, OddDim) {
+    Run(200, 5, 3, 13, knowhere::metric::L2);
+}
+
+TEST(Float16, GrowingSegmentFp16Storage) {
+    int64_t dim = 16;
+    int64_t n = 200;
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    auto vec = schema->AddDebugField("embeddings", DataType::VECTOR_FLOAT, dim, knowhere::metric::L2);
+    schema->set_primary_field_id(pk);
+
+    SegcoreConfig config = SegcoreConfig::default_config();
+    config.set_fp16_vector_storage(true);
+    auto segment = CreateGrowingSegment(schema, -1, config);
+    auto segment_impl = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+
+    auto dataset = DataGen(schema, n);
+    auto offset = segment->PreInsert(n);
+    segment->Insert(offset, n, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    // the column really holds half bits
+    auto vec_base = segment_impl->get_insert_record().get_field_data_base(vec);
+    ASSERT_NE(dynamic_cast<const ConcurrentVector<Float16Vector>*>(vec_base), nullptr);
+
+    // bulk_subscript up-converts; values match the source after one
+    // round trip through half precision
+    auto source = dataset.get_col<float>(vec);
+    std::vector<int64_t> offsets = {0, 7, 33, n - 1};
+    auto array = segment_impl->bulk_subscript(vec, offsets.data(), offsets.size());
+    auto& out = array->vectors().float_vector().data();
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        for (int64_t d = 0; d < dim; ++d) {
+            auto src = source[offsets[i] * dim + d];
+            ASSERT_EQ(out[i * dim + d], Float16ToFloat32(Float32ToFloat16(src)));
+        }
+    }
+
+    // a query equal to one stored row must come back as the top hit
+    // through the fp16 brute-force scan
+    query::SearchInfo info;
+    info.topk_ = 5;
+    info.round_decimal_ = -1;
+    info.field_id_ = vec;
+    info.metric_type_ = knowhere::metric::L2;
+    auto query_row = source.data() + 7 * dim;
+    auto bitset = std::make_shared<BitsetType>();
+    bitset->resize(n);
+    SearchResult result;
+    auto status = query::SearchOnGrowing(*segment_impl, info, query_row, 1, std::numeric_limits<Timestamp>::max(),
+                                         BitsetView(*bitset), result);
+    ASSERT_TRUE(status.ok()) << status.ToString();
+    ASSERT_EQ(result.seg_offsets_[0], 7);
+
+    // accounting reflects the halved column
+    auto fp32_segment = CreateGrowingSegment(schema, -1, SegcoreConfig::default_config());
+    auto fp32_offset = fp32_segment->PreInsert(n);
+    fp32_segment->Insert(fp32_offset, n, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+    ASSERT_EQ(segment_impl->GetFieldMemoryUsageInBytes(vec) * 2,
+              dynamic_cast<SegmentGrowingImpl*>(fp32_segment.get())->GetFieldMemoryUsageInBytes(vec));
+}
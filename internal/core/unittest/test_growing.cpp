@@ -10,6 +10,9 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <numeric>
+#include <thread>
 
 #include "segcore/SegmentGrowing.h"
 #include "segcore/SegmentGrowingImpl.h"
@@ -40,6 +43,204 @@ TEST(Growing, DeleteCount) {
     ASSERT_EQ(cnt, c);
 }
 
+TEST(Growing, AdaptiveChunkRows) {
+    auto& config = SegcoreConfig::default_config();
+
+    // 1536-dim float rows are 6 KB wide: full 32k-row chunks would be
+    // ~200 MB, so the width-adaptive policy halves the row count until the
+    // widest field's chunk fits the byte budget
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->AddDebugField("hugevec", DataType::VECTOR_FLOAT, 1536, knowhere::metric::L2);
+    schema->set_primary_field_id(pk);
+    auto segment = CreateGrowingSegment(schema);
+    auto segment_impl = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+    auto rows = segment_impl->size_per_chunk();
+    ASSERT_LT(rows, config.get_chunk_rows());
+    ASSERT_LE(rows * 1536 * 4, config.get_target_chunk_bytes());
+    ASSERT_GE(rows, 1024);
+
+    // narrow schemas keep the configured chunk rows
+    auto narrow_schema = std::make_shared<Schema>();
+    auto narrow_pk = narrow_schema->AddDebugField("pk", DataType::INT64);
+    narrow_schema->set_primary_field_id(narrow_pk);
+    auto narrow_segment = CreateGrowingSegment(narrow_schema);
+    auto narrow_impl = dynamic_cast<SegmentGrowingImpl*>(narrow_segment.get());
+    ASSERT_EQ(narrow_impl->size_per_chunk(), config.get_chunk_rows());
+}
+
+TEST(Growing, ConcurrentInsert) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto segment = CreateGrowingSegment(schema);
+    auto segment_impl = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+
+    // each writer reserves its own range and publishes its pks as a batch;
+    // nothing may be lost or misplaced when lanes run concurrently
+    int64_t per_thread = 1000;
+    int num_threads = 4;
+    std::vector<std::vector<int64_t>> all_pks(num_threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            auto dataset = DataGen(schema, per_thread, t);
+            auto offset = segment->PreInsert(per_thread);
+            segment->Insert(offset, per_thread, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+            all_pks[t] = dataset.get_col<int64_t>(pk);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto total = per_thread * num_threads;
+    ASSERT_EQ(segment->get_row_count(), total);
+    auto& record = segment_impl->get_insert_record();
+    ASSERT_EQ(record.ack_responder_.GetAck(), total);
+    for (auto& pks : all_pks) {
+        for (auto value : pks) {
+            ASSERT_FALSE(record.search_pk(value, total).empty()) << value;
+        }
+    }
+}
+
+TEST(Growing, BulkImport) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    auto vec = schema->AddDebugField("vec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    schema->set_primary_field_id(pk);
+    auto segment = CreateGrowingSegment(schema);
+    auto segment_impl = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+
+    int64_t n = 10000;
+    std::vector<int64_t> row_ids(n);
+    std::vector<Timestamp> tss(n);
+    std::vector<int64_t> pks(n);
+    std::vector<float> vectors(n * 16, 1.0f);
+    for (int64_t i = 0; i < n; ++i) {
+        row_ids[i] = i;
+        tss[i] = 100 + i;
+        pks[i] = i;  // import files flush the pk column sorted
+    }
+    std::vector<InsertColumnView> columns{
+        InsertColumnView{pk, pks.data(), nullptr},
+        InsertColumnView{vec, vectors.data(), nullptr},
+    };
+    segment->BulkImport(n, row_ids.data(), tss.data(), columns);
+
+    ASSERT_EQ(segment->get_row_count(), n);
+    auto& record = segment_impl->get_insert_record();
+    for (int64_t value : {int64_t(0), n / 2, n - 1}) {
+        auto offsets = record.search_pk(value, n);
+        ASSERT_EQ(offsets.size(), 1);
+        ASSERT_EQ(offsets[0].get(), value);
+    }
+    // the import sealed the segment against further batches
+    ASSERT_ANY_THROW(segment->PreInsert(1));
+}
+
+TEST(Growing, BulkImportUnsortedPks) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto segment = CreateGrowingSegment(schema);
+    auto segment_impl = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+
+    // an unsorted pk column takes the sliced parallel build; every pk must
+    // still resolve to its row
+    int64_t n = 5000;
+    std::vector<int64_t> row_ids(n);
+    std::vector<Timestamp> tss(n);
+    std::vector<int64_t> pks(n);
+    for (int64_t i = 0; i < n; ++i) {
+        row_ids[i] = i;
+        tss[i] = 100 + i;
+        pks[i] = n - 1 - i;
+    }
+    std::vector<InsertColumnView> columns{InsertColumnView{pk, pks.data(), nullptr}};
+    segment->BulkImport(n, row_ids.data(), tss.data(), columns);
+
+    ASSERT_EQ(segment->get_row_count(), n);
+    auto& record = segment_impl->get_insert_record();
+    for (int64_t i = 0; i < n; i += 97) {
+        auto offsets = record.search_pk(pks[i], n);
+        ASSERT_EQ(offsets.size(), 1) << pks[i];
+        ASSERT_EQ(offsets[0].get(), i);
+    }
+}
+
+TEST(Growing, TailChunkSnapshot) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    auto vec = schema->AddDebugField("embeddings", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    schema->set_primary_field_id(pk);
+    auto segment = CreateGrowingSegment(schema);
+    auto segment_impl = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+
+    int64_t n = 1000;
+    auto dataset = DataGen(schema, n);
+    auto offset = segment->PreInsert(n);
+    segment->Insert(offset, n, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    // the copy must match the live chunk and be shared while the barrier
+    // stays put
+    auto snapshot = segment_impl->get_tail_chunk_snapshot(vec, 0, n);
+    ASSERT_EQ(snapshot->visible_rows, n);
+    auto vec_ptr = segment_impl->get_insert_record().get_field_data_base(vec);
+    ASSERT_EQ(memcmp(snapshot->data.data(), vec_ptr->get_chunk_data(0), n * 16 * sizeof(float)), 0);
+    auto again = segment_impl->get_tail_chunk_snapshot(vec, 0, n);
+    ASSERT_EQ(snapshot.get(), again.get());
+
+    // once the barrier advances a fresh copy covers the new rows
+    auto dataset2 = DataGen(schema, n, 17);
+    auto offset2 = segment->PreInsert(n);
+    segment->Insert(offset2, n, dataset2.row_ids_.data(), dataset2.timestamps_.data(), dataset2.raw_);
+    auto wider = segment_impl->get_tail_chunk_snapshot(vec, 0, 2 * n);
+    ASSERT_EQ(wider->visible_rows, 2 * n);
+    ASSERT_EQ(memcmp(wider->data.data(), vec_ptr->get_chunk_data(0), 2 * n * 16 * sizeof(float)), 0);
+
+    // an older barrier is served by the newer snapshot
+    auto older = segment_impl->get_tail_chunk_snapshot(vec, 0, n);
+    ASSERT_EQ(older.get(), wider.get());
+}
+
+TEST(Growing, StagedDeleteMerge) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto segment = CreateGrowingSegment(schema);
+    auto segment_impl = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+
+    int64_t c = 10;
+    auto offset = segment->PreInsert(c);
+    auto dataset = DataGen(schema, c);
+    auto pks = dataset.get_col<int64_t>(pk);
+    segment->Insert(offset, c, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    // deliver the second reservation first: it must park until the gap in
+    // front of it is filled, keeping the acked log contiguous
+    auto del_offset1 = segment->PreDelete(3);
+    auto del_offset2 = segment->PreDelete(3);
+    ASSERT_EQ(del_offset2, 3);
+    auto late_ids = GenPKs(pks.begin() + 3, pks.begin() + 6);
+    std::vector<Timestamp> late_tss = {c + 6, c + 4, c + 5};
+    ASSERT_TRUE(segment->Delete(del_offset2, 3, late_ids.get(), late_tss.data()).ok());
+    auto& record = segment_impl->get_deleted_record();
+    ASSERT_EQ(record.ack_responder_.GetAck(), 0);
+
+    auto early_ids = GenPKs(pks.begin(), pks.begin() + 3);
+    std::vector<Timestamp> early_tss = {c + 3, c + 1, c + 2};
+    ASSERT_TRUE(segment->Delete(del_offset1, 3, early_ids.get(), early_tss.data()).ok());
+
+    // both batches published as one run, globally sorted by timestamp
+    ASSERT_EQ(record.ack_responder_.GetAck(), 6);
+    for (int64_t i = 0; i + 1 < 6; ++i) {
+        ASSERT_LE(record.timestamps_[i], record.timestamps_[i + 1]) << "@" << i;
+    }
+    ASSERT_EQ(segment->get_real_count(), c - 6);
+}
+
 TEST(Growing, RealCount) {
     auto schema = std::make_shared<Schema>();
     auto pk = schema->AddDebugField("pk", DataType::INT64);
@@ -83,3 +284,111 @@ TEST(Growing, RealCount) {
     ASSERT_TRUE(status.ok());
     ASSERT_EQ(0, segment->get_real_count());
 }
+
+TEST(Growing, EvictIndexedRawChunks) {
+    // small chunks, an exhaustive IVF and the eviction mode on; once the
+    // builds land, raw chunks inside compacted runs may be dropped and
+    // retrieval must come back identical out of the per-chunk indexes
+    SegcoreConfig config = SegcoreConfig::default_config();
+    config.set_chunk_rows(256);
+    config.set_nlist(16);
+    config.set_nprobe(16);
+    config.set_evict_indexed_vector_chunks(true);
+
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField("embeddings", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+
+    int64_t dim = 16;
+    int64_t N = 256 * 17;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateGrowingSegment(schema, -1, config);
+    segment->PreInsert(N);
+    segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    auto impl = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+    auto& indexing_record = impl->get_indexing_record();
+    for (int i = 0; i < 500 && indexing_record.get_finished_ack() < 17; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    ASSERT_EQ(indexing_record.get_finished_ack(), 17);
+    impl->evict_indexed_raw_chunks();
+
+    // only chunks inside published compacted runs are candidates; whether
+    // any were actually dropped depends on the index family handing back
+    // stored rows, which eviction verifies per chunk
+    auto vec_base = impl->get_insert_record().get_field_data_base(vec_fid);
+    auto compacted = indexing_record.get_vec_field_indexing(vec_fid).compacted_until();
+    ASSERT_LE(vec_base->num_released_chunks(), compacted);
+    for (int64_t chunk_id = compacted; chunk_id < 17; ++chunk_id) {
+        ASSERT_FALSE(vec_base->chunk_released(chunk_id));
+    }
+
+    // retrieval equivalence across evicted and live chunks
+    auto expected = dataset.get_col<float>(vec_fid);
+    std::vector<int64_t> offsets(N);
+    std::iota(offsets.begin(), offsets.end(), 0);
+    auto result = impl->bulk_subscript(vec_fid, offsets.data(), N);
+    auto& actual = result->vectors().float_vector().data();
+    ASSERT_EQ(actual.size(), N * dim);
+    for (int64_t i = 0; i < N * dim; ++i) {
+        ASSERT_EQ(actual[i], expected[i]) << "@" << i;
+    }
+}
+
+TEST(Growing, ClusteredIngest) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    auto tenant = schema->AddDebugField("tenant", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto segment = CreateGrowingSegment(schema);
+    auto segment_impl = dynamic_cast<SegmentGrowingImpl*>(segment.get());
+    segment_impl->enable_clustered_ingest(tenant);
+
+    int64_t n = 1000;
+    int64_t num_tenants = 10;
+    auto dataset = DataGen(schema, n);
+    // interleave the tenants so arrival order is maximally scattered
+    for (auto& field : *dataset.raw_->mutable_fields_data()) {
+        if (field.field_id() == tenant.get()) {
+            auto values = field.mutable_scalars()->mutable_long_data()->mutable_data();
+            for (int64_t i = 0; i < n; ++i) {
+                values->Set(i, i % num_tenants);
+            }
+        }
+    }
+
+    auto offset = segment->PreInsert(n);
+    segment->Insert(offset, n, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    // the batch lands sorted by tenant: each tenant occupies one contiguous
+    // run of rows instead of being spread over the whole chunk
+    auto tenant_span = segment_impl->chunk_data<int64_t>(tenant, 0);
+    for (int64_t i = 1; i < n; ++i) {
+        ASSERT_LE(tenant_span[i - 1], tenant_span[i]);
+    }
+
+    // rows moved as units: every pk still sits next to its own tenant value
+    auto pk_span = segment_impl->chunk_data<int64_t>(pk, 0);
+    auto& record = segment_impl->get_insert_record();
+    for (int64_t value = 0; value < n; ++value) {
+        auto offsets = record.search_pk(value, n);
+        ASSERT_EQ(offsets.size(), 1) << value;
+        auto row = offsets[0].get();
+        ASSERT_EQ(pk_span[row], value);
+        ASSERT_EQ(tenant_span[row], value % num_tenants);
+    }
+
+    // visibility rounds down to whole batches: a timestamp inside the batch
+    // exposes nothing, the batch's last timestamp exposes all of it
+    ASSERT_EQ(segment_impl->get_active_count(dataset.timestamps_[n / 2]), 0);
+    ASSERT_EQ(segment_impl->get_active_count(dataset.timestamps_[n - 1]), n);
+
+    // a second batch extends the cut batch by batch
+    auto dataset2 = DataGen(schema, n, 43, n);
+    auto offset2 = segment->PreInsert(n);
+    segment->Insert(offset2, n, dataset2.row_ids_.data(), dataset2.timestamps_.data(), dataset2.raw_);
+    ASSERT_EQ(segment_impl->get_active_count(dataset.timestamps_[n - 1]), n);
+    ASSERT_EQ(segment_impl->get_active_count(dataset2.timestamps_[n - 1]), 2 * n);
+}
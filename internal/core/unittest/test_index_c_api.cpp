@@ -81,6 +81,125 @@ TEST(FloatVecIndex, All) {
     }
 }
 
+TEST(FloatVecIndex, StreamingBuild) {
+    auto index_type = knowhere::IndexEnum::INDEX_FAISS_IVFPQ;
+    auto metric_type = knowhere::metric::L2;
+    indexcgo::TypeParams type_params;
+    indexcgo::IndexParams index_params;
+    std::tie(type_params, index_params) = generate_params(index_type, metric_type);
+    std::string type_params_str, index_params_str;
+    bool ok;
+    ok = google::protobuf::TextFormat::PrintToString(type_params, &type_params_str);
+    assert(ok);
+    ok = google::protobuf::TextFormat::PrintToString(index_params, &index_params_str);
+    assert(ok);
+    auto dataset = GenDataset(NB, metric_type, false);
+    auto xb_data = dataset.get_col<float>(milvus::FieldId(100));
+
+    CDataType dtype = FloatVector;
+    CIndex index;
+    CStatus status;
+    CBinarySet binary_set;
+
+    {
+        status = CreateIndex(dtype, type_params_str.c_str(), index_params_str.c_str(), &index);
+        ASSERT_EQ(Success, status.error_code);
+    }
+    {
+        // a block before the build has been started must fail
+        status = BuildFloatVecIndexBlock(index, NB * DIM, xb_data.data());
+        ASSERT_NE(Success, status.error_code);
+    }
+    {
+        // train on the whole sample, then feed the same rows in two blocks
+        status = BuildFloatVecIndexBegin(index, NB, NB * DIM, xb_data.data());
+        ASSERT_EQ(Success, status.error_code);
+        auto half = NB / 2;
+        status = BuildFloatVecIndexBlock(index, half * DIM, xb_data.data());
+        ASSERT_EQ(Success, status.error_code);
+        status = BuildFloatVecIndexBlock(index, (NB - half) * DIM, xb_data.data() + half * DIM);
+        ASSERT_EQ(Success, status.error_code);
+        status = BuildVecIndexEnd(index);
+        ASSERT_EQ(Success, status.error_code);
+    }
+    {
+        status = SerializeIndexToBinarySet(index, &binary_set);
+        ASSERT_EQ(Success, status.error_code);
+        ASSERT_GT(GetBinarySetSize(binary_set), 0);
+    }
+    DeleteBinarySet(binary_set);
+    {
+        status = DeleteIndex(index);
+        ASSERT_EQ(Success, status.error_code);
+    }
+}
+
+namespace {
+int
+CollectSliceToBinarySet(void* context, const char* key, const uint8_t* slice_data, int64_t slice_size) {
+    auto c_binary_set = reinterpret_cast<CBinarySet>(context);
+    auto status = AppendIndexBinary(c_binary_set, const_cast<uint8_t*>(slice_data), slice_size, key);
+    return status.error_code == Success ? 0 : 1;
+}
+}  // namespace
+
+TEST(FloatVecIndex, SerializeToSink) {
+    auto index_type = knowhere::IndexEnum::INDEX_FAISS_IVFPQ;
+    auto metric_type = knowhere::metric::L2;
+    indexcgo::TypeParams type_params;
+    indexcgo::IndexParams index_params;
+    std::tie(type_params, index_params) = generate_params(index_type, metric_type);
+    std::string type_params_str, index_params_str;
+    bool ok;
+    ok = google::protobuf::TextFormat::PrintToString(type_params, &type_params_str);
+    assert(ok);
+    ok = google::protobuf::TextFormat::PrintToString(index_params, &index_params_str);
+    assert(ok);
+    auto dataset = GenDataset(NB, metric_type, false);
+    auto xb_data = dataset.get_col<float>(milvus::FieldId(100));
+
+    CDataType dtype = FloatVector;
+    CIndex index;
+    CStatus status;
+    CBinarySet binary_set;
+    CIndex copy_index;
+
+    {
+        status = CreateIndex(dtype, type_params_str.c_str(), index_params_str.c_str(), &index);
+        ASSERT_EQ(Success, status.error_code);
+    }
+    {
+        status = BuildFloatVecIndex(index, NB * DIM, xb_data.data());
+        ASSERT_EQ(Success, status.error_code);
+    }
+    {
+        // collect the streamed slices into a binary set; loading from it
+        // proves the streamed bytes are the full serialized index
+        status = NewBinarySet(&binary_set);
+        ASSERT_EQ(Success, status.error_code);
+        status = SerializeIndexToSink(index, CollectSliceToBinarySet, binary_set);
+        ASSERT_EQ(Success, status.error_code);
+        ASSERT_GT(GetBinarySetSize(binary_set), 0);
+    }
+    {
+        status = CreateIndex(dtype, type_params_str.c_str(), index_params_str.c_str(), &copy_index);
+        ASSERT_EQ(Success, status.error_code);
+    }
+    {
+        status = LoadIndexFromBinarySet(copy_index, binary_set);
+        ASSERT_EQ(Success, status.error_code);
+    }
+    DeleteBinarySet(binary_set);
+    {
+        status = DeleteIndex(index);
+        ASSERT_EQ(Success, status.error_code);
+    }
+    {
+        status = DeleteIndex(copy_index);
+        ASSERT_EQ(Success, status.error_code);
+    }
+}
+
 TEST(BinaryVecIndex, All) {
     auto index_type = knowhere::IndexEnum::INDEX_FAISS_BIN_IVFFLAT;
     auto metric_type = knowhere::metric::JACCARD;
@@ -320,7 +320,11 @@ TEST(Indexing, BinaryBruteForce) {
         query_data  //
     };
 
-    auto sub_result = query::BruteForceSearch(search_dataset, bin_vec.data(), N, nullptr);
+    auto sub_qr = query::BruteForceSearch(search_dataset, bin_vec.data(), N, nullptr);
+    ASSERT_TRUE(sub_qr.ok()) << sub_qr.status().ToString();
+    auto& sub_result = sub_qr.value();
+    // rounding now happens once on the final result, not inside BruteForceSearch
+    sub_result.round_values();
 
     SearchResult sr;
     sr.total_nq_ = num_queries;
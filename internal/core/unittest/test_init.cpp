@@ -11,6 +11,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
+
+#include "common/SimdDispatch.h"
+#include "log/AsyncLogSink.h"
+#include "log/Log.h"
 #include "segcore/segcore_init_c.h"
 #include "test_utils/DataGen.h"
 
@@ -21,3 +26,32 @@ TEST(Init, Naive) {
     SegcoreSetChunkRows(32768);
     SegcoreSetSimdType("auto");
 }
+
+TEST(Init, SimdDispatch) {
+    using namespace milvus;
+    auto restore = GetSimdLevelCap();
+
+    SetSimdLevelCap(SimdLevel::SSE42);
+    ASSERT_FALSE(UseSimdAvx2());
+    SetSimdLevelCap(SimdLevel::Scalar);
+    ASSERT_FALSE(UseSimdSse42());
+    ASSERT_STREQ(SimdLevelName(GetEffectiveSimdLevel()), "scalar");
+    SetSimdLevelCap(restore);
+
+    auto level = SegcoreGetSimdLevel();
+    ASSERT_GT(strlen(level), 0);
+    free(level);
+}
+
+TEST(Init, AsyncLogging) {
+    using namespace milvus;
+    SegcoreSetEnableAsyncLogging(true);
+    for (int i = 0; i < 100; ++i) {
+        LOG_SEGCORE_INFO_ << "async logging round trip " << i;
+    }
+    AsyncLogSink::Flush();
+    ASSERT_EQ(AsyncLogSink::DroppedCount(), 0);
+    // disabling drains whatever is still queued and restores sync dispatch
+    SegcoreSetEnableAsyncLogging(false);
+    LOG_SEGCORE_INFO_ << "back to synchronous dispatch";
+}
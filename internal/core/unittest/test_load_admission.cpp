@@ -0,0 +1,112 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "segcore/LoadAdmission.h"
+
+using namespace milvus::segcore;
+
+namespace {
+
+// the admission controller is a process-wide singleton; leave it disabled
+// behind us so other tests never queue
+struct BudgetScope {
+    explicit BudgetScope(int64_t bytes) {
+        LoadAdmission::GetInstance().SetBudget(bytes);
+    }
+    ~BudgetScope() {
+        LoadAdmission::GetInstance().SetBudget(0);
+    }
+};
+
+}  // namespace
+
+TEST(LoadAdmission, DisabledAdmitsEverything) {
+    auto& admission = LoadAdmission::GetInstance();
+    ASSERT_EQ(admission.budget(), 0);
+    // far beyond any plausible budget, admitted without blocking
+    LoadAdmissionGuard guard(int64_t(1) << 50);
+    ASSERT_EQ(admission.queue_depth(), 0);
+    ASSERT_EQ(admission.bytes_in_use(), int64_t(1) << 50);
+}
+
+TEST(LoadAdmission, QueuesBeyondBudget) {
+    BudgetScope scope(1000);
+    auto& admission = LoadAdmission::GetInstance();
+
+    auto first = std::make_unique<LoadAdmissionGuard>(600);
+    ASSERT_EQ(admission.bytes_in_use(), 600);
+
+    // the second load does not fit and must queue until the first releases
+    std::atomic<bool> admitted{false};
+    auto second = std::thread([&admitted] {
+        LoadAdmissionGuard guard(600);
+        admitted.store(true);
+    });
+    while (admission.queue_depth() == 0) {
+        std::this_thread::yield();
+    }
+    ASSERT_FALSE(admitted.load());
+
+    first.reset();
+    second.join();
+    ASSERT_TRUE(admitted.load());
+    ASSERT_EQ(admission.bytes_in_use(), 0);
+    ASSERT_EQ(admission.queue_depth(), 0);
+}
+
+TEST(LoadAdmission, OversizedLoadAdmitsAlone) {
+    BudgetScope scope(1000);
+    auto& admission = LoadAdmission::GetInstance();
+
+    // larger than the whole budget: waits for the budget to drain, then
+    // goes through instead of deadlocking
+    auto small = std::make_unique<LoadAdmissionGuard>(400);
+    std::atomic<bool> admitted{false};
+    auto oversized = std::thread([&admitted] {
+        LoadAdmissionGuard guard(5000);
+        admitted.store(true);
+    });
+    while (admission.queue_depth() == 0) {
+        std::this_thread::yield();
+    }
+    ASSERT_FALSE(admitted.load());
+
+    small.reset();
+    oversized.join();
+    ASSERT_TRUE(admitted.load());
+    ASSERT_EQ(admission.bytes_in_use(), 0);
+}
+
+TEST(LoadAdmission, RaisingBudgetAdmitsQueued) {
+    BudgetScope scope(500);
+    auto& admission = LoadAdmission::GetInstance();
+
+    LoadAdmissionGuard held(400);
+    std::atomic<bool> admitted{false};
+    auto waiter = std::thread([&admitted] {
+        LoadAdmissionGuard guard(300);
+        admitted.store(true);
+    });
+    while (admission.queue_depth() == 0) {
+        std::this_thread::yield();
+    }
+
+    // growing the budget at runtime lets the queued load through
+    admission.SetBudget(1000);
+    waiter.join();
+    ASSERT_TRUE(admitted.load());
+}
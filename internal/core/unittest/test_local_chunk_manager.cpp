@@ -228,3 +228,40 @@ TEST_F(LocalChunkManagerTest, ReadOffset) {
     exist = lcm.DirExist(path_prefix);
     EXPECT_EQ(exist, false);
 }
+
+TEST_F(LocalChunkManagerTest, StagedWrite) {
+    auto& lcm = LocalChunkManager::GetInstance();
+    string path_prefix = lcm.GetPathPrefix();
+
+    // odd sizes straddle the staging block and leave an unaligned tail
+    std::vector<uint8_t> data((1 << 20) + 12345);
+    std::default_random_engine e(67);
+    for (auto& byte : data) {
+        byte = e() % 256;
+    }
+
+    auto run = [&](const string& file) {
+        auto staged = lcm.OpenStagedFile(file, data.size());
+        // split appends so one crosses the internal block boundary
+        staged->Append(data.data(), 1000);
+        staged->Append(data.data() + 1000, data.size() - 1000);
+        EXPECT_EQ(staged->size(), data.size());
+        staged->Finish();
+
+        // the tail padding and preallocated extent must be trimmed away
+        EXPECT_EQ(lcm.Size(file), data.size());
+        std::vector<uint8_t> read_data(data.size());
+        auto size = lcm.Read(file, read_data.data(), read_data.size());
+        EXPECT_EQ(size, data.size());
+        EXPECT_EQ(read_data, data);
+    };
+
+    run("/tmp/local-test-dir/staged/buffered");
+    // direct staging must behave identically, including the O_DIRECT
+    // fallback on filesystems that reject the flag
+    lcm.SetDirectStagingIO(true);
+    run("/tmp/local-test-dir/staged/direct");
+    lcm.SetDirectStagingIO(false);
+
+    lcm.RemoveDir(path_prefix);
+}
@@ -0,0 +1,77 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "common/Metrics.h"
+#include "utils/Json.h"
+
+using namespace milvus;
+
+TEST(Metrics, CounterConcurrent) {
+    auto& counter = MetricsRegistry::GetInstance().GetCounter("test.counter.concurrent");
+    // the registry hands out the same instrument for the same name
+    ASSERT_EQ(&counter, &MetricsRegistry::GetInstance().GetCounter("test.counter.concurrent"));
+
+    constexpr int num_threads = 8;
+    constexpr int per_thread = 10000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; i++) {
+        threads.emplace_back([&counter] {
+            for (int j = 0; j < per_thread; j++) {
+                counter.Increment();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(counter.Value(), num_threads * per_thread);
+}
+
+TEST(Metrics, HistogramBuckets) {
+    ASSERT_EQ(MetricHistogram::BucketOf(0), 0);
+    ASSERT_EQ(MetricHistogram::BucketOf(-5), 0);
+    ASSERT_EQ(MetricHistogram::BucketOf(1), 1);
+    ASSERT_EQ(MetricHistogram::BucketOf(2), 2);
+    ASSERT_EQ(MetricHistogram::BucketOf(3), 2);
+    ASSERT_EQ(MetricHistogram::BucketOf(4), 3);
+    ASSERT_EQ(MetricHistogram::BucketOf(1023), 10);
+    ASSERT_EQ(MetricHistogram::BucketOf(1024), 11);
+    ASSERT_EQ(MetricHistogram::BucketOf(INT64_MAX), MetricHistogram::kNumBuckets - 1);
+
+    auto& hist = MetricsRegistry::GetInstance().GetHistogram("test.histogram.buckets");
+    hist.Observe(0);
+    hist.Observe(1);
+    hist.Observe(3);
+    hist.Observe(3);
+    ASSERT_EQ(hist.Count(), 4);
+    ASSERT_EQ(hist.Sum(), 7);
+    ASSERT_EQ(hist.BucketCount(0), 1);
+    ASSERT_EQ(hist.BucketCount(1), 1);
+    ASSERT_EQ(hist.BucketCount(2), 2);
+}
+
+TEST(Metrics, Snapshot) {
+    MetricsRegistry::GetInstance().GetCounter("test.snapshot.counter").Increment(42);
+    MetricsRegistry::GetInstance().GetHistogram("test.snapshot.histogram").Observe(5);
+
+    auto snapshot = json::parse(MetricsRegistry::GetInstance().Snapshot());
+    ASSERT_GE(snapshot["counters"]["test.snapshot.counter"].get<int64_t>(), 42);
+
+    auto& hist = snapshot["histograms"]["test.snapshot.histogram"];
+    ASSERT_GE(hist["count"].get<int64_t>(), 1);
+    ASSERT_GE(hist["sum"].get<int64_t>(), 5);
+    // 5 falls in [4, 8), rendered under its upper bound
+    ASSERT_GE(hist["buckets"]["8"].get<int64_t>(), 1);
+}
@@ -205,6 +205,45 @@ TEST_F(MinioChunkManagerTest, ReadPositive) {
     EXPECT_EQ(readdata[4], 0x23);
 }
 
+TEST_F(MinioChunkManagerTest, RangedReadPositive) {
+    auto& chunk_manager = MinioChunkManager::GetInstance();
+    string testBucketName = "test-ranged-read";
+    chunk_manager.SetBucketName(testBucketName);
+    EXPECT_EQ(chunk_manager.GetBucketName(), testBucketName);
+
+    if (!chunk_manager.BucketExists(testBucketName)) {
+        chunk_manager.CreateBucket(testBucketName);
+    }
+    uint8_t data[8] = {0x17, 0x32, 0x45, 0x34, 0x23, 0x59, 0x62, 0x71};
+    string path = "1/5/7";
+    chunk_manager.Write(path, data, sizeof(data));
+
+    uint8_t readdata[8] = {0};
+    auto size = chunk_manager.Read(path, 2, readdata, 3);
+    EXPECT_EQ(size, 3);
+    EXPECT_EQ(readdata[0], 0x45);
+    EXPECT_EQ(readdata[1], 0x34);
+    EXPECT_EQ(readdata[2], 0x23);
+
+    // range running past the object end is truncated
+    size = chunk_manager.Read(path, 6, readdata, 4);
+    EXPECT_EQ(size, 2);
+    EXPECT_EQ(readdata[0], 0x62);
+    EXPECT_EQ(readdata[1], 0x71);
+
+    uint8_t head[2] = {0};
+    uint8_t tail[2] = {0};
+    vector<MinioChunkManager::ReadRange> ranges = {{0, head, 2}, {6, tail, 2}};
+    auto sizes = chunk_manager.MultiRead(path, ranges);
+    EXPECT_EQ(sizes.size(), 2);
+    EXPECT_EQ(sizes[0], 2);
+    EXPECT_EQ(sizes[1], 2);
+    EXPECT_EQ(head[0], 0x17);
+    EXPECT_EQ(head[1], 0x32);
+    EXPECT_EQ(tail[0], 0x62);
+    EXPECT_EQ(tail[1], 0x71);
+}
+
 TEST_F(MinioChunkManagerTest, RemovePositive) {
     auto& chunk_manager = MinioChunkManager::GetInstance();
     string testBucketName = "test-remove";
@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 #include <fstream>
+#include <numeric>
+#include <random>
 
 #include "storage/parquet_c.h"
 #include "storage/PayloadReader.h"
@@ -90,6 +92,112 @@ TEST(storage, inoutstream) {
     ASSERT_EQ(inarray->Value(4), 5);
 }
 
+TEST(storage, MultiRowGroupParallelDecode) {
+    const int64_t N = 10000;
+    const int64_t rows_per_group = 500;  // 20 row groups
+    arrow::Int64Builder i64builder;
+    std::vector<int64_t> data(N);
+    std::iota(data.begin(), data.end(), 0);
+    auto st = i64builder.AppendValues(data);
+    ASSERT_TRUE(st.ok());
+    std::shared_ptr<arrow::Array> i64array;
+    st = i64builder.Finish(&i64array);
+    ASSERT_TRUE(st.ok());
+    auto schema = arrow::schema({arrow::field("val", arrow::int64())});
+    auto table = arrow::Table::Make(schema, {i64array});
+
+    auto os = std::make_shared<milvus::storage::PayloadOutputStream>();
+    st = parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), os, rows_per_group);
+    ASSERT_TRUE(st.ok());
+
+    // the parallel path reassembles the row groups decoded on the load
+    // pool in file order, so the payload must come back as written
+    milvus::storage::PayloadReader reader(os->Buffer().data(), os->Buffer().size(), milvus::DataType::INT64);
+    auto payload = reader.get_payload();
+    ASSERT_EQ(payload->rows, N);
+    auto* values = reinterpret_cast<const int64_t*>(payload->raw_data);
+    for (int64_t i = 0; i < N; ++i) {
+        ASSERT_EQ(values[i], i) << i;
+    }
+}
+
+TEST(storage, ChainedOutputStream) {
+    // enough bytes to span several blocks of the chained sink (the first
+    // block holds 1 MB), written in odd-sized chunks so writes straddle
+    // block boundaries
+    const int64_t total = (3 << 20) + 12345;
+    std::vector<uint8_t> expected(total);
+    std::default_random_engine e(67);
+    for (auto& b : expected) {
+        b = e() % 256;
+    }
+
+    auto os = std::make_shared<milvus::storage::PayloadOutputStream>();
+    int64_t offset = 0;
+    int64_t chunk = 1;
+    while (offset < total) {
+        auto n = std::min(chunk, total - offset);
+        auto st = os->Write(expected.data() + offset, n);
+        ASSERT_TRUE(st.ok());
+        offset += n;
+        chunk = chunk * 3 + 7919;
+    }
+    ASSERT_EQ(os->Tell().ValueOrDie(), total);
+
+    // the sliced view exposes the blocks directly: several slices, no
+    // assembly, bytes identical to what was written
+    milvus::storage::SlicedData sliced;
+    os->AppendViews(sliced, os);
+    ASSERT_GT(sliced.get_slices().size(), 1);
+    ASSERT_EQ(sliced.size(), total);
+    ASSERT_EQ(sliced.flatten(), expected);
+
+    // the legacy contiguous accessor still returns the same bytes
+    ASSERT_EQ(os->Buffer(), expected);
+
+    // writing after a flatten invalidates the cached copy
+    uint8_t tail = 0xab;
+    auto st = os->Write(&tail, 1);
+    ASSERT_TRUE(st.ok());
+    ASSERT_EQ(os->Buffer().size(), total + 1);
+    ASSERT_EQ(os->Buffer().back(), 0xab);
+}
+
+TEST(storage, WriterReserveAndReset) {
+    const int64_t N = 4096;
+    std::vector<int64_t> data(N);
+    std::iota(data.begin(), data.end(), 0);
+
+    milvus::storage::PayloadWriter writer(milvus::DataType::INT64);
+    writer.reserve(N);
+    milvus::storage::Payload payload{milvus::DataType::INT64, reinterpret_cast<const uint8_t*>(data.data()),
+                                     static_cast<int>(N), std::nullopt};
+    writer.add_payload(payload);
+    writer.finish();
+    ASSERT_EQ(writer.get_payload_length(), N);
+    {
+        auto& buffer = writer.get_payload_buffer();
+        milvus::storage::PayloadReader reader(buffer.data(), buffer.size(), milvus::DataType::INT64);
+        ASSERT_EQ(reader.get_payload()->rows, N);
+    }
+
+    // a reset writer keeps its reservation and serializes correctly again
+    writer.reset();
+    ASSERT_FALSE(writer.has_finished());
+    payload.rows = static_cast<int>(N / 2);
+    writer.add_payload(payload);
+    writer.finish();
+    ASSERT_EQ(writer.get_payload_length(), N / 2);
+    auto& buffer = writer.get_payload_buffer();
+    milvus::storage::PayloadReader reader(buffer.data(), buffer.size(), milvus::DataType::INT64);
+    auto out = reader.get_payload();
+    ASSERT_EQ(out->rows, N / 2);
+    auto* values = reinterpret_cast<const int64_t*>(out->raw_data);
+    for (int64_t i = 0; i < N / 2; ++i) {
+        ASSERT_EQ(values[i], i);
+    }
+}
+
 TEST(storage, boolean) {
     auto payload = NewPayloadWriter(int(milvus::DataType::BOOL));
     bool data[] = {true, false, true, false};
@@ -212,6 +320,48 @@ TEST(storage, stringarray) {
     ReleasePayloadReader(reader);
 }
 
+TEST(storage, stringarray_packed) {
+    auto payload = NewPayloadWriter(int(milvus::DataType::VARCHAR));
+    // packed buffer: "1234" + "12345" + "\0a\0", delimited by offsets
+    char packed[] = {'1', '2', '3', '4', '1', '2', '3', '4', '5', 0, 'a', 0};
+    int64_t offsets[] = {0, 4, 9, 12};
+    auto st = AddStringsToPayload(payload, packed, offsets, 3);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+
+    st = FinishPayloadWriter(payload);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    auto cb = GetPayloadBufferFromWriter(payload);
+    ASSERT_GT(cb.length, 0);
+    ASSERT_NE(cb.data, nullptr);
+    auto nums = GetPayloadLengthFromWriter(payload);
+    ASSERT_EQ(nums, 3);
+
+    auto reader = NewPayloadReader(int(milvus::DataType::VARCHAR), (uint8_t*)cb.data, cb.length);
+    int length = GetPayloadLengthFromReader(reader);
+    ASSERT_EQ(length, 3);
+    char *v0, *v1, *v2;
+    int s0, s1, s2;
+    st = GetOneStringFromPayload(reader, 0, &v0, &s0);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    ASSERT_EQ(s0, 4);
+    ASSERT_EQ(memcmp(v0, "1234", 4), 0);
+
+    st = GetOneStringFromPayload(reader, 1, &v1, &s1);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    ASSERT_EQ(s1, 5);
+    ASSERT_EQ(memcmp(v1, "12345", 5), 0);
+
+    st = GetOneStringFromPayload(reader, 2, &v2, &s2);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    ASSERT_EQ(s2, 3);
+    ASSERT_EQ(v2[0], 0);
+    ASSERT_EQ(v2[1], 'a');
+    ASSERT_EQ(v2[2], 0);
+
+    ReleasePayloadWriter(payload);
+    ReleasePayloadReader(reader);
+}
+
 TEST(storage, binary_vector) {
     int DIM = 16;
     auto payload = NewVectorPayloadWriter(int(milvus::DataType::VECTOR_BINARY), DIM);
@@ -348,3 +498,97 @@ TEST(storage, int8_2) {
     ASSERT_EQ(bool_array->Value(2), -100);
     ASSERT_EQ(bool_array->Value(3), 100);
 }
+
+TEST(storage, stringarray_compressed) {
+    auto payload = NewPayloadWriter(int(milvus::DataType::VARCHAR));
+    auto st = SetPayloadWriterCompression(payload, 7, true);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    for (int i = 0; i < 100; i++) {
+        auto label = i % 2 == 0 ? "even" : "odd";
+        st = AddOneStringToPayload(payload, (char*)label, strlen(label));
+        ASSERT_EQ(st.error_code, ErrorCode::Success);
+    }
+    // codec can no longer change once rows exist
+    st = SetPayloadWriterCompression(payload, 1, false);
+    ASSERT_NE(st.error_code, ErrorCode::Success);
+
+    st = FinishPayloadWriter(payload);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    auto cb = GetPayloadBufferFromWriter(payload);
+    ASSERT_GT(cb.length, 0);
+    ASSERT_NE(cb.data, nullptr);
+
+    auto reader = NewPayloadReader(int(milvus::DataType::VARCHAR), (uint8_t*)cb.data, cb.length);
+    int length = GetPayloadLengthFromReader(reader);
+    ASSERT_EQ(length, 100);
+    for (int i = 0; i < length; i++) {
+        char* str;
+        int str_size;
+        st = GetOneStringFromPayload(reader, i, &str, &str_size);
+        ASSERT_EQ(st.error_code, ErrorCode::Success);
+        ASSERT_EQ(std::string(str, str_size), i % 2 == 0 ? "even" : "odd");
+    }
+
+    ReleasePayloadWriter(payload);
+    ReleasePayloadReader(reader);
+}
+
+TEST(storage, payload_writer_reuse) {
+    // a released writer goes back to the pool; a writer acquired for the
+    // same shape afterwards must come back empty
+    auto writer = NewPayloadWriter(int(milvus::DataType::INT64));
+    int64_t data[] = {1, 2, 3};
+    auto st = AddInt64ToPayload(writer, data, 3);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    st = FinishPayloadWriter(writer);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    ReleasePayloadWriter(writer);
+
+    auto reused = NewPayloadWriter(int(milvus::DataType::INT64));
+    ASSERT_EQ(GetPayloadLengthFromWriter(reused), 0);
+    int64_t more[] = {7, 8};
+    st = AddInt64ToPayload(reused, more, 2);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    st = FinishPayloadWriter(reused);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    auto cb = GetPayloadBufferFromWriter(reused);
+    ASSERT_GT(cb.length, 0);
+
+    auto reader = NewPayloadReader(int(milvus::DataType::INT64), (uint8_t*)cb.data, cb.length);
+    int64_t* values = nullptr;
+    int length = 0;
+    st = GetInt64FromPayload(reader, &values, &length);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    ASSERT_EQ(length, 2);
+    ASSERT_EQ(values[0], 7);
+    ASSERT_EQ(values[1], 8);
+    ReleasePayloadReader(reader);
+    ReleasePayloadWriter(reused);
+}
+
+TEST(storage, arrow_pool_accounting) {
+    auto writer = NewPayloadWriter(int(milvus::DataType::INT64));
+    std::vector<int64_t> data(8192);
+    std::iota(data.begin(), data.end(), 0);
+    auto st = AddInt64ToPayload(writer, data.data(), data.size());
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    st = FinishPayloadWriter(writer);
+    ASSERT_EQ(st.error_code, ErrorCode::Success);
+    // builder and encode buffers were charged to the write pool
+    ASSERT_GT(GetArrowWritePoolPeakBytes(), 0);
+
+    auto cb = GetPayloadBufferFromWriter(writer);
+    auto read_bytes_before = GetArrowReadPoolBytes();
+    auto reader = NewPayloadReader(int(milvus::DataType::INT64), (uint8_t*)cb.data, cb.length);
+    // the decoded column is live, so the read pool must be holding it
+    ASSERT_GT(GetArrowReadPoolBytes(), read_bytes_before);
+    ASSERT_GT(GetArrowReadPoolPeakBytes(), 0);
+    ReleasePayloadReader(reader);
+    ASSERT_EQ(GetArrowReadPoolBytes(), read_bytes_before);
+
+    // with a tiny combined limit the decode allocation must fail cleanly
+    SetArrowPoolLimit(1);
+    ASSERT_ANY_THROW(NewPayloadReader(int(milvus::DataType::INT64), (uint8_t*)cb.data, cb.length));
+    SetArrowPoolLimit(0);
+    ReleasePayloadWriter(writer);
+}
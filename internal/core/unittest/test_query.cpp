@@ -10,6 +10,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
 
 #include "pb/schema.pb.h"
 #include "query/Expr.h"
@@ -344,6 +346,74 @@ TEST(Query, ExecWithPredicate) {
     ASSERT_EQ(json.dump(2), ref.dump(2));
 }
 
+TEST(Query, CoalescedSearch) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    schema->AddDebugField("age", DataType::FLOAT);
+    auto i64_fid = schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "range": {
+                    "age": {
+                        "GE": -1,
+                        "LT": 1
+                    }
+                }
+            },
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 5,
+                        "round_decimal": 3
+                    }
+                }
+            }
+            ]
+        }
+    })";
+    int64_t N = 10000;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateGrowingSegment(schema);
+    segment->PreInsert(N);
+    segment->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    auto plan = CreatePlan(*schema, dsl);
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroup(num_queries, 16, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    Timestamp time = 1000000;
+
+    auto baseline = SearchResultToJson(*segment->Search(plan.get(), ph_group.get(), time));
+
+    // concurrent identical searches must return exactly the solo result,
+    // whether or not they actually merged into one batch
+    SegcoreConfig::default_config().set_search_coalescing(true);
+    constexpr int kThreads = 4;
+    std::vector<std::unique_ptr<SearchResult>> results(kThreads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; ++i) {
+        threads.emplace_back([&, i] { results[i] = segment->Search(plan.get(), ph_group.get(), time); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    SegcoreConfig::default_config().set_search_coalescing(false);
+
+    for (int i = 0; i < kThreads; ++i) {
+        ASSERT_EQ(SearchResultToJson(*results[i]).dump(2), baseline.dump(2)) << "thread " << i;
+    }
+}
+
 TEST(Query, ExecTerm) {
     using namespace milvus::query;
     using namespace milvus::segcore;
@@ -444,6 +514,77 @@ TEST(Query, ExecEmpty) {
     }
 }
 
+TEST(Query, CompactedChunkIndexSearch) {
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    // small chunks and an exhaustive IVF (nprobe == nlist) so the compacted
+    // index path must return exactly the brute-force answer
+    SegcoreConfig config = SegcoreConfig::default_config();
+    config.set_chunk_rows(256);
+    config.set_nlist(16);
+    config.set_nprobe(16);
+
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    int64_t N = 256 * 17;
+    auto dataset = DataGen(schema, N);
+    auto indexed = CreateGrowingSegment(schema, -1, config);
+    indexed->PreInsert(N);
+    indexed->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    auto reference = CreateGrowingSegment(schema, -1, config);
+    reference->disable_small_index();
+    reference->PreInsert(N);
+    reference->Insert(0, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    // chunk builds and compaction run on the build pool; the finished ack
+    // lands only after both, so polling it is enough
+    auto impl = dynamic_cast<SegmentGrowingImpl*>(indexed.get());
+    auto& indexing_record = impl->get_indexing_record();
+    for (int i = 0; i < 500 && indexing_record.get_finished_ack() < 17; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    ASSERT_EQ(indexing_record.get_finished_ack(), 17);
+
+    auto runs = indexing_record.get_vec_field_indexing(vec_fid).get_compacted_runs();
+    ASSERT_EQ(runs.size(), 2);
+    ASSERT_EQ(runs[0]->chunk_beg, 0);
+    ASSERT_EQ(runs[0]->chunk_end, 8);
+    ASSERT_EQ(runs[1]->chunk_beg, 8);
+    ASSERT_EQ(runs[1]->chunk_end, 16);
+
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 16
+                        },
+                        "query": "$0",
+                        "topk": 5,
+                        "round_decimal": 3
+                    }
+                }
+            }
+            ]
+        }
+    })";
+    auto plan = CreatePlan(*schema, dsl);
+    auto ph_group_raw = CreatePlaceholderGroup(3, 16, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    Timestamp time = dataset.timestamps_[N - 1];
+
+    auto sr_indexed = indexed->Search(plan.get(), ph_group.get(), time);
+    auto sr_reference = reference->Search(plan.get(), ph_group.get(), time);
+    ASSERT_EQ(sr_indexed->seg_offsets_, sr_reference->seg_offsets_);
+}
+
 TEST(Query, ExecWithoutPredicateFlat) {
     using namespace milvus::query;
     using namespace milvus::segcore;
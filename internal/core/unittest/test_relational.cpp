@@ -11,8 +11,11 @@
 
 #include <gtest/gtest.h>
 #include "query/Relational.h"
+#include "common/StringCompare.h"
 #include "common/Utils.h"
 #include <string>
+#include <string_view>
+#include <vector>
 
 TEST(Relational, Basic) {
     using namespace milvus::query;
@@ -80,3 +83,92 @@ TEST(Relational, DifferentInCompatibleType) {
     ASSERT_ANY_THROW(Relational<decltype(MatchOp<milvus::OpType::PrefixMatch>{})>()(i64, s));
     ASSERT_ANY_THROW(Relational<decltype(MatchOp<milvus::OpType::PostfixMatch>{})>()(i64, s));
 }
+
+namespace {
+
+int
+Sign(int v) {
+    return v < 0 ? -1 : v > 0 ? 1 : 0;
+}
+
+// reference three-way compare; the kernels must agree with it on sign
+int
+RefCompare(const std::string& a, const std::string& b) {
+    return Sign(std::string_view(a).compare(std::string_view(b)));
+}
+
+}  // namespace
+
+TEST(StringCompare, AgainstReference) {
+    using namespace milvus;
+
+    // edge cases the prefix word and the vector tails must get right: empty
+    // strings, proper prefixes, ties at the 8-byte word boundary, embedded
+    // NULs, high-bit bytes (unsigned ordering) and strings past the 32-byte
+    // AVX2 stride
+    std::vector<std::string> corpus = {
+        "",
+        "a",
+        "b",
+        "ab",
+        "abc",
+        "abcdefg",
+        "abcdefgh",
+        "abcdefghi",
+        "abcdefgi",
+        "abcdefgh_tail_one",
+        "abcdefgh_tail_two",
+        std::string("emb\0ed", 6),
+        std::string("emb\0ee", 6),
+        std::string("\x01", 1),
+        std::string("\xff", 1),
+        std::string(7, 'x'),
+        std::string(8, 'x'),
+        std::string(9, 'x'),
+        std::string(15, 'y') + "a",
+        std::string(15, 'y') + "b",
+        std::string(16, 'y'),
+        std::string(31, 'z') + "a",
+        std::string(31, 'z') + "b",
+        std::string(32, 'z'),
+        std::string(40, 'z'),
+        std::string(100, 'q') + "left",
+        std::string(100, 'q') + "right",
+    };
+
+    auto saved_cap = GetSimdLevelCap();
+    for (auto level : {SimdLevel::Scalar, SimdLevel::SSE42, SimdLevel::AVX2}) {
+        SetSimdLevelCap(level);
+        for (auto& a : corpus) {
+            for (auto& b : corpus) {
+                auto expected = RefCompare(a, b);
+                ASSERT_EQ(Sign(CompareStringViews(a, b)), expected) << "a=" << a << " b=" << b;
+
+                StringOperand operand(b);
+                ASSERT_EQ(Sign(PrefixedCompare(a, operand)), expected) << "a=" << a << " b=" << b;
+                ASSERT_EQ(PrefixedEquals(a, operand), a == b) << "a=" << a << " b=" << b;
+                ASSERT_EQ(PrefixedStartsWith(a, operand), PrefixMatch(a, b)) << "a=" << a << " b=" << b;
+            }
+        }
+    }
+    SetSimdLevelCap(saved_cap);
+}
+
+TEST(StringCompare, BigEndianPrefixOrder) {
+    using namespace milvus;
+
+    // integer order on the packed prefix must match lexicographic byte order
+    // for every pair whose first 8 bytes differ
+    std::vector<std::string> corpus = {"", "a", "az", "b", "ba", std::string("a\0", 2), std::string("\xff\x01", 2),
+                                       "abcdefgh", "abcdefgz"};
+    for (auto& a : corpus) {
+        for (auto& b : corpus) {
+            auto pa = BigEndianPrefix(a.data(), a.size());
+            auto pb = BigEndianPrefix(b.data(), b.size());
+            if (pa == pb) {
+                continue;
+            }
+            ASSERT_EQ(pa < pb, RefCompare(a, b) < 0) << "a=" << a << " b=" << b;
+        }
+    }
+}
@@ -366,3 +366,39 @@ TEST(Retrieve, Delete) {
         ASSERT_EQ(field1_data.data_size(), DIM * size);
     }
 }
+
+TEST(Retrieve, NoPredicateAllVisible) {
+    auto schema = std::make_shared<Schema>();
+    auto fid_64 = schema->AddDebugField("i64", DataType::INT64);
+    schema->set_primary_field_id(fid_64);
+
+    int64_t N = 100;
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *segment);
+    auto i64_col = dataset.get_col<int64_t>(fid_64);
+
+    // clean segment, no predicate, guarantee past every row: the fast path
+    // answers with the leading offsets without building any bitset
+    auto plan = std::make_unique<query::RetrievePlan>(*schema);
+    plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+    plan->field_ids_ = {fid_64};
+
+    auto full = segment->Retrieve(plan.get(), MAX_TIMESTAMP);
+    auto& full_data = full->fields_data(0).scalars().long_data();
+    ASSERT_EQ(full_data.data_size(), N);
+    for (int64_t i = 0; i < N; ++i) {
+        ASSERT_EQ(full_data.data(i), i64_col[i]);
+    }
+
+    // a limit clips to the leading offsets
+    plan->plan_node_->limit_ = 7;
+    auto limited = segment->Retrieve(plan.get(), MAX_TIMESTAMP);
+    ASSERT_EQ(limited->fields_data(0).scalars().long_data().data_size(), 7);
+    plan->plan_node_->limit_ = -1;
+
+    // a guarantee inside the segment's timestamp range leaves the fast path
+    // and applies visibility row by row (DataGen timestamps run 0..N-1)
+    auto partial = segment->Retrieve(plan.get(), N / 2);
+    ASSERT_EQ(partial->fields_data(0).scalars().long_data().data_size(), N / 2 + 1);
+}
@@ -112,6 +112,56 @@ TYPED_TEST_P(TypedScalarIndexTest, Range) {
     }
 }
 
+TYPED_TEST_P(TypedScalarIndexTest, ParallelBuild) {
+    using T = TypeParam;
+    auto dtype = milvus::GetDType<T>();
+    auto index_types = GetIndexTypes<T>();
+    for (const auto& index_type : index_types) {
+        auto index = milvus::scalar::IndexFactory::GetInstance().CreateIndex<T>(index_type);
+        index->SetBuildParallelism(4);
+        auto arr = GenArr<T>(nb);
+        index->Build(nb, arr.data());
+        ASSERT_EQ(nb, index->Count());
+        assert_in<T>(index, arr);
+        assert_range<T>(index, arr);
+        assert_reverse<T>(index, arr);
+    }
+}
+
+TYPED_TEST_P(TypedScalarIndexTest, CompressedRanges) {
+    using T = TypeParam;
+    auto dtype = milvus::GetDType<T>();
+    auto index_types = GetIndexTypes<T>();
+    for (const auto& index_type : index_types) {
+        auto index = milvus::scalar::IndexFactory::GetInstance().CreateIndex<T>(index_type);
+        auto arr = GenArr<T>(nb);
+        index->Build(nb, arr.data());
+
+        // the compressed form must carry exactly the bits of the bitmap form
+        auto bitmap = index->In(1, arr.data());
+        auto ranges = index->InAsRanges(1, arr.data());
+        ASSERT_EQ(ranges->size(), bitmap->size());
+        ASSERT_EQ(ranges->cardinality(), bitmap->count());
+        ASSERT_EQ(*ranges->ToBitmap(), *bitmap);
+
+        auto range_bitmap = index->Range(arr[nb / 2], milvus::OpType::GreaterEqual);
+        auto range_ranges = index->RangeAsRanges(arr[nb / 2], milvus::OpType::GreaterEqual);
+        ASSERT_EQ(range_ranges->cardinality(), range_bitmap->count());
+        ASSERT_EQ(*range_ranges->ToBitmap(), *range_bitmap);
+
+        // O(hits) combines against a full bitmap
+        milvus::scalar::TargetBitmap other(nb);
+        for (int64_t i = 0; i < nb; i += 2) {
+            other.set(i);
+        }
+        auto and_result = range_ranges->AndWith(other);
+        ASSERT_EQ(*and_result, *range_bitmap & other);
+        auto or_result = other;
+        range_ranges->OrInto(or_result);
+        ASSERT_EQ(or_result, *range_bitmap | other);
+    }
+}
+
 TYPED_TEST_P(TypedScalarIndexTest, Codec) {
     using T = TypeParam;
     auto dtype = milvus::GetDType<T>();
@@ -135,6 +185,16 @@ TYPED_TEST_P(TypedScalarIndexTest, Codec) {
 // TODO: it's easy to overflow for int8_t. Design more reasonable ut.
 using ScalarT = ::testing::Types<int8_t, int16_t, int32_t, int64_t, float, double>;
 
-REGISTER_TYPED_TEST_CASE_P(TypedScalarIndexTest, Dummy, Constructor, Count, In, NotIn, Range, Codec, Reverse);
+REGISTER_TYPED_TEST_CASE_P(TypedScalarIndexTest,
+                           Dummy,
+                           Constructor,
+                           Count,
+                           In,
+                           NotIn,
+                           Range,
+                           ParallelBuild,
+                           CompressedRanges,
+                           Codec,
+                           Reverse);
 
 INSTANTIATE_TYPED_TEST_CASE_P(ArithmeticCheck, TypedScalarIndexTest, ScalarT);
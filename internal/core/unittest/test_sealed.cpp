@@ -408,7 +408,7 @@ TEST(Sealed, LoadFieldData) {
     ASSERT_EQ(segment->num_chunk_index(str_id), 0);
     auto chunk_span1 = segment->chunk_data<int64_t>(counter_id, 0);
     auto chunk_span2 = segment->chunk_data<double>(double_id, 0);
-    auto chunk_span3 = segment->chunk_data<std::string>(str_id, 0);
+    auto chunk_span3 = segment->chunk_data<std::string_view>(str_id, 0);
     auto ref1 = dataset.get_col<int64_t>(counter_id);
     auto ref2 = dataset.get_col<double>(double_id);
     auto ref3 = dataset.get_col(str_id)->scalars().string_data().data();
@@ -640,6 +640,212 @@ TEST(Sealed, Delete) {
                     reinterpret_cast<const Timestamp*>(new_timestamps.data()));
 }
 
+TEST(Sealed, AllVisibleFastPath) {
+    auto dim = 16;
+    auto N = 100;
+    auto metric_type = knowhere::metric::L2;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, metric_type);
+    auto counter_id = schema->AddDebugField("counter", DataType::INT64);
+    schema->set_primary_field_id(counter_id);
+
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+
+    // unloaded segments never take the fast path
+    ASSERT_FALSE(segment->all_visible_at(MAX_TIMESTAMP));
+
+    SealedLoadFieldData(dataset, *segment);
+
+    // DataGen's timestamps run 0..N-1, so a guarantee at or past the max
+    // covers the whole segment and skips timestamp filtering
+    ASSERT_TRUE(segment->all_visible_at(MAX_TIMESTAMP));
+    ASSERT_TRUE(segment->all_visible_at(N - 1));
+    ASSERT_FALSE(segment->all_visible_at(N / 2));
+
+    // the visibility step leaves a fully visible segment's bitset untouched
+    BitsetType bitset(N, false);
+    segment->mask_with_visibility(bitset, N, MAX_TIMESTAMP);
+    ASSERT_TRUE(bitset.none());
+
+    // a loaded delete disables the fast path
+    std::vector<idx_t> pks{1};
+    auto ids = std::make_unique<IdArray>();
+    ids->mutable_int_id()->mutable_data()->Add(pks.begin(), pks.end());
+    std::vector<Timestamp> del_ts{N + 1};
+    LoadDeletedRecordInfo info = {del_ts.data(), ids.get(), 1};
+    segment->LoadDeletedRecord(info);
+    ASSERT_FALSE(segment->all_visible_at(MAX_TIMESTAMP));
+    segment->mask_with_visibility(bitset, N, MAX_TIMESTAMP);
+    ASSERT_EQ(bitset.count(), 1);
+}
+
+TEST(Sealed, LoadFromGrowing) {
+    auto dim = 16;
+    auto N = ROW_COUNT;
+    auto metric_type = knowhere::metric::L2;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, metric_type);
+    auto counter_id = schema->AddDebugField("counter", DataType::INT64);
+    auto double_id = schema->AddDebugField("double", DataType::DOUBLE);
+    auto str_id = schema->AddDebugField("str", DataType::VARCHAR);
+    schema->set_primary_field_id(counter_id);
+
+    auto dataset = DataGen(schema, N);
+    auto growing = CreateGrowingSegment(schema);
+    growing->disable_small_index();
+    auto offset = growing->PreInsert(N);
+    growing->Insert(offset, N, dataset.row_ids_.data(), dataset.timestamps_.data(), dataset.raw_);
+
+    // a few deletes ride along with the conversion
+    int64_t del_count = 3;
+    std::vector<idx_t> del_pks{1, 2, 3};
+    auto del_ids = std::make_unique<IdArray>();
+    del_ids->mutable_int_id()->mutable_data()->Add(del_pks.begin(), del_pks.end());
+    std::vector<Timestamp> del_timestamps(del_count, dataset.timestamps_[N - 1] + 1);
+    auto del_offset = growing->PreDelete(del_count);
+    growing->Delete(del_offset, del_count, del_ids.get(), del_timestamps.data());
+
+    auto sealed = CreateSealedSegment(schema);
+    sealed->LoadFromGrowing(*growing);
+
+    ASSERT_EQ(sealed->get_row_count(), N);
+    ASSERT_EQ(sealed->get_deleted_count(), del_count);
+    ASSERT_EQ(sealed->num_chunk(), 1);
+
+    // columns landed as single sealed chunks holding the source rows verbatim
+    auto chunk_span1 = sealed->chunk_data<int64_t>(counter_id, 0);
+    auto chunk_span2 = sealed->chunk_data<double>(double_id, 0);
+    auto chunk_span3 = sealed->chunk_data<std::string_view>(str_id, 0);
+    auto ref1 = dataset.get_col<int64_t>(counter_id);
+    auto ref2 = dataset.get_col<double>(double_id);
+    auto ref3 = dataset.get_col(str_id)->scalars().string_data().data();
+    for (int i = 0; i < N; ++i) {
+        ASSERT_EQ(chunk_span1[i], ref1[i]);
+        ASSERT_EQ(chunk_span2[i], ref2[i]);
+        ASSERT_EQ(chunk_span3[i], ref3[i]);
+    }
+
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "range": {
+                    "double": {
+                        "GE": -1,
+                        "LT": 1
+                    }
+                }
+            },
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 5,
+                        "round_decimal": 3
+                    }
+                }
+            }
+            ]
+        }
+    })";
+    auto plan = CreatePlan(*schema, dsl);
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroup(num_queries, 16, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+
+    // both sides run the brute-force path over the same rows, timestamps and
+    // delete log, so the converted segment must answer identically
+    Timestamp time = dataset.timestamps_[N - 1] + 2;
+    auto sr_growing = growing->Search(plan.get(), ph_group.get(), time);
+    auto sr_sealed = sealed->Search(plan.get(), ph_group.get(), time);
+    ASSERT_EQ(SearchResultToJson(*sr_growing).dump(-2), SearchResultToJson(*sr_sealed).dump(-2));
+}
+
+TEST(Sealed, EvictCoveredFieldData) {
+    auto dim = 16;
+    auto N = ROW_COUNT;
+    auto metric_type = knowhere::metric::L2;
+    auto schema = std::make_shared<Schema>();
+    auto fakevec_id = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, dim, metric_type);
+    auto counter_id = schema->AddDebugField("counter", DataType::INT64);
+    auto double_id = schema->AddDebugField("double", DataType::DOUBLE);
+    schema->set_primary_field_id(counter_id);
+
+    auto dataset = DataGen(schema, N);
+    auto segment = CreateSealedSegment(schema);
+    SealedLoadFieldData(dataset, *segment);
+
+    // a scalar index now coexists with the raw column instead of conflicting
+    LoadIndexInfo double_index;
+    double_index.field_id = double_id.get();
+    double_index.field_type = CDataType::Double;
+    double_index.index_params["index_type"] = "sort";
+    auto double_data = dataset.get_col<double>(double_id);
+    double_index.index = std::move(GenScalarIndexing<double>(N, double_data.data()));
+    segment->LoadIndex(double_index);
+    ASSERT_TRUE(segment->HasFieldData(double_id));
+    ASSERT_TRUE(segment->HasIndex(double_id));
+
+    std::string dsl = R"({
+        "bool": {
+            "must": [
+            {
+                "range": {
+                    "double": {
+                        "GE": -1,
+                        "LT": 1
+                    }
+                }
+            },
+            {
+                "vector": {
+                    "fakevec": {
+                        "metric_type": "L2",
+                        "params": {
+                            "nprobe": 10
+                        },
+                        "query": "$0",
+                        "topk": 5,
+                        "round_decimal": 3
+                    }
+                }
+            }
+            ]
+        }
+    })";
+    Timestamp time = 1000000;
+    auto plan = CreatePlan(*schema, dsl);
+    auto num_queries = 5;
+    auto ph_group_raw = CreatePlaceholderGroup(num_queries, 16, 1024);
+    auto ph_group = ParsePlaceholderGroup(plan.get(), ph_group_raw.SerializeAsString());
+    auto sr_before = segment->Search(plan.get(), ph_group.get(), time);
+
+    auto mem_before = segment->GetMemoryUsageInBytes();
+    auto double_bytes = segment->GetFieldMemoryUsageInBytes(double_id);
+    ASSERT_GT(double_bytes, 0);
+
+    // nothing to do while the segment already fits the target
+    ASSERT_EQ(segment->EvictCoveredFieldData(mem_before), 0);
+
+    // under pressure only the covered column goes; the vector column has no
+    // reconstruction path and stays resident
+    auto released = segment->EvictCoveredFieldData(0);
+    ASSERT_EQ(released, double_bytes);
+    ASSERT_FALSE(segment->HasFieldData(double_id));
+    ASSERT_TRUE(segment->HasFieldData(fakevec_id));
+    ASSERT_TRUE(segment->HasFieldData(counter_id));
+    ASSERT_EQ(segment->GetMemoryUsageInBytes(), mem_before - released);
+
+    // the predicate now reads the index; results must not change
+    auto sr_after = segment->Search(plan.get(), ph_group.get(), time);
+    ASSERT_EQ(SearchResultToJson(*sr_before).dump(-2), SearchResultToJson(*sr_after).dump(-2));
+}
+
 auto
 GenMaxFloatVecs(int N, int dim) {
     std::vector<float> vecs;
@@ -10,9 +10,11 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include <gtest/gtest.h>
+#include <map>
 #include <random>
 #include <string>
 
+#include "segcore/ChunkArena.h"
 #include "segcore/SegmentGrowingImpl.h"
 #include "test_utils/DataGen.h"
 
@@ -80,6 +82,33 @@ TEST(SegmentCoreTest, SmallIndex) {
     schema->AddDebugField("age", DataType::INT32);
 }
 
+TEST(SegmentCoreTest, HnswSmallIndex) {
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+
+    SegcoreConfig config = SegcoreConfig::default_config();
+    config.set_small_index_type("HNSW");
+    ASSERT_EQ(config.at(knowhere::metric::L2).index_type, "HNSW");
+    ASSERT_EQ(config.at(knowhere::metric::IP).index_type, "HNSW");
+    // binary chunks stay on BinaryIVF; knowhere's HNSW is float-only
+    ASSERT_EQ(config.at(knowhere::metric::HAMMING).index_type, "BIN_IVF");
+
+    VectorFieldIndexing indexing((*schema)[vec_fid], config);
+    auto build_params = indexing.get_build_params();
+    ASSERT_TRUE(build_params.count("M"));
+    ASSERT_TRUE(build_params.count("efConstruction"));
+
+    // ef follows topk once the request exceeds the configured floor
+    auto search_params = indexing.get_search_params(500);
+    ASSERT_GE(search_params["ef"].get<int64_t>(), 500);
+
+    ASSERT_ANY_THROW(config.set_small_index_type("ANNOY"));
+
+    config.set_small_index_type("IVF");
+    ASSERT_EQ(config.at(knowhere::metric::L2).index_type, "IVF");
+}
+
 TEST(OffsetMap, int64_t){
     using namespace milvus::segcore;
     OffsetMap *map= new OffsetHashMap<int64_t>();
@@ -101,6 +130,32 @@ TEST(InsertRecordTest, int64_t){
     ASSERT_EQ(offset[0].get(), int64_t(3));
 }
 
+TEST(InsertRecordTest, batch_probe){
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    auto record = milvus::segcore::InsertRecord(*schema, int64_t(32));
+    const int64_t N = 1000;
+    for (int64_t i = 0; i < N; ++i) {
+        record.insert_pk(int64_t(i), i);
+    }
+    // duplicate pk lands a second offset past the barrier
+    record.insert_pk(int64_t(7), int64_t(N + 1));
+
+    std::vector<int64_t> batch{7, 500, 999, 123456};
+    std::map<int64_t, std::vector<int64_t>> found;
+    record.search_pks(batch, N, [&](int64_t pk_index, int64_t offset) { found[pk_index].push_back(offset); });
+
+    ASSERT_EQ(found.size(), 3);
+    ASSERT_EQ(found[0], std::vector<int64_t>{7});
+    ASSERT_EQ(found[1], std::vector<int64_t>{500});
+    ASSERT_EQ(found[2], std::vector<int64_t>{999});
+    ASSERT_EQ(found.count(3), 0);
+}
+
 TEST(InsertRecordTest, string){
     using namespace milvus::segcore;
     auto schema = std::make_shared<Schema>();
@@ -112,4 +167,134 @@ TEST(InsertRecordTest, string){
     record.insert_pk(PkType(std::string("test")), int64_t(3));
     std::vector<SegOffset> offset = record.search_pk(PkType(std::string("test")), int64_t(10));
     ASSERT_EQ(offset[0].get(), int64_t(3));
-}
\ No newline at end of file
+}
+
+TEST(InsertRecordTest, pk_scan_snapshot){
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField("fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    auto record = milvus::segcore::InsertRecord(*schema, int64_t(32));
+    // sorted pk column as flush writes it; the duplicate occupies rows 2-3
+    std::vector<int64_t> pks{10, 20, 30, 30, 40, 50};
+    record.install_pk_scan_snapshot(std::vector<int64_t>(pks));
+    ASSERT_FALSE(record.empty_pks());
+
+    // before publication, lookups binary-search the snapshot
+    auto probe = [&](int64_t pk, int64_t barrier) {
+        std::vector<int64_t> offsets;
+        for (auto& off : record.search_pk(pk, barrier)) {
+            offsets.push_back(off.get());
+        }
+        return offsets;
+    };
+    ASSERT_EQ(probe(30, 100), (std::vector<int64_t>{2, 3}));
+    ASSERT_EQ(probe(30, 2), (std::vector<int64_t>{2}));
+    ASSERT_EQ(probe(10, 100), (std::vector<int64_t>{0}));
+    ASSERT_TRUE(probe(35, 100).empty());
+
+    std::map<int64_t, std::vector<int64_t>> found;
+    std::vector<int64_t> batch{30, 50, 99};
+    record.search_pks(batch, 100, [&](int64_t pk_index, int64_t offset) { found[pk_index].push_back(offset); });
+    ASSERT_EQ(found.size(), 2);
+    ASSERT_EQ(found[0], (std::vector<int64_t>{2, 3}));
+    ASSERT_EQ(found[1], (std::vector<int64_t>{5}));
+
+    // publication retires the scan path; the hash map answers identically
+    record.publish_pk_index();
+    ASSERT_FALSE(record.empty_pks());
+    ASSERT_EQ(probe(30, 100), (std::vector<int64_t>{2, 3}));
+    ASSERT_EQ(probe(30, 2), (std::vector<int64_t>{2}));
+    ASSERT_EQ(probe(10, 100), (std::vector<int64_t>{0}));
+    ASSERT_TRUE(probe(35, 100).empty());
+    // a second publish is a no-op, it must not double-insert
+    record.publish_pk_index();
+    ASSERT_EQ(probe(30, 100), (std::vector<int64_t>{2, 3}));
+}
+TEST(ChunkArena, ChunkAlignment) {
+    using namespace milvus::segcore;
+    auto check = [](ChunkArena& arena) {
+        for (auto bytes : {1, 7, 64, 100, 4096}) {
+            auto ptr = arena.allocate(bytes, 4);
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr) % ChunkArena::kChunkAlignment, 0) << bytes;
+        }
+        // an allocation larger than one slab still lands aligned
+        auto big = arena.allocate(ChunkArena::kSlabSize + 3, 8);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(big) % ChunkArena::kChunkAlignment, 0);
+    };
+    ChunkArena heap_arena;
+    check(heap_arena);
+    MmapChunkArena mmap_arena;
+    check(mmap_arena);
+
+    // enabling hugepages must never fail an allocation, whether or not the
+    // host has pages reserved: an empty pool falls back to file-backed slabs
+    MmapChunkArena::set_use_hugepages(true);
+    MmapChunkArena huge_arena;
+    check(huge_arena);
+    MmapChunkArena::set_use_hugepages(false);
+}
+
+TEST(SegCoreTest, PkBloomFilter) {
+    using milvus::segcore::PkBloomFilter;
+
+    constexpr int64_t N = 100 * 1000;
+    PkBloomFilter filter(N);
+
+    // no false negatives, ever
+    for (int64_t pk = 0; pk < N; ++pk) {
+        filter.add(PkBloomFilter::hash_pk(pk));
+    }
+    for (int64_t pk = 0; pk < N; ++pk) {
+        ASSERT_TRUE(filter.may_contain(PkBloomFilter::hash_pk(pk))) << pk;
+    }
+
+    // pks from "other segments" should almost all miss; the nominal rate is
+    // ~1%, assert a loose bound so the test is not seed-sensitive
+    int64_t false_positives = 0;
+    for (int64_t pk = N; pk < 2 * N; ++pk) {
+        if (filter.may_contain(PkBloomFilter::hash_pk(pk))) {
+            ++false_positives;
+        }
+    }
+    ASSERT_LT(false_positives, N / 20);
+
+    // string pks go through the same filter
+    PkBloomFilter str_filter(1000);
+    for (int i = 0; i < 1000; ++i) {
+        str_filter.add(PkBloomFilter::hash_pk("pk_" + std::to_string(i)));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(str_filter.may_contain(PkBloomFilter::hash_pk("pk_" + std::to_string(i))));
+    }
+}
+
+TEST(SegCoreTest, PkBloomFilterDeletePath) {
+    using namespace milvus::segcore;
+
+    // the offset map must stay exact with the filter in front of it: hits
+    // resolve, misses return empty, batch replay touches only present pks
+    auto schema = std::make_shared<Schema>();
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    auto record = InsertRecord(*schema, int64_t(32 * 1024));
+    for (int64_t pk = 0; pk < 1000; ++pk) {
+        record.insert_pk(pk, pk);
+    }
+    for (int64_t pk = 0; pk < 1000; ++pk) {
+        auto offsets = record.search_pk(pk, int64_t(1000));
+        ASSERT_EQ(offsets.size(), 1);
+        ASSERT_EQ(offsets[0].get(), pk);
+    }
+    ASSERT_TRUE(record.search_pk(int64_t(123456), int64_t(1000)).empty());
+
+    std::vector<int64_t> batch = {5, 999999, 7, 888888};
+    int64_t hits = 0;
+    record.search_pks(batch, 1000, [&](int64_t pk_index, int64_t offset) {
+        ASSERT_EQ(batch[pk_index], offset);
+        ++hits;
+    });
+    ASSERT_EQ(hits, 2);
+}
@@ -11,6 +11,10 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
+#include <vector>
+
+#include "common/SimdDispatch.h"
 #include "segcore/SimilarityCorelation.h"
 
 TEST(SimilarityCorelation, Naive) {
@@ -23,3 +27,26 @@ TEST(SimilarityCorelation, Naive) {
     ASSERT_FALSE(milvus::segcore::PositivelyRelated(knowhere::metric::SUBSTRUCTURE));
     ASSERT_FALSE(milvus::segcore::PositivelyRelated(knowhere::metric::SUPERSTRUCTURE));
 }
+
+TEST(SimilarityCorelation, NegateDistances) {
+    using milvus::SimdLevel;
+    // odd count exercises the vector tail; values cover signs, zeros and
+    // non-finite distances, all of which must flip sign exactly
+    std::vector<float> source;
+    for (int i = 0; i < 67; ++i) {
+        source.push_back((i - 33) * 0.25f);
+    }
+    source.push_back(std::numeric_limits<float>::infinity());
+    source.push_back(-std::numeric_limits<float>::infinity());
+
+    auto saved_cap = milvus::GetSimdLevelCap();
+    for (auto level : {SimdLevel::Scalar, SimdLevel::SSE42, SimdLevel::AVX2}) {
+        milvus::SetSimdLevelCap(level);
+        auto distances = source;
+        milvus::segcore::NegateDistances(distances.data(), static_cast<int64_t>(distances.size()));
+        for (size_t i = 0; i < source.size(); ++i) {
+            ASSERT_EQ(distances[i], -source[i]) << i;
+        }
+    }
+    milvus::SetSimdLevelCap(saved_cap);
+}
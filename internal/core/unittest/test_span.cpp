@@ -11,6 +11,9 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
+
+#include "common/Span.h"
 #include "segcore/SegmentGrowing.h"
 #include "test_utils/DataGen.h"
 
@@ -60,3 +63,48 @@ TEST(Span, Naive) {
         }
     }
 }
+
+TEST(Span, PrefetchedIteration) {
+    using namespace milvus;
+
+    // ForEachSpanRow must visit every row in order regardless of the
+    // prefetch distance, including distances past the row count
+    std::vector<int64_t> column(1000);
+    std::iota(column.begin(), column.end(), 0);
+    Span<int64_t> span(column.data(), column.size());
+
+    for (auto distance : {0, 1, 16, 5000}) {
+        int64_t expected = 0;
+        ForEachSpanRow(
+            span,
+            [&](int64_t i, const int64_t& value) {
+                ASSERT_EQ(i, expected);
+                ASSERT_EQ(value, expected);
+                ++expected;
+            },
+            distance);
+        ASSERT_EQ(expected, static_cast<int64_t>(column.size()));
+    }
+}
+
+TEST(Span, GatherSpanRows) {
+    using namespace milvus;
+
+    constexpr int64_t dim = 8;
+    constexpr int64_t rows = 256;
+    std::vector<float> column(rows * dim);
+    std::iota(column.begin(), column.end(), 0.0f);
+
+    // offsets out of order, with holes
+    std::vector<int64_t> offsets = {200, 0, 13, INVALID_SEG_OFFSET, 255, 13, INVALID_SEG_OFFSET, 7};
+    std::vector<float> out(offsets.size() * dim, -1.0f);
+    GatherSpanRows(reinterpret_cast<const char*>(column.data()), dim * sizeof(float), offsets.data(), offsets.size(),
+                   reinterpret_cast<char*>(out.data()));
+
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        for (int64_t d = 0; d < dim; ++d) {
+            auto expected = offsets[i] == INVALID_SEG_OFFSET ? 0.0f : column[offsets[i] * dim + d];
+            ASSERT_EQ(out[i * dim + d], expected) << "row " << i << " dim " << d;
+        }
+    }
+}
@@ -0,0 +1,83 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include "storage/IoMetrics.h"
+#include "storage/storage_metrics_c.h"
+#include "utils/Json.h"
+
+using namespace milvus;
+using storage::IoMetrics;
+using storage::IoRecorder;
+
+TEST(storage, IoMetricsRecorder) {
+    auto& stats = IoMetrics::GetInstance().stats(IoMetrics::Backend::Local, IoMetrics::Op::Read);
+    auto count_before = stats.count.load();
+    auto bytes_before = stats.bytes.load();
+    auto failures_before = stats.failures.load();
+
+    {
+        IoRecorder recorder(IoMetrics::Backend::Local, IoMetrics::Op::Read);
+        ASSERT_EQ(stats.inflight.load(), 1);
+        recorder.SetBytes(4096);
+    }
+    ASSERT_EQ(stats.inflight.load(), 0);
+    ASSERT_EQ(stats.count.load(), count_before + 1);
+    ASSERT_EQ(stats.bytes.load(), bytes_before + 4096);
+    ASSERT_EQ(stats.failures.load(), failures_before);
+
+    // an exception unwinding through the recorder counts as a failure
+    try {
+        IoRecorder recorder(IoMetrics::Backend::Local, IoMetrics::Op::Read);
+        throw std::runtime_error("broken disk");
+    } catch (std::runtime_error&) {
+    }
+    ASSERT_EQ(stats.count.load(), count_before + 2);
+    ASSERT_EQ(stats.failures.load(), failures_before + 1);
+}
+
+TEST(storage, IoMetricsSnapshot) {
+    {
+        IoRecorder recorder(IoMetrics::Backend::Remote, IoMetrics::Op::Write);
+        recorder.SetBytes(123);
+    }
+
+    char* snapshot = GetStorageIoMetrics();
+    auto json = milvus::json::parse(snapshot);
+    free(snapshot);
+
+    // both backends and every operation appear even when idle
+    for (auto backend : {"local", "remote"}) {
+        for (auto op : {"read", "write", "list"}) {
+            ASSERT_TRUE(json[backend].contains(op)) << backend << "/" << op;
+            ASSERT_TRUE(json[backend][op].contains("latency_ns"));
+        }
+    }
+    auto& write_stats = json["remote"]["write"];
+    ASSERT_GE(write_stats["count"].get<int64_t>(), 1);
+    ASSERT_GE(write_stats["bytes"].get<int64_t>(), 123);
+    ASSERT_EQ(write_stats["inflight"].get<int64_t>(), 0);
+    // every completed operation landed in some latency bucket
+    int64_t bucket_total = 0;
+    for (auto& [bound, hits] : write_stats["latency_ns"].items()) {
+        bucket_total += hits.get<int64_t>();
+    }
+    ASSERT_EQ(bucket_total, write_stats["count"].get<int64_t>());
+}
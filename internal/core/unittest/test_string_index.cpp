@@ -19,7 +19,9 @@
 
 #define private public
 #include "index/StringIndex.h"
+#include "index/StringIndexHash.h"
 #include "index/StringIndexMarisa.h"
+#include "index/StringIndexSort.h"
 
 #include "index/IndexFactory.h"
 #include "test_utils/indexbuilder_test_utils.h"
@@ -54,6 +56,15 @@ TEST_F(StringIndexMarisaTest, Constructor) {
     auto index = milvus::scalar::CreateStringIndexMarisa();
 }
 
+TEST_F(StringIndexMarisaTest, BuildParallel) {
+    auto index = milvus::scalar::CreateStringIndexMarisa();
+    index->SetBuildParallelism(4);
+    index->Build(strs.size(), strs.data());
+    auto bitset = index->In(strs.size(), strs.data());
+    ASSERT_EQ(bitset->size(), strs.size());
+    ASSERT_TRUE(bitset->all());
+}
+
 TEST_F(StringIndexMarisaTest, Build) {
     auto index = milvus::scalar::CreateStringIndexMarisa();
     index->Build(strs.size(), strs.data());
@@ -273,3 +284,276 @@ TEST_F(StringIndexMarisaTest, Codec) {
         }
     }
 }
+
+class StringIndexSortTest : public StringIndexBaseTest {};
+
+TEST_F(StringIndexSortTest, Constructor) {
+    auto index = milvus::scalar::CreateStringIndexSort();
+}
+
+TEST_F(StringIndexSortTest, BuildParallel) {
+    auto index = milvus::scalar::CreateStringIndexSort();
+    index->SetBuildParallelism(4);
+    index->Build(strs.size(), strs.data());
+    auto bitset = index->In(strs.size(), strs.data());
+    ASSERT_EQ(bitset->size(), strs.size());
+    ASSERT_TRUE(bitset->all());
+}
+
+TEST_F(StringIndexSortTest, BuildWithDataset) {
+    auto index = milvus::scalar::CreateStringIndexSort();
+    index->BuildWithDataset(str_ds);
+    ASSERT_EQ(strs.size(), index->Count());
+}
+
+TEST_F(StringIndexSortTest, In) {
+    auto index = milvus::scalar::CreateStringIndexSort();
+    index->BuildWithDataset(str_ds);
+    auto bitset = index->In(strs.size(), strs.data());
+    ASSERT_EQ(bitset->size(), strs.size());
+    ASSERT_TRUE(bitset->all());
+
+    std::vector<std::string> missing = {"not-a-generated-string"};
+    bitset = index->In(missing.size(), missing.data());
+    ASSERT_TRUE(bitset->none());
+}
+
+TEST_F(StringIndexSortTest, NotIn) {
+    auto index = milvus::scalar::CreateStringIndexSort();
+    index->BuildWithDataset(str_ds);
+    auto bitset = index->NotIn(strs.size(), strs.data());
+    ASSERT_EQ(bitset->size(), strs.size());
+    ASSERT_TRUE(bitset->none());
+}
+
+TEST_F(StringIndexSortTest, Range) {
+    auto index = milvus::scalar::CreateStringIndexSort();
+    std::vector<std::string> strings(nb);
+    for (int i = 0; i < nb; ++i) {
+        strings[i] = std::to_string(std::rand() % 10);
+    }
+    index->Build(nb, strings.data());
+
+    {
+        auto bitset = index->Range("0", milvus::OpType::GreaterEqual);
+        ASSERT_EQ(bitset->size(), nb);
+        ASSERT_EQ(bitset->count(), nb);
+    }
+
+    {
+        auto bitset = index->Range("90", milvus::OpType::LessThan);
+        ASSERT_EQ(bitset->size(), nb);
+        ASSERT_EQ(bitset->count(), nb);
+    }
+
+    {
+        auto bitset = index->Range("9", milvus::OpType::LessEqual);
+        ASSERT_EQ(bitset->size(), nb);
+        ASSERT_EQ(bitset->count(), nb);
+    }
+
+    {
+        auto bitset = index->Range("0", true, "9", true);
+        ASSERT_EQ(bitset->size(), nb);
+        ASSERT_EQ(bitset->count(), nb);
+    }
+
+    {
+        auto bitset = index->Range("0", true, "90", false);
+        ASSERT_EQ(bitset->size(), nb);
+        ASSERT_EQ(bitset->count(), nb);
+    }
+
+    {
+        // inverted and half-open-empty bounds select nothing
+        auto bitset = index->Range("9", true, "0", true);
+        ASSERT_TRUE(bitset->none());
+        bitset = index->Range("5", false, "5", true);
+        ASSERT_TRUE(bitset->none());
+    }
+}
+
+TEST_F(StringIndexSortTest, PrefixMatch) {
+    auto index = milvus::scalar::CreateStringIndexSort();
+    index->BuildWithDataset(str_ds);
+
+    for (size_t i = 0; i < strs.size(); i++) {
+        auto bitset = index->PrefixMatch(strs[i]);
+        ASSERT_EQ(bitset->size(), strs.size());
+        ASSERT_TRUE(bitset->test(i));
+    }
+}
+
+TEST_F(StringIndexSortTest, ReverseLookup) {
+    auto index = milvus::scalar::CreateStringIndexSort();
+    index->BuildWithDataset(str_ds);
+
+    for (size_t i = 0; i < strs.size(); i++) {
+        ASSERT_EQ(index->Reverse_Lookup(i), strs[i]);
+    }
+}
+
+TEST_F(StringIndexSortTest, Codec) {
+    auto index = milvus::scalar::CreateStringIndexSort();
+    std::vector<std::string> strings(nb);
+    for (int i = 0; i < nb; ++i) {
+        strings[i] = std::to_string(std::rand() % 10);
+    }
+    index->Build(nb, strings.data());
+
+    auto copy_index = milvus::scalar::CreateStringIndexSort();
+    {
+        auto binary_set = index->Serialize(nullptr);
+        copy_index->Load(binary_set);
+    }
+    ASSERT_EQ(copy_index->Count(), nb);
+
+    {
+        auto bitset = copy_index->In(nb, strings.data());
+        ASSERT_EQ(bitset->size(), nb);
+        ASSERT_TRUE(bitset->all());
+    }
+
+    {
+        std::vector<std::string> invalid_strings = {std::to_string(nb)};
+        auto bitset = copy_index->In(1, invalid_strings.data());
+        ASSERT_EQ(bitset->size(), nb);
+        ASSERT_TRUE(bitset->none());
+    }
+
+    {
+        auto bitset = copy_index->Range("0", true, "9", true);
+        ASSERT_EQ(bitset->size(), nb);
+        ASSERT_EQ(bitset->count(), nb);
+    }
+
+    {
+        for (size_t i = 0; i < nb; i++) {
+            ASSERT_EQ(copy_index->Reverse_Lookup(i), strings[i]);
+            auto bitset = copy_index->PrefixMatch(strings[i]);
+            ASSERT_EQ(bitset->size(), nb);
+            ASSERT_TRUE(bitset->test(i));
+        }
+    }
+}
+
+class StringIndexHashTest : public StringIndexBaseTest {};
+
+TEST_F(StringIndexHashTest, Constructor) {
+    auto index = milvus::scalar::CreateStringIndexHash();
+}
+
+TEST_F(StringIndexHashTest, In) {
+    auto index = milvus::scalar::CreateStringIndexHash();
+    index->BuildWithDataset(str_ds);
+    ASSERT_EQ(strs.size(), index->Count());
+
+    auto bitset = index->In(strs.size(), strs.data());
+    ASSERT_EQ(bitset->size(), strs.size());
+    ASSERT_TRUE(bitset->all());
+
+    std::vector<std::string> missing = {"not-a-generated-string"};
+    bitset = index->In(missing.size(), missing.data());
+    ASSERT_TRUE(bitset->none());
+}
+
+TEST_F(StringIndexHashTest, NotIn) {
+    auto index = milvus::scalar::CreateStringIndexHash();
+    index->BuildWithDataset(str_ds);
+    auto bitset = index->NotIn(strs.size(), strs.data());
+    ASSERT_EQ(bitset->size(), strs.size());
+    ASSERT_TRUE(bitset->none());
+}
+
+TEST_F(StringIndexHashTest, DuplicatedValues) {
+    auto index = milvus::scalar::CreateStringIndexHash();
+    std::vector<std::string> strings(nb);
+    for (int i = 0; i < nb; ++i) {
+        strings[i] = std::to_string(i % 10);
+    }
+    index->Build(nb, strings.data());
+
+    std::vector<std::string> probe = {"7"};
+    auto bitset = index->In(1, probe.data());
+    for (size_t i = 0; i < nb; i++) {
+        ASSERT_EQ(bitset->test(i), (i % 10) == 7);
+    }
+}
+
+TEST_F(StringIndexHashTest, UnsupportedPredicates) {
+    auto index = milvus::scalar::CreateStringIndexHash();
+    index->BuildWithDataset(str_ds);
+    ASSERT_THROW(index->Range("a", milvus::OpType::GreaterEqual), std::invalid_argument);
+    ASSERT_THROW(index->Range("a", true, "z", true), std::invalid_argument);
+    ASSERT_THROW(index->PrefixMatch("a"), std::invalid_argument);
+}
+
+TEST_F(StringIndexHashTest, ReverseLookup) {
+    auto index = milvus::scalar::CreateStringIndexHash();
+    index->BuildWithDataset(str_ds);
+    for (size_t i = 0; i < strs.size(); i++) {
+        ASSERT_EQ(index->Reverse_Lookup(i), strs[i]);
+    }
+}
+
+TEST_F(StringIndexHashTest, Codec) {
+    auto index = milvus::scalar::CreateStringIndexHash();
+    std::vector<std::string> strings(nb);
+    for (int i = 0; i < nb; ++i) {
+        strings[i] = std::to_string(std::rand());
+    }
+    index->Build(nb, strings.data());
+
+    auto copy_index = milvus::scalar::CreateStringIndexHash();
+    {
+        auto binary_set = index->Serialize(nullptr);
+        copy_index->Load(binary_set);
+    }
+    ASSERT_EQ(copy_index->Count(), nb);
+
+    auto bitset = copy_index->In(nb, strings.data());
+    ASSERT_EQ(bitset->size(), nb);
+    ASSERT_TRUE(bitset->all());
+
+    for (size_t i = 0; i < nb; i++) {
+        ASSERT_EQ(copy_index->Reverse_Lookup(i), strings[i]);
+    }
+}
+
+TEST_F(StringIndexMarisaTest, CodecWithoutOffsetsMapping) {
+    auto index = milvus::scalar::CreateStringIndexMarisa();
+    std::vector<std::string> strings(nb);
+    for (int i = 0; i < nb; ++i) {
+        strings[i] = std::to_string(std::rand() % 10);
+    }
+    *str_arr.mutable_data() = {strings.begin(), strings.end()};
+    str_ds = GenDsFromPB(str_arr);
+    index->BuildWithDataset(str_ds);
+
+    // an index serialized before the offsets mapping was persisted only
+    // carries the trie and the str ids; Load rebuilds the mapping
+    auto binary_set = index->Serialize(nullptr);
+    knowhere::BinarySet legacy_set;
+    auto trie = binary_set.GetByName(milvus::scalar::MARISA_TRIE_INDEX);
+    legacy_set.Append(milvus::scalar::MARISA_TRIE_INDEX, trie->data, trie->size);
+    auto str_ids = binary_set.GetByName(milvus::scalar::MARISA_STR_IDS);
+    legacy_set.Append(milvus::scalar::MARISA_STR_IDS, str_ids->data, str_ids->size);
+
+    auto copy_index = milvus::scalar::CreateStringIndexMarisa();
+    copy_index->Load(legacy_set);
+
+    {
+        auto bitset = copy_index->In(nb, strings.data());
+        ASSERT_EQ(bitset->size(), nb);
+        ASSERT_TRUE(bitset->any());
+    }
+
+    {
+        for (size_t i = 0; i < nb; i++) {
+            auto str = strings[i];
+            auto bitset = copy_index->PrefixMatch(str);
+            ASSERT_EQ(bitset->size(), nb);
+            ASSERT_TRUE(bitset->test(i));
+        }
+    }
+}
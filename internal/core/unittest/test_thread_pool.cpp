@@ -0,0 +1,85 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "common/ThreadPool.h"
+
+using namespace milvus;
+
+TEST(ThreadPool, PriorityClasses) {
+    ThreadPool pool(1);
+    // park the single worker so the tasks queued below are dispatched in
+    // one deterministic drain once the gate opens
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+    auto parked = pool.Submit([opened] { opened.wait(); });
+
+    // a fresh credit cycle dispatches eight interactive tasks before the
+    // single batch one, regardless of submission order
+    std::vector<std::string> order;
+    std::vector<std::future<void>> futures;
+    futures.emplace_back(
+        pool.Submit(TaskOptions{TaskPriority::Batch}, [&order] { order.emplace_back("batch"); }));
+    for (int i = 0; i < 8; ++i) {
+        futures.emplace_back(
+            pool.Submit(TaskOptions{TaskPriority::Interactive}, [&order] { order.emplace_back("interactive"); }));
+    }
+    gate.set_value();
+    for (auto& future : futures) {
+        future.wait();
+    }
+    parked.wait();
+
+    ASSERT_EQ(order.size(), 9);
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_EQ(order[i], "interactive") << i;
+    }
+    ASSERT_EQ(order.back(), "batch");
+}
+
+TEST(ThreadPool, DeadlineSkipsAhead) {
+    ThreadPool pool(1);
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+    auto parked = pool.Submit([opened] { opened.wait(); });
+
+    // the nearly-expired batch query outranks even interactive work
+    std::vector<std::string> order;
+    auto interactive =
+        pool.Submit(TaskOptions{TaskPriority::Interactive}, [&order] { order.emplace_back("interactive"); });
+    TaskOptions urgent{TaskPriority::Batch, std::chrono::steady_clock::now() + std::chrono::milliseconds(1)};
+    auto deadline = pool.Submit(urgent, [&order] { order.emplace_back("deadline"); });
+    gate.set_value();
+    interactive.wait();
+    deadline.wait();
+    parked.wait();
+
+    ASSERT_EQ(order, (std::vector<std::string>{"deadline", "interactive"}));
+}
+
+TEST(ThreadPool, NestedSubmitInheritsOptions) {
+    ThreadPool pool(1);
+    // workers install the running task's options, so fan-out submits keep
+    // the class the C API entry point set
+    auto nested = pool.Submit(TaskOptions{TaskPriority::Interactive},
+                              [] { return ScopedTaskOptions::Current().priority; });
+    ASSERT_EQ(nested.get(), TaskPriority::Interactive);
+
+    ScopedTaskOptions scope(TaskOptions{TaskPriority::Batch});
+    auto inherited = pool.Submit([] { return ScopedTaskOptions::Current().priority; });
+    ASSERT_EQ(inherited.get(), TaskPriority::Batch);
+}
@@ -10,6 +10,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
 #include <vector>
 
 #include "segcore/TimestampIndex.h"
@@ -33,3 +35,123 @@ TEST(TimestampIndex, Naive) {
         ASSERT_EQ(guessed_slice[i], lengths[i]);
     }
 }
+
+TEST(TimestampIndex, ActiveRangeAndBitset) {
+    std::vector<Timestamp> timestamps{
+        1, 2, 14, 11, 13, 20, 21, 22,
+    };
+    std::vector<int64_t> lengths = {2, 3, 3};
+    TimestampIndex index;
+    index.set_length_meta(lengths);
+    index.build_with(timestamps.data(), timestamps.size());
+
+    // query covers the boundary slice entirely: undecided range collapses
+    auto range = index.get_active_range(14);
+    ASSERT_EQ(range.first, range.second);
+    ASSERT_EQ(range.first, 5);
+
+    for (Timestamp query : {2, 11, 13, 20, 21}) {
+        auto active_range = index.get_active_range(query);
+        if (active_range.first == active_range.second) {
+            continue;
+        }
+        auto bitset = TimestampIndex::GenerateBitset(query, active_range, timestamps.data(), timestamps.size());
+        ASSERT_EQ(bitset.size(), timestamps.size());
+        for (int64_t i = 0; i < timestamps.size(); ++i) {
+            ASSERT_EQ(bitset[i], timestamps[i] > query) << "query=" << query << " i=" << i;
+        }
+        auto split = index.search_active_split(query, active_range, timestamps.data());
+        if (split >= 0) {
+            for (int64_t i = 0; i < timestamps.size(); ++i) {
+                ASSERT_EQ(i >= split, timestamps[i] > query) << "query=" << query << " i=" << i;
+            }
+        }
+    }
+
+    // slice {14, 11, 13} is unsorted, so its boundary query falls back
+    auto mid_range = index.get_active_range(12);
+    ASSERT_EQ(index.search_active_split(12, mid_range, timestamps.data()), -1);
+    // slice {20, 21, 22} is sorted and splits by binary search
+    auto tail_range = index.get_active_range(20);
+    ASSERT_EQ(index.search_active_split(20, tail_range, timestamps.data()), 6);
+}
+
+TEST(TimestampIndex, Monotonic) {
+    // sorted column spanning several delta blocks, with duplicate runs
+    const int64_t N = 10000;
+    std::vector<Timestamp> timestamps(N);
+    Timestamp value = 1'000'000;
+    for (int64_t i = 0; i < N; ++i) {
+        value += i % 3;
+        timestamps[i] = value;
+    }
+
+    TimestampIndex index;
+    index.build_monotonic(timestamps.data(), N);
+    ASSERT_TRUE(index.has_compressed_column());
+
+    // out-of-range queries keep their early-outs
+    ASSERT_EQ(index.get_active_range(timestamps.back()), std::make_pair(N, N));
+    ASSERT_EQ(index.get_active_range(timestamps.front() - 1), std::make_pair(int64_t(0), int64_t(0)));
+
+    // every in-range query resolves to the exact upper-bound split,
+    // leaving nothing undecided
+    for (int64_t probe : {int64_t(0), int64_t(1), int64_t(4097), N / 2, N - 2}) {
+        auto query = timestamps[probe];
+        auto range = index.get_active_range(query);
+        ASSERT_EQ(range.first, range.second) << "probe=" << probe;
+        auto expected = std::upper_bound(timestamps.begin(), timestamps.end(), query) - timestamps.begin();
+        ASSERT_EQ(range.first, expected) << "probe=" << probe;
+    }
+
+    // parity with the slice-built index on the same data
+    TimestampIndex sliced_index;
+    sliced_index.set_length_meta(GenerateFakeSlices(timestamps.data(), N, 4096));
+    sliced_index.build_with(timestamps.data(), N);
+    for (int64_t probe : {int64_t(42), N / 2, N - 1}) {
+        auto query = timestamps[probe];
+        auto fast = index.get_active_range(query);
+        auto slow = sliced_index.get_active_range(query);
+        // both agree that [0, beg) is visible and [end, N) is not
+        ASSERT_GE(fast.first, slow.first);
+        ASSERT_LE(fast.second, slow.second);
+    }
+}
+
+TEST(TimestampIndex, CompressedBitset) {
+    // nearly monotonic with small deltas plus a few wide jumps, so the
+    // frame-of-reference blocks span every packed width
+    std::default_random_engine rng(42);
+    const int64_t N = 20000;
+    std::vector<Timestamp> timestamps(N);
+    Timestamp value = 1'000'000'000;
+    for (int64_t i = 0; i < N; ++i) {
+        value += rng() % 7;
+        if (i == N / 3) {
+            value += Timestamp(1) << 20;
+        }
+        if (i == 2 * N / 3) {
+            value += Timestamp(1) << 36;
+        }
+        timestamps[i] = value;
+    }
+    // break sortedness inside one block so the compare kernel really runs
+    std::shuffle(timestamps.begin() + 100, timestamps.begin() + 400, rng);
+
+    auto lengths = GenerateFakeSlices(timestamps.data(), N, 4096);
+    TimestampIndex index;
+    index.set_length_meta(std::move(lengths));
+    index.build_with(timestamps.data(), N);
+    ASSERT_TRUE(index.has_compressed_column());
+
+    for (int64_t probe : {int64_t(0), int64_t(150), N / 3, 2 * N / 3, N - 1}) {
+        auto query = timestamps[probe];
+        auto range = index.get_active_range(query);
+        if (range.first == range.second) {
+            continue;
+        }
+        auto expected = TimestampIndex::GenerateBitset(query, range, timestamps.data(), N);
+        auto compressed = index.generate_compressed_bitset(query, range, N);
+        ASSERT_EQ(compressed, expected) << "probe=" << probe;
+    }
+}
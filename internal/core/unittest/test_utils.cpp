@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 #include <string.h>
 
+#include "common/BitsetView.h"
 #include "common/Utils.h"
 #include "query/Utils.h"
 #include "test_utils/DataGen.h"
@@ -35,6 +36,44 @@ TEST(Util, StringMatch) {
     ASSERT_FALSE(PostfixMatch("dontmatch", "postfix"));
 }
 
+TEST(Util, BitsetViewBitGranularSubview) {
+    using namespace milvus;
+
+    int64_t n = 1000;
+    BitsetType bitset(n);
+    for (int64_t i = 0; i < n; ++i) {
+        bitset[i] = (i % 3 == 0);
+    }
+    BitsetView view(bitset);
+
+    // a chunk size that is not a multiple of 8 lands subviews mid-byte
+    int64_t chunk_rows = 100;
+    for (int64_t offset = 0; offset < n; offset += chunk_rows) {
+        auto rows = std::min(chunk_rows, n - offset);
+        auto sub = view.subview(offset, rows);
+        for (int64_t i = 0; i < rows; ++i) {
+            ASSERT_EQ(sub.test(i), bool(bitset[offset + i])) << offset << "+" << i;
+        }
+        // the knowhere adapter re-bases to bit 0 with identical contents
+        auto aligned = sub.as_byte_aligned();
+        ASSERT_TRUE(aligned.byte_aligned());
+        for (int64_t i = 0; i < rows; ++i) {
+            ASSERT_EQ(aligned.test(i), bool(bitset[offset + i])) << offset << "+" << i;
+        }
+        if (offset % 8 == 0) {
+            // byte-aligned views pass through zero-copy
+            ASSERT_EQ(aligned.data(), view.data() + offset / 8);
+        }
+    }
+
+    // subviews compose at bit granularity
+    auto outer = view.subview(3, 500);
+    auto inner = outer.subview(10, 100);
+    for (int64_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(inner.test(i), bool(bitset[13 + i]));
+    }
+}
+
 TEST(Util, GetDeleteBitmap) {
     using namespace milvus;
     using namespace milvus::query;
@@ -47,7 +86,7 @@ TEST(Util, GetDeleteBitmap) {
     auto N = 10;
 
     InsertRecord insert_record(*schema, N);
-    DeletedRecord delete_record;
+    DeletedRecord delete_record(*schema);
 
     // fill insert record, all insert records has same pk = 1, timestamps= {1 ... N}
     std::vector<int64_t> age_data(N);
@@ -65,10 +104,10 @@ TEST(Util, GetDeleteBitmap) {
 
     // test case delete pk1(ts = 0) -> insert repeated pk1 (ts = {1 ... N}) -> query (ts = N)
     std::vector<Timestamp> delete_ts = {0};
-    std::vector<PkType> delete_pk = {1};
+    std::vector<int64_t> delete_pk = {1};
     auto offset = delete_record.reserved.fetch_add(1);
     delete_record.timestamps_.set_data_raw(offset, delete_ts.data(), 1);
-    delete_record.pks_.set_data_raw(offset, delete_pk.data(), 1);
+    delete_record.pks<int64_t>().set_data_raw(offset, delete_pk.data(), 1);
     delete_record.ack_responder_.AddSegment(offset, offset + 1);
 
     auto query_timestamp = tss[N - 1];
@@ -82,7 +121,7 @@ TEST(Util, GetDeleteBitmap) {
     delete_pk = {1};
     offset = delete_record.reserved.fetch_add(1);
     delete_record.timestamps_.set_data_raw(offset, delete_ts.data(), 1);
-    delete_record.pks_.set_data_raw(offset, delete_pk.data(), 1);
+    delete_record.pks<int64_t>().set_data_raw(offset, delete_pk.data(), 1);
     delete_record.ack_responder_.AddSegment(offset, offset + 1);
 
     del_barrier = get_barrier(delete_record, query_timestamp);
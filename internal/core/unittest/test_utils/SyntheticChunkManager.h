@@ -0,0 +1,143 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "exceptions/EasyAssert.h"
+#include "storage/ChunkManager.h"
+
+namespace milvus::storage {
+
+// In-memory ChunkManager that charges a configurable per-read latency and
+// bandwidth before serving bytes, so load-path benchmarks can model anything
+// from page cache to object store without touching real storage. Reads are
+// counted; writes and metadata ops are free.
+class SyntheticChunkManager : public ChunkManager {
+ public:
+    explicit SyntheticChunkManager(int64_t read_latency_us = 0, int64_t read_bandwidth_bps = 0)
+        : read_latency_us_(read_latency_us), read_bandwidth_bps_(read_bandwidth_bps) {
+    }
+
+    bool
+    Exist(const std::string& filepath) override {
+        std::lock_guard lck(mutex_);
+        return files_.count(filepath) != 0;
+    }
+
+    uint64_t
+    Size(const std::string& filepath) override {
+        std::lock_guard lck(mutex_);
+        auto it = files_.find(filepath);
+        AssertInfo(it != files_.end(), "synthetic file not found: " + filepath);
+        return it->second.size();
+    }
+
+    uint64_t
+    Read(const std::string& filepath, void* buf, uint64_t len) override {
+        return Read(filepath, 0, buf, len);
+    }
+
+    uint64_t
+    Read(const std::string& filepath, uint64_t offset, void* buf, uint64_t len) override {
+        std::unique_lock lck(mutex_);
+        auto it = files_.find(filepath);
+        AssertInfo(it != files_.end(), "synthetic file not found: " + filepath);
+        AssertInfo(offset <= it->second.size(), "read offset past end of synthetic file");
+        auto n = std::min(len, it->second.size() - offset);
+        std::memcpy(buf, it->second.data() + offset, n);
+        lck.unlock();
+
+        Throttle(n);
+        bytes_read_.fetch_add(n, std::memory_order_relaxed);
+        return n;
+    }
+
+    void
+    Write(const std::string& filepath, void* buf, uint64_t len) override {
+        std::lock_guard lck(mutex_);
+        auto begin = static_cast<const char*>(buf);
+        files_[filepath].assign(begin, begin + len);
+    }
+
+    void
+    Write(const std::string& filepath, uint64_t offset, void* buf, uint64_t len) override {
+        std::lock_guard lck(mutex_);
+        auto& file = files_[filepath];
+        if (file.size() < offset + len) {
+            file.resize(offset + len);
+        }
+        std::memcpy(file.data() + offset, buf, len);
+    }
+
+    std::vector<std::string>
+    ListWithPrefix(const std::string& filepath) override {
+        std::lock_guard lck(mutex_);
+        std::vector<std::string> result;
+        for (auto& [path, _] : files_) {
+            if (path.compare(0, filepath.size(), filepath) == 0) {
+                result.push_back(path);
+            }
+        }
+        return result;
+    }
+
+    void
+    Remove(const std::string& filepath) override {
+        std::lock_guard lck(mutex_);
+        files_.erase(filepath);
+    }
+
+    std::string
+    GetName() const override {
+        return "SyntheticChunkManager";
+    }
+
+    int64_t
+    TotalBytesRead() const {
+        return bytes_read_.load(std::memory_order_relaxed);
+    }
+
+    void
+    ResetCounters() {
+        bytes_read_.store(0, std::memory_order_relaxed);
+    }
+
+ private:
+    void
+    Throttle(uint64_t len) const {
+        int64_t delay_us = read_latency_us_;
+        if (read_bandwidth_bps_ > 0) {
+            delay_us += static_cast<int64_t>(len * 1'000'000 / read_bandwidth_bps_);
+        }
+        if (delay_us > 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(delay_us));
+        }
+    }
+
+    int64_t read_latency_us_;
+    int64_t read_bandwidth_bps_;
+    mutable std::mutex mutex_;
+    std::map<std::string, std::string> files_;
+    std::atomic<int64_t> bytes_read_{0};
+};
+
+}  // namespace milvus::storage
@@ -2,6 +2,7 @@
 # from gen_base_visitor import *
 # from gen_node import *
 from assemble import *
+from fused_gen import gen_fused
 from meta_gen import *
 import re
 import os
@@ -109,4 +110,6 @@ if __name__ == "__main__":
             template = 'templates/visitor_derived.cpp'
             output = output_path + vis_name + '.cpp'
             gen_file(rootfile, template, output, **info)
+
+    gen_fused(output_path)
     print("Done")
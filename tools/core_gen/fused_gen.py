@@ -0,0 +1,201 @@
+#!python
+# Emits the fused filter kernels for hot conjunction shapes: for every
+# scalar type and comparison operator, a single-pass (term AND range) or
+# (compare AND range) kernel plus the shape-matching dispatch picked up by
+# ExecExprVisitor's LogicalAnd evaluation.
+from meta_gen import readfile, replace_all
+
+SCALAR_TYPES = [
+    ("int8_t", "Int8", "INT8"),
+    ("int16_t", "Int16", "INT16"),
+    ("int32_t", "Int32", "INT32"),
+    ("int64_t", "Int64", "INT64"),
+    ("float", "Float", "FLOAT"),
+    ("double", "Double", "DOUBLE"),
+]
+
+COMPARE_OPS = [
+    ("LessThan", "<"),
+    ("LessEqual", "<="),
+    ("GreaterThan", ">"),
+    ("GreaterEqual", ">="),
+    ("Equal", "=="),
+    ("NotEqual", "!="),
+]
+
+TERM_UNARY_CASE = """\
+            case OpType::{op}: {{
+                out = EvalFusedTwoColumn<{ctype}>(
+                    segment, row_count, term.field_id_, unary->field_id_,
+                    [&probe, val]({ctype} x, {ctype} y) {{ return y {sym} val && probe(x); }});
+                return true;
+            }}"""
+
+TERM_BINARY_CASE = """\
+            case {key}: {{
+                out = EvalFusedTwoColumn<{ctype}>(
+                    segment, row_count, term.field_id_, binary->field_id_,
+                    [&probe, lower, upper]({ctype} x, {ctype} y) {{
+                        return lower {losym} y && y {upsym} upper && probe(x);
+                    }});
+                return true;
+            }}"""
+
+COMPARE_INNER_CASE = """\
+                case OpType::{rop}: {{
+                    out = EvalFusedThreeColumn<{ctype}>(
+                        segment, row_count, compare.left_field_id_, compare.right_field_id_, range.field_id_,
+                        [val]({ctype} a, {ctype} b, {ctype} y) {{ return a {csym} b && y {rsym} val; }});
+                    return true;
+                }}"""
+
+COMPARE_OUTER_CASE = """\
+        case OpType::{cop}: {{
+            switch (range.op_type_) {{
+{inner}
+                default: {{
+                    return false;
+                }}
+            }}
+        }}"""
+
+TYPE_BLOCK = """\
+// ---- {ctype} ----
+
+bool
+TryFusedTermRange{name}(const segcore::SegmentInternalInterface& segment,
+                        int64_t row_count,
+                        const TermExprImpl<{ctype}>& term,
+                        const Expr& range,
+                        BitsetType& out) {{
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (auto unary = dynamic_cast<const UnaryRangeExprImpl<{ctype}>*>(&range)) {{
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, unary->field_id_, num_chunk)) {{
+            return false;
+        }}
+        SortedTerms<{ctype}> probe(term.terms_);
+        auto val = unary->value_;
+        switch (unary->op_type_) {{
+{term_unary_cases}
+            default: {{
+                return false;
+            }}
+        }}
+    }}
+    if (auto binary = dynamic_cast<const BinaryRangeExprImpl<{ctype}>*>(&range)) {{
+        if (!FusableField(segment, term.field_id_, num_chunk) || !FusableField(segment, binary->field_id_, num_chunk)) {{
+            return false;
+        }}
+        SortedTerms<{ctype}> probe(term.terms_);
+        auto lower = binary->lower_value_;
+        auto upper = binary->upper_value_;
+        switch ((binary->lower_inclusive_ ? 2 : 0) | (binary->upper_inclusive_ ? 1 : 0)) {{
+{term_binary_cases}
+            default: {{
+                return false;
+            }}
+        }}
+    }}
+    return false;
+}}
+
+bool
+TryFusedCompareRange{name}(const segcore::SegmentInternalInterface& segment,
+                           int64_t row_count,
+                           const CompareExpr& compare,
+                           const UnaryRangeExprImpl<{ctype}>& range,
+                           BitsetType& out) {{
+    if (compare.left_data_type_ != DataType::{dtype} || compare.right_data_type_ != DataType::{dtype}) {{
+        return false;
+    }}
+    auto num_chunk = upper_div(row_count, segment.size_per_chunk());
+    if (!FusableField(segment, compare.left_field_id_, num_chunk) ||
+        !FusableField(segment, compare.right_field_id_, num_chunk) ||
+        !FusableField(segment, range.field_id_, num_chunk)) {{
+        return false;
+    }}
+    auto val = range.value_;
+    switch (compare.op_type_) {{
+{compare_cases}
+        default: {{
+            return false;
+        }}
+    }}
+}}
+
+bool
+TryFused{name}(const segcore::SegmentInternalInterface& segment,
+               int64_t row_count,
+               const Expr& left,
+               const Expr& right,
+               BitsetType& out) {{
+    if (auto term = dynamic_cast<const TermExprImpl<{ctype}>*>(&left)) {{
+        return TryFusedTermRange{name}(segment, row_count, *term, right, out);
+    }}
+    if (auto term = dynamic_cast<const TermExprImpl<{ctype}>*>(&right)) {{
+        return TryFusedTermRange{name}(segment, row_count, *term, left, out);
+    }}
+    if (auto compare = dynamic_cast<const CompareExpr*>(&left)) {{
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<{ctype}>*>(&right)) {{
+            return TryFusedCompareRange{name}(segment, row_count, *compare, *range, out);
+        }}
+    }}
+    if (auto compare = dynamic_cast<const CompareExpr*>(&right)) {{
+        if (auto range = dynamic_cast<const UnaryRangeExprImpl<{ctype}>*>(&left)) {{
+            return TryFusedCompareRange{name}(segment, row_count, *compare, *range, out);
+        }}
+    }}
+    return false;
+}}
+"""
+
+TRY_LINE = """\
+    if (TryFused{name}(segment, row_count, left, right, out)) {{
+        return out;
+    }}"""
+
+BOUND_SYMS = {True: "<=", False: "<"}
+
+
+def type_block(ctype, name, dtype):
+    term_unary_cases = "\n".join(
+        TERM_UNARY_CASE.format(op=op, sym=sym, ctype=ctype) for op, sym in COMPARE_OPS)
+    term_binary_cases = "\n".join(
+        TERM_BINARY_CASE.format(key=(2 if lower else 0) | (1 if upper else 0),
+                                losym=BOUND_SYMS[lower],
+                                upsym=BOUND_SYMS[upper],
+                                ctype=ctype)
+        for lower in (False, True) for upper in (False, True))
+    compare_cases = "\n".join(
+        COMPARE_OUTER_CASE.format(
+            cop=cop,
+            inner="\n".join(
+                COMPARE_INNER_CASE.format(rop=rop, csym=csym, rsym=rsym, ctype=ctype)
+                for rop, rsym in COMPARE_OPS)) for cop, csym in COMPARE_OPS)
+    return TYPE_BLOCK.format(ctype=ctype,
+                             name=name,
+                             dtype=dtype,
+                             term_unary_cases=term_unary_cases,
+                             term_binary_cases=term_binary_cases,
+                             compare_cases=compare_cases)
+
+
+def gen_fused(output_path):
+    license = open("../../internal/core/build-support/cpp_license.txt").read()
+
+    header = readfile("templates/fused_expr.h")
+    with open(output_path + "FusedExprEval.h", "w") as file:
+        file.write(license + header)
+
+    kernel_blocks = "\n".join(type_block(*entry) for entry in SCALAR_TYPES)
+    try_lines = "\n".join(TRY_LINE.format(name=name) for _, name, _ in SCALAR_TYPES)
+    source = replace_all(readfile("templates/fused_expr.cpp"),
+                         kernel_blocks=kernel_blocks,
+                         try_lines=try_lines)
+    with open(output_path + "FusedExprEval.cpp", "w") as file:
+        file.write(license + source)
+
+
+if __name__ == "__main__":
+    gen_fused("../../internal/core/src/query/generated/")
+    print("Done")
@@ -0,0 +1,122 @@
+// Generated File
+// DO NOT EDIT
+#include <algorithm>
+#include <optional>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <vector>
+
+#include "query/generated/FusedExprEval.h"
+#include "common/BitsetUtils.h"
+#include "common/Utils.h"
+#include "query/ExprImpl.h"
+#include "segcore/SegmentInterface.h"
+
+namespace milvus::query {
+
+namespace {
+
+// mirrors the expression visitors' threshold for fanning chunk evaluation
+// out to tbb
+constexpr int64_t kParallelEvalRowThreshold = 256 * 1024;
+
+// a field is fusable when every chunk scans raw data; a field with any
+// scalar index goes through the split per-leaf path instead
+bool
+FusableField(const segcore::SegmentInternalInterface& segment, FieldId field_id, int64_t num_chunk) {
+    return segment.num_chunk_index(field_id) == 0 && segment.num_chunk_data(field_id) >= num_chunk;
+}
+
+template <typename Eval>
+BitsetType
+EvalFusedChunks(const segcore::SegmentInternalInterface& segment, int64_t row_count, Eval eval) {
+    auto size_per_chunk = segment.size_per_chunk();
+    auto num_chunk = upper_div(row_count, size_per_chunk);
+    std::vector<BitsetType> results(num_chunk);
+    auto eval_chunk = [&](int64_t chunk_id) {
+        auto this_size = chunk_id == num_chunk - 1 ? row_count - chunk_id * size_per_chunk : size_per_chunk;
+        BitsetType result(this_size);
+        eval(chunk_id, this_size, result);
+        results[chunk_id] = std::move(result);
+    };
+    if (num_chunk > 1 && row_count >= kParallelEvalRowThreshold) {
+        tbb::parallel_for(tbb::blocked_range<int64_t>(0, num_chunk), [&](const tbb::blocked_range<int64_t>& range) {
+            for (auto chunk_id = range.begin(); chunk_id != range.end(); ++chunk_id) {
+                eval_chunk(chunk_id);
+            }
+        });
+    } else {
+        for (auto chunk_id = 0; chunk_id < num_chunk; ++chunk_id) {
+            eval_chunk(chunk_id);
+        }
+    }
+    BitsetType final_result(row_count);
+    int64_t counter = 0;
+    for (auto& chunk : results) {
+        AppendBitset(final_result, counter, chunk);
+        counter += chunk.size();
+    }
+    return final_result;
+}
+
+template <typename T, typename Func>
+BitsetType
+EvalFusedTwoColumn(const segcore::SegmentInternalInterface& segment,
+                   int64_t row_count,
+                   FieldId left_field,
+                   FieldId right_field,
+                   Func func) {
+    return EvalFusedChunks(segment, row_count, [&](int64_t chunk_id, int64_t size, BitsetType& result) {
+        auto left = segment.chunk_data<T>(left_field, chunk_id);
+        auto right = segment.chunk_data<T>(right_field, chunk_id);
+        EvalBinaryElementwise(left.data(), right.data(), size, result, func);
+    });
+}
+
+template <typename T, typename Func>
+BitsetType
+EvalFusedThreeColumn(const segcore::SegmentInternalInterface& segment,
+                     int64_t row_count,
+                     FieldId a_field,
+                     FieldId b_field,
+                     FieldId c_field,
+                     Func func) {
+    return EvalFusedChunks(segment, row_count, [&](int64_t chunk_id, int64_t size, BitsetType& result) {
+        auto a = segment.chunk_data<T>(a_field, chunk_id);
+        auto b = segment.chunk_data<T>(b_field, chunk_id);
+        auto c = segment.chunk_data<T>(c_field, chunk_id);
+        EvalTernaryElementwise(a.data(), b.data(), c.data(), size, result, func);
+    });
+}
+
+// sorted IN-list probe shared by the term kernels
+template <typename T>
+class SortedTerms {
+ public:
+    explicit SortedTerms(const std::vector<T>& terms) : values_(terms) {
+        std::sort(values_.begin(), values_.end());
+    }
+
+    bool
+    operator()(T value) const {
+        return std::binary_search(values_.begin(), values_.end(), value);
+    }
+
+ private:
+    std::vector<T> values_;
+};
+
+@@kernel_blocks@@
+}  // namespace
+
+std::optional<BitsetType>
+TryFusedConjunction(const segcore::SegmentInternalInterface& segment,
+                    int64_t row_count,
+                    const Expr& left,
+                    const Expr& right) {
+    BitsetType out;
+@@try_lines@@
+    return std::nullopt;
+}
+
+}  // namespace milvus::query
@@ -0,0 +1,30 @@
+#pragma once
+// Generated File
+// DO NOT EDIT
+#include <optional>
+
+#include "common/Types.h"
+#include "query/Expr.h"
+
+namespace milvus::segcore {
+class SegmentInternalInterface;
+}
+
+namespace milvus::query {
+
+// Shape-matched fused filter kernels for the hot leaf conjunctions
+// (term AND range) and (compare AND range), one specialization per scalar
+// type and comparison operator: the pair evaluates in a single pass over
+// the raw columns instead of two bitset-producing scans stitched with a
+// word AND. Returns nullopt when the pair does not match a generated
+// shape, mixes scalar types, or an involved field carries a scalar index
+// (whose lookup beats any scan); the caller then falls back to per-leaf
+// evaluation. Pure range pairs are not generated here: they take the
+// interval-folding path in LoweredExpr.
+std::optional<BitsetType>
+TryFusedConjunction(const segcore::SegmentInternalInterface& segment,
+                    int64_t row_count,
+                    const Expr& left,
+                    const Expr& right);
+
+}  // namespace milvus::query